@@ -23,12 +23,24 @@ static void amaHandleResponse(ControlEnvelope *control_envelope_in);
 
 
 
+/* Size of the blocks the envelope is unpacked into. A block with its
+   header fits the 512 byte pmalloc pool, and a typical command envelope
+   fits in one block. Larger single allocations get a block of their own. */
+#define AMA_UNPACK_ARENA_BLOCK_SIZE (512 - PROTOBUF_C_ARENA_BLOCK_HEADER_SIZE)
+
 void amaReceiveCommand(char* data, uint16 length)
 {
     if(data && length)
     {
-        ControlEnvelope* control_envelope_in = 
-                control_envelope__unpack(NULL, (size_t)length, (const uint8_t*)data);
+        ProtobufCArena arena;
+        ControlEnvelope* control_envelope_in;
+
+        /* The envelope is only used until the handlers return, while data
+           is still valid, so bytes fields can be left in place */
+        protobuf_c_arena_init(&arena, AMA_UNPACK_ARENA_BLOCK_SIZE, TRUE);
+
+        control_envelope_in = 
+                control_envelope__unpack(&arena.allocator, (size_t)length, (const uint8_t*)data);
 
         if(control_envelope_in)
         {
@@ -40,11 +52,9 @@ void amaReceiveCommand(char* data, uint16 length)
             {
                 amaHandleCommand(control_envelope_in);
             }
-
-            control_envelope__free_unpacked(control_envelope_in, NULL);
-
         }
 
+        protobuf_c_arena_clear(&arena);
     }
 }
 
@@ -135,23 +135,19 @@ void avrcpSendCommonStatusCfm(AVRCP*            avrcp,
 
 /****************************************************************************
 * NAME    
-* avrcpSendCommonFragmentedMetadataCfm    
+* avrcpMakeFragmentedMetadataCfm    
 *
 * DESCRIPTION
-*   Send MetaData confirm to the CT application with the extracted data from 
-*   the response
+*   Allocate a MetaData confirm with no data
 *
 * RETURNS
-*    void
+*    The message
 *******************************************************************************/
-void avrcpSendCommonFragmentedMetadataCfm(AVRCP         *avrcp, 
+static AVRCP_COMMON_FRAGMENTED_METADATA_CFM_T *avrcpMakeFragmentedMetadataCfm(
+                                          AVRCP         *avrcp, 
                                           avrcp_status_code  status,
-                                          uint16         id, 
-                                          uint16         metadata_packet_type,
-                                          uint16         data_length, 
-                                          const uint8*   data)
+                                          uint16         metadata_packet_type)
 {
-    uint16 offset=0;
     MAKE_AVRCP_MESSAGE(AVRCP_COMMON_FRAGMENTED_METADATA_CFM);
     
     message->avrcp = avrcp;
@@ -178,6 +174,31 @@ void avrcpSendCommonFragmentedMetadataCfm(AVRCP         *avrcp,
     message->data=0;
     message->size_data=0;
 
+    return message;
+}
+
+/****************************************************************************
+* NAME    
+* avrcpSendCommonFragmentedMetadataCfm    
+*
+* DESCRIPTION
+*   Send MetaData confirm to the CT application with the extracted data from 
+*   the response
+*
+* RETURNS
+*    void
+*******************************************************************************/
+void avrcpSendCommonFragmentedMetadataCfm(AVRCP         *avrcp, 
+                                          avrcp_status_code  status,
+                                          uint16         id, 
+                                          uint16         metadata_packet_type,
+                                          uint16         data_length, 
+                                          const uint8*   data)
+{
+    uint16 offset=0;
+    AVRCP_COMMON_FRAGMENTED_METADATA_CFM_T *message = 
+        avrcpMakeFragmentedMetadataCfm(avrcp, status, metadata_packet_type);
+
     if(!(status & AVRCP_ERROR_STATUS_BASE) && 
         (data_length))
     {
@@ -201,6 +222,58 @@ void avrcpSendCommonFragmentedMetadataCfm(AVRCP         *avrcp,
     return;
 }
 
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+/****************************************************************************
+* NAME    
+* avrcpSendCommonCopiedMetadataCfm    
+*
+* DESCRIPTION
+*   Send a successful single packet MetaData confirm to the CT application
+*   with a copy of response parameters held by the library, such as a
+*   cached response. Unlike the data of a received packet there is no
+*   L2CAP source to fall back on, so the copy is made first.
+*
+* RETURNS
+*    TRUE if the confirm was sent, FALSE if there was no memory for the copy
+*******************************************************************************/
+bool avrcpSendCommonCopiedMetadataCfm(AVRCP         *avrcp,
+                                      uint16         id,
+                                      uint16         data_length,
+                                      const uint8*   data)
+{
+    AVRCP_COMMON_FRAGMENTED_METADATA_CFM_T *message;
+    uint8 *copy = NULL;
+
+    if(data_length > 1)
+    {
+        copy = (uint8*)malloc(data_length-1);
+        if(!copy)
+        {
+            return FALSE;
+        }
+        memmove(copy, data+1, data_length-1);
+    }
+
+    message = avrcpMakeFragmentedMetadataCfm(avrcp, avrcp_success,
+                                             avrcp_packet_type_single);
+    if(data_length)
+    {
+        message->number_of_data_items = data[0];
+    }
+
+    if(copy)
+    {
+        avrcpReleaseAppData(avrcp);
+        message->size_data = data_length-1;
+        message->data = avrcpSourceFromData(avrcp, copy, message->size_data);
+        avrcp->data_app_ind = message->data;
+    }
+
+    MessageSend(avrcp->clientTask, id, message);
+    return TRUE;
+}
+#endif /* AVRCP_ENABLE_METADATA_CACHE */
+
 #ifdef AVRCP_ENABLE_DEPRECATED
 /****************************************************************************
 * NAME    
@@ -617,19 +690,18 @@ void convertUint32ToUint8Values(uint8 *ptr, uint32 value)
 
 /****************************************************************************
 * NAME    
-* avrcpSourceFromConstData    
+* avrcpReleaseAppData    
 *
 * DESCRIPTION
-*  Create a Source by allocating memory and copying data from constant memory.   
+*  Free the data of the last Source given to the application, if it is
+*  not the L2CAP source and the application has not emptied it yet.
 *
 * RETURNS
 *    void
 *******************************************************************************/
-Source avrcpSourceFromConstData(AVRCP *avrcp, const uint8 *data, uint16 length)
+void avrcpReleaseAppData(AVRCP *avrcp)
 {
-    uint8* ptr = NULL;
     Source src = StreamSourceFromSink(avrcp->sink);
-    uint16 data_drop = avrcp->av_msg_len;
 
     /* If application does not free the data yet. Force free */
     if( avrcp->data_app_ind && (src != avrcp->data_app_ind) )
@@ -642,6 +714,25 @@ Source avrcpSourceFromConstData(AVRCP *avrcp, const uint8 *data, uint16 length)
         }
         SourceEmpty(avrcp->data_app_ind);
     }
+}
+
+/****************************************************************************
+* NAME    
+* avrcpSourceFromConstData    
+*
+* DESCRIPTION
+*  Create a Source by allocating memory and copying data from constant memory.   
+*
+* RETURNS
+*    void
+*******************************************************************************/
+Source avrcpSourceFromConstData(AVRCP *avrcp, const uint8 *data, uint16 length)
+{
+    uint8* ptr = NULL;
+    Source src = StreamSourceFromSink(avrcp->sink);
+    uint16 data_drop = avrcp->av_msg_len;
+
+    avrcpReleaseAppData(avrcp);
 
     if(avrcp->bitfields.fragment == avrcp_packet_type_single)
     {
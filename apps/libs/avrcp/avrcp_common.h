@@ -155,6 +155,22 @@ void avrcpSendCommonFragmentedMetadataCfm(AVRCP        *avrcp,
                                        uint16            data_length, 
                                        const uint8*      data);
 
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+/****************************************************************************
+NAME
+    avrcpSendCommonCopiedMetadataCfm
+
+DESCRIPTION
+    Send a successful single packet MetaData confirm with a copy of response
+    parameters held by the library. Returns FALSE, and sends nothing, if
+    there is no memory for the copy.
+*/
+bool avrcpSendCommonCopiedMetadataCfm(AVRCP        *avrcp,
+                                      uint16            id,
+                                      uint16            data_length,
+                                      const uint8*      data);
+#endif /* AVRCP_ENABLE_METADATA_CACHE */
+
 #ifdef AVRCP_ENABLE_DEPRECATED
 /****************************************************************************
 NAME
@@ -283,6 +299,17 @@ DESCRIPTION
 void convertUint32ToUint8Values(uint8 *ptr, uint32 value);
 
 
+/****************************************************************************
+NAME
+   avrcpReleaseAppData 
+
+DESCRIPTION
+    Free the data of the last Source given to the application if it has
+    not emptied it yet, unless it is the L2CAP source.
+*/
+void avrcpReleaseAppData(AVRCP *avrcp);
+
+
 /****************************************************************************
 NAME
    avrcpSourceFromConstData 
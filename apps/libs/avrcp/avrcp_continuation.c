@@ -19,6 +19,7 @@ NOTES
 
 #include <panic.h>
 #include "avrcp_metadata_transfer.h"
+#include "avrcp_metadata_cache.h"
 
 
 #ifndef AVRCP_TG_ONLY_LIB /* Disable CT for TG only lib */
@@ -100,6 +101,13 @@ void AvrcpAbortContinuingResponseRequest(AVRCP *avrcp, uint16 pdu_id)
     avrcp->bitfields.fragment = avrcp_packet_type_end;
     avrcpUnblockReceivedData(avrcp);
 
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+    if (pdu_id == AVRCP_GET_ELEMENT_ATTRIBUTES_PDU_ID)
+    {
+        avrcpMetadataCacheAbandon(avrcp);
+    }
+#endif
+
     status = avrcpMetadataStatusCommand(avrcp,
                                   AVRCP_ABORT_CONTINUING_RESPONSE_PDU_ID, 
                                   avrcp_abort_continuation, 1, params, 0, 0);
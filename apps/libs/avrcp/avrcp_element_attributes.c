@@ -18,6 +18,7 @@ NOTES
 */
 #include <source.h>
 #include "avrcp_metadata_transfer.h"
+#include "avrcp_metadata_cache.h"
 
 #ifndef AVRCP_TG_ONLY_LIB /* Disable CT for TG only lib */
 /****************************************************************************
@@ -51,6 +52,16 @@ void AvrcpGetElementAttributesRequest( AVRCP    *avrcp,
     uint8 extra_params[AVRCP_GET_ELEMENTS_HDR_SIZE];
     avrcp_status_code status;
 
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+    /* Answer from the cache if the same attributes were fetched since the
+       last track change */
+    if (avrcpMetadataCacheRequest(avrcp, identifier_high, identifier_low,
+                                  size_attributes, attributes))
+    {
+        return;
+    }
+#endif
+
     /* Fill in the extra Header for Get Elements which is Identifier and
        number of elements*/
     convertUint32ToUint8Values(&extra_params[0], identifier_high);
@@ -66,6 +77,9 @@ void AvrcpGetElementAttributesRequest( AVRCP    *avrcp,
 
     if (status != avrcp_success)
     {
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+        avrcpMetadataCacheAbandon(avrcp);
+#endif
         avrcpSendCommonFragmentedMetadataCfm(avrcp, status, 
                                             AVRCP_GET_ELEMENT_ATTRIBUTES_CFM, 
                                             0, 0, 0);
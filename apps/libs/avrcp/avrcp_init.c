@@ -22,6 +22,7 @@ NOTES
 #include <bdaddr.h>
 #include "avrcp_init.h"
 #include "avrcp_profile_handler.h"
+#include "avrcp_metadata_cache.h"
 
 static AvrcpDeviceTask gAvrcpDeviceSettings;
 static const TaskData avrcpInitTask = {avrcpInitHandler};
@@ -166,6 +167,9 @@ void avrcpInitDefaults( AVRCP       *avrcp,
     avrcp->bitfields.remote_features = 0;
     avrcp->bitfields.remote_extensions = 0;
     avrcp->av_max_data_size = AVRCP_AVC_MAX_DATA_SIZE;
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+    avrcp->metadata_cache = NULL;
+#endif
 }
 
 
@@ -314,6 +318,10 @@ void avrcpResetValues(AVRCP* avrcp)
     /* Free any memory that may be allocated */
     avrcpSourceProcessed(avrcp, TRUE);
 
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+    avrcpMetadataCacheFree(avrcp);
+#endif
+
    /* Reset the local state values to their initial states */
     avrcpInitDefaults(avrcp, avrcpReady);
 
@@ -526,6 +534,9 @@ void avrcpHandleDeleteTask(AVRCP *avrcp)
         MessageFlushTask(&avrcp->task);
 
         avrcpDeleteTaskFromList(avrcp);
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+        avrcpMetadataCacheFree(avrcp);
+#endif
         free(avrcp);
     }
 }
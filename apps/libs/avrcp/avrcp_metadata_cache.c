@@ -0,0 +1,366 @@
+/****************************************************************************
+Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    avrcp_metadata_cache.c
+
+DESCRIPTION
+    Cache of the last GetElementAttributes response received by the CT.
+
+    GetElementAttributes responses are received in order, so the response
+    to a request is stored only if no other request was outstanding when it
+    was made. The response parameters of each packet are copied from the
+    L2CAP source into the cache as they arrive, so a response sent in
+    continuation packets needs no reassembly buffer. The cache is sized for
+    a response of one packet, see AVRCP_METADATA_CACHE_SIZE, and a response
+    that outgrows it is dropped from the cache.
+
+    The cached response for the playing track is only used while the CT is
+    registered for track changed notifications, so that the TG would have
+    told us if the track had changed.
+
+NOTES
+
+*/
+
+
+/****************************************************************************
+    Header files
+*/
+#include <source.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avrcp_metadata_cache.h"
+#include "avrcp_common.h"
+
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+
+/****************************************************************************
+*NAME
+*    avrcpMetadataCacheFree
+*
+*DESCRIPTION
+*    Free the cache of a connection.
+*****************************************************************************/
+void avrcpMetadataCacheFree(AVRCP *avrcp)
+{
+    free(avrcp->metadata_cache);
+    avrcp->metadata_cache = NULL;
+}
+
+#ifndef AVRCP_TG_ONLY_LIB /* Disable CT for TG only lib */
+
+/****************************************************************************
+*NAME
+*    avrcpGetMetadataCache
+*
+*DESCRIPTION
+*    Get the cache of a connection, creating it if necessary. Returns NULL
+*    if there is no memory, in which case nothing is cached.
+*****************************************************************************/
+static avrcpMetadataCache *avrcpGetMetadataCache(AVRCP *avrcp)
+{
+    avrcpMetadataCache *cache = avrcp->metadata_cache;
+
+    if (!cache)
+    {
+        cache = (avrcpMetadataCache *)malloc(sizeof(avrcpMetadataCache));
+        if (cache)
+        {
+            memset(cache, 0, sizeof(avrcpMetadataCache) -
+                             AVRCP_METADATA_CACHE_SIZE);
+            avrcp->metadata_cache = cache;
+        }
+    }
+
+    return cache;
+}
+
+/****************************************************************************
+*NAME
+*    avrcpGetAttributeMask
+*
+*DESCRIPTION
+*    Convert the list of 4 octet attribute IDs to a mask. Returns FALSE if
+*    an attribute ID can not be held in the mask.
+*****************************************************************************/
+static bool avrcpGetAttributeMask(uint16    size_attributes,
+                                  Source    attributes,
+                                  uint32    *mask)
+{
+    const uint8 *ptr;
+    uint16 i;
+
+    *mask = 0;
+
+    if (!size_attributes)
+    {
+        return TRUE;
+    }
+
+    ptr = SourceMap(attributes);
+    if (!ptr || (SourceSize(attributes) < size_attributes) ||
+        (size_attributes % 4))
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < size_attributes; i += 4)
+    {
+        uint32 id = convertUint8ValuesToUint32(&ptr[i]);
+
+        if (!id || (id > 31))
+        {
+            return FALSE;
+        }
+        *mask |= (uint32)1 << id;
+    }
+
+    return TRUE;
+}
+
+/****************************************************************************
+*NAME
+*    avrcpIsTrackUid
+*
+*DESCRIPTION
+*    Check whether a track identifier identifies the track.
+*****************************************************************************/
+static bool avrcpIsTrackUid(const uint8 *track)
+{
+    uint16 i;
+    uint8 all_set = 0xFF;
+    uint8 any_set = 0;
+
+    for (i = 0; i < 8; i++)
+    {
+        all_set &= track[i];
+        any_set |= track[i];
+    }
+
+    return (any_set != 0) && (all_set != 0xFF);
+}
+
+/****************************************************************************
+*NAME
+*    avrcpMetadataCacheRequest
+*
+*DESCRIPTION
+*    Answer a GetElementAttributes request from the cache, or prepare to
+*    store the response to it.
+*****************************************************************************/
+bool avrcpMetadataCacheRequest(AVRCP    *avrcp,
+                               uint32   identifier_high,
+                               uint32   identifier_low,
+                               uint16   size_attributes,
+                               Source   attributes)
+{
+    avrcpMetadataCache *cache = avrcpGetMetadataCache(avrcp);
+    uint32 mask;
+
+    if (!cache)
+    {
+        return FALSE;
+    }
+
+    if (avrcpGetAttributeMask(size_attributes, attributes, &mask) &&
+        !cache->outstanding)
+    {
+        if ((cache->bitfields.state == avrcp_metadata_cache_valid) &&
+            cache->bitfields.tracking &&
+            (cache->identifier_high == identifier_high) &&
+            (cache->identifier_low == identifier_low) &&
+            (cache->attribute_mask == mask) &&
+            (avrcp->pending == avrcp_none) &&
+            (avrcp->bitfields.fragment == avrcp_packet_type_single))
+        {
+            /* Without memory for the copy given to the application the
+               request is sent to the TG instead */
+            if (avrcpSendCommonCopiedMetadataCfm(avrcp,
+                                            AVRCP_GET_ELEMENT_ATTRIBUTES_CFM,
+                                            cache->length, cache->data))
+            {
+                AVRCP_INFO(("avrcpMetadataCacheRequest: hit\n"));
+
+                if (size_attributes)
+                {
+                    SourceEmpty(attributes);
+                }
+
+                cache->hits++;
+                return TRUE;
+            }
+        }
+
+        cache->identifier_high = identifier_high;
+        cache->identifier_low = identifier_low;
+        cache->attribute_mask = mask;
+        cache->length = 0;
+        cache->bitfields.state = avrcp_metadata_cache_filling;
+        cache->misses++;
+    }
+
+    cache->outstanding++;
+    return FALSE;
+}
+
+/****************************************************************************
+*NAME
+*    avrcpMetadataCacheResponse
+*
+*DESCRIPTION
+*    Store a GetElementAttributes response packet if it belongs to the
+*    request being cached.
+*****************************************************************************/
+void avrcpMetadataCacheResponse(AVRCP               *avrcp,
+                                avrcp_status_code   status,
+                                uint16              metadata_packet_type,
+                                const uint8         *data,
+                                uint16              length)
+{
+    avrcpMetadataCache *cache = avrcp->metadata_cache;
+    bool start = (metadata_packet_type == avrcp_packet_type_single) ||
+                 (metadata_packet_type == avrcp_packet_type_start);
+    bool last = (metadata_packet_type == avrcp_packet_type_single) ||
+                (metadata_packet_type == avrcp_packet_type_end) ||
+                (status != avrcp_success);
+
+    if (!cache || !cache->outstanding)
+    {
+        return;
+    }
+
+    if (start && cache->bitfields.continuing)
+    {
+        /* The CT did not request the rest of the previous response */
+        avrcpMetadataCacheAbandon(avrcp);
+        if (!cache->outstanding)
+        {
+            return;
+        }
+    }
+
+    if (cache->bitfields.state == avrcp_metadata_cache_filling)
+    {
+        if ((status != avrcp_success) ||
+            (avrcp->bitfields.fragment != avrcp_packet_type_single) ||
+            (start && !length) || (start != !cache->length) ||
+            (length > AVRCP_METADATA_CACHE_SIZE - cache->length))
+        {
+            cache->bitfields.state = avrcp_metadata_cache_empty;
+        }
+        else
+        {
+            if (length)
+            {
+                memmove(&cache->data[cache->length], data, length);
+                cache->length += length;
+            }
+
+            if (last)
+            {
+                cache->bitfields.state = avrcp_metadata_cache_valid;
+            }
+        }
+    }
+
+    cache->bitfields.continuing = !last;
+    if (last)
+    {
+        cache->outstanding--;
+    }
+}
+
+/****************************************************************************
+*NAME
+*    avrcpMetadataCacheAbandon
+*
+*DESCRIPTION
+*    The oldest outstanding request will not be answered.
+*****************************************************************************/
+void avrcpMetadataCacheAbandon(AVRCP *avrcp)
+{
+    avrcpMetadataCache *cache = avrcp->metadata_cache;
+
+    if (cache && cache->outstanding)
+    {
+        if (cache->bitfields.state == avrcp_metadata_cache_filling)
+        {
+            cache->bitfields.state = avrcp_metadata_cache_empty;
+        }
+        cache->bitfields.continuing = FALSE;
+        cache->outstanding--;
+    }
+}
+
+/****************************************************************************
+*NAME
+*    avrcpMetadataCacheEvent
+*
+*DESCRIPTION
+*    Empty the cache if the event means that the attributes may have
+*    changed. A response still being received is not stored.
+*****************************************************************************/
+void avrcpMetadataCacheEvent(AVRCP                  *avrcp,
+                             avrcp_supported_events event_id,
+                             uint16                 response,
+                             const uint8            *data,
+                             uint16                 length)
+{
+    avrcpMetadataCache *cache = avrcp->metadata_cache;
+    bool invalidate = TRUE;
+
+    switch (event_id)
+    {
+    case avrcp_event_track_changed:
+        if ((response == avctp_response_interim) && (length >= 8))
+        {
+            /* Registered. The attributes are kept if the TG reported the
+               same track when the previous registration completed. A TG
+               without track UIDs reports 0 or all 0xFF for every track. */
+            cache = avrcpGetMetadataCache(avrcp);
+            if (!cache)
+            {
+                return;
+            }
+
+            invalidate = !cache->bitfields.track_valid ||
+                         memcmp(cache->track, data, 8) ||
+                         !avrcpIsTrackUid(data);
+            cache->bitfields.tracking = TRUE;
+        }
+        else if (cache)
+        {
+            /* Changed or rejected. The CT must register again. */
+            cache->bitfields.tracking = FALSE;
+        }
+
+        if (cache)
+        {
+            cache->bitfields.track_valid = (length >= 8);
+            if (length >= 8)
+            {
+                memmove(cache->track, data, 8);
+            }
+        }
+        break;
+
+    case avrcp_event_uids_changed:
+    case avrcp_event_addressed_player_changed:  /* Fall through */
+        break;
+
+    default:
+        return;
+    }
+
+    if (cache && invalidate)
+    {
+        cache->bitfields.state = avrcp_metadata_cache_empty;
+    }
+}
+
+#endif /* !AVRCP_TG_ONLY_LIB */
+
+#endif /* AVRCP_ENABLE_METADATA_CACHE */
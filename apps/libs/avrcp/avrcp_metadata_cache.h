@@ -0,0 +1,151 @@
+/****************************************************************************
+Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    avrcp_metadata_cache.h
+
+DESCRIPTION
+    Per connection cache of the last GetElementAttributes response received
+    by the CT, if it fits in AVRCP_METADATA_CACHE_SIZE bytes. The response
+    parameters are assembled in the cache as the continuation packets
+    arrive, and a repeated request for the same element and attributes is
+    answered from the cache without a command to the TG.
+    The cache is emptied when the TG notifies a track change, a UIDs change
+    or an addressed player change.
+*/
+
+#ifndef AVRCP_METADATA_CACHE_H_
+#define AVRCP_METADATA_CACHE_H_
+
+#include "avrcp_private.h"
+
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+
+/* Largest response held in the cache. The whole cache entry has to fit in
+   the largest pmalloc pool of the earbud application (692 bytes), so this
+   is not enough for a full response with continuations: each packet but
+   the last carries up to AVRCP_AVC_MAX_DATA_SIZE (502) bytes. A response
+   of one packet always fits, and so does a start packet followed by an
+   end packet of up to 138 bytes. Anything longer, including every
+   response of three or more packets, is passed to the application but
+   not cached. */
+#ifndef AVRCP_METADATA_CACHE_SIZE
+#define AVRCP_METADATA_CACHE_SIZE       640
+#endif
+
+#if AVRCP_METADATA_CACHE_SIZE < AVRCP_AVC_MAX_DATA_SIZE
+#error "AVRCP_METADATA_CACHE_SIZE must hold a response of one packet"
+#endif
+
+/* State of the cache entry */
+typedef enum
+{
+    avrcp_metadata_cache_empty,
+    avrcp_metadata_cache_filling,
+    avrcp_metadata_cache_valid
+} avrcpMetadataCacheState;
+
+/* The cache entry. The key is the element identifier and the mask of the
+   requested attribute IDs, 0 for all attributes. data holds the response
+   parameters starting with the number of attributes. */
+typedef struct __avrcpMetadataCache
+{
+    uint32                  identifier_high;
+    uint32                  identifier_low;
+    uint32                  attribute_mask;
+    uint8                   track[8];       /* Last track identifier
+                                               notified by the TG */
+    uint16                  length;         /* Bytes in data */
+    uint16                  hits;
+    uint16                  misses;
+    uint8                   outstanding;    /* GetElementAttributes
+                                               requests not yet answered */
+    struct
+    {
+        avrcpMetadataCacheState state:2;
+        unsigned                tracking:1;   /* Registered for track
+                                                 changed notifications */
+        unsigned                continuing:1; /* More packets to come */
+        unsigned                track_valid:1;/* track has been notified */
+        unsigned                unused:3;
+    } bitfields;
+    uint8                   data[AVRCP_METADATA_CACHE_SIZE];
+} avrcpMetadataCache;
+
+
+/****************************************************************************
+NAME
+    avrcpMetadataCacheFree
+
+DESCRIPTION
+    Free the cache of a connection.
+*/
+void avrcpMetadataCacheFree(AVRCP *avrcp);
+
+#ifndef AVRCP_TG_ONLY_LIB /* Disable CT for TG only lib */
+
+/****************************************************************************
+NAME
+    avrcpMetadataCacheRequest
+
+DESCRIPTION
+    Look up a GetElementAttributes request in the cache. Returns TRUE if
+    the confirmation has been sent from the cache and the attributes
+    Source has been emptied. Returns FALSE if the request must be sent to
+    the TG, in which case the response will be stored in the cache unless
+    an earlier request is still waiting for its response.
+*/
+bool avrcpMetadataCacheRequest(AVRCP    *avrcp,
+                               uint32   identifier_high,
+                               uint32   identifier_low,
+                               uint16   size_attributes,
+                               Source   attributes);
+
+
+/****************************************************************************
+NAME
+    avrcpMetadataCacheResponse
+
+DESCRIPTION
+    Add a GetElementAttributes response packet from the TG to the cache.
+    data is the response parameters of the packet, including the number
+    of attributes in a single or start packet.
+*/
+void avrcpMetadataCacheResponse(AVRCP               *avrcp,
+                                avrcp_status_code   status,
+                                uint16              metadata_packet_type,
+                                const uint8         *data,
+                                uint16              length);
+
+
+/****************************************************************************
+NAME
+    avrcpMetadataCacheAbandon
+
+DESCRIPTION
+    The oldest GetElementAttributes request will not be answered, because
+    the request failed or timed out or the continuation was aborted.
+*/
+void avrcpMetadataCacheAbandon(AVRCP *avrcp);
+
+
+/****************************************************************************
+NAME
+    avrcpMetadataCacheEvent
+
+DESCRIPTION
+    Update the cache on an event notification from the TG. data points to
+    the event parameters after the event ID.
+*/
+void avrcpMetadataCacheEvent(AVRCP                  *avrcp,
+                             avrcp_supported_events event_id,
+                             uint16                 response,
+                             const uint8            *data,
+                             uint16                 length);
+
+
+#endif /* !AVRCP_TG_ONLY_LIB */
+#endif /* AVRCP_ENABLE_METADATA_CACHE */
+
+#endif /* AVRCP_METADATA_CACHE_H_ */
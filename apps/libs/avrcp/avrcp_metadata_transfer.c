@@ -34,6 +34,7 @@ NOTES
 #include "avrcp_mediaplayer.h"
 #include "avrcp_browsing_handler.h"
 #include "avrcp_init.h"
+#include "avrcp_metadata_cache.h"
 
 static AVRCP_INTERNAL_VENDORDEPENDENT_REQ_T *avrcpCreateMetadataMessage(
         uint8 id, avrcpPending pending, uint16 inline_param_len,
@@ -235,6 +236,9 @@ void avrcpSendMetadataFailCfmToClient(AVRCP *avrcp, avrcp_status_code status)
                                  AVRCP_GET_APP_VALUE_TEXT_CFM, 0, 0, 0);
             break;
         case avrcp_get_element_attributes:
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+            avrcpMetadataCacheAbandon(avrcp);
+#endif
             avrcpSendCommonFragmentedMetadataCfm(avrcp, status,
                                  AVRCP_GET_ELEMENT_ATTRIBUTES_CFM, 0, 0,  0);
             break;
@@ -420,6 +424,14 @@ void avrcpHandleMetadataResponse(   AVRCP       *avrcp,
     case AVRCP_GET_APP_VALUE_TEXT_PDU_ID:       /* Fall through */
     case AVRCP_GET_ELEMENT_ATTRIBUTES_PDU_ID:   /* Fall through */
         {
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+            if (pdu_id == AVRCP_GET_ELEMENT_ATTRIBUTES_PDU_ID)
+            {
+                /* Store the parameters before the source is handed on */
+                avrcpMetadataCacheResponse(avrcp, status, meta_packet_type,
+                                           data, packet_size);
+            }
+#endif
             /* Only process the response if it was expected. */
             avrcpSendCommonFragmentedMetadataCfm(avrcp, 
                                             status, 
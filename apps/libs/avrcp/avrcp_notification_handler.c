@@ -39,6 +39,7 @@ NOTES
 #include "avrcp_continuation_handler.h"
 #include "avrcp_metadata_transfer.h"
 #include "avrcp_common.h"
+#include "avrcp_metadata_cache.h"
 
 #ifndef AVRCP_TG_ONLY_LIB /* Disable CT for TG only lib */
 
@@ -91,6 +92,11 @@ void avrcpSendNotification( AVRCP *avrcp,
         data_start++;
         data_len = packet_size-data_start;
     }
+
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+    avrcpMetadataCacheEvent(avrcp, event_id, response, 
+                            &ptr[data_start], data_len);
+#endif
     
     switch (event_id)
     {
@@ -889,6 +889,10 @@ struct __AVRCP
     uint8                   avctp_packets_remaining; /* packets of fragmented
                                                         message still to come */
     bdaddr                bd_addr;
+#ifdef AVRCP_ENABLE_METADATA_CACHE
+    struct __avrcpMetadataCache *metadata_cache; /* Last GetElementAttributes
+                                                    response, NULL if none */
+#endif
 };
 
 typedef struct _AVRCP_List
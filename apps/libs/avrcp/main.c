@@ -0,0 +1,528 @@
+/* Copyright (c) 2019 Qualcomm Technologies International, Ltd. */
+/*  */
+/* Host replay harness for the GetElementAttributes cache. A simulated TG
+   answers the CT requests with response PDUs split into continuation
+   packets, and sends track changed and UIDs changed notifications. The
+   packets are passed to the cache in the order avrcpHandleMetadataResponse
+   would pass them, and every confirmation received by the application is
+   checked against what the TG holds at that time. Now and then there is
+   no memory to copy a cached response, so the request goes to the TG. The same session is run
+   with and without the cache to compare the traffic. Build with
+   -DAVRCP_ENABLE_METADATA_CACHE. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avrcp_metadata_cache.h"
+#include "avrcp_common.h"
+
+/* Number of steps in the session */
+#define TEST_STEPS              20000
+
+/* Largest response parameters in one packet */
+#define TEST_PACKET_PARAMS      AVRCP_AVC_MAX_DATA_SIZE
+
+/* Largest response the TG sends */
+#define TEST_MAX_RESPONSE       2048
+
+/* Bytes of AVCTP, AV/C and metadata header in each packet */
+#define TEST_HEADER_SIZE        (AVCTP_SINGLE_PKT_HEADER_SIZE + \
+                                 AVRCP_VENDOR_HEADER_SIZE + METADATA_HEADER_SIZE)
+
+/* Attributes shown on the display and on the track list */
+#define MASK_ALL                0
+#define MASK_TITLE_ARTIST       ((1 << 1) | (1 << 2))
+
+struct __SOURCE
+{
+    const uint8 *data;
+    uint16 size;
+};
+
+/* The simulated TG */
+typedef struct
+{
+    uint16  track;          /* Index of the playing track */
+    bool    uids;           /* Reports track UIDs, otherwise 0 */
+    bool    registered;     /* CT registered for track changed */
+} test_tg;
+
+/* What the application has received */
+typedef struct
+{
+    uint8   data[TEST_MAX_RESPONSE];
+    uint16  length;
+    bool    complete;
+    bool    failed;
+} test_app;
+
+typedef struct
+{
+    unsigned long requests;
+    unsigned long commands;     /* Commands sent to the TG */
+    unsigned long packets;      /* Response packets from the TG */
+    unsigned long bytes;        /* Bytes received from the TG */
+    unsigned long checked;      /* Confirmations checked */
+    unsigned long errors;
+} test_stats;
+
+static test_tg tg;
+static test_app app;
+static test_stats stats;
+static uint32 seed;
+static bool memory_short;   /* A copy for the application can not be made */
+
+const uint8 *SourceMap(Source source)
+{
+    return source ? source->data : NULL;
+}
+
+uint16 SourceSize(Source source)
+{
+    return source ? source->size : 0;
+}
+
+bool SourceDrop(Source source, uint16 amount)
+{
+    if (!source || amount > source->size)
+        return FALSE;
+    source->data += amount;
+    source->size -= amount;
+    return TRUE;
+}
+
+uint32 convertUint8ValuesToUint32(const uint8 *ptr)
+{
+    return ((uint32)ptr[0] << 24) | ((uint32)ptr[1] << 16) |
+           ((uint32)ptr[2] << 8) | (uint32)ptr[3];
+}
+
+/* The application receives the confirmation */
+void avrcpSendCommonFragmentedMetadataCfm(AVRCP         *avrcp,
+                                          avrcp_status_code  status,
+                                          uint16         id,
+                                          uint16         metadata_packet_type,
+                                          uint16         data_length,
+                                          const uint8*   data)
+{
+    UNUSED(avrcp);
+    UNUSED(id);
+
+    if (status != avrcp_success)
+    {
+        app.failed = TRUE;
+        app.complete = TRUE;
+        return;
+    }
+
+    if ((metadata_packet_type == avrcp_packet_type_single) ||
+        (metadata_packet_type == avrcp_packet_type_start))
+        app.length = 0;
+
+    if (app.length + data_length <= TEST_MAX_RESPONSE)
+    {
+        memmove(&app.data[app.length], data, data_length);
+        app.length += data_length;
+    }
+
+    app.complete = (metadata_packet_type == avrcp_packet_type_single) ||
+                   (metadata_packet_type == avrcp_packet_type_end);
+}
+
+/* The application receives a confirmation from the cache, unless there is
+   no memory for the copy */
+bool avrcpSendCommonCopiedMetadataCfm(AVRCP         *avrcp,
+                                      uint16         id,
+                                      uint16         data_length,
+                                      const uint8*   data)
+{
+    if (memory_short)
+        return FALSE;
+
+    avrcpSendCommonFragmentedMetadataCfm(avrcp, avrcp_success, id,
+                                         avrcp_packet_type_single,
+                                         data_length, data);
+    return TRUE;
+}
+
+static uint32 test_random(uint32 range)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % range;
+}
+
+static void put_uint32(uint8 *ptr, uint32 value)
+{
+    ptr[0] = (uint8)(value >> 24);
+    ptr[1] = (uint8)(value >> 16);
+    ptr[2] = (uint8)(value >> 8);
+    ptr[3] = (uint8)value;
+}
+
+static void track_uid(uint8 *uid)
+{
+    memset(uid, 0, 8);
+    if (tg.uids)
+        put_uint32(&uid[4], 0x1000 + tg.track);
+}
+
+/* Value of an attribute of a track. Every eighth track has a long title
+   so that its response needs continuation packets. */
+static uint16 attribute_value(uint16 track, uint16 id, char *value)
+{
+    switch (id)
+    {
+    case 1:
+        if (track % 8 == 7)
+            return (uint16)sprintf(value, "Track %u (Extended Live Version "
+                "Recorded at the Royal Albert Hall with the Full Orchestra, "
+                "Choir and Special Guests, Remastered from the Original "
+                "Multitrack Tapes, Including the Encore, the Spoken "
+                "Introduction and the Applause That Followed It, Which Went "
+                "On for Quite Some Time, Much Longer Than Anyone Expected, "
+                "Before the Lights Finally Came Up and Everyone Went Home, "
+                "Remembering the Night for Years and Years Afterwards)", track);
+        return (uint16)sprintf(value, "Track %u", track);
+    case 2:
+        return (uint16)sprintf(value, "Artist %u", track / 12);
+    case 3:
+        return (uint16)sprintf(value, "Album %u", track / 12);
+    case 4:
+        return (uint16)sprintf(value, "%u", track % 12 + 1);
+    case 5:
+        return (uint16)sprintf(value, "12");
+    case 6:
+        return (uint16)sprintf(value, "Genre %u", track / 50);
+    default:
+        return (uint16)sprintf(value, "%u", 180000 + track * 1000);
+    }
+}
+
+/* Response parameters of GetElementAttributes for the playing track */
+static uint16 tg_response(uint32 mask, uint8 *params)
+{
+    uint16 length = 1;
+    uint16 id;
+
+    params[0] = 0;
+    for (id = 1; id <= 7; id++)
+    {
+        char value[512];
+        uint16 size;
+
+        if (mask && !(mask & (1UL << id)))
+            continue;
+
+        size = attribute_value(tg.track, id, value);
+        put_uint32(&params[length], id);
+        params[length + 4] = 0x00;
+        params[length + 5] = 0x6A;          /* UTF-8 */
+        params[length + 6] = (uint8)(size >> 8);
+        params[length + 7] = (uint8)size;
+        memmove(&params[length + 8], value, size);
+        length += 8 + size;
+        params[0]++;
+    }
+    return length;
+}
+
+static void send_event(AVRCP *avrcp, avrcp_supported_events event_id,
+                       uint16 response)
+{
+    uint8 params[8];
+
+    memset(params, 0, sizeof(params));
+    if (event_id == avrcp_event_track_changed)
+        track_uid(params);
+
+    avrcpMetadataCacheEvent(avrcp, event_id, response, params,
+                            event_id == avrcp_event_track_changed ? 8 : 2);
+}
+
+/* The CT registers for track changed, the TG answers INTERIM */
+static void register_track_changed(AVRCP *avrcp)
+{
+    stats.commands++;
+    tg.registered = TRUE;
+    send_event(avrcp, avrcp_event_track_changed, avctp_response_interim);
+}
+
+/* The playing track changes. The TG sends CHANGED if registered and the
+   application registers again, usually at once. */
+static void change_track(AVRCP *avrcp, bool reregister)
+{
+    tg.track++;
+    if (tg.registered)
+    {
+        tg.registered = FALSE;
+        send_event(avrcp, avrcp_event_track_changed, avctp_response_changed);
+    }
+    if (reregister)
+        register_track_changed(avrcp);
+}
+
+/* The TG answers the oldest outstanding request, with the application
+   requesting the continuation packets. Returns the expected response. */
+static void tg_answer(AVRCP *avrcp, uint32 mask, bool abort, bool reject,
+                      uint8 *expected, uint16 *expected_length)
+{
+    uint8 params[TEST_MAX_RESPONSE];
+    uint16 length = tg_response(mask, params);
+    uint16 offset = 0;
+
+    app.length = 0;
+    app.complete = FALSE;
+    app.failed = FALSE;
+
+    if (reject)
+    {
+        uint8 error = 0x03;     /* Invalid parameter */
+
+        stats.packets++;
+        stats.bytes += TEST_HEADER_SIZE + 1;
+        avrcpMetadataCacheResponse(avrcp, error | AVRCP_ERROR_STATUS_BASE,
+                                   avrcp_packet_type_single, &error, 1);
+        avrcpSendCommonFragmentedMetadataCfm(avrcp,
+                                   error | AVRCP_ERROR_STATUS_BASE,
+                                   AVRCP_GET_ELEMENT_ATTRIBUTES_CFM,
+                                   avrcp_packet_type_single, 0, 0);
+        *expected_length = 0;
+        return;
+    }
+
+    while (offset < length)
+    {
+        uint16 size = length - offset;
+        uint16 type;
+
+        if (size > TEST_PACKET_PARAMS)
+        {
+            size = TEST_PACKET_PARAMS;
+            type = offset ? avrcp_packet_type_continue : avrcp_packet_type_start;
+        }
+        else
+        {
+            type = offset ? avrcp_packet_type_end : avrcp_packet_type_single;
+        }
+
+        if (offset)
+        {
+            /* RequestContinuingResponse, or the application gives up */
+            if (abort)
+            {
+                stats.commands++;
+                avrcpMetadataCacheAbandon(avrcp);
+                *expected_length = 0;
+                return;
+            }
+            stats.commands++;
+        }
+
+        stats.packets++;
+        stats.bytes += TEST_HEADER_SIZE + size;
+        avrcpMetadataCacheResponse(avrcp, avrcp_success, type,
+                                   &params[offset], size);
+        avrcpSendCommonFragmentedMetadataCfm(avrcp, avrcp_success,
+                                   AVRCP_GET_ELEMENT_ATTRIBUTES_CFM,
+                                   type, size, &params[offset]);
+        offset += size;
+    }
+
+    memmove(expected, params, length);
+    *expected_length = length;
+}
+
+static void check(const uint8 *expected, uint16 expected_length)
+{
+    stats.checked++;
+    if (!expected_length)
+    {
+        if (!app.failed && app.complete)
+            stats.errors++;
+        return;
+    }
+
+    if (!app.complete || app.failed || app.length != expected_length ||
+        memcmp(app.data, expected, expected_length))
+        stats.errors++;
+}
+
+static void make_attributes(uint32 mask, uint8 *list, struct __SOURCE *source)
+{
+    uint16 id, size = 0;
+
+    for (id = 1; id <= 7; id++)
+    {
+        if (mask & (1UL << id))
+        {
+            put_uint32(&list[size], id);
+            size += 4;
+        }
+    }
+    source->data = list;
+    source->size = size;
+}
+
+/* The application calls AvrcpGetElementAttributesRequest. Returns TRUE if
+   the request was answered from the cache. */
+static bool request(AVRCP *avrcp, uint32 mask, bool cached)
+{
+    uint8 list[28];
+    struct __SOURCE source;
+
+    stats.requests++;
+    make_attributes(mask, list, &source);
+
+    if (cached && avrcpMetadataCacheRequest(avrcp, 0, 0, source.size, &source))
+        return TRUE;
+
+    stats.commands++;
+    return FALSE;
+}
+
+/* Request and check the answer. The TG may not answer, may reject the
+   request or the application may abort the continuation. */
+static void fetch(AVRCP *avrcp, uint32 mask, bool cached)
+{
+    uint8 expected[TEST_MAX_RESPONSE];
+    uint16 expected_length;
+    bool timeout = (test_random(100) == 0);
+    bool abort = (test_random(20) == 0);
+    bool reject = (test_random(100) == 0);
+
+    memory_short = (test_random(10) == 0);
+    app.complete = FALSE;
+    if (request(avrcp, mask, cached))
+    {
+        expected_length = tg_response(mask, expected);
+    }
+    else if (timeout)
+    {
+        /* The watchdog fails the request */
+        avrcpMetadataCacheAbandon(avrcp);
+        return;
+    }
+    else
+    {
+        tg_answer(avrcp, mask, abort, reject, expected, &expected_length);
+    }
+    check(expected, expected_length);
+}
+
+/* Two requests before the first is answered */
+static void fetch_two(AVRCP *avrcp, bool cached)
+{
+    uint8 expected[TEST_MAX_RESPONSE];
+    uint16 expected_length;
+    bool first, second;
+
+    first = request(avrcp, MASK_ALL, cached);
+    if (first)
+    {
+        expected_length = tg_response(MASK_ALL, expected);
+        check(expected, expected_length);
+    }
+
+    second = request(avrcp, MASK_TITLE_ARTIST, cached);
+    if (second)
+    {
+        expected_length = tg_response(MASK_TITLE_ARTIST, expected);
+        check(expected, expected_length);
+    }
+
+    if (!first)
+    {
+        tg_answer(avrcp, MASK_ALL, FALSE, FALSE, expected, &expected_length);
+        check(expected, expected_length);
+    }
+
+    if (!second)
+    {
+        tg_answer(avrcp, MASK_TITLE_ARTIST, FALSE, FALSE, expected,
+                  &expected_length);
+        check(expected, expected_length);
+    }
+}
+
+static unsigned run(bool cached, bool uids)
+{
+    AVRCP *avrcp = (AVRCP *)calloc(1, sizeof(AVRCP));
+    avrcpMetadataCache *cache;
+    uint32 step;
+    bool deferred = FALSE;
+
+    if (!avrcp)
+        return 1;
+
+    avrcp->pending = avrcp_none;
+    avrcp->bitfields.fragment = avrcp_packet_type_single;
+
+    memset(&tg, 0, sizeof(tg));
+    memset(&stats, 0, sizeof(stats));
+    tg.uids = uids;
+    seed = 1;
+
+    register_track_changed(avrcp);
+
+    for (step = 0; step < TEST_STEPS; step++)
+    {
+        uint32 r = test_random(100);
+
+        if (r < 3)
+        {
+            /* Track ends, the application registers again at once or
+               after it has fetched the new attributes */
+            deferred = (test_random(5) == 0);
+            change_track(avrcp, !deferred);
+        }
+        else if (r < 4)
+        {
+            send_event(avrcp, avrcp_event_uids_changed, avctp_response_changed);
+        }
+        else if (r < 40)
+        {
+            fetch(avrcp, MASK_ALL, cached);
+        }
+        else if (r < 70)
+        {
+            fetch(avrcp, MASK_TITLE_ARTIST, cached);
+        }
+        else if (r < 73)
+        {
+            fetch_two(avrcp, cached);
+        }
+
+        if (deferred && r >= 3)
+        {
+            deferred = FALSE;
+            register_track_changed(avrcp);
+        }
+    }
+
+    cache = avrcp->metadata_cache;
+    printf("%s, %s:\n", cached ? "With the cache" : "Without the cache",
+           uids ? "TG with track UIDs" : "TG without track UIDs");
+    printf("  %lu requests, %lu commands, %lu response packets, %lu bytes\n",
+           stats.requests, stats.commands, stats.packets, stats.bytes);
+    if (cache)
+        printf("  %u hits, %u misses, %lu bytes of cache\n", cache->hits,
+               cache->misses, (unsigned long)sizeof(avrcpMetadataCache));
+    printf("  %lu responses checked %s\n", stats.checked,
+           stats.errors ? "FAIL!" : "OK");
+
+    avrcpMetadataCacheFree(avrcp);
+    free(avrcp);
+    return stats.errors ? 1 : 0;
+}
+
+int main(void)
+{
+    unsigned failures = 0;
+
+    failures += run(FALSE, TRUE);
+    failures += run(TRUE, TRUE);
+    failures += run(TRUE, FALSE);
+
+    return failures ? 1 : 0;
+}
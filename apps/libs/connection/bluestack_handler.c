@@ -2108,6 +2108,13 @@ void connectionBluestackHandler(Task task, MessageId id, Message message)
             break;
 #endif
 
+        /* The TDL write back timer can expire in any state, and must not be
+           dropped or the cache never schedules another one */
+        case CL_INTERNAL_SM_TDL_FLUSH_IND:
+            PRINT(("CL_INTERNAL_SM_TDL_FLUSH_IND\n"));
+            ConnectionTrustedDeviceListFlush();
+            break;
+
         /* Everything else must be internal connection library primitives */
         default:
         {
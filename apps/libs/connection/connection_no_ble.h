@@ -6549,6 +6549,18 @@ bool ConnectionAuthIsPriorityDevice(
 */
 uint16 ConnectionTrustedDeviceListSize(void);
 
+/*!
+    @brief Write any pending changes to the Trusted Device List to persistent
+    store.
+
+    When the library is built with CL_TDL_RECORD_CACHE the trusted device
+    records and their attributes are held in RAM, and changes are written
+    back to persistent store together a short time after the first change.
+    The application should call this function before powering off so that
+    no changes are lost. Otherwise the function does nothing.
+*/
+void ConnectionTrustedDeviceListFlush(void);
+
 /*!
     @brief Reserve an LTADDR for use with a connectionless slave broadcast.
 
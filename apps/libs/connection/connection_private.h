@@ -200,6 +200,7 @@ typedef enum
     CL_INTERNAL_SM_GET_AUTH_DEVICE_REQ,
     CL_INTERNAL_SM_SET_TRUST_LEVEL_REQ,
     CL_INTERNAL_SM_ADD_DEVICE_AT_TDL_POS_REQ,
+    CL_INTERNAL_SM_TDL_FLUSH_IND,
 
     /* Baseband Entity */
     CL_INTERNAL_DM_READ_CLASS_OF_DEVICE_REQ,
@@ -187,6 +187,278 @@ static tdi_cache_t tdi_cache = {0};
 
 #define GET_TDI_CACHE (tdi_cache.tdi)
 
+#ifdef CL_TDL_RECORD_CACHE
+/* Ram copy of the TDL keys of every device (the device record with its link
+ * keys, the attribute data and the GATT attribute data). It is read from PS
+ * once by connectionInitTrustedDeviceList(), after which searches and reads
+ * do not touch PS. Changes, including those to the TDI, are written back
+ * together TDL_FLUSH_DELAY after the first one, so that a pairing or a run
+ * of MRU updates costs one write per key.
+ */
+/* Device record, attribute and GATT attribute keys */
+#define TDL_KEY_TYPES               (3)
+
+/* Dirty flag of the TDI, following those of the TDL keys */
+#define TDL_DIRTY_TDI   ((uint32)1 << (TDL_KEY_TYPES * MAX_NO_DEVICES_TO_MANAGE))
+
+#define TDL_FLUSH_DELAY D_SEC(1)
+
+/* Timed write backs that may fail in a row before the timer stops being
+ * armed. The keys stay dirty and are tried again on the next change or
+ * ConnectionTrustedDeviceListFlush(). */
+#define TDL_FLUSH_RETRIES   (3)
+
+typedef struct
+{
+    uint16      *data;      /* Contents of the key, NULL if not stored */
+    uint16      words;      /* Length of the key in words */
+} tdl_key_t;
+
+typedef struct
+{
+    tdl_key_t   key[TDL_KEY_TYPES][MAX_NO_DEVICES_TO_MANAGE];
+    uint32      dirty;      /* Keys changed since the last write back */
+    bool        flush_pending;
+    uint16      flush_failures; /* Write backs failed in a row */
+} tdl_record_cache_t;
+
+static tdl_record_cache_t tdl_record_cache;
+
+/* First PS key of each type of TDL key */
+static const uint16 tdl_key_base[TDL_KEY_TYPES] =
+{
+    TRUSTED_DEVICE_LIST,
+    PSKEY_TDL_ATTRIBUTE_BASE,
+    PSKEY_TDL_GATT_ATTRIBUTE_BASE
+};
+
+
+/****************************************************************************
+
+DESCRIPTION
+    Get the cached copy of a TDL PS key and its dirty flag.
+
+RETURNS
+    Pointer to the cached key, NULL if it is not a TDL key.
+*/
+static tdl_key_t *tdl_cache_key(uint16 key, uint32 *dirty)
+{
+    uint16 type;
+    uint16 pos;
+
+    for (type = 0; type < TDL_KEY_TYPES; type++)
+    {
+        if (key >= tdl_key_base[type] &&
+            key < tdl_key_base[type] + MAX_NO_DEVICES_TO_MANAGE)
+        {
+            break;
+        }
+    }
+
+    if (type == TDL_KEY_TYPES)
+    {
+        return NULL;
+    }
+
+    pos = key - tdl_key_base[type];
+
+    if (dirty)
+    {
+        *dirty = (uint32)1 << (type * MAX_NO_DEVICES_TO_MANAGE + pos);
+    }
+
+    return &tdl_record_cache.key[type][pos];
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    Start the write back timer if it is not already running.
+*/
+static void tdl_cache_arm_flush(void)
+{
+    if (!tdl_record_cache.flush_pending)
+    {
+        tdl_record_cache.flush_pending = TRUE;
+        MessageSendLater(
+                connectionGetCmTask(),
+                CL_INTERNAL_SM_TDL_FLUSH_IND,
+                NULL,
+                TDL_FLUSH_DELAY
+                );
+    }
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    Mark cached keys as changed and start the write back timer.
+*/
+static void tdl_cache_set_dirty(uint32 dirty)
+{
+    tdl_record_cache.dirty |= dirty;
+    tdl_record_cache.flush_failures = 0;
+    tdl_cache_arm_flush();
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    Read all the TDL keys of the first 'count' positions from PS into the
+    cache, discarding anything cached before.
+*/
+static void tdl_cache_load(uint16 count)
+{
+    uint16 type;
+    uint16 pos;
+
+    for (type = 0; type < TDL_KEY_TYPES; type++)
+    {
+        for (pos = 0; pos < MAX_NO_DEVICES_TO_MANAGE; pos++)
+        {
+            tdl_key_t *entry = &tdl_record_cache.key[type][pos];
+
+            free(entry->data);
+            entry->data = NULL;
+            entry->words = 0;
+
+            if (pos < count)
+            {
+                uint16 words = PsRetrieve(tdl_key_base[type] + pos, NULL, 0);
+
+                if (words)
+                {
+                    entry->data = PanicUnlessMalloc(words * sizeof(uint16));
+                    entry->words = PsRetrieve(tdl_key_base[type] + pos, entry->data, words);
+                }
+            }
+        }
+    }
+
+    tdl_record_cache.dirty = 0;
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    PsRetrieve() for the TDL keys, served from the cache.
+
+RETURNS
+    As PsRetrieve().
+*/
+static uint16 tdl_retrieve(uint16 key, void *buff, uint16 words)
+{
+    tdl_key_t *entry = tdl_cache_key(key, NULL);
+
+    if (!entry)
+    {
+        return PsRetrieve(key, buff, words);
+    }
+
+    if (!entry->data)
+    {
+        return 0;
+    }
+
+    if (!buff && !words)
+    {
+        return entry->words;
+    }
+
+    memmove(buff, entry->data, MIN(words, entry->words) * sizeof(uint16));
+
+    return (entry->words > words) ? 0 : entry->words;
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    PsStore() for the TDL keys. The cache is updated and the key is written
+    back later if its contents have changed.
+
+RETURNS
+    As PsStore().
+*/
+static uint16 tdl_store(uint16 key, const void *buff, uint16 words)
+{
+    uint32 dirty;
+    tdl_key_t *entry = tdl_cache_key(key, &dirty);
+
+    if (!entry)
+    {
+        return PsStore(key, buff, words);
+    }
+
+    if (!words)
+    {
+        if (entry->data)
+        {
+            free(entry->data);
+            entry->data = NULL;
+            entry->words = 0;
+            tdl_cache_set_dirty(dirty);
+        }
+        return 0;
+    }
+
+    if (!entry->data ||
+        entry->words != words ||
+        memcmp(entry->data, buff, words * sizeof(uint16)))
+    {
+        if (entry->words != words)
+        {
+            free(entry->data);
+            entry->data = PanicUnlessMalloc(words * sizeof(uint16));
+            entry->words = words;
+        }
+
+        memmove(entry->data, buff, words * sizeof(uint16));
+        tdl_cache_set_dirty(dirty);
+    }
+
+    return words;
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    PsStore() of a TDL key that is written through to PS at once, for
+    changes whose caller needs to know that they reached PS. The cache is
+    only updated if the write succeeds.
+
+RETURNS
+    As PsStore().
+*/
+static uint16 tdl_store_now(uint16 key, const void *buff, uint16 words)
+{
+    uint32 dirty;
+    tdl_key_t *entry = tdl_cache_key(key, &dirty);
+    uint16 stored;
+
+    if (!entry || !words)
+    {
+        return tdl_store(key, buff, words);
+    }
+
+    stored = PsStore(key, buff, words);
+    if (stored)
+    {
+        (void)tdl_store(key, buff, words);
+        tdl_record_cache.dirty &= ~dirty;
+    }
+
+    return stored;
+}
+
+#else
+
+/* Without the cache the TDL keys are accessed in PS directly */
+#define tdl_retrieve    PsRetrieve
+#define tdl_store       PsStore
+#define tdl_store_now   PsStore
+
+#endif /* CL_TDL_RECORD_CACHE */
+
 
 /****************************************************************************
 
@@ -260,28 +532,124 @@ uint16 ConnectionTrustedDeviceListSize(void)
 /****************************************************************************
 
 DESCRIPTION
-    Store the Trusted Device List Index in to PS and pack it, using 4-bits
-    per index value.
-    Also updates the cached copy (both order and hash)
+    Store the cached Trusted Device List Index in to PS and pack it, using
+    4-bits per index value.
 */
-static void store_trusted_device_index(const td_index_t *tdi)
+static void write_trusted_device_index(void)
 {
     uint16 ps_tdi[TDI_SIZE];
     uint16 i;
 
+    memset(ps_tdi, 0, TDI_SIZE * sizeof(uint16));
+    /* Pack TDI */
+    for (i = 0; i < MAX_NO_DEVICES_TO_MANAGE; i++)
+        ps_tdi[i / 4] |= (tdi_cache.tdi.element[i].order & 0x0F) << (4 * (i % 4));
+
+    PsStore(TRUSTED_DEVICE_INDEX, ps_tdi, TDI_SIZE);
+}
+
+/****************************************************************************
+
+DESCRIPTION
+    Update the cached copy of the Trusted Device List Index (both order and
+    hash) and store it in PS if it has changed.
+*/
+static void store_trusted_device_index(const td_index_t *tdi)
+{
     /* Only store the TDI cache if it has changed */
     if (memcmp(tdi, &tdi_cache.tdi, sizeof(*tdi)))
     {
         /* Update cached copy */
         memmove(&tdi_cache.tdi, tdi, sizeof(*tdi));
 
-        memset(ps_tdi, 0, TDI_SIZE * sizeof(uint16));
-        /* Pack TDI */
-        for (i = 0; i < MAX_NO_DEVICES_TO_MANAGE; i++)
-            ps_tdi[i / 4] |= (tdi_cache.tdi.element[i].order & 0x0F) << (4 * (i % 4));
+#ifdef CL_TDL_RECORD_CACHE
+        tdl_cache_set_dirty(TDL_DIRTY_TDI);
+#else
+        write_trusted_device_index();
+#endif
+    }
+}
 
-        PsStore(TRUSTED_DEVICE_INDEX, ps_tdi, TDI_SIZE);
+/****************************************************************************
+NAME
+    ConnectionTrustedDeviceListFlush
+
+FUNCTION
+    Write back the TDL keys changed in the RAM cache. New and updated keys
+    are stored before the TDI, and deleted keys after it, so that the TDI in
+    PS never refers to a missing device record.
+
+RETURNS
+    void
+*/
+void ConnectionTrustedDeviceListFlush(void)
+{
+#ifdef CL_TDL_RECORD_CACHE
+    uint32 failed = 0;
+    uint16 type;
+    uint16 pos;
+
+    if (tdl_record_cache.flush_pending)
+    {
+        (void)MessageCancelAll(connectionGetCmTask(), CL_INTERNAL_SM_TDL_FLUSH_IND);
+        tdl_record_cache.flush_pending = FALSE;
     }
+
+    for (type = 0; type < TDL_KEY_TYPES; type++)
+    {
+        for (pos = 0; pos < MAX_NO_DEVICES_TO_MANAGE; pos++)
+        {
+            uint32 dirty = (uint32)1 << (type * MAX_NO_DEVICES_TO_MANAGE + pos);
+            const tdl_key_t *entry = &tdl_record_cache.key[type][pos];
+
+            if ((tdl_record_cache.dirty & dirty) && entry->data)
+            {
+                if (!PsStore(tdl_key_base[type] + pos, entry->data, entry->words))
+                {
+                    CL_DEBUG_INFO(("ERROR: Could not write back TDL key %d\n", tdl_key_base[type] + pos));
+                    failed |= dirty;
+                }
+            }
+        }
+    }
+
+    if (tdl_record_cache.dirty & TDL_DIRTY_TDI)
+    {
+        write_trusted_device_index();
+    }
+
+    for (type = 0; type < TDL_KEY_TYPES; type++)
+    {
+        for (pos = 0; pos < MAX_NO_DEVICES_TO_MANAGE; pos++)
+        {
+            uint32 dirty = (uint32)1 << (type * MAX_NO_DEVICES_TO_MANAGE + pos);
+
+            if ((tdl_record_cache.dirty & dirty) && !tdl_record_cache.key[type][pos].data)
+            {
+                (void)PsStore(tdl_key_base[type] + pos, NULL, 0);
+            }
+        }
+    }
+
+    /* Keys that could not be stored stay dirty and are tried again a few
+     * times, after that only on the next change or explicit flush. */
+    tdl_record_cache.dirty = failed;
+
+    if (!failed)
+    {
+        tdl_record_cache.flush_failures = 0;
+    }
+    else if (++tdl_record_cache.flush_failures < TDL_FLUSH_RETRIES)
+    {
+        tdl_cache_arm_flush();
+    }
+    else
+    {
+        CL_DEBUG_INFO(("ERROR: TDL write back failed %d times, waiting for the next change\n",
+                       tdl_record_cache.flush_failures));
+        tdl_record_cache.flush_failures = 0;
+    }
+#endif
 }
 
 
@@ -712,7 +1080,7 @@ static td_data_t *tdl_find_device(
                         )
 {
     td_data_t *td = (td_data_t *) PanicUnlessMalloc(SIZE_TD_DATA_T);
-    typed_bdaddr *dev_taddr = PanicUnlessNew(typed_bdaddr);
+    typed_bdaddr dev_taddr;
     uint16 used = 0;
     uint16 pos;
     uint16 idx;
@@ -726,13 +1094,13 @@ static td_data_t *tdl_find_device(
         if( GET_TDI_CACHE.element[idx].hash == TDI_HASH(*addr) ||
             GET_TDI_CACHE.element[idx].hash == TDI_HASH_UNUSED )
         {
-            if (PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
+            if (tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
             {
-                dev_taddr->type = unpack_td_bdaddr(&dev_taddr->addr, td);
+                dev_taddr.type = unpack_td_bdaddr(&dev_taddr.addr, td);
 
                 if (
-                    dev_taddr->type == addr_type &&
-                    BdaddrIsSame(&dev_taddr->addr, addr)
+                    dev_taddr.type == addr_type &&
+                    BdaddrIsSame(&dev_taddr.addr, addr)
                     )
                 {
                     /* found our device */
@@ -767,7 +1135,7 @@ static td_data_t *tdl_find_device(
         for(idx = max_trusted_devices - 1; idx != 0; idx--)
         {
             pos = GET_TDI_CACHE.element[idx].order;
-            if(PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
+            if(tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
             {
                 if(!(td->content.priority_device))
                     break;
@@ -780,8 +1148,6 @@ static td_data_t *tdl_find_device(
     td = NULL;
 
 out:
-    free(dev_taddr);
-
     if (pp)
     {
         *pp = pos;
@@ -841,13 +1207,13 @@ static void delete_from_security_manager(uint16 pos)
     td_data_t td;
 
     /* Verify there is a TDL entry in this 'pos'. */
-    if (PsRetrieve(TRUSTED_DEVICE_LIST + pos,  NULL, 0))
+    if (tdl_retrieve(TRUSTED_DEVICE_LIST + pos,  NULL, 0))
     {
         typed_bdaddr addrt;
         MAKE_PRIM_T(DM_SM_REMOVE_DEVICE_REQ);
 
         /* Don't have to read all the TDL entry data. */
-        PsRetrieve(TRUSTED_DEVICE_LIST + pos, &td, PS_SIZE_ADJ(SIZE_TD));
+        tdl_retrieve(TRUSTED_DEVICE_LIST + pos, &td, PS_SIZE_ADJ(SIZE_TD));
         
         addrt.type = unpack_td_bdaddr(&addrt.addr, &td);
         BdaddrConvertTypedVmToBluestack(&prim->addrt, &addrt);
@@ -882,16 +1248,16 @@ static uint16 delete_from_trusted_device_list(uint16 pos, uint16 idx)
     store_trusted_device_index(&tdi);
 
     /* Delete the list entry */
-    PsStore(TRUSTED_DEVICE_LIST + pos, NULL, 0);
+    tdl_store(TRUSTED_DEVICE_LIST + pos, NULL, 0);
 
     /* Delete any associated attribute data, if it exists. */
-    if(PsRetrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
+    if(tdl_retrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
     {
-        PsStore(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
+        tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
     }
 
     /* Delete any associated GATT attribute data */
-    PsStore(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, NULL, 0);
+    tdl_store(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, NULL, 0);
 
     return TRUE;
 }
@@ -967,6 +1333,9 @@ uint16 connectionInitTrustedDeviceList(void)
     td_data_t *td;
     uint16 max_trusted_devices = MAX_TRUSTED_DEVICES;
 
+    /* Do not lose changes not yet written back if re-initialised. */
+    ConnectionTrustedDeviceListFlush();
+
     /* Set the TDI RAM cache as invalid so that
      * it will be cached from the PS store on first read. */
     memset(&tdi_cache, 0, sizeof(tdi_cache));
@@ -976,13 +1345,18 @@ uint16 connectionInitTrustedDeviceList(void)
     /* Read TDI from PS */
     read_trusted_device_index(NULL);
 
+#ifdef CL_TDL_RECORD_CACHE
+    /* Read all the device records and attributes from PS */
+    tdl_cache_load(max_trusted_devices);
+#endif
+
     td = PanicUnlessMalloc(SIZE_TD_DATA_T);
 
     for (i = 0;
          i < max_trusted_devices && (pos = GET_TDI_CACHE.element[i].order) != TDI_ORDER_UNUSED;
          i++)
     {
-        if (PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
+        if (tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
         {
             bdaddr tempAddr;
 
@@ -1058,9 +1432,9 @@ bool connectionAuthAddDevice(const CL_INTERNAL_SM_ADD_AUTH_DEVICE_REQ_T *req)
             delete_from_trusted_device_list(pos, idx);
 
             /* Delete any associated attribute data, if it exists. */
-            if(PsRetrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
+            if(tdl_retrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
             {
-                PsStore(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
+                tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
             }
         }
     }
@@ -1078,9 +1452,9 @@ bool connectionAuthAddDevice(const CL_INTERNAL_SM_ADD_AUTH_DEVICE_REQ_T *req)
         pack_td_bdaddr(td, TYPED_BDADDR_PUBLIC, &req->bd_addr);
         
         /* Delete any associated attribute data, if it exists. */
-        if(PsRetrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
+        if(tdl_retrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
         {
-            PsStore(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
+            tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
         }
     }
 
@@ -1107,8 +1481,10 @@ bool connectionAuthAddDevice(const CL_INTERNAL_SM_ADD_AUTH_DEVICE_REQ_T *req)
 
         pack_td_security_requirements(td, sec_req);
 
-        /* Store trusted device persistently in the list */
-        if  ( !PsStore(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td))) )
+        /* Store trusted device persistently in the list. The record is
+         * written now even with the record cache, so that a full PS fails
+         * the pairing as it does without the cache. */
+        if  ( !tdl_store_now(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td))) )
         {
             ok = FALSE;
         }
@@ -1212,9 +1588,9 @@ bool connectionAuthDeleteDevice(
             delete_from_trusted_device_list(pos, idx);
 
             /* Delete any associated attribute data, if it exists. */
-            if(PsRetrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
+            if(tdl_retrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
             {
-                PsStore(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
+                tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
             }
 
             result = TRUE;
@@ -1263,7 +1639,7 @@ bool connectionAuthDeleteAllDevice(uint16 ps_base)
     {
         if  ((tdi.element[rec].order != TDI_ORDER_UNUSED)
               &&
-              PsRetrieve(
+              tdl_retrieve(
                 TRUSTED_DEVICE_LIST + tdi.element[rec].order,
                 td,
                 PS_SIZE_ADJ(SIZE_TD_DATA_T)
@@ -1278,16 +1654,16 @@ bool connectionAuthDeleteAllDevice(uint16 ps_base)
                 unpack_td_TYPED_BDADDR_T(&prim->addrt, td);
 
                 /* Delete entry from TDL */
-                (void)PsStore(TRUSTED_DEVICE_LIST + tdi.element[rec].order, NULL, 0);
+                (void)tdl_store(TRUSTED_DEVICE_LIST + tdi.element[rec].order, NULL, 0);
                 deleted = TRUE;
 
                 VmSendDmPrim(prim);
 
                 /* Delete any associated attribute data */
-                (void)PsStore(PSKEY_TDL_ATTRIBUTE_BASE + tdi.element[rec].order, NULL, 0);
+                (void)tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + tdi.element[rec].order, NULL, 0);
 
                 /* Delete any associated GATT attribute data */
-                (void)PsStore(PSKEY_TDL_GATT_ATTRIBUTE_BASE + tdi.element[rec].order, NULL, 0);
+                (void)tdl_store(PSKEY_TDL_GATT_ATTRIBUTE_BASE + tdi.element[rec].order, NULL, 0);
 
                 /* set index value to unused after device is deleted */
                 tdi.element[rec].order = TDI_ORDER_UNUSED;
@@ -1331,7 +1707,7 @@ bool connectionAuthSetTrustLevel(const bdaddr* peer_bd_addr, uint16 trusted)
         td->content.trusted = trusted ? TRUE : FALSE;
 
         /* Store the record */
-        PsStore(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td)));
+        tdl_store(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td)));
 
         /* Update Bluestack Security Manager Database */
         dm_sm_add_device_req(td);
@@ -1373,7 +1749,7 @@ bool ConnectionAuthSetPriorityDevice(
         td->content.priority_device = is_priority_device ? TRUE : FALSE;
 
         /* Store the record */
-        PsStore(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td)));
+        tdl_store(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td)));
 
         /* update the MRU status of the device */
         update_trusted_device_index(pos, idx);
@@ -1402,7 +1778,7 @@ bool ConnectionAuthSetPriorityDevice(
                 }
 
                 /* otherwise get device's priority */
-                PsRetrieve(
+                tdl_retrieve(
                         TRUSTED_DEVICE_LIST + tdi.element[index].order,
                         td,
                         PS_SIZE_ADJ(SIZE_TD_DATA_T)
@@ -1553,7 +1929,7 @@ void connectionAuthPutAttribute(
 
     if (td != NULL)
     {
-        PsStore(PSKEY_TDL_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata));
+        tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata));
         free(td);
     }
 }
@@ -1639,7 +2015,7 @@ bool connectionAuthGetAttributeNow(
         if(size_psdata)
         {
             /* Read attribute data */
-            if(PsRetrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata)))
+            if(tdl_retrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata)))
             {
                 return TRUE;
             }
@@ -1732,7 +2108,7 @@ bool connectionAuthGetIndexedAttributeNow(
         /* Read the device record from the Trusted Device List */
         if  (
             GET_TDI_CACHE.element[mru_index].order != TDI_ORDER_UNUSED &&
-            PsRetrieve(
+            tdl_retrieve(
                 (TRUSTED_DEVICE_LIST + GET_TDI_CACHE.element[mru_index].order),
                 td,
                 PS_SIZE_ADJ(SIZE_TD_DATA_T)
@@ -1747,7 +2123,7 @@ bool connectionAuthGetIndexedAttributeNow(
             {
                 /* Read attribute data */
                 if  (
-                    PsRetrieve(
+                    tdl_retrieve(
                         PSKEY_TDL_ATTRIBUTE_BASE + GET_TDI_CACHE.element[mru_index].order,
                         psdata,
                         PS_SIZE_ADJ(size_psdata))
@@ -1789,7 +2165,7 @@ uint16 connectionAuthGetIndexedAttributeSizeNow( uint16 mru_index )
         GET_TDI_CACHE.element[mru_index].order != TDI_ORDER_UNUSED )
     {
         /* Read attribute data size, convert the value to octets */
-        size = PsRetrieve(
+        size = tdl_retrieve(
                 PSKEY_TDL_ATTRIBUTE_BASE + GET_TDI_CACHE.element[mru_index].order,
                 NULL, 0) * sizeof(uint16);
     }
@@ -1818,7 +2194,7 @@ void ConnectionPutGattAttribute(
 
     if (td != NULL)
     {
-        PsStore(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata));
+        tdl_store(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata));
         free(td);
     }
 }
@@ -1848,7 +2224,7 @@ bool ConnectionGetGattAttribute(
         free(td);
 
         /* Read attribute data */
-        if(PsRetrieve(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata)))
+        if(tdl_retrieve(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, psdata, PS_SIZE_ADJ(size_psdata)))
         {
             return TRUE;
         }
@@ -1921,7 +2297,7 @@ uint8 ConnectionGattTdlBootSequence(bool hashes_matched, tp_bdaddr *device_list,
          i < max_trusted_devices && (pos = GET_TDI_CACHE.element[i].order) != TDI_ORDER_UNUSED;
          i++)
     {
-        if(PsRetrieve(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, gd, PS_SIZE_ADJ(SIZE_TD)))
+        if(tdl_retrieve(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, gd, PS_SIZE_ADJ(SIZE_TD)))
         {
             /* If the DB hashes didn't match, a DB change has occured since the last boot, thus 
              * every trusted client is now change-unaware. Update their status accordingly.
@@ -1929,7 +2305,7 @@ uint8 ConnectionGattTdlBootSequence(bool hashes_matched, tp_bdaddr *device_list,
             if (!hashes_matched)
             {
                 gd->content.change_aware = 0;
-                PsStore(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, gd, PS_SIZE_ADJ(SIZE_TD));
+                tdl_store(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, gd, PS_SIZE_ADJ(SIZE_TD));
             }
             
             if (gd->content.robust_caching)
@@ -1987,9 +2363,9 @@ void connectionAuthUpdateTdl(
         td = (td_data_t *)PanicNull( calloc(1, SIZE_TD_DATA_T));
         pack_td_bdaddr(td, taddr->type, &taddr->addr);
 
-        if(PsRetrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
+        if(tdl_retrieve(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0))
         {
-            PsStore(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
+            tdl_store(PSKEY_TDL_ATTRIBUTE_BASE + pos, NULL, 0);
         }
 
         /* Since this is a new trusted device, set up and store a
@@ -2002,7 +2378,7 @@ void connectionAuthUpdateTdl(
         pack_td_bdaddr((td_data_t *)gd, taddr->type, &taddr->addr);
         gd->content.change_aware = 1;
         gd->content.robust_caching = 0;
-        PsStore(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, gd, PS_SIZE_ADJ(SIZE_TD));
+        tdl_store(PSKEY_TDL_GATT_ATTRIBUTE_BASE + pos, gd, PS_SIZE_ADJ(SIZE_TD));
         
         free(gd);
 
@@ -2056,7 +2432,7 @@ void connectionAuthUpdateTdl(
     }
 
     /* Update the trusted device list to indicate this was the most recent. */
-    if ( PsStore(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td))) )
+    if ( tdl_store(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(CALC_TD_SIZE(td))) )
     {
         update_trusted_device_index(pos, idx);
     }
@@ -2112,7 +2488,7 @@ void connectionAddDeviceAtTdlPosition(uint8 pos)
 {
     td_data_t *td = PanicUnlessMalloc(SIZE_TD_DATA_T);
 
-    PanicZero(PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)));
+    PanicZero(tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)));
     dm_sm_add_device_req(td);
     free(td);
 }
@@ -2143,7 +2519,7 @@ void ConnectionDmBleAddTdlDevicesToWhiteListReq(bool ble_only_devices)
          i < max_trusted_devices && (pos = GET_TDI_CACHE.element[i].order) != TDI_ORDER_UNUSED;
          i++)
     {
-        if (PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
+        if (tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
         {
             /* If only adding BLE devices and there are no BLE link keys
              * for this device, then continue to the next in the list.
@@ -2189,7 +2565,7 @@ bool ConnectionBondedToPrivacyEnabledDevice(void)
          i < max_trusted_devices && (pos = GET_TDI_CACHE.element[i].order) != TDI_ORDER_UNUSED;
          i++)
     {
-        if (PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
+        if (tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, PS_SIZE_ADJ(SIZE_TD_DATA_T)))
         {
             /* Check for the IRK (ID link key).
              * This indicates that we have bonded with a device using privacy.
@@ -2230,7 +2606,7 @@ bool ConnectionDmBleCheckTdlDeviceAvailable(void)
          i < max_trusted_devices && (pos = GET_TDI_CACHE.element[i].order) != TDI_ORDER_UNUSED;
          i++)
     {
-        if (PsRetrieve(TRUSTED_DEVICE_LIST + pos, td, SIZE_TD_DATA_T))
+        if (tdl_retrieve(TRUSTED_DEVICE_LIST + pos, td, SIZE_TD_DATA_T))
         {
             /* check if there are BLE link keys for this device.
              */
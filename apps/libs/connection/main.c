@@ -0,0 +1,471 @@
+/* Copyright (c) 2019 Qualcomm Technologies International, Ltd. */
+/*  */
+/* Host test harness for the Trusted Device List. The traps used by
+   connection_tdl.c are replaced by a mock persistent store that counts
+   the reads and writes, so that builds with and without
+   CL_TDL_RECORD_CACHE can be compared running the same sequence of
+   pairings, link key requests, MRU updates and attribute accesses. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "connection.h"
+#include "connection_private.h"
+#include "connection_tdl.h"
+
+#include <bdaddr.h>
+#include <ps.h>
+
+/* Number of connection events in the test */
+#define TEST_EVENTS             20000
+
+/* Connection events per second, the write back timer runs once a second */
+#define TEST_EVENTS_PER_SECOND  10
+
+/* Size of the application attribute data in bytes */
+#define TEST_ATTRIBUTE_SIZE     16
+
+/* Most device ids used in the test */
+#define TEST_MAX_IDS            512
+
+#define MOCK_PS_KEYS            200
+#define MOCK_PS_MAX_WORDS       64
+
+/* Mock persistent store */
+static uint16 ps_data[MOCK_PS_KEYS][MOCK_PS_MAX_WORDS];
+static uint16 ps_words[MOCK_PS_KEYS];
+
+static unsigned long ps_reads;
+static unsigned long ps_writes;
+static unsigned long ps_words_written;
+static bool ps_fail;
+
+static connectionState theCm;
+static bool flush_pending;
+
+/* Application attribute data last written for each device id */
+static uint16 attribute_value[TEST_MAX_IDS];
+
+uint16 PsRetrieve(uint16 key, void *buff, uint16 words)
+{
+    ps_reads++;
+
+    if (key >= MOCK_PS_KEYS || !ps_words[key])
+        return 0;
+
+    if (!buff && !words)
+        return ps_words[key];
+
+    if (ps_words[key] > words)
+        return 0;
+
+    memmove(buff, ps_data[key], ps_words[key] * sizeof(uint16));
+    return ps_words[key];
+}
+
+uint16 PsStore(uint16 key, const void *buff, uint16 words)
+{
+    ps_writes++;
+
+    if (ps_fail || key >= MOCK_PS_KEYS || words > MOCK_PS_MAX_WORDS)
+        return 0;
+
+    ps_words_written += words;
+    ps_words[key] = words;
+    if (words)
+        memmove(ps_data[key], buff, words * sizeof(uint16));
+    return words;
+}
+
+Task connectionGetCmTask(void)
+{
+    return &theCm.task;
+}
+
+void MessageSend(Task task, MessageId id, void *message)
+{
+    UNUSED(task);
+    UNUSED(id);
+    free(message);
+}
+
+void MessageSendLater(Task task, MessageId id, void *message, uint32 delay)
+{
+    UNUSED(task);
+    UNUSED(delay);
+    if (id == CL_INTERNAL_SM_TDL_FLUSH_IND)
+        flush_pending = TRUE;
+    free(message);
+}
+
+uint16 MessageCancelAll(Task task, MessageId id)
+{
+    UNUSED(task);
+    if (id == CL_INTERNAL_SM_TDL_FLUSH_IND && flush_pending)
+    {
+        flush_pending = FALSE;
+        return 1;
+    }
+    return 0;
+}
+
+void VmSendDmPrim(void *prim)
+{
+    free(prim);
+}
+
+void *VmGetHandleFromPointer(void *pointer)
+{
+    return pointer;
+}
+
+void Panic(void)
+{
+    printf("Panic!\n");
+    exit(1);
+}
+
+void *PanicNull(void *ptr)
+{
+    if (!ptr)
+        Panic();
+    return ptr;
+}
+
+void *PanicUnlessMalloc(size_t sz)
+{
+    return PanicNull(malloc(sz));
+}
+
+bool BdaddrIsSame(const bdaddr *first, const bdaddr *second)
+{
+    return first->lap == second->lap && first->uap == second->uap &&
+           first->nap == second->nap;
+}
+
+void BdaddrConvertTypedBluestackToVm(typed_bdaddr *out, const TYPED_BD_ADDR_T *in)
+{
+    out->type = (in->type == TBDADDR_PUBLIC) ? TYPED_BDADDR_PUBLIC : TYPED_BDADDR_RANDOM;
+    out->addr.lap = in->addr.lap;
+    out->addr.uap = in->addr.uap;
+    out->addr.nap = in->addr.nap;
+}
+
+void BdaddrConvertTypedVmToBluestack(TYPED_BD_ADDR_T *out, const typed_bdaddr *in)
+{
+    out->type = (in->type == TYPED_BDADDR_PUBLIC) ? TBDADDR_PUBLIC : TBDADDR_RANDOM;
+    out->addr.lap = in->addr.lap;
+    out->addr.uap = in->addr.uap;
+    out->addr.nap = in->addr.nap;
+}
+
+cl_sm_link_key_type connectionConvertLinkKeyType(uint8_t link_key_type)
+{
+    return (cl_sm_link_key_type)link_key_type;
+}
+
+void ConnectionDmBleAddDeviceToWhiteListReq(uint8 type, const bdaddr *bd_addr)
+{
+    UNUSED(type);
+    UNUSED(bd_addr);
+}
+
+/* The application task handling the write back timer */
+static void run_timer(void)
+{
+    if (flush_pending)
+        ConnectionTrustedDeviceListFlush();
+}
+
+static void make_addr(uint16 id, bdaddr *addr)
+{
+    addr->lap = 0x100000 + id;
+    addr->uap = 0x5b;
+    addr->nap = 0x0002;
+}
+
+static uint16 link_key_word(uint16 id, uint16 i)
+{
+    return (uint16)(id * 0x0101 + i);
+}
+
+static void make_attribute(uint16 value, uint16 *data)
+{
+    uint16 i;
+    for (i = 0; i < TEST_ATTRIBUTE_SIZE / sizeof(uint16); i++)
+        data[i] = (uint16)(value + i);
+}
+
+static void pair_device(uint16 id)
+{
+    CL_INTERNAL_SM_ADD_AUTH_DEVICE_REQ_T req;
+    uint16 data[TEST_ATTRIBUTE_SIZE / sizeof(uint16)];
+    uint16 i;
+
+    memset(&req, 0, sizeof(req));
+    make_addr(id, &req.bd_addr);
+    req.enc_bredr.link_key_type = DM_SM_LINK_KEY_UNAUTHENTICATED_P192;
+    for (i = 0; i < 8; i++)
+        req.enc_bredr.link_key[i] = link_key_word(id, i);
+    req.trusted = TRUE;
+    req.bonded = TRUE;
+
+    if (!connectionAuthAddDevice(&req))
+        printf("Add device %u failed\n", id);
+
+    attribute_value[id] = id;
+    make_attribute(id, data);
+    connectionAuthPutAttribute(0, TYPED_BDADDR_PUBLIC, &req.bd_addr,
+                               TEST_ATTRIBUTE_SIZE, (const uint8 *)data);
+}
+
+/* A device connects: link key request, security check, MRU update and
+   reading the application attributes. Returns the number of errors. */
+static unsigned connect_device(uint16 id)
+{
+    typed_bdaddr taddr;
+    cl_sm_link_key_type type;
+    uint16 key[8];
+    uint16 trusted;
+    uint16 data[TEST_ATTRIBUTE_SIZE / sizeof(uint16)];
+    uint16 expected[TEST_ATTRIBUTE_SIZE / sizeof(uint16)];
+    unsigned errors = 0;
+    uint16 i;
+
+    taddr.type = TYPED_BDADDR_PUBLIC;
+    make_addr(id, &taddr.addr);
+
+    if (!connectionAuthGetDevice(&taddr.addr, &type, key, &trusted))
+        return 0;
+
+    for (i = 0; i < 8; i++)
+        if (key[i] != link_key_word(id, i))
+            errors++;
+
+    (void)connectionCheckSecurityRequirement(&taddr);
+    (void)connectionAuthUpdateMru(&taddr.addr);
+
+    make_attribute(attribute_value[id], expected);
+    if (!connectionAuthGetAttributeNow(0, TYPED_BDADDR_PUBLIC, &taddr.addr,
+                                       TEST_ATTRIBUTE_SIZE, (uint8 *)data) ||
+        memcmp(data, expected, sizeof(data)))
+        errors++;
+
+    return errors;
+}
+
+/* Check every device in the TDL after a reboot */
+static unsigned check_after_reboot(void)
+{
+    uint16 count;
+    uint16 i;
+    unsigned errors = 0;
+
+    count = connectionInitTrustedDeviceList();
+    for (i = 0; i < count; i++)
+    {
+        uint16 data[TEST_ATTRIBUTE_SIZE / sizeof(uint16)];
+        typed_bdaddr taddr;
+        uint16 id;
+
+        if (!connectionAuthGetIndexedAttributeNow(0, i, TEST_ATTRIBUTE_SIZE,
+                                                  (uint8 *)data, &taddr))
+        {
+            errors++;
+            continue;
+        }
+
+        id = (uint16)(taddr.addr.lap - 0x100000);
+        errors += connect_device(id);
+    }
+    return errors;
+}
+
+static unsigned long ps_checksum(void)
+{
+    unsigned long sum = 0;
+    uint16 key, i;
+
+    for (key = 0; key < MOCK_PS_KEYS; key++)
+    {
+        sum = sum * 31 + ps_words[key];
+        for (i = 0; i < ps_words[key]; i++)
+            sum = sum * 31 + ps_data[key][i];
+    }
+    return sum;
+}
+
+/* A pairing that PS cannot store fails, with or without the cache, and
+   the device is not there after a reboot */
+static unsigned check_failed_add(uint16 id)
+{
+    CL_INTERNAL_SM_ADD_AUTH_DEVICE_REQ_T req;
+    cl_sm_link_key_type type;
+    uint16 key[8];
+    uint16 trusted;
+    unsigned errors = 0;
+
+    memset(&req, 0, sizeof(req));
+    make_addr(id, &req.bd_addr);
+    req.enc_bredr.link_key_type = DM_SM_LINK_KEY_UNAUTHENTICATED_P192;
+    req.trusted = TRUE;
+    req.bonded = TRUE;
+
+    ps_fail = TRUE;
+    if (connectionAuthAddDevice(&req))
+    {
+        printf("  Add device succeeded with PS full\n");
+        errors++;
+    }
+    ps_fail = FALSE;
+
+    if (connectionAuthGetDevice(&req.bd_addr, &type, key, &trusted))
+    {
+        printf("  Device found after a failed add\n");
+        errors++;
+    }
+
+    ConnectionTrustedDeviceListFlush();
+    connectionInitTrustedDeviceList();
+    if (connectionAuthGetDevice(&req.bd_addr, &type, key, &trusted))
+    {
+        printf("  Device found after a reboot\n");
+        errors++;
+    }
+    printf("  Failed add device: %s\n", errors ? "FAIL!" : "OK");
+    return errors;
+}
+
+#ifdef CL_TDL_RECORD_CACHE
+/* A write back that fails leaves the keys dirty and arms the timer again,
+   a bounded number of times, so that they are stored once PS accepts them
+   without the timer running for ever while it does not */
+static unsigned check_failed_write_back(uint16 id)
+{
+    unsigned errors = 0;
+    unsigned runs = 0;
+
+    pair_device(id);
+    ps_fail = TRUE;
+    run_timer();
+
+    if (!flush_pending)
+    {
+        printf("  Write back not retried\n");
+        errors++;
+    }
+
+    while (flush_pending && runs < 100)
+    {
+        run_timer();
+        runs++;
+    }
+    ps_fail = FALSE;
+
+    if (runs + 1 > 3)
+    {
+        printf("  Write back tried %u times\n", runs + 1);
+        errors++;
+    }
+
+    /* Given up on by the timer, still written by an explicit flush */
+    ConnectionTrustedDeviceListFlush();
+    if (flush_pending)
+        errors++;
+
+    errors += check_after_reboot();
+    printf("  Failed write back: %s\n", errors ? "FAIL!" : "OK");
+    return errors;
+}
+#endif
+
+int main(void)
+{
+    static const uint16 pattern[] = { 0, 1, 0, 2, 1, 0, 3, 1, 0, 4, 1, 5, 0, 1, 6, 7 };
+    uint16 recent[MAX_NO_DEVICES_TO_MANAGE];
+    uint16 next_id = 0;
+    unsigned errors = 0;
+    clock_t start;
+    uint32 event;
+    uint16 i;
+
+    theCm.smState.TdlNumberOfDevices = MAX_NO_DEVICES_TO_MANAGE;
+
+    /* Pair a full list of devices */
+    connectionInitTrustedDeviceList();
+    for (i = 0; i < MAX_NO_DEVICES_TO_MANAGE; i++)
+    {
+        recent[i] = next_id;
+        pair_device(next_id++);
+    }
+    ConnectionTrustedDeviceListFlush();
+
+#ifdef CL_TDL_RECORD_CACHE
+    printf("TDL with the record cache\n");
+#else
+    printf("TDL without the record cache\n");
+#endif
+
+    ps_reads = ps_writes = ps_words_written = 0;
+    connectionInitTrustedDeviceList();
+    printf("  Init:   %lu PS reads\n", ps_reads);
+
+    ps_reads = ps_writes = ps_words_written = 0;
+    start = clock();
+
+    for (event = 0; event < TEST_EVENTS; event++)
+    {
+        uint16 id = recent[pattern[event % 16]];
+        typed_bdaddr taddr;
+
+        errors += connect_device(id);
+
+        /* Application changes its attributes, e.g. the volume */
+        if (event % 5 == 0)
+        {
+            uint16 data[TEST_ATTRIBUTE_SIZE / sizeof(uint16)];
+
+            attribute_value[id] = (uint16)event;
+            make_attribute(attribute_value[id], data);
+            make_addr(id, &taddr.addr);
+            connectionAuthPutAttribute(0, TYPED_BDADDR_PUBLIC, &taddr.addr,
+                                       TEST_ATTRIBUTE_SIZE, (const uint8 *)data);
+        }
+
+        /* New device pairs, replacing the oldest */
+        if (event % 97 == 96 && next_id < TEST_MAX_IDS)
+        {
+            memmove(&recent[1], &recent[0], sizeof(recent) - sizeof(recent[0]));
+            recent[0] = next_id;
+            pair_device(next_id++);
+        }
+
+        /* User deletes a device */
+        if (event % 1000 == 999)
+        {
+            make_addr(recent[MAX_NO_DEVICES_TO_MANAGE - 1], &taddr.addr);
+            (void)connectionAuthDeleteDevice(TYPED_BDADDR_PUBLIC, &taddr.addr);
+        }
+
+        if (event % TEST_EVENTS_PER_SECOND == TEST_EVENTS_PER_SECOND - 1)
+            run_timer();
+    }
+    ConnectionTrustedDeviceListFlush();
+
+    printf("  Run:    %u events, %ld ms\n", TEST_EVENTS,
+           (long)((clock() - start) * 1000 / CLOCKS_PER_SEC));
+    printf("          %lu PS reads, %lu PS writes, %lu words written\n",
+           ps_reads, ps_writes, ps_words_written);
+    printf("  PS checksum %08lx\n", ps_checksum() & 0xffffffffUL);
+
+    errors += check_after_reboot();
+    errors += check_failed_add(next_id++);
+#ifdef CL_TDL_RECORD_CACHE
+    errors += check_failed_write_back(next_id);
+#endif
+    printf("  %s\n", errors ? "FAIL!" : "OK");
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+/*
+Copyright (c) 2005 - 2015 Qualcomm Technologies International, Ltd.
+
+*/
+
+#include "digest.h"
+
+uint16 DigestLength(digest_type type)
+{
+    return type == digest_sha256 ? SHA256_DIGEST_LEN : MD5_DIGEST_LEN;
+}
+
+void DigestInit(DIGEST_CTX *context, digest_type type)
+{
+    context->type = type;
+    if(type == digest_sha256)
+        SHA256Init(&context->u.sha256);
+    else
+        MD5Init(&context->u.md5);
+}
+
+void DigestUpdate(DIGEST_CTX *context, const uint8 *bytes, uint16 len)
+{
+    if(context->type == digest_sha256)
+        SHA256Update(&context->u.sha256, bytes, len);
+    else
+        MD5Update(&context->u.md5, bytes, len);
+}
+
+void DigestFinal(uint8 *digest, DIGEST_CTX *context)
+{
+    if(context->type == digest_sha256)
+        SHA256Final(digest, &context->u.sha256);
+    else
+        MD5Final(digest, &context->u.md5);
+}
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2005 - 2015 Qualcomm Technologies International, Ltd.
+
+*/
+
+/*
+Generic incremental message digest. Wraps the MD5 and SHA-256 contexts
+so that a caller hashing a stream (a partition being written, a prompt
+file being read) can pick the algorithm at run time and feed the data
+as it arrives, in chunks of any size, without staging it in RAM.
+
+Data presented in whole 64-byte blocks at a block boundary is digested
+straight from the caller's buffer; only the tail of a chunk is collected
+in the context.
+*/
+#ifndef DIGEST_H_
+#define DIGEST_H_
+
+#include <csrtypes.h>
+
+#include "md5.h"
+#include "sha256.h"
+
+#define DIGEST_MAX_LEN SHA256_DIGEST_LEN
+
+typedef enum
+{
+    digest_md5,
+    digest_sha256
+} digest_type;
+
+typedef struct
+{
+    digest_type type;
+    union
+    {
+        MD5_CTX md5;
+        SHA256_CTX sha256;
+    } u;
+} DIGEST_CTX;
+
+/*!
+  @brief Length in bytes of the digest produced by an algorithm.
+*/
+uint16 DigestLength(digest_type type);
+
+/*!
+  @brief Initialise a DIGEST_CTX for the given algorithm.
+*/
+void DigestInit(DIGEST_CTX *, digest_type type);
+
+/*!
+   @brief Update a DIGEST_CTX with the next chunk of data.
+*/
+void DigestUpdate(DIGEST_CTX *, const uint8 *bytes, uint16 len);
+
+/*! 
+   @brief Extract the digest from the DIGEST_CTX.
+
+   digest must have room for DigestLength() bytes.
+*/
+void DigestFinal(uint8 *digest, DIGEST_CTX *);
+
+#endif /* DIGEST_H_ */
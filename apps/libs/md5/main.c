@@ -1,24 +1,27 @@
 /* Copyright (c) 2005 - 2015 Qualcomm Technologies International, Ltd. */
 /*  */
-/* Test harness for MD5 */
+/* Test harness and throughput benchmark for MD5 and SHA-256 */
 
 #include <stdio.h>
 #include <string.h>
 #include <vm.h>
 
-#include "md5.h"
+#include "digest.h"
 
 /* Length of test block, number of test blocks.  */
 #define TEST_BLOCK_LEN   1000
 #define TEST_BLOCK_COUNT 1000
 
+static const char *digest_name(digest_type type)
+{ return type == digest_sha256 ? "SHA256" : "MD5"; }
+
 static void puthex(unsigned int nibble)
 { putchar("0123456789abcdef"[nibble&15]); }
 
-static void print_digest(unsigned char digest[16])
+static void print_digest(const unsigned char *digest, unsigned int len)
 {
     unsigned int i;
-    for(i = 0; i < 16; i++)
+    for(i = 0; i < len; i++)
     {
         puthex(digest[i]>>4);
         puthex(digest[i]);
@@ -28,17 +31,17 @@ static void print_digest(unsigned char digest[16])
 /* Measures the time to digest TEST_BLOCK_COUNT TEST_BLOCK_LEN-byte
    blocks.
 */
-static void time_trial(void)
+static void time_trial(digest_type type)
 {
-    MD5_CTX context;
+    DIGEST_CTX context;
     uint32 endTime, startTime;
-    unsigned char block[TEST_BLOCK_LEN], digest[16];
+    unsigned char block[TEST_BLOCK_LEN], digest[DIGEST_MAX_LEN];
     unsigned int i;
 
 
     printf
-        ("MD5 time trial. Digesting %d %d-byte blocks ...",
-         TEST_BLOCK_LEN, TEST_BLOCK_COUNT);
+        ("%s time trial. Digesting %d %d-byte blocks ...",
+         digest_name(type), TEST_BLOCK_COUNT, TEST_BLOCK_LEN);
 
     /* Initialize block */
     for(i = 0; i < TEST_BLOCK_LEN; i++)
@@ -48,69 +51,120 @@ static void time_trial(void)
     startTime = VmGetClock();
 
     /* Digest blocks */
-    MD5Init(&context);
+    DigestInit(&context, type);
     for(i = 0; i < TEST_BLOCK_COUNT; i++)
-        MD5Update(&context, block, TEST_BLOCK_LEN);
-    MD5Final(digest, &context);
+        DigestUpdate(&context, block, TEST_BLOCK_LEN);
+    DigestFinal(digest, &context);
 
     /* Stop timer */
     endTime = VmGetClock();
+    if(endTime == startTime)
+        ++endTime;
 
     printf(" done\n");
     printf("Digest = ");
-    print_digest(digest);
+    print_digest(digest, DigestLength(type));
     printf("\nTime = %ld ms\n",(long)(endTime-startTime));
     printf
         ("Speed = %ld bytes/second\n",
         (long)TEST_BLOCK_LEN *(long)TEST_BLOCK_COUNT *(long) 1000/(endTime-startTime));
 }
 
-/* Digests a reference suite of strings and prints the results.
- */
+/* Digests input in one call, then again in chunks of every size from
+   1 to 97 bytes so that both the buffered and direct block paths are
+   exercised, and checks every result against the expected digest.
+*/
 
-static void verify(const char *input, const unsigned char *expected)
+static void verify(digest_type type, const char *input, uint16 repeat,
+                   const unsigned char *expected)
 {
-    MD5_CTX context;
-    unsigned char digest[16];
-    unsigned int len = strlen(input);
-
-    MD5Init(&context);
-    MD5Update(&context,(unsigned char *) input, len);
-    MD5Final(digest, &context);
+    DIGEST_CTX context;
+    unsigned char digest[DIGEST_MAX_LEN];
+    uint16 len = (uint16)strlen(input);
+    uint16 digest_len = DigestLength(type);
+    uint16 chunk, r;
+    unsigned int failures = 0;
+
+    DigestInit(&context, type);
+    for(r = 0; r < repeat; ++r)
+        DigestUpdate(&context,(const uint8 *) input, len);
+    DigestFinal(digest, &context);
+    if(memcmp(digest, expected, digest_len) != 0)
+        ++failures;
+
+    for(chunk = 1; chunk <= 97; ++chunk)
+    {
+        unsigned char chunked[DIGEST_MAX_LEN];
+        DigestInit(&context, type);
+        for(r = 0; r < repeat; ++r)
+        {
+            uint16 i;
+            for(i = 0; i < len; i += chunk)
+                DigestUpdate(&context,(const uint8 *) input + i,
+                             (uint16)(len - i < chunk ? len - i : chunk));
+        }
+        DigestFinal(chunked, &context);
+        if(memcmp(chunked, expected, digest_len) != 0)
+            ++failures;
+    }
 
-    printf("MD5(\"%s\") = ", input);
-    print_digest(digest);
-    if(memcmp(digest, expected, sizeof(digest)) != 0)
+    if(repeat == 1)
+        printf("%s(\"%s\") = ", digest_name(type), input);
+    else
+        printf("%s(%u x \"%s\") = ", digest_name(type), repeat, input);
+    print_digest(digest, digest_len);
+    if(failures)
         printf(" FAIL!");
     printf("\n");
 }
 
-const static struct
+typedef struct
 {
     const char *input;
-    unsigned char output[16];
-} test_cases[] =
+    uint16 repeat;
+    unsigned char output[DIGEST_MAX_LEN];
+} test_case;
+
+/* RFC 1321 appendix A.5 */
+const static test_case md5_cases[] =
+{
+    { "", 1, { 0xd4, 0x1d, 0x8c, 0xd9, 0x8f, 0x00, 0xb2, 0x04, 0xe9, 0x80, 0x09, 0x98, 0xec, 0xf8, 0x42, 0x7e }},
+    { "a", 1, { 0x0c, 0xc1, 0x75, 0xb9, 0xc0, 0xf1, 0xb6, 0xa8, 0x31, 0xc3, 0x99, 0xe2, 0x69, 0x77, 0x26, 0x61 }},
+    { "abc", 1, { 0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0, 0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72 }},
+    { "message digest", 1, { 0xf9, 0x6b, 0x69, 0x7d, 0x7c, 0xb7, 0x93, 0x8d, 0x52, 0x5a, 0x2f, 0x31, 0xaa, 0xf1, 0x61, 0xd0 }},
+    { "abcdefghijklmnopqrstuvwxyz", 1, { 0xc3, 0xfc, 0xd3, 0xd7, 0x61, 0x92, 0xe4, 0x00, 0x7d, 0xfb, 0x49, 0x6c, 0xca, 0x67, 0xe1, 0x3b }},
+    { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 1, { 0xd1, 0x74, 0xab, 0x98, 0xd2, 0x77, 0xd9, 0xf5, 0xa5, 0x61, 0x1c, 0x2c, 0x9f, 0x41, 0x9d, 0x9f }},
+    { "12345678901234567890123456789012345678901234567890123456789012345678901234567890", 1, { 0x57, 0xed, 0xf4, 0xa2, 0x2b, 0xe3, 0xc9, 0x55, 0xac, 0x49, 0xda, 0x2e, 0x21, 0x07, 0xb6, 0x7a }}
+};
+
+/* FIPS 180-2 appendix B */
+const static test_case sha256_cases[] =
 {
-    { "", { 0xd4, 0x1d, 0x8c, 0xd9, 0x8f, 0x00, 0xb2, 0x04, 0xe9, 0x80, 0x09, 0x98, 0xec, 0xf8, 0x42, 0x7e }},
-    { "a", { 0x0c, 0xc1, 0x75, 0xb9, 0xc0, 0xf1, 0xb6, 0xa8, 0x31, 0xc3, 0x99, 0xe2, 0x69, 0x77, 0x26, 0x61 }},
-    { "abc", { 0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0, 0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72 }},
-    { "message digest", { 0xf9, 0x6b, 0x69, 0x7d, 0x7c, 0xb7, 0x93, 0x8d, 0x52, 0x5a, 0x2f, 0x31, 0xaa, 0xf1, 0x61, 0xd0 }},
-    { "abcdefghijklmnopqrstuvwxyz", { 0xc3, 0xfc, 0xd3, 0xd7, 0x61, 0x92, 0xe4, 0x00, 0x7d, 0xfb, 0x49, 0x6c, 0xca, 0x67, 0xe1, 0x3b }},
-    { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", { 0xd1, 0x74, 0xab, 0x98, 0xd2, 0x77, 0xd9, 0xf5, 0xa5, 0x61, 0x1c, 0x2c, 0x9f, 0x41, 0x9d, 0x9f }},
-    { "12345678901234567890123456789012345678901234567890123456789012345678901234567890", { 0x57, 0xed, 0xf4, 0xa2, 0x2b, 0xe3, 0xc9, 0x55, 0xac, 0x49, 0xda, 0x2e, 0x21, 0x07, 0xb6, 0x7a }}
+    { "abc", 1, { 0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+                  0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad }},
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+                { 0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+                  0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 }},
+    { "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 10000,
+                { 0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+                  0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0 }},
+    { "", 1, { 0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+               0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 }}
 };
 
-static void test_suite(void)
+static void test_suite(digest_type type, const test_case *cases, uint16 count)
 {
     uint16 i;
-    printf("MD5 test suite:\n");
-    for(i = 0; i < sizeof(test_cases)/sizeof(*test_cases); ++i)
-        verify(test_cases[i].input, test_cases[i].output);
+    printf("%s test suite:\n", digest_name(type));
+    for(i = 0; i < count; ++i)
+        verify(type, cases[i].input, cases[i].repeat, cases[i].output);
 }
 
 int main(void)
 {
-    test_suite();
-    time_trial();
+    test_suite(digest_md5, md5_cases, sizeof(md5_cases)/sizeof(*md5_cases));
+    test_suite(digest_sha256, sha256_cases, sizeof(sha256_cases)/sizeof(*sha256_cases));
+    time_trial(digest_md5);
+    time_trial(digest_sha256);
     return 0;
 }
@@ -62,79 +62,120 @@ static void fill(uint32 word[16], uint16 index, const uint8 *byte, uint16 bytes)
         word[index >> 2] |= ((uint32)(byte[i] & 0xFF)) << (8 * (index & 3));
 }
 
-/* Basic MD5 transform of a single 512-bit block */
+/* Assemble a 64-byte block into little-endian uint32's */
 
-static void transform(MD5_CTX *context)
+static void decode(uint32 word[16], const uint8 *byte)
 {
-    const static uint32 k[64] =
-        {
-            0xd76aa478u, 0xe8c7b756u, 0x242070dbu, 0xc1bdceeeu,
-            0xf57c0fafu, 0x4787c62au, 0xa8304613u, 0xfd469501u,
-            0x698098d8u, 0x8b44f7afu, 0xffff5bb1u, 0x895cd7beu,
-            0x6b901122u, 0xfd987193u, 0xa679438eu, 0x49b40821u,
-            0xf61e2562u, 0xc040b340u, 0x265e5a51u, 0xe9b6c7aau,
-            0xd62f105du, 0x02441453u, 0xd8a1e681u, 0xe7d3fbc8u,
-            0x21e1cde6u, 0xc33707d6u, 0xf4d50d87u, 0x455a14edu,
-            0xa9e3e905u, 0xfcefa3f8u, 0x676f02d9u, 0x8d2a4c8au,
-            0xfffa3942u, 0x8771f681u, 0x6d9d6122u, 0xfde5380cu,
-            0xa4beea44u, 0x4bdecfa9u, 0xf6bb4b60u, 0xbebfbc70u,
-            0x289b7ec6u, 0xeaa127fau, 0xd4ef3085u, 0x4881d05u,
-            0xd9d4d039u, 0xe6db99e5u, 0x1fa27cf8u, 0xc4ac5665u,
-            0xf4292244u, 0x432aff97u, 0xab9423a7u, 0xfc93a039u,
-            0x655b59c3u, 0x8f0ccc92u, 0xffeff47du, 0x85845dd1u,
-            0x6fa87e4fu, 0xfe2ce6e0u, 0xa3014314u, 0x4e0811a1u,
-            0xf7537e82u, 0xbd3af235u, 0x2ad7d2bbu, 0xeb86d391u
-        };
-    const static uint8 r[4][4] =
-        {
-            {  7, 12, 17, 22 },
-            {  5,  9, 14, 20 },
-            {  4, 11, 16, 23 },
-            {  6, 10, 15, 21 }
-        };
     uint16 i;
-    uint32 a = context->state[0];
-    uint32 b = context->state[1];
-    uint32 c = context->state[2];
-    uint32 d = context->state[3];
-  
-    for(i = 0; i < 64; ++i)
-    {
-        uint32 f;
-        uint16 g;
-        uint16 shift = r[i / 16][i & 3];
-        if(i < 16)
-        {
-            g = i;      
-            f = d ^ (b & (c ^ d));
-        }
-        else if(i < 32)
-        {
-            g = 5*i + 1;
-            f = c ^ (d & (b ^ c));
-        }
-        else if(i < 48)
-        {
-            g = 3*i + 5;
-            f = b ^ (c ^ d);
-        }
-        else 
-        {
-            g = 7*i;
-            f = c ^ (b | ~d);
-        }      
-        f += a + k[i] + context->buffer[g & 15];
-        f = (f << shift) | (f >> (32-shift)); /* Rotate left by 'shift' */
-        a = d; 
-        d = c;
-        c = b;
-        b += f;
-    }
+    for(i = 0; i < 16; ++i, byte += 4)
+        word[i] = ((uint32)(byte[0] & 0xFF))       |
+                  ((uint32)(byte[1] & 0xFF) << 8)  |
+                  ((uint32)(byte[2] & 0xFF) << 16) |
+                  ((uint32)(byte[3] & 0xFF) << 24);
+}
+
+/* 
+   The four MD5 round operations. Each one is a step of the form
+   a = b + ((a + f(b,c,d) + x + k) <<< s)
+*/
+
+#define ROTL(x, s) (((x) << (s)) | ((x) >> (32 - (s))))
+#define STEP(f, a, b, c, d, x, k, s) \
+    do { (a) += f((b), (c), (d)) + (x) + (k); (a) = ROTL((a), (s)) + (b); } while(0)
 
-    context->state[0] += a;
-    context->state[1] += b;
-    context->state[2] += c;
-    context->state[3] += d;
+#define F(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define G(b, c, d) ((c) ^ ((d) & ((b) ^ (c))))
+#define H(b, c, d) ((b) ^ (c) ^ (d))
+#define I(b, c, d) ((c) ^ ((b) | ~(d)))
+
+/* Basic MD5 transform of a single 512-bit block */
+
+static void transform(uint32 state[4], const uint32 x[16])
+{
+    uint32 a = state[0];
+    uint32 b = state[1];
+    uint32 c = state[2];
+    uint32 d = state[3];
+
+    STEP(F, a, b, c, d, x[ 0], 0xd76aa478u,  7);
+    STEP(F, d, a, b, c, x[ 1], 0xe8c7b756u, 12);
+    STEP(F, c, d, a, b, x[ 2], 0x242070dbu, 17);
+    STEP(F, b, c, d, a, x[ 3], 0xc1bdceeeu, 22);
+    STEP(F, a, b, c, d, x[ 4], 0xf57c0fafu,  7);
+    STEP(F, d, a, b, c, x[ 5], 0x4787c62au, 12);
+    STEP(F, c, d, a, b, x[ 6], 0xa8304613u, 17);
+    STEP(F, b, c, d, a, x[ 7], 0xfd469501u, 22);
+    STEP(F, a, b, c, d, x[ 8], 0x698098d8u,  7);
+    STEP(F, d, a, b, c, x[ 9], 0x8b44f7afu, 12);
+    STEP(F, c, d, a, b, x[10], 0xffff5bb1u, 17);
+    STEP(F, b, c, d, a, x[11], 0x895cd7beu, 22);
+    STEP(F, a, b, c, d, x[12], 0x6b901122u,  7);
+    STEP(F, d, a, b, c, x[13], 0xfd987193u, 12);
+    STEP(F, c, d, a, b, x[14], 0xa679438eu, 17);
+    STEP(F, b, c, d, a, x[15], 0x49b40821u, 22);
+
+    STEP(G, a, b, c, d, x[ 1], 0xf61e2562u,  5);
+    STEP(G, d, a, b, c, x[ 6], 0xc040b340u,  9);
+    STEP(G, c, d, a, b, x[11], 0x265e5a51u, 14);
+    STEP(G, b, c, d, a, x[ 0], 0xe9b6c7aau, 20);
+    STEP(G, a, b, c, d, x[ 5], 0xd62f105du,  5);
+    STEP(G, d, a, b, c, x[10], 0x02441453u,  9);
+    STEP(G, c, d, a, b, x[15], 0xd8a1e681u, 14);
+    STEP(G, b, c, d, a, x[ 4], 0xe7d3fbc8u, 20);
+    STEP(G, a, b, c, d, x[ 9], 0x21e1cde6u,  5);
+    STEP(G, d, a, b, c, x[14], 0xc33707d6u,  9);
+    STEP(G, c, d, a, b, x[ 3], 0xf4d50d87u, 14);
+    STEP(G, b, c, d, a, x[ 8], 0x455a14edu, 20);
+    STEP(G, a, b, c, d, x[13], 0xa9e3e905u,  5);
+    STEP(G, d, a, b, c, x[ 2], 0xfcefa3f8u,  9);
+    STEP(G, c, d, a, b, x[ 7], 0x676f02d9u, 14);
+    STEP(G, b, c, d, a, x[12], 0x8d2a4c8au, 20);
+
+    STEP(H, a, b, c, d, x[ 5], 0xfffa3942u,  4);
+    STEP(H, d, a, b, c, x[ 8], 0x8771f681u, 11);
+    STEP(H, c, d, a, b, x[11], 0x6d9d6122u, 16);
+    STEP(H, b, c, d, a, x[14], 0xfde5380cu, 23);
+    STEP(H, a, b, c, d, x[ 1], 0xa4beea44u,  4);
+    STEP(H, d, a, b, c, x[ 4], 0x4bdecfa9u, 11);
+    STEP(H, c, d, a, b, x[ 7], 0xf6bb4b60u, 16);
+    STEP(H, b, c, d, a, x[10], 0xbebfbc70u, 23);
+    STEP(H, a, b, c, d, x[13], 0x289b7ec6u,  4);
+    STEP(H, d, a, b, c, x[ 0], 0xeaa127fau, 11);
+    STEP(H, c, d, a, b, x[ 3], 0xd4ef3085u, 16);
+    STEP(H, b, c, d, a, x[ 6], 0x04881d05u, 23);
+    STEP(H, a, b, c, d, x[ 9], 0xd9d4d039u,  4);
+    STEP(H, d, a, b, c, x[12], 0xe6db99e5u, 11);
+    STEP(H, c, d, a, b, x[15], 0x1fa27cf8u, 16);
+    STEP(H, b, c, d, a, x[ 2], 0xc4ac5665u, 23);
+
+    STEP(I, a, b, c, d, x[ 0], 0xf4292244u,  6);
+    STEP(I, d, a, b, c, x[ 7], 0x432aff97u, 10);
+    STEP(I, c, d, a, b, x[14], 0xab9423a7u, 15);
+    STEP(I, b, c, d, a, x[ 5], 0xfc93a039u, 21);
+    STEP(I, a, b, c, d, x[12], 0x655b59c3u,  6);
+    STEP(I, d, a, b, c, x[ 3], 0x8f0ccc92u, 10);
+    STEP(I, c, d, a, b, x[10], 0xffeff47du, 15);
+    STEP(I, b, c, d, a, x[ 1], 0x85845dd1u, 21);
+    STEP(I, a, b, c, d, x[ 8], 0x6fa87e4fu,  6);
+    STEP(I, d, a, b, c, x[15], 0xfe2ce6e0u, 10);
+    STEP(I, c, d, a, b, x[ 6], 0xa3014314u, 15);
+    STEP(I, b, c, d, a, x[13], 0x4e0811a1u, 21);
+    STEP(I, a, b, c, d, x[ 4], 0xf7537e82u,  6);
+    STEP(I, d, a, b, c, x[11], 0xbd3af235u, 10);
+    STEP(I, c, d, a, b, x[ 2], 0x2ad7d2bbu, 15);
+    STEP(I, b, c, d, a, x[ 9], 0xeb86d391u, 21);
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+/* Transform the block collected in the context buffer */
+
+static void transform_buffer(MD5_CTX *context)
+{
+    transform(context->state, context->buffer);
 
     /* Clear input buffer again as required by next fill */
     memset(context->buffer, 0, sizeof(context->buffer));
@@ -167,15 +208,29 @@ void MD5Update(MD5_CTX *context, const uint8 *input, uint16 len)
     context->bytes += len;
     for(i = 0; i < len; i += n)
     {
+        if(index == 0 && len - i >= 64)
+        {
+            /* Whole block in the input, no need to collect it in the
+               context buffer first */
+            uint32 block[16];
+            decode(block, &input[i]);
+            transform(context->state, block);
+            n = 64;
+            continue;
+        }
         n = min(64 - index, len - i);
         /* Append bytes into buffer inside context */
         fill(context->buffer, index, &input[i], n);
         /* If buffer is full, process it */
         if(index+n == 64)
         {
-            transform(context);
+            transform_buffer(context);
             index = 0;
         }
+        else
+        {
+            index += n;
+        }
     }
 }
 
@@ -191,11 +246,11 @@ void MD5Final(uint8 digest[16], MD5_CTX *context)
     uint16 index = (uint16)(context->bytes & 0x3f);
 
     fill(context->buffer, index++, &pad, 1);
-    if(index > 56) transform(context);
+    if(index > 56) transform_buffer(context);
 
     context->buffer[14] = context->bytes << 3;
     context->buffer[15] = context->bytes >> 29;
-    transform(context);
+    transform_buffer(context);
   
     encode (digest, context->state, 16);
 }
@@ -32,20 +32,23 @@ documentation and/or software.
 /*
 This is a utility library and provided as a number of
 functions. It is provided for use by the PBAP library during
-authentication; performance is not adequate for processing large
-volumes of data.
+authentication, and as the MD5 half of the generic digest API in
+digest.h for integrity checks on streamed data.
 A typical application will call MD5Init, make a number of calls to
 MD5Update to supply the data, and finally call MD5Final to extract
 the data. 
 This library uses the same API as the MD5 reference implementation
-in RFC-1321, but has been optimised to reduce the code size and
-memory consumption on BlueCore.
+in RFC-1321, but has been optimised to reduce the memory consumption
+on BlueCore. The rounds are unrolled, and whole 64-byte blocks are
+digested directly from the caller's buffer.
 */
 #ifndef MD5_H_
 #define MD5_H_
 
 #include <csrtypes.h>
 
+#define MD5_DIGEST_LEN 16
+
 typedef struct
 {
     uint32 buffer[16];
@@ -0,0 +1,207 @@
+/*
+Copyright (c) 2005 - 2015 Qualcomm Technologies International, Ltd.
+
+*/
+
+#include "sha256.h"
+
+#include <string.h>
+
+#define min(a,b) ((a)<(b)?(a):(b))
+
+/* Unpack an array of uint32's into a big-endian array of uint8's. */
+
+static void encode(uint8 *output, const uint32 *input, uint16 len)
+{
+    uint16 j;
+
+    for (j = 0; j < len; ++j)
+        output[j] = (uint8) ((input[j >> 2] >> (8 * (3 - (j & 3)))) & 0xFF);
+}
+
+/* 
+   Or an array of uint8's into the specified offset of big-endian uint32's
+   Assumes that the uint32 array has previously been zeroed
+*/
+
+static void fill(uint32 word[16], uint16 index, const uint8 *byte, uint16 bytes)
+{
+    uint16 i;
+    for(i = 0; i < bytes; ++i, ++index)
+        word[index >> 2] |= ((uint32)(byte[i] & 0xFF)) << (8 * (3 - (index & 3)));
+}
+
+/* Assemble a 64-byte block into big-endian uint32's */
+
+static void decode(uint32 word[16], const uint8 *byte)
+{
+    uint16 i;
+    for(i = 0; i < 16; ++i, byte += 4)
+        word[i] = ((uint32)(byte[0] & 0xFF) << 24) |
+                  ((uint32)(byte[1] & 0xFF) << 16) |
+                  ((uint32)(byte[2] & 0xFF) << 8)  |
+                  ((uint32)(byte[3] & 0xFF));
+}
+
+#define ROTR(x, s) (((x) >> (s)) | ((x) << (32 - (s))))
+
+#define CH(e, f, g)  ((g) ^ ((e) & ((f) ^ (g))))
+#define MAJ(a, b, c) (((a) & (b)) | ((c) & ((a) | (b))))
+#define SIGMA0(a)    (ROTR((a), 2) ^ ROTR((a), 13) ^ ROTR((a), 22))
+#define SIGMA1(e)    (ROTR((e), 6) ^ ROTR((e), 11) ^ ROTR((e), 25))
+#define sigma0(w)    (ROTR((w), 7) ^ ROTR((w), 18) ^ ((w) >> 3))
+#define sigma1(w)    (ROTR((w), 17) ^ ROTR((w), 19) ^ ((w) >> 10))
+
+/* 
+   Basic SHA-256 transform of a single 512-bit block. The message schedule
+   is kept as a 16 word circular window rather than the full 64 words, and
+   it is built in place in w.
+*/
+
+static void transform(uint32 state[8], uint32 w[16])
+{
+    static const uint32 k[64] =
+        {
+            0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u,
+            0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+            0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u,
+            0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+            0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu,
+            0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+            0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u,
+            0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+            0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u,
+            0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+            0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u,
+            0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+            0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u,
+            0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+            0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u,
+            0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u
+        };
+    uint16 i;
+    uint32 a = state[0];
+    uint32 b = state[1];
+    uint32 c = state[2];
+    uint32 d = state[3];
+    uint32 e = state[4];
+    uint32 f = state[5];
+    uint32 g = state[6];
+    uint32 h = state[7];
+
+    for(i = 0; i < 64; ++i)
+    {
+        uint32 t1, t2;
+
+        if(i >= 16)
+            w[i & 15] += sigma1(w[(i - 2) & 15]) + w[(i - 7) & 15] +
+                         sigma0(w[(i - 15) & 15]);
+
+        t1 = h + SIGMA1(e) + CH(e, f, g) + k[i] + w[i & 15];
+        t2 = SIGMA0(a) + MAJ(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/* Transform the block collected in the context buffer */
+
+static void transform_buffer(SHA256_CTX *context)
+{
+    transform(context->state, context->buffer);
+
+    /* Clear input buffer again as required by next fill */
+    memset(context->buffer, 0, sizeof(context->buffer));
+}
+
+/* 
+   SHA-256 initialization. Begins a SHA-256 operation, writing a new context.
+*/
+
+void SHA256Init(SHA256_CTX *context)
+{
+    static const uint32 seed[8] =
+        {
+            0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au,
+            0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u
+        };
+    memset(context, 0, sizeof(*context));
+    memmove(context->state, seed, sizeof(seed));
+}
+
+/* 
+   SHA-256 block update operation. Continues a SHA-256 message-digest
+   operation, processing another message block, and updating the
+   context.
+*/
+
+void SHA256Update(SHA256_CTX *context, const uint8 *input, uint16 len)
+{
+    /* Compute number of bytes mod 64 */
+    uint16 i, n;
+    uint16 index = context->bytes & 0x3F;
+
+    context->bytes += len;
+    for(i = 0; i < len; i += n)
+    {
+        if(index == 0 && len - i >= 64)
+        {
+            /* Whole block in the input, no need to collect it in the
+               context buffer first */
+            uint32 block[16];
+            decode(block, &input[i]);
+            transform(context->state, block);
+            n = 64;
+            continue;
+        }
+        n = min(64 - index, len - i);
+        /* Append bytes into buffer inside context */
+        fill(context->buffer, index, &input[i], n);
+        /* If buffer is full, process it */
+        if(index+n == 64)
+        {
+            transform_buffer(context);
+            index = 0;
+        }
+        else
+        {
+            index += n;
+        }
+    }
+}
+
+/* 
+   SHA-256 finalization.
+
+   Ends a SHA-256 message-digest operation, extracting the digest.
+*/
+
+void SHA256Final(uint8 digest[SHA256_DIGEST_LEN], SHA256_CTX *context)
+{
+    const uint8 pad = 0x80;
+    uint16 index = (uint16)(context->bytes & 0x3f);
+
+    fill(context->buffer, index++, &pad, 1);
+    if(index > 56) transform_buffer(context);
+
+    context->buffer[14] = context->bytes >> 29;
+    context->buffer[15] = context->bytes << 3;
+    transform_buffer(context);
+  
+    encode (digest, context->state, SHA256_DIGEST_LEN);
+}
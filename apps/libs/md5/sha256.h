@@ -0,0 +1,41 @@
+/*
+Copyright (c) 2005 - 2015 Qualcomm Technologies International, Ltd.
+
+*/
+
+/*
+SHA-256 message digest, as specified in FIPS 180-2.
+The API mirrors the MD5 one: call SHA256Init, make any number of calls
+to SHA256Update with the data in chunks of any size, and finally call
+SHA256Final to extract the digest.
+*/
+#ifndef SHA256_H_
+#define SHA256_H_
+
+#include <csrtypes.h>
+
+#define SHA256_DIGEST_LEN 32
+
+typedef struct
+{
+    uint32 buffer[16];
+    uint32 state[8];
+    uint32 bytes;
+} SHA256_CTX;
+
+/*!
+  @brief Initialise a SHA256_CTX.
+*/
+void SHA256Init(SHA256_CTX *);
+
+/*!
+   @brief Update a SHA256_CTX with the next block of data.
+*/
+void SHA256Update(SHA256_CTX *, const uint8 *bytes, uint16 len);
+
+/*! 
+   @brief Extract the digest from the SHA256_CTX.
+*/
+void SHA256Final(uint8 digest[SHA256_DIGEST_LEN], SHA256_CTX *);
+
+#endif /* SHA256_H_ */
@@ -0,0 +1,365 @@
+/* Copyright (c) 2010 - 2015 Qualcomm Technologies International, Ltd. */
+/*  */
+/* Test harness and benchmark for the streaming OBEX object tokenizer */
+
+#include <stdio.h>
+#include <string.h>
+#include <vm.h>
+
+#include "obex_parse.h"
+
+/* Size of the OBEX packets the objects are split into */
+#define TEST_PACKET_LEN  1000
+
+/* Largest chunk size used in the packet boundary check */
+#define TEST_MAX_CHUNK   67
+
+/* Longest name kept by the application */
+#define TEST_MAX_VALUE   48
+
+static const char* const vcard_tags[] =
+{
+    "VCARD", "VERSION", "N", "FN", "TEL", "EMAIL", "NOTE"
+};
+
+enum { tag_vcard, tag_version, tag_n, tag_fn, tag_tel, tag_email, tag_note };
+
+static const char* const listing_tags[] =
+{
+    "vCard-listing", "card", "handle", "name"
+};
+
+enum { tag_listing, tag_card, tag_handle, tag_name };
+
+/* Synthetic PBAP pull phonebook of count vCards. Every fourth card has a
+   NOTE folded over two lines. */
+static char *make_phonebook(uint16 count, uint32 *len)
+{
+    char *book = malloc((size_t)count * 256 + 1);
+    char *p = book;
+    uint16 i;
+
+    if(!book)
+        return NULL;
+
+    for(i = 0; i < count; ++i)
+    {
+        p += sprintf(p, "BEGIN:VCARD\r\nVERSION:2.1\r\n"
+                        "N:Surname%u;Given%u\r\n"
+                        "FN:Given%u Surname%u\r\n"
+                        "TEL;TYPE=CELL:+4477000%05u\r\n"
+                        "TEL;TYPE=HOME:+441223%06u\r\n"
+                        "EMAIL;TYPE=INTERNET:given%u@example.com\r\n",
+                        i, i, i, i, i, i, i);
+        if((i & 3) == 0)
+            p += sprintf(p, "NOTE:Met at the conference in\r\n"
+                            " Cambridge on day %u\r\n", i);
+        p += sprintf(p, "END:VCARD\r\n");
+    }
+
+    *len = (uint32)(p - book);
+    return book;
+}
+
+/* Synthetic PBAP vCard listing of count cards */
+static char *make_listing(uint16 count, uint32 *len)
+{
+    char *list = malloc((size_t)count * 64 + 256);
+    char *p = list;
+    uint16 i;
+
+    if(!list)
+        return NULL;
+
+    p += sprintf(p, "<?xml version=\"1.0\"?>\n"
+                    "<!DOCTYPE vcard-listing SYSTEM \"vcard-listing.dtd\">\n"
+                    "<vCard-listing version=\"1.0\">\n");
+    for(i = 0; i < count; ++i)
+        p += sprintf(p, "<card handle=\"%u.vcf\" name=\"Surname%u;Given%u\"/>\n",
+                     i, i, i);
+    p += sprintf(p, "</vCard-listing>\n");
+
+    *len = (uint32)(p - list);
+    return list;
+}
+
+/* What the application collects from the tokens */
+typedef struct
+{
+    uint32  checksum;       /* Over the values, type and tag of every token */
+    uint32  tokens;
+    uint16  cards;
+    uint16  tels;
+    uint16  bad_names;
+    uint16  notes;
+    uint16  long_names;     /* Begin and end tokens reported as too long */
+    char    value[TEST_MAX_VALUE];
+    uint16  value_len;
+} test_result;
+
+static void add_token(test_result *r, const ObexParseToken *t, bool xml)
+{
+    uint16 i;
+    char expected[TEST_MAX_VALUE];
+
+    /* Values may be split differently, so only the bytes and the end of
+       each value are counted */
+    for(i = 0; i < t->len; ++i)
+        r->checksum = r->checksum * 31 + (uint8)t->data[i];
+    if(t->complete)
+        r->checksum = r->checksum * 31 + t->type * 7 + t->tag;
+
+    if(t->type == op_token_begin && t->tag == (xml ? tag_card : tag_vcard))
+        r->cards++;
+
+    if(t->type != op_token_property)
+        return;
+    r->tokens++;
+
+    if(!xml && t->tag == tag_tel && t->complete)
+        r->tels++;
+
+    /* Gather the fragments of the names the application wants to keep */
+    if(t->tag == (xml ? tag_name : tag_fn) || (!xml && t->tag == tag_note))
+    {
+        for(i = 0; i < t->len && r->value_len < TEST_MAX_VALUE - 1; ++i)
+            r->value[r->value_len++] = t->data[i];
+
+        if(t->complete)
+        {
+            uint16 card = r->cards - 1;
+            r->value[r->value_len] = '\0';
+
+            if(!xml && t->tag == tag_note)
+            {
+                sprintf(expected, "Met at the conference inCambridge on day %u", card);
+                r->notes++;
+            }
+            else if(xml)
+                sprintf(expected, "Surname%u;Given%u", card, card);
+            else
+                sprintf(expected, "Given%u Surname%u", card, card);
+
+            if(strcmp(r->value, expected) != 0)
+                r->bad_names++;
+            r->value_len = 0;
+        }
+    }
+}
+
+/* Parse an object passed in chunks of chunk bytes */
+static void stream_object(const ObexParseTagTable *table, ObexParseObject type,
+                          const char *data, uint32 len, uint16 chunk,
+                          test_result *r)
+{
+    ObexParseStream stream;
+    ObexParseToken token;
+    ObexParseStatus status;
+    bool xml = (type >= op_xml_element);
+    uint32 offset;
+
+    memset(r, 0, sizeof(*r));
+    ObexParseStreamInit(&stream, table, type);
+
+    for(offset = 0; offset < len; offset += chunk)
+    {
+        uint16 part = (uint16)((len - offset < chunk) ? len - offset : chunk);
+
+        ObexParseStreamData(&stream, data + offset, part, (offset + part == len));
+        while((status = ObexParseStreamNext(&stream, &token)) != obex_parse_get_more_data)
+        {
+            if(status == obex_parse_success)
+                add_token(r, &token, xml);
+            else if(status == obex_parse_data_corrupted && !token.data &&
+                    token.tag == OBEX_PARSE_TAG_UNKNOWN)
+                r->long_names++;
+        }
+    }
+}
+
+/* Every packet size must produce the same tokens */
+
+static unsigned verify(const ObexParseTagTable *table, ObexParseObject type,
+                       const char *name, const char *data, uint32 len,
+                       uint16 count)
+{
+    test_result whole, part;
+    unsigned failures = 0;
+    uint16 chunk;
+
+    stream_object(table, type, data, len, (uint16)len, &whole);
+    if(whole.cards != count || whole.bad_names)
+        ++failures;
+    if(type < op_xml_element && (whole.tels != count * 2 || whole.notes != (count + 3) / 4))
+        ++failures;
+
+    for(chunk = 1; chunk <= TEST_MAX_CHUNK; ++chunk)
+    {
+        stream_object(table, type, data, len, chunk, &part);
+        if(part.checksum != whole.checksum || part.cards != count || part.bad_names)
+            ++failures;
+    }
+
+    printf("%s: %u entries, %lu values%s\n", name, whole.cards,
+           (unsigned long)whole.tokens, failures ? " FAIL!" : " OK");
+    return failures;
+}
+
+/* Objects with a name one longer than the longest kept, between two
+   entries. The long name must be reported, not returned cut short, and
+   the entries around it must still be parsed. */
+static const char long_name_vcards[] =
+    "BEGIN:VCARD\r\nFN:Given0 Surname0\r\nEND:VCARD\r\n"
+    "BEGIN:X-SEVENTEEN-CHARS\r\nVERSION:2.1\r\nEND:X-SEVENTEEN-CHARS\r\n"
+    "BEGIN:VCARD\r\nFN:Given1 Surname1\r\nEND:VCARD\r\n";
+
+static const char long_name_listing[] =
+    "<vCard-listing version=\"1.0\">\n"
+    "<card handle=\"0.vcf\" name=\"Surname0;Given0\"/>\n"
+    "<x-seventeen-chars>text</x-seventeen-chars>\n"
+    "<card handle=\"1.vcf\" name=\"Surname1;Given1\"/>\n"
+    "</vCard-listing>\n";
+
+static unsigned verify_long_names(const ObexParseTagTable *table, ObexParseObject type,
+                                  const char *name, const char *data, uint16 long_names)
+{
+    uint32 len = (uint32)strlen(data);
+    unsigned failures = 0;
+    test_result r;
+    uint16 chunk;
+
+    for(chunk = 1; chunk <= len; ++chunk)
+    {
+        stream_object(table, type, data, len, chunk, &r);
+        if(r.long_names != long_names || r.cards != 2 || r.bad_names)
+            ++failures;
+    }
+
+    printf("%s with a long name: %s\n", name, failures ? "FAIL!" : "OK");
+    return failures;
+}
+
+/* The parse tree needs the whole object in one buffer. The first call
+   opens the first card and lists its properties followed by the next
+   cards, which are then parsed again one level down to get their names. */
+static uint16 tree_names(const char *s, const char *e, bool top)
+{
+    ObexParseTree tree;
+    uint16 names = 0;
+
+    while(s < e)
+    {
+        uint16 len = (uint16)((e - s > 0xFFFF) ? 0xFFFF : e - s);
+        const ObexParseData *last;
+        const char *next;
+        uint8 i;
+
+        ObexParseCreateTree(&tree, op_vobj_vcard, s, len);
+        if(tree.numElements == 0)
+            break;
+
+        for(i = 0; i < tree.numElements; ++i)
+        {
+            ObexParseData *element = &tree.elements[i];
+
+            if(element->type == op_vobj_element)
+            {
+                uint16 valLen = OBEX_PARSE_MAX_DATA_SIZE;
+                char *value = ObexParseDecode(element, "FN", 2, &valLen);
+                if(value)
+                {
+                    names++;
+                    free(value);
+                }
+            }
+            else if(top && element->type == op_vobj_vcard)
+            {
+                names += tree_names(element->object,
+                                    element->object + element->len, FALSE);
+            }
+        }
+
+        last = &tree.elements[tree.numElements - 1];
+        next = last->object + last->len;
+        if(next <= s || !top)
+            break;
+        s = next;
+    }
+    return names;
+}
+
+static void time_trial(const ObexParseTagTable *table, uint16 count)
+{
+    uint32 len, offset, startTime, streamTime, treeTime;
+    char *book = make_phonebook(count, &len);
+    char *whole;
+    test_result r;
+    uint16 names;
+
+    if(!book)
+        return;
+
+    printf("Phonebook of %u vCards, %lu bytes in %u byte packets\n", count,
+           (unsigned long)len, TEST_PACKET_LEN);
+
+    startTime = VmGetClock();
+    stream_object(table, op_vobj_vcard, book, len, TEST_PACKET_LEN, &r);
+    streamTime = VmGetClock() - startTime;
+
+    printf("  Stream: %u names, %ld ms, %lu bytes of parser state\n", r.cards,
+           (long)streamTime, (unsigned long)sizeof(ObexParseStream));
+
+    /* Reassemble the packets, then build trees over the whole object. The
+       tree parser looks at the byte after an element that ends the
+       buffer, so the object is NUL terminated as a string. */
+    startTime = VmGetClock();
+    whole = malloc(len + 1);
+    if(whole)
+    {
+        for(offset = 0; offset < len; offset += TEST_PACKET_LEN)
+            memcpy(whole + offset, book + offset,
+                   (len - offset < TEST_PACKET_LEN) ? len - offset : TEST_PACKET_LEN);
+        whole[len] = '\0';
+        names = tree_names(whole, whole + len, TRUE);
+        treeTime = VmGetClock() - startTime;
+        free(whole);
+
+        printf("  Tree:   %u names, %ld ms, %lu bytes reassembled\n", names,
+               (long)treeTime, (unsigned long)len);
+    }
+
+    free(book);
+}
+
+int main(void)
+{
+    ObexParseTagTable vcard_table, listing_table;
+    static const uint16 sizes[] = { 1000, 2000, 5000, 10000 };
+    unsigned failures = 0;
+    uint32 len;
+    char *data;
+    uint16 i;
+
+    if(!ObexParseTagTableInit(&vcard_table, vcard_tags, sizeof(vcard_tags)/sizeof(*vcard_tags)) ||
+       !ObexParseTagTableInit(&listing_table, listing_tags, sizeof(listing_tags)/sizeof(*listing_tags)))
+    {
+        printf("Tag table FAIL!\n");
+        return 1;
+    }
+
+    data = make_phonebook(100, &len);
+    failures += verify(&vcard_table, op_vobj_vcard, "vCard phonebook", data, len, 100);
+    free(data);
+
+    data = make_listing(100, &len);
+    failures += verify(&listing_table, op_xml_folder_list, "vCard listing", data, len, 100);
+    free(data);
+
+    failures += verify_long_names(&vcard_table, op_vobj_vcard, "vCard phonebook", long_name_vcards, 2);
+    failures += verify_long_names(&listing_table, op_xml_folder_list, "vCard listing", long_name_listing, 2);
+
+    for(i = 0; i < sizeof(sizes)/sizeof(*sizes); ++i)
+        time_trial(&vcard_table, sizes[i]);
+
+    return failures ? 1 : 0;
+}
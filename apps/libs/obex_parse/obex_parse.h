@@ -6,7 +6,7 @@ FILE NAME
     obex_parse.h
 
 VERSION
-    0.5 
+    0.6
     
 DESCRIPTION
 	Header file for the OBEX Parser library. This support library provides 
@@ -18,12 +18,15 @@ DESCRIPTION
     formats are XML and Irda style formats used in the Bluetooth 
     OBEX profiles. Supprted features are 1) Creating a Parse tree from 
     the received object 2) Decoding the elements of the tree to extract 
-    the associated value of a requested tag.
+    the associated value of a requested tag. A streaming tokenizer is
+    also provided for objects too large to hold in one buffer, such as
+    PBAP phonebooks, which parses the object packet by packet.
    
    
 
 HISTORY
     0.5 - This initial version supports only messaging Objects for MAP 1.0.
+    0.6 - Added the streaming tokenizer and tag tables.
 */
 
 /*!
@@ -174,5 +177,141 @@ char*   ObexParseDecode( ObexParseData* element,
                          uint16         *maxValLen );
 
 
+#define OBEX_PARSE_TAG_HASH_SIZE    64   /* Slots in a tag table, power of 2 */
+#define OBEX_PARSE_MAX_TAGS         48   /* Tags a tag table can hold */
+#define OBEX_PARSE_MAX_NAME_LEN     16   /* Longest tag name recognised */
+#define OBEX_PARSE_TAG_UNKNOWN      0xFF /* Tag not in the tag table */
+
+/*! @brief Hash table of the tag names an application is interested in */
+typedef struct
+{
+    const char* const* tags;   /*!< The tag names, as passed to init */
+    uint8   numTags;           /*!< Number of tag names */
+    uint8   lens[OBEX_PARSE_MAX_TAGS]; /*!< Length of each tag name */
+    uint8   slots[OBEX_PARSE_TAG_HASH_SIZE]; /*!< Tag index + 1, 0 if empty*/
+} ObexParseTagTable;
+
+/*! @brief Type of a token returned by the streaming parser */
+typedef enum
+{
+    op_token_begin,     /*!< BEGIN:VCARD or \<msg. data is the tag name */
+    op_token_end,       /*!< END:VCARD or \</msg\>, data is the tag name.
+                             For an empty element /\> data is NULL */
+    op_token_property,  /*!< vObj property value or XML attribute value */
+    op_token_param,     /*!< vObj property parameters e.g: TYPE=CELL */
+    op_token_text       /*!< XML character data between tags */
+} ObexParseTokenType;
+
+/*! @brief A token returned by the streaming parser */
+typedef struct
+{
+    ObexParseTokenType  type;     /*!< Type of the token */
+    uint8               tag;      /*!< Index of the tag name in the tag
+                                       table or OBEX_PARSE_TAG_UNKNOWN */
+    bool                complete; /*!< FALSE if more of the value follows
+                                       in later tokens */
+    const char*         data;     /*!< The value, or this fragment of it */
+    uint16              len;      /*!< Length of data */
+} ObexParseToken;
+
+/*! @brief State of the streaming parser. Opaque to the application. */
+typedef struct
+{
+    const ObexParseTagTable* table;
+    const char*  s;
+    const char*  e;
+    unsigned     state:4;
+    unsigned     xml:1;
+    unsigned     last:1;
+    unsigned     nameOverflow:1;
+    unsigned     nameTooLong:1;
+    char         quote;
+    uint8        nameLen;
+    uint8        tag;
+    uint8        elementTag;
+    uint16       hash;
+    char         name[OBEX_PARSE_MAX_NAME_LEN];
+} ObexParseStream;
+
+/*!
+    @brief  Build a hash table of tag names for the streaming parser.
+
+    @param  table   The table to fill.
+
+    @param  tags    Array of NUL terminated tag names. The array must remain
+    valid while the table is in use. vObj property names are matched case
+    insensitively and must be given in upper case; XML names are matched
+    exactly.
+
+    @param  numTags Number of entries in tags, at most OBEX_PARSE_MAX_TAGS.
+
+    The token tag of a recognised name is its index in tags. A table can be
+    built once and shared by any number of streams.
+
+    Returns FALSE if there are too many tags or a tag name is longer than
+    OBEX_PARSE_MAX_NAME_LEN.
+*/
+bool ObexParseTagTableInit( ObexParseTagTable* table,
+                            const char* const* tags,
+                            uint8 numTags );
+
+/*!
+    @brief  Start parsing a new object with the streaming parser.
+
+    @param  stream  The parser state.
+
+    @param  table   Tag names to recognise, or NULL.
+
+    @param  objType Type of the object. Any vObj type selects the vObj
+    tokenizer, any XML type selects the XML tokenizer.
+
+    Unlike ObexParseCreateTree the streaming parser does not need the
+    object in one buffer. Each OBEX packet is passed in turn to
+    ObexParseStreamData and tokens are pulled with ObexParseStreamNext.
+    Values split across packets are returned as several tokens, so memory
+    use does not depend on the size of the object.
+*/
+void ObexParseStreamInit( ObexParseStream* stream,
+                          const ObexParseTagTable* table,
+                          ObexParseObject objType );
+
+/*!
+    @brief  Supply the next part of the object to the streaming parser.
+
+    @param  stream  The parser state.
+
+    @param  data    The data. It must remain valid until ObexParseStreamNext
+    has returned obex_parse_get_more_data.
+
+    @param  dataLen Length of the data.
+
+    @param  last    TRUE if this is the final part of the object, so that a
+    value not terminated by a line end or quote is still completed.
+*/
+void ObexParseStreamData( ObexParseStream* stream,
+                          const char* data,
+                          uint16 dataLen,
+                          bool last );
+
+/*!
+    @brief  Get the next token from the streaming parser.
+
+    @param  stream  The parser state.
+
+    @param  token   Filled in with the token on success. The token data
+    points into the supplied data or into the stream, and is only valid
+    until the next call.
+
+    Returns obex_parse_success if a token was returned and
+    obex_parse_get_more_data once all of the data has been consumed.
+    Returns obex_parse_data_corrupted for a begin or end token whose name
+    is longer than OBEX_PARSE_MAX_NAME_LEN. The token then has the tag
+    OBEX_PARSE_TAG_UNKNOWN and no data, and parsing continues with the next
+    call.
+*/
+ObexParseStatus ObexParseStreamNext( ObexParseStream* stream,
+                                     ObexParseToken* token );
+
+
 #endif /* OBEX_PARSE_H_ */
 
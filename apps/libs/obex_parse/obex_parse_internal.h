@@ -39,6 +39,29 @@ typedef struct{
     unsigned folds:8;
 } opHandle;
 
+/* Streaming parser states. vObj and XML states share the same values */
+typedef enum{
+    op_vs_line_start = 0,   /* Start of a vObj line */
+    op_vs_name,             /* Property name e.g: TEL */
+    op_vs_param,            /* Property parameters e.g: TYPE=CELL */
+    op_vs_value,            /* Property value */
+    op_vs_eol,              /* Line end, checking for a folded line */
+    op_vs_begin,            /* Object name after BEGIN: */
+    op_vs_end,              /* Object name after END: */
+
+    op_xs_text = 0,         /* Character data between tags */
+    op_xs_text_more,        /* Rest of character data split over packets */
+    op_xs_lt,               /* Just after < */
+    op_xs_name,             /* Element name in a start tag */
+    op_xs_attrs,            /* Between attributes in a start tag */
+    op_xs_attr_name,        /* Attribute name */
+    op_xs_attr_eq,          /* Between an attribute name and its value */
+    op_xs_attr_value,       /* Quoted attribute value */
+    op_xs_empty,            /* After / in an empty element tag */
+    op_xs_end_name,         /* Element name in an end tag */
+    op_xs_skip              /* Skipping to > */
+}opStreamState;
+
 #define opSkipCRLF(s, e ) opSkipChars(s, e, '\n', '\r')
 #define opSkipSpace(s, e ) opSkipChars(s, e, '\t', ' ' )
 #define opSkipNULL( s,e )  opSkipChars(s, e, 0x0, '\v')
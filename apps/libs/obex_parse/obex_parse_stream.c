@@ -0,0 +1,712 @@
+/****************************************************************************
+Copyright (c) 2010 - 2015 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    obex_parse_stream.c
+
+DESCRIPTION
+    This internal file defines the streaming tokenizer. Unlike the parse
+    tree it keeps its position between calls, so an object can be parsed
+    packet by packet as it is received.
+*/
+
+#include <string.h>
+#include "obex_parse_internal.h"
+
+/* Character classes used to find the end of names */
+#define OP_CC_LINE      0x01    /* CR LF */
+#define OP_CC_SPACE     0x02    /* Space TAB */
+#define OP_CC_VOBJ      0x04    /* ; : */
+#define OP_CC_XML       0x08    /* / > = */
+
+#define OP_CC_BLANK     ( OP_CC_LINE | OP_CC_SPACE )
+
+static const uint8 opCharClass[64] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, OP_CC_SPACE, OP_CC_LINE, 0, 0, OP_CC_LINE, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    OP_CC_SPACE, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, OP_CC_XML,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, OP_CC_VOBJ, OP_CC_VOBJ, 0, OP_CC_XML, OP_CC_XML, 0
+};
+
+/* All the delimiters are below '@' */
+#define opClass(c) ( ((uint8)(c) < 64)? opCharClass[(uint8)(c)] : 0 )
+
+#define opHashStep(h, c) ( (uint16)( (h) * 31 + (uint8)(c) ) )
+
+/*************************************************************************
+ *NAME
+ *  opTagLookup
+ *
+ *DESCRIPTION
+ *  Find the name collected in the stream in the tag table.
+ *
+ *PARAMETERS
+ *  stream - The parser state holding the name and its hash.
+ ************************************************************************/
+static uint8 opTagLookup( const ObexParseStream* stream )
+{
+    const ObexParseTagTable* table = stream->table;
+    uint16 slot;
+
+    if( !table || stream->nameOverflow ) return OBEX_PARSE_TAG_UNKNOWN;
+
+    slot = stream->hash & ( OBEX_PARSE_TAG_HASH_SIZE - 1 );
+
+    while( table->slots[slot] )
+    {
+        uint8 index = table->slots[slot] - 1;
+        const char* tag = table->tags[index];
+
+        /* Compare lengths first so a tag shorter than the name is not read
+           past its terminator */
+        if( ( table->lens[index] == stream->nameLen ) &&
+            ( memcmp( tag, stream->name, stream->nameLen ) == 0 ) )
+        {
+            return index;
+        }
+        slot = ( slot + 1 ) & ( OBEX_PARSE_TAG_HASH_SIZE - 1 );
+    }
+
+    return OBEX_PARSE_TAG_UNKNOWN;
+}
+
+/*************************************************************************
+ *NAME
+ *  opNameReset
+ *
+ *DESCRIPTION
+ *  Start collecting a new name.
+ ************************************************************************/
+static void opNameReset( ObexParseStream* stream )
+{
+    stream->nameLen = 0;
+    stream->hash = 0;
+    stream->nameOverflow = FALSE;
+}
+
+/*************************************************************************
+ *NAME
+ *  opCollectName
+ *
+ *DESCRIPTION
+ *  Add characters to the name being collected until a character in one
+ *  of the stop classes. vObj names are folded to upper case.
+ *
+ *PARAMETERS
+ *  stream - The parser state.
+ *  s - Start of the input buffer.
+ *  e - End of the input buffer.
+ *  stop - Character classes which end the name.
+ ************************************************************************/
+static const char* opCollectName( ObexParseStream* stream,
+                                  const char *s,
+                                  const char *e,
+                                  uint8 stop )
+{
+    uint16 hash = stream->hash;
+    uint8  len = stream->nameLen;
+
+    while( ( s != e ) && !( opClass( *s ) & stop ) )
+    {
+        char c = *s++;
+
+        if( !stream->xml && c >= 'a' && c <= 'z' ) c -= 'a' - 'A';
+
+        hash = opHashStep( hash, c );
+        if( len < OBEX_PARSE_MAX_NAME_LEN )
+        {
+            stream->name[len++] = c;
+        }
+        else
+        {
+            stream->nameOverflow = TRUE;
+        }
+    }
+
+    stream->hash = hash;
+    stream->nameLen = len;
+
+    return s;
+}
+
+/*************************************************************************
+ *NAME
+ *  opSetToken
+ *
+ *DESCRIPTION
+ *  Fill in a token.
+ ************************************************************************/
+static void opSetToken( ObexParseToken* token,
+                        ObexParseTokenType type,
+                        uint8 tag,
+                        bool complete,
+                        const char* data,
+                        uint16 len )
+{
+    token->type = type;
+    token->tag = tag;
+    token->complete = complete;
+    token->data = data;
+    token->len = len;
+}
+
+/*************************************************************************
+ *NAME
+ *  opSetNameToken
+ *
+ *DESCRIPTION
+ *  Fill in a begin or end token for the name collected in the stream.
+ ************************************************************************/
+static void opSetNameToken( ObexParseStream* stream,
+                            ObexParseToken* token,
+                            ObexParseTokenType type )
+{
+    if( stream->nameOverflow )
+    {
+        /* Only the start of the name is held; report it rather than
+           return it cut short */
+        opSetToken( token, type, OBEX_PARSE_TAG_UNKNOWN, TRUE, NULL, 0 );
+        stream->nameTooLong = TRUE;
+        return;
+    }
+    opSetToken( token, type, opTagLookup( stream ), TRUE,
+                stream->name, stream->nameLen );
+}
+
+/*************************************************************************
+ *NAME
+ *  opStreamVobj
+ *
+ *DESCRIPTION
+ *  Tokenize vObject data e.g: vCard, vCal or bMessage.
+ *
+ *PARAMETERS
+ *  stream - The parser state.
+ *  token - Filled in with the token found.
+ *
+ *RETURNS
+ *  TRUE if a token was found, FALSE if the data is consumed.
+ ************************************************************************/
+static bool opStreamVobj( ObexParseStream* stream, ObexParseToken* token )
+{
+    const char *s = stream->s, *e = stream->e, *p;
+    bool found = FALSE;
+
+    while( !found && ( s != e ) )
+    {
+        switch( stream->state )
+        {
+            case op_vs_line_start:
+                s = opSkipCRLF( s, e );
+                if( s == e ) break;
+
+                opNameReset( stream );
+                stream->state = op_vs_name;
+                break;
+
+            case op_vs_name:
+                s = opCollectName( stream, s, e, OP_CC_LINE | OP_CC_VOBJ );
+                if( s == e ) break;
+
+                if( opClass( *s ) & OP_CC_LINE )
+                {
+                    /* No value, ignore the line */
+                    stream->state = op_vs_line_start;
+                }
+                else if( *s == ':' && stream->nameLen == 5 &&
+                         memcmp( stream->name, "BEGIN", 5 ) == 0 )
+                {
+                    opNameReset( stream );
+                    stream->state = op_vs_begin;
+                    s++;
+                }
+                else if( *s == ':' && stream->nameLen == 3 &&
+                         memcmp( stream->name, "END", 3 ) == 0 )
+                {
+                    opNameReset( stream );
+                    stream->state = op_vs_end;
+                    s++;
+                }
+                else
+                {
+                    stream->tag = opTagLookup( stream );
+                    stream->state = ( *s == ':' )? op_vs_value: op_vs_param;
+                    s++;
+                }
+                break;
+
+            case op_vs_param:
+                p = opSkipToMulChars( s, e, ':', '\r', '\n' );
+                opSetToken( token, op_token_param, stream->tag,
+                            ( p != e ), s, p - s );
+                found = TRUE;
+
+                if( p != e )
+                {
+                    if( *p == ':' )
+                    {
+                        stream->state = op_vs_value;
+                        p++;
+                    }
+                    else
+                    {
+                        stream->state = op_vs_line_start;
+                    }
+                }
+                s = p;
+                break;
+
+            case op_vs_value:
+                p = opSkipToAnyChar( s, e, '\r', '\n' );
+                if( p == e )
+                {
+                    opSetToken( token, op_token_property, stream->tag,
+                                FALSE, s, p - s );
+                    found = TRUE;
+                    s = p;
+                }
+                else
+                {
+                    const char *q = opSkipCRLF( p, e );
+
+                    if( q == e )
+                    {
+                        /* Can't tell yet if the next line is folded */
+                        opSetToken( token, op_token_property, stream->tag,
+                                    FALSE, s, p - s );
+                        found = ( p != s );
+                        stream->state = op_vs_eol;
+                        s = q;
+                    }
+                    else if( *q == ' ' || *q == '\t' )
+                    {
+                        /* Folded line, the value continues */
+                        opSetToken( token, op_token_property, stream->tag,
+                                    FALSE, s, p - s );
+                        found = ( p != s );
+                        s = q + 1;
+                    }
+                    else
+                    {
+                        opSetToken( token, op_token_property, stream->tag,
+                                    TRUE, s, p - s );
+                        found = TRUE;
+                        stream->state = op_vs_line_start;
+                        s = q;
+                    }
+                }
+                break;
+
+            case op_vs_eol:
+                s = opSkipCRLF( s, e );
+                if( s == e ) break;
+
+                if( *s == ' ' || *s == '\t' )
+                {
+                    stream->state = op_vs_value;
+                    s++;
+                }
+                else
+                {
+                    opSetToken( token, op_token_property, stream->tag,
+                                TRUE, s, 0 );
+                    found = TRUE;
+                    stream->state = op_vs_line_start;
+                }
+                break;
+
+            case op_vs_begin:
+            case op_vs_end:
+                s = opCollectName( stream, s, e, OP_CC_LINE );
+                if( s == e ) break;
+
+                opSetNameToken( stream, token,
+                                ( stream->state == op_vs_begin )?
+                                op_token_begin: op_token_end );
+                found = TRUE;
+                stream->state = op_vs_line_start;
+                break;
+
+            default:
+                stream->state = op_vs_line_start;
+                break;
+        }
+    }
+
+    stream->s = s;
+    return found;
+}
+
+/*************************************************************************
+ *NAME
+ *  opStreamXml
+ *
+ *DESCRIPTION
+ *  Tokenize XML data e.g: MAP message listing or PBAP vCard listing.
+ *
+ *PARAMETERS
+ *  stream - The parser state.
+ *  token - Filled in with the token found.
+ *
+ *RETURNS
+ *  TRUE if a token was found, FALSE if the data is consumed.
+ ************************************************************************/
+static bool opStreamXml( ObexParseStream* stream, ObexParseToken* token )
+{
+    const char *s = stream->s, *e = stream->e, *p;
+    bool found = FALSE;
+
+    while( !found && ( s != e ) )
+    {
+        switch( stream->state )
+        {
+            case op_xs_text:
+                s = opSkipBlank( s, e );
+                if( s == e ) break;
+
+                if( *s == '<' )
+                {
+                    stream->state = op_xs_lt;
+                    s++;
+                    break;
+                }
+                stream->state = op_xs_text_more;
+                /* fall through */
+
+            case op_xs_text_more:
+                p = opSkipToChar( s, e, '<' );
+                opSetToken( token, op_token_text, OBEX_PARSE_TAG_UNKNOWN,
+                            ( p != e ), s, p - s );
+                found = TRUE;
+
+                if( p != e )
+                {
+                    stream->state = op_xs_lt;
+                    p++;
+                }
+                s = p;
+                break;
+
+            case op_xs_lt:
+                opNameReset( stream );
+                if( *s == '/' )
+                {
+                    stream->state = op_xs_end_name;
+                    s++;
+                }
+                else if( *s == '?' || *s == '!' )
+                {
+                    stream->state = op_xs_skip;
+                }
+                else
+                {
+                    stream->state = op_xs_name;
+                }
+                break;
+
+            case op_xs_name:
+                s = opCollectName( stream, s, e, OP_CC_BLANK | OP_CC_XML );
+                if( s == e ) break;
+
+                opSetNameToken( stream, token, op_token_begin );
+                stream->elementTag = token->tag;
+                found = TRUE;
+                stream->state = op_xs_attrs;
+                break;
+
+            case op_xs_attrs:
+                s = opSkipBlank( s, e );
+                if( s == e ) break;
+
+                if( *s == '/' )
+                {
+                    stream->state = op_xs_empty;
+                    s++;
+                }
+                else if( *s == '>' )
+                {
+                    stream->state = op_xs_text;
+                    s++;
+                }
+                else
+                {
+                    opNameReset( stream );
+                    stream->state = op_xs_attr_name;
+                }
+                break;
+
+            case op_xs_attr_name:
+                s = opCollectName( stream, s, e, OP_CC_BLANK | OP_CC_XML );
+                if( s == e ) break;
+
+                stream->tag = opTagLookup( stream );
+                stream->state = op_xs_attr_eq;
+                break;
+
+            case op_xs_attr_eq:
+                while( ( s != e ) && ( *s == '=' ||
+                       ( opClass( *s ) & OP_CC_BLANK ) ) ) s++;
+                if( s == e ) break;
+
+                if( *s == '"' || *s == '\'' )
+                {
+                    stream->quote = *s;
+                    stream->state = op_xs_attr_value;
+                    s++;
+                }
+                else
+                {
+                    /* Attribute without a value */
+                    stream->state = op_xs_attrs;
+                }
+                break;
+
+            case op_xs_attr_value:
+                p = opSkipToChar( s, e, stream->quote );
+                opSetToken( token, op_token_property, stream->tag,
+                            ( p != e ), s, p - s );
+                found = TRUE;
+
+                if( p != e )
+                {
+                    stream->state = op_xs_attrs;
+                    p++;
+                }
+                s = p;
+                break;
+
+            case op_xs_empty:
+                opSetToken( token, op_token_end, stream->elementTag, TRUE,
+                            NULL, 0 );
+                found = TRUE;
+                stream->state = op_xs_skip;
+                break;
+
+            case op_xs_end_name:
+                s = opCollectName( stream, s, e, OP_CC_BLANK | OP_CC_XML );
+                if( s == e ) break;
+
+                opSetNameToken( stream, token, op_token_end );
+                found = TRUE;
+                stream->state = op_xs_skip;
+                break;
+
+            case op_xs_skip:
+                s = opSkipToChar( s, e, '>' );
+                if( s == e ) break;
+
+                stream->state = op_xs_text;
+                s++;
+                break;
+
+            default:
+                stream->state = op_xs_text;
+                break;
+        }
+    }
+
+    stream->s = s;
+    return found;
+}
+
+/*************************************************************************
+ *NAME
+ *  opStreamFlush
+ *
+ *DESCRIPTION
+ *  Complete a value left open at the end of the last part of the object.
+ *
+ *PARAMETERS
+ *  stream - The parser state.
+ *  token - Filled in with the token completing the value.
+ *
+ *RETURNS
+ *  TRUE if a token was returned.
+ ************************************************************************/
+static bool opStreamFlush( ObexParseStream* stream, ObexParseToken* token )
+{
+    bool found = TRUE;
+
+    if( stream->xml )
+    {
+        switch( stream->state )
+        {
+            case op_xs_text_more:
+                opSetToken( token, op_token_text, OBEX_PARSE_TAG_UNKNOWN,
+                            TRUE, stream->s, 0 );
+                break;
+
+            case op_xs_attr_value:
+                opSetToken( token, op_token_property, stream->tag, TRUE,
+                            stream->s, 0 );
+                break;
+
+            default:
+                found = FALSE;
+                break;
+        }
+        stream->state = op_xs_text;
+    }
+    else
+    {
+        switch( stream->state )
+        {
+            case op_vs_param:
+                opSetToken( token, op_token_param, stream->tag, TRUE,
+                            stream->s, 0 );
+                break;
+
+            case op_vs_value:
+            case op_vs_eol:
+                opSetToken( token, op_token_property, stream->tag, TRUE,
+                            stream->s, 0 );
+                break;
+
+            case op_vs_begin:
+                opSetNameToken( stream, token, op_token_begin );
+                break;
+
+            case op_vs_end:
+                opSetNameToken( stream, token, op_token_end );
+                break;
+
+            default:
+                found = FALSE;
+                break;
+        }
+        stream->state = op_vs_line_start;
+    }
+
+    return found;
+}
+
+/**************************************************************************
+ *NAME
+ *  ObexParseTagTableInit
+ *
+ *DESCRIPTION
+ *  Hash the tag names into the table. Collisions probe to the next slot.
+ *
+ *PARAMETERS
+ *  Refer obex_parse.h for details.
+ ************************************************************************/
+bool ObexParseTagTableInit( ObexParseTagTable* table,
+                            const char* const* tags,
+                            uint8 numTags )
+{
+    uint8 index;
+
+    memset( table->slots, 0, sizeof(table->slots) );
+    table->tags = tags;
+    table->numTags = 0;
+
+    if( numTags > OBEX_PARSE_MAX_TAGS ) return FALSE;
+
+    for( index = 0; index < numTags; index++ )
+    {
+        const char *tag = tags[index];
+        uint16 hash = 0;
+        uint16 slot;
+        uint16 len;
+
+        for( len = 0; tag[len]; len++ ) hash = opHashStep( hash, tag[len] );
+        if( len > OBEX_PARSE_MAX_NAME_LEN ) return FALSE;
+        table->lens[index] = (uint8)len;
+
+        slot = hash & ( OBEX_PARSE_TAG_HASH_SIZE - 1 );
+        while( table->slots[slot] )
+        {
+            slot = ( slot + 1 ) & ( OBEX_PARSE_TAG_HASH_SIZE - 1 );
+        }
+        table->slots[slot] = index + 1;
+        table->numTags++;
+    }
+
+    return TRUE;
+}
+
+/**************************************************************************
+ *NAME
+ *  ObexParseStreamInit
+ *
+ *DESCRIPTION
+ *  Reset the streaming parser for a new object.
+ *
+ *PARAMETERS
+ *  Refer obex_parse.h for details.
+ ************************************************************************/
+void ObexParseStreamInit( ObexParseStream* stream,
+                          const ObexParseTagTable* table,
+                          ObexParseObject objType )
+{
+    memset( stream, 0, sizeof(*stream) );
+    stream->table = table;
+    stream->xml = ( objType >= op_xml_element );
+    stream->state = ( stream->xml )? op_xs_text: op_vs_line_start;
+    stream->tag = OBEX_PARSE_TAG_UNKNOWN;
+    stream->elementTag = OBEX_PARSE_TAG_UNKNOWN;
+}
+
+/**************************************************************************
+ *NAME
+ *  ObexParseStreamData
+ *
+ *DESCRIPTION
+ *  Supply the next part of the object.
+ *
+ *PARAMETERS
+ *  Refer obex_parse.h for details.
+ ************************************************************************/
+void ObexParseStreamData( ObexParseStream* stream,
+                          const char* data,
+                          uint16 dataLen,
+                          bool last )
+{
+    stream->s = data;
+    stream->e = data + dataLen;
+    stream->last = last;
+}
+
+/**************************************************************************
+ *NAME
+ *  ObexParseStreamNext
+ *
+ *DESCRIPTION
+ *  Get the next token from the data supplied.
+ *
+ *PARAMETERS
+ *  Refer obex_parse.h for details.
+ ************************************************************************/
+ObexParseStatus ObexParseStreamNext( ObexParseStream* stream,
+                                     ObexParseToken* token )
+{
+    bool found;
+
+    if( stream->xml )
+    {
+        found = opStreamXml( stream, token );
+    }
+    else
+    {
+        found = opStreamVobj( stream, token );
+    }
+
+    if( !found && stream->last )
+    {
+        found = opStreamFlush( stream, token );
+    }
+
+    if( found && stream->nameTooLong )
+    {
+        stream->nameTooLong = FALSE;
+        return obex_parse_data_corrupted;
+    }
+
+    return found? obex_parse_success: obex_parse_get_more_data;
+}
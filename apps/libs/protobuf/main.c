@@ -0,0 +1,247 @@
+/* Copyright (c) 2018 Qualcomm Technologies International, Ltd. */
+/*  */
+/* Host benchmark for protobuf unpacking. Decodes representative AMA control
+   envelopes with the system allocator, an arena, and an arena in zero copy
+   mode, and reports the allocations made and the decode time of each.
+   Build with the ama library on the include path for the generated code. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vm.h>
+
+#include "protobuf.h"
+#include "accessories.pb-c.h"
+
+/* Number of times each message is decoded per measurement */
+#define DECODE_COUNT 10000
+
+/* Arena block size used by the benchmark, as the AMA library uses: a block
+   and its header fit the 512 byte pmalloc pool */
+#define ARENA_BLOCK_SIZE (512 - PROTOBUF_C_ARENA_BLOCK_HEADER_SIZE)
+
+/* System allocator that counts the calls made to it */
+static unsigned malloc_calls;
+
+static void *counting_alloc(void *allocator_data, size_t size)
+{
+    (void) allocator_data;
+    ++malloc_calls;
+    return malloc(size);
+}
+
+static void counting_free(void *allocator_data, void *pointer)
+{
+    (void) allocator_data;
+    free(pointer);
+}
+
+static ProtobufCAllocator counting_allocator =
+{
+    counting_alloc, counting_free, NULL
+};
+
+typedef struct
+{
+    const char *name;
+    uint8_t *data;
+    size_t len;
+} sample;
+
+static sample pack_envelope(const char *name, ControlEnvelope *envelope)
+{
+    sample s;
+    s.name = name;
+    s.len = control_envelope__get_packed_size(envelope);
+    s.data = malloc(s.len);
+    control_envelope__pack(envelope, s.data);
+    return s;
+}
+
+/* Wake word triggered StartSpeech, with a block of wake word metadata */
+static sample start_speech_sample(void)
+{
+    static uint8_t metadata[200];
+    SpeechSettings settings = SPEECH_SETTINGS__INIT;
+    SpeechInitiator__WakeWord wake_word = SPEECH_INITIATOR__WAKE_WORD__INIT;
+    SpeechInitiator initiator = SPEECH_INITIATOR__INIT;
+    Dialog dialog = DIALOG__INIT;
+    StartSpeech start = START_SPEECH__INIT;
+    ControlEnvelope envelope = CONTROL_ENVELOPE__INIT;
+    unsigned i;
+
+    for(i = 0; i < sizeof(metadata); i++)
+        metadata[i] = (uint8_t) i;
+
+    settings.audio_format = AUDIO_FORMAT__MSBC;
+    wake_word.start_index_in_samples = 8000;
+    wake_word.end_index_in_samples = 16000;
+    wake_word.metadata.len = sizeof(metadata);
+    wake_word.metadata.data = metadata;
+    initiator.type = SPEECH_INITIATOR__TYPE__WAKEWORD;
+    initiator.wake_word = &wake_word;
+    dialog.id = 12345;
+    start.settings = &settings;
+    start.initiator = &initiator;
+    start.dialog = &dialog;
+    envelope.command = COMMAND__START_SPEECH;
+    envelope.payload_case = CONTROL_ENVELOPE__PAYLOAD_START_SPEECH;
+    envelope.u.start_speech = &start;
+
+    return pack_envelope("StartSpeech", &envelope);
+}
+
+/* Response carrying the device information */
+static sample device_information_sample(void)
+{
+    static Transport transports[] = { TRANSPORT__BLUETOOTH_RFCOMM, TRANSPORT__BLUETOOTH_IAP };
+    DeviceInformation info = DEVICE_INFORMATION__INIT;
+    Response response = RESPONSE__INIT;
+    ControlEnvelope envelope = CONTROL_ENVELOPE__INIT;
+
+    info.serial_number = "1234567890";
+    info.name = "Earbuds";
+    info.device_type = "A32E8VQVU960EJ";
+    info.n_supported_transports = sizeof(transports) / sizeof(transports[0]);
+    info.supported_transports = transports;
+    response.payload_case = RESPONSE__PAYLOAD_DEVICE_INFORMATION;
+    response.u.device_information = &info;
+    envelope.command = COMMAND__GET_DEVICE_INFORMATION;
+    envelope.payload_case = CONTROL_ENVELOPE__PAYLOAD_RESPONSE;
+    envelope.u.response = &response;
+
+    return pack_envelope("DeviceInformation", &envelope);
+}
+
+/* Response carrying connection details */
+static sample connection_details_sample(void)
+{
+    static uint8_t identifier[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    ConnectionDetails details = CONNECTION_DETAILS__INIT;
+    Response response = RESPONSE__INIT;
+    ControlEnvelope envelope = CONTROL_ENVELOPE__INIT;
+
+    details.identifier.len = sizeof(identifier);
+    details.identifier.data = identifier;
+    response.payload_case = RESPONSE__PAYLOAD_CONNECTION_DETAILS;
+    response.u.connection_details = &details;
+    envelope.command = COMMAND__UPGRADE_TRANSPORT;
+    envelope.payload_case = CONTROL_ENVELOPE__PAYLOAD_RESPONSE;
+    envelope.u.response = &response;
+
+    return pack_envelope("ConnectionDetails", &envelope);
+}
+
+/* Decodes the sample DECODE_COUNT times. arena is NULL to use the counting
+   system allocator. Returns FALSE if any decode failed. */
+static protobuf_c_boolean run(const sample *s, ProtobufCArena *arena,
+                              unsigned *allocs, unsigned *mallocs, uint32 *ms)
+{
+    uint32 start;
+    unsigned i;
+
+    malloc_calls = 0;
+    start = VmGetClock();
+
+    for(i = 0; i < DECODE_COUNT; i++)
+    {
+        ControlEnvelope *envelope;
+
+        if(arena)
+        {
+            envelope = control_envelope__unpack(&arena->allocator, s->len, s->data);
+            if(!envelope)
+                return FALSE;
+            protobuf_c_arena_clear(arena);
+        }
+        else
+        {
+            envelope = control_envelope__unpack(&counting_allocator, s->len, s->data);
+            if(!envelope)
+                return FALSE;
+            control_envelope__free_unpacked(envelope, &counting_allocator);
+        }
+    }
+
+    *ms = VmGetClock() - start;
+    *allocs = (arena ? arena->n_allocs : malloc_calls) / DECODE_COUNT;
+    *mallocs = (arena ? arena->n_blocks : malloc_calls) / DECODE_COUNT;
+    return TRUE;
+}
+
+static void benchmark(const sample *s)
+{
+    static const char *modes[] = { "system", "arena", "arena zero copy" };
+    unsigned mode;
+
+    printf("%s (%u bytes):\n", s->name, (unsigned) s->len);
+    for(mode = 0; mode < 3; mode++)
+    {
+        ProtobufCArena arena;
+        unsigned allocs, mallocs;
+        uint32 ms;
+
+        protobuf_c_arena_init(&arena, ARENA_BLOCK_SIZE, mode == 2);
+        if(!run(s, mode ? &arena : NULL, &allocs, &mallocs, &ms))
+        {
+            printf("  %-16s FAIL!\n", modes[mode]);
+            continue;
+        }
+        printf("  %-16s %3u allocations, %3u system allocations, %ld ms\n",
+               modes[mode], allocs, mallocs, (long) ms);
+    }
+}
+
+/* Checks that a zero copy decode gives the same message as a copying one */
+static void verify(const sample *s)
+{
+    ProtobufCArena arena;
+    ControlEnvelope *copied, *in_place;
+    uint8_t *repacked_copied, *repacked_in_place;
+    size_t len;
+
+    protobuf_c_arena_init(&arena, ARENA_BLOCK_SIZE, TRUE);
+    copied = control_envelope__unpack(NULL, s->len, s->data);
+    in_place = control_envelope__unpack(&arena.allocator, s->len, s->data);
+    if(!copied || !in_place)
+    {
+        printf("%s: FAIL! (decode)\n", s->name);
+        return;
+    }
+
+    len = control_envelope__get_packed_size(copied);
+    repacked_copied = malloc(len);
+    repacked_in_place = malloc(len);
+    control_envelope__pack(copied, repacked_copied);
+    if(control_envelope__get_packed_size(in_place) != len ||
+       control_envelope__pack(in_place, repacked_in_place) != len ||
+       memcmp(repacked_copied, repacked_in_place, len) != 0 ||
+       len != s->len || memcmp(repacked_copied, s->data, len) != 0)
+        printf("%s: FAIL! (round trip)\n", s->name);
+
+    free(repacked_copied);
+    free(repacked_in_place);
+    control_envelope__free_unpacked(copied, NULL);
+    protobuf_c_arena_clear(&arena);
+}
+
+int main(void)
+{
+    sample samples[3];
+    unsigned i;
+
+    samples[0] = start_speech_sample();
+    samples[1] = device_information_sample();
+    samples[2] = connection_details_sample();
+
+    for(i = 0; i < 3; i++)
+        verify(&samples[i]);
+
+    printf("Decoding each message %d times\n", DECODE_COUNT);
+    for(i = 0; i < 3; i++)
+    {
+        benchmark(&samples[i]);
+        free(samples[i].data);
+    }
+    return 0;
+}
@@ -188,6 +188,164 @@ static ProtobufCAllocator protobuf_c__allocator = {
     .allocator_data = NULL,
 };
 
+/* === arena === */
+
+/*
+ * Arena blocks are a small header followed by the allocations. Both are kept
+ * aligned for the widest scalar a message can contain.
+ */
+#define ARENA_ALIGN	sizeof(_uint64_t)
+#define ARENA_ROUND(n)	(((n) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+struct ProtobufCArenaBlock {
+    struct ProtobufCArenaBlock *next;
+};
+
+#define ARENA_HEADER	PROTOBUF_C_ARENA_BLOCK_HEADER_SIZE
+
+/* The header must hold the block structure and keep the allocations after
+ * it aligned */
+STATIC_ASSERT(sizeof(struct ProtobufCArenaBlock) <= ARENA_HEADER &&
+              ARENA_ROUND(ARENA_HEADER) == ARENA_HEADER, arena_header_too_small);
+
+/* Start a new current block. What is left of the previous one is abandoned. */
+static void
+arena_new_block(ProtobufCArena *arena)
+{
+    struct ProtobufCArenaBlock *block =
+        system_alloc(NULL, ARENA_HEADER + arena->block_size);
+
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->next = (uint8_t *) block + ARENA_HEADER;
+    arena->remaining = arena->block_size;
+    arena->n_blocks++;
+}
+
+static void *
+arena_alloc(void *allocator_data, size_t size)
+{
+    ProtobufCArena *arena = allocator_data;
+    void *ptr;
+
+    size = ARENA_ROUND(size);
+    if (size > arena->block_size) {
+        /* Requests larger than a block get a block of their own, leaving
+         * the current block in use for the allocations that follow */
+        struct ProtobufCArenaBlock *block =
+            system_alloc(NULL, ARENA_HEADER + size);
+
+        if (arena->blocks != NULL) {
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        } else {
+            block->next = NULL;
+            arena->blocks = block;
+        }
+        arena->n_blocks++;
+        arena->n_allocs++;
+        return (uint8_t *) block + ARENA_HEADER;
+    }
+
+    if (size > arena->remaining)
+        arena_new_block(arena);
+
+    ptr = arena->next;
+    arena->next += size;
+    arena->remaining -= size;
+    arena->n_allocs++;
+    return ptr;
+}
+
+static void
+arena_free(void *allocator_data, void *data)
+{
+    /* Everything is released at once by protobuf_c_arena_clear() */
+    UNUSED(allocator_data);
+    UNUSED(data);
+}
+
+/*
+ * TRUE if bytes fields unpacked with this allocator may point into the
+ * source buffer rather than being copied out of it.
+ */
+static inline protobuf_c_boolean
+is_zero_copy(const ProtobufCAllocator *allocator)
+{
+    return allocator->alloc == &arena_alloc &&
+        ((const ProtobufCArena *) allocator->allocator_data)->zero_copy;
+}
+
+/*
+ * Working memory needed only for the duration of an unpack. From an arena it
+ * is taken from the top of the current block, growing down towards the
+ * message data, so that it can be given back when it is freed. Nested unpacks
+ * free their scratch in the reverse order of allocation.
+ */
+static void *
+scratch_alloc(ProtobufCAllocator *allocator, size_t size)
+{
+    if (allocator->alloc == &arena_alloc) {
+        ProtobufCArena *arena = allocator->allocator_data;
+
+        size = ARENA_ROUND(size);
+        if (size <= arena->block_size) {
+            if (size > arena->remaining)
+                arena_new_block(arena);
+            arena->remaining -= size;
+            arena->n_allocs++;
+            return arena->next + arena->remaining;
+        }
+    }
+    return do_alloc(allocator, size);
+}
+
+static void
+scratch_free(ProtobufCAllocator *allocator, void *data, size_t size)
+{
+    if (allocator->alloc == &arena_alloc) {
+        ProtobufCArena *arena = allocator->allocator_data;
+
+        /* Scratch left behind in an earlier block stays until the arena is
+         * cleared */
+        if ((uint8_t *) data == arena->next + arena->remaining)
+            arena->remaining += ARENA_ROUND(size);
+        return;
+    }
+    do_free(allocator, data);
+}
+
+void
+protobuf_c_arena_init(ProtobufCArena *arena, size_t block_size,
+              protobuf_c_boolean zero_copy)
+{
+    arena->allocator.alloc = &arena_alloc;
+    arena->allocator.free = &arena_free;
+    arena->allocator.allocator_data = arena;
+    arena->blocks = NULL;
+    arena->next = NULL;
+    arena->remaining = 0;
+    arena->block_size = ARENA_ROUND(block_size);
+    arena->zero_copy = zero_copy;
+    arena->n_allocs = 0;
+    arena->n_blocks = 0;
+}
+
+void
+protobuf_c_arena_clear(ProtobufCArena *arena)
+{
+    struct ProtobufCArenaBlock *block = arena->blocks;
+
+    while (block != NULL) {
+        struct ProtobufCArenaBlock *next = block->next;
+        system_free(NULL, block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    arena->next = NULL;
+    arena->remaining = 0;
+}
+
 /* === buffer-simple === */
 
 void
@@ -2581,7 +2739,9 @@ parse_required_member(ScannedMember *scanned_member,
         {
             do_free(allocator, bd->data);
         }
-        if (len - pref_len > 0) {
+        if (len - pref_len > 0 && is_zero_copy(allocator)) {
+            bd->data = (uint8_t *) data + pref_len;
+        } else if (len - pref_len > 0) {
             bd->data = do_alloc(allocator, len - pref_len);
             if (bd->data == NULL)
                 return FALSE;
@@ -2888,6 +3048,10 @@ parse_member(ScannedMember *scanned_member,
         ufield->tag = scanned_member->tag;
         ufield->wire_type = scanned_member->wire_type;
         ufield->len = scanned_member->len;
+        if (is_zero_copy(allocator)) {
+            ufield->data = (uint8_t *) scanned_member->data;
+            return TRUE;
+        }
         ufield->data = do_alloc(allocator, scanned_member->len);
         if (ufield->data == NULL)
             return FALSE;
@@ -3010,6 +3174,12 @@ message_init_generic(const ProtobufCMessageDescriptor *desc,
    - BOUND_SIZEOF_SCANNED_MEMBER_LOG2		\
    - FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2)
 
+/*
+ * Required fields bitmap size that fits in the unpack scratch allocation,
+ * enough for messages of up to 128 fields.
+ */
+#define REQUIRED_FIELDS_BITMAP_STACK_LEN	16
+
 #define REQUIRED_FIELD_BITMAP_SET(index)	\
     (required_fields_bitmap[(index)/8] |= (1UL<<((index)%8)))
 
@@ -3029,27 +3199,31 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
     if (allocator == NULL)
         allocator = &protobuf_c__allocator;
 
-    ScannedMember * first_member_slab = do_alloc(allocator, ( (1UL << FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2)*sizeof(ScannedMember) ) );
-    if (!first_member_slab)
+    /*
+     * The first ScannedMember slab, the slab table and the small required
+     * fields bitmap are only needed while unpacking, so they share a single
+     * scratch allocation.
+     */
+    const size_t scratch_size =
+        (1UL << FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2) * sizeof(ScannedMember) +
+        (MAX_SCANNED_MEMBER_SLAB + 1) * sizeof(ScannedMember *) +
+        REQUIRED_FIELDS_BITMAP_STACK_LEN;
+    void *scratch = scratch_alloc(allocator, scratch_size);
+    if (!scratch)
         return (NULL);
 
-    memset(first_member_slab, 0, (1UL << FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2)*sizeof(ScannedMember) );
-   
+    memset(scratch, 0, scratch_size);
+
+    ScannedMember * first_member_slab = scratch;
+
     /*
      * scanned_member_slabs[i] is an array of arrays of ScannedMember.
      * The first slab (scanned_member_slabs[0] is just a pointer to
      * first_member_slab), above. All subsequent slabs will be allocated
      * using the allocator.
      */
-    ScannedMember **scanned_member_slabs = do_alloc(allocator, (MAX_SCANNED_MEMBER_SLAB + 1) * sizeof(ScannedMember *) );
-    if(!scanned_member_slabs)
-    {
-        do_free(allocator, first_member_slab);
-        return NULL;
-    }
-
-    memset(scanned_member_slabs, 0, (MAX_SCANNED_MEMBER_SLAB + 1) * sizeof(*scanned_member_slabs));
-
+    ScannedMember **scanned_member_slabs = (ScannedMember **)
+        (first_member_slab + (1UL << FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2));
 
     unsigned which_slab = 0; /* the slab we are currently populating */
     unsigned in_slab_index = 0; /* number of members in the slab */
@@ -3059,15 +3233,8 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
     unsigned i_slab;
     unsigned last_field_index = 0;
     unsigned required_fields_bitmap_len;
-    unsigned char * required_fields_bitmap_stack = do_alloc(allocator, 16*sizeof(unsigned char) );
-    if (!required_fields_bitmap_stack)
-    {
-        do_free(allocator, first_member_slab);
-        do_free(allocator, scanned_member_slabs);
-        return (NULL);
-    }
-
-    memset(required_fields_bitmap_stack, 0, 16*sizeof(unsigned char) );
+    unsigned char * required_fields_bitmap_stack = (unsigned char *)
+        (scanned_member_slabs + MAX_SCANNED_MEMBER_SLAB + 1);
     
     unsigned char *required_fields_bitmap = required_fields_bitmap_stack;
     protobuf_c_boolean required_fields_bitmap_alloced = FALSE;
@@ -3077,21 +3244,16 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
     rv = do_alloc(allocator, desc->sizeof_message);
     if (!rv)
     {
-        do_free(allocator, required_fields_bitmap_stack);
-        do_free(allocator, first_member_slab);
-        do_free(allocator, scanned_member_slabs);
-
+        scratch_free(allocator, scratch, scratch_size);
         return (NULL);
     }
     scanned_member_slabs[0] = first_member_slab;
 
     required_fields_bitmap_len = (desc->n_fields + 7) / 8;
-    if (required_fields_bitmap_len > sizeof(required_fields_bitmap_stack)) {
+    if (required_fields_bitmap_len > REQUIRED_FIELDS_BITMAP_STACK_LEN) {
         required_fields_bitmap = do_alloc(allocator, required_fields_bitmap_len);
         if (!required_fields_bitmap) {
-            do_free(allocator, required_fields_bitmap_stack);
-            do_free(allocator, first_member_slab);
-            do_free(allocator, scanned_member_slabs);
+            scratch_free(allocator, scratch, scratch_size);
             do_free(allocator, rv);
             return (NULL);
         }
@@ -3322,9 +3484,7 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
         do_free(allocator, scanned_member_slabs[j]);
     if (required_fields_bitmap_alloced)
         do_free(allocator, required_fields_bitmap);
-    do_free(allocator, required_fields_bitmap_stack);
-    do_free(allocator, first_member_slab);
-    do_free(allocator, scanned_member_slabs);
+    scratch_free(allocator, scratch, scratch_size);
     return rv;
 
 error_cleanup:
@@ -3333,9 +3493,7 @@ error_cleanup:
         do_free(allocator, scanned_member_slabs[j]);
     if (required_fields_bitmap_alloced)
         do_free(allocator, required_fields_bitmap);
-    do_free(allocator, required_fields_bitmap_stack);
-    do_free(allocator, first_member_slab);
-    do_free(allocator, scanned_member_slabs);
+    scratch_free(allocator, scratch, scratch_size);
     return NULL;
 
 error_cleanup_during_scan:
@@ -3344,9 +3502,7 @@ error_cleanup_during_scan:
         do_free(allocator, scanned_member_slabs[j]);
     if (required_fields_bitmap_alloced)
         do_free(allocator, required_fields_bitmap);
-    do_free(allocator, required_fields_bitmap_stack);
-    do_free(allocator, first_member_slab);
-    do_free(allocator, scanned_member_slabs);
+    scratch_free(allocator, scratch, scratch_size);
     return NULL;
 }
 
@@ -346,6 +346,8 @@ typedef enum {
 } ProtobufCWireType;
 
 struct ProtobufCAllocator;
+struct ProtobufCArena;
+struct ProtobufCArenaBlock;
 struct ProtobufCBinaryData;
 struct ProtobufCBuffer;
 struct ProtobufCBufferSimple;
@@ -362,6 +364,7 @@ struct ProtobufCService;
 struct ProtobufCServiceDescriptor;
 
 typedef struct ProtobufCAllocator ProtobufCAllocator;
+typedef struct ProtobufCArena ProtobufCArena;
 typedef struct ProtobufCBinaryData ProtobufCBinaryData;
 typedef struct ProtobufCBuffer ProtobufCBuffer;
 typedef struct ProtobufCBufferSimple ProtobufCBufferSimple;
@@ -398,6 +401,56 @@ struct ProtobufCAllocator {
     void		*allocator_data;
 };
 
+/**
+ * Bytes each arena block takes from the system allocator on top of its
+ * `block_size`. A caller that sizes blocks to fit a memory pool should take
+ * this off the pool size.
+ */
+#define PROTOBUF_C_ARENA_BLOCK_HEADER_SIZE	8
+
+/**
+ * Arena allocator.
+ *
+ * Allocations are carved out of blocks of `block_size` bytes taken from the
+ * system allocator, and individual frees are ignored. Passing `&arena.allocator`
+ * to an unpack function therefore costs one pmalloc per block rather than one
+ * per message, repeated field and bytes field, and the whole decoded message
+ * is released with a single call to protobuf_c_arena_clear(). The arena can
+ * then be reused for the next message.
+ *
+ * In zero copy mode, bytes fields and unknown fields of a message unpacked
+ * from the arena point into the serialised data instead of being copied, so
+ * the serialised data must outlive the message. String fields are still
+ * copied (into the arena) as they have to be `NUL`-terminated.
+ *
+~~~{.c}
+ProtobufCArena arena;
+protobuf_c_arena_init(&arena, 256, TRUE);
+msg = foo__unpack(&arena.allocator, len, data);
+...
+protobuf_c_arena_clear(&arena);
+~~~
+ */
+struct ProtobufCArena {
+    /** "Base class", pass this to the unpack functions. */
+    ProtobufCAllocator	allocator;
+    /** Blocks in use, most recent first. */
+    struct ProtobufCArenaBlock *blocks;
+    /** Next free byte in the current block. */
+    uint8_t		*next;
+    /** Bytes left in the current block. */
+    size_t		remaining;
+    /** Size of each block. */
+    size_t		block_size;
+    /** Whether bytes fields point into the serialised data. */
+    protobuf_c_boolean	zero_copy;
+    /** Number of allocations served since initialisation, for profiling. */
+    unsigned		n_allocs;
+    /** Number of blocks taken from the system allocator since
+     *  initialisation, for profiling. */
+    unsigned		n_blocks;
+};
+
 /**
  * Structure for the protobuf `bytes` scalar type.
  *
@@ -981,6 +1034,36 @@ protobuf_c_message_free_unpacked(
     ProtobufCMessage *message,
     ProtobufCAllocator *allocator);
 
+/**
+ * Initialise an arena allocator. No memory is allocated until the first
+ * allocation from the arena.
+ *
+ * \param arena
+ *      The arena to initialise.
+ * \param block_size
+ *      Size in bytes of the blocks the arena takes from the system allocator.
+ * \param zero_copy
+ *      TRUE if bytes fields should point into the serialised data.
+ */
+PROTOBUF_C__API
+void
+protobuf_c_arena_init(
+    ProtobufCArena *arena,
+    size_t block_size,
+    protobuf_c_boolean zero_copy);
+
+/**
+ * Free everything allocated from an arena. Every message unpacked with the
+ * arena becomes invalid; there is no need to call
+ * protobuf_c_message_free_unpacked() on them first.
+ *
+ * \param arena
+ *      The arena to clear. It can be used again straight away.
+ */
+PROTOBUF_C__API
+void
+protobuf_c_arena_clear(ProtobufCArena *arena);
+
 /**
  * Check the validity of a message object.
  *
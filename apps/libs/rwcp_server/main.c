@@ -0,0 +1,544 @@
+/****************************************************************************
+Copyright (c) 2017 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    main.c
+
+DESCRIPTION
+    Host loss and reorder simulator for the RWCP server. A client with a
+    sliding window sends an upgrade image's worth of DATA segments over a
+    channel with latency, loss and reordering in both directions. It resends
+    from the GAP on a GAP and everything outstanding on a timeout, and
+    skips resends that a later cumulative ACK already covers. Now and then
+    the upgrade library pauses the server through RwcpServerFlowControl.
+
+    Every scenario is run twice. The first run uses the server as built. In
+    the second run the server holds no segments for reassembly, the way it
+    drops them without reassembly. Both runs check that:
+    - every segment reaches GAIA exactly once, in order and intact;
+    - an in-sequence segment is ACKed before it is processed;
+    - the held payloads stay within RWCP_REASSEMBLY_BYTES_MAX;
+    - nothing is leaked.
+    The output reports the traffic and the peak memory held.
+
+    The server source is included so the harness can count its allocations
+    and read its state. Build from this directory with the flags of the
+    library build plus -I../gaia -I../gatt -I../upgrade
+    -I../transport_manager, and run it. It is not part of the library.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <panic.h>
+#include <gaia.h>
+
+static void *simMalloc(size_t size);
+static void simFree(void *ptr);
+
+#define malloc(size)    simMalloc(size)
+#define free(ptr)       simFree(ptr)
+#include "rwcp_server.c"
+#undef malloc
+#undef free
+
+/* Segments in the simulated upgrade image */
+#define SIM_SEGMENTS            3000
+
+/* Size of a DATA segment including the RWCP header. The payload starts
+   with the segment index, the rest is a pattern derived from it. */
+#define SIM_SEGMENT_SIZE        160
+
+/* Client window, in segments */
+#define SIM_CLIENT_WINDOW       15
+
+/* One way latency of the channel, in ticks. The client sends at most one
+   segment per tick. */
+#define SIM_LATENCY             3
+
+/* Largest extra delay of a reordered segment or notification, in ticks */
+#define SIM_REORDER_DELAY       4
+
+/* Ticks without progress before the client resends everything
+   outstanding */
+#define SIM_TIMEOUT             (4 * SIM_LATENCY + 8)
+
+/* Ticks the upgrade library keeps the server paused */
+#define SIM_PAUSE_TICKS         6
+
+/* Give up on a scenario after this many ticks */
+#define SIM_TICK_LIMIT          (SIM_SEGMENTS * 50)
+
+/* Segments and notifications in flight */
+#define SIM_CHANNEL_SIZE        128
+
+/* Notifications sent by the server */
+#define SIM_NOTIFICATION_DATA_ACK   0x00
+#define SIM_NOTIFICATION_SYN_ACK    0x40
+#define SIM_NOTIFICATION_GAP        0xc0
+
+typedef struct
+{
+    const char *name;
+    unsigned loss_percent;              /* each direction */
+    unsigned reorder_percent;           /* each direction */
+    unsigned pause_per_mille;           /* chance per tick of a pause */
+} sim_scenario;
+
+typedef struct
+{
+    unsigned due;                       /* tick it arrives */
+    int index;                          /* segment index, or -1 for a notification */
+    uint8 header;                       /* RWCP header */
+} sim_packet;
+
+typedef struct
+{
+    sim_packet to_server[SIM_CHANNEL_SIZE];
+    sim_packet to_client[SIM_CHANNEL_SIZE];
+    unsigned tick;
+
+    /* Client */
+    bool established;
+    int base;                           /* oldest unacknowledged segment */
+    int next;                           /* next new segment */
+    int resend;                         /* next segment to resend */
+    int resend_end;                     /* resend up to, not including */
+    unsigned last_progress;             /* tick base last moved */
+
+    /* Upgrade library */
+    int expected;                       /* next segment GAIA should see */
+    unsigned paused_until;              /* 0 if not paused */
+    int handling;                       /* segment being handled, -1 if none */
+    bool acked_handling;                /* its ACK has been sent */
+
+    /* Results */
+    unsigned sent;
+    unsigned resends;
+    unsigned resends_skipped;
+    unsigned gaps;
+    unsigned timeouts;
+    unsigned pauses;
+    unsigned peak_held;
+    unsigned peak_bytes;
+    unsigned failures;
+} sim_state;
+
+static const sim_scenario scenarios[] =
+{
+    { "clean",                  0,  0,  0 },
+    { "1% loss",                1,  0,  0 },
+    { "5% loss",                5,  0,  0 },
+    { "5% reorder",             0,  5,  0 },
+    { "2% loss, 5% reorder",    2,  5,  0 },
+    { "2% loss, flow control",  2,  0,  5 },
+};
+
+static sim_state sim;
+static unsigned live_allocations;
+static unsigned random_state;
+
+static void *simMalloc(size_t size)
+{
+    void *ptr = malloc(size);
+    if (ptr != NULL)
+    {
+        live_allocations++;
+    }
+    return ptr;
+}
+
+static void simFree(void *ptr)
+{
+    if (ptr != NULL)
+    {
+        live_allocations--;
+    }
+    free(ptr);
+}
+
+void *PanicUnlessMalloc(size_t sz)
+{
+    void *ptr = malloc(sz);
+    if (ptr == NULL)
+    {
+        printf("FAIL: out of memory\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+static unsigned randomBelow(unsigned limit)
+{
+    random_state = random_state * 1664525u + 1013904223u;
+    return (unsigned)(((unsigned long long)(random_state >> 8) * limit) >> 24);
+}
+
+static uint8 segmentSequence(int index)
+{
+    return (uint8)((index + 1) % RWCP_SEQUENCE_NUMBER_MAX);
+}
+
+static uint8 segmentPattern(int index, uint16 offset)
+{
+    return (uint8)(index * 7 + offset * 13);
+}
+
+/* Put a packet on the channel, unless the channel loses it */
+static void channelSend(sim_packet *channel, const sim_scenario *scenario,
+                        int index, uint8 header)
+{
+    unsigned delay = SIM_LATENCY;
+    unsigned i;
+
+    if (randomBelow(100) < scenario->loss_percent)
+    {
+        return;
+    }
+    if (randomBelow(100) < scenario->reorder_percent)
+    {
+        delay += 1 + randomBelow(SIM_REORDER_DELAY);
+    }
+    for (i = 0; i < SIM_CHANNEL_SIZE; i++)
+    {
+        if (channel[i].due == 0)
+        {
+            channel[i].due = sim.tick + delay;
+            channel[i].index = index;
+            channel[i].header = header;
+            return;
+        }
+    }
+    /* A full channel loses the packet */
+}
+
+/* Take the next packet due at this tick, in the order they were sent */
+static bool channelReceive(sim_packet *channel, sim_packet *packet)
+{
+    unsigned i;
+    unsigned found = SIM_CHANNEL_SIZE;
+
+    for (i = 0; i < SIM_CHANNEL_SIZE; i++)
+    {
+        if (channel[i].due != 0 && channel[i].due <= sim.tick
+            && (found == SIM_CHANNEL_SIZE || channel[i].due < channel[found].due))
+        {
+            found = i;
+        }
+    }
+    if (found == SIM_CHANNEL_SIZE)
+    {
+        return FALSE;
+    }
+    *packet = channel[found];
+    channel[found].due = 0;
+    return TRUE;
+}
+
+static const sim_scenario *current_scenario;
+
+/* Server notification, to the client */
+void GaiaRwcpSendNotification(uint8 *payload, uint16 payload_length)
+{
+    uint8 header = payload[0];
+
+    if (payload_length != RWCP_HEADER_SIZE)
+    {
+        printf("FAIL: notification of %u bytes\n", payload_length);
+        sim.failures++;
+    }
+    if ((header & RWCP_COMMAND_MASK) == SIM_NOTIFICATION_DATA_ACK && sim.handling >= 0
+        && (header & RWCP_SEQUENCE_MASK) == segmentSequence(sim.handling))
+    {
+        sim.acked_handling = TRUE;
+    }
+    channelSend(sim.to_client, current_scenario, -1, header);
+    free(payload);
+}
+
+/* Segment passed on by the server, to the upgrade library */
+void GaiaRwcpProcessCommand(uint8 *command, uint16 size_command)
+{
+    int index = command[0] | (command[1] << 8);
+    uint16 i;
+
+    if (index != sim.expected)
+    {
+        printf("FAIL: GAIA received segment %d, expected %d\n", index, sim.expected);
+        sim.failures++;
+    }
+    if (size_command != SIM_SEGMENT_SIZE - RWCP_HEADER_SIZE)
+    {
+        printf("FAIL: segment %d has %u bytes\n", index, size_command);
+        sim.failures++;
+    }
+    for (i = 2; i < size_command; i++)
+    {
+        if (command[i] != segmentPattern(index, i))
+        {
+            printf("FAIL: segment %d corrupt at %u\n", index, i);
+            sim.failures++;
+            break;
+        }
+    }
+    if (index == sim.handling && !sim.acked_handling)
+    {
+        printf("FAIL: segment %d processed before it was acknowledged\n", index);
+        sim.failures++;
+    }
+    sim.expected = index + 1;
+}
+
+/* Map a sequence number in a notification to the segment it covers */
+static int clientSegment(uint8 sequence)
+{
+    int index;
+
+    for (index = sim.base - 1; index < sim.next; index++)
+    {
+        if (segmentSequence(index) == sequence)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+static void clientAcknowledged(int index)
+{
+    if (index >= sim.base)
+    {
+        sim.base = index + 1;
+        sim.last_progress = sim.tick;
+    }
+}
+
+static void clientResendOutstanding(void)
+{
+    sim.resend = sim.base;
+    sim.resend_end = sim.next;
+}
+
+static void clientNotification(uint8 header)
+{
+    int index = clientSegment(header & RWCP_SEQUENCE_MASK);
+
+    switch (header & RWCP_COMMAND_MASK)
+    {
+        case SIM_NOTIFICATION_SYN_ACK:
+            if (!sim.established)
+            {
+                sim.established = TRUE;
+                sim.last_progress = sim.tick;
+            }
+            break;
+
+        case SIM_NOTIFICATION_DATA_ACK:
+            if (index >= 0)
+            {
+                clientAcknowledged(index);
+            }
+            break;
+
+        case SIM_NOTIFICATION_GAP:
+            sim.gaps++;
+            if (index >= 0)
+            {
+                clientAcknowledged(index);
+            }
+            if (sim.resend >= sim.resend_end || sim.resend > sim.base)
+            {
+                clientResendOutstanding();
+            }
+            break;
+
+        default:
+            printf("FAIL: unexpected notification 0x%02x\n", header);
+            sim.failures++;
+            break;
+    }
+}
+
+static void clientSend(const sim_scenario *scenario)
+{
+    int index = -1;
+
+    if (!sim.established)
+    {
+        /* SYN until the server answers */
+        if (sim.tick % SIM_TIMEOUT == 1)
+        {
+            channelSend(sim.to_server, scenario, -1, RWCP_CLIENT_CMD_SYN);
+        }
+        return;
+    }
+
+    /* Resends a later cumulative ACK already covers are skipped */
+    if (sim.resend < sim.base && sim.resend < sim.resend_end)
+    {
+        sim.resends_skipped += (unsigned)(
+            (sim.base < sim.resend_end ? sim.base : sim.resend_end) - sim.resend);
+        sim.resend = sim.base;
+    }
+
+    if (sim.resend < sim.resend_end)
+    {
+        index = sim.resend++;
+        sim.resends++;
+    }
+    else if (sim.next < sim.base + SIM_CLIENT_WINDOW && sim.next < SIM_SEGMENTS)
+    {
+        index = sim.next++;
+    }
+
+    if (index >= 0)
+    {
+        sim.sent++;
+        channelSend(sim.to_server, scenario, index,
+                    RWCP_CLIENT_CMD_DATA | segmentSequence(index));
+    }
+}
+
+static void serverReceive(const sim_packet *packet, bool reassembly)
+{
+    uint8 data[SIM_SEGMENT_SIZE];
+    uint16 size = RWCP_HEADER_SIZE;
+    uint16 i;
+
+    data[0] = packet->header;
+    if (packet->index >= 0)
+    {
+        data[1] = (uint8)packet->index;
+        data[2] = (uint8)(packet->index >> 8);
+        for (i = 2; i < SIM_SEGMENT_SIZE - RWCP_HEADER_SIZE; i++)
+        {
+            data[RWCP_PAYLOAD_OFFSET + i] = segmentPattern(packet->index, i);
+        }
+        size = SIM_SEGMENT_SIZE;
+    }
+
+    sim.handling = packet->index;
+    sim.acked_handling = FALSE;
+    RwcpServerHandleMessage(data, size);
+    sim.handling = -1;
+
+    if (!reassembly)
+    {
+        /* As if it had not been held */
+        releaseSegments();
+    }
+
+    if (g_server_data.segments_held > sim.peak_held)
+    {
+        sim.peak_held = g_server_data.segments_held;
+    }
+    if (g_server_data.bytes_held > sim.peak_bytes)
+    {
+        sim.peak_bytes = g_server_data.bytes_held;
+    }
+    if (g_server_data.bytes_held > RWCP_REASSEMBLY_BYTES_MAX)
+    {
+        printf("FAIL: %u bytes held\n", g_server_data.bytes_held);
+        sim.failures++;
+    }
+    if (live_allocations != g_server_data.segments_held)
+    {
+        printf("FAIL: %u allocations for %u held segments\n",
+               live_allocations, g_server_data.segments_held);
+        sim.failures++;
+    }
+}
+
+static unsigned runScenario(const sim_scenario *scenario, bool reassembly)
+{
+    sim_packet packet;
+
+    memset(&sim, 0, sizeof(sim));
+    sim.handling = -1;
+    current_scenario = scenario;
+    random_state = 1;
+    RwcpServerInit(0);
+
+    for (sim.tick = 1; sim.expected < SIM_SEGMENTS || sim.base < SIM_SEGMENTS; sim.tick++)
+    {
+        if (sim.tick > SIM_TICK_LIMIT)
+        {
+            printf("FAIL: %s: stalled at segment %d\n", scenario->name, sim.expected);
+            sim.failures++;
+            break;
+        }
+
+        while (channelReceive(sim.to_client, &packet))
+        {
+            clientNotification(packet.header);
+        }
+
+        if (sim.paused_until != 0 && sim.tick >= sim.paused_until)
+        {
+            sim.paused_until = 0;
+            RwcpServerFlowControl(TRUE);
+        }
+        else if (sim.paused_until == 0 && randomBelow(1000) < scenario->pause_per_mille)
+        {
+            sim.paused_until = sim.tick + SIM_PAUSE_TICKS;
+            sim.pauses++;
+            RwcpServerFlowControl(FALSE);
+        }
+
+        while (channelReceive(sim.to_server, &packet))
+        {
+            serverReceive(&packet, reassembly);
+        }
+
+        if (sim.established && sim.base < sim.next
+            && sim.tick - sim.last_progress >= SIM_TIMEOUT)
+        {
+            sim.timeouts++;
+            sim.last_progress = sim.tick;
+            clientResendOutstanding();
+        }
+
+        clientSend(scenario);
+    }
+
+    /* A new session releases anything still held */
+    RwcpServerInit(0);
+    if (live_allocations != 0)
+    {
+        printf("FAIL: %s: %u allocations leaked\n", scenario->name, live_allocations);
+        sim.failures++;
+    }
+
+    printf("%-22s %-6s %6u ticks %6u sent %5u resent %5u skipped %4u gaps %3u timeouts"
+           " %3u pauses, held %2u / %4u bytes\n",
+           scenario->name, reassembly ? "hold" : "drop", sim.tick, sim.sent,
+           sim.resends, sim.resends_skipped, sim.gaps, sim.timeouts, sim.pauses,
+           sim.peak_held, sim.peak_bytes);
+
+    return sim.failures;
+}
+
+int main(void)
+{
+    unsigned failures = 0;
+    unsigned i;
+
+    printf("%u segments of %u bytes, window %u, latency %u ticks\n\n",
+           SIM_SEGMENTS, SIM_SEGMENT_SIZE, SIM_CLIENT_WINDOW, SIM_LATENCY);
+
+    for (i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        failures += runScenario(&scenarios[i], TRUE);
+        failures += runScenario(&scenarios[i], FALSE);
+    }
+
+    if (failures != 0)
+    {
+        printf("\n%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
@@ -16,17 +16,6 @@ DESCRIPTION
 #include "rwcp_server.h"
 #include <gaia.h>
 
-/* Service data type */
-typedef struct
-{
-    rwcp_protocol_state protocol_state;          /* RWCP Server states */
-    bool out_of_sequence_status;          /* temporarily mute GAP replies during congestion */
-    uint8 last_sequence_number;          /* last acknowledged sequence number */
-    uint8 rwcp_upgrade_header_size;          /*cumulative header size of GAIA and Upgrade headers */
-    bool accept_segments;          /* flow control flag */
-    Task client_task;          /*Client task*/
-} SERVER_DATA_T;
-
 /*
  * RWCP protocol definitions
  */
@@ -63,6 +52,37 @@ typedef enum
 #define RWCP_RECEIVE_WINDOW_MAX                         32
 #define RWCP_SEQUENCE_NUMBER_INVALID                0xFF
 
+/* Out of sequence segments inside the receive window are held until the
+ * missing ones arrive, rather than being dropped and resent, for as long as
+ * their payloads fit in RWCP_REASSEMBLY_BYTES_MAX. Held payloads come from
+ * the larger pmalloc pools (140 to 692 bytes on the earbud, about 5K in
+ * all). Holding no more than a fifth of that leaves GAIA and the upgrade
+ * library blocks while a gap is being filled, but it also means only about
+ * six full size segments are held, not the full window of 32. Later
+ * segments are dropped and resent by the client as before. */
+#define RWCP_REASSEMBLY_BYTES_MAX                       1024
+
+/* Reassembly slot for an out of sequence segment */
+typedef struct
+{
+    uint8 *payload;          /* segment payload without the RWCP header, NULL if empty */
+    uint16 size_payload;          /* size of the payload */
+} rwcp_segment_t;
+
+/* Service data type */
+typedef struct
+{
+    rwcp_protocol_state protocol_state;          /* RWCP Server states */
+    bool out_of_sequence_status;          /* temporarily mute GAP replies during congestion */
+    uint8 last_sequence_number;          /* last acknowledged sequence number */
+    uint8 rwcp_upgrade_header_size;          /*cumulative header size of GAIA and Upgrade headers */
+    bool accept_segments;          /* flow control flag */
+    Task client_task;          /*Client task*/
+    uint8 segments_held;          /* occupied reassembly slots */
+    uint16 bytes_held;          /* payload bytes in the occupied slots */
+    rwcp_segment_t segments[RWCP_RECEIVE_WINDOW_MAX];          /* indexed by sequence number modulo the window */
+} SERVER_DATA_T;
+
 #if defined(DEBUG_RWCP_SERVER)
 #define RWCP_SERVER_DEBUG(x)     printf x
 #else
@@ -249,6 +269,153 @@ static bool isOutOfSequence(uint8 sequence)
 }
 
 
+/*----------------------------------------------------------------------------*
+ *  NAME
+ *      segmentSlot
+ *
+ *  DESCRIPTION
+ *      Reassembly slot for a sequence number. Sequence numbers within the
+ *      receive window of the last acknowledged one map to distinct slots.
+ *
+ *  RETURNS
+ *      Pointer to the slot.
+ *
+ *---------------------------------------------------------------------------*/
+static rwcp_segment_t *segmentSlot(uint8 sequence)
+{
+    return &g_server_data.segments[sequence % RWCP_RECEIVE_WINDOW_MAX];
+}
+
+
+/*----------------------------------------------------------------------------*
+ *  NAME
+ *      holdSegment
+ *
+ *  DESCRIPTION
+ *      Keep a copy of an out of sequence segment if the held payloads stay
+ *      within RWCP_REASSEMBLY_BYTES_MAX. Segments which do not fit, or for
+ *      which there is no memory, are dropped and will be resent by the
+ *      client.
+ *
+ *  RETURNS
+ *      None.
+ *
+ *---------------------------------------------------------------------------*/
+static void holdSegment(uint8 sequence, uint8 *data, uint16 size)
+{
+    rwcp_segment_t *slot = segmentSlot(sequence);
+    uint16 size_payload = size - RWCP_HEADER_SIZE;
+
+    if (slot->payload != NULL
+        || size_payload > RWCP_REASSEMBLY_BYTES_MAX - g_server_data.bytes_held)
+    {
+        return;
+    }
+
+    slot->payload = malloc(size_payload);
+    if (slot->payload != NULL)
+    {
+        memcpy(slot->payload, &data[RWCP_PAYLOAD_OFFSET], size_payload);
+        slot->size_payload = size_payload;
+        g_server_data.segments_held++;
+        g_server_data.bytes_held += size_payload;
+        RWCP_SERVER_DEBUG(( "h:%d\n", sequence ));
+    }
+}
+
+
+/*----------------------------------------------------------------------------*
+ *  NAME
+ *      freeSegment
+ *
+ *  DESCRIPTION
+ *      Empty an occupied reassembly slot.
+ *
+ *  RETURNS
+ *      None.
+ *
+ *---------------------------------------------------------------------------*/
+static void freeSegment(rwcp_segment_t *slot)
+{
+    free(slot->payload);
+    slot->payload = NULL;
+    g_server_data.segments_held--;
+    g_server_data.bytes_held -= slot->size_payload;
+}
+
+
+/*----------------------------------------------------------------------------*
+ *  NAME
+ *      releaseSegments
+ *
+ *  DESCRIPTION
+ *      Discard every held segment.
+ *
+ *  RETURNS
+ *      None.
+ *
+ *---------------------------------------------------------------------------*/
+static void releaseSegments(void)
+{
+    uint16 i;
+
+    for (i = 0; i < RWCP_RECEIVE_WINDOW_MAX && g_server_data.segments_held != 0; i++)
+    {
+        rwcp_segment_t *slot = &g_server_data.segments[i];
+
+        if (slot->payload != NULL)
+        {
+            freeSegment(slot);
+        }
+    }
+}
+
+
+/*----------------------------------------------------------------------------*
+ *  NAME
+ *      deliverHeldSegments
+ *
+ *  DESCRIPTION
+ *      Pass on held segments that now follow on from the last acknowledged
+ *      one, for as long as the upgrade library accepts them. The last one
+ *      delivered is acknowledged, which also acknowledges the earlier ones.
+ *
+ *  RETURNS
+ *      None.
+ *
+ *---------------------------------------------------------------------------*/
+static void deliverHeldSegments(void)
+{
+    bool delivered = FALSE;
+
+    while (g_server_data.segments_held != 0 && g_server_data.accept_segments)
+    {
+        uint8 sequence = nextExpectedSequenceNumber(g_server_data.last_sequence_number);
+        rwcp_segment_t *slot = segmentSlot(sequence);
+        uint8 *payload = slot->payload;
+
+        if (payload == NULL)
+        {
+            break;
+        }
+
+        slot->payload = NULL;
+        g_server_data.segments_held--;
+        g_server_data.bytes_held -= slot->size_payload;
+        g_server_data.last_sequence_number = sequence;
+        delivered = TRUE;
+
+        GaiaRwcpProcessCommand(payload, slot->size_payload);
+        free(payload);
+    }
+
+    if (delivered)
+    {
+        rwcpDataAck(g_server_data.last_sequence_number);
+    }
+}
+
+
 /*----------------------------------------------------------------------------*
  *  NAME
  *      handleDataSegment
@@ -267,6 +434,8 @@ static rwcp_data_pkts_t handleDataSegment(uint8 sequence_number, uint8 *data, ui
      * Send an ACK if, the sequence number is as expected.
      * Send a GAP if, the sequence number is unexpected.
      * ACK duplicates.
+     * Hold out of sequence segments inside the receive window, once the
+     * gap is filled they are delivered after it and acknowledged together.
      */
     rwcp_data_pkts_t data_pkt_type = RWCP_DATA_PKT_DISCARDED;
     if ( g_server_data.accept_segments )
@@ -278,11 +447,22 @@ static rwcp_data_pkts_t handleDataSegment(uint8 sequence_number, uint8 *data, ui
 
             rwcpDataAck( sequence_number);
             g_server_data.last_sequence_number = sequence_number;
+            if (segmentSlot(sequence_number)->payload != NULL)
+            {
+                /* Resent by the client, the held copy is not needed */
+                freeSegment(segmentSlot(sequence_number));
+            }
             GaiaRwcpProcessCommand(&data[RWCP_PAYLOAD_OFFSET],size - RWCP_HEADER_SIZE);
+
+            if (g_server_data.segments_held != 0)
+            {
+                deliverHeldSegments();
+            }
         }
         else if ( isOutOfSequence(sequence_number) )
         {
             data_pkt_type = RWCP_DATA_PKT_OUT_OF_SEQUENCE;
+            holdSegment(sequence_number, data, size);
             if ( !g_server_data.out_of_sequence_status )
             {
                 g_server_data.out_of_sequence_status = TRUE;
@@ -368,6 +548,7 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
                     RWCP_SERVER_DEBUG(( "SYN received, LISTEN => SYN_RCVD\n" ));
                     rwcpSynAck(sequence_number);
                     g_server_data.last_sequence_number = sequence_number;
+                    releaseSegments();
                     g_server_data.protocol_state = RWCP_SYN_RCVD;
                     break;
 
@@ -398,6 +579,7 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
                     RWCP_SERVER_DEBUG(( "SYN received, SYN_RCVD => SYN_RCVD\n" ));
                     rwcpSynAck(sequence_number);
                     g_server_data.last_sequence_number = sequence_number;
+                    releaseSegments();
                     break;
 
                 /* handle the ReSeT command */
@@ -405,6 +587,7 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
                     RWCP_SERVER_DEBUG(( "RST received, SYN_RCVD => LISTEN\n" ));
                     rwcpRstAck( sequence_number);
                     g_server_data.protocol_state = RWCP_LISTEN;
+                    releaseSegments();
                     break;
 
                 /* first DATA segment arrived, handle it, and change state */
@@ -421,6 +604,7 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
                     RWCP_SERVER_DEBUG(( "Unexpected, hdr = %x, SYN_RCVD => LISTEN\n", rwcp_header ));
                     rwcpRst( sequence_number);
                     g_server_data.protocol_state = RWCP_LISTEN;
+                    releaseSegments();
                     break;
             }
             break;
@@ -436,6 +620,7 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
                     RWCP_SERVER_DEBUG(( "RST received, ESTABLISHED => LISTEN\n" ));
                     rwcpRstAck( sequence_number);
                     g_server_data.protocol_state = RWCP_LISTEN;
+                    releaseSegments();
                     break;
 
                 /* DATA segment arrived, handle it*/
@@ -450,6 +635,7 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
                     RWCP_SERVER_DEBUG(( "Unexpected, hdr = %x, ESTABLISHED => LISTEN\n", rwcp_header ));
                     rwcpRst( sequence_number);
                     g_server_data.protocol_state = RWCP_LISTEN;
+                    releaseSegments();
                     break;
             }
             break;
@@ -473,6 +659,11 @@ bool RwcpServerHandleMessage(uint8 *data, uint16 size)
 void RwcpServerFlowControl(bool accept)
 {
     g_server_data.accept_segments = accept;
+
+    if (accept && g_server_data.protocol_state == RWCP_ESTABLISHED)
+    {
+        deliverHeldSegments();
+    }
 }
 
 void RwcpSetClientTask(Task client_task)
@@ -489,4 +680,5 @@ void RwcpServerInit( uint8 header_size)
     g_server_data.client_task = NULL;
     g_server_data.last_sequence_number = 0;
     g_server_data.rwcp_upgrade_header_size = header_size;
+    releaseSegments();
 }
@@ -64,6 +64,8 @@ rwcp_protocol_state RwcpGetProtocolState(void);
 /*! 
     @brief Stop/start the RWCP protocol message handler. 
     Used to pause the RWCP. When paused, it will ignore all messages.
+    Resuming delivers any held segments which follow on from the last
+    acknowledged one.
     
     @param accept TRUE to accept and process RWCP message, FALSE to ignore them
 */
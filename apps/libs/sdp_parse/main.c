@@ -0,0 +1,406 @@
+/* Copyright (c) 2015 Qualcomm Technologies International, Ltd. */
+/*  */
+/* Test harness and lookup benchmark for the SDP Parse library */
+
+#include <stdio.h>
+#include <string.h>
+#include <vm.h>
+
+#include "sdp_parse.h"
+
+/* Number of times each record is searched in the time trial */
+#define TEST_ITERATIONS 20000
+
+/* Attribute lists as returned in CL_SDP_SERVICE_SEARCH_ATTRIBUTE_CFM */
+
+/* AVRCP Target */
+static const uint8 avrcp_tg_record[] =
+{
+    0x09, 0x00, 0x00,           /* ServiceRecordHandle */
+        0x0a, 0x00, 0x01, 0x00, 0x02,
+    0x09, 0x00, 0x01,           /* ServiceClassIDList */
+        0x35, 0x03,
+            0x19, 0x11, 0x0C,   /* A/V Remote Control Target */
+    0x09, 0x00, 0x04,           /* Protocol Descriptor List */
+        0x35, 0x10,
+            0x35, 0x06,
+                0x19, 0x01, 0x00,   /* L2CAP */
+                0x09, 0x00, 0x17,   /* AVCTP PSM */
+            0x35, 0x06,
+                0x19, 0x00, 0x17,   /* AVCTP */
+                0x09, 0x01, 0x04,   /* AVCTP 1.4 */
+    0x09, 0x00, 0x05,           /* Browse Group List */
+        0x35, 0x03,
+            0x19, 0x10, 0x02,
+    0x09, 0x00, 0x09,           /* Profile Descriptor List */
+        0x35, 0x08,
+            0x35, 0x06,
+                0x19, 0x11, 0x0E,   /* A/V Remote Control */
+                0x09, 0x01, 0x06,   /* AVRCP 1.6 */
+    0x09, 0x01, 0x00,           /* Service Name */
+        0x25, 0x0C, 'A', 'V', 'R', 'C', 'P', ' ', 'T', 'a', 'r', 'g', 'e', 't',
+    0x09, 0x03, 0x11,           /* Supported Features */
+        0x09, 0x00, 0x41
+};
+
+/* PBAP Server */
+static const uint8 pbap_pse_record[] =
+{
+    0x09, 0x00, 0x00,           /* ServiceRecordHandle */
+        0x0a, 0x00, 0x01, 0x00, 0x05,
+    0x09, 0x00, 0x01,           /* ServiceClassIDList */
+        0x35, 0x03,
+            0x19, 0x11, 0x2F,   /* Phonebook Access Server */
+    0x09, 0x00, 0x04,           /* Protocol Descriptor List */
+        0x35, 0x11,
+            0x35, 0x03,
+                0x19, 0x01, 0x00,   /* L2CAP */
+            0x35, 0x05,
+                0x19, 0x00, 0x03,   /* RFCOMM */
+                0x08, 0x13,         /* Channel 19 */
+            0x35, 0x03,
+                0x19, 0x00, 0x08,   /* OBEX */
+    0x09, 0x00, 0x09,           /* Profile Descriptor List */
+        0x35, 0x08,
+            0x35, 0x06,
+                0x19, 0x11, 0x30,   /* Phonebook Access */
+                0x09, 0x01, 0x02,   /* PBAP 1.2 */
+    0x09, 0x01, 0x00,           /* Service Name */
+        0x25, 0x09, 'P', 'B', 'A', 'P', ' ', 'P', 'S', 'E', ' ',
+    0x09, 0x02, 0x00,           /* GoepL2CapPsm */
+        0x09, 0x10, 0x25,
+    0x09, 0x03, 0x14,           /* Supported Repositories */
+        0x08, 0x03,
+    0x09, 0x03, 0x17,           /* PBAP Supported Features */
+        0x0a, 0x00, 0x00, 0x03, 0xFF
+};
+
+/* MAP Message Access Server */
+static const uint8 map_mas_record[] =
+{
+    0x09, 0x00, 0x01,           /* ServiceClassIDList */
+        0x35, 0x03,
+            0x19, 0x11, 0x32,   /* Message Access Server */
+    0x09, 0x00, 0x04,           /* Protocol Descriptor List */
+        0x35, 0x11,
+            0x35, 0x03,
+                0x19, 0x01, 0x00,   /* L2CAP */
+            0x35, 0x05,
+                0x19, 0x00, 0x03,   /* RFCOMM */
+                0x08, 0x11,         /* Channel 17 */
+            0x35, 0x03,
+                0x19, 0x00, 0x08,   /* OBEX */
+    0x09, 0x00, 0x09,           /* Profile Descriptor List */
+        0x35, 0x08,
+            0x35, 0x06,
+                0x19, 0x11, 0x34,   /* Message Access Profile */
+                0x09, 0x01, 0x01,   /* MAP 1.1 */
+    0x09, 0x01, 0x00,           /* Service Name */
+        0x25, 0x07, 'M', 'A', 'P', ' ', 'M', 'A', 'S',
+    0x09, 0x03, 0x15,           /* MAS Instance ID */
+        0x08, 0x00,
+    0x09, 0x03, 0x16,           /* Supported Message Types */
+        0x08, 0x0E
+};
+
+/* Same attributes as avrcp_tg_record, cut off part way through the name */
+#define AVRCP_TG_TRUNCATED_SIZE 66
+
+typedef struct
+{
+    const char *name;
+    const uint8 *record;
+    uint8 size;
+    uint16 service_class;
+} test_record;
+
+static const test_record records[] =
+{
+    { "AVRCP TG", avrcp_tg_record, sizeof(avrcp_tg_record), 0x110E },
+    { "PBAP PSE", pbap_pse_record, sizeof(pbap_pse_record), 0x1130 },
+    { "MAP MAS", map_mas_record, sizeof(map_mas_record), 0x1134 }
+};
+
+/* Everything a client typically reads from a record on connection */
+typedef struct
+{
+    bool     has_version;
+    uint16   version;
+    bool     has_features;
+    uint16   features;
+    bool     has_chans;
+    uint8    chans[4];
+    uint8    chans_found;
+    bool     has_name;
+    char     name[33];
+    uint8    name_length;
+    bool     has_repos;
+    uint8    repos;
+    bool     has_psm;
+    uint16   psm;
+    bool     has_instance;
+    uint8    instance;
+    bool     has_msg_feature;
+    uint8    msg_feature;
+    bool     has_handle;
+    uint32   handle;
+} record_values;
+
+static void read_record(const test_record *r, record_values *v)
+{
+    uint8 *chans = v->chans;
+    char *name = v->name;
+    uint8 *record = (uint8 *) r->record;
+
+    memset(v, 0, sizeof(*v));
+    v->has_version = SdpParseGetProfileVersion(r->size, r->record, r->service_class, &v->version);
+    v->has_features = SdpParseGetSupportedFeatures(r->size, r->record, &v->features);
+    v->has_chans = SdpParseGetMultipleRfcommServerChannels(r->size, r->record, sizeof(v->chans), &chans, &v->chans_found);
+    v->has_name = SdpParseGetServiceName(r->size, r->record, sizeof(v->name), &name, &v->name_length);
+    v->has_repos = SdpParseGetPbapRepos(r->size, r->record, &v->repos);
+    v->has_psm = SdpParseGetGoepL2CapPsm(r->size, r->record, &v->psm);
+    v->has_instance = SdpParseGetMapMasInstance(r->size, record, &v->instance);
+    v->has_msg_feature = SdpParseGetMapMasMsgFeature(r->size, record, &v->msg_feature);
+    v->has_handle = SdpParseGetArbitrary(r->size, r->record, saServiceRecordHandle, &v->handle);
+}
+
+static void read_index(const test_record *r, record_values *v)
+{
+    SdpParseIndex index;
+    uint8 *chans = v->chans;
+    char *name = v->name;
+
+    memset(v, 0, sizeof(*v));
+    SdpParseIndexRecord(r->size, r->record, &index);
+    v->has_version = SdpParseIndexGetProfileVersion(&index, r->service_class, &v->version);
+    v->has_features = SdpParseIndexGetSupportedFeatures(&index, &v->features);
+    v->has_chans = SdpParseIndexGetMultipleRfcommServerChannels(&index, sizeof(v->chans), &chans, &v->chans_found);
+    v->has_name = SdpParseIndexGetServiceName(&index, sizeof(v->name), &name, &v->name_length);
+    v->has_repos = SdpParseIndexGetPbapRepos(&index, &v->repos);
+    v->has_psm = SdpParseIndexGetGoepL2CapPsm(&index, &v->psm);
+    v->has_instance = SdpParseIndexGetMapMasInstance(&index, &v->instance);
+    v->has_msg_feature = SdpParseIndexGetMapMasMsgFeature(&index, &v->msg_feature);
+    v->has_handle = SdpParseIndexGetArbitrary(&index, saServiceRecordHandle, &v->handle);
+}
+
+static void print_values(const record_values *v)
+{
+    if(v->has_version)
+        printf(" version=%04x", v->version);
+    if(v->has_features)
+        printf(" features=%04x", v->features);
+    if(v->has_chans)
+        printf(" rfcomm=%u", v->chans[0]);
+    if(v->has_name)
+        printf(" name=\"%s\"", v->name);
+    if(v->has_repos)
+        printf(" repos=%u", v->repos);
+    if(v->has_psm)
+        printf(" psm=%04x", v->psm);
+    if(v->has_instance)
+        printf(" instance=%u", v->instance);
+    if(v->has_msg_feature)
+        printf(" msg=%02x", v->msg_feature);
+    if(v->has_handle)
+        printf(" handle=%08lx", (unsigned long)v->handle);
+}
+
+/* Reads every attribute both by walking the record and through an index
+   and checks the results agree */
+
+static unsigned verify(const test_record *r)
+{
+    record_values by_record, by_index;
+    unsigned failures = 0;
+
+    read_record(r, &by_record);
+    read_index(r, &by_index);
+    if(memcmp(&by_record, &by_index, sizeof(by_record)) != 0)
+        ++failures;
+
+    printf("%s:", r->name);
+    print_values(&by_index);
+    printf(failures ? " FAIL!\n" : "\n");
+    return failures;
+}
+
+/* More attributes than the index holds, the rest must still be found */
+
+static unsigned verify_overflow(void)
+{
+    uint8 record[(SDP_PARSE_INDEX_MAX_ATTRIBUTES + 4) * 6];
+    SdpParseIndex index;
+    unsigned failures = 0;
+    uint32 val;
+    uint16 i;
+
+    for(i = 0; i < SDP_PARSE_INDEX_MAX_ATTRIBUTES + 4; ++i)
+    {
+        uint8 *p = record + i * 6;
+        p[0] = 0x09; p[1] = 0x80; p[2] = (uint8) i;
+        p[3] = 0x09; p[4] = 0x00; p[5] = (uint8) (i * 3);
+    }
+
+    if(!SdpParseIndexRecord(sizeof(record), record, &index))
+        ++failures;
+    if(index.num_attributes != SDP_PARSE_INDEX_MAX_ATTRIBUTES)
+        ++failures;
+
+    for(i = 0; i < SDP_PARSE_INDEX_MAX_ATTRIBUTES + 4; ++i)
+    {
+        if(!SdpParseIndexGetArbitrary(&index, (ServiceAttributeId) (0x8000 | i), &val) || val != (uint32) (i * 3))
+            ++failures;
+    }
+    if(SdpParseIndexGetArbitrary(&index, 0x8100, &val))
+        ++failures;
+
+    printf("Index overflow:%s\n", failures ? " FAIL!" : " OK");
+    return failures;
+}
+
+/* A malformed record indexes the attributes before the damage */
+
+static unsigned verify_malformed(void)
+{
+    SdpParseIndex index;
+    uint16 version, features;
+    uint32 handle;
+    unsigned failures = 0;
+
+    if(SdpParseIndexRecord(AVRCP_TG_TRUNCATED_SIZE, avrcp_tg_record, &index))
+        ++failures;
+    if(!SdpParseIndexGetArbitrary(&index, saServiceRecordHandle, &handle) || handle != 0x00010002)
+        ++failures;
+    if(!SdpParseIndexGetProfileVersion(&index, 0x110E, &version) || version != 0x0106)
+        ++failures;
+    if(SdpParseIndexGetSupportedFeatures(&index, &features))
+        ++failures;
+    if(SdpParseGetSupportedFeatures(AVRCP_TG_TRUNCATED_SIZE, avrcp_tg_record, &features))
+        ++failures;
+
+    printf("Malformed record:%s\n", failures ? " FAIL!" : " OK");
+    return failures;
+}
+
+/* A repeated attribute, the first instance not a sequence: the getters go
+   on to the later instance as the record walk always has */
+
+static unsigned verify_repeated(void)
+{
+    static const uint8 record[] =
+    {
+        0x09, 0x00, 0x04,           /* Protocol Descriptor List, not a sequence */
+            0x08, 0x01,
+        0x09, 0x00, 0x09,           /* Profile Descriptor List, not a sequence */
+            0x08, 0x02,
+        0x09, 0x00, 0x04,           /* Protocol Descriptor List */
+            0x35, 0x0C,
+                0x35, 0x03,
+                    0x19, 0x01, 0x00,   /* L2CAP */
+                0x35, 0x05,
+                    0x19, 0x00, 0x03,   /* RFCOMM */
+                    0x08, 0x05,         /* Channel 5 */
+        0x09, 0x00, 0x09,           /* Profile Descriptor List */
+            0x35, 0x08,
+                0x35, 0x06,
+                    0x19, 0x11, 0x1E,   /* Handsfree */
+                    0x09, 0x01, 0x07    /* HFP 1.7 */
+    };
+    SdpParseIndex index;
+    uint8 chan, found;
+    uint8 *chans = &chan;
+    uint16 version;
+    unsigned failures = 0;
+
+    if(!SdpParseGetProfileVersion(sizeof(record), record, 0x111E, &version) || version != 0x0107)
+        ++failures;
+    if(!SdpParseGetMultipleRfcommServerChannels(sizeof(record), record, 1, &chans, &found) || chan != 5)
+        ++failures;
+
+    SdpParseIndexRecord(sizeof(record), record, &index);
+    version = 0;
+    chan = 0;
+    if(!SdpParseIndexGetProfileVersion(&index, 0x111E, &version) || version != 0x0107)
+        ++failures;
+    if(!SdpParseIndexGetMultipleRfcommServerChannels(&index, 1, &chans, &found) || chan != 5)
+        ++failures;
+
+    printf("Repeated attribute:%s\n", failures ? " FAIL!" : " OK");
+    return failures;
+}
+
+/* Values inserted through an index can be read back by walking the record */
+
+static unsigned verify_insert(void)
+{
+    uint8 record[sizeof(pbap_pse_record)];
+    SdpParseIndex index;
+    uint8 repos, found, chan, length;
+    uint8 *chans = &chan;
+    char name[10];
+    char *names = name;
+    unsigned failures = 0;
+
+    memcpy(record, pbap_pse_record, sizeof(record));
+    SdpParseIndexRecord(sizeof(record), record, &index);
+
+    if(!SdpParseIndexInsertRfcommServerChannel(&index, 7) ||
+       !SdpParseIndexInsertPbapRepos(&index, 1) ||
+       !SdpParseIndexInsertProfileVersion(&index, 0x1130, 0x0101) ||
+       !SdpParseIndexInsertServiceName(&index, "PSE"))
+        ++failures;
+
+    if(!SdpParseGetMultipleRfcommServerChannels(sizeof(record), record, 1, &chans, &found) || chan != 7)
+        ++failures;
+    if(!SdpParseGetPbapRepos(sizeof(record), record, &repos) || repos != 1)
+        ++failures;
+    if(!SdpParseGetServiceName(sizeof(record), record, sizeof(name), &names, &length) || strcmp(name, "PSE      ") != 0)
+        ++failures;
+
+    printf("Insert:%s\n", failures ? " FAIL!" : " OK");
+    return failures;
+}
+
+/* Measures the time to read every attribute of interest from every record */
+
+static void time_trial(const char *name, void (*read)(const test_record *, record_values *))
+{
+    record_values values;
+    uint32 endTime, startTime;
+    long i;
+    uint16 r;
+
+    printf("%s time trial. Reading %d records %d times ...", name,
+           (int)(sizeof(records)/sizeof(*records)), TEST_ITERATIONS);
+
+    startTime = VmGetClock();
+    for(i = 0; i < TEST_ITERATIONS; ++i)
+        for(r = 0; r < sizeof(records)/sizeof(*records); ++r)
+            read(&records[r], &values);
+    endTime = VmGetClock();
+    if(endTime == startTime)
+        ++endTime;
+
+    printf(" done\n");
+    printf("Time = %ld ms\n", (long)(endTime-startTime));
+    printf("Speed = %ld records/second\n",
+           (long)TEST_ITERATIONS * (long)(sizeof(records)/sizeof(*records)) * 1000L / (long)(endTime-startTime));
+}
+
+int main(void)
+{
+    unsigned failures = 0;
+    uint16 r;
+
+    for(r = 0; r < sizeof(records)/sizeof(*records); ++r)
+        failures += verify(&records[r]);
+    failures += verify_overflow();
+    failures += verify_malformed();
+    failures += verify_repeated();
+    failures += verify_insert();
+
+    time_trial("Record walk", read_record);
+    time_trial("Indexed", read_index);
+
+    return failures ? 1 : 0;
+}
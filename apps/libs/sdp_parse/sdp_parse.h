@@ -31,6 +31,39 @@ DESCRIPTION
 
 #include <service.h>
 
+/************************************ Types *********************************/
+
+/*!
+	@brief Maximum number of attributes held in an SdpParseIndex. Attributes
+		   beyond this are found by walking the remainder of the record.
+*/
+#define SDP_PARSE_INDEX_MAX_ATTRIBUTES 16
+
+/*!
+	@brief Location of one attribute value within an indexed service record
+*/
+typedef struct
+{
+	ServiceAttributeId id;		/*!< The attribute ID */
+	uint8 type;					/*!< The ServiceDataType of the value */
+	uint8 offset;				/*!< Offset of the value from the start of the record */
+	uint8 size;					/*!< Size of the value in bytes */
+} SdpParseIndexEntry;
+
+/*!
+	@brief Index of the attributes in a service record, built by
+		   SdpParseIndexRecord. The index refers into the service record, which
+		   must remain valid and unmoved while the index is in use.
+*/
+typedef struct
+{
+	const uint8* service_record;	/*!< The indexed service record */
+	uint8 size_service_record;		/*!< Size of the service record */
+	uint8 size_indexed;				/*!< Bytes of the record covered by the index */
+	uint8 num_attributes;			/*!< Number of entries in attributes */
+	SdpParseIndexEntry attributes[SDP_PARSE_INDEX_MAX_ATTRIBUTES];	/*!< The attributes in record order */
+} SdpParseIndex;
+
 /************************************ Functions *****************************/
 
 /*!
@@ -284,5 +317,114 @@ bool SdpParseGetGoepL2CapPsm( const uint8 size_service_record,
                               const uint8* service_record,
                               uint16* psm );
 
+/*!
+	@brief Walk a service record once and index the location of each attribute,
+		   so that any number of SdpParseIndex* accesses can then be made
+		   without walking the record again.
+
+	@param size_service_record Size of the service record
+
+	@param service_record Pointer to the Service Record to index
+
+	@param index Filled in with the index of the record
+
+    @return TRUE if the record was indexed, FALSE if it is malformed. Attributes
+            before the malformed part of the record are still indexed.
+*/
+
+bool SdpParseIndexRecord(const uint8 size_service_record, const uint8* service_record, SdpParseIndex* index);
+
+/*!
+	@brief As SdpParseGetProfileVersion, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetProfileVersion(const SdpParseIndex* index, uint16 service_class, uint16* profile);
+
+/*!
+	@brief As SdpParseInsertProfileVersion, using an index of the Service Record
+*/
+
+bool SdpParseIndexInsertProfileVersion(const SdpParseIndex* index, uint16 service_class, uint16 profile);
+
+/*!
+	@brief As SdpParseGetSupportedFeatures, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetSupportedFeatures(const SdpParseIndex* index, uint16* features);
+
+/*!
+	@brief As SdpParseInsertSupportedFeatures, using an index of the Service Record
+*/
+
+bool SdpParseIndexInsertSupportedFeatures(const SdpParseIndex* index, uint16 features);
+
+/*!
+	@brief As SdpParseGetMultipleRfcommServerChannels, using an index of the
+		   Service Record
+*/
+
+bool SdpParseIndexGetMultipleRfcommServerChannels(const SdpParseIndex* index, uint8 size_chans, uint8** chans, uint8* chans_found);
+
+/*!
+	@brief As SdpParseInsertRfcommServerChannel, using an index of the Service
+		   Record
+*/
+
+bool SdpParseIndexInsertRfcommServerChannel(const SdpParseIndex* index, uint8 chan);
+
+/*!
+	@brief As SdpParseGetArbitrary, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetArbitrary(const SdpParseIndex* index, ServiceAttributeId id, uint32* val);
+
+/*!
+	@brief As SdpParseInsertArbitrary, using an index of the Service Record
+*/
+
+bool SdpParseIndexInsertArbitrary(const SdpParseIndex* index, ServiceAttributeId id, uint32 val);
+
+/*!
+	@brief As SdpParseGetServiceName, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetServiceName(const SdpParseIndex* index, uint8 size_service_name, char** service_name, uint8* length_service_name);
+
+/*!
+	@brief As SdpParseInsertServiceName, using an index of the Service Record
+*/
+
+bool SdpParseIndexInsertServiceName(const SdpParseIndex* index, char* service_name);
+
+/*!
+	@brief As SdpParseGetPbapRepos, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetPbapRepos(const SdpParseIndex* index, uint8* repos);
+
+/*!
+	@brief As SdpParseInsertPbapRepos, using an index of the Service Record
+*/
+
+bool SdpParseIndexInsertPbapRepos(const SdpParseIndex* index, uint8 repos);
+
+/*!
+	@brief As SdpParseGetMapMasInstance, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetMapMasInstance(const SdpParseIndex* index, uint8* instance_id);
+
+/*!
+	@brief As SdpParseGetMapMasMsgFeature, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetMapMasMsgFeature(const SdpParseIndex* index, uint8* msg_feature);
+
+/*!
+	@brief As SdpParseGetGoepL2CapPsm, using an index of the Service Record
+*/
+
+bool SdpParseIndexGetGoepL2CapPsm(const SdpParseIndex* index, uint16* psm);
+
 #endif /* SDP_H_ */
 /** @} */
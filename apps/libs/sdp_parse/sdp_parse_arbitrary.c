@@ -9,7 +9,7 @@ DESCRIPTION
 	Contains functions for accessing user specified fields in a service record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 
@@ -17,14 +17,11 @@ DESCRIPTION
 
 /* Find Arbitrary Attribute */
 
-static bool findArbitrary(const uint8 size_service_record, const uint8* service_record, ServiceAttributeId id, Region* value)
+static bool findArbitrary(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, ServiceAttributeId id, Region* value)
 {
 	ServiceDataType type;
-    Region record;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
 	
-	if (ServiceFindAttribute(&record, id, &type, value))
+	if (sdpParseFindAttribute(size_service_record, service_record, index, id, &type, value))
 		if(type == sdtUnsignedInteger)
 		{
 			/* Found the Attribute Field */
@@ -34,14 +31,12 @@ static bool findArbitrary(const uint8 size_service_record, const uint8* service_
 	return FALSE;
 }
 
-/************************************ Public ******************************/
-
 /* Access Arbitrary Attribute */
 
-bool SdpParseGetArbitrary(const uint8 size_service_record, const uint8* service_record, ServiceAttributeId id, uint32* val)
+static bool getArbitrary(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, ServiceAttributeId id, uint32* val)
 {
 	Region value;
-	if(findArbitrary(size_service_record, service_record, id, &value))
+	if(findArbitrary(size_service_record, service_record, index, id, &value))
 	{
 		*val = RegionReadUnsigned(&value);
 		/* Accessed Successfully */
@@ -53,10 +48,10 @@ bool SdpParseGetArbitrary(const uint8 size_service_record, const uint8* service_
 
 /* Insert Arbitrary Attribute */
 
-bool SdpParseInsertArbitrary(const uint8 size_service_record, const uint8* service_record, ServiceAttributeId id, uint32 val)
+static bool insertArbitrary(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, ServiceAttributeId id, uint32 val)
 {
 	Region value;
-	if(findArbitrary(size_service_record, service_record, id, &value))
+	if(findArbitrary(size_service_record, service_record, index, id, &value))
 	{
 		RegionWriteUnsigned(&value, val);
 		/* Inserted Successfully */
@@ -65,3 +60,25 @@ bool SdpParseInsertArbitrary(const uint8 size_service_record, const uint8* servi
 	/* Failed */
 	return FALSE;
 }
+
+/************************************ Public ******************************/
+
+bool SdpParseGetArbitrary(const uint8 size_service_record, const uint8* service_record, ServiceAttributeId id, uint32* val)
+{
+	return getArbitrary(size_service_record, service_record, NULL, id, val);
+}
+
+bool SdpParseInsertArbitrary(const uint8 size_service_record, const uint8* service_record, ServiceAttributeId id, uint32 val)
+{
+	return insertArbitrary(size_service_record, service_record, NULL, id, val);
+}
+
+bool SdpParseIndexGetArbitrary(const SdpParseIndex* index, ServiceAttributeId id, uint32* val)
+{
+	return getArbitrary(0, NULL, index, id, val);
+}
+
+bool SdpParseIndexInsertArbitrary(const SdpParseIndex* index, ServiceAttributeId id, uint32 val)
+{
+	return insertArbitrary(0, NULL, index, id, val);
+}
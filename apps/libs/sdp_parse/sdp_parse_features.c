@@ -10,7 +10,7 @@ DESCRIPTION
 	record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 
@@ -18,14 +18,11 @@ DESCRIPTION
 
 /* Find Supported Features */
 
-static bool findSupportedFeatures(const uint8 length, const uint8* begin, Region* value)
+static bool findSupportedFeatures(const uint8 length, const uint8* begin, const SdpParseIndex* index, Region* value)
 {
 	ServiceDataType type;
-	Region record;
-	record.begin = begin;
-    record.end   = begin + length;
 
-	if (ServiceFindAttribute(&record, saSupportedFeatures, &type, value))
+	if (sdpParseFindAttribute(length, begin, index, saSupportedFeatures, &type, value))
 		if(type == sdtUnsignedInteger)
 		{
 			/* Found the Supported Features */
@@ -35,14 +32,12 @@ static bool findSupportedFeatures(const uint8 length, const uint8* begin, Region
 	return FALSE;
 }
 
-/************************************ Public ******************************/
-
 /* Access Supported Features */
 
-bool SdpParseGetSupportedFeatures(const uint8 size_service_record, const uint8* service_record, uint16* features)
+static bool getSupportedFeatures(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint16* features)
 {
 	Region value;
-    if(findSupportedFeatures(size_service_record, service_record, &value))
+    if(findSupportedFeatures(size_service_record, service_record, index, &value))
     {
 		*features = (uint16) RegionReadUnsigned(&value);
 		/* Accessed Successfully */
@@ -54,11 +49,11 @@ bool SdpParseGetSupportedFeatures(const uint8 size_service_record, const uint8*
 
 /* Insert Supported Features */
 
-bool SdpParseInsertSupportedFeatures(const uint8 size_service_record, const uint8* service_record, uint16 features)
+static bool insertSupportedFeatures(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint16 features)
 {
 	Region value;
 
-	if (findSupportedFeatures(size_service_record, service_record, &value) && RegionSize(&value) == 2)
+	if (findSupportedFeatures(size_service_record, service_record, index, &value) && RegionSize(&value) == 2)
 	{
 		RegionWriteUnsigned(&value, (uint32) features);
 		/* Inserted Successfully */
@@ -67,3 +62,25 @@ bool SdpParseInsertSupportedFeatures(const uint8 size_service_record, const uint
 	/* Failed */
 	return FALSE;
 }
+
+/************************************ Public ******************************/
+
+bool SdpParseGetSupportedFeatures(const uint8 size_service_record, const uint8* service_record, uint16* features)
+{
+	return getSupportedFeatures(size_service_record, service_record, NULL, features);
+}
+
+bool SdpParseInsertSupportedFeatures(const uint8 size_service_record, const uint8* service_record, uint16 features)
+{
+	return insertSupportedFeatures(size_service_record, service_record, NULL, features);
+}
+
+bool SdpParseIndexGetSupportedFeatures(const SdpParseIndex* index, uint16* features)
+{
+	return getSupportedFeatures(0, NULL, index, features);
+}
+
+bool SdpParseIndexInsertSupportedFeatures(const SdpParseIndex* index, uint16 features)
+{
+	return insertSupportedFeatures(0, NULL, index, features);
+}
@@ -0,0 +1,130 @@
+/****************************************************************************
+Copyright (c) 2015 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    sdp_parse_index.c
+
+DESCRIPTION
+	Contains functions for indexing the attributes of a service record so
+	that repeated accesses do not have to walk the record each time
+*/
+
+#include "sdp_parse_private.h"
+#include <service.h>
+#include <region.h>
+
+/************************************ Private *****************************/
+
+/* Find the next instance of an Attribute in the Index */
+
+static bool findIndexed(sdpParseSearch* search, ServiceAttributeId id, ServiceDataType* type, Region* value)
+{
+	const SdpParseIndex* index = search->index;
+
+	for(; search->next_entry < index->num_attributes; search->next_entry++)
+	{
+		const SdpParseIndexEntry* entry = &index->attributes[search->next_entry];
+
+		if(entry->id == id)
+		{
+			*type = (ServiceDataType) entry->type;
+			value->begin = index->service_record + entry->offset;
+			value->end   = value->begin + entry->size;
+			search->next_entry++;
+			/* Found the Attribute Field */
+			return TRUE;
+		}
+	}
+
+	/* Not indexed, may still be in the rest of the record */
+	if(RegionSize(&search->record))
+		return ServiceFindAttribute(&search->record, id, type, value);
+
+	/* Failed */
+	return FALSE;
+}
+
+/*********************************** Shared *******************************/
+
+void sdpParseSearchInit(sdpParseSearch* search, const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index)
+{
+	search->index = index;
+	search->next_entry = 0;
+
+	if(index)
+	{
+		/* Only the part of the record that did not fit in the index is walked */
+		search->record.begin = index->service_record + index->size_indexed;
+		search->record.end   = index->service_record + index->size_service_record;
+	}
+	else
+	{
+		search->record.begin = service_record;
+		search->record.end   = service_record + size_service_record;
+	}
+}
+
+bool sdpParseSearchNext(sdpParseSearch* search, ServiceAttributeId id, ServiceDataType* type, Region* value)
+{
+	if(search->index)
+		return findIndexed(search, id, type, value);
+
+	/* The walk carries on from after the instance found last time */
+	return ServiceFindAttribute(&search->record, id, type, value);
+}
+
+bool sdpParseFindAttribute(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, ServiceAttributeId id, ServiceDataType* type, Region* value)
+{
+	sdpParseSearch search;
+
+	sdpParseSearchInit(&search, size_service_record, service_record, index);
+	return sdpParseSearchNext(&search, id, type, value);
+}
+
+/************************************ Public ******************************/
+
+/* Index Service Record */
+
+bool SdpParseIndexRecord(const uint8 size_service_record, const uint8* service_record, SdpParseIndex* index)
+{
+	SdpParseIndexEntry* entry = index->attributes;
+	ServiceAttributeId id;
+	ServiceDataType type;
+	Region record, value;
+
+	record.begin = service_record;
+	record.end   = service_record + size_service_record;
+
+	index->service_record      = service_record;
+	index->size_service_record = size_service_record;
+	index->num_attributes      = 0;
+
+	/* Record each attribute as an offset into the record, once the index is
+	   full the remainder of the record is walked on demand instead */
+	while(index->num_attributes < SDP_PARSE_INDEX_MAX_ATTRIBUTES && ServiceNextAttribute(&record, &id, &type, &value))
+	{
+		entry->id     = id;
+		entry->type   = (uint8) type;
+		entry->offset = (uint8) (value.begin - service_record);
+		entry->size   = (uint8) RegionSize(&value);
+		entry++;
+		index->num_attributes++;
+	}
+
+	index->size_indexed = (uint8) (record.begin - service_record);
+
+	/* A full index leaves the rest to be walked later, otherwise anything
+	   left over could not be parsed */
+	if(index->num_attributes == SDP_PARSE_INDEX_MAX_ATTRIBUTES)
+		return TRUE;
+
+	/* Nothing past a malformed attribute can be found, so don't look */
+	if(RegionSize(&record))
+	{
+		index->size_service_record = index->size_indexed;
+		return FALSE;
+	}
+
+	return TRUE;
+}
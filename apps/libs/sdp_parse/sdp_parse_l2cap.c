@@ -9,21 +9,19 @@ DESCRIPTION
 	Contains functions for accessing the L2CAP related attributes
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 
 /************************************ Private *****************************/
 static bool findGoepL2CapPsm( const uint8 length, 
                               const uint8* begin, 
+                              const SdpParseIndex* index,
                               Region* value )
 {
 	ServiceDataType type;
-	Region record;
-	record.begin = begin;
-    record.end   = begin + length;
 
-	if (ServiceFindAttribute(&record, saGoepL2CapPsm, &type, value))
+	if (sdpParseFindAttribute(length, begin, index, saGoepL2CapPsm, &type, value))
 		if(type == sdtUnsignedInteger)
 		{
 			/* Found the Supported Features */
@@ -33,15 +31,13 @@ static bool findGoepL2CapPsm( const uint8 length,
 	return FALSE;
 }
 
-
-/************************************ Public ******************************/
-/* Get GoepL2CapPsm */
-bool SdpParseGetGoepL2CapPsm( const uint8 size_service_record, 
-                              const uint8* service_record,
-                              uint16* psm )
+static bool getGoepL2CapPsm( const uint8 size_service_record,
+                             const uint8* service_record,
+                             const SdpParseIndex* index,
+                             uint16* psm )
 {
 	Region value;
-    if(findGoepL2CapPsm(size_service_record, service_record, &value))
+    if(findGoepL2CapPsm(size_service_record, service_record, index, &value))
     {
 		*psm = (uint16) RegionReadUnsigned(&value);
 		/* Accessed Successfully */
@@ -51,3 +47,19 @@ bool SdpParseGetGoepL2CapPsm( const uint8 size_service_record,
     return FALSE;
 }
 
+
+/************************************ Public ******************************/
+/* Get GoepL2CapPsm */
+bool SdpParseGetGoepL2CapPsm( const uint8 size_service_record,
+                              const uint8* service_record,
+                              uint16* psm )
+{
+    return getGoepL2CapPsm(size_service_record, service_record, NULL, psm);
+}
+
+/* Get GoepL2CapPsm from an indexed record */
+bool SdpParseIndexGetGoepL2CapPsm( const SdpParseIndex* index, uint16* psm )
+{
+    return getGoepL2CapPsm(0, NULL, index, psm);
+}
+
@@ -9,7 +9,7 @@ DESCRIPTION
 	Contains functions for accessing MAP specific fields in a service record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 
@@ -18,14 +18,12 @@ DESCRIPTION
 /* Find MAP MAS instance id */
 
 static bool findMapMasInstance(const uint8 size_service_record, 
-                               uint8* service_record, Region* value)
+                               const uint8* service_record,
+                               const SdpParseIndex* index, Region* value)
 {
 	ServiceDataType type;
-    Region record;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
 	
-	if (ServiceFindAttribute(&record, saMapMasInstanceId, &type, value))
+	if (sdpParseFindAttribute(size_service_record, service_record, index, saMapMasInstanceId, &type, value))
 		if(type == sdtUnsignedInteger)
 		{
 			/* Found the Attribute Field */
@@ -36,14 +34,12 @@ static bool findMapMasInstance(const uint8 size_service_record,
 }
 
 static bool findMapMasMsgFeature(const uint8 size_service_record,
-                                 uint8* service_record, Region* value)
+                                 const uint8* service_record,
+                                 const SdpParseIndex* index, Region* value)
 {
 	ServiceDataType type;
-    Region record;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
 	
-	if (ServiceFindAttribute(&record, saMapMasMsgFeature, &type, value))
+	if (sdpParseFindAttribute(size_service_record, service_record, index, saMapMasMsgFeature, &type, value))
 		if(type == sdtUnsignedInteger)
 		{
 			/* Found the Attribute Field */
@@ -73,7 +69,7 @@ bool SdpParseGetMapMasInstance( const uint8 size_service_record,
                                 uint8* instance_id )
 {
 	Region value;
-	if(findMapMasInstance(size_service_record, service_record, &value))
+	if(findMapMasInstance(size_service_record, service_record, NULL, &value))
 	{
 		*instance_id = RegionReadUnsigned(&value);
 		/* Accessed Successfully */
@@ -101,7 +97,61 @@ bool SdpParseGetMapMasMsgFeature( const uint8 size_service_record,
                                   uint8* msg_feature )
 {
 	Region value;
-	if(findMapMasMsgFeature(size_service_record, service_record, &value))
+	if(findMapMasMsgFeature(size_service_record, service_record, NULL, &value))
+	{
+		*msg_feature = RegionReadUnsigned(&value);
+		/* Accessed Successfully */
+		return TRUE;
+	}
+	/* Failed */
+	return FALSE;
+}
+
+/****************************************************************************
+ * NAME
+ *  SdpParseIndexGetMapMasInstance
+ *
+ * DESCRIPTION
+ * API to access the MAS instance ID from an indexed record
+ *
+ * PARAMETERS
+ *  Refer sdp_parse.h
+ *
+ * RETURNS
+ *  TRUE on success with instanceId contains the MASInstanceID.
+ **************************************************************************/
+bool SdpParseIndexGetMapMasInstance( const SdpParseIndex* index,
+                                     uint8* instance_id )
+{
+	Region value;
+	if(findMapMasInstance(0, NULL, index, &value))
+	{
+		*instance_id = RegionReadUnsigned(&value);
+		/* Accessed Successfully */
+		return TRUE;
+	}
+	/* Failed */
+	return FALSE;
+}
+
+/****************************************************************************
+ * NAME
+ *  SdpParseIndexGetMapMasMsgFeature
+ *
+ * DESCRIPTION
+ * API to access the MAS support message feature from an indexed record
+ *
+ * PARAMETERS
+ *  Refer sdp_parse.h
+ *
+ * RETURNS
+ *  TRUE on success with MsgFeature contains the MASInstanceID.
+ **************************************************************************/
+bool SdpParseIndexGetMapMasMsgFeature( const SdpParseIndex* index,
+                                       uint8* msg_feature )
+{
+	Region value;
+	if(findMapMasMsgFeature(0, NULL, index, &value))
 	{
 		*msg_feature = RegionReadUnsigned(&value);
 		/* Accessed Successfully */
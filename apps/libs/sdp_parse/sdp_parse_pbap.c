@@ -9,7 +9,7 @@ DESCRIPTION
 	Contains functions for accessing PBAP specific fields in a service record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 
@@ -17,14 +17,11 @@ DESCRIPTION
 
 /* Find PBAP Repository */
 
-static bool findPbapRepos(const uint8 size_service_record, const uint8* service_record, Region* value)
+static bool findPbapRepos(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, Region* value)
 {
 	ServiceDataType type;
-    Region record;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
 	
-	if (ServiceFindAttribute(&record, saPbapRepos, &type, value))
+	if (sdpParseFindAttribute(size_service_record, service_record, index, saPbapRepos, &type, value))
 		if(type == sdtUnsignedInteger)
 		{
 			/* Found the Attribute Field */
@@ -34,14 +31,12 @@ static bool findPbapRepos(const uint8 size_service_record, const uint8* service_
 	return FALSE;
 }
 
-/************************************ Public ******************************/
-
 /* Access PBAP Repository */
 
-bool SdpParseGetPbapRepos(const uint8 size_service_record, const uint8* service_record, uint8* repos)
+static bool getPbapRepos(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint8* repos)
 {
 	Region value;
-	if(findPbapRepos(size_service_record, service_record, &value))
+	if(findPbapRepos(size_service_record, service_record, index, &value))
 	{
 		*repos = RegionReadUnsigned(&value);
 		/* Accessed Successfully */
@@ -53,10 +48,10 @@ bool SdpParseGetPbapRepos(const uint8 size_service_record, const uint8* service_
 
 /* Insert PBAP Repository */
 
-bool SdpParseInsertPbapRepos(const uint8 size_service_record, const uint8* service_record, uint8 repos)
+static bool insertPbapRepos(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint8 repos)
 {
 	Region value;
-	if(findPbapRepos(size_service_record, service_record, &value))
+	if(findPbapRepos(size_service_record, service_record, index, &value))
 	{
 		RegionWriteUnsigned(&value, repos);
 		/* Inserted Successfully */
@@ -65,3 +60,25 @@ bool SdpParseInsertPbapRepos(const uint8 size_service_record, const uint8* servi
 	/* Failed */
 	return FALSE;
 }
+
+/************************************ Public ******************************/
+
+bool SdpParseGetPbapRepos(const uint8 size_service_record, const uint8* service_record, uint8* repos)
+{
+	return getPbapRepos(size_service_record, service_record, NULL, repos);
+}
+
+bool SdpParseInsertPbapRepos(const uint8 size_service_record, const uint8* service_record, uint8 repos)
+{
+	return insertPbapRepos(size_service_record, service_record, NULL, repos);
+}
+
+bool SdpParseIndexGetPbapRepos(const SdpParseIndex* index, uint8* repos)
+{
+	return getPbapRepos(0, NULL, index, repos);
+}
+
+bool SdpParseIndexInsertPbapRepos(const SdpParseIndex* index, uint8 repos)
+{
+	return insertPbapRepos(0, NULL, index, repos);
+}
@@ -0,0 +1,42 @@
+/****************************************************************************
+Copyright (c) 2015 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    sdp_parse_private.h
+
+DESCRIPTION
+	Private helpers shared by the SDP Parse library
+*/
+
+#ifndef SDP_PARSE_PRIVATE_H_
+#define SDP_PARSE_PRIVATE_H_
+
+#include "sdp_parse.h"
+
+/*
+	A search for each instance of an attribute in turn, either through an
+	index built by SdpParseIndexRecord or, if index is NULL, by walking the
+	raw service record.
+*/
+typedef struct
+{
+	const SdpParseIndex* index;
+	uint8 next_entry;		/* Next index entry to look at */
+	Region record;			/* Part of the record still to walk */
+} sdpParseSearch;
+
+void sdpParseSearchInit(sdpParseSearch* search, const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index);
+
+/*
+	Locate the next instance of an attribute, after any the search has
+	already returned.
+*/
+bool sdpParseSearchNext(sdpParseSearch* search, ServiceAttributeId id, ServiceDataType* type, Region* value);
+
+/*
+	Locate the first instance of an attribute.
+*/
+bool sdpParseFindAttribute(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, ServiceAttributeId id, ServiceDataType* type, Region* value);
+
+#endif /* SDP_PARSE_PRIVATE_H_ */
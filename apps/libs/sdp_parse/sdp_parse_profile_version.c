@@ -10,7 +10,7 @@ DESCRIPTION
 	record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 
@@ -18,15 +18,16 @@ DESCRIPTION
 
 /* Find Profile Version */
 
-static bool findProfileVersion(const uint8 size_service_record, const uint8* service_record, const uint16 service_class, Region* value)
+static bool findProfileVersion(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, const uint16 service_class, Region* value)
 {	
 	ServiceDataType type;
-    Region record, protocols, protocol;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
+    Region protocols, protocol;
+    sdpParseSearch search;
 	
+    sdpParseSearchInit(&search, size_service_record, service_record, index);
+
 	/* Move protocols to Profile Descriptor List */
-    while(ServiceFindAttribute(&record, saBluetoothProfileDescriptorList, &type, &protocols))
+    while(sdpParseSearchNext(&search, saBluetoothProfileDescriptorList, &type, &protocols))
 	{
 		if(type == sdtSequence)
 		{
@@ -55,14 +56,12 @@ static bool findProfileVersion(const uint8 size_service_record, const uint8* ser
     return FALSE; 
 }
 
-/************************************ Public ******************************/
-
 /* Access Profile Version */
 
-bool SdpParseGetProfileVersion(const uint8 size_service_record, const uint8* service_record, uint16 service_class, uint16* profile)
+static bool getProfileVersion(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint16 service_class, uint16* profile)
 {
 	Region value;
-    if (findProfileVersion(size_service_record, service_record, service_class, &value))
+    if (findProfileVersion(size_service_record, service_record, index, service_class, &value))
     {
         *profile = (uint16) RegionReadUnsigned(&value);
 		/* Accessed Successfully */
@@ -74,10 +73,10 @@ bool SdpParseGetProfileVersion(const uint8 size_service_record, const uint8* ser
 
 /* Insert Profile Version */
 
-bool SdpParseInsertProfileVersion(const uint8 size_service_record, const uint8* service_record, uint16 service_class, uint16 profile)
+static bool insertProfileVersion(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint16 service_class, uint16 profile)
 {
 	Region value;
-    if (findProfileVersion(size_service_record, service_record, service_class, &value) && RegionSize(&value) == 2)
+    if (findProfileVersion(size_service_record, service_record, index, service_class, &value) && RegionSize(&value) == 2)
     {
             RegionWriteUnsigned(&value, (uint32) profile);
 			/* Inserted Successfully */
@@ -86,3 +85,25 @@ bool SdpParseInsertProfileVersion(const uint8 size_service_record, const uint8*
 	/* Failed */
     return FALSE;
 }
+
+/************************************ Public ******************************/
+
+bool SdpParseGetProfileVersion(const uint8 size_service_record, const uint8* service_record, uint16 service_class, uint16* profile)
+{
+	return getProfileVersion(size_service_record, service_record, NULL, service_class, profile);
+}
+
+bool SdpParseInsertProfileVersion(const uint8 size_service_record, const uint8* service_record, uint16 service_class, uint16 profile)
+{
+	return insertProfileVersion(size_service_record, service_record, NULL, service_class, profile);
+}
+
+bool SdpParseIndexGetProfileVersion(const SdpParseIndex* index, uint16 service_class, uint16* profile)
+{
+	return getProfileVersion(0, NULL, index, service_class, profile);
+}
+
+bool SdpParseIndexInsertProfileVersion(const SdpParseIndex* index, uint16 service_class, uint16 profile)
+{
+	return insertProfileVersion(0, NULL, index, service_class, profile);
+}
@@ -10,7 +10,7 @@ DESCRIPTION
 	record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 #include <panic.h>
@@ -21,15 +21,15 @@ DESCRIPTION
 
 /* Find PDL */
 
-static bool findProtocolDescriptorList(const uint8 size_service_record, const uint8* service_record, Region* protocols)
+static bool findProtocolDescriptorList(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, Region* protocols)
 {
 	ServiceDataType type;
-    Region record;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
+    sdpParseSearch search;
+
+    sdpParseSearchInit(&search, size_service_record, service_record, index);
 
 	/* Move protocols to Protocol Descriptor List */
-    while(ServiceFindAttribute(&record, saProtocolDescriptorList, &type, protocols))
+    while(sdpParseSearchNext(&search, saProtocolDescriptorList, &type, protocols))
 		if(type == sdtSequence)
 			/* Success */
 			return TRUE;
@@ -77,14 +77,12 @@ static bool findServerChannel(Region* protocols, uint32 channel_id, Region* valu
     return FALSE;
 }
 
-/************************************ Public ******************************/
-
 /* Insert RFCOMM Server Channel */
 
-bool SdpParseInsertRfcommServerChannel(const uint8 size_service_record, const uint8* service_record, uint8 chan)
+static bool insertRfcommServerChannel(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint8 chan)
 {
 	Region protocols,value;
-    if(findProtocolDescriptorList(size_service_record, service_record, &protocols))
+    if(findProtocolDescriptorList(size_service_record, service_record, index, &protocols))
     	if(findServerChannel(&protocols, (uint32) UUID_RFCOMM, &value))
 		{
 			RegionWriteUnsigned(&value, (uint32) chan);
@@ -97,12 +95,12 @@ bool SdpParseInsertRfcommServerChannel(const uint8 size_service_record, const ui
 
 /* Access All RFCOMM Server Channels */
 
-bool SdpParseGetMultipleRfcommServerChannels(const uint8 size_service_record, const uint8* service_record, uint8 size_chans, uint8** chans, uint8* chans_found)
+static bool getMultipleRfcommServerChannels(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint8 size_chans, uint8** chans, uint8* chans_found)
 {
 	Region protocols, value;
 	*chans_found = 0;
 
-	if(findProtocolDescriptorList(size_service_record, service_record, &protocols))
+	if(findProtocolDescriptorList(size_service_record, service_record, index, &protocols))
 		while(findServerChannel(&protocols, (uint32) UUID_RFCOMM, &value))
 		{
 			/* reset protocols.begin so next search starts from after the channel we just found */
@@ -133,3 +131,25 @@ bool SdpParseGetMultipleRfcommServerChannels(const uint8 size_service_record, co
     	return FALSE;
 	}
 }
+
+/************************************ Public ******************************/
+
+bool SdpParseInsertRfcommServerChannel(const uint8 size_service_record, const uint8* service_record, uint8 chan)
+{
+	return insertRfcommServerChannel(size_service_record, service_record, NULL, chan);
+}
+
+bool SdpParseGetMultipleRfcommServerChannels(const uint8 size_service_record, const uint8* service_record, uint8 size_chans, uint8** chans, uint8* chans_found)
+{
+	return getMultipleRfcommServerChannels(size_service_record, service_record, NULL, size_chans, chans, chans_found);
+}
+
+bool SdpParseIndexInsertRfcommServerChannel(const SdpParseIndex* index, uint8 chan)
+{
+	return insertRfcommServerChannel(0, NULL, index, chan);
+}
+
+bool SdpParseIndexGetMultipleRfcommServerChannels(const SdpParseIndex* index, uint8 size_chans, uint8** chans, uint8* chans_found)
+{
+	return getMultipleRfcommServerChannels(0, NULL, index, size_chans, chans, chans_found);
+}
@@ -9,7 +9,7 @@ DESCRIPTION
 	Contains functions for accessing the service name in a service record
 */
 
-#include "sdp_parse.h"
+#include "sdp_parse_private.h"
 #include <service.h>
 #include <region.h>
 #include <panic.h>
@@ -22,14 +22,11 @@ DESCRIPTION
 
 /* Find Service Name Attribute */
 
-static bool findServiceName(const uint8 size_service_record, const uint8* service_record, ServiceAttributeId id, Region* value)
+static bool findServiceName(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, ServiceAttributeId id, Region* value)
 {
 	ServiceDataType type;
-    Region record;
-    record.begin = service_record;
-    record.end   = service_record + size_service_record;
 	
-	if (ServiceFindAttribute(&record, id, &type, value))
+	if (sdpParseFindAttribute(size_service_record, service_record, index, id, &type, value))
 		if(type == sdtTextString)
 		{
 			/* Found the Attribute Field */
@@ -39,17 +36,15 @@ static bool findServiceName(const uint8 size_service_record, const uint8* servic
 	return FALSE;
 }
 
-/************************************ Public ******************************/
-
 /* Access Service Name Attribute */
 
-bool SdpParseGetServiceName(const uint8 size_service_record, const uint8* service_record, uint8 size_service_name, char** service_name, uint8* length_service_name)
+static bool getServiceName(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, uint8 size_service_name, char** service_name, uint8* length_service_name)
 {
 	Region value;
 	uint8 k;
 	
 	/* if found service name field */
-	if(findServiceName(size_service_record, service_record, saServiceName, &value))
+	if(findServiceName(size_service_record, service_record, index, saServiceName, &value))
 	{	
 		/* read in size of service name string */
 		value.end = value.begin;
@@ -95,7 +90,7 @@ bool SdpParseGetServiceName(const uint8 size_service_record, const uint8* servic
 
 /* Insert Service Name Attribute */
 
-bool SdpParseInsertServiceName(const uint8 size_service_record, const uint8* service_record, char* service_name)
+static bool insertServiceName(const uint8 size_service_record, const uint8* service_record, const SdpParseIndex* index, char* service_name)
 {
 	Region value;
 	uint8 size_service_name, size_old_service_name, k;
@@ -105,7 +100,7 @@ bool SdpParseInsertServiceName(const uint8 size_service_record, const uint8* ser
 	if(size_service_name <= MAX_SIZE_SERVICE_NAME && size_service_name > 0)
 	{
 		/* if found service name field */
-		if(findServiceName(size_service_record, service_record, saServiceName, &value))
+		if(findServiceName(size_service_record, service_record, index, saServiceName, &value))
 		{	
 			/* move to size service name value */
 			value.end = value.begin;
@@ -143,3 +138,25 @@ bool SdpParseInsertServiceName(const uint8 size_service_record, const uint8* ser
 	/* Failed */
 	return FALSE;
 }
+
+/************************************ Public ******************************/
+
+bool SdpParseGetServiceName(const uint8 size_service_record, const uint8* service_record, uint8 size_service_name, char** service_name, uint8* length_service_name)
+{
+	return getServiceName(size_service_record, service_record, NULL, size_service_name, service_name, length_service_name);
+}
+
+bool SdpParseInsertServiceName(const uint8 size_service_record, const uint8* service_record, char* service_name)
+{
+	return insertServiceName(size_service_record, service_record, NULL, service_name);
+}
+
+bool SdpParseIndexGetServiceName(const SdpParseIndex* index, uint8 size_service_name, char** service_name, uint8* length_service_name)
+{
+	return getServiceName(0, NULL, index, size_service_name, service_name, length_service_name);
+}
+
+bool SdpParseIndexInsertServiceName(const SdpParseIndex* index, char* service_name)
+{
+	return insertServiceName(0, NULL, index, service_name);
+}
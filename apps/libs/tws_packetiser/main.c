@@ -0,0 +1,689 @@
+/****************************************************************************
+Copyright (c) 2016 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    main.c
+
+DESCRIPTION
+    Host harness for the TWS packet master and slave. Splits an SBC file into
+    frames, packs the frames into TWS packets of the given MTU, unpacks the
+    packets again, checks the result against the input and reports the frames
+    processed per second.
+
+    The packets are then fed through the slave packetiser with the stream
+    traps replaced by a mock source of packets and a mock timestamped sink,
+    to check the frames written to the sink and the claims made for them:
+    multi-frame SBC packets, a sink too small to claim a whole packet, and
+    AAC frames fragmented across packets, one of them left incomplete.
+
+    Usage: tws_packetiser <file.sbc> [mtu]
+    e.g. audio/kse/resource/153_Prompts_176.4_kHz_Music_Detected_48k.sbc
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tws_packetiser.h"
+#include "packet_master.h"
+#include "packet_slave.h"
+#include "frame_info.h"
+
+#include <message.h>
+#include <panic.h>
+#include <sink.h>
+#include <source.h>
+#include <stream.h>
+#include <system_clock.h>
+
+/* Default packet size, a 2-DH5 payload less L2CAP overhead */
+#define DEFAULT_MTU     672
+
+/* Number of passes over the file for each measurement */
+#define PASSES          200
+
+/* Mock source and sink for the slave packetiser */
+#define MOCK_MAX_PACKETS    1024
+#define MOCK_MAX_FRAMES     1024
+#define MOCK_SINK_SIZE      4096
+#define MOCK_SINK_OUT_SIZE  (MOCK_MAX_FRAMES * 1024)
+#define MOCK_NOW            1000000
+#define MOCK_TTP_DELAY      100000
+#define MOCK_SOURCE         ((Source)&mock_stream)
+#define MOCK_SINK           ((Sink)&mock_stream)
+
+/* AAC frames fragmented across packets */
+#define FRAGMENT_FRAMES     40
+#define FRAGMENT_MTU        200
+#define FRAGMENT_DROPPED    7
+
+static int mock_stream;
+
+/* Packets in the source, one per boundary */
+static uint8 *source_packet[MOCK_MAX_PACKETS];
+static uint16 source_len[MOCK_MAX_PACKETS];
+static uint32 source_count;
+static uint32 source_next;
+
+/* The sink keeps the claimed space at the start of sink_buffer. Flushed
+   records are moved to sink_out at once, so only the claimed space counts
+   against sink_space. */
+static uint8 sink_buffer[MOCK_SINK_SIZE];
+static uint32 sink_claimed;
+static uint32 sink_space;
+static uint8 sink_out[MOCK_SINK_OUT_SIZE];
+static uint32 sink_out_len;
+static uint32 sink_record_len[MOCK_MAX_FRAMES];
+static uint32 sink_records;
+static unsigned long sink_maps;
+static unsigned long sink_queries;
+static unsigned long sink_claims;
+static unsigned long sink_claim_failures;
+
+static TaskData client_task;
+static Task slave_task;
+
+static uint8 *readFile(const char *name, uint32 *len)
+{
+    FILE *f = fopen(name, "rb");
+    uint8 *data = NULL;
+    long size;
+
+    if (f && fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) > 0)
+    {
+        rewind(f);
+        data = malloc(size);
+        if (data && fread(data, 1, size, f) == (size_t)size)
+        {
+            *len = (uint32)size;
+        }
+        else
+        {
+            free(data);
+            data = NULL;
+        }
+    }
+    if (f)
+    {
+        fclose(f);
+    }
+    return data;
+}
+
+/* Pack all the frames into packets, then unpack each packet. Returns the
+   number of frames unpacked, or zero if the output differs from the input. */
+static uint32 runPass(const uint8 *sbc, uint32 sbc_len, uint32 mtu,
+                      uint8 *packet_buffer, uint8 *out)
+{
+    tws_packetiser_slave_config_t slave_config;
+    packet_master_t master;
+    uint32 in_offset = 0, out_offset = 0, frames = 0;
+    audio_frame_metadata_t fmd;
+    frame_info_history_sbc_t history;
+
+    memset(&slave_config, 0, sizeof(slave_config));
+    slave_config.codec = TWS_PACKETISER_CODEC_SBC;
+    memset(&fmd, 0, sizeof(fmd));
+    memset(&history, 0, sizeof(history));
+
+    master.funcs = &packet_master_funcs_tws;
+    if (!master.funcs->init(&master, TWS_PACKETISER_CODEC_SBC, FALSE))
+    {
+        return 0;
+    }
+
+    while (in_offset < sbc_len)
+    {
+        packet_slave_t slave;
+        rtime_t ttp;
+        packetiser_helper_scmst_t scmst;
+        bool complete;
+        frame_info_t frame_info;
+        rtime_spadj_mini_t spadj_mini;
+        uint32 frame_number;
+
+        /* Master: header, then as many whole frames as fit */
+        master.funcs->packetInit(&master, packet_buffer, mtu);
+        master.funcs->writeHeader(&master, frames, packetiser_helper_scmst_copy_allowed);
+        while (in_offset < sbc_len &&
+               frameInfoSBC(sbc + in_offset, sbc_len - in_offset, &frame_info, &history) &&
+               frame_info.length <= sbc_len - in_offset &&
+               master.funcs->writeAudioFrame(&master, sbc + in_offset, frame_info.length, &fmd))
+        {
+            in_offset += frame_info.length;
+        }
+        master.funcs->finalise(&master);
+        if (master.funcs->packetLength(&master) <= master.funcs->headerLength(&master, 0))
+        {
+            /* Not even one frame was written */
+            break;
+        }
+
+        /* Slave: every frame straight into the output */
+        slave.funcs = &packet_slave_funcs_tws;
+        if (!slave.funcs->init(&slave, packet_buffer, master.funcs->packetLength(&master), &slave_config) ||
+            !slave.funcs->readHeader(&slave, &ttp, &scmst, &complete))
+        {
+            return 0;
+        }
+        while (slave.funcs->readMiniSpadj(&slave, &spadj_mini) &&
+               slave.funcs->readAudioFrameInfo(&slave, &frame_info) &&
+               slave.funcs->readAudioFrame(&slave, out + out_offset, frame_info.length, &frame_number))
+        {
+            out_offset += frame_info.length;
+            frames++;
+        }
+        slave.funcs->unInit(&slave);
+    }
+
+    if (out_offset != in_offset || memcmp(sbc, out, in_offset) != 0)
+    {
+        return 0;
+    }
+    return frames;
+}
+
+/* Traps used by the slave packetiser */
+const uint8 *SourceMap(Source source)
+{
+    UNUSED(source);
+    return source_next < source_count ? source_packet[source_next] : NULL;
+}
+
+uint16 SourceBoundary(Source source)
+{
+    UNUSED(source);
+    return source_next < source_count ? source_len[source_next] : 0;
+}
+
+void SourceDrop(Source source, uint16 amount)
+{
+    UNUSED(source);
+    if (source_next < source_count && amount == source_len[source_next])
+    {
+        source_next++;
+    }
+    else
+    {
+        Panic();
+    }
+}
+
+const void *SourceMapHeader(Source source)
+{
+    UNUSED(source);
+    return NULL;
+}
+
+uint16 SourceSizeHeader(Source source)
+{
+    UNUSED(source);
+    return 0;
+}
+
+uint8 *SinkMap(Sink sink)
+{
+    UNUSED(sink);
+    sink_maps++;
+    return sink_buffer;
+}
+
+uint16 SinkClaim(Sink sink, uint16 extra)
+{
+    uint32 offset = sink_claimed;
+    UNUSED(sink);
+    if (!extra)
+    {
+        sink_queries++;
+        return (uint16)offset;
+    }
+    if (sink_claimed + extra > sink_space)
+    {
+        sink_claim_failures++;
+        return 0xFFFF;
+    }
+    sink_claims++;
+    sink_claimed += extra;
+    return (uint16)offset;
+}
+
+bool SinkFlushHeader(Sink sink, uint16 amount, const void *header, uint16 length)
+{
+    UNUSED(sink);
+    UNUSED(header);
+    if (!amount || amount > sink_claimed || length != AUDIO_FRAME_METADATA_LENGTH ||
+        sink_records == MOCK_MAX_FRAMES || sink_out_len + amount > MOCK_SINK_OUT_SIZE)
+    {
+        return FALSE;
+    }
+    memcpy(sink_out + sink_out_len, sink_buffer, amount);
+    sink_out_len += amount;
+    sink_record_len[sink_records++] = amount;
+    sink_claimed -= amount;
+    memmove(sink_buffer, sink_buffer + amount, sink_claimed);
+    return TRUE;
+}
+
+bool SinkMapInit(Sink sink, stream_device device, uint16 header_len)
+{
+    UNUSED(sink);
+    UNUSED(device);
+    return header_len == AUDIO_FRAME_METADATA_LENGTH;
+}
+
+bool SinkUnmap(Sink sink)
+{
+    UNUSED(sink);
+    return TRUE;
+}
+
+bool SinkIsValid(Sink sink)
+{
+    return sink == MOCK_SINK;
+}
+
+bool SourceIsValid(Source source)
+{
+    return source == MOCK_SOURCE;
+}
+
+bool SinkConfigure(Sink sink, stream_config_key key, uint32 value)
+{
+    UNUSED(sink);
+    UNUSED(key);
+    UNUSED(value);
+    return TRUE;
+}
+
+bool SourceConfigure(Source source, stream_config_key key, uint32 value)
+{
+    UNUSED(source);
+    UNUSED(key);
+    UNUSED(value);
+    return TRUE;
+}
+
+Sink StreamSinkFromSource(Source source)
+{
+    UNUSED(source);
+    return MOCK_SINK;
+}
+
+/* The wall clock is the local clock */
+bool SinkGetWallclock(Sink sink, bt_wallclock_info *wallclock)
+{
+    UNUSED(sink);
+    memset(wallclock, 0, sizeof(*wallclock));
+    return TRUE;
+}
+
+rtime_t SystemClockGetTimerTime(void)
+{
+    return MOCK_NOW;
+}
+
+Task MessageStreamTaskFromSink(Sink sink, Task task)
+{
+    UNUSED(sink);
+    UNUSED(task);
+    return NULL;
+}
+
+Task MessageStreamTaskFromSource(Source source, Task task)
+{
+    UNUSED(source);
+    UNUSED(task);
+    return NULL;
+}
+
+/* The slave's own message starts it reading, remember its task */
+void MessageSend(Task task, MessageId id, void *message)
+{
+    UNUSED(id);
+    if (task != &client_task)
+    {
+        slave_task = task;
+    }
+    free(message);
+}
+
+void MessageSendLater(Task task, MessageId id, void *message, uint32 delay)
+{
+    UNUSED(task);
+    UNUSED(id);
+    UNUSED(delay);
+    free(message);
+}
+
+uint16 MessageCancelAll(Task task, MessageId id)
+{
+    UNUSED(task);
+    UNUSED(id);
+    return 0;
+}
+
+uint16 MessageFlushTask(Task task)
+{
+    UNUSED(task);
+    return 0;
+}
+
+void Panic(void)
+{
+    printf("Panic\n");
+    abort();
+}
+
+void *PanicNull(void *p)
+{
+    if (!p)
+    {
+        Panic();
+    }
+    return p;
+}
+
+void *PanicUnlessMalloc(size_t sz)
+{
+    return PanicNull(malloc(sz));
+}
+
+/* Empty the mock source */
+static void sourceReset(void)
+{
+    while (source_count)
+    {
+        free(source_packet[--source_count]);
+    }
+    source_next = 0;
+}
+
+/* TTP of each frame, or of each set of fragments of a frame */
+static rtime_t frameTtp(uint32 frame)
+{
+    return MOCK_NOW + MOCK_TTP_DELAY + frame * 100;
+}
+
+/* Pack frames into packets of at most mtu octets for the mock source. Each
+   packet has the TTP of the first frame it holds. If end_packet is not NULL
+   it is set to the packet holding the end of each frame. Returns FALSE if the
+   frames do not fit in the source. */
+static bool sourcePack(tws_packetiser_codec_t codec, const uint8 *data,
+                       const uint32 *frame_len, uint32 frames, uint32 mtu,
+                       uint32 *end_packet)
+{
+    packet_master_t master;
+    audio_frame_metadata_t fmd;
+    uint32 frame = 0, offset = 0;
+
+    memset(&fmd, 0, sizeof(fmd));
+    master.funcs = &packet_master_funcs_tws;
+    if (!master.funcs->init(&master, codec, FALSE))
+    {
+        return FALSE;
+    }
+
+    while (frame < frames && source_count < MOCK_MAX_PACKETS)
+    {
+        uint8 *packet = PanicUnlessMalloc(mtu);
+
+        master.funcs->packetInit(&master, packet, mtu);
+        master.funcs->writeHeader(&master, frameTtp(frame), packetiser_helper_scmst_copy_allowed);
+        while (frame < frames &&
+               master.funcs->writeAudioFrame(&master, data + offset, frame_len[frame], &fmd))
+        {
+            if (end_packet)
+            {
+                end_packet[frame] = source_count;
+            }
+            offset += frame_len[frame++];
+        }
+        master.funcs->finalise(&master);
+        if (master.funcs->packetLength(&master) <= master.funcs->headerLength(&master, 0))
+        {
+            free(packet);
+            return FALSE;
+        }
+        source_packet[source_count] = packet;
+        source_len[source_count++] = (uint16)master.funcs->packetLength(&master);
+    }
+    return frame == frames;
+}
+
+/* Remove a packet from the mock source, as if it was lost */
+static void sourceLose(uint32 packet)
+{
+    free(source_packet[packet]);
+    source_count--;
+    memmove(&source_packet[packet], &source_packet[packet + 1], (source_count - packet) * sizeof(source_packet[0]));
+    memmove(&source_len[packet], &source_len[packet + 1], (source_count - packet) * sizeof(source_len[0]));
+}
+
+/* Run the slave packetiser over the packets in the source, with space
+   octets in the sink. Returns the number of errors found in the frames
+   written to the sink. */
+static int runSlave(const char *name, tws_packetiser_codec_t codec, uint32 space,
+                    const uint8 *expect, const uint32 *expect_len, uint32 expect_frames)
+{
+    tws_packetiser_slave_config_t config;
+    tws_packetiser_slave_t *tp;
+    uint32 expect_total = 0, i;
+    int errors = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.client = &client_task;
+    config.source = MOCK_SOURCE;
+    config.sink = MOCK_SINK;
+    config.codec = codec;
+    config.sample_rate = rtime_sample_rate_44100;
+    config.scmst = packetiser_helper_scmst_copy_allowed;
+    config.mode = TWS_PACKETISER_SLAVE_MODE_TWS;
+
+    sink_claimed = sink_out_len = sink_records = 0;
+    sink_space = space;
+    sink_maps = sink_queries = sink_claims = sink_claim_failures = 0;
+    slave_task = NULL;
+
+    tp = TwsPacketiserSlaveInit(&config);
+    if (!tp || !slave_task)
+    {
+        printf("  %s: init failed\n", name);
+        return 1;
+    }
+    slave_task->handler(slave_task, MESSAGE_MORE_DATA, NULL);
+    TwsPacketiserSlaveDestroy(tp);
+
+    if (source_next != source_count)
+    {
+        printf("  %s: %lu of %lu packets read\n", name,
+               (unsigned long)source_next, (unsigned long)source_count);
+        errors++;
+    }
+    if (sink_records != expect_frames)
+    {
+        printf("  %s: %lu frames written, expected %lu\n", name,
+               (unsigned long)sink_records, (unsigned long)expect_frames);
+        errors++;
+    }
+    for (i = 0; i < expect_frames && i < sink_records; i++)
+    {
+        if (sink_record_len[i] != expect_len[i])
+        {
+            printf("  %s: frame %lu is %lu octets, expected %lu\n", name, (unsigned long)i,
+                   (unsigned long)sink_record_len[i], (unsigned long)expect_len[i]);
+            errors++;
+            break;
+        }
+    }
+    for (i = 0; i < expect_frames; i++)
+    {
+        expect_total += expect_len[i];
+    }
+    if (sink_out_len != expect_total || memcmp(sink_out, expect, expect_total) != 0)
+    {
+        printf("  %s: frames in the sink differ from the input\n", name);
+        errors++;
+    }
+    printf("  %s: %lu packets, %lu frames, %lu maps, %lu queries, %lu claims, %lu failed: %s\n",
+           name, (unsigned long)source_count, (unsigned long)sink_records,
+           sink_maps, sink_queries, sink_claims, sink_claim_failures,
+           errors ? "FAIL!" : "OK");
+    return errors;
+}
+
+/* Multi-frame SBC packets into a sink that can take a whole packet, then
+   into one that can only take the largest frame. */
+static int testSlaveSBC(const uint8 *sbc, uint32 sbc_len, uint32 mtu)
+{
+    static uint32 frame_len[MOCK_MAX_FRAMES];
+    frame_info_history_sbc_t history;
+    frame_info_t frame_info;
+    uint32 frames = 0, offset = 0, largest = 0, packets;
+    int errors = 0;
+
+    memset(&history, 0, sizeof(history));
+    while (frames < MOCK_MAX_FRAMES && offset < sbc_len &&
+           frameInfoSBC(sbc + offset, sbc_len - offset, &frame_info, &history) &&
+           frame_info.length <= sbc_len - offset)
+    {
+        frame_len[frames++] = frame_info.length;
+        offset += frame_info.length;
+        largest = MAX(largest, frame_info.length);
+    }
+
+    if (!sourcePack(TWS_PACKETISER_CODEC_SBC, sbc, frame_len, frames, mtu, NULL))
+    {
+        printf("  SBC frames do not fit the source\n");
+        sourceReset();
+        return 1;
+    }
+    packets = source_count;
+
+    /* One query and one claim per packet, whatever its number of frames */
+    errors += runSlave("SBC", TWS_PACKETISER_CODEC_SBC, MOCK_SINK_SIZE, sbc, frame_len, frames);
+    if (sink_queries != packets || sink_claims != packets || sink_claim_failures)
+    {
+        printf("  SBC: expected a query and a claim per packet\n");
+        errors++;
+    }
+
+    /* The claim for the whole packet fails, each frame is claimed instead */
+    source_next = 0;
+    errors += runSlave("SBC, small sink", TWS_PACKETISER_CODEC_SBC, largest, sbc, frame_len, frames);
+    if (sink_claim_failures != packets || sink_claims != frames)
+    {
+        printf("  SBC, small sink: expected a failed claim per packet and a claim per frame\n");
+        errors++;
+    }
+
+    sourceReset();
+    return errors;
+}
+
+/* AAC frames fragmented across packets. The packet with the end of one frame
+   is lost, so the fragments of that frame are left claimed in the sink and
+   must be overwritten by the next frame. */
+static int testSlaveFragments(void)
+{
+    static uint8 data[FRAGMENT_FRAMES * 1024];
+    static uint32 frame_len[FRAGMENT_FRAMES];
+    static uint32 end_packet[FRAGMENT_FRAMES];
+    uint32 frames, offset = 0, dropped_len, dropped_offset = 0;
+    int errors;
+
+    for (frames = 0; frames < FRAGMENT_FRAMES; frames++)
+    {
+        uint32 i;
+        frame_len[frames] = 100 + (frames * 37) % 800;
+        for (i = 0; i < frame_len[frames]; i++)
+        {
+            data[offset + i] = (uint8)(rand() & 0xff);
+        }
+        if (frames < FRAGMENT_DROPPED)
+        {
+            dropped_offset += frame_len[frames];
+        }
+        offset += frame_len[frames];
+    }
+
+    if (!sourcePack(TWS_PACKETISER_CODEC_AAC, data, frame_len, frames, FRAGMENT_MTU, end_packet) ||
+        end_packet[FRAGMENT_DROPPED] == end_packet[FRAGMENT_DROPPED - 1] + 1)
+    {
+        printf("  AAC frames do not fit the source or are not fragmented\n");
+        sourceReset();
+        return 1;
+    }
+
+    /* Expect every frame but the one whose end is lost */
+    sourceLose(end_packet[FRAGMENT_DROPPED]);
+    dropped_len = frame_len[FRAGMENT_DROPPED];
+    memmove(data + dropped_offset, data + dropped_offset + dropped_len, offset - dropped_offset - dropped_len);
+    memmove(&frame_len[FRAGMENT_DROPPED], &frame_len[FRAGMENT_DROPPED + 1],
+            (FRAGMENT_FRAMES - FRAGMENT_DROPPED - 1) * sizeof(frame_len[0]));
+
+    errors = runSlave("AAC fragments", TWS_PACKETISER_CODEC_AAC, MOCK_SINK_SIZE,
+                      data, frame_len, FRAGMENT_FRAMES - 1);
+    sourceReset();
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 sbc_len = 0, mtu = DEFAULT_MTU, frames = 0, pass;
+    uint8 *sbc, *out, *packet_buffer;
+    clock_t start, elapsed;
+    int errors = 0;
+
+    if (argc < 2)
+    {
+        printf("Usage: %s <file.sbc> [mtu]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2)
+    {
+        mtu = (uint32)atoi(argv[2]);
+    }
+
+    sbc = readFile(argv[1], &sbc_len);
+    out = malloc(sbc_len);
+    packet_buffer = malloc(mtu);
+    if (!sbc || !out || !packet_buffer)
+    {
+        printf("Cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    start = clock();
+    for (pass = 0; pass < PASSES; pass++)
+    {
+        uint32 pass_frames = runPass(sbc, sbc_len, mtu, packet_buffer, out);
+        if (!pass_frames)
+        {
+            printf("FAIL! Unpacked frames differ from the input\n");
+            return 1;
+        }
+        frames += pass_frames;
+    }
+    elapsed = clock() - start;
+    if (!elapsed)
+    {
+        elapsed = 1;
+    }
+
+    printf("%lu frames of %lu bytes in %lu-byte packets\n",
+           (unsigned long)(frames / PASSES), (unsigned long)sbc_len, (unsigned long)mtu);
+    printf("Speed = %lu frames/second\n",
+           (unsigned long)((double)frames * CLOCKS_PER_SEC / elapsed));
+
+    printf("Slave packetiser:\n");
+    errors += testSlaveSBC(sbc, sbc_len, mtu);
+    errors += testSlaveFragments();
+    printf("%s\n", errors ? "FAIL!" : "OK");
+
+    free(packet_buffer);
+    free(out);
+    free(sbc);
+    return errors ? 1 : 0;
+}
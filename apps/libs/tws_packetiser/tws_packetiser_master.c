@@ -162,10 +162,9 @@ static process_header_action_t tpDecideAction(tws_packetiser_master_t *tp, rtime
     return action;
 }
 
-static bool tpProcessHeader(tws_packetiser_master_t *tp)
+/* On success, fmd holds the metadata of the first frame for the packet */
+static bool tpProcessHeader(tws_packetiser_master_t *tp, audio_frame_metadata_t *fmd)
 {
-    audio_frame_metadata_t fmd;
-
     /* A message may already be queued for the frame at the head of the source -
        this will happen if the time to transmit the frame is in the future, and
        this function is re-called (e.g. because of a MESSAGE_MORE_DATA) before
@@ -173,9 +172,9 @@ static bool tpProcessHeader(tws_packetiser_master_t *tp)
        message - it will be re-sent if necessary */
     PanicFalse(MessageCancelAll(&tp->lib_task, TP_INTERNAL_TX_PACKET_MSG) <= 1);
 
-    while (PacketiserHelperAudioFrameMetadataGetFromSource(tp->config.source, &fmd))
+    while (PacketiserHelperAudioFrameMetadataGetFromSource(tp->config.source, fmd))
     {
-        process_header_action_t action = tpDecideAction(tp, fmd.ttp);
+        process_header_action_t action = tpDecideAction(tp, fmd->ttp);
         uint32 delay_ms;
         switch (action)
         {
@@ -187,7 +186,7 @@ static bool tpProcessHeader(tws_packetiser_master_t *tp)
             
             case WRITE_HEADER:
                 TP_DEBUG1("TPMASTER: ProcessHeader write header %d", tp->tx_time_before_ttp);
-                if (tpWriteHeader(tp, fmd.ttp))
+                if (tpWriteHeader(tp, fmd->ttp))
                 {
                     return TRUE;
                 }
@@ -203,7 +202,7 @@ static bool tpProcessHeader(tws_packetiser_master_t *tp)
 
             case DROP:
             default:
-                tpDropAudioFrame(tp, &fmd);
+                tpDropAudioFrame(tp, fmd);
                 TP_DEBUG1("TPMASTER: ProcessHeader drop %d", tp->tx_time_before_ttp);
             break;
         }
@@ -211,26 +210,26 @@ static bool tpProcessHeader(tws_packetiser_master_t *tp)
     return FALSE;
 }
 
-static void tpWriteFrames(tws_packetiser_master_t *tp)
+/* Write frames to the packet until it is full, starting with the frame whose
+   metadata was already read by tpProcessHeader() */
+static void tpWriteFrames(tws_packetiser_master_t *tp, audio_frame_metadata_t *fmd)
 {
-    audio_frame_metadata_t fmd;
-
-    while (PacketiserHelperAudioFrameMetadataGetFromSource(tp->config.source, &fmd))
+    do
     {
         uint32 frame_len = PanicZero(SourceBoundary(tp->config.source));
         const uint8 *frame_src = PanicNull((uint8*)SourceMap(tp->config.source));
 
-        if (tp->packet.funcs->writeAudioFrame(&tp->packet, frame_src, frame_len, &fmd))
+        if (tp->packet.funcs->writeAudioFrame(&tp->packet, frame_src, frame_len, fmd))
         {
             SourceDrop(tp->config.source, frame_len);
-            TP_DEBUG2("TPMASTER:    Wrote Frame: %d %d", fmd.ttp, frame_len);
+            TP_DEBUG2("TPMASTER:    Wrote Frame: %d %d", fmd->ttp, frame_len);
         }
         else
         {
             TP_DEBUG("TPMASTER:    !Wrote Frame");
             break;
         }
-    }
+    } while (PacketiserHelperAudioFrameMetadataGetFromSource(tp->config.source, fmd));
 }
 
 static void tpTransmitPacket(tws_packetiser_master_t *tp)
@@ -253,9 +252,11 @@ static void messageHandler(Task task, MessageId id, Message message)
         case MESSAGE_MORE_SPACE:
         case TP_INTERNAL_TX_PACKET_MSG:
         {
-            while (tpProcessHeader(tp))
+            audio_frame_metadata_t fmd;
+
+            while (tpProcessHeader(tp, &fmd))
             {
-                tpWriteFrames(tp);
+                tpWriteFrames(tp, &fmd);
                 tpTransmitPacket(tp);
 
                 if(tp->first_packet)
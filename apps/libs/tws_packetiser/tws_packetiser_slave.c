@@ -12,6 +12,7 @@ FILE NAME
 #include <packetiser_helper.h>
 #include <system_clock.h>
 #include <panic.h>
+#include <hydra_macros.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stream.h>
@@ -62,6 +63,11 @@ struct __tws_packetiser_slave
         The new fragment will need to overwrite the existing data in the claiming space. This variable
         is used to track the amount of pre-claimed data in the sink */
     uint32 excess_claimed;
+
+    /*! The amount claimed in the sink and not yet flushed. Read from the sink
+        at the start of each packet and then tracked locally, so the frames of
+        a packet do not each need to query the sink. */
+    uint32 claimed;
 };
 
 /* Send message to client when the scmst type changes */
@@ -78,27 +84,33 @@ static void handleScmstChange(tws_packetiser_slave_t *tp,
     }
 }
 
-static uint8 *sinkGetWriteAddr(tws_packetiser_slave_t *tp, uint32 len)
+/* Get the address at which to write a frame of len octets. reserve is the
+   amount of space the rest of the packet may need; it is claimed up front so
+   that the following frames in the packet are written into space that is
+   already claimed. */
+static uint8 *sinkGetWriteAddr(tws_packetiser_slave_t *tp, uint32 len, uint32 reserve)
 {
     Sink sink = tp->config.sink;
     uint8 *dest = SinkMap(sink);
     if (dest)
     {
-        int32 extra = len - tp->excess_claimed;
-        uint32 claimed = SinkClaim(sink, 0);
-        dest += (claimed - tp->excess_claimed);
-        if (extra >= 0)
+        dest += (tp->claimed - tp->excess_claimed);
+        if (len > tp->excess_claimed)
         {
+            uint32 extra = MAX(len, reserve) - tp->excess_claimed;
             if (SinkClaim(sink, extra) == 0xFFFF)
             {
-                return NULL;
+                /* Not enough space for the whole packet, try for just this frame */
+                extra = len - tp->excess_claimed;
+                if (SinkClaim(sink, extra) == 0xFFFF)
+                {
+                    return NULL;
+                }
             }
-            tp->excess_claimed = 0;
-        }
-        else
-        {
-            tp->excess_claimed = -extra;
+            tp->claimed += extra;
+            tp->excess_claimed += extra;
         }
+        tp->excess_claimed -= len;
     }
     return dest;
 }
@@ -108,13 +120,14 @@ static bool audioFrameReadSuccessfully(tws_packetiser_slave_t *tp,
                                        packet_slave_t *tws_packet,
                                        frame_info_t *frame_info,
                                        bool no_mini_spadj,
+                                       uint32 reserve,
                                        uint32 *frame_number)
 {
     if (no_mini_spadj || tws_packet->funcs->readMiniSpadj(tws_packet, &tp->spadj_mini))
     {
         if (tws_packet->funcs->readAudioFrameInfo(tws_packet, frame_info))
         {
-            uint8 *dest = sinkGetWriteAddr(tp, frame_info->length);
+            uint8 *dest = sinkGetWriteAddr(tp, frame_info->length, reserve);
             if (dest)
             {
                 return tws_packet->funcs->readAudioFrame(tws_packet, dest, frame_info->length, frame_number);
@@ -157,6 +170,9 @@ static bool tpReadPacket(tws_packetiser_slave_t *tp)
         frame_info_t frame_info;
         bool no_mini_spadj = TRUE;
         uint32 frame_number = 0;
+        /* The frames are copied out of the packet, so together they cannot
+           be longer than it */
+        uint32 reserve = len;
         uint32 ttp_bits = tws_packet.funcs->getTTPLenBits(&tws_packet);
         if (ttp_bits < 32)
         {
@@ -178,13 +194,21 @@ static bool tpReadPacket(tws_packetiser_slave_t *tp)
             no_mini_spadj = FALSE;
             tp->ttp_wallclock = ttp_wallclock;
             tp->excess_claimed = SinkClaim(tp->config.sink, 0);
+            tp->claimed = tp->excess_claimed;
+        }
+        else
+        {
+            tp->claimed = SinkClaim(tp->config.sink, 0);
         }
 
         TP_DEBUG1("TPSLAVE: Received packet with TTP 0x%x", ttp_wallclock);
 
         /* Read all the frames directly into the sink */
-        while(audioFrameReadSuccessfully(tp, &tws_packet, &frame_info, no_mini_spadj, &frame_number))
+        while(audioFrameReadSuccessfully(tp, &tws_packet, &frame_info, no_mini_spadj, reserve, &frame_number))
         {
+            /* Space for the rest of the packet was claimed with the first frame */
+            reserve = 0;
+
             if (complete)
             {
                 rtime_t frame_time;
@@ -193,6 +217,7 @@ static bool tpReadPacket(tws_packetiser_slave_t *tp)
                 {
                     /* Convert fmd structure to bytes then flush the frame */
                     uint8 fmdbin[AUDIO_FRAME_METADATA_LENGTH];
+                    uint32 written = tp->claimed - tp->excess_claimed;
 
                     if(0 == frame_number)
                     {
@@ -201,9 +226,9 @@ static bool tpReadPacket(tws_packetiser_slave_t *tp)
 
                     fmd.sample_period_adjustment = RtimeSpadjMiniToFull(tp->spadj_mini);
                     PacketiserHelperAudioFrameMetadataSet(&fmd, fmdbin);
-                    PanicFalse(SinkFlushHeader(tp->config.sink,
-                                               SinkClaim(tp->config.sink, 0) - tp->excess_claimed,
+                    PanicFalse(SinkFlushHeader(tp->config.sink, written,
                                                fmdbin, sizeof(fmdbin)));
+                    tp->claimed -= written;
                     TP_DEBUG2("TPSLAVE:    0x%x, %d", fmd.ttp, time_before_ttp);
                 }
                 else
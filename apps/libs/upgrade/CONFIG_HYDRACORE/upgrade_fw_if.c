@@ -255,6 +255,7 @@ UpgradeFWIFPartitionHdl UpgradeFWIFPartitionOpen(uint16 logic,uint16 physPartiti
     UpgradePartitionsMarkUpgrading(logic);
 
     UpgradeCtxGetFW()->partitionNum = physPartition;
+    UpgradeCtxGetFW()->writeFailed = FALSE;
 
     return (UpgradeFWIFPartitionHdl)(int)sink;
 }
@@ -282,6 +283,12 @@ UpgradeHostErrorCode UpgradeFWIFPartitionClose(UpgradeFWIFPartitionHdl handle)
     if (!sink)
         return FALSE;
 
+    if (UpgradeCtxGetFW()->writeFailed)
+    {
+        PRINT(("UPG: Not closing partition after a failed write\n"));
+        return UPGRADE_HOST_ERROR_PARTITION_CLOSE_FAILED;
+    }
+
     if (!UpgradePSSpaceForCriticalOperations())
     {
         return UPGRADE_HOST_ERROR_PARTITION_CLOSE_FAILED_PS_SPACE;
@@ -342,6 +349,11 @@ uint16 UpgradeFWIFPartitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, ui
     return len;
 }
 
+uint16 UpgradeFWIFPartitionWriteBehind(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len)
+{
+    return UpgradeFWIFPartitionWrite(handle, data, len);
+}
+
 UpgradeHostErrorCode UpgradeFWIFPartitionClose(UpgradeFWIFPartitionHdl handle)
 {
     UNUSED(handle);
@@ -100,21 +100,22 @@ const char *UpgradeFWIFGetHeaderID(void)
 
 /***************************************************************************
 NAME
-    UpgradeFWIFPartitionWrite
+    partitionWrite
 
 DESCRIPTION
-    Write data to an open external flash partition. Each byte of the data
-    is copied to the partition in a byte by byte copy operation.
+    Copy data into a partition sink and flush it.
 
 PARAMS
     handle Handle to a writeable partition.
     data Pointer to the data to write.
     len Number of bytes (not words) to write.
+    wait TRUE to return only once the data is in the partition, FALSE to
+         return as soon as the write has been started.
 
 RETURNS
     uint16 The number of bytes written, or 0 if there was an error.
 */
-uint16 UpgradeFWIFPartitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len)
+static uint16 partitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len, bool wait)
 {
     uint8 *dst;
     Sink sink = (Sink)(int)handle;
@@ -122,6 +123,14 @@ uint16 UpgradeFWIFPartitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, ui
     if (!sink)
         return 0;
 
+    /* A write that was not waited for may have failed since */
+    if (UpgradeCtxGetFW()->writeFailed || !SinkIsValid(sink))
+    {
+        PRINT(("UPG: Earlier write to partition failed: sink %p\n", (void *) sink));
+        UpgradeCtxGetFW()->writeFailed = TRUE;
+        return 0;
+    }
+
     /* For 1st pass don't worry about size of writes between flushes */
 
     dst = SinkMap(sink);
@@ -139,15 +148,75 @@ uint16 UpgradeFWIFPartitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, ui
 
     memmove(dst, data, len);
 
-    if (!SinkFlushBlocking(sink, len))
+    if (wait)
+    {
+        if (!SinkFlushBlocking(sink, len))
+        {
+            PRINT(("UPG: Failed to flush data to partition: sink %p, len %d\n", (void *) sink, len));
+            UpgradeCtxGetFW()->writeFailed = TRUE;
+            return 0;
+        }
+    }
+    else if (!SinkFlush(sink, len) || !SinkIsValid(sink))
     {
-        PRINT(("UPG: Failed to flush data to partition: sink %p, len %d\n", (void *) sink, len));
+        PRINT(("UPG: Failed to start flush to partition: sink %p, len %d\n", (void *) sink, len));
+        UpgradeCtxGetFW()->writeFailed = TRUE;
         return 0;
     }
 
     return len;
 }
 
+/***************************************************************************
+NAME
+    UpgradeFWIFPartitionWrite
+
+DESCRIPTION
+    Write data to an open external flash partition. Each byte of the data
+    is copied to the partition in a byte by byte copy operation.
+
+PARAMS
+    handle Handle to a writeable partition.
+    data Pointer to the data to write.
+    len Number of bytes (not words) to write.
+
+RETURNS
+    uint16 The number of bytes written, or 0 if there was an error.
+*/
+uint16 UpgradeFWIFPartitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len)
+{
+    return partitionWrite(handle, data, len, TRUE);
+}
+
+/***************************************************************************
+NAME
+    UpgradeFWIFPartitionWriteBehind
+
+DESCRIPTION
+    Write data to an open external flash partition without waiting for the
+    flash write to finish, so the next block can be received meanwhile.
+    The sink is a FIFO, so only wait when it could not take another block
+    of the same size; that wait also covers the writes still in flight.
+    A write that fails after this returns is latched in the upgrade context
+    and reported by the next write to the partition, at the latest by the
+    blocking write of its last block.
+
+PARAMS
+    handle Handle to a writeable partition.
+    data Pointer to the data to write.
+    len Number of bytes (not words) to write.
+
+RETURNS
+    uint16 The number of bytes written, or 0 if there was an error.
+*/
+uint16 UpgradeFWIFPartitionWriteBehind(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len)
+{
+    Sink sink = (Sink)(int)handle;
+    bool wait = (SinkSlack(sink) < 2 * (uint32)len);
+
+    return partitionWrite(handle, data, len, wait);
+}
+
 /***************************************************************************
 NAME
     UpgradeFWIFValidateInit
@@ -530,8 +530,20 @@ RETURNS
 UpgradeHostErrorCode UpgradePartitionDataHandleDataState(uint8 *data, uint16 len, bool reqComplete)
 {
     UpgradePartitionDataCtx *ctx = UpgradeCtxGetPartitionData();
+    uint16 written;
 
-    if(len != UpgradeFWIFPartitionWrite(ctx->partitionHdl, data, len))
+    /* Let the flash write overlap with receiving the next block, except for
+     * the last block which must be in the partition before it is closed. */
+    if(reqComplete)
+    {
+        written = UpgradeFWIFPartitionWrite(ctx->partitionHdl, data, len);
+    }
+    else
+    {
+        written = UpgradeFWIFPartitionWriteBehind(ctx->partitionHdl, data, len);
+    }
+
+    if(len != written)
     {
         PRINT(("UpgradeFWIFPartitionWrite(%d) failed. partitionLength %ld, bigReqSize %ld\n",
             len, ctx->partitionLength, ctx->bigReqSize));
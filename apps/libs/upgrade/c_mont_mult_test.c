@@ -0,0 +1,466 @@
+/****************************************************************************
+Copyright (c) 2017 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    c_mont_mult_test.c
+
+DESCRIPTION
+    Host test harness for c_mont_mult and rsa_decrypt.
+
+    Known answers come from the key in CONFIG_HYDRACORE/private.pem,
+    for the RSA-2048 and F4 configuration of rsa_decrypt.h.
+    One Montgomery product of two fixed blocks is checked. Then a block
+    signed with the private key is checked to decrypt back to the original
+    block. c_mont_mult is also checked against a reference modular multiply
+    for random odd moduli and for edge-case operands. The reference is a
+    schoolbook product with a bit-serial reduction, so it shares no code
+    with the Montgomery loop.
+
+    It then times c_mont_mult and rsa_decrypt on the same operands. The
+    best of TIMING_RUNS runs is reported.
+
+    Build from this directory with the flags of the library build plus
+    -I../rsa_decrypt. It is not part of the library.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../rsa_decrypt/rsa_decrypt.c"
+#include "CONFIG_HYDRACORE/c_mont_mult.c"
+
+/* Random moduli and operand pairs checked against the reference */
+#define RANDOM_MODULI           20
+#define RANDOM_OPERANDS         10
+
+/* Calls per timing run, and runs of which the best is reported */
+#define TIMING_CALLS            2000
+#define TIMING_RUNS             10
+
+/* Modulus of CONFIG_HYDRACORE/private.pem */
+static const uint16 kat_modulus[RSA_SIGNATURE_SIZE] =
+{
+    0xc0ad, 0x829c, 0xea91, 0xa214, 0x5b86, 0x764b, 0xe053, 0x73d5,
+    0x75e8, 0x7735, 0x8fbb, 0xcd76, 0xb5c8, 0xf541, 0x23b8, 0x0087,
+    0xe4d5, 0xa80d, 0xe266, 0x07db, 0x5926, 0xf93f, 0xb174, 0xcbff,
+    0x71c4, 0x8f66, 0x2ec3, 0x5c5b, 0x343b, 0x9649, 0x6d73, 0xe520,
+    0x3df3, 0x44c4, 0xf929, 0x449b, 0x52cf, 0x9d7c, 0xa408, 0x3adb,
+    0x0984, 0x568c, 0x3372, 0x9146, 0x9ab0, 0x435c, 0x4361, 0xe755,
+    0xa7ed, 0x455e, 0x5ac9, 0x3a07, 0x1c11, 0x477c, 0x3e3f, 0x00e5,
+    0x04bd, 0xe401, 0x8abc, 0xb023, 0x6a08, 0x9f3e, 0xcf15, 0x95f1,
+    0x1fbf, 0x1ab4, 0x8b06, 0xee05, 0x0527, 0x9df0, 0x506b, 0x5e16,
+    0x6654, 0xf0a9, 0x336a, 0x66ca, 0x94b3, 0x25b0, 0xcb41, 0x1df3,
+    0xf25c, 0x00de, 0x126b, 0x7eb0, 0xe73d, 0x9d07, 0xa16c, 0xa1c8,
+    0x3a9f, 0x8156, 0x9922, 0x9141, 0x7ee7, 0x9faf, 0xadf0, 0x8f9f,
+    0xffa5, 0xc724, 0x135d, 0x88b3, 0x62b1, 0xc0ea, 0x57b4, 0x99b1,
+    0xb10c, 0x8294, 0xe6ee, 0xe8bd, 0x7467, 0xa84c, 0xb50b, 0xb85f,
+    0x7d57, 0x196f, 0x6f6a, 0xbe48, 0xd937, 0x7a8f, 0x5ad2, 0x06ba,
+    0x6079, 0xffef, 0x5231, 0xd589, 0x073e, 0x68d8, 0x6153, 0xe4e7
+};
+
+#define KAT_M_DASH 0x1129
+
+/* R^2 mod M, R = 2^2048 */
+static const uint16 kat_r2n[RSA_SIGNATURE_SIZE] =
+{
+    0x8bdb, 0xd984, 0x3aba, 0x6d2a, 0xfda9, 0x936f, 0x8c75, 0xf689,
+    0x2ae7, 0xb9eb, 0x9de8, 0xd9e9, 0x66eb, 0xf9b1, 0x58c8, 0x0272,
+    0x3410, 0xd09e, 0xf004, 0x76c0, 0x3a57, 0x64ff, 0x9ace, 0x3555,
+    0x849a, 0x0b38, 0x07ac, 0xa27d, 0xc4d5, 0x8ac9, 0xbb04, 0x0348,
+    0x07b1, 0xb5bf, 0x0908, 0x6ae9, 0x6774, 0x174b, 0xf88d, 0xa7c3,
+    0x9262, 0x7cc9, 0x15cf, 0x5902, 0x6f26, 0xae6d, 0xdacf, 0x722c,
+    0x602d, 0x91f1, 0xb260, 0xdc2d, 0xfaf0, 0xcf87, 0x4812, 0x9663,
+    0x7540, 0x7dbe, 0x8897, 0x5af9, 0xc53f, 0x5082, 0xcad3, 0x0058,
+    0xb3c5, 0x4499, 0x43ba, 0x62df, 0x1a71, 0x6025, 0x2f92, 0x0ffb,
+    0xb180, 0xa597, 0xbfbc, 0x5d1e, 0x656d, 0xcce2, 0xbee6, 0x92b1,
+    0xe2c4, 0x2ed7, 0xa465, 0x1445, 0xed80, 0x9f2b, 0x42a3, 0xc86f,
+    0x8db5, 0x994d, 0xa868, 0xa746, 0x2a57, 0x2f60, 0x8b86, 0x32a1,
+    0x4aa4, 0xd230, 0xba60, 0xf3a2, 0x5e83, 0x91e7, 0xbbfd, 0x7d98,
+    0xaccf, 0xe19d, 0x0ca5, 0x23c7, 0x20a0, 0x516d, 0xe261, 0xb984,
+    0x7921, 0xd220, 0x25ee, 0x6e7d, 0x1e87, 0x8e9d, 0x3c80, 0xc8cc,
+    0xdb27, 0x0abd, 0xc182, 0xd7af, 0x7a85, 0x1ee5, 0xeee1, 0x8c93
+};
+
+/* A message block */
+static const uint16 kat_message[RSA_SIGNATURE_SIZE] =
+{
+    0x0003, 0x0a11, 0x181f, 0x262d, 0x343b, 0x4249, 0x5057, 0x5e65,
+    0x6c73, 0x7a81, 0x888f, 0x969d, 0xa4ab, 0xb2b9, 0xc0c7, 0xced5,
+    0xdce3, 0xeaf1, 0xf8ff, 0x060d, 0x141b, 0x2229, 0x3037, 0x3e45,
+    0x4c53, 0x5a61, 0x686f, 0x767d, 0x848b, 0x9299, 0xa0a7, 0xaeb5,
+    0xbcc3, 0xcad1, 0xd8df, 0xe6ed, 0xf4fb, 0x0209, 0x1017, 0x1e25,
+    0x2c33, 0x3a41, 0x484f, 0x565d, 0x646b, 0x7279, 0x8087, 0x8e95,
+    0x9ca3, 0xaab1, 0xb8bf, 0xc6cd, 0xd4db, 0xe2e9, 0xf0f7, 0xfe05,
+    0x0c13, 0x1a21, 0x282f, 0x363d, 0x444b, 0x5259, 0x6067, 0x6e75,
+    0x7c83, 0x8a91, 0x989f, 0xa6ad, 0xb4bb, 0xc2c9, 0xd0d7, 0xdee5,
+    0xecf3, 0xfa01, 0x080f, 0x161d, 0x242b, 0x3239, 0x4047, 0x4e55,
+    0x5c63, 0x6a71, 0x787f, 0x868d, 0x949b, 0xa2a9, 0xb0b7, 0xbec5,
+    0xccd3, 0xdae1, 0xe8ef, 0xf6fd, 0x040b, 0x1219, 0x2027, 0x2e35,
+    0x3c43, 0x4a51, 0x585f, 0x666d, 0x747b, 0x8289, 0x9097, 0x9ea5,
+    0xacb3, 0xbac1, 0xc8cf, 0xd6dd, 0xe4eb, 0xf2f9, 0x0007, 0x0e15,
+    0x1c23, 0x2a31, 0x383f, 0x464d, 0x545b, 0x6269, 0x7077, 0x7e85,
+    0x8c93, 0x9aa1, 0xa8af, 0xb6bd, 0xc4cb, 0xd2d9, 0xe0e7, 0xeef5
+};
+
+/* The message block raised to the private exponent */
+static const uint16 kat_signature[RSA_SIGNATURE_SIZE] =
+{
+    0x2632, 0xaed8, 0x8425, 0xfc57, 0x0c2a, 0xc527, 0x31a6, 0x1e62,
+    0x5527, 0x5c89, 0x153e, 0xb232, 0x15ca, 0x0ebe, 0x4e0b, 0x9c58,
+    0x7f3e, 0x0fb6, 0x9e99, 0x0aa4, 0x0dd4, 0x4898, 0xdbfd, 0xd7a7,
+    0xa93f, 0xd64e, 0x5055, 0x89c2, 0x85db, 0xaa7b, 0x550f, 0x3919,
+    0x7aab, 0x76eb, 0xb25b, 0xf05c, 0xb8f9, 0x2540, 0xdfb6, 0x7c4a,
+    0xf023, 0x6562, 0x71a3, 0xcfc2, 0x722f, 0x2e58, 0xada6, 0x0e4e,
+    0x83c4, 0x8bb6, 0xf953, 0x067c, 0x555b, 0x0884, 0xbc26, 0x1192,
+    0x54d4, 0xc38b, 0x450b, 0xc3a2, 0x0eb3, 0x8d6d, 0x1f80, 0x192e,
+    0x31e5, 0x32d6, 0xdcd5, 0x5e46, 0xbdc4, 0x769a, 0xb061, 0x7054,
+    0xab79, 0xcab1, 0x6e6b, 0x0a3a, 0xc666, 0x34e5, 0x8d53, 0x48eb,
+    0xb209, 0xddfa, 0x9d3b, 0xeb4b, 0x3328, 0x1be6, 0x519b, 0x2caf,
+    0x2d92, 0x3751, 0x45a6, 0x3d95, 0xe1fc, 0xcdaf, 0x8489, 0xbc9e,
+    0x957d, 0x7f6e, 0x1996, 0xe670, 0x8c75, 0x3c21, 0x378d, 0xf6fb,
+    0xbd66, 0x8e41, 0xdad7, 0x407c, 0x00c0, 0xe8c6, 0x0b47, 0xe61e,
+    0x4f16, 0xb886, 0xb325, 0x3d5f, 0xeee1, 0xe676, 0x354f, 0xacd2,
+    0x41e0, 0xea4f, 0xf973, 0xc709, 0xb515, 0xce17, 0xf726, 0x1b11
+};
+
+/* kat_message * kat_signature * R^-1 mod M */
+static const uint16 kat_product[RSA_SIGNATURE_SIZE] =
+{
+    0x55c5, 0xf6b4, 0x5978, 0x0bfb, 0x0745, 0x9cbf, 0xa14f, 0x7ca1,
+    0x9b01, 0x78ff, 0xba50, 0xeb7a, 0xcfbf, 0x0f68, 0x5705, 0x0635,
+    0xd651, 0x2296, 0x03de, 0x9789, 0x1643, 0xbe15, 0xdc3f, 0xf03c,
+    0x380b, 0x1649, 0xf577, 0x9c44, 0xf41e, 0x1d6c, 0x4ca1, 0x68cc,
+    0xa244, 0x36a9, 0xad07, 0xe66d, 0xd66a, 0x796d, 0x9913, 0x6cbd,
+    0xc01d, 0x7be3, 0x5d2f, 0x298e, 0xc900, 0x4103, 0x1436, 0xa330,
+    0x6ea9, 0xef8c, 0xbe9b, 0xf03a, 0x5107, 0xb339, 0x178b, 0x134e,
+    0xd98d, 0xd0f4, 0x7a52, 0x9d02, 0x0c2b, 0x06d5, 0x6081, 0x13eb,
+    0xf4f0, 0x21d4, 0xbffc, 0x8ce5, 0x2b45, 0xc62e, 0x3c27, 0xe450,
+    0x95ab, 0x1c0a, 0x30f0, 0x3def, 0xff3a, 0x14df, 0x981b, 0xee67,
+    0x01f0, 0xbff2, 0x1757, 0x61ef, 0xcbf3, 0x02f3, 0xcafb, 0xe37d,
+    0xe241, 0x35b4, 0xa1f2, 0xa1bf, 0xb975, 0x665a, 0x0c03, 0xc20e,
+    0xe85d, 0x0012, 0x97c5, 0x0f14, 0x42e5, 0x4e3d, 0x7897, 0x6fdb,
+    0x40c7, 0xff14, 0xd1d2, 0x7769, 0x4d6e, 0x52a2, 0x51f7, 0x701a,
+    0xf96d, 0x3435, 0xebc4, 0xbaf2, 0xc2b4, 0xce67, 0xe5f9, 0xa913,
+    0x8c96, 0x88d0, 0x0914, 0x6feb, 0x3c1c, 0x8435, 0x4b70, 0xdf0c
+};
+
+/****************************************************************************
+    Reference arithmetic. Numbers are big endian arrays of 16-bit words,
+    as c_mont_mult uses them.
+*/
+
+/* r = r - m over n words, returns the borrow */
+static unsigned ref_sub(uint16 *r, const uint16 *m, unsigned n)
+{
+    uint32 borrow = 0;
+    unsigned i;
+
+    for (i = n; i-- > 0;)
+    {
+        uint32 d = (uint32)r[i] - m[i] - borrow;
+        r[i] = (uint16)d;
+        borrow = (d >> 16) & 1;
+    }
+    return borrow;
+}
+
+/* TRUE if the n word a is less than the n word m */
+static bool ref_less(const uint16 *a, const uint16 *m, unsigned n)
+{
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        if (a[i] != m[i])
+            return a[i] < m[i];
+    }
+    return FALSE;
+}
+
+/* TRUE if the n+1 word r is at least the n word m */
+static bool ref_not_less(const uint16 *r, const uint16 *m, unsigned n)
+{
+    unsigned i;
+
+    if (r[0] != 0)
+        return TRUE;
+    for (i = 0; i < n; i++)
+    {
+        if (r[i + 1] != m[i])
+            return r[i + 1] > m[i];
+    }
+    return TRUE;
+}
+
+/* r = x mod m, for x of xn words, by shifting x in one bit at a time */
+static void ref_mod(uint16 r[RSA_SIGNATURE_SIZE], const uint16 *x, unsigned xn,
+                    const uint16 m[RSA_SIGNATURE_SIZE])
+{
+    uint16 acc[RSA_SIGNATURE_SIZE + 1];
+    unsigned bit, i;
+
+    memset(acc, 0, sizeof(acc));
+    for (bit = 0; bit < xn * 16; bit++)
+    {
+        unsigned in = (x[bit / 16] >> (15 - bit % 16)) & 1;
+
+        for (i = 0; i < RSA_SIGNATURE_SIZE; i++)
+            acc[i] = (uint16)((acc[i] << 1) | (acc[i + 1] >> 15));
+        acc[RSA_SIGNATURE_SIZE] = (uint16)((acc[RSA_SIGNATURE_SIZE] << 1) | in);
+        if (ref_not_less(acc, m, RSA_SIGNATURE_SIZE))
+        {
+            acc[0] -= (uint16)ref_sub(acc + 1, m, RSA_SIGNATURE_SIZE);
+        }
+    }
+    memcpy(r, acc + 1, sizeof(uint16) * RSA_SIGNATURE_SIZE);
+}
+
+/* r = a * b mod m */
+static void ref_mul_mod(uint16 r[RSA_SIGNATURE_SIZE], const uint16 *a, const uint16 *b,
+                        const uint16 m[RSA_SIGNATURE_SIZE])
+{
+    uint16 product[2 * RSA_SIGNATURE_SIZE];
+    unsigned i, j;
+
+    memset(product, 0, sizeof(product));
+    for (i = RSA_SIGNATURE_SIZE; i-- > 0;)
+    {
+        uint32 carry = 0;
+
+        for (j = RSA_SIGNATURE_SIZE; j-- > 0;)
+        {
+            uint32 t = (uint32)a[i] * b[j] + product[i + j + 1] + carry;
+            product[i + j + 1] = (uint16)t;
+            carry = t >> 16;
+        }
+        product[i] = (uint16)carry;
+    }
+    ref_mod(r, product, 2 * RSA_SIGNATURE_SIZE, m);
+}
+
+/* Checks that c = a * b * R^-1 mod m, that is c * R = a * b mod m */
+static bool ref_check(const uint16 *c, const uint16 *a, const uint16 *b,
+                      const uint16 m[RSA_SIGNATURE_SIZE])
+{
+    uint16 shifted[2 * RSA_SIGNATURE_SIZE];
+    uint16 left[RSA_SIGNATURE_SIZE], right[RSA_SIGNATURE_SIZE];
+
+    memcpy(shifted, c, sizeof(uint16) * RSA_SIGNATURE_SIZE);
+    memset(shifted + RSA_SIGNATURE_SIZE, 0, sizeof(uint16) * RSA_SIGNATURE_SIZE);
+    ref_mod(left, shifted, 2 * RSA_SIGNATURE_SIZE, m);
+    ref_mul_mod(right, a, b, m);
+    return memcmp(left, right, sizeof(left)) == 0
+        && ref_less(c, m, RSA_SIGNATURE_SIZE);
+}
+
+/****************************************************************************
+    Operands
+*/
+static uint32 rand_state = 0x12345678;
+
+static uint16 rand16(void)
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return (uint16)(rand_state >> 8);
+}
+
+/* An odd modulus. Every other one has a short top word, so that the final
+   subtraction is taken more often. */
+static void random_modulus(rsa_mod_t *mod, unsigned index)
+{
+    uint16 inverse;
+    unsigned i;
+
+    for (i = 0; i < RSA_SIGNATURE_SIZE; i++)
+        mod->M[i] = rand16();
+    mod->M[0] = (index & 1) ? (uint16)(mod->M[0] & 0x00ff) | 1 : mod->M[0] | 0x8000;
+    mod->M[RSA_SIGNATURE_SIZE - 1] |= 1;
+
+    /* Newton's iteration for M^-1 mod 2^16 */
+    inverse = mod->M[RSA_SIGNATURE_SIZE - 1];
+    for (i = 0; i < 4; i++)
+        inverse = (uint16)(inverse * (2 - mod->M[RSA_SIGNATURE_SIZE - 1] * inverse));
+    mod->M_dash = (uint16)-inverse;
+}
+
+/* Operand k of a set: 0, 1, M - 1, then random values below M */
+static void operand(uint16 x[RSA_SIGNATURE_SIZE], const rsa_mod_t *mod, unsigned k)
+{
+    unsigned i;
+
+    memset(x, 0, sizeof(uint16) * RSA_SIGNATURE_SIZE);
+    switch (k)
+    {
+        case 0:
+            break;
+        case 1:
+            x[RSA_SIGNATURE_SIZE - 1] = 1;
+            break;
+        case 2:
+            memcpy(x, mod->M, sizeof(uint16) * RSA_SIGNATURE_SIZE);
+            x[RSA_SIGNATURE_SIZE - 1]--;
+            break;
+        default:
+            {
+                uint16 r[RSA_SIGNATURE_SIZE];
+
+                for (i = 0; i < RSA_SIGNATURE_SIZE; i++)
+                    r[i] = rand16();
+                ref_mod(x, r, RSA_SIGNATURE_SIZE, mod->M);
+            }
+            break;
+    }
+}
+
+/****************************************************************************
+    Tests
+*/
+static unsigned test_known_answers(void)
+{
+    rsa_mod_t mod;
+    uint16 a[RSA_SIGNATURE_SIZE], start[RSA_SIGNATURE_SIZE];
+    unsigned failures = 0;
+
+    memcpy(mod.M, kat_modulus, sizeof(mod.M));
+    mod.M_dash = KAT_M_DASH;
+
+    memcpy(a, kat_message, sizeof(a));
+    c_mont_mult(a, kat_signature, &mod);
+    if (memcmp(a, kat_product, sizeof(a)) != 0)
+    {
+        printf("FAIL: known Montgomery product\n");
+        failures++;
+    }
+
+    memcpy(start, kat_signature, sizeof(start));
+    memcpy(a, kat_r2n, sizeof(a));
+    rsa_decrypt(start, &mod, a);
+    if (memcmp(start, kat_message, sizeof(start)) != 0)
+    {
+        printf("FAIL: signature does not decrypt to the signed block\n");
+        failures++;
+    }
+    return failures;
+}
+
+static unsigned test_reference(void)
+{
+    rsa_mod_t mod;
+    unsigned m, k, failures = 0, checks = 0;
+
+    for (m = 0; m < RANDOM_MODULI; m++)
+    {
+        random_modulus(&mod, m);
+        for (k = 0; k < RANDOM_OPERANDS; k++)
+        {
+            uint16 a[RSA_SIGNATURE_SIZE], b[RSA_SIGNATURE_SIZE];
+            uint16 c[RSA_SIGNATURE_SIZE];
+
+            operand(a, &mod, k);
+            operand(b, &mod, (k + 3) % RANDOM_OPERANDS);
+
+            /* Multiply */
+            memcpy(c, a, sizeof(c));
+            c_mont_mult(c, b, &mod);
+            if (!ref_check(c, a, b, mod.M))
+            {
+                printf("FAIL: modulus %u, operands %u: product differs from the reference\n", m, k);
+                failures++;
+            }
+
+            /* Square in place, as rsa_decrypt does */
+            memcpy(c, a, sizeof(c));
+            c_mont_mult(c, c, &mod);
+            if (!ref_check(c, a, a, mod.M))
+            {
+                printf("FAIL: modulus %u, operand %u: square differs from the reference\n", m, k);
+                failures++;
+            }
+            checks += 2;
+        }
+    }
+    printf("%u products and squares checked against the reference\n", checks);
+    return failures;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Time per call of a run of calls, of mult or, without mult, of
+   rsa_decrypt */
+static double time_per_call(void (*mult)(uint16 *, const uint16 *, const rsa_mod_t *),
+                            const rsa_mod_t *mod, unsigned calls)
+{
+    uint16 a[RSA_SIGNATURE_SIZE], start[RSA_SIGNATURE_SIZE];
+    double t;
+    unsigned i;
+
+    memcpy(a, kat_message, sizeof(a));
+    t = now_ns();
+    for (i = 0; i < calls; i++)
+    {
+        if (mult != NULL)
+        {
+            mult(a, kat_signature, mod);
+        }
+        else
+        {
+            memcpy(start, kat_signature, sizeof(start));
+            memcpy(a, kat_r2n, sizeof(a));
+            rsa_decrypt(start, mod, a);
+        }
+    }
+    return (now_ns() - t) / calls;
+}
+
+/* The runs of each function are interleaved so that they see the same
+   machine load. */
+static void time_calls(void)
+{
+    rsa_mod_t mod;
+    double mult = 0, decrypt = 0;
+    unsigned run;
+
+    memcpy(mod.M, kat_modulus, sizeof(mod.M));
+    mod.M_dash = KAT_M_DASH;
+
+    for (run = 0; run < TIMING_RUNS; run++)
+    {
+        double t;
+
+        t = time_per_call(c_mont_mult, &mod, TIMING_CALLS);
+        mult = (run == 0 || t < mult) ? t : mult;
+        t = time_per_call(NULL, &mod, TIMING_CALLS / 20);
+        decrypt = (run == 0 || t < decrypt) ? t : decrypt;
+    }
+
+    printf("\nc_mont_mult: %8.0f ns\n", mult);
+    printf("rsa_decrypt: %8.0f ns\n", decrypt);
+}
+
+int main(void)
+{
+    unsigned failures = 0;
+
+    failures += test_known_answers();
+    failures += test_reference();
+    time_calls();
+
+    if (failures != 0)
+    {
+        printf("\n%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
@@ -0,0 +1,392 @@
+/****************************************************************************
+Copyright (c) 2017 Qualcomm Technologies International, Ltd.
+
+
+FILE NAME
+    main.c
+
+DESCRIPTION
+    Host timing harness for partition writes. Writes an image through
+    UpgradeFWIFPartitionWrite and UpgradeFWIFPartitionWriteBehind, the way
+    UpgradePartitionDataHandleDataState does, into a partition sink backed
+    by a temporary file.
+
+    The sink models the image upgrade stream. It has a FIFO of
+    SINK_BUFFER_SIZE bytes that drains into the file at the flash write
+    rate, on a simulated clock. Blocks arrive over the link at the link
+    rate, one at a time after a request or PREFETCH_UPGRADE_BLOCKS ahead,
+    as the host does with multiple block requests. The harness
+    reports how long the image takes when every block waits for the flash
+    and when only the last block waits. It then checks that the file
+    matches the image.
+
+    It also fails the flash part way through the image, closing the sink
+    as the firmware does. It checks that the failure is reported by a
+    later write, at most a sink's worth of blocks later. It also checks
+    that the failure is latched so the partition is not closed, and that
+    the partition is not reported complete.
+
+    Usage: upgrade [image]
+    Without an image, a 128K pattern is written. Build from this directory
+    with the flags of the library build plus -ICONFIG_HYDRACORE -I../print
+    -I../rsa_decrypt -I../byte_utils -I../rsa_pss_constants and
+    -Wl,--gc-sections -ffunction-sections, so the validation code it does
+    not call need not link. It is not part of the library.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <sink.h>
+
+#include "upgrade_ctx.h"
+#include "upgrade_fw_if.h"
+#include "upgrade_partition_data_priv.h"
+
+#include "CONFIG_HYDRACORE/upgrade_fw_if_config.c"
+
+/* Bytes the partition sink can hold while the flash writes them */
+#define SINK_BUFFER_SIZE        1024
+
+/* Size of the blocks the host sends */
+#define BLOCK_SIZE              240
+
+/* Size of the pattern written without an image */
+#define PATTERN_SIZE            (128 * 1024)
+
+/* The only partition sink */
+#define PARTITION_SINK          ((Sink)(int)1)
+
+typedef struct
+{
+    const char *name;
+    double link_us_per_byte;
+    double flash_us_per_byte;
+    uint32 blocks_ahead;            /* blocks the host may send unrequested */
+    double request_us;              /* until the host sends a requested block */
+} scenario_t;
+
+/* LE at about 60K/s with a 15ms connection interval, BR/EDR at about
+   180K/s. The flash programs about 250K/s, or 90K/s when it also erases. */
+static const scenario_t scenarios[] =
+{
+    { "LE, one block",          16.0,   4.0,    1,                          15000 },
+    { "LE, prefetch",           16.0,  11.0,    PREFETCH_UPGRADE_BLOCKS,    15000 },
+    { "BR/EDR, one block",       5.5,   4.0,    1,                           2500 },
+    { "BR/EDR, prefetch",        5.5,   4.0,    PREFETCH_UPGRADE_BLOCKS,     2500 },
+    { "BR/EDR, erasing",         5.5,  11.0,    1,                           2500 },
+    { "BR/EDR, erasing, prefetch", 5.5, 11.0,   PREFETCH_UPGRADE_BLOCKS,     2500 },
+};
+
+/* Simulated partition sink */
+static struct
+{
+    FILE *file;
+    uint8 staging[SINK_BUFFER_SIZE];
+    uint8 fifo[SINK_BUFFER_SIZE];
+    uint16 head;                    /* next byte to write to the flash */
+    uint16 queued;                  /* bytes waiting for the flash */
+    uint16 claimed;
+    uint32 written;                 /* bytes in the flash */
+    uint32 fail_at;                 /* flash fails at this offset */
+    bool valid;
+    double now;                     /* simulated time, us */
+    double flash_time;              /* time the flash has written up to */
+    double flash_us_per_byte;
+    unsigned waits;                 /* blocking flushes */
+} sink;
+
+static UpgradeFWIFCtx fw_ctx;
+
+UpgradeFWIFCtx *UpgradeCtxGetFW(void)
+{
+    return &fw_ctx;
+}
+
+/* Let the flash write what it can by the current time */
+static void flashRun(void)
+{
+    while (sink.valid && sink.queued != 0
+           && sink.flash_time + sink.flash_us_per_byte <= sink.now + 1e-6)
+    {
+        if (sink.written == sink.fail_at)
+        {
+            sink.valid = FALSE;
+            sink.queued = 0;
+            break;
+        }
+        fputc(sink.fifo[sink.head], sink.file);
+        sink.head = (sink.head + 1) % SINK_BUFFER_SIZE;
+        sink.queued--;
+        sink.written++;
+        sink.flash_time += sink.flash_us_per_byte;
+    }
+}
+
+static void sinkQueue(uint16 amount)
+{
+    uint16 tail = (sink.head + sink.queued) % SINK_BUFFER_SIZE;
+    uint16 i;
+
+    for (i = 0; i < amount; i++)
+    {
+        sink.fifo[(tail + i) % SINK_BUFFER_SIZE] = sink.staging[i];
+    }
+    if (sink.queued == 0)
+    {
+        sink.flash_time = sink.now;
+    }
+    sink.queued += amount;
+    sink.claimed = 0;
+}
+
+uint8 *SinkMap(Sink s)
+{
+    return (s == PARTITION_SINK && sink.valid) ? sink.staging : NULL;
+}
+
+uint16 SinkClaim(Sink s, uint16 extra)
+{
+    flashRun();
+    if (s != PARTITION_SINK || !sink.valid
+        || sink.queued + sink.claimed + extra > SINK_BUFFER_SIZE)
+    {
+        return 0xFFFF;
+    }
+    sink.claimed += extra;
+    return sink.claimed - extra;
+}
+
+uint16 SinkSlack(Sink s)
+{
+    flashRun();
+    if (s != PARTITION_SINK || !sink.valid)
+    {
+        return 0;
+    }
+    return SINK_BUFFER_SIZE - sink.queued - sink.claimed;
+}
+
+bool SinkIsValid(Sink s)
+{
+    flashRun();
+    return s == PARTITION_SINK && sink.valid;
+}
+
+bool SinkFlush(Sink s, uint16 amount)
+{
+    flashRun();
+    if (s != PARTITION_SINK || !sink.valid || amount > sink.claimed)
+    {
+        return FALSE;
+    }
+    sinkQueue(amount);
+    return TRUE;
+}
+
+bool SinkFlushBlocking(Sink s, uint16 amount)
+{
+    if (!SinkFlush(s, amount))
+    {
+        return FALSE;
+    }
+    sink.waits++;
+    while (sink.valid && sink.queued != 0)
+    {
+        sink.now += sink.queued * sink.flash_us_per_byte;
+        flashRun();
+    }
+    return sink.valid;
+}
+
+typedef struct
+{
+    double elapsed_us;
+    unsigned waits;
+    int failed_block;               /* block a write failed on, -1 if none */
+    bool complete;                  /* last block written */
+    bool matches;                   /* file matches the image */
+    bool latched;                   /* the failure is latched for the close */
+} result_t;
+
+/* Write the image a block at a time, as the partition data state does */
+static result_t writeImage(const scenario_t *scenario, const uint8 *image, uint32 size,
+                           bool write_behind, uint32 fail_at)
+{
+    uint32 blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    double *handled = calloc(blocks, sizeof(double));
+    double arrived = 0;
+    result_t result;
+    uint32 i;
+
+    memset(&result, 0, sizeof(result));
+    result.failed_block = -1;
+
+    memset(&sink, 0, sizeof(sink));
+    sink.file = tmpfile();
+    sink.valid = TRUE;
+    sink.fail_at = fail_at;
+    sink.flash_us_per_byte = scenario->flash_us_per_byte;
+    memset(&fw_ctx, 0, sizeof(fw_ctx));
+
+    if (!handled || !sink.file)
+    {
+        printf("FAIL: out of memory\n");
+        exit(1);
+    }
+
+    for (i = 0; i < blocks; i++)
+    {
+        uint16 len = (uint16)((i == blocks - 1) ? size - i * BLOCK_SIZE : BLOCK_SIZE);
+        bool last = (i == blocks - 1);
+        uint16 written;
+        double requested = (i < scenario->blocks_ahead) ? 0
+                         : handled[i - scenario->blocks_ahead] + scenario->request_us;
+
+        /* The link sends one block at a time, once the block is requested */
+        arrived = (arrived > requested ? arrived : requested) + len * scenario->link_us_per_byte;
+        if (sink.now < arrived)
+        {
+            sink.now = arrived;
+        }
+
+        if (write_behind && !last)
+        {
+            written = UpgradeFWIFPartitionWriteBehind(PARTITION_SINK, (uint8 *)&image[i * BLOCK_SIZE], len);
+        }
+        else
+        {
+            written = UpgradeFWIFPartitionWrite(PARTITION_SINK, (uint8 *)&image[i * BLOCK_SIZE], len);
+        }
+        handled[i] = sink.now;
+
+        if (written != len)
+        {
+            result.failed_block = (int)i;
+            break;
+        }
+        result.complete = last;
+    }
+
+    result.latched = fw_ctx.writeFailed;
+    result.elapsed_us = sink.now;
+    result.waits = sink.waits;
+
+    if (result.complete)
+    {
+        uint8 buffer[BLOCK_SIZE];
+        uint32 offset = 0;
+        size_t n;
+
+        result.matches = (sink.written == size);
+        rewind(sink.file);
+        while (result.matches && (n = fread(buffer, 1, sizeof(buffer), sink.file)) != 0)
+        {
+            result.matches = (memcmp(buffer, &image[offset], n) == 0);
+            offset += n;
+        }
+    }
+
+    fclose(sink.file);
+    free(handled);
+    return result;
+}
+
+static uint8 *readImage(const char *name, uint32 *size)
+{
+    uint8 *image;
+    uint32 i;
+
+    if (name)
+    {
+        FILE *f = fopen(name, "rb");
+        long len;
+
+        if (!f || fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) <= 0)
+        {
+            return NULL;
+        }
+        rewind(f);
+        image = malloc(len);
+        if (image && fread(image, 1, len, f) != (size_t)len)
+        {
+            free(image);
+            image = NULL;
+        }
+        fclose(f);
+        *size = (uint32)len;
+        return image;
+    }
+
+    image = malloc(PATTERN_SIZE);
+    for (i = 0; image && i < PATTERN_SIZE; i++)
+    {
+        image[i] = (uint8)(i * 7 + (i >> 8));
+    }
+    *size = PATTERN_SIZE;
+    return image;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned failures = 0;
+    uint32 size;
+    uint8 *image = readImage(argc > 1 ? argv[1] : NULL, &size);
+    unsigned i;
+
+    if (!image)
+    {
+        printf("Usage: upgrade [image]\n");
+        return 1;
+    }
+
+    printf("%lu bytes in blocks of %u, sink of %u bytes\n\n",
+           (unsigned long)size, BLOCK_SIZE, SINK_BUFFER_SIZE);
+
+    for (i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        const scenario_t *scenario = &scenarios[i];
+        result_t blocking = writeImage(scenario, image, size, FALSE, 0xFFFFFFFF);
+        result_t behind = writeImage(scenario, image, size, TRUE, 0xFFFFFFFF);
+        result_t failing = writeImage(scenario, image, size, TRUE, size / 3);
+
+        printf("%-26s blocking %6.0f ms, write behind %6.0f ms (%4.1f%% faster, %3u of %3u blocks waited)",
+               scenario->name, blocking.elapsed_us / 1000, behind.elapsed_us / 1000,
+               100.0 * (blocking.elapsed_us - behind.elapsed_us) / blocking.elapsed_us,
+               behind.waits, blocking.waits);
+        printf(", failure at %lu reported at block %d\n",
+               (unsigned long)(size / 3), failing.failed_block);
+
+        if (!blocking.complete || !blocking.matches || !behind.complete || !behind.matches)
+        {
+            printf("FAIL: %s: partition does not match the image\n", scenario->name);
+            failures++;
+        }
+        if (behind.elapsed_us > blocking.elapsed_us * 1.001)
+        {
+            printf("FAIL: %s: write behind is slower\n", scenario->name);
+            failures++;
+        }
+        /* Reported by the first write after the flash fails, at most a
+           sink's worth of blocks later */
+        if (failing.complete || !failing.latched || failing.failed_block < 0
+            || (uint32)failing.failed_block * BLOCK_SIZE < size / 3
+            || (uint32)failing.failed_block * BLOCK_SIZE > size / 3 + SINK_BUFFER_SIZE + BLOCK_SIZE)
+        {
+            printf("FAIL: %s: flash failure not reported\n", scenario->name);
+            failures++;
+        }
+    }
+
+    free(image);
+
+    if (failures != 0)
+    {
+        printf("\n%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
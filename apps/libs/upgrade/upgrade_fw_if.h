@@ -176,6 +176,24 @@ UpgradeFWIFPartitionHdl UpgradeFWIFPartitionOpen(uint16 logic,uint16 physPartiti
 */
 uint16 UpgradeFWIFPartitionWrite(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len);
 
+/*!
+    @brief Write data to an open external flash partition without waiting
+           for the write to complete, unless the partition cannot accept
+           another block of the same size.
+
+    A later UpgradeFWIFPartitionWrite() on the same handle returns only once
+    all earlier data has been written, so use it for the last block before
+    closing the partition. A write that fails after this call returns is
+    reported by the next write, and UpgradeFWIFPartitionClose() then fails.
+
+    @param handle Handle to a writeable partition.
+    @param data Pointer to the data buffer to write.
+    @param len Number of bytes (not words) to write.
+
+    @return The number of bytes written, or 0 if there was an error.
+*/
+uint16 UpgradeFWIFPartitionWriteBehind(UpgradeFWIFPartitionHdl handle, uint8 *data, uint16 len);
+
 /*!
     @brief Close a handle to an external flash partition.
 
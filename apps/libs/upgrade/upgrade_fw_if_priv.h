@@ -27,6 +27,13 @@ typedef struct
 
     uint16 partitionNum;
 
+    /*
+     * Set when a write to the open partition has failed, possibly after
+     * UpgradeFWIFPartitionWriteBehind() returned. Every later write to the
+     * partition then fails too. Cleared when a partition is opened.
+     */
+    bool writeFailed;
+
 } UpgradeFWIFCtx;
 
 #endif /* UPGRADE_FW_IF_PRIV_H_ */
@@ -0,0 +1,905 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  rtp_decode_host_test.c
+ * \ingroup rtp_decode
+ *
+ * Host test of the packed output path of rtp_decode. <br>
+ *
+ * Builds rtp_decode.c, sample_count.c and unpack_cbuff_to_array.c as a
+ * DESKTOP_TEST_BUILD. The cbuffer, metadata and TTP calls they make are
+ * replaced by small octet models. The operator is set up through
+ * rtp_decode_create and rtp_decode_connect in RTP_DECODE mode, with
+ * pack_latency_buffer set, and is fed a recorded SBC RTP stream. Every
+ * kick delivers a burst of packets, as far as the input has space, and
+ * the output is drained after it, as the decoder would. Bursts of 64
+ * packets overrun the frame buffer and the output within one kick.
+ *
+ * The old copy path emptied the internal buffers after every packet. That
+ * is exactly what the current code does when each kick sees a single
+ * packet, so bursts of 1 are the reference. Larger bursts must give the
+ * same output octets and the same output tags, and the octets must be the
+ * SBC frames of the stream. The time per packet and the copies and
+ * metadata transports per packet are reported for each burst size.
+ * A kick that loses sync after two good packets must still pass those
+ * packets on, and a kick that finds less than 4 octets of space in the
+ * frame buffer must leave the input alone. Returns non-zero on any
+ * failure.
+ *
+ * Build from this directory with
+ *     cc -O2 -fno-strict-aliasing -DDESKTOP_TEST_BUILD -DINSTALL_METADATA
+ *        -DINSTALL_CBUFFER_EX -DOS_OXYGOS -DDAWTH=32 -DLOG2_ADDR_PER_WORD=2
+ *        -DADDR_PER_WORD=4 -I.. -I../.. -I../../common
+ *        -I../../base_op -I../../../components
+ *        -I../../../components/common/interface
+ *        -I../../../components/common -I../../../components/buffer
+ *        -I../../../components/hal -I../../../components/adaptor
+ *        -I../../../components/aov -I../../../components/hydra_modules
+ *        -I../../../components/hydra_modules/hydra
+ *        -I../../../components/hydra_modules/hydra_adaption
+ *        -I../../../support_lib -I../../../common/interface
+ *        -I../../../common/interface/gen/k32 -I../../../../lib/audio_fadeout
+ *        -I../../../output/stre_rom_v02_release/gen -ffunction-sections
+ *        -Wl,--gc-sections rtp_decode_host_test.c
+ * and run it as
+ *     ./a.out [file]
+ * where file defaults to the KSE RTP SBC resource.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../rtp_decode.c"
+#include "../sample_count.c"
+#include "../unpack_cbuff_to_array.c"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define DEFAULT_FILE        "../../../../../kse/resource/153_Prompts_176.4_kHz_Music_Detected_48k_rtp.sbc"
+
+/* Size of each packet in the resource, see kse/config/rtp_sbc_decoder.cfg.json */
+#define PACKET_SIZE         85
+
+/* Input and output buffer sizes, in words */
+#define IP_BUFFER_WORDS     4096
+#define OP_BUFFER_WORDS     1024
+
+/* Time between packets and the latency the TTP model adds, in us */
+#define PACKET_INTERVAL     1500
+#define TTP_LATENCY         150000
+
+#define MAX_BUFFERS         8
+#define TIMING_PASSES       20
+#define MAX_OUTPUT_TAGS     20000
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/* Octet model of a cbuffer. Read and write positions are absolute octet
+ * counts, tags carry absolute positions in their index. */
+typedef struct
+{
+    tCbuffer cb;
+    uint8 *data;
+    unsigned words;
+    unsigned usable;
+    unsigned rd;
+    unsigned wr;
+} host_buffer;
+
+typedef struct
+{
+    unsigned position;
+    unsigned length;
+    unsigned timestamp;
+    unsigned flags;
+    int sp_adjust;
+} output_tag;
+
+typedef struct
+{
+    uint8 *octets;
+    unsigned num_octets;
+    output_tag *tags;
+    unsigned num_tags;
+    unsigned copies;
+    unsigned transports;
+    double ns;
+} output_record;
+
+/****************************************************************************
+Private Variable Definitions
+*/
+static host_buffer buffers[MAX_BUFFERS];
+static unsigned num_buffers;
+static RTP_DECODE_OP_DATA opx;
+static OPERATOR_DATA op_data;
+static unsigned copies, transports;
+static bool ttp_started;
+
+/****************************************************************************
+Buffer and metadata models
+*/
+
+static host_buffer *host(tCbuffer *cb)
+{
+    return (host_buffer *)cb;
+}
+
+static unsigned size_octets(host_buffer *b)
+{
+    return b->words * b->usable;
+}
+
+static tCbuffer *new_buffer(int *base, unsigned words, unsigned flags)
+{
+    host_buffer *b = &buffers[num_buffers++];
+
+    memset(b, 0, sizeof(*b));
+    b->words = words;
+    b->usable = 2;
+    b->data = (uint8 *)base;
+    if (b->data == NULL)
+    {
+        b->data = calloc(words, 4);
+    }
+    b->cb.size = words;
+    b->cb.base_addr = (int *)b->data;
+    b->cb.read_ptr = b->cb.base_addr;
+    b->cb.write_ptr = b->cb.base_addr;
+    b->cb.descriptor = flags;
+    return &b->cb;
+}
+
+tCbuffer *cbuffer_create(void *cbuffer_data_ptr, unsigned int buffer_size, unsigned int descriptor)
+{
+    return new_buffer(cbuffer_data_ptr, buffer_size, descriptor);
+}
+
+tCbuffer *cbuffer_create_with_malloc(unsigned int buffer_size, unsigned int descriptor)
+{
+    return new_buffer(NULL, buffer_size, descriptor);
+}
+
+unsigned int cbuffer_get_size_in_words(tCbuffer *cbuffer)
+{
+    return host(cbuffer)->words;
+}
+
+void cbuffer_set_usable_octets(tCbuffer *buff, unsigned usable_octets)
+{
+    host(buff)->usable = usable_octets;
+}
+
+unsigned cbuffer_get_usable_octets(tCbuffer *buff)
+{
+    return host(buff)->usable;
+}
+
+unsigned int cbuffer_calc_amount_data_ex(tCbuffer *cbuffer)
+{
+    return host(cbuffer)->wr - host(cbuffer)->rd;
+}
+
+/* One word is always left free. An in-place buffer is bounded by the read
+ * position of the buffer it writes ahead of. */
+unsigned int cbuffer_calc_amount_space_ex(tCbuffer *cbuffer)
+{
+    host_buffer *b = host(cbuffer);
+    unsigned rd = b->rd;
+
+    if (BUF_DESC_IN_PLACE(cbuffer->descriptor) && (cbuffer->aux_ptr != NULL))
+    {
+        rd = host((tCbuffer *)cbuffer->aux_ptr)->rd;
+    }
+    return size_octets(b) - (b->wr - rd) - b->usable;
+}
+
+void cbuffer_advance_read_ptr_ex(tCbuffer *cbuffer, unsigned num_octets)
+{
+    host(cbuffer)->rd += num_octets;
+}
+
+void cbuffer_advance_read_ptr(tCbuffer *cbuffer, unsigned int amount)
+{
+    host(cbuffer)->rd += amount;
+}
+
+void cbuffer_advance_write_ptr_ex(tCbuffer *cbuffer, unsigned num_octets)
+{
+    host(cbuffer)->wr += num_octets;
+}
+
+/* Word address and octet in the word, as the 16-bit unpacked hardware
+ * reports it. */
+unsigned int cbuffer_get_read_offset_ex(tCbuffer *cbuffer)
+{
+    unsigned rd = host(cbuffer)->rd;
+
+    return ((rd >> 1) << LOG2_ADDR_PER_WORD) + (rd & 1);
+}
+
+static uint8 *octet_at(host_buffer *b, unsigned position)
+{
+    return &b->data[position % size_octets(b)];
+}
+
+unsigned cbuffer_copy_ex(tCbuffer *dst, tCbuffer *src, unsigned num_octets)
+{
+    host_buffer *d = host(dst);
+    host_buffer *s = host(src);
+    unsigned i;
+
+    num_octets = MIN(num_octets, cbuffer_calc_amount_data_ex(src));
+    num_octets = MIN(num_octets, cbuffer_calc_amount_space_ex(dst));
+    for (i = 0; i < num_octets; i++)
+    {
+        *octet_at(d, d->wr + i) = *octet_at(s, s->rd + i);
+    }
+    d->wr += num_octets;
+    s->rd += num_octets;
+    copies++;
+    return num_octets;
+}
+
+static void unpack(int *dest, tCbuffer *src, unsigned offset, unsigned amount)
+{
+    unsigned i;
+
+    for (i = 0; i < amount; i++)
+    {
+        dest[i] = *octet_at(host(src), host(src)->rd + offset + i);
+    }
+}
+
+void unpack_cbuff_to_array_16bit(int *dest, tCbuffer *cbuffer_src, unsigned amount_to_copy)
+{
+    unpack(dest, cbuffer_src, 0, amount_to_copy);
+    host(cbuffer_src)->rd += amount_to_copy;
+}
+
+void unpack_cbuff_to_array_32bit(int *dest, tCbuffer *cbuffer_src, unsigned amount_to_copy)
+{
+    unpack_cbuff_to_array_16bit(dest, cbuffer_src, amount_to_copy);
+}
+
+void unpack_cbuff_to_array_from_offset_16bit(int *dest, tCbuffer *cbuffer_src,
+                                             unsigned amount_to_copy, unsigned offset)
+{
+    unpack(dest, cbuffer_src, offset, amount_to_copy);
+}
+
+void unpack_cbuff_to_array_from_offset_32bit(int *dest, tCbuffer *cbuffer_src,
+                                             unsigned amount_to_copy, unsigned offset)
+{
+    unpack(dest, cbuffer_src, offset, amount_to_copy);
+}
+
+/* The metadata read and write positions live in prev_rd_index and
+ * prev_wr_index. */
+metadata_tag *buff_metadata_new_tag(void)
+{
+    return calloc(1, sizeof(metadata_tag));
+}
+
+void buff_metadata_delete_tag(metadata_tag *tag, bool updates_eof)
+{
+    (void)updates_eof;
+    free(tag);
+}
+
+void buff_metadata_tag_list_delete(metadata_tag *list)
+{
+    while (list != NULL)
+    {
+        metadata_tag *next = list->next;
+
+        free(list);
+        list = next;
+    }
+}
+
+unsigned buff_metadata_available_octets(tCbuffer *cbuffer)
+{
+    return cbuffer->metadata->prev_wr_index - cbuffer->metadata->prev_rd_index;
+}
+
+metadata_tag *buff_metadata_peek(tCbuffer *cbuffer)
+{
+    return cbuffer->metadata->tags.head;
+}
+
+bool buff_metadata_append(tCbuffer *cbuffer, metadata_tag *tag_list,
+                          unsigned octets_pre_written, unsigned octets_post_written)
+{
+    metadata_list *md = cbuffer->metadata;
+    unsigned position = md->prev_wr_index + octets_pre_written;
+
+    if (tag_list == NULL)
+    {
+        md->prev_wr_index = position + octets_post_written;
+        return TRUE;
+    }
+    while (tag_list != NULL)
+    {
+        metadata_tag *next = tag_list->next;
+
+        tag_list->index = position;
+        tag_list->next = NULL;
+        if (md->tags.head == NULL)
+        {
+            md->tags.head = tag_list;
+        }
+        else
+        {
+            md->tags.tail->next = tag_list;
+        }
+        md->tags.tail = tag_list;
+        if (next != NULL)
+        {
+            position += tag_list->length;
+        }
+        tag_list = next;
+    }
+    md->prev_wr_index = position + octets_post_written;
+    return TRUE;
+}
+
+metadata_tag *buff_metadata_remove(tCbuffer *cbuffer, unsigned octets_consumed,
+                                   unsigned *octets_pre_removed, unsigned *octets_post_removed)
+{
+    metadata_list *md = cbuffer->metadata;
+    unsigned start = md->prev_rd_index;
+    unsigned end = start + octets_consumed;
+    metadata_tag *list = NULL, *last = NULL;
+
+    while ((md->tags.head != NULL) && (md->tags.head->index < end))
+    {
+        metadata_tag *tag = md->tags.head;
+
+        md->tags.head = tag->next;
+        tag->next = NULL;
+        if (last == NULL)
+        {
+            list = tag;
+        }
+        else
+        {
+            last->next = tag;
+        }
+        last = tag;
+    }
+    if (md->tags.head == NULL)
+    {
+        md->tags.tail = NULL;
+    }
+    *octets_pre_removed = (list != NULL) ? list->index - start : octets_consumed;
+    *octets_post_removed = (last != NULL) ? end - last->index : 0;
+    md->prev_rd_index = end;
+    return list;
+}
+
+metadata_tag *metadata_strict_transport(tCbuffer *src, tCbuffer *dst, unsigned trans_octets)
+{
+    unsigned b4idx, afteridx;
+    metadata_tag *list = buff_metadata_remove(src, trans_octets, &b4idx, &afteridx);
+    metadata_tag *last = list;
+
+    while ((last != NULL) && (last->next != NULL))
+    {
+        last = last->next;
+    }
+    buff_metadata_append(dst, list, b4idx, afteridx);
+    transports++;
+    return last;
+}
+
+/****************************************************************************
+Operator framework and TTP models
+*/
+
+void *base_op_get_instance_data(OPERATOR_DATA *op)
+{
+    (void)op;
+    return &opx;
+}
+
+bool base_op_create(OPERATOR_DATA *op, void *message_data, unsigned *response_id, void **response_data)
+{
+    (void)op; (void)message_data; (void)response_id; (void)response_data;
+    return TRUE;
+}
+
+bool base_op_build_std_response_ex(OPERATOR_DATA *op, STATUS_KYMERA status, void **response_data)
+{
+    static OP_STD_RSP response;
+
+    response.op_id = 0;
+    response.status = status;
+    *response_data = &response;
+    (void)op;
+    return TRUE;
+}
+
+bool common_send_unsolicited_message(OPERATOR_DATA *op_data, unsigned msg_id, unsigned length, const unsigned *payload)
+{
+    (void)op_data; (void)msg_id; (void)length; (void)payload;
+    return TRUE;
+}
+
+void *xzppmalloc(unsigned int numBytes, unsigned int preference)
+{
+    (void)preference;
+    return calloc(1, numBytes);
+}
+
+TIME hal_get_time(void)
+{
+    return 0;
+}
+
+void fault_diatribe(faultid id, DIATRIBE_TYPE arg)
+{
+    printf("FAIL: fault %d, %d\n", (int)id, (int)arg);
+}
+
+void panic(panicid deathbed_confession)
+{
+    printf("FAIL: panic %d\n", (int)deathbed_confession);
+    exit(1);
+}
+
+/* A fixed latency from the time of arrival, the restart flag on the first
+ * tag only. */
+void ttp_update_ttp(ttp_context *context, TIME time, unsigned samples, ttp_status *status)
+{
+    (void)context; (void)samples;
+    status->ttp = time + TTP_LATENCY;
+    status->sp_adjustment = 0;
+    status->err_offset_id = 0;
+    status->stream_restart = !ttp_started;
+    ttp_started = TRUE;
+}
+
+void ttp_reset(ttp_context *context)
+{
+    (void)context;
+    ttp_started = FALSE;
+}
+
+void ttp_configure_latency(ttp_context *context, TIME_INTERVAL target_latency)
+{
+    (void)context; (void)target_latency;
+}
+
+void ttp_update_ttp_from_source_time(ttp_context *context, TIME toa, TIME source_time, ttp_status *status)
+{
+    (void)source_time;
+    ttp_update_ttp(context, toa, 0, status);
+}
+
+unsigned ttp_get_next_timestamp(unsigned last_timestamp, unsigned nr_of_samples,
+                                unsigned sample_rate, int sp_adjust)
+{
+    (void)sp_adjust;
+    return last_timestamp + (unsigned)(((uint64)nr_of_samples * 1000000 + sample_rate / 2) / sample_rate);
+}
+
+void ttp_utils_populate_tag(metadata_tag *tag, ttp_status *status)
+{
+    METADATA_TIMESTAMP_SET(tag, status->ttp, METADATA_TIMESTAMP_LOCAL);
+    tag->sp_adjust = status->sp_adjustment;
+    if (status->stream_restart)
+    {
+        METADATA_STREAM_START_SET(tag);
+    }
+}
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+static tCbuffer *new_metadata_buffer(unsigned words)
+{
+    tCbuffer *buffer = cbuffer_create_with_malloc(words, 0);
+
+    buffer->metadata = calloc(1, sizeof(metadata_list));
+    buffer->metadata->next = buffer->metadata;
+    BUF_DESC_METADATA_SET(buffer->descriptor);
+    return buffer;
+}
+
+static void free_buffers(void)
+{
+    unsigned i, j;
+
+    for (i = 0; i < num_buffers; i++)
+    {
+        bool shared = FALSE;
+
+        for (j = 0; j < i; j++)
+        {
+            shared |= (buffers[j].data == buffers[i].data);
+        }
+        if (buffers[i].cb.metadata != NULL)
+        {
+            buff_metadata_tag_list_delete(buffers[i].cb.metadata->tags.head);
+            free(buffers[i].cb.metadata);
+        }
+        if (!shared)
+        {
+            free(buffers[i].data);
+        }
+    }
+    num_buffers = 0;
+}
+
+/* Create and connect the operator as the A2DP chain does. */
+static void setup_operator(void)
+{
+    uintptr_t message[2];
+    unsigned response_id;
+    void *response;
+
+    memset(&opx, 0, sizeof(opx));
+    ttp_started = FALSE;
+    rtp_decode_create(&op_data, NULL, &response_id, &response);
+    opx.mode = RTP_DECODE;
+    opx.sample_rate = 48000;
+    opx.pack_latency_buffer = TRUE;
+
+    message[0] = TERMINAL_SINK_MASK;
+    message[1] = (uintptr_t)new_metadata_buffer(IP_BUFFER_WORDS);
+    rtp_decode_connect(&op_data, message, &response_id, &response);
+    message[0] = 0;
+    message[1] = (uintptr_t)new_metadata_buffer(OP_BUFFER_WORDS);
+    rtp_decode_connect(&op_data, message, &response_id, &response);
+}
+
+/* Append octets to the input, with a time of arrival tag if tagged. */
+static void write_input(const uint8 *octets, unsigned length, bool tagged, unsigned arrival)
+{
+    host_buffer *ip = host(opx.ip_buffer);
+    unsigned i;
+
+    for (i = 0; i < length; i++)
+    {
+        *octet_at(ip, ip->wr + i) = octets[i];
+    }
+    ip->wr += length;
+    if (tagged)
+    {
+        metadata_tag *tag = buff_metadata_new_tag();
+
+        tag->length = length;
+        METADATA_PACKET_START_SET(tag);
+        METADATA_PACKET_END_SET(tag);
+        METADATA_TIME_OF_ARRIVAL_SET(tag, arrival);
+        buff_metadata_append(opx.ip_buffer, tag, 0, length);
+    }
+    else
+    {
+        buff_metadata_append(opx.ip_buffer, NULL, length, 0);
+    }
+}
+
+/* Take everything from the output, as the decoder would. */
+static void drain_output(output_record *record)
+{
+    host_buffer *op = host(opx.op_buffer);
+    unsigned available = buff_metadata_available_octets(opx.op_buffer);
+    unsigned start = opx.op_buffer->metadata->prev_rd_index;
+    unsigned b4idx, afteridx, i;
+    metadata_tag *list, *tag;
+
+    if (cbuffer_calc_amount_data_ex(opx.op_buffer) != available)
+    {
+        printf("FAIL: output has %u octets and %u octets of metadata\n",
+               cbuffer_calc_amount_data_ex(opx.op_buffer), available);
+    }
+    list = buff_metadata_remove(opx.op_buffer, available, &b4idx, &afteridx);
+    for (tag = list; (tag != NULL) && (record->tags != NULL); tag = tag->next)
+    {
+        if (record->num_tags < MAX_OUTPUT_TAGS)
+        {
+            output_tag *out = &record->tags[record->num_tags++];
+
+            out->position = record->num_octets + (tag->index - start);
+            out->length = tag->length;
+            out->timestamp = tag->timestamp;
+            out->flags = tag->flags;
+            out->sp_adjust = tag->sp_adjust;
+        }
+    }
+    buff_metadata_tag_list_delete(list);
+
+    for (i = 0; i < available; i++)
+    {
+        if (record->octets != NULL)
+        {
+            record->octets[record->num_octets + i] = *octet_at(op, op->rd + i);
+        }
+    }
+    op->rd += available;
+    record->num_octets += available;
+}
+
+/* Feed the stream through the operator, burst packets per kick, as far as
+ * the input has space. Keep kicking until the operator has taken it all. */
+static void run_stream(const uint8 *stream, unsigned num_packets, unsigned burst,
+                       output_record *record)
+{
+    TOUCHED_TERMINALS touched;
+    unsigned packet = 0;
+    unsigned last_output = ~0u;
+
+    setup_operator();
+    copies = transports = 0;
+
+    while ((packet < num_packets) || (record->num_octets != last_output))
+    {
+        unsigned i;
+
+        last_output = record->num_octets;
+        for (i = 0; (i < burst) && (packet < num_packets)
+                    && (cbuffer_calc_amount_space_ex(opx.ip_buffer) >= PACKET_SIZE); i++, packet++)
+        {
+            write_input(&stream[packet * PACKET_SIZE], PACKET_SIZE, TRUE, packet * PACKET_INTERVAL);
+        }
+        memset(&touched, 0, sizeof(touched));
+        rtp_decode_process_data(&op_data, &touched);
+        drain_output(record);
+    }
+    record->copies = copies;
+    record->transports = transports;
+    free_buffers();
+}
+
+static void record_init(output_record *record, unsigned size)
+{
+    memset(record, 0, sizeof(*record));
+    record->octets = malloc(size);
+    record->tags = malloc(MAX_OUTPUT_TAGS * sizeof(output_tag));
+}
+
+static void record_free(output_record *record)
+{
+    free(record->octets);
+    free(record->tags);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/****************************************************************************
+Tests
+*/
+
+/* The output must be the SBC frames of the packets, without their headers. */
+static unsigned check_payload(const uint8 *stream, unsigned num_packets, const output_record *reference)
+{
+    unsigned header = RTP_MINIMUM_HEADER_SIZE + SBC_PAYLOAD_HEADER_SIZE;
+    unsigned payload = PACKET_SIZE - header;
+    unsigned packet;
+
+    if (reference->num_octets != num_packets * payload)
+    {
+        printf("FAIL: %u output octets, expected %u\n", reference->num_octets, num_packets * payload);
+        return 1;
+    }
+    for (packet = 0; packet < num_packets; packet++)
+    {
+        if (memcmp(&reference->octets[packet * payload], &stream[packet * PACKET_SIZE + header], payload) != 0)
+        {
+            printf("FAIL: packet %u payload differs\n", packet);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static unsigned check_same(unsigned burst, const output_record *reference, const output_record *record)
+{
+    unsigned i;
+
+    if ((record->num_octets != reference->num_octets)
+        || (memcmp(record->octets, reference->octets, reference->num_octets) != 0))
+    {
+        printf("FAIL: burst %u: output octets differ\n", burst);
+        return 1;
+    }
+    if (record->num_tags != reference->num_tags)
+    {
+        printf("FAIL: burst %u: %u output tags, expected %u\n", burst, record->num_tags, reference->num_tags);
+        return 1;
+    }
+    for (i = 0; i < reference->num_tags; i++)
+    {
+        if (memcmp(&record->tags[i], &reference->tags[i], sizeof(output_tag)) != 0)
+        {
+            printf("FAIL: burst %u: output tag %u differs\n", burst, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* A kick that loses sync part way must still pass on the packets it
+ * decoded before. */
+static unsigned test_resync(const uint8 *stream)
+{
+    static const uint8 stray[10];
+    output_record record;
+    TOUCHED_TERMINALS touched;
+    unsigned header = RTP_MINIMUM_HEADER_SIZE + SBC_PAYLOAD_HEADER_SIZE;
+    unsigned failures = 0;
+
+    record_init(&record, 4 * PACKET_SIZE);
+    setup_operator();
+    write_input(&stream[0], PACKET_SIZE, TRUE, 0);
+    write_input(&stream[PACKET_SIZE], PACKET_SIZE, TRUE, PACKET_INTERVAL);
+    write_input(stray, sizeof(stray), FALSE, 0);
+    write_input(&stream[2 * PACKET_SIZE], PACKET_SIZE, TRUE, 2 * PACKET_INTERVAL);
+
+    memset(&touched, 0, sizeof(touched));
+    rtp_decode_process_data(&op_data, &touched);
+    drain_output(&record);
+
+    if ((record.num_octets != 2 * (PACKET_SIZE - header)) || (record.num_tags != 2)
+        || (touched.sources != TOUCHED_SOURCE_0))
+    {
+        printf("FAIL: resync: %u octets and %u tags passed on, expected %u and 2\n",
+               record.num_octets, record.num_tags, 2 * (PACKET_SIZE - header));
+        failures++;
+    }
+    free_buffers();
+    record_free(&record);
+    return failures;
+}
+
+/* With less than 4 octets of space left in the frame buffer the kick must
+ * take nothing from the input, and once there is space again the packets
+ * must come out whole. */
+static unsigned test_frame_buffer_full(const uint8 *stream)
+{
+    output_record record;
+    TOUCHED_TERMINALS touched;
+    host_buffer *clone, *frame;
+    unsigned header = RTP_MINIMUM_HEADER_SIZE + SBC_PAYLOAD_HEADER_SIZE;
+    unsigned filled, input, packet;
+    unsigned failures = 0;
+
+    record_init(&record, 4 * PACKET_SIZE);
+    setup_operator();
+    clone = host(opx.u.pack.clone_frame_buffer);
+    frame = host(opx.u.pack.frame_buffer);
+    for (packet = 0; packet < 4; packet++)
+    {
+        write_input(&stream[packet * PACKET_SIZE], PACKET_SIZE, TRUE, packet * PACKET_INTERVAL);
+    }
+    input = cbuffer_calc_amount_data_ex(opx.ip_buffer);
+
+    /* Octets without metadata stay in the frame buffer, as if the output
+     * had not taken the frames before them. */
+    filled = cbuffer_calc_amount_space_ex(opx.u.pack.clone_frame_buffer) - 2;
+    clone->wr += filled;
+    frame->wr += filled;
+
+    memset(&touched, 0, sizeof(touched));
+    rtp_decode_process_data(&op_data, &touched);
+    if ((cbuffer_calc_amount_data_ex(opx.ip_buffer) != input) || (clone->wr != frame->wr))
+    {
+        printf("FAIL: frame buffer full: %u of %u input octets taken\n",
+               input - cbuffer_calc_amount_data_ex(opx.ip_buffer), input);
+        failures++;
+    }
+    else
+    {
+        clone->wr -= filled;
+        frame->wr -= filled;
+        memset(&touched, 0, sizeof(touched));
+        rtp_decode_process_data(&op_data, &touched);
+        drain_output(&record);
+        if ((record.num_octets != 4 * (PACKET_SIZE - header))
+            || (memcmp(record.octets, &stream[header], PACKET_SIZE - header) != 0))
+        {
+            printf("FAIL: frame buffer full: %u octets passed on after, expected %u\n",
+                   record.num_octets, 4 * (PACKET_SIZE - header));
+            failures++;
+        }
+    }
+    free_buffers();
+    record_free(&record);
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    static const unsigned bursts[] = {1, 2, 4, 8, 64};
+    const char *name = (argc > 1) ? argv[1] : DEFAULT_FILE;
+    FILE *f = fopen(name, "rb");
+    uint8 *stream;
+    long size;
+    unsigned num_packets, i, pass;
+    unsigned failures = 0;
+    output_record reference;
+
+    if ((f == NULL) || (fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) <= 0))
+    {
+        printf("FAIL: cannot read %s\n", name);
+        return 1;
+    }
+    rewind(f);
+    stream = malloc(size);
+    if (fread(stream, 1, size, f) != (size_t)size)
+    {
+        printf("FAIL: cannot read %s\n", name);
+        return 1;
+    }
+    fclose(f);
+    num_packets = (unsigned)size / PACKET_SIZE;
+    printf("%u packets of %u octets\n\n", num_packets, PACKET_SIZE);
+
+    for (i = 0; i < sizeof(bursts) / sizeof(bursts[0]); i++)
+    {
+        output_record record;
+        double start;
+
+        record_init(&record, size);
+        run_stream(stream, num_packets, bursts[i], &record);
+        if (i == 0)
+        {
+            reference = record;
+            failures += check_payload(stream, num_packets, &reference);
+        }
+        else
+        {
+            failures += check_same(bursts[i], &reference, &record);
+        }
+
+        start = now_ns();
+        for (pass = 0; pass < TIMING_PASSES; pass++)
+        {
+            output_record timing;
+
+            memset(&timing, 0, sizeof(timing));
+            run_stream(stream, num_packets, bursts[i], &timing);
+        }
+        record.ns = (now_ns() - start) / ((double)TIMING_PASSES * num_packets);
+
+        printf("%u packet(s) per kick%s: %6.0f ns per packet, %.2f copies and %.2f metadata transports per packet, %u tags\n",
+               bursts[i], (i == 0) ? " (old path)" : "", record.ns,
+               (double)record.copies / num_packets, (double)record.transports / num_packets,
+               record.num_tags);
+        if (i != 0)
+        {
+            record_free(&record);
+        }
+    }
+    record_free(&reference);
+
+    failures += test_resync(stream);
+    failures += test_frame_buffer_full(stream);
+    free(stream);
+
+    if (failures != 0)
+    {
+        printf("\n%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
@@ -1222,6 +1222,9 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
     unsigned available_octets, available_space;
     unsigned rtp_header_size = RTP_MINIMUM_HEADER_SIZE +
                    (opx_data->scms_enable ? SCMS_HEADER_SIZE : 0);
+    /* The header layout only depends on the codec and the content protection,
+     * neither of which can change while data is being processed. */
+    unsigned min_packet_size = rtp_header_size + opx_data->payload_header_size;
     metadata_tag* tag;
 
     patch_fn(rtp_decode_process_data);
@@ -1330,21 +1333,30 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
     {
         if(!tag_valid(tag, opx_data))
         {
+            /* Pass on the frames decoded so far. */
+            rtp_decode_empty_internal_buffers(opx_data,touched);
             return;
         }
         /* Is there space in the sink for the unpacked data?
          * this needs to be a quick check and hence don't worry
          * about calculating the header size which isn't copied.
+         * When packing, the frames of all packets are left in the frame
+         * buffer and moved to the output in one go, so only empty it
+         * when it is full.
          */
-        if ((cbuffer_calc_amount_space_ex(clone_buffer) - 4 ) < packet_size)
+        if ((cbuffer_calc_amount_space_ex(clone_buffer) < packet_size + 4) &&
+            opx_data->pack_latency_buffer)
+        {
+            rtp_decode_empty_internal_buffers(opx_data,touched);
+        }
+        if (cbuffer_calc_amount_space_ex(clone_buffer) < packet_size + 4)
         {
             L4_DBG_MSG2("RTP END  available data (octets) = %d, available space (octets) = %d !!output space smaller than packet size!!",
                     cbuffer_calc_amount_data_ex(ip_buffer), cbuffer_calc_amount_space_ex(op_buffer));
             return;
         }
 
-        if (packet_size < (rtp_header_size +
-                opx_data->payload_header_size))
+        if (packet_size < min_packet_size)
         {
             /* packet is too small to contain header so discard it.*/
             cbuffer_advance_read_ptr_ex(ip_buffer, packet_size);
@@ -1485,14 +1497,14 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
         }
         available_octets -= packet_size;
 
-        /* unpack to output if possible. */
-        rtp_decode_empty_internal_buffers(opx_data,touched);
-
         /* Read the next packet tag. */
         tag = buff_metadata_peek(ip_buffer);
         packet_size = get_tag_size (tag);
     }
 
+    /* unpack to output if possible. */
+    rtp_decode_empty_internal_buffers(opx_data,touched);
+
     /*
      * Consumed all the available data -> kick backwards.
      */
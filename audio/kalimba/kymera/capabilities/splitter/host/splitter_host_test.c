@@ -0,0 +1,352 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  splitter_host_test.c
+ * \ingroup capabilities
+ *
+ * Host test of the clone path of the splitter. <br>
+ *
+ * Builds splitter.c as a DESKTOP_TEST_BUILD without metadata. The timer and
+ * operator framework calls it makes are replaced by counters. Two channels
+ * have their input and outputs set up as the splitter's connect does in
+ * clone mode: every output is a cbuffer over the memory of its channel's
+ * input. The test then kicks the operator with the outputs in different
+ * states and checks the buffer pointers it leaves.
+ *
+ * With no output active the kick must leave every pointer where it was and
+ * touch nothing. This holds both with the outputs unconnected and with
+ * them connected but inactive; before, the first dereferenced a NULL output
+ * and the second moved the input read pointers by UINT_MAX. With one or two
+ * outputs active, new input must reach every active output, the inputs
+ * must free only what the slowest active output has read, and an inactive
+ * output must be left alone. Every kick must schedule the self kick again.
+ * Returns non-zero on any failure.
+ *
+ * Build from this directory with
+ *     cc -O2 -fno-strict-aliasing -DDESKTOP_TEST_BUILD -DOS_OXYGOS -DDAWTH=32
+ *        -DLOG2_ADDR_PER_WORD=2 -DADDR_PER_WORD=4 -I.. -I../.. -I../../common
+ *        -I../../base_op -I../../../components
+ *        -I../../../components/common/interface
+ *        -I../../../components/common -I../../../components/buffer
+ *        -I../../../components/hal -I../../../components/adaptor
+ *        -I../../../components/aov -I../../../components/hydra_modules
+ *        -I../../../components/hydra_modules/hydra
+ *        -I../../../components/hydra_modules/hydra_adaption
+ *        -I../../../support_lib -I../../../common/interface
+ *        -I../../../common/interface/gen/k32 -I../../../../lib/audio_fadeout
+ *        -I../../../output/stre_rom_v02_release/gen -ffunction-sections
+ *        -Wl,--gc-sections splitter_host_test.c
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../splitter.c"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+/* Size of each input buffer, in words */
+#define BUFFER_WORDS        64
+
+#define NUM_CHANNELS        2
+
+/* Marks a pointer the splitter must not have moved */
+#define UNCONNECTED         ((tCbuffer *)NULL)
+
+/****************************************************************************
+Private Variable Definitions
+*/
+static SPLITTER_OP_DATA splitter_data;
+static OPERATOR_DATA op_data;
+static SPLITTER_CHANNEL_STRUC channels[NUM_CHANNELS];
+static tCbuffer inputs[NUM_CHANNELS];
+static tCbuffer outputs[NUM_CHANNELS][SPLITTER_MAX_OUTPUTS_PER_CHANNEL];
+static int memory[NUM_CHANNELS][BUFFER_WORDS];
+static unsigned self_kicks;
+
+/****************************************************************************
+Operator framework and timer models
+*/
+
+void *base_op_get_instance_data(OPERATOR_DATA *op)
+{
+    (void)op;
+    return &splitter_data;
+}
+
+TIME_INTERVAL stream_if_get_system_kick_period(void)
+{
+    return 2000;
+}
+
+TIME hal_get_time(void)
+{
+    return 0;
+}
+
+tTimerId create_add_strict_event(TIME event_time, tTimerEventFunction event_fn, void *data_ptr)
+{
+    (void)event_time; (void)event_fn; (void)data_ptr;
+    self_kicks++;
+    return 1;
+}
+
+bool timer_cancel_event_ret(tTimerId timer_id, uint16 *piarg, void **pdata)
+{
+    (void)timer_id; (void)piarg; (void)pdata;
+    return TRUE;
+}
+
+void interrupt_block(void)
+{
+}
+
+void interrupt_unblock(void)
+{
+}
+
+void splitter_timer_task(void *timer_data)
+{
+    (void)timer_data;
+}
+
+/****************************************************************************
+Helpers
+*/
+
+static int *word_at(unsigned channel, unsigned words)
+{
+    return &memory[channel][words % BUFFER_WORDS];
+}
+
+static unsigned words_between(const int *from, const int *to)
+{
+    return (unsigned)(((to - from) + BUFFER_WORDS) % BUFFER_WORDS);
+}
+
+/* Set up the channels as the splitter's connect does in clone mode, with
+ * the outputs of connected[] present. Input and outputs start empty. */
+static void setup(const bool connected[SPLITTER_MAX_OUTPUTS_PER_CHANNEL])
+{
+    unsigned ch, i;
+
+    memset(&splitter_data, 0, sizeof(splitter_data));
+    memset(channels, 0, sizeof(channels));
+    splitter_data.working_mode = CLONE_BUFFER;
+    splitter_data.touched_sinks = TOUCHED_SINK_0 | TOUCHED_SINK_1;
+    splitter_data.touched_sources = TOUCHED_SOURCE_0 | TOUCHED_SOURCE_1 | TOUCHED_SOURCE_2 | TOUCHED_SOURCE_3;
+    splitter_data.self_kick_timer = TIMER_ID_INVALID;
+
+    for (ch = 0; ch < NUM_CHANNELS; ch++)
+    {
+        tCbuffer *in = &inputs[ch];
+
+        memset(in, 0, sizeof(*in));
+        in->base_addr = memory[ch];
+        in->read_ptr = in->write_ptr = memory[ch];
+        in->size = BUFFER_WORDS * ADDR_PER_WORD;
+        channels[ch].input_buffer = in;
+        channels[ch].id = ch;
+        channels[ch].next = (ch + 1 < NUM_CHANNELS) ? &channels[ch + 1] : NULL;
+
+        for (i = 0; i < SPLITTER_MAX_OUTPUTS_PER_CHANNEL; i++)
+        {
+            outputs[ch][i] = *in;
+            channels[ch].output_buffer[i] = connected[i] ? &outputs[ch][i] : UNCONNECTED;
+        }
+    }
+    splitter_data.channel_list = channels;
+    self_kicks = 0;
+}
+
+static void set_states(SPLITTER_OUTPUT_STATE state_0, SPLITTER_OUTPUT_STATE state_1)
+{
+    splitter_data.output_state[0] = state_0;
+    splitter_data.output_state[1] = state_1;
+}
+
+/* Source writes words into every input */
+static void write_inputs(unsigned words)
+{
+    unsigned ch;
+
+    for (ch = 0; ch < NUM_CHANNELS; ch++)
+    {
+        unsigned wr = words_between(memory[ch], inputs[ch].write_ptr);
+
+        inputs[ch].write_ptr = word_at(ch, wr + words);
+    }
+}
+
+/* A sink reads words from output i of every channel */
+static void read_outputs(unsigned i, unsigned words)
+{
+    unsigned ch;
+
+    for (ch = 0; ch < NUM_CHANNELS; ch++)
+    {
+        unsigned rd = words_between(memory[ch], outputs[ch][i].read_ptr);
+
+        outputs[ch][i].read_ptr = word_at(ch, rd + words);
+    }
+}
+
+static unsigned kick(TOUCHED_TERMINALS *touched)
+{
+    unsigned kicks = self_kicks;
+
+    memset(touched, 0, sizeof(*touched));
+    splitter_process_data(&op_data, touched);
+    return self_kicks - kicks;
+}
+
+/* Check every channel's input read and write and output i's write, in
+ * words from the start of the buffer */
+static unsigned check_pointers(const char *test, unsigned in_read, unsigned in_write,
+                               unsigned i, unsigned out_write)
+{
+    unsigned ch, failures = 0;
+
+    for (ch = 0; ch < NUM_CHANNELS; ch++)
+    {
+        unsigned rd = words_between(memory[ch], inputs[ch].read_ptr);
+        unsigned wr = words_between(memory[ch], inputs[ch].write_ptr);
+        unsigned out = words_between(memory[ch], outputs[ch][i].write_ptr);
+
+        if ((rd != in_read) || (wr != in_write) || (out != out_write))
+        {
+            printf("FAIL: %s: channel %u input %u-%u, output %u written to %u; expected %u-%u and %u\n",
+                   test, ch, rd, wr, i, out, in_read, in_write, out_write);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/****************************************************************************
+Tests
+*/
+
+/* No output active: nothing may move, whether the outputs are connected or
+ * not, and only the self kick is scheduled. */
+static unsigned test_no_active_output(void)
+{
+    static const bool none[SPLITTER_MAX_OUTPUTS_PER_CHANNEL] = {FALSE, FALSE};
+    static const bool both[SPLITTER_MAX_OUTPUTS_PER_CHANNEL] = {TRUE, TRUE};
+    const bool *connected[] = {none, both};
+    static const SPLITTER_OUTPUT_STATE states[] = {INACTIVE, HOLD};
+    TOUCHED_TERMINALS touched;
+    unsigned c, s, failures = 0;
+
+    for (c = 0; c < 2; c++)
+    {
+        for (s = 0; s < 2; s++)
+        {
+            setup(connected[c]);
+            set_states(states[s], states[s]);
+            write_inputs(10);
+            if (kick(&touched) != 1)
+            {
+                printf("FAIL: no active output: self kick not scheduled\n");
+                failures++;
+            }
+            if ((touched.sinks != 0) || (touched.sources != 0))
+            {
+                printf("FAIL: no active output: terminals touched\n");
+                failures++;
+            }
+            failures += check_pointers("no active output", 0, 10, 0, 0);
+            failures += check_pointers("no active output", 0, 10, 1, 0);
+        }
+    }
+    return failures;
+}
+
+/* One output active: it gets the new data and frees the input as it reads.
+ * The inactive output, here unconnected, is not touched. */
+static unsigned test_one_active_output(void)
+{
+    static const bool first[SPLITTER_MAX_OUTPUTS_PER_CHANNEL] = {TRUE, FALSE};
+    TOUCHED_TERMINALS touched;
+    unsigned failures = 0;
+
+    setup(first);
+    set_states(ACTIVE, INACTIVE);
+    write_inputs(10);
+    kick(&touched);
+    failures += check_pointers("one active output", 0, 10, 0, 10);
+    if (touched.sources != splitter_data.touched_sources)
+    {
+        printf("FAIL: one active output: sources not kicked\n");
+        failures++;
+    }
+
+    read_outputs(0, 6);
+    kick(&touched);
+    failures += check_pointers("one active output", 6, 10, 0, 10);
+    if (touched.sinks != splitter_data.touched_sinks)
+    {
+        printf("FAIL: one active output: sinks not kicked\n");
+        failures++;
+    }
+
+    /* Across the end of the buffer */
+    read_outputs(0, 4);
+    write_inputs(BUFFER_WORDS - 4);
+    kick(&touched);
+    failures += check_pointers("one active output", 10, 6, 0, 6);
+    return failures;
+}
+
+/* Two outputs active: both get the new data and the input is freed only as
+ * far as the slower one has read. */
+static unsigned test_two_active_outputs(void)
+{
+    static const bool both[SPLITTER_MAX_OUTPUTS_PER_CHANNEL] = {TRUE, TRUE};
+    TOUCHED_TERMINALS touched;
+    unsigned failures = 0;
+
+    setup(both);
+    set_states(ACTIVE, ACTIVE);
+    write_inputs(20);
+    kick(&touched);
+    failures += check_pointers("two active outputs", 0, 20, 0, 20);
+    failures += check_pointers("two active outputs", 0, 20, 1, 20);
+
+    read_outputs(0, 15);
+    read_outputs(1, 5);
+    kick(&touched);
+    failures += check_pointers("two active outputs", 5, 20, 0, 20);
+
+    /* The second output is deactivated: the input follows the first, and
+     * the second no longer gets new data. */
+    set_states(ACTIVE, INACTIVE);
+    write_inputs(4);
+    kick(&touched);
+    failures += check_pointers("two active outputs", 15, 24, 0, 24);
+    failures += check_pointers("two active outputs", 15, 24, 1, 20);
+    return failures;
+}
+
+int main(void)
+{
+    unsigned failures = 0;
+
+    failures += test_no_active_output();
+    failures += test_one_active_output();
+    failures += test_two_active_outputs();
+
+    if (failures != 0)
+    {
+        printf("%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
@@ -102,6 +102,7 @@ static inline void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_T
 {
     SPLITTER_OP_DATA *splitter = get_instance_data(op_data);
     unsigned i, min_new_data, min_new_space;
+    unsigned active_outputs = 0;
     int *new_output_write_addr;
     int *new_input_read_addr;
 
@@ -110,6 +111,26 @@ static inline void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_T
 
     timer_cancel_event_atomic(&splitter->self_kick_timer);
 
+    /* The output states are the same for every channel, so look them up once
+     * per kick rather than once per channel. */
+    for (i=0; i<SPLITTER_MAX_OUTPUTS_PER_CHANNEL; i++)
+    {
+        if (get_current_output_state(splitter, i) == ACTIVE)
+        {
+            active_outputs |= 1 << i;
+        }
+    }
+
+    if (active_outputs == 0)
+    {
+        /* Nobody reads the cloned buffers so there is no space to free and
+         * no output to write to. Leave the data in the input until an output
+         * is activated. */
+        timer_schedule_event_in_atomic(SPLITTER_SELF_KICK_RATIO * stream_if_get_system_kick_period(),
+            splitter_timer_task, (void*)op_data, &splitter->self_kick_timer);
+        return;
+    }
+
     /* This code is very naughty and reaches into the cbuffer structures. It can
      * be done safely because they have to be local, and it's lightning fast as
      * a result. Cbuffer API is subverted because it isn't designed for this.
@@ -124,7 +145,7 @@ static inline void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_T
 
         for (i=0; i<SPLITTER_MAX_OUTPUTS_PER_CHANNEL; i++)
         {
-            if (get_current_output_state(splitter, i) == ACTIVE)
+            if ((active_outputs & (1 << i)) != 0)
             {
                 out = channel->output_buffer[i];
 
@@ -217,7 +238,7 @@ static inline void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_T
         {
             for (i=0; i<SPLITTER_MAX_OUTPUTS_PER_CHANNEL; i++)
             {
-                if (get_current_output_state(splitter, i) == ACTIVE)
+                if ((active_outputs & (1 << i)) != 0)
                 {
                     tCbuffer *out = channel->output_buffer[i];
                     new_output_write_addr = (int *)((char *)out->write_ptr + min_new_data);
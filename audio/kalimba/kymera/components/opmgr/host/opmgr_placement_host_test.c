@@ -0,0 +1,781 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  opmgr_placement_host_test.c
+ * \ingroup  opmgr
+ *
+ * Host unit test of the dual-core operator placement engine. <br>
+ *
+ * Builds the partitioner as a DESKTOP_TEST_BUILD and checks it on small
+ * graphs with a known answer: independent chains are split between the
+ * processors, light chains are not split across a busy KIP connection,
+ * pins and memory budgets are kept and malformed graphs are refused. The
+ * deferred placement is then driven as opmgr drives it, operators created
+ * first and placed when they are connected: a chain beside a busy P0 moves
+ * to P1, light and P0 only operators stay, nothing moves with one processor
+ * running, and only the connections made are remembered until they are
+ * disconnected or their operators destroyed. Random graphs are compared
+ * against an exhaustive search for the peak load, and the partition of a
+ * full graph is timed. Returns non-zero on any failure.
+ *
+ * Build from this directory with
+ *     cc -O2 -DDESKTOP_TEST_BUILD -I../.. -I../../common/interface
+ *        -I../../../common/interface/gen/k32 opmgr_placement_host_test.c
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "types.h"
+
+/* opmgr.h brings in most of the firmware, the engine only needs the create
+ * key type from it. */
+#define OPMGR_H
+typedef struct
+{
+    unsigned int key;
+    int32  value;
+} OPERATOR_CREATE_EX_INFO;
+
+/* Endpoint IDs of the tests: operator endpoints carry the operator ID, as
+ * STREAM_EP_IS_OPEP_ID() and EXT_TO_INT_OPID() see them on target. */
+#define SIM_REAL_EP         0x2000
+#define SIM_OP_EP(op_id)    (0x4000 | ((op_id) << 6))
+#define PLACEMENT_EP_OP(ep_id) \
+            ((((ep_id) & 0x4000) != 0) ? (((ep_id) >> 6) & 0xFF) : 0)
+
+#include "../opmgr_placement.c"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define RANDOM_GRAPHS       2000
+#define RANDOM_MAX_NODES    10
+#define TIMING_RUNS         2000
+
+/* Load of a heavy and a light operator, in KIPS */
+#define HEAVY_KIPS          20000
+#define LIGHT_KIPS          300
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+static unsigned random_state = 1;
+
+/* Random number below limit, from the high bits of an LCG. */
+static unsigned random_below(unsigned limit)
+{
+    random_state = random_state * 1664525u + 1013904223u;
+    return (unsigned)(((unsigned long long)(random_state >> 8) * limit) >> 24);
+}
+
+static void make_node(OPMGR_PLACEMENT_NODE *node, unsigned kips, uint8 pin)
+{
+    node->cap_id = 0;
+    node->kips = kips;
+    node->mem_words = 1000;
+    node->pin = pin;
+    node->proc = 0;
+}
+
+static void make_edge(OPMGR_PLACEMENT_EDGE *edge, uint8 source, uint8 sink,
+                      unsigned words_per_sec)
+{
+    edge->source = source;
+    edge->sink = sink;
+    edge->words_per_sec = words_per_sec;
+    edge->buffer_words = 256;
+}
+
+static void make_graph(OPMGR_PLACEMENT_GRAPH *graph,
+                       OPMGR_PLACEMENT_NODE *nodes, unsigned num_nodes,
+                       const OPMGR_PLACEMENT_EDGE *edges, unsigned num_edges)
+{
+    graph->nodes = nodes;
+    graph->num_nodes = num_nodes;
+    graph->edges = edges;
+    graph->num_edges = num_edges;
+    graph->num_procs = OPMGR_PLACEMENT_NUM_PROCS;
+    graph->mem_limit[0] = 0;
+    graph->mem_limit[1] = 0;
+}
+
+static unsigned peak_kips(const OPMGR_PLACEMENT_COST *cost)
+{
+    return (cost->kips[0] > cost->kips[1]) ? cost->kips[0] : cost->kips[1];
+}
+
+/* Two chains of heavy operators between real endpoints: input -> a -> b ->
+ * output. Each chain should end up whole on a processor of its own. */
+static int test_split_chains(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[4];
+    OPMGR_PLACEMENT_EDGE edges[6];
+    OPMGR_PLACEMENT_GRAPH graph;
+    OPMGR_PLACEMENT_COST cost;
+    int failures = 0;
+    unsigned i;
+
+    for (i = 0; i < 4; i++)
+    {
+        make_node(&nodes[i], HEAVY_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    }
+    make_edge(&edges[0], OPMGR_PLACEMENT_REAL_EP, 0, 48000);
+    make_edge(&edges[1], 0, 1, 48000);
+    make_edge(&edges[2], 1, OPMGR_PLACEMENT_REAL_EP, 48000);
+    make_edge(&edges[3], OPMGR_PLACEMENT_REAL_EP, 2, 48000);
+    make_edge(&edges[4], 2, 3, 48000);
+    make_edge(&edges[5], 3, OPMGR_PLACEMENT_REAL_EP, 48000);
+    make_graph(&graph, nodes, 4, edges, 6);
+
+    if (!opmgr_placement_partition(&graph, &cost))
+    {
+        printf("FAIL: split chains: no placement\n");
+        return 1;
+    }
+
+    if ((nodes[0].proc != nodes[1].proc) || (nodes[2].proc != nodes[3].proc) ||
+        (nodes[0].proc == nodes[2].proc))
+    {
+        printf("FAIL: split chains: placed %u %u %u %u\n",
+               nodes[0].proc, nodes[1].proc, nodes[2].proc, nodes[3].proc);
+        failures++;
+    }
+
+    /* Only the real endpoints of the chain on P1 cross */
+    if (cost.crossings != 2)
+    {
+        printf("FAIL: split chains: %u crossings\n", cost.crossings);
+        failures++;
+    }
+
+    if (peak_kips(&cost) >= 4 * HEAVY_KIPS)
+    {
+        printf("FAIL: split chains: peak %u KIPS not below one core\n",
+               peak_kips(&cost));
+        failures++;
+    }
+
+    printf("Split chains: P0 %u KIPS, P1 %u KIPS, %u crossings\n",
+           cost.kips[0], cost.kips[1], cost.crossings);
+    return failures;
+}
+
+/* A chain of light operators gains nothing from a split that costs two
+ * KIP crossings, so it stays on P0. */
+static int test_light_chain(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[3];
+    OPMGR_PLACEMENT_EDGE edges[4];
+    OPMGR_PLACEMENT_GRAPH graph;
+    OPMGR_PLACEMENT_COST cost;
+    unsigned i;
+
+    for (i = 0; i < 3; i++)
+    {
+        make_node(&nodes[i], LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    }
+    make_edge(&edges[0], OPMGR_PLACEMENT_REAL_EP, 0, 96000);
+    make_edge(&edges[1], 0, 1, 96000);
+    make_edge(&edges[2], 1, 2, 96000);
+    make_edge(&edges[3], 2, OPMGR_PLACEMENT_REAL_EP, 96000);
+    make_graph(&graph, nodes, 3, edges, 4);
+
+    if (!opmgr_placement_partition(&graph, &cost) || (cost.crossings != 0) ||
+        (cost.kips[1] != 0))
+    {
+        printf("FAIL: light chain: %u crossings, P1 %u KIPS\n",
+               cost.crossings, cost.kips[1]);
+        return 1;
+    }
+    return 0;
+}
+
+/* Pinned operators stay put, and a single processor takes everything. */
+static int test_pins(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[3];
+    OPMGR_PLACEMENT_GRAPH graph;
+    int failures = 0;
+
+    make_node(&nodes[0], HEAVY_KIPS, 1);
+    make_node(&nodes[1], HEAVY_KIPS, 1);
+    make_node(&nodes[2], LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    make_graph(&graph, nodes, 3, NULL, 0);
+
+    if (!opmgr_placement_partition(&graph, NULL) ||
+        (nodes[0].proc != 1) || (nodes[1].proc != 1) || (nodes[2].proc != 0))
+    {
+        printf("FAIL: pins: placed %u %u %u\n",
+               nodes[0].proc, nodes[1].proc, nodes[2].proc);
+        failures++;
+    }
+
+    make_node(&nodes[0], HEAVY_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    make_node(&nodes[1], HEAVY_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    graph.num_procs = 1;
+
+    if (!opmgr_placement_partition(&graph, NULL) ||
+        (nodes[0].proc != 0) || (nodes[1].proc != 0) || (nodes[2].proc != 0))
+    {
+        printf("FAIL: single processor: placed %u %u %u\n",
+               nodes[0].proc, nodes[1].proc, nodes[2].proc);
+        failures++;
+    }
+    return failures;
+}
+
+/* A memory budget on P0 moves operators off it even when that costs load,
+ * and a graph too big for both budgets is refused. */
+static int test_memory_limit(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[3];
+    OPMGR_PLACEMENT_GRAPH graph;
+    OPMGR_PLACEMENT_COST cost;
+    int failures = 0;
+    unsigned i;
+
+    for (i = 0; i < 3; i++)
+    {
+        make_node(&nodes[i], LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    }
+    make_graph(&graph, nodes, 3, NULL, 0);
+    graph.mem_limit[0] = 1000;
+
+    if (!opmgr_placement_partition(&graph, &cost) || (cost.mem_words[0] > 1000))
+    {
+        printf("FAIL: memory limit: P0 uses %u words\n", cost.mem_words[0]);
+        failures++;
+    }
+
+    graph.mem_limit[1] = 1000;
+    if (opmgr_placement_partition(&graph, NULL))
+    {
+        printf("FAIL: memory limit: over budget graph accepted\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int test_malformed(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[2];
+    OPMGR_PLACEMENT_EDGE edge;
+    OPMGR_PLACEMENT_GRAPH graph;
+    int failures = 0;
+
+    make_node(&nodes[0], LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    make_node(&nodes[1], LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    make_edge(&edge, 0, 2, 48000);
+    make_graph(&graph, nodes, 2, &edge, 1);
+
+    if (opmgr_placement_partition(&graph, NULL))
+    {
+        printf("FAIL: malformed: edge to a missing node accepted\n");
+        failures++;
+    }
+
+    make_edge(&edge, 0, 1, 48000);
+    nodes[1].pin = 2;
+    if (opmgr_placement_partition(&graph, NULL))
+    {
+        printf("FAIL: malformed: pin to a missing processor accepted\n");
+        failures++;
+    }
+    return failures;
+}
+
+/* Operators known to the create -> connect tests, standing in for the
+ * operator lists of opmgr. */
+typedef struct
+{
+    unsigned cap_id;
+    unsigned kips;
+    uint8 proc;
+    bool exists;
+} SIM_OP;
+
+static SIM_OP sim_ops[OPMGR_PLACEMENT_MAX_NODES + 1];
+static unsigned sim_num_ops;
+static unsigned sim_next_transform;
+/* Failures found inside sim_connect() */
+static int sim_failures;
+
+static void sim_reset(void)
+{
+    unsigned i;
+
+    for (i = 1; i <= sim_num_ops; i++)
+    {
+        if (sim_ops[i].exists)
+        {
+            opmgr_placement_destroyed(i);
+        }
+    }
+    sim_num_ops = 0;
+}
+
+/* As opmgr_create_operator_ex(): an operator created without the processor
+ * key goes on P0 and waits for placement if its capability can move. */
+static unsigned sim_create(unsigned cap_id, unsigned kips, uint8 proc_key)
+{
+    unsigned op_id = ++sim_num_ops;
+    SIM_OP *op = &sim_ops[op_id];
+
+    op->cap_id = cap_id;
+    op->kips = kips;
+    op->exists = TRUE;
+    op->proc = (proc_key == OPMGR_PLACEMENT_PIN_NONE) ? 0 : proc_key;
+    if ((proc_key == OPMGR_PLACEMENT_PIN_NONE) && opmgr_placement_cap_movable(cap_id))
+    {
+        opmgr_placement_defer(op_id, 1);
+    }
+    return op_id;
+}
+
+/* As opmgr_placement_connect(): the operators of the connection go first,
+ * the movers are moved, and the connection is remembered if it is made.
+ * Returns the number of operators moved. */
+static unsigned sim_connect(unsigned source_id, unsigned sink_id,
+                            unsigned num_procs, bool made)
+{
+    static OPMGR_PLACEMENT_WORKSPACE ws;
+    unsigned source_op = PLACEMENT_EP_OP(source_id);
+    unsigned sink_op = PLACEMENT_EP_OP(sink_id);
+    unsigned order[2];
+    unsigned num_ops = 0, num_moves = 0;
+    unsigned i;
+
+    order[0] = source_op;
+    order[1] = sink_op;
+    for (i = 0; i < 2; i++)
+    {
+        if ((order[i] != 0) && (placement_find_node(&ws, num_ops, order[i]) == num_ops))
+        {
+            ws.ops[num_ops].op_id = order[i];
+            num_ops++;
+        }
+    }
+    for (i = 1; i <= sim_num_ops; i++)
+    {
+        if (sim_ops[i].exists && (i != source_op) && (i != sink_op))
+        {
+            ws.ops[num_ops].op_id = i;
+            num_ops++;
+        }
+    }
+    for (i = 0; i < num_ops; i++)
+    {
+        const SIM_OP *op = &sim_ops[ws.ops[i].op_id];
+
+        ws.ops[i].cap_id = op->cap_id;
+        ws.ops[i].kips = op->kips;
+        ws.ops[i].proc = op->proc;
+    }
+
+    if (opmgr_placement_is_pending(source_op) || opmgr_placement_is_pending(sink_op))
+    {
+        opmgr_placement_decide(&ws, num_ops, num_procs, source_op, sink_op);
+
+        for (i = 0; i < num_ops; i++)
+        {
+            SIM_OP *op = &sim_ops[ws.ops[i].op_id];
+
+            if (ws.ops[i].movable)
+            {
+                OPERATOR_CREATE_EX_INFO key;
+
+                /* The operator is created again with this key */
+                opmgr_placement_create_key(&ws.nodes[i], &key);
+                if ((key.key != OPERATOR_CREATE_PROCESSOR_ID) ||
+                    (key.value != ws.ops[i].proc))
+                {
+                    printf("FAIL: connect: create key %u = %d for P%u\n",
+                           key.key, (int)key.value, ws.ops[i].proc);
+                    sim_failures++;
+                }
+                op->proc = ws.ops[i].proc;
+                num_moves++;
+            }
+            else if (ws.nodes[i].proc != op->proc)
+            {
+                printf("FAIL: connect: operator %u placed away from P%u\n",
+                       ws.ops[i].op_id, op->proc);
+                sim_failures++;
+            }
+        }
+    }
+    opmgr_placement_fix(source_op);
+    opmgr_placement_fix(sink_op);
+
+    if (made)
+    {
+        opmgr_placement_connected(++sim_next_transform, source_id, sink_id);
+    }
+    return num_moves;
+}
+
+/* A chain created beside a busy P0 moves to P1 on its first connection,
+ * and stays there once it is connected on to a real endpoint. */
+static int test_connect_moves(void)
+{
+    unsigned busy, x, y;
+    int failures = 0;
+
+    busy = sim_create(0x10, HEAVY_KIPS, 0);
+    x = sim_create(0x20, OPMGR_PLACEMENT_DEFAULT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    y = sim_create(0x21, OPMGR_PLACEMENT_DEFAULT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    sim_connect(SIM_REAL_EP, SIM_OP_EP(busy), 2, TRUE);
+
+    if (opmgr_placement_is_pending(busy) || !opmgr_placement_is_pending(x) ||
+        !opmgr_placement_is_pending(y))
+    {
+        printf("FAIL: connect: operators created without the processor key not waiting\n");
+        failures++;
+    }
+
+    if ((sim_connect(SIM_OP_EP(x), SIM_OP_EP(y), 2, TRUE) != 2) ||
+        (sim_ops[x].proc != 1) || (sim_ops[y].proc != 1))
+    {
+        printf("FAIL: connect: chain on P%u/P%u beside a busy P0\n",
+               sim_ops[x].proc, sim_ops[y].proc);
+        failures++;
+    }
+
+    if (opmgr_placement_is_pending(x) || opmgr_placement_is_pending(y) ||
+        (sim_connect(SIM_OP_EP(y), SIM_REAL_EP, 2, TRUE) != 0) ||
+        (placement_num_connections != 3))
+    {
+        printf("FAIL: connect: placed chain moved again or connections lost\n");
+        failures++;
+    }
+
+    sim_reset();
+    return failures;
+}
+
+/* A light operator connected to a real endpoint is not worth a crossing,
+ * and an operator of a P0 only capability never waits for placement. */
+static int test_connect_stays(void)
+{
+    unsigned busy, light, sbc;
+    int failures = 0;
+
+    busy = sim_create(0x10, HEAVY_KIPS, 0);
+    light = sim_create(0x20, LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    sbc = sim_create(CAP_ID_SBC_DECODER, HEAVY_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    sim_connect(SIM_REAL_EP, SIM_OP_EP(busy), 2, TRUE);
+
+    if ((sim_connect(SIM_OP_EP(light), SIM_REAL_EP, 2, TRUE) != 0) ||
+        (sim_ops[light].proc != 0) || opmgr_placement_is_pending(light))
+    {
+        printf("FAIL: stays: light operator on P%u\n", sim_ops[light].proc);
+        failures++;
+    }
+
+    if (opmgr_placement_is_pending(sbc) ||
+        (sim_connect(SIM_REAL_EP, SIM_OP_EP(sbc), 2, TRUE) != 0) ||
+        (sim_ops[sbc].proc != 0))
+    {
+        printf("FAIL: stays: P0 only capability placed on P%u\n", sim_ops[sbc].proc);
+        failures++;
+    }
+
+    sim_reset();
+    return failures;
+}
+
+/* Without P1 running nothing moves, and the operators are placed for good. */
+static int test_connect_single_core(void)
+{
+    unsigned busy, x, y;
+    int failures = 0;
+
+    busy = sim_create(0x10, HEAVY_KIPS, 0);
+    x = sim_create(0x20, HEAVY_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    y = sim_create(0x21, HEAVY_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+    sim_connect(SIM_REAL_EP, SIM_OP_EP(busy), 1, TRUE);
+
+    if ((sim_connect(SIM_OP_EP(x), SIM_OP_EP(y), 1, TRUE) != 0) ||
+        (sim_ops[x].proc != 0) || (sim_ops[y].proc != 0) ||
+        opmgr_placement_is_pending(x) || opmgr_placement_is_pending(y))
+    {
+        printf("FAIL: single core: operators moved or left waiting\n");
+        failures++;
+    }
+
+    sim_reset();
+    return failures;
+}
+
+/* Only connections that were made are remembered, and they are forgotten on
+ * disconnect or when one of their operators is destroyed. */
+static int test_connection_tracking(void)
+{
+    unsigned a, b, c;
+    unsigned transforms[1];
+    int failures = 0;
+
+    a = sim_create(0x10, LIGHT_KIPS, 0);
+    b = sim_create(0x11, LIGHT_KIPS, 0);
+    c = sim_create(0x12, LIGHT_KIPS, OPMGR_PLACEMENT_PIN_NONE);
+
+    sim_connect(SIM_REAL_EP, SIM_OP_EP(a), 2, FALSE);
+    if (placement_num_connections != 0)
+    {
+        printf("FAIL: tracking: failed connection remembered\n");
+        failures++;
+    }
+
+    sim_connect(SIM_REAL_EP, SIM_OP_EP(a), 2, TRUE);
+    transforms[0] = sim_next_transform;
+    sim_connect(SIM_OP_EP(a), SIM_OP_EP(b), 2, TRUE);
+    sim_connect(SIM_OP_EP(b) + 1, SIM_OP_EP(c), 2, TRUE);
+    sim_connect(SIM_REAL_EP + 1, SIM_REAL_EP, 2, TRUE);
+    if (placement_num_connections != 3)
+    {
+        printf("FAIL: tracking: %u connections remembered, expected 3\n",
+               placement_num_connections);
+        failures++;
+    }
+
+    opmgr_placement_disconnect_transforms(1, transforms);
+    opmgr_placement_disconnect_endpoints(0, SIM_OP_EP(b));
+    if ((placement_num_connections != 1) ||
+        (placement_connections[0].sink_id != SIM_OP_EP(c)))
+    {
+        printf("FAIL: tracking: disconnect left %u connections\n",
+               placement_num_connections);
+        failures++;
+    }
+
+    /* An operator waiting for placement is forgotten with its connections */
+    sim_ops[c].exists = FALSE;
+    opmgr_placement_defer(c, 1);
+    opmgr_placement_destroyed(c);
+    if ((placement_num_connections != 0) || opmgr_placement_is_pending(c))
+    {
+        printf("FAIL: tracking: destroyed operator still known\n");
+        failures++;
+    }
+
+    sim_reset();
+    return failures;
+}
+
+/* The pending table is bounded: an operator that does not fit stays on P0,
+ * and a record left by an earlier operator with the same ID is replaced. */
+static int test_defer_limits(void)
+{
+    unsigned i;
+    int failures = 0;
+
+    for (i = 1; i <= OPMGR_PLACEMENT_MAX_PENDING; i++)
+    {
+        if (!opmgr_placement_defer(i, 1))
+        {
+            printf("FAIL: defer: operator %u refused\n", i);
+            failures++;
+        }
+    }
+    if (opmgr_placement_defer(OPMGR_PLACEMENT_MAX_PENDING + 1, 1) ||
+        !opmgr_placement_defer(1, 2) || (placement_find_pending(1)->priority != 2))
+    {
+        printf("FAIL: defer: table full or reused ID not handled\n");
+        failures++;
+    }
+
+    for (i = 1; i <= OPMGR_PLACEMENT_MAX_PENDING; i++)
+    {
+        opmgr_placement_fix(i);
+    }
+    return failures;
+}
+
+/* Best peak load over every placement of the free nodes. */
+static unsigned exhaustive_peak(OPMGR_PLACEMENT_GRAPH *graph)
+{
+    OPMGR_PLACEMENT_COST cost;
+    unsigned best = ~0u;
+    unsigned mask, i;
+
+    for (mask = 0; mask < (1u << graph->num_nodes); mask++)
+    {
+        bool valid = TRUE;
+
+        for (i = 0; i < graph->num_nodes; i++)
+        {
+            OPMGR_PLACEMENT_NODE *node = &graph->nodes[i];
+
+            node->proc = (uint8)((mask >> i) & 1);
+            if ((node->pin != OPMGR_PLACEMENT_PIN_NONE) && (node->pin != node->proc))
+            {
+                valid = FALSE;
+            }
+        }
+
+        if (valid)
+        {
+            opmgr_placement_evaluate(graph, &cost);
+            if (peak_kips(&cost) < best)
+            {
+                best = peak_kips(&cost);
+            }
+        }
+    }
+    return best;
+}
+
+/* Random graphs: the placement keeps pins, reports the cost of what it
+ * chose and is never worse than all on P0. How close it gets to the best
+ * peak load is reported. */
+static int test_random(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[RANDOM_MAX_NODES];
+    OPMGR_PLACEMENT_EDGE edges[2 * RANDOM_MAX_NODES];
+    OPMGR_PLACEMENT_GRAPH graph;
+    OPMGR_PLACEMENT_COST cost, check;
+    unsigned optimal = 0;
+    double worst = 1.0;
+    int failures = 0;
+    unsigned run, i;
+
+    for (run = 0; run < RANDOM_GRAPHS; run++)
+    {
+        unsigned num_nodes = 2 + random_below(RANDOM_MAX_NODES - 1);
+        unsigned num_edges = random_below(2 * num_nodes);
+        unsigned single, peak, best;
+
+        for (i = 0; i < num_nodes; i++)
+        {
+            uint8 pin = (random_below(6) == 0) ? (uint8)random_below(2) :
+                                                 OPMGR_PLACEMENT_PIN_NONE;
+
+            make_node(&nodes[i], 100 + random_below(HEAVY_KIPS), pin);
+        }
+        for (i = 0; i < num_edges; i++)
+        {
+            uint8 source = (uint8)random_below(num_nodes + 1);
+            uint8 sink = (uint8)random_below(num_nodes + 1);
+
+            make_edge(&edges[i],
+                      (source == num_nodes) ? OPMGR_PLACEMENT_REAL_EP : source,
+                      (sink == num_nodes) ? OPMGR_PLACEMENT_REAL_EP : sink,
+                      8000 * (1 + random_below(12)));
+        }
+        make_graph(&graph, nodes, num_nodes, edges, num_edges);
+
+        for (i = 0; i < num_nodes; i++)
+        {
+            nodes[i].proc = (nodes[i].pin == OPMGR_PLACEMENT_PIN_NONE) ? 0 : nodes[i].pin;
+        }
+        opmgr_placement_evaluate(&graph, &check);
+        single = peak_kips(&check);
+
+        if (!opmgr_placement_partition(&graph, &cost))
+        {
+            printf("FAIL: random %u: no placement\n", run);
+            failures++;
+            continue;
+        }
+
+        opmgr_placement_evaluate(&graph, &check);
+        peak = peak_kips(&cost);
+
+        for (i = 0; i < num_nodes; i++)
+        {
+            if ((nodes[i].pin != OPMGR_PLACEMENT_PIN_NONE) && (nodes[i].proc != nodes[i].pin))
+            {
+                printf("FAIL: random %u: pinned node %u moved\n", run, i);
+                failures++;
+            }
+        }
+        if ((peak_kips(&check) != peak) || (check.crossings != cost.crossings))
+        {
+            printf("FAIL: random %u: reported cost is not the placement's\n", run);
+            failures++;
+        }
+        if (peak > single)
+        {
+            printf("FAIL: random %u: peak %u worse than single core %u\n",
+                   run, peak, single);
+            failures++;
+        }
+
+        best = exhaustive_peak(&graph);
+        if (peak == best)
+        {
+            optimal++;
+        }
+        else if ((double)peak / best > worst)
+        {
+            worst = (double)peak / best;
+        }
+    }
+
+    printf("Random graphs: %u of %u at the best peak load, worst %.3f of best\n",
+           optimal, RANDOM_GRAPHS, worst);
+    return failures;
+}
+
+/* Time the partition of a full graph: a chain through every operator. */
+static int time_partition(void)
+{
+    OPMGR_PLACEMENT_NODE nodes[OPMGR_PLACEMENT_MAX_NODES];
+    OPMGR_PLACEMENT_EDGE edges[OPMGR_PLACEMENT_MAX_NODES + 1];
+    OPMGR_PLACEMENT_GRAPH graph;
+    clock_t start;
+    double seconds;
+    unsigned run, i;
+
+    for (i = 0; i < OPMGR_PLACEMENT_MAX_NODES; i++)
+    {
+        make_node(&nodes[i], 100 + random_below(HEAVY_KIPS), OPMGR_PLACEMENT_PIN_NONE);
+        make_edge(&edges[i], (uint8)(i ? i - 1 : OPMGR_PLACEMENT_REAL_EP),
+                  (uint8)i, 48000);
+    }
+    make_edge(&edges[i], (uint8)(i - 1), OPMGR_PLACEMENT_REAL_EP, 48000);
+    make_graph(&graph, nodes, OPMGR_PLACEMENT_MAX_NODES, edges, i + 1);
+
+    start = clock();
+    for (run = 0; run < TIMING_RUNS; run++)
+    {
+        (void)opmgr_placement_partition(&graph, NULL);
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Partition of %u operators: %.1f us\n", OPMGR_PLACEMENT_MAX_NODES,
+           seconds * 1e6 / TIMING_RUNS);
+    return 0;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int main(void)
+{
+    int failures = 0;
+
+    failures += test_split_chains();
+    failures += test_light_chain();
+    failures += test_pins();
+    failures += test_memory_limit();
+    failures += test_malformed();
+    failures += test_connect_moves();
+    failures += test_connect_stays();
+    failures += test_connect_single_core();
+    failures += test_connection_tracking();
+    failures += test_defer_limits();
+    failures += sim_failures;
+    failures += test_random();
+    failures += time_partition();
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -14,6 +14,9 @@ Include Files
 */
 
 #include "opmgr_private.h"
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+#include "opmgr_placement.h"
+#endif
 
 /****************************************************************************
 Private Type Declarations
@@ -707,6 +710,9 @@ bool opmgr_destroy_op_endpoints(OPERATOR_DATA* op_data)
            Nothing to do, so avoid going through stream_destroy_
            all_operators_endpoints, and return TRUE here.
         */
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT)
+        opmgr_placement_destroyed(op_data->id);
+#endif
         return TRUE;
     }
 #endif
@@ -715,9 +721,20 @@ bool opmgr_destroy_op_endpoints(OPERATOR_DATA* op_data)
      * the graph to work out what the current topology is. If the sources went
      * first then we might end up with a chain flopping around we don't know about.
      */
-    return stream_destroy_all_operators_endpoints(INT_TO_EXT_OPID(op_data->id),
-                                                    op_data->cap_data->max_sinks,
-                                                    op_data->cap_data->max_sources);
+    if (!stream_destroy_all_operators_endpoints(INT_TO_EXT_OPID(op_data->id),
+                                                op_data->cap_data->max_sinks,
+                                                op_data->cap_data->max_sources))
+    {
+        return FALSE;
+    }
+
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+    if (KIP_PRIMARY_CONTEXT())
+    {
+        opmgr_placement_destroyed(op_data->id);
+    }
+#endif
+    return TRUE;
 }
 
 
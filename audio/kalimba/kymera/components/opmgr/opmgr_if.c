@@ -24,6 +24,10 @@ Include Files
 #include "aov_task.h"
 #endif
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+#include "opmgr_placement.h"
+#endif
+
 /****************************************************************************
 Private type definitions
 */
@@ -822,6 +826,19 @@ void opmgr_start_operator(unsigned int con_id, unsigned num_ops, unsigned int *o
 {
     PL_PRINT_P0(TR_OPMGR, "Opmgr: Start Operator(s).\n");
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+    /* A running operator is not moved, even if it was never connected */
+    if (KIP_PRIMARY_CONTEXT())
+    {
+        unsigned i;
+
+        for (i = 0; i < num_ops; i++)
+        {
+            opmgr_placement_fix(EXT_TO_INT_OPID(op_list[i]));
+        }
+    }
+#endif /* INSTALL_OPMGR_AUTO_PLACEMENT && INSTALL_DUAL_CORE_SUPPORT */
+
     opmgr_issue_list_cmd(OPCMD_START, MP_MSG_ID_START_OPERATOR_REQ, con_id, num_ops, op_list, callback, NULL);
 }
 
@@ -1160,6 +1177,9 @@ extern void opmgr_create_operator_ex(unsigned int con_id, CAP_ID cap_id,
     unsigned int priority = LOWEST_PRIORITY;
     unsigned processor_id = 0;
     unsigned int i;
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+    bool processor_given = FALSE;
+#endif
 
     patch_fn_shared(opmgr);
 
@@ -1199,6 +1219,9 @@ extern void opmgr_create_operator_ex(unsigned int con_id, CAP_ID cap_id,
                 }
 #endif /* #ifdef INSTALL_DUAL_CORE_SUPPORT */
                 processor_id = (unsigned int)info[i].value;
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+                processor_given = TRUE;
+#endif
 
                 /* pack the processor id into the connection id for both sender/receiver,
                  * higher byte represents receiver, lower byte represents sender
@@ -1292,6 +1315,22 @@ extern void opmgr_create_operator_ex(unsigned int con_id, CAP_ID cap_id,
     }
 #endif /* INSTALL_CAP_DOWNLOAD_MGR */
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+    /* When the client did not choose the processor the operator is created
+     * on P0 and placed when it is first connected. */
+    if (KIP_PRIMARY_CONTEXT() && !processor_given && opmgr_placement_cap_movable(cap_id))
+    {
+        OPERATOR_DATA *head = oplist_head;
+
+        opmgr_create_operator_post_dnld(con_id, cap_id, op_id, priority, processor_id, callback);
+        if (oplist_head != head)
+        {
+            opmgr_placement_defer(oplist_head->id, priority);
+        }
+        return;
+    }
+#endif /* INSTALL_OPMGR_AUTO_PLACEMENT && INSTALL_DUAL_CORE_SUPPORT */
+
     /* note that in multicore case, priority becomes redundantly fished out of keys until that gets sorted out */
     opmgr_create_operator_post_dnld(con_id, cap_id, op_id, priority, processor_id, callback);
 }
@@ -1609,6 +1648,14 @@ void opmgr_operator_message(unsigned int con_id, unsigned op_id, unsigned num_pa
             return;
         }
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+        /* Kept to send again if the operator moves when it is connected */
+        if (KIP_PRIMARY_CONTEXT())
+        {
+            opmgr_placement_log_message(cur_op->id, num_params, params);
+        }
+#endif /* INSTALL_OPMGR_AUTO_PLACEMENT && INSTALL_DUAL_CORE_SUPPORT */
+
 #if defined(INSTALL_DUAL_CORE_SUPPORT) || defined(AUDIO_SECOND_CORE)
         /* If the message is not to local processor, forward the message to
          * remote processor's operators via KIP. We must not end up here if we
@@ -0,0 +1,1260 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  opmgr_placement.c
+ * \ingroup  opmgr
+ *
+ * Automatic dual-core operator placement. <br>
+ */
+
+/****************************************************************************
+Include Files
+*/
+
+#include "opmgr_placement.h"
+#include "operator_prim.h"
+#include "cap_id_prim.h"
+
+#ifndef DESKTOP_TEST_BUILD
+#include "opmgr_private.h"
+#include "stream/stream_endpoint.h"
+#include "stream/stream.h"
+#include "patch.h"
+#endif
+
+#if defined(PROFILER_ON) && !defined(DESKTOP_TEST_BUILD)
+#include "clk_mgr/clk_mgr.h"
+#endif
+
+/****************************************************************************
+Private Macro Declarations
+*/
+
+/* Processor an edge terminal lives on. Real endpoints are owned by P0. */
+#define PLACEMENT_TERMINAL_PROC(g, idx) \
+            (((idx) == OPMGR_PLACEMENT_REAL_EP) ? 0 : (g)->nodes[(idx)].proc)
+
+#define PLACEMENT_TERMINAL_VALID(g, idx) \
+            (((idx) == OPMGR_PLACEMENT_REAL_EP) || ((idx) < (g)->num_nodes))
+
+#ifndef DESKTOP_TEST_BUILD
+/* Internal ID of the operator of an endpoint, 0 for a real endpoint. */
+#define PLACEMENT_EP_OP(ep_id) \
+            (STREAM_EP_IS_OPEP_ID(ep_id) ? EXT_TO_INT_OPID(ep_id) : 0)
+#endif
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/* Figure of merit of a placement, compared field by field in this order. */
+typedef struct
+{
+    /* Words by which the placement exceeds the memory budgets. */
+    unsigned overflow;
+    /* Load of the busiest processor. */
+    unsigned peak_kips;
+    /* Number of KIP crossings. */
+    unsigned crossings;
+    /* Load summed across processors. */
+    unsigned total_kips;
+} PLACEMENT_SCORE;
+
+/* A connection that has been made, between external endpoint IDs. */
+typedef struct
+{
+    unsigned transform_id;
+    unsigned source_id;
+    unsigned sink_id;
+} PLACEMENT_CONNECTION;
+
+/* An operator waiting for placement. op_id is 0 for a free entry. */
+typedef struct
+{
+    unsigned op_id;
+    unsigned priority;
+    /* Operator messages sent to it, each preceded by its length */
+    unsigned *log;
+    unsigned log_words;
+} PLACEMENT_PENDING;
+
+#ifndef DESKTOP_TEST_BUILD
+typedef bool (*PLACEMENT_CONNECT_CBACK)(unsigned con_id, unsigned status,
+                                        unsigned transform_id);
+
+/* A connect request taken over. callback is NULL for a free entry. */
+typedef struct
+{
+    PLACEMENT_CONNECT_CBACK callback;
+    unsigned con_id;
+    unsigned source_id;
+    unsigned sink_id;
+} PLACEMENT_REQUEST;
+
+/* An operator being moved, with what it takes to create it again. */
+typedef struct
+{
+    unsigned op_id;
+    unsigned cap_id;
+    /* Connection that created it */
+    unsigned con_id;
+    unsigned priority;
+    uint8 proc;
+    unsigned *log;
+    unsigned log_words;
+} PLACEMENT_MOVE_OP;
+
+/* The moves made before a connect request is passed on. */
+typedef struct
+{
+    PLACEMENT_REQUEST *req;
+    /* Only the operators of the connection can move */
+    PLACEMENT_MOVE_OP ops[2];
+    unsigned num_ops;
+    unsigned current;
+    /* Next message of the current operator to send again */
+    unsigned log_pos;
+    unsigned ext_op_id;
+    OPERATOR_CREATE_EX_INFO keys[2];
+} PLACEMENT_MOVE;
+#endif /* !DESKTOP_TEST_BUILD */
+
+/****************************************************************************
+Private Variable Definitions
+*/
+
+static PLACEMENT_CONNECTION placement_connections[OPMGR_PLACEMENT_MAX_CONNECTIONS];
+static unsigned placement_num_connections;
+
+static PLACEMENT_PENDING placement_pending[OPMGR_PLACEMENT_MAX_PENDING];
+
+/* Capabilities only available on P0: the SCO endpoints and the A2DP codecs
+ * are owned by the primary processor. */
+static const unsigned placement_p0_caps[] =
+{
+    CAP_ID_SCO_SEND,
+    CAP_ID_SCO_RCV,
+    CAP_ID_WBS_ENC,
+    CAP_ID_WBS_DEC,
+    CAP_ID_SBC_DECODER,
+    CAP_ID_AAC_DECODER,
+    CAP_ID_APTX_CLASSIC_DECODER,
+    CAP_ID_APTX_LOW_LATENCY_DECODER,
+    CAP_ID_APTXHD_DECODER,
+    CAP_ID_APTX_CLASSIC_MONO_DECODER,
+    CAP_ID_APTX_CLASSIC_MONO_DECODER_NO_AUTOSYNC,
+    CAP_ID_APTX_CLASSIC_ENCODER,
+    CAP_ID_APTXHD_ENCODER
+};
+
+#ifndef DESKTOP_TEST_BUILD
+static PLACEMENT_REQUEST placement_requests[OPMGR_PLACEMENT_MAX_REQUESTS];
+
+/* Moves in progress, only one connect request moves operators at a time */
+static PLACEMENT_MOVE *placement_move_state;
+#endif /* !DESKTOP_TEST_BUILD */
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Reduce a full cost to the figure of merit used for comparison. */
+static void placement_score(const OPMGR_PLACEMENT_GRAPH *graph,
+                            PLACEMENT_SCORE *score)
+{
+    OPMGR_PLACEMENT_COST cost;
+    unsigned p;
+
+    opmgr_placement_evaluate(graph, &cost);
+
+    score->overflow = 0;
+    score->peak_kips = 0;
+    score->total_kips = 0;
+    score->crossings = cost.crossings;
+
+    for (p = 0; p < graph->num_procs; p++)
+    {
+        if ((graph->mem_limit[p] != 0) && (cost.mem_words[p] > graph->mem_limit[p]))
+        {
+            score->overflow += cost.mem_words[p] - graph->mem_limit[p];
+        }
+        if (cost.kips[p] > score->peak_kips)
+        {
+            score->peak_kips = cost.kips[p];
+        }
+        score->total_kips += cost.kips[p];
+    }
+}
+
+/* TRUE if a is a strictly better placement than b. */
+static bool placement_score_better(const PLACEMENT_SCORE *a,
+                                   const PLACEMENT_SCORE *b)
+{
+    if (a->overflow != b->overflow)
+    {
+        return a->overflow < b->overflow;
+    }
+    if (a->peak_kips != b->peak_kips)
+    {
+        return a->peak_kips < b->peak_kips;
+    }
+    if (a->crossings != b->crossings)
+    {
+        return a->crossings < b->crossings;
+    }
+    return a->total_kips < b->total_kips;
+}
+
+/* Move a node to the next processor. With two processors this is a swap of
+ * sides, so applying it twice restores the original placement. */
+static void placement_move(const OPMGR_PLACEMENT_GRAPH *graph, unsigned idx)
+{
+    OPMGR_PLACEMENT_NODE *node = &graph->nodes[idx];
+
+    node->proc = (uint8)((node->proc + 1) % graph->num_procs);
+}
+
+static void placement_unmove(const OPMGR_PLACEMENT_GRAPH *graph, unsigned idx)
+{
+    OPMGR_PLACEMENT_NODE *node = &graph->nodes[idx];
+
+    node->proc = (uint8)((node->proc + graph->num_procs - 1) % graph->num_procs);
+}
+
+/* Check node pins and edge terminals refer to things that exist. */
+static bool placement_validate(const OPMGR_PLACEMENT_GRAPH *graph)
+{
+    unsigned i;
+
+    if ((graph->num_procs == 0) || (graph->num_procs > OPMGR_PLACEMENT_NUM_PROCS) ||
+        (graph->num_nodes > OPMGR_PLACEMENT_MAX_NODES) ||
+        ((graph->num_nodes != 0) && (graph->nodes == NULL)) ||
+        ((graph->num_edges != 0) && (graph->edges == NULL)))
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < graph->num_nodes; i++)
+    {
+        unsigned pin = graph->nodes[i].pin;
+
+        if ((pin != OPMGR_PLACEMENT_PIN_NONE) && (pin >= graph->num_procs))
+        {
+            return FALSE;
+        }
+    }
+
+    for (i = 0; i < graph->num_edges; i++)
+    {
+        if (!PLACEMENT_TERMINAL_VALID(graph, graph->edges[i].source) ||
+            !PLACEMENT_TERMINAL_VALID(graph, graph->edges[i].sink))
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/*
+ * One refinement pass. Every free node is moved exactly once, always picking
+ * the move that gives the best resulting placement even if it is worse than
+ * the current one, so that the pass can climb out of a local minimum. The
+ * prefix of moves that reached the best placement is then kept and the rest
+ * is undone. Returns TRUE if the pass improved on the starting placement.
+ */
+static bool placement_refine_pass(const OPMGR_PLACEMENT_GRAPH *graph,
+                                  PLACEMENT_SCORE *best)
+{
+    bool locked[OPMGR_PLACEMENT_MAX_NODES];
+    uint8 order[OPMGR_PLACEMENT_MAX_NODES];
+    unsigned num_moves = 0, best_moves = 0;
+    unsigned i;
+
+    for (i = 0; i < graph->num_nodes; i++)
+    {
+        locked[i] = (graph->nodes[i].pin != OPMGR_PLACEMENT_PIN_NONE);
+    }
+
+    for (;;)
+    {
+        PLACEMENT_SCORE step_best, trial;
+        unsigned step_idx = graph->num_nodes;
+
+        for (i = 0; i < graph->num_nodes; i++)
+        {
+            if (locked[i])
+            {
+                continue;
+            }
+
+            placement_move(graph, i);
+            placement_score(graph, &trial);
+            placement_unmove(graph, i);
+
+            if ((step_idx == graph->num_nodes) ||
+                placement_score_better(&trial, &step_best))
+            {
+                step_best = trial;
+                step_idx = i;
+            }
+        }
+
+        if (step_idx == graph->num_nodes)
+        {
+            /* Every free node has moved once in this pass */
+            break;
+        }
+
+        placement_move(graph, step_idx);
+        locked[step_idx] = TRUE;
+        order[num_moves++] = (uint8)step_idx;
+
+        if (placement_score_better(&step_best, best))
+        {
+            *best = step_best;
+            best_moves = num_moves;
+        }
+    }
+
+    /* Roll back the moves made after the best placement was reached */
+    while (num_moves > best_moves)
+    {
+        placement_unmove(graph, order[--num_moves]);
+    }
+
+    return (best_moves != 0);
+}
+
+static PLACEMENT_PENDING *placement_find_pending(unsigned op_id)
+{
+    unsigned i;
+
+    if (op_id == 0)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < OPMGR_PLACEMENT_MAX_PENDING; i++)
+    {
+        if (placement_pending[i].op_id == op_id)
+        {
+            return &placement_pending[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void placement_drop_pending(PLACEMENT_PENDING *pending)
+{
+#ifndef DESKTOP_TEST_BUILD
+    pfree(pending->log);
+#endif
+    pending->op_id = 0;
+    pending->log = NULL;
+    pending->log_words = 0;
+}
+
+/* Graph terminal of an operator: OPMGR_PLACEMENT_REAL_EP for a real
+ * endpoint, or num_ops if the operator is not in the workspace. */
+static unsigned placement_find_node(const OPMGR_PLACEMENT_WORKSPACE *ws,
+                                    unsigned num_ops, unsigned op_id)
+{
+    unsigned i;
+
+    if (op_id == 0)
+    {
+        return OPMGR_PLACEMENT_REAL_EP;
+    }
+
+    for (i = 0; i < num_ops; i++)
+    {
+        if (ws->ops[i].op_id == op_id)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/* Add a connection to the graph unless one of its operators is unknown. */
+static unsigned placement_add_edge(OPMGR_PLACEMENT_WORKSPACE *ws,
+                                   unsigned num_ops, unsigned num_edges,
+                                   unsigned source_op, unsigned sink_op)
+{
+    unsigned source = placement_find_node(ws, num_ops, source_op);
+    unsigned sink = placement_find_node(ws, num_ops, sink_op);
+
+    if ((source == num_ops) || (sink == num_ops))
+    {
+        return num_edges;
+    }
+
+    ws->edges[num_edges].source = (uint8)source;
+    ws->edges[num_edges].sink = (uint8)sink;
+    ws->edges[num_edges].words_per_sec = OPMGR_PLACEMENT_DEFAULT_RATE;
+    ws->edges[num_edges].buffer_words = 0;
+    return num_edges + 1;
+}
+
+#ifndef DESKTOP_TEST_BUILD
+/* Load estimate of an existing operator. An operator that has not run yet
+ * reads 0 on its profiler, so it gets the default estimate as well. */
+static unsigned placement_op_kips(const OPERATOR_DATA *op)
+{
+#ifdef PROFILER_ON
+    unsigned kips;
+
+    if (opmgr_placement_measured_kips(INT_TO_EXT_OPID(op->id), &kips) &&
+        (kips != 0))
+    {
+        return kips;
+    }
+#else
+    NOT_USED(op);
+#endif
+    return OPMGR_PLACEMENT_DEFAULT_KIPS;
+}
+
+/* Add an existing operator to the workspace, unless it is already there. */
+static void placement_add_op(OPMGR_PLACEMENT_WORKSPACE *ws, unsigned *num_ops,
+                             const OPERATOR_DATA *op)
+{
+    OPMGR_PLACEMENT_OP *entry;
+
+    if ((op == NULL) || (*num_ops >= OPMGR_PLACEMENT_MAX_NODES) ||
+        (placement_find_node(ws, *num_ops, op->id) != *num_ops))
+    {
+        return;
+    }
+
+    entry = &ws->ops[(*num_ops)++];
+    entry->op_id = op->id;
+    entry->cap_id = op->cap_data->id;
+    entry->kips = placement_op_kips(op);
+    entry->proc = (uint8)op->processor_id;
+    entry->movable = FALSE;
+}
+
+static bool placement_connect_cback(unsigned con_id, unsigned status,
+                                    unsigned transform_id);
+static void placement_move_next(void);
+
+/* Hand the connect request on to the streams, now that the operators are
+ * where they should be. */
+static void placement_pass_on(PLACEMENT_REQUEST *req)
+{
+    stream_if_connect(req->con_id, req->source_id, req->sink_id,
+                      placement_connect_cback);
+}
+
+static void placement_end_moves(void)
+{
+    PLACEMENT_MOVE *move = placement_move_state;
+    unsigned i;
+
+    for (i = move->current; i < move->num_ops; i++)
+    {
+        pfree(move->ops[i].log);
+    }
+    placement_move_state = NULL;
+    pfree(move);
+}
+
+/* Give up on a connect request, an operator of it could not be created
+ * again anywhere. */
+static void placement_fail(void)
+{
+    PLACEMENT_REQUEST *req = placement_move_state->req;
+    PLACEMENT_CONNECT_CBACK callback = req->callback;
+
+    placement_end_moves();
+    req->callback = NULL;
+    callback(REVERSE_CONNECTION_ID(req->con_id), STATUS_CMD_FAILED, 0);
+}
+
+static void placement_op_moved(void)
+{
+    PLACEMENT_MOVE_OP *mop = &placement_move_state->ops[placement_move_state->current];
+
+    pfree(mop->log);
+    mop->log = NULL;
+    placement_move_state->current++;
+    placement_move_next();
+}
+
+static bool placement_replay_cback(unsigned con_id, unsigned status,
+                                   unsigned op_id, unsigned num_resp_params,
+                                   unsigned *resp_params);
+
+/* Send the next message the current operator was sent before it moved. */
+static void placement_replay_next(void)
+{
+    PLACEMENT_MOVE *move = placement_move_state;
+    PLACEMENT_MOVE_OP *mop = &move->ops[move->current];
+    unsigned *msg;
+
+    if (move->log_pos >= mop->log_words)
+    {
+        placement_op_moved();
+        return;
+    }
+
+    msg = &mop->log[move->log_pos];
+    move->log_pos += msg[0] + 1;
+    opmgr_operator_message(mop->con_id, INT_TO_EXT_OPID(mop->op_id),
+                           msg[0], &msg[1], placement_replay_cback);
+}
+
+static bool placement_replay_cback(unsigned con_id, unsigned status,
+                                   unsigned op_id, unsigned num_resp_params,
+                                   unsigned *resp_params)
+{
+    /* The sender had the answer when the message was first sent */
+    NOT_USED(con_id);
+    NOT_USED(status);
+    NOT_USED(op_id);
+    NOT_USED(num_resp_params);
+    NOT_USED(resp_params);
+
+    placement_replay_next();
+    return TRUE;
+}
+
+static bool placement_create_cback(unsigned con_id, unsigned status,
+                                   unsigned op_id);
+
+/* Create the current operator on the processor in its proc field. */
+static void placement_create(void)
+{
+    PLACEMENT_MOVE *move = placement_move_state;
+    PLACEMENT_MOVE_OP *mop = &move->ops[move->current];
+
+    move->keys[0].key = OPERATOR_CREATE_OP_PRIORITY;
+    move->keys[0].value = (int32)mop->priority;
+    move->keys[1].key = OPERATOR_CREATE_PROCESSOR_ID;
+    move->keys[1].value = (int32)mop->proc;
+
+    /* A dual core build takes a given operator ID as the internal one, so
+     * the operator keeps its ID. */
+    opmgr_create_operator_ex(mop->con_id, (CAP_ID)mop->cap_id, mop->op_id,
+                             2, move->keys, placement_create_cback);
+}
+
+static bool placement_create_cback(unsigned con_id, unsigned status,
+                                   unsigned op_id)
+{
+    PLACEMENT_MOVE *move = placement_move_state;
+    PLACEMENT_MOVE_OP *mop = &move->ops[move->current];
+
+    NOT_USED(con_id);
+    NOT_USED(op_id);
+
+    if (status != STATUS_OK)
+    {
+        if (mop->proc != IPC_PROCESSOR_0)
+        {
+            /* Put it back where it was */
+            mop->proc = IPC_PROCESSOR_0;
+            placement_create();
+        }
+        else
+        {
+            L2_DBG_MSG1("opmgr_placement: failed to create op 0x%04x again",
+                        INT_TO_EXT_OPID(mop->op_id));
+            placement_fail();
+        }
+        return TRUE;
+    }
+
+    move->log_pos = 0;
+    placement_replay_next();
+    return TRUE;
+}
+
+static bool placement_destroy_cback(unsigned con_id, unsigned status,
+                                    unsigned count, unsigned err_code)
+{
+    NOT_USED(con_id);
+    NOT_USED(err_code);
+
+    if ((status != STATUS_OK) || (count != 1))
+    {
+        /* Still where it was, it is connected there */
+        placement_op_moved();
+        return TRUE;
+    }
+
+    placement_create();
+    return TRUE;
+}
+
+/* Move the next operator, or pass the request on once they have all moved. */
+static void placement_move_next(void)
+{
+    PLACEMENT_MOVE *move = placement_move_state;
+    PLACEMENT_REQUEST *req = move->req;
+    PLACEMENT_MOVE_OP *mop;
+
+    if (move->current >= move->num_ops)
+    {
+        placement_end_moves();
+        placement_pass_on(req);
+        return;
+    }
+
+    mop = &move->ops[move->current];
+    if (get_op_data_from_id(mop->op_id) == NULL)
+    {
+        /* Destroyed while an earlier operator was moving */
+        placement_op_moved();
+        return;
+    }
+
+    move->ext_op_id = INT_TO_EXT_OPID(mop->op_id);
+    opmgr_destroy_operator(mop->con_id, 1, &move->ext_op_id,
+                           placement_destroy_cback);
+}
+
+/* Place the operators of a connect request. Returns TRUE if some of them
+ * are being moved, the request is then passed on once they have moved. */
+static bool placement_start_moves(PLACEMENT_REQUEST *req)
+{
+    unsigned source_op = PLACEMENT_EP_OP(req->source_id);
+    unsigned sink_op = PLACEMENT_EP_OP(req->sink_id);
+    OPMGR_PLACEMENT_WORKSPACE *ws;
+    PLACEMENT_MOVE *move = NULL;
+    const OPERATOR_DATA *op;
+    unsigned num_ops = 0, num_procs, i;
+
+    if (!opmgr_placement_is_pending(source_op) &&
+        !opmgr_placement_is_pending(sink_op))
+    {
+        return FALSE;
+    }
+
+    ws = xpnew(OPMGR_PLACEMENT_WORKSPACE);
+    if (ws != NULL)
+    {
+        placement_add_op(ws, &num_ops, get_anycore_op_data_from_id(source_op));
+        placement_add_op(ws, &num_ops, get_anycore_op_data_from_id(sink_op));
+        for (op = oplist_head; op != NULL; op = op->next)
+        {
+            placement_add_op(ws, &num_ops, op);
+        }
+        for (op = remote_oplist_head; op != NULL; op = op->next)
+        {
+            placement_add_op(ws, &num_ops, op);
+        }
+
+        num_procs = kip_aux_processor_has_started(IPC_PROCESSOR_1) ?
+                    OPMGR_PLACEMENT_NUM_PROCS : 1;
+        if (opmgr_placement_decide(ws, num_ops, num_procs,
+                                   source_op, sink_op) != 0)
+        {
+            move = xzpnew(PLACEMENT_MOVE);
+        }
+    }
+
+    if (move != NULL)
+    {
+        for (i = 0; i < num_ops; i++)
+        {
+            PLACEMENT_PENDING *pending = placement_find_pending(ws->ops[i].op_id);
+            PLACEMENT_MOVE_OP *mop = &move->ops[move->num_ops];
+
+            if (!ws->ops[i].movable || (pending == NULL))
+            {
+                continue;
+            }
+
+            mop->op_id = ws->ops[i].op_id;
+            mop->cap_id = ws->ops[i].cap_id;
+            mop->con_id = get_op_data_from_id(mop->op_id)->con_id;
+            mop->priority = pending->priority;
+            mop->proc = ws->ops[i].proc;
+            mop->log = pending->log;
+            mop->log_words = pending->log_words;
+            pending->log = NULL;
+            move->num_ops++;
+        }
+        move->req = req;
+        placement_move_state = move;
+    }
+
+    /* Moving or not, the operators of the connection are placed now */
+    opmgr_placement_fix(source_op);
+    opmgr_placement_fix(sink_op);
+    pfree(ws);
+
+    if (move == NULL)
+    {
+        return FALSE;
+    }
+
+    placement_move_next();
+    return TRUE;
+}
+
+static bool placement_connect_cback(unsigned con_id, unsigned status,
+                                    unsigned transform_id)
+{
+    PLACEMENT_CONNECT_CBACK callback;
+    PLACEMENT_REQUEST *req = NULL;
+    unsigned i;
+
+    for (i = 0; i < OPMGR_PLACEMENT_MAX_REQUESTS; i++)
+    {
+        PLACEMENT_REQUEST *entry = &placement_requests[i];
+
+        if ((entry->callback != NULL) &&
+            ((placement_move_state == NULL) || (placement_move_state->req != entry)) &&
+            (GET_UNPACKED_CONID(con_id) == UNPACK_REVERSE_CONID(entry->con_id)))
+        {
+            req = entry;
+            break;
+        }
+    }
+
+    if (req == NULL)
+    {
+        return TRUE;
+    }
+
+    if (status == STATUS_OK)
+    {
+        opmgr_placement_connected(transform_id, req->source_id, req->sink_id);
+    }
+
+    callback = req->callback;
+    req->callback = NULL;
+    return callback(con_id, status, transform_id);
+}
+#endif /* !DESKTOP_TEST_BUILD */
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/****************************************************************************
+ *
+ * opmgr_placement_kip_kips
+ *
+ */
+unsigned opmgr_placement_kip_kips(unsigned words_per_sec)
+{
+    return OPMGR_PLACEMENT_KIP_FIXED_KIPS +
+           (words_per_sec * OPMGR_PLACEMENT_KIP_CYCLES_PER_WORD) / 1000;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_evaluate
+ *
+ */
+void opmgr_placement_evaluate(const OPMGR_PLACEMENT_GRAPH *graph,
+                              OPMGR_PLACEMENT_COST *cost)
+{
+    unsigned i;
+
+    for (i = 0; i < OPMGR_PLACEMENT_NUM_PROCS; i++)
+    {
+        cost->kips[i] = 0;
+        cost->mem_words[i] = 0;
+    }
+    cost->crossings = 0;
+
+    for (i = 0; i < graph->num_nodes; i++)
+    {
+        const OPMGR_PLACEMENT_NODE *node = &graph->nodes[i];
+
+        cost->kips[node->proc] += node->kips;
+        cost->mem_words[node->proc] += node->mem_words;
+    }
+
+    for (i = 0; i < graph->num_edges; i++)
+    {
+        const OPMGR_PLACEMENT_EDGE *edge = &graph->edges[i];
+        unsigned src_proc = PLACEMENT_TERMINAL_PROC(graph, edge->source);
+        unsigned sink_proc = PLACEMENT_TERMINAL_PROC(graph, edge->sink);
+
+        if (src_proc != sink_proc)
+        {
+            unsigned kip_kips = opmgr_placement_kip_kips(edge->words_per_sec);
+
+            /* Both sides pay for the kick and the shadow endpoint, the
+             * receiving side holds the extra KIP buffer. */
+            cost->kips[src_proc] += kip_kips;
+            cost->kips[sink_proc] += kip_kips;
+            cost->mem_words[sink_proc] += edge->buffer_words;
+            cost->crossings++;
+        }
+    }
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_partition
+ *
+ */
+bool opmgr_placement_partition(OPMGR_PLACEMENT_GRAPH *graph,
+                               OPMGR_PLACEMENT_COST *cost)
+{
+    PLACEMENT_SCORE best;
+    unsigned i, pass;
+
+    if (!placement_validate(graph))
+    {
+        return FALSE;
+    }
+
+    /* Start from the single core placement, it has no crossings at all */
+    for (i = 0; i < graph->num_nodes; i++)
+    {
+        OPMGR_PLACEMENT_NODE *node = &graph->nodes[i];
+
+        node->proc = (node->pin == OPMGR_PLACEMENT_PIN_NONE) ? 0 : node->pin;
+    }
+
+    placement_score(graph, &best);
+
+    if (graph->num_procs > 1)
+    {
+        for (pass = 0; pass < OPMGR_PLACEMENT_MAX_PASSES; pass++)
+        {
+            if (!placement_refine_pass(graph, &best))
+            {
+                break;
+            }
+        }
+    }
+
+    if (cost != NULL)
+    {
+        opmgr_placement_evaluate(graph, cost);
+    }
+
+    return (best.overflow == 0);
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_create_key
+ *
+ */
+void opmgr_placement_create_key(const OPMGR_PLACEMENT_NODE *node,
+                                OPERATOR_CREATE_EX_INFO *info)
+{
+    info->key = OPERATOR_CREATE_PROCESSOR_ID;
+    info->value = (int32)node->proc;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_cap_movable
+ *
+ */
+bool opmgr_placement_cap_movable(unsigned cap_id)
+{
+    unsigned i;
+
+#if defined(INSTALL_CAP_DOWNLOAD_MGR) && !defined(DESKTOP_TEST_BUILD)
+    CAP_DOWNLOAD_STATUS status;
+
+    /* A downloaded capability is loaded for the processor it was asked for */
+    if (opmgr_get_download_cap_status(cap_id, &status))
+    {
+        return FALSE;
+    }
+#endif
+
+    for (i = 0; i < sizeof(placement_p0_caps) / sizeof(placement_p0_caps[0]); i++)
+    {
+        if (placement_p0_caps[i] == cap_id)
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_defer
+ *
+ */
+bool opmgr_placement_defer(unsigned op_id, unsigned priority)
+{
+    PLACEMENT_PENDING *free_entry = NULL;
+    unsigned i;
+
+    for (i = 0; i < OPMGR_PLACEMENT_MAX_PENDING; i++)
+    {
+        PLACEMENT_PENDING *pending = &placement_pending[i];
+
+        if (pending->op_id == op_id)
+        {
+            /* Left behind by an earlier operator with the same ID */
+            placement_drop_pending(pending);
+        }
+        if ((pending->op_id == 0) && (free_entry == NULL))
+        {
+            free_entry = pending;
+        }
+    }
+
+    if ((op_id == 0) || (free_entry == NULL))
+    {
+        return FALSE;
+    }
+
+    free_entry->op_id = op_id;
+    free_entry->priority = priority;
+    return TRUE;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_is_pending
+ *
+ */
+bool opmgr_placement_is_pending(unsigned op_id)
+{
+    return (placement_find_pending(op_id) != NULL);
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_fix
+ *
+ */
+void opmgr_placement_fix(unsigned op_id)
+{
+    PLACEMENT_PENDING *pending = placement_find_pending(op_id);
+
+    if (pending != NULL)
+    {
+        placement_drop_pending(pending);
+    }
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_decide
+ *
+ */
+unsigned opmgr_placement_decide(OPMGR_PLACEMENT_WORKSPACE *ws,
+                                unsigned num_ops, unsigned num_procs,
+                                unsigned source_op, unsigned sink_op)
+{
+    OPMGR_PLACEMENT_GRAPH graph;
+    unsigned num_edges = 0, num_moves = 0;
+    unsigned i;
+
+    if (num_ops > OPMGR_PLACEMENT_MAX_NODES)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < num_ops; i++)
+    {
+        OPMGR_PLACEMENT_OP *op = &ws->ops[i];
+        OPMGR_PLACEMENT_NODE *node = &ws->nodes[i];
+
+        op->movable = ((op->op_id == source_op) || (op->op_id == sink_op)) &&
+                      opmgr_placement_is_pending(op->op_id) &&
+                      opmgr_placement_cap_movable(op->cap_id);
+
+        node->cap_id = op->cap_id;
+        node->kips = op->kips;
+        node->mem_words = 0;
+        node->pin = op->movable ? OPMGR_PLACEMENT_PIN_NONE : op->proc;
+    }
+
+    for (i = 0; i < placement_num_connections; i++)
+    {
+        num_edges = placement_add_edge(ws, num_ops, num_edges,
+                        PLACEMENT_EP_OP(placement_connections[i].source_id),
+                        PLACEMENT_EP_OP(placement_connections[i].sink_id));
+    }
+    num_edges = placement_add_edge(ws, num_ops, num_edges, source_op, sink_op);
+
+    graph.nodes = ws->nodes;
+    graph.num_nodes = num_ops;
+    graph.edges = ws->edges;
+    graph.num_edges = num_edges;
+    graph.num_procs = num_procs;
+    graph.mem_limit[0] = 0;
+    graph.mem_limit[1] = 0;
+
+    if (!opmgr_placement_partition(&graph, NULL))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < num_ops; i++)
+    {
+        OPMGR_PLACEMENT_OP *op = &ws->ops[i];
+
+        if (!op->movable)
+        {
+            continue;
+        }
+
+        if (ws->nodes[i].proc == op->proc)
+        {
+            opmgr_placement_fix(op->op_id);
+            op->movable = FALSE;
+        }
+        else
+        {
+            op->proc = ws->nodes[i].proc;
+            num_moves++;
+        }
+    }
+
+    return num_moves;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_connected
+ *
+ */
+void opmgr_placement_connected(unsigned transform_id,
+                               unsigned source_id, unsigned sink_id)
+{
+    PLACEMENT_CONNECTION *conn;
+
+    if ((PLACEMENT_EP_OP(source_id) == 0 && PLACEMENT_EP_OP(sink_id) == 0) ||
+        (placement_num_connections >= OPMGR_PLACEMENT_MAX_CONNECTIONS))
+    {
+        return;
+    }
+
+    conn = &placement_connections[placement_num_connections++];
+    conn->transform_id = transform_id;
+    conn->source_id = source_id;
+    conn->sink_id = sink_id;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_disconnect_transforms
+ *
+ */
+void opmgr_placement_disconnect_transforms(unsigned count,
+                                           const unsigned *transforms)
+{
+    unsigned i = 0, t;
+
+    while (i < placement_num_connections)
+    {
+        for (t = 0; t < count; t++)
+        {
+            if (placement_connections[i].transform_id == transforms[t])
+            {
+                break;
+            }
+        }
+
+        if (t < count)
+        {
+            placement_connections[i] =
+                placement_connections[--placement_num_connections];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_disconnect_endpoints
+ *
+ */
+void opmgr_placement_disconnect_endpoints(unsigned source_id, unsigned sink_id)
+{
+    unsigned i = 0;
+
+    while (i < placement_num_connections)
+    {
+        const PLACEMENT_CONNECTION *conn = &placement_connections[i];
+
+        if (((source_id != 0) && (conn->source_id == source_id)) ||
+            ((sink_id != 0) && (conn->sink_id == sink_id)))
+        {
+            placement_connections[i] =
+                placement_connections[--placement_num_connections];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_destroyed
+ *
+ */
+void opmgr_placement_destroyed(unsigned op_id)
+{
+    unsigned i = 0;
+
+    opmgr_placement_fix(op_id);
+
+    while (i < placement_num_connections)
+    {
+        const PLACEMENT_CONNECTION *conn = &placement_connections[i];
+
+        if ((PLACEMENT_EP_OP(conn->source_id) == op_id) ||
+            (PLACEMENT_EP_OP(conn->sink_id) == op_id))
+        {
+            placement_connections[i] =
+                placement_connections[--placement_num_connections];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+#ifndef DESKTOP_TEST_BUILD
+/****************************************************************************
+ *
+ * opmgr_placement_log_message
+ *
+ */
+void opmgr_placement_log_message(unsigned op_id, unsigned num_params,
+                                 const unsigned *params)
+{
+    PLACEMENT_PENDING *pending = placement_find_pending(op_id);
+    unsigned *msg;
+
+    if (pending == NULL)
+    {
+        return;
+    }
+
+    if (pending->log_words + num_params + 1 > OPMGR_PLACEMENT_MAX_LOG_WORDS)
+    {
+        /* It could not be set up again elsewhere, so it stays */
+        placement_drop_pending(pending);
+        return;
+    }
+
+    if (pending->log == NULL)
+    {
+        pending->log = xpnewn(OPMGR_PLACEMENT_MAX_LOG_WORDS, unsigned);
+        if (pending->log == NULL)
+        {
+            placement_drop_pending(pending);
+            return;
+        }
+    }
+
+    msg = &pending->log[pending->log_words];
+    msg[0] = num_params;
+    memcpy(&msg[1], params, num_params * sizeof(unsigned));
+    pending->log_words += num_params + 1;
+}
+
+/****************************************************************************
+ *
+ * opmgr_placement_connect
+ *
+ */
+bool opmgr_placement_connect(unsigned con_id, unsigned source_id,
+                             unsigned sink_id,
+                             bool (*callback)(unsigned con_id,
+                                              unsigned status,
+                                              unsigned transform_id))
+{
+    PLACEMENT_REQUEST *req = NULL;
+    unsigned i;
+
+    patch_fn_shared(opmgr);
+
+    /* Requests passed on by the engine itself go through */
+    if (!KIP_PRIMARY_CONTEXT() || (callback == placement_connect_cback) ||
+        ((PLACEMENT_EP_OP(source_id) == 0) && (PLACEMENT_EP_OP(sink_id) == 0)))
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < OPMGR_PLACEMENT_MAX_REQUESTS; i++)
+    {
+        if (placement_requests[i].callback == NULL)
+        {
+            req = &placement_requests[i];
+            break;
+        }
+    }
+
+    if (req == NULL)
+    {
+        /* Made where the operators are, and not remembered */
+        opmgr_placement_fix(PLACEMENT_EP_OP(source_id));
+        opmgr_placement_fix(PLACEMENT_EP_OP(sink_id));
+        return FALSE;
+    }
+
+    req->callback = callback;
+    req->con_id = con_id;
+    req->source_id = source_id;
+    req->sink_id = sink_id;
+
+    if ((placement_move_state != NULL) || !placement_start_moves(req))
+    {
+        /* Nothing to move, or another request is moving operators: the
+         * operators of this one stay where they are. */
+        opmgr_placement_fix(PLACEMENT_EP_OP(source_id));
+        opmgr_placement_fix(PLACEMENT_EP_OP(sink_id));
+        placement_pass_on(req);
+    }
+
+    return TRUE;
+}
+#endif /* !DESKTOP_TEST_BUILD */
+
+#if defined(PROFILER_ON) && !defined(DESKTOP_TEST_BUILD)
+/****************************************************************************
+ *
+ * opmgr_placement_measured_kips
+ *
+ */
+bool opmgr_placement_measured_kips(unsigned ext_op_id, unsigned *kips)
+{
+    OPERATOR_DATA *op_data;
+    CLK_FREQ_MHZ freq;
+
+    patch_fn_shared(opmgr);
+
+    op_data = get_op_data_from_id(EXT_TO_INT_OPID(ext_op_id));
+    if ((op_data == NULL) || (op_data->profiler == NULL) ||
+        (op_data->profiler == UNINITIALISED_PROFILER))
+    {
+        return FALSE;
+    }
+
+    freq = clk_mgr_get_current_cpu_freq();
+    if (freq == FREQ_UNSPECIFIED)
+    {
+        return FALSE;
+    }
+
+    /* cpu_fraction is in thousandths of the processor, so at F MHz one
+     * thousandth is F KIPS. */
+    *kips = op_data->profiler->cpu_fraction * (unsigned)freq;
+    return TRUE;
+}
+#endif /* PROFILER_ON && !DESKTOP_TEST_BUILD */
@@ -0,0 +1,394 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  opmgr_placement.h
+ * \ingroup  opmgr
+ *
+ * Automatic dual-core operator placement. <br>
+ *
+ * Given a description of an operator graph (per-operator load and memory
+ * estimates plus the connections between operators), the placement engine
+ * chooses a processor for every operator such that the peak processor load
+ * is minimised. Every connection that ends up crossing processors is charged
+ * with the cost of its KIP data channel (extra kicks, buffer copy and the
+ * shadow buffer memory), so the engine only splits the graph where the load
+ * balance gained outweighs the crossing overhead.
+ *
+ * The partitioner itself only works on the caller supplied arrays, it does
+ * not allocate and it does not touch any operator state, so it can be built
+ * and exercised in a host test build (see host/opmgr_placement_host_test.c).
+ *
+ * On target, an operator created without the OPERATOR_CREATE_PROCESSOR_ID
+ * key is created on P0 and left unplaced until its first connection, when it
+ * is known what it works with. stream_if_connect() hands the request to
+ * opmgr_placement_connect(), which places the unplaced operators of the
+ * connection against the operators that already exist, pinned where they
+ * are, and the connections made so far. An operator that is better off on
+ * P1 is destroyed and created again there with the same ID, the operator
+ * messages it was sent are sent again, and then the connection is made.
+ * Only a connection that has been made is remembered, and it is forgotten
+ * when it is disconnected or one of its operators is destroyed.
+ */
+
+#ifndef OPMGR_PLACEMENT_H
+#define OPMGR_PLACEMENT_H
+
+/****************************************************************************
+Include Files
+*/
+#include "types.h"
+#include "opmgr/opmgr.h"
+
+/****************************************************************************
+Public Constant Declarations
+*/
+
+/** Number of processors the engine can distribute operators across. */
+#define OPMGR_PLACEMENT_NUM_PROCS           2
+
+/** Node pin value: the engine is free to choose the processor. */
+#define OPMGR_PLACEMENT_PIN_NONE            0xFF
+
+/** Edge terminal used for a real (hardware) endpoint. Real endpoints
+ *  always live on the primary processor. */
+#define OPMGR_PLACEMENT_REAL_EP             0xFF
+
+/** Upper bound on the number of operators in one placement request. */
+#define OPMGR_PLACEMENT_MAX_NODES           32
+
+/** Upper bound on the number of refinement passes. Each pass moves every
+ *  free operator at most once, so this bounds the run time for a graph. */
+#define OPMGR_PLACEMENT_MAX_PASSES          8
+
+/** Approximate cost of a KIP crossing on each processor, in KIPS, that does
+ *  not depend on the data rate (kick signal handling and shadow endpoint
+ *  scheduling). */
+#define OPMGR_PLACEMENT_KIP_FIXED_KIPS      150
+
+/** Approximate cost of moving one word through a KIP data channel, in
+ *  processor cycles. */
+#define OPMGR_PLACEMENT_KIP_CYCLES_PER_WORD 4
+
+/** Load assumed for an operator that has no profiler reading, in KIPS. */
+#define OPMGR_PLACEMENT_DEFAULT_KIPS        2000
+
+/** Data rate assumed for a recorded connection, in words per second. */
+#define OPMGR_PLACEMENT_DEFAULT_RATE        48000
+
+/** Number of connections remembered for placing later operators. */
+#define OPMGR_PLACEMENT_MAX_CONNECTIONS     32
+
+/** Number of operators that can wait for placement at the same time. An
+ *  operator created when they are all in use stays on P0. */
+#define OPMGR_PLACEMENT_MAX_PENDING         8
+
+/** Words of operator messages kept for an operator waiting for placement,
+ *  to send again if it moves. An operator sent more stays on P0. */
+#define OPMGR_PLACEMENT_MAX_LOG_WORDS       64
+
+/** Number of connect requests that can be in progress at the same time. */
+#define OPMGR_PLACEMENT_MAX_REQUESTS        4
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/** One operator in the graph to place. */
+typedef struct
+{
+    /** Capability ID, informational only. */
+    unsigned cap_id;
+
+    /** Processing load estimate in KIPS (thousands of instructions per
+     *  second). Use opmgr_placement_measured_kips() to refine an estimate
+     *  with profiler data when it is available. */
+    unsigned kips;
+
+    /** Memory required by the operator, in words. */
+    unsigned mem_words;
+
+    /** OPMGR_PLACEMENT_PIN_NONE, or the processor ID the operator must be
+     *  created on. */
+    uint8 pin;
+
+    /** Output: the processor chosen for the operator. */
+    uint8 proc;
+} OPMGR_PLACEMENT_NODE;
+
+/** One connection in the graph to place. */
+typedef struct
+{
+    /** Index of the source node, or OPMGR_PLACEMENT_REAL_EP. */
+    uint8 source;
+
+    /** Index of the sink node, or OPMGR_PLACEMENT_REAL_EP. */
+    uint8 sink;
+
+    /** Data rate through the connection, in words per second. */
+    unsigned words_per_sec;
+
+    /** Size of the connection buffer, in words. A crossing connection
+     *  needs this much again for the KIP side of the channel. */
+    unsigned buffer_words;
+} OPMGR_PLACEMENT_EDGE;
+
+/** Graph description and per processor budgets. */
+typedef struct
+{
+    OPMGR_PLACEMENT_NODE *nodes;
+    unsigned num_nodes;
+
+    const OPMGR_PLACEMENT_EDGE *edges;
+    unsigned num_edges;
+
+    /** Processors available; 1 places everything on P0. */
+    unsigned num_procs;
+
+    /** Memory budget for each processor in words, 0 for no limit. */
+    unsigned mem_limit[OPMGR_PLACEMENT_NUM_PROCS];
+} OPMGR_PLACEMENT_GRAPH;
+
+/** An existing operator, as given to opmgr_placement_decide(). */
+typedef struct
+{
+    /** Internal operator ID. */
+    unsigned op_id;
+
+    /** Capability ID. */
+    unsigned cap_id;
+
+    /** Processing load estimate in KIPS. */
+    unsigned kips;
+
+    /** The processor the operator is on. Output: the processor it should
+     *  be moved to. */
+    uint8 proc;
+
+    /** Output: TRUE if the operator was free to be placed. */
+    bool movable;
+} OPMGR_PLACEMENT_OP;
+
+/** Everything opmgr_placement_decide() works on, too big for the stack. */
+typedef struct
+{
+    /** The operators, those of the connection first. */
+    OPMGR_PLACEMENT_OP ops[OPMGR_PLACEMENT_MAX_NODES];
+
+    OPMGR_PLACEMENT_NODE nodes[OPMGR_PLACEMENT_MAX_NODES];
+
+    /** The connections made so far and the one being made. */
+    OPMGR_PLACEMENT_EDGE edges[OPMGR_PLACEMENT_MAX_CONNECTIONS + 1];
+} OPMGR_PLACEMENT_WORKSPACE;
+
+/** Summary of a placement. */
+typedef struct
+{
+    /** Load on each processor including KIP crossing overhead, in KIPS. */
+    unsigned kips[OPMGR_PLACEMENT_NUM_PROCS];
+
+    /** Memory used on each processor including KIP buffers, in words. */
+    unsigned mem_words[OPMGR_PLACEMENT_NUM_PROCS];
+
+    /** Number of connections crossing processors. */
+    unsigned crossings;
+} OPMGR_PLACEMENT_COST;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief  Partition the graph across the available processors.
+ *
+ * The proc field of every node is written. Pinned nodes keep their pin.
+ * Free nodes start on P0 and are then moved by repeated refinement passes
+ * (each free node moves at most once per pass, the best prefix of a pass is
+ * kept) until a pass brings no improvement.
+ *
+ * \param  graph  The graph to place.
+ * \param  cost   Optional, receives the cost of the chosen placement.
+ *
+ * \return TRUE if a placement within the memory limits was found, FALSE if
+ *         the graph is malformed or cannot fit.
+ */
+extern bool opmgr_placement_partition(OPMGR_PLACEMENT_GRAPH *graph,
+                                      OPMGR_PLACEMENT_COST *cost);
+
+/**
+ * \brief  Evaluate the current proc assignment of the graph.
+ *
+ * \param  graph  The graph, with the proc field of each node set.
+ * \param  cost   Receives the per processor load and memory.
+ */
+extern void opmgr_placement_evaluate(const OPMGR_PLACEMENT_GRAPH *graph,
+                                     OPMGR_PLACEMENT_COST *cost);
+
+/**
+ * \brief  Estimated per processor cost of carrying a connection over KIP.
+ *
+ * \param  words_per_sec  Data rate of the connection.
+ *
+ * \return Load in KIPS.
+ */
+extern unsigned opmgr_placement_kip_kips(unsigned words_per_sec);
+
+/**
+ * \brief  Fill in a create operator key which applies the placement of a node.
+ *
+ * \param  node  A placed node.
+ * \param  info  The key/value pair to fill in.
+ */
+extern void opmgr_placement_create_key(const OPMGR_PLACEMENT_NODE *node,
+                                       OPERATOR_CREATE_EX_INFO *info);
+
+/**
+ * \brief  Whether operators of a capability can be moved to P1.
+ *
+ * Capabilities whose endpoints or codecs are only available on P0 and
+ * downloaded capabilities, which are loaded for one processor, stay on P0.
+ *
+ * \param  cap_id  Capability ID.
+ *
+ * \return TRUE if an operator of the capability can run on P1.
+ */
+extern bool opmgr_placement_cap_movable(unsigned cap_id);
+
+/**
+ * \brief  Leave a new operator on P0 unplaced until it is first connected.
+ *
+ * \param  op_id     Internal ID of the operator.
+ * \param  priority  Priority it was created with, to create it again with.
+ *
+ * \return TRUE if it is waiting for placement, FALSE if there was no room
+ *         to record it, and it stays on P0.
+ */
+extern bool opmgr_placement_defer(unsigned op_id, unsigned priority);
+
+/**
+ * \brief  Whether an operator is waiting for placement.
+ *
+ * \param  op_id  Internal ID of the operator.
+ */
+extern bool opmgr_placement_is_pending(unsigned op_id);
+
+/**
+ * \brief  Leave an operator where it is from now on.
+ *
+ * \param  op_id  Internal ID of the operator.
+ */
+extern void opmgr_placement_fix(unsigned op_id);
+
+/**
+ * \brief  Place the operators of a connection that is being made.
+ *
+ * The operators of the connection that are waiting for placement and can
+ * run on P1 are free, every other operator is pinned where it is. The
+ * connections made so far and the new one are charged if they cross. Free
+ * operators that are best left where they are are fixed there. The others
+ * get the processor to move to in their proc field and keep waiting, the
+ * caller fixes them once it has moved them.
+ *
+ * \param  ws         ops[0 .. num_ops - 1] filled in, with the operators of
+ *                    the connection among them.
+ * \param  num_ops    Number of operators.
+ * \param  num_procs  Processors that have started.
+ * \param  source_op  Internal ID of the source operator, 0 for a real
+ *                    endpoint.
+ * \param  sink_op    Internal ID of the sink operator, 0 for a real endpoint.
+ *
+ * \return Number of operators to move.
+ */
+extern unsigned opmgr_placement_decide(OPMGR_PLACEMENT_WORKSPACE *ws,
+                                       unsigned num_ops, unsigned num_procs,
+                                       unsigned source_op, unsigned sink_op);
+
+/**
+ * \brief  Remember a connection that has been made.
+ *
+ * \param  transform_id  External ID of its transform.
+ * \param  source_id     External ID of the source endpoint.
+ * \param  sink_id       External ID of the sink endpoint.
+ */
+extern void opmgr_placement_connected(unsigned transform_id,
+                                      unsigned source_id, unsigned sink_id);
+
+/**
+ * \brief  Forget the connections of transforms being disconnected.
+ *
+ * \param  count       Number of transforms.
+ * \param  transforms  External transform IDs.
+ */
+extern void opmgr_placement_disconnect_transforms(unsigned count,
+                                                  const unsigned *transforms);
+
+/**
+ * \brief  Forget the connections of endpoints being disconnected.
+ *
+ * \param  source_id  External ID of the source endpoint, or 0.
+ * \param  sink_id    External ID of the sink endpoint, or 0.
+ */
+extern void opmgr_placement_disconnect_endpoints(unsigned source_id,
+                                                 unsigned sink_id);
+
+/**
+ * \brief  Forget an operator that is being destroyed, and its connections.
+ *
+ * \param  op_id  Internal ID of the operator.
+ */
+extern void opmgr_placement_destroyed(unsigned op_id);
+
+#ifndef DESKTOP_TEST_BUILD
+/**
+ * \brief  Keep an operator message sent to an operator waiting for
+ *         placement, to send it again if the operator moves.
+ *
+ * An operator whose messages do not fit stays where it is.
+ *
+ * \param  op_id       Internal ID of the operator.
+ * \param  num_params  Length of the message.
+ * \param  params      The message.
+ */
+extern void opmgr_placement_log_message(unsigned op_id, unsigned num_params,
+                                        const unsigned *params);
+
+/**
+ * \brief  Place the operators of a connection and make it.
+ *
+ * Called by stream_if_connect() before anything else. Unless it returns
+ * FALSE it has taken the request over: it moves the operators that need
+ * moving and then makes the request again itself, and the callback is
+ * called once the connection is made or has failed. The connection is
+ * remembered only if it is made.
+ *
+ * \param  con_id     Connection ID of the request.
+ * \param  source_id  External ID of the source endpoint.
+ * \param  sink_id    External ID of the sink endpoint.
+ * \param  callback   The callback of the request.
+ *
+ * \return TRUE if the request has been taken over.
+ */
+extern bool opmgr_placement_connect(unsigned con_id, unsigned source_id,
+                                    unsigned sink_id,
+                                    bool (*callback)(unsigned con_id,
+                                                     unsigned status,
+                                                     unsigned transform_id));
+#endif /* !DESKTOP_TEST_BUILD */
+
+#if defined(PROFILER_ON) && !defined(DESKTOP_TEST_BUILD)
+/**
+ * \brief  Measured load of an existing operator.
+ *
+ * Converts the operator's profiler reading into KIPS at the current clock.
+ * Used to refine the static estimate of a capability once an instance of it
+ * has run.
+ *
+ * \param  ext_op_id  External operator ID.
+ * \param  kips       Receives the measured load.
+ *
+ * \return TRUE if the operator exists locally and has a profiler reading.
+ */
+extern bool opmgr_placement_measured_kips(unsigned ext_op_id, unsigned *kips);
+#endif /* PROFILER_ON && !DESKTOP_TEST_BUILD */
+
+#endif /* OPMGR_PLACEMENT_H */
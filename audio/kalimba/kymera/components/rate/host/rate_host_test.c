@@ -0,0 +1,915 @@
+/****************************************************************************
+ * Copyright 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file rate_host_test.c
+ * \ingroup rate_lib
+ *
+ * Host test of the rate matching library. <br>
+ *
+ * Builds the rate library sources as a DESKTOP_TEST_BUILD with the 32-bit
+ * word width of the target.
+ *
+ * rate_fractional_divide_fast is checked against the double word
+ * rate_fractional_divide_generic at the edges of every divisor below 2^16
+ * and for random arguments, then both are timed. The generic divide is
+ * also timed with a bit-serial double word division, which is closer to
+ * what it costs on a core without a double word divider.
+ *
+ * rate_measure, rate_pid and rate_compare are checked against known
+ * answers: measurement intervals, validity and reuse; integration and
+ * saturation of the controller; and the accumulated sample count error
+ * between two clocks, for equal and different nominal rates.
+ *
+ * The timestamp filter is run over traces of a 48kHz device with a clock
+ * drift, a timestamp jitter and uneven kicks. rate_match is run in a closed
+ * loop, warping a feedback device until it follows a reference device.
+ * For each trace it reports when the rate error converged, its bias and
+ * noise afterwards, and the cost of an update. Under jitter the error never
+ * stays within a fixed bound sample by sample, so convergence is judged on
+ * its mean over a sliding window: the trace has converged once the mean of
+ * every later window is within the tolerance.
+ *
+ * Host timings only compare the variants with each other; they are not
+ * Kalimba cycle counts. Returns non-zero on any failure.
+ *
+ * Build from this directory with
+ *     cc -O2 -DDESKTOP_TEST_BUILD -I.. -I../.. -I../../platform
+ *        -I../../common/interface rate_host_test.c -lm
+ */
+
+/****************************************************************************
+ * Include Files
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+/* Normally set by the build's pre-include file */
+#define DAWTH   32
+#define MAXINT  0x7FFFFFFF
+#define MININT  0x80000000
+
+/* Build the default rate_match configuration, without an adaptive
+ * responsiveness function */
+#define RATE_MATCH_ADAPT_DEFAULT_NONE
+
+#include "util.h"
+
+#include "../rate_platform.c"
+#include "../rate_conv.c"
+#include "../rate_ts_filter.c"
+#include "../rate_measure.c"
+#include "../rate_compare.c"
+#include "../rate_pid.c"
+#include "../rate_match.c"
+
+/****************************************************************************
+ * Private Macro Definitions
+ */
+
+#define RANDOM_DIVIDES          20000000
+#define EDGE_NUMERATORS         64
+#define TIMING_DIVIDES          10000000
+
+#define TRACE_SAMPLE_RATE       48000
+#define TRACE_KICK_SAMPLES      48
+#define TRACE_SECONDS           30
+#define TRACE_UPDATES           (TRACE_SECONDS * TRACE_SAMPLE_RATE / TRACE_KICK_SAMPLES)
+
+
+/* Closed loop rate matching: kick period, rate_match_update period and
+ * length of each trace */
+#define MATCH_KICK_US           1000
+#define MATCH_PERIOD_US         50000
+#define MATCH_SECONDS           60
+#define MATCH_UPDATES           (MATCH_SECONDS * 1000000 / MATCH_PERIOD_US)
+
+/* Traces must converge within the first two thirds */
+#define STEADY_START(N)         ((N) - (N) / 3)
+
+/****************************************************************************
+ * Private Type Definitions
+ */
+
+typedef struct
+{
+    const char *name;
+
+    /** Clock drift of the device, parts per million of the sample period */
+    double drift_ppm;
+
+    /** Peak timestamp jitter, microseconds, uniformly distributed */
+    double jitter_us;
+
+    /** Vary the samples per update by up to this many either way */
+    unsigned kick_spread;
+
+    /** Converged once the mean error over every later window of this
+     * length stays within the tolerance; long enough to average out the
+     * jitter, short enough not to average in the initial transient */
+    double window_s;
+    double tolerance_ppm;
+} RATE_HOST_TRACE;
+
+typedef struct
+{
+    const char *name;
+
+    /** Nominal rates of the reference and feedback devices, Hz */
+    unsigned ref_rate;
+    unsigned fb_rate;
+
+    /** Clock drift of the feedback device against the reference, ppm */
+    double drift_ppm;
+
+    /** Peak timestamp jitter of both devices, microseconds */
+    double jitter_us;
+
+    /** Convergence window, seconds, and tolerance, ppm */
+    double window_s;
+    double tolerance_ppm;
+} RATE_HOST_MATCH_TRACE;
+
+/** A device sampling at a drifting rate, timestamped at each kick */
+typedef struct
+{
+    /** Actual sample rate, Hz */
+    double rate;
+
+    /** Samples since the start, with fraction */
+    double phase;
+
+    /** Whole samples already reported */
+    unsigned long reported;
+
+    RATE_MEASURE measure;
+} RATE_HOST_DEVICE;
+
+/****************************************************************************
+ * Private Data
+ */
+
+static const RATE_HOST_TRACE traces[] =
+{
+    { "nominal",                    0.0,    0.0, 0, 0.1,  2.0 },
+    { "+100ppm",                  100.0,    0.0, 0, 0.1,  2.0 },
+    { "-250ppm",                 -250.0,    0.0, 0, 0.1,  2.0 },
+    { "+100ppm, 20us jitter",     100.0,   20.0, 0, 2.0, 10.0 },
+    { "-250ppm, 50us jitter",    -250.0,   50.0, 0, 2.0, 20.0 },
+    { "+1000ppm, 20us jitter",   1000.0,   20.0, 0, 2.0, 10.0 },
+    { "+100ppm, uneven kicks",    100.0,    5.0, 4, 1.0, 10.0 },
+};
+
+static const RATE_HOST_MATCH_TRACE match_traces[] =
+{
+    { "48k, nominal",            48000, 48000,    0.0,  0.0, 0.5,  2.0 },
+    { "48k, +100ppm",            48000, 48000,  100.0,  0.0, 0.5,  2.0 },
+    { "48k, -300ppm",            48000, 48000, -300.0,  0.0, 0.5,  2.0 },
+    { "48k, +100ppm, 20us",      48000, 48000,  100.0, 20.0, 5.0, 20.0 },
+    { "44.1k to 48k, +50ppm",    48000, 44100,   50.0,  0.0, 0.5,  2.0 },
+    { "16k to 48k, -80ppm, 10us",48000, 16000,  -80.0, 10.0, 5.0, 10.0 },
+};
+
+static unsigned random_state = 1;
+
+/****************************************************************************
+ * Private Function Implementations
+ */
+
+/* Platform helpers from pl_intrinsics.h, which only has asm versions */
+int pl_sign_detect(int input)
+{
+    int shift = 0;
+
+    if (input < 0)
+    {
+        input = ~input;
+    }
+    if (input == 0)
+    {
+        return DAWTH - 1;
+    }
+    while ((input & (1 << (DAWTH - 2))) == 0)
+    {
+        input <<= 1;
+        shift += 1;
+    }
+    return shift;
+}
+
+uint48 pl_abs_long(int48 x)
+{
+    return (x < 0) ? (uint48)-x : (uint48)x;
+}
+
+static unsigned random_next(void)
+{
+    random_state = random_state * 1664525u + 1013904223u;
+    return random_state;
+}
+
+/* Random number below limit, from the high bits of the LCG */
+static unsigned random_below(unsigned limit)
+{
+    return (unsigned)(((uint64)(random_next() >> 8) * limit) >> 24);
+}
+
+/* Uniformly distributed jitter of up to peak_us either way */
+static double random_jitter(double peak_us)
+{
+    return peak_us * ((double)random_below(2001) / 1000.0 - 1.0);
+}
+
+/* Bit-serial 64 by 32 bit division, as a runtime library does it on a 32-bit
+ * core without a double word divider. Only used to time the generic divide
+ * the way it runs on such a core. */
+static uint64 divide_bit_serial(uint64 num, uint32 den)
+{
+    uint64 quotient = 0;
+    uint64 rem = 0;
+    int bit;
+
+    for (bit = 63; bit >= 0; bit--)
+    {
+        rem = (rem << 1) | ((num >> bit) & 1);
+        if (rem >= den)
+        {
+            rem -= den;
+            quotient |= (uint64)1 << bit;
+        }
+    }
+    return quotient;
+}
+
+static int fractional_divide_bit_serial(int num, int den)
+{
+    return (int)divide_bit_serial(((uint64)num << (DAWTH-1)) + (den >> 1), (uint32)den);
+}
+
+static double elapsed_ns(clock_t start, unsigned count)
+{
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+static double fractional_to_ppm(int value)
+{
+    return (double)value / 2147483648.0 * 1e6;
+}
+
+static unsigned check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+/* Find where an error trace converged: the first entry from which the mean
+ * of every window of the given length is within tolerance. Returns count if
+ * the last window is still outside. */
+static unsigned converged_at(const double *error, unsigned count,
+                             unsigned window, double tolerance)
+{
+    double sum = 0.0;
+    unsigned settled = count;
+    unsigned n;
+
+    if (count < window)
+    {
+        return count;
+    }
+    for (n = 0; n < window; n++)
+    {
+        sum += error[n];
+    }
+    for (n = window; ; n++)
+    {
+        /* sum covers error[n - window] to error[n - 1] */
+        if (fabs(sum / window) > tolerance)
+        {
+            settled = count;
+        }
+        else if (settled == count)
+        {
+            settled = n - window;
+        }
+        if (n == count)
+        {
+            break;
+        }
+        sum += error[n] - error[n - window];
+    }
+    return settled;
+}
+
+/* Mean and standard deviation of error[from] to error[count - 1] */
+static void error_stats(const double *error, unsigned from, unsigned count,
+                        double *mean, double *sigma)
+{
+    double sum = 0.0, sum_sq = 0.0;
+    unsigned n;
+
+    for (n = from; n < count; n++)
+    {
+        sum += error[n];
+    }
+    *mean = sum / (count - from);
+    for (n = from; n < count; n++)
+    {
+        sum_sq += (error[n] - *mean) * (error[n] - *mean);
+    }
+    *sigma = sqrt(sum_sq / (count - from));
+}
+
+static unsigned check_divide(int num, int den)
+{
+    int fast = rate_fractional_divide_fast(num, den);
+    int generic = rate_fractional_divide_generic(num, den);
+
+    if (fast != generic)
+    {
+        printf("FAIL: rate_fractional_divide_fast(%d, %d) = 0x%08x, generic 0x%08x\n",
+               num, den, (unsigned)fast, (unsigned)generic);
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned test_divide(void)
+{
+    unsigned failures = 0;
+    unsigned checked = 0;
+    volatile int sink = 0;
+    clock_t start;
+    double fast_ns, generic_ns, serial_ns;
+    int den, i;
+
+    /* Edges of every divisor the fast path takes: the rounding boundary
+     * around den/2 and the top of the range, plus a spread in between. */
+    for (den = 1; den < RATE_FRACTIONAL_DIVIDE_FAST_LIMIT && failures < 10; den++)
+    {
+        int edges[] = { 0, 1, den / 2 - 1, den / 2, den / 2 + 1, den - 2, den - 1 };
+
+        for (i = 0; i < (int)(sizeof(edges) / sizeof(edges[0])); i++)
+        {
+            if ((edges[i] >= 0) && (edges[i] < den))
+            {
+                failures += check_divide(edges[i], den);
+                checked++;
+            }
+        }
+        for (i = 0; i < EDGE_NUMERATORS; i++)
+        {
+            failures += check_divide((int)random_below((unsigned)den), den);
+            checked++;
+        }
+    }
+
+    for (i = 0; i < RANDOM_DIVIDES && failures < 10; i++)
+    {
+        den = 1 + (int)random_below(RATE_FRACTIONAL_DIVIDE_FAST_LIMIT - 1);
+        failures += check_divide((int)random_below((unsigned)den), den);
+        checked++;
+    }
+
+    /* Above the limit the dispatcher must fall back to the generic divide. */
+    for (i = 0; i < 100000 && failures < 10; i++)
+    {
+        int num;
+
+        den = RATE_FRACTIONAL_DIVIDE_FAST_LIMIT + (int)random_below(MAXINT - RATE_FRACTIONAL_DIVIDE_FAST_LIMIT);
+        num = (int)random_below((unsigned)den);
+        if (rate_fractional_divide(num, den) != rate_fractional_divide_generic(num, den))
+        {
+            printf("FAIL: rate_fractional_divide(%d, %d) differs from generic\n", num, den);
+            failures++;
+        }
+        checked++;
+    }
+
+    random_state = 7;
+    start = clock();
+    for (i = 0; i < TIMING_DIVIDES; i++)
+    {
+        den = 1 + (int)(random_next() & 0xFFFE);
+        sink += rate_fractional_divide_fast((int)((unsigned)i % (unsigned)den), den);
+    }
+    fast_ns = elapsed_ns(start, TIMING_DIVIDES);
+
+    random_state = 7;
+    start = clock();
+    for (i = 0; i < TIMING_DIVIDES; i++)
+    {
+        den = 1 + (int)(random_next() & 0xFFFE);
+        sink += rate_fractional_divide_generic((int)((unsigned)i % (unsigned)den), den);
+    }
+    generic_ns = elapsed_ns(start, TIMING_DIVIDES);
+
+    random_state = 7;
+    start = clock();
+    for (i = 0; i < TIMING_DIVIDES; i++)
+    {
+        den = 1 + (int)(random_next() & 0xFFFE);
+        sink += fractional_divide_bit_serial((int)((unsigned)i % (unsigned)den), den);
+    }
+    serial_ns = elapsed_ns(start, TIMING_DIVIDES);
+
+    printf("fractional divide: %u argument pairs checked\n"
+           "    fast %.2f ns, generic %.2f ns (%.2f ns with a bit-serial double word divide) per call\n",
+           checked, fast_ns, generic_ns, serial_ns);
+    return failures;
+}
+
+/* Measurements of a 48kHz stream kicked every 1ms */
+static unsigned test_measure(void)
+{
+    const RATE_MEASUREMENT_VALIDITY* validity = &rate_measurement_validity_default;
+    RATE_MEASURE rm;
+    RATE_MEASUREMENT q;
+    unsigned failures = 0;
+    TIME t = 5000;
+    unsigned k;
+
+    memset(&rm, 0, sizeof(rm));
+
+    rate_measure_set_nominal_rate(&rm, 48000);
+    rate_measure_stop(&rm);
+    failures += check(rm.sample_rate_div25 == 1920, "rate_measure: 48kHz / 25");
+    failures += check(!rate_measure_take_measurement(&rm, &q, validity, t),
+                      "rate_measure: no measurement before the start");
+
+    /* The first update starts, the second one is the first sample count */
+    rate_measure_update(&rm, 48, t, 0);
+    failures += check(rate_measure_valid(&rm), "rate_measure: started by an update");
+    for (k = 1; k <= 5; k++)
+    {
+        rate_measure_update(&rm, 48, t + k * 1000, 0);
+    }
+    failures += check(!rate_measure_available(&rm, validity, t + 5000),
+                      "rate_measure: 5ms is shorter than the minimum interval");
+
+    for (; k <= 10; k++)
+    {
+        rate_measure_update(&rm, 48, t + k * 1000, 0);
+    }
+    failures += check(rate_measure_available(&rm, validity, t + 10000),
+                      "rate_measure: 10ms measurement available");
+    failures += check(rate_measure_take_measurement(&rm, &q, validity, t + 10000)
+                      && (q.num_samples == 480) && (q.delta_usec == 10000)
+                      && (q.last_timestamp == t + 10000)
+                      && q.restarted && !q.unreliable,
+                      "rate_measure: first measurement is 480 samples in 10ms, restarted");
+
+    /* Within max_age the same measurement is returned again */
+    rate_measure_update(&rm, 48, t + 11000, 0);
+    failures += check(rate_measure_take_measurement(&rm, &q, validity, t + 15000)
+                      && (q.num_samples == 480) && (q.last_timestamp == t + 10000),
+                      "rate_measure: measurement reused within max_age");
+
+    /* Then the next one starts from the end of the last one */
+    for (k = 12; k <= 30; k++)
+    {
+        rate_measure_update(&rm, 48, t + k * 1000, 0);
+    }
+    failures += check(rate_measure_take_measurement(&rm, &q, validity, t + 30000)
+                      && (q.num_samples == 960) && (q.delta_usec == 20000)
+                      && !q.restarted && !q.unreliable,
+                      "rate_measure: second measurement is contiguous");
+
+    /* 10% too many samples is outside the plausible range */
+    for (k = 31; k <= 50; k++)
+    {
+        rate_measure_update(&rm, 53, t + k * 1000, 0);
+    }
+    failures += check(rate_measure_take_measurement(&rm, &q, validity, t + 50000)
+                      && (q.num_samples == 1060) && q.unreliable,
+                      "rate_measure: 10% fast measurement is unreliable");
+
+    /* As is one flagged by the caller */
+    for (k = 51; k <= 70; k++)
+    {
+        rate_measure_update(&rm, 48, t + k * 1000, 0);
+    }
+    rate_measure_set_unreliable(&rm);
+    failures += check(rate_measure_take_measurement(&rm, &q, validity, t + 70000)
+                      && q.unreliable,
+                      "rate_measure: caller flagged measurement is unreliable");
+
+    /* 2^16 samples do not fit a measurement */
+    rate_measure_update(&rm, 1 << 16, t + 90000, 0);
+    failures += check(!rate_measure_take_measurement(&rm, &q, validity, t + 90000),
+                      "rate_measure: too many samples");
+
+    /* Timestamps wrap */
+    t = 0xFFFFF000u;
+    rate_measure_stop(&rm);
+    rate_measure_update(&rm, 0, t, 0);
+    rate_measure_update(&rm, 480, t + 10000, 0);
+    failures += check(rate_measure_take_measurement(&rm, &q, validity, t + 10000)
+                      && (q.delta_usec == 10000) && !q.unreliable,
+                      "rate_measure: interval across the timer wrap");
+
+    failures += check(rate_measure_check_rate(rm.sample_period, 480, 10400)
+                      && !rate_measure_check_rate(rm.sample_period, 480, 10600)
+                      && rate_measure_check_rate(rm.sample_period, 480, 9600)
+                      && !rate_measure_check_rate(rm.sample_period, 480, 9400),
+                      "rate_measure_check_rate: +/-5% limits");
+
+    printf("rate_measure: %s\n", failures ? "FAIL!" : "OK");
+    return failures;
+}
+
+static unsigned test_pid(void)
+{
+    RATE_PID pid;
+    unsigned failures = 0;
+    int correction = 0;
+    unsigned n;
+
+    rate_pid_set_coeff(&pid, FRACTIONAL(0.5), FRACTIONAL(0.25));
+    rate_pid_reset(&pid);
+
+    /* Proportional plus integral of a constant deviation */
+    for (n = 1; n <= 3; n++)
+    {
+        correction = rate_pid_update(&pid, FRACTIONAL(0.01));
+    }
+    failures += check(abs(pid.pid_int - FRACTIONAL(0.03)) <= 2,
+                      "rate_pid: integrates the deviation");
+    failures += check(abs(correction - FRACTIONAL(0.005 + 0.0075)) <= 4,
+                      "rate_pid: kp * deviation + ki * integral");
+
+    /* Full speed scaling is the unscaled update, half speed scales the
+     * proportional term by one half and the integrated one by a quarter */
+    rate_pid_reset(&pid);
+    correction = rate_pid_update_scaled(&pid, FRACTIONAL(0.01), MAXINT);
+    failures += check(abs(correction - FRACTIONAL(0.005 + 0.0025)) <= 4,
+                      "rate_pid: update at full speed");
+    rate_pid_reset(&pid);
+    correction = rate_pid_update_scaled(&pid, FRACTIONAL(0.01), FRACTIONAL(0.5));
+    failures += check(abs(pid.pid_int - FRACTIONAL(0.0025)) <= 2
+                      && abs(correction - FRACTIONAL(0.0025 + 0.000625)) <= 4,
+                      "rate_pid: update at half speed");
+
+    /* The integrator saturates rather than wrapping */
+    rate_pid_reset(&pid);
+    for (n = 0; n < 200; n++)
+    {
+        correction = rate_pid_update(&pid, FRACTIONAL(0.9));
+    }
+    failures += check((pid.pid_int == MAXINT) && (correction > 0),
+                      "rate_pid: integrator saturates at +1");
+    for (n = 0; n < 400; n++)
+    {
+        correction = rate_pid_update(&pid, -FRACTIONAL(0.9));
+    }
+    failures += check((pid.pid_int == (int)MININT) && (correction < 0),
+                      "rate_pid: integrator saturates at -1");
+
+    failures += check(rate_pid_update(NULL, 1) == 0, "rate_pid: NULL controller");
+
+    printf("rate_pid: %s\n", failures ? "FAIL!" : "OK");
+    return failures;
+}
+
+/* Open loop comparison of two devices with a fixed relative drift. The
+ * feedback sample count error rate_compare accumulates must follow the
+ * exact count of samples the feedback device ran ahead. */
+static unsigned run_compare(unsigned ref_rate, unsigned fb_rate, double drift_ppm)
+{
+    RATE_COMPARE rcmp;
+    RATE_MEASUREMENT ref, fb;
+    double fb_actual = fb_rate * (1.0 + drift_ppm * 1e-6);
+    double max_error = 0.0;
+    unsigned failures = 0;
+    unsigned n;
+
+    memset(&rcmp, 0, sizeof(rcmp));
+    rate_compare_set_ref_sample_rate(&rcmp, ref_rate);
+    rate_compare_set_fb_sample_rate(&rcmp, fb_rate);
+    rate_compare_start(&rcmp);
+
+    for (n = 0; n < 200; n++)
+    {
+        /* Both devices are measured over the same 50ms, on sample
+         * boundaries of the reference */
+        double t0 = 1000.0 + n * 50000.0, t1 = t0 + 50000.0;
+        double fb0 = ceil(t0 * 1e-6 * fb_actual), fb1 = ceil(t1 * 1e-6 * fb_actual);
+        double expected;
+        int deviation;
+        RATE_COMPARE_RESULT result;
+
+        ref.num_samples = (uint16)(ref_rate / 20);
+        ref.restarted = (n == 0);
+        ref.unreliable = FALSE;
+        ref.delta_usec = 50000;
+        ref.last_timestamp = (TIME)t1;
+
+        fb.num_samples = (uint16)(fb1 - fb0);
+        fb.restarted = (n == 0);
+        fb.unreliable = FALSE;
+        fb.delta_usec = (TIME)llround(fb1 * 1e6 / fb_actual) - (TIME)llround(fb0 * 1e6 / fb_actual);
+        fb.last_timestamp = (TIME)llround(fb1 * 1e6 / fb_actual);
+
+        result = rate_compare(&rcmp, &ref, &fb, &deviation);
+        if (!(result & RATE_COMPARE_VALID) || ((result & RATE_COMPARE_START) != 0) != (n == 0))
+        {
+            printf("FAIL: rate_compare %u to %u Hz: result %d at %u\n", fb_rate, ref_rate, result, n);
+            failures++;
+            break;
+        }
+
+        /* Samples the feedback device is short of the nominal ratio */
+        expected = (t1 - 1000.0) * 1e-6 * (fb_rate - fb_actual);
+        {
+            double error = rcmp.fb_sample_count_error
+                           + (double)rcmp.fb_sample_count_residual / 2147483648.0;
+
+            if (fabs(error - expected) > max_error)
+            {
+                max_error = fabs(error - expected);
+            }
+        }
+    }
+    if (max_error > 0.1)
+    {
+        printf("FAIL: rate_compare %u to %u Hz, %+.0f ppm: sample count error off by %.3f\n",
+               fb_rate, ref_rate, drift_ppm, max_error);
+        failures++;
+    }
+    return failures;
+}
+
+static unsigned test_compare(void)
+{
+    unsigned failures = 0;
+    RATE_COMPARE rcmp;
+    RATE_MEASUREMENT q = { 2400, TRUE, FALSE, 50000, 100000 };
+    int deviation;
+
+    memset(&rcmp, 0, sizeof(rcmp));
+    failures += run_compare(48000, 48000, 0.0);
+    failures += run_compare(48000, 48000, 100.0);
+    failures += run_compare(48000, 48000, -250.0);
+    failures += run_compare(48000, 44100, 50.0);
+    failures += run_compare(44100, 16000, -80.0);
+
+    rate_compare_set_ref_sample_rate(&rcmp, 48000);
+    rate_compare_set_fb_sample_rate(&rcmp, 48000);
+    rate_compare_start(&rcmp);
+    failures += check(rate_compare(&rcmp, &q, NULL, &deviation) == RATE_COMPARE_FAILED,
+                      "rate_compare: NULL measurement");
+
+    /* 50ms of samples in 49.5ms is a deviation of 1% */
+    q.delta_usec = 49500;
+    failures += check(rate_deviation(1920, &q, &deviation)
+                      && (fabs(fractional_to_ppm(deviation) + 10000.0) < 1.0),
+                      "rate_deviation: 1% fast");
+
+    printf("rate_compare: %s\n", failures ? "FAIL!" : "OK");
+    return failures;
+}
+
+/* Advance a device to time t_us and record the timestamp of its last
+ * sample, with jitter. */
+static void device_kick(RATE_HOST_DEVICE* dev, double t_us, double dt_us, double jitter_us)
+{
+    unsigned long samples;
+    double last_us;
+
+    dev->phase += dev->rate * dt_us * 1e-6;
+    samples = (unsigned long)floor(dev->phase);
+    last_us = t_us - (dev->phase - samples) / dev->rate * 1e6;
+    rate_measure_update(&dev->measure, (unsigned)(samples - dev->reported),
+                        (TIME)llround(last_us + random_jitter(jitter_us)), 0);
+    dev->reported = samples;
+}
+
+/* Run rate_match in a closed loop: the feedback device is warped by the
+ * correction until it runs at the reference rate. */
+static unsigned run_match(const RATE_HOST_MATCH_TRACE *trace)
+{
+    static double rate_error_ppm[MATCH_UPDATES];
+    RATE_HOST_DEVICE ref_dev = { 0 }, fb_dev = { 0 };
+    RATE_MATCH_CONTROL rmc;
+    double fb_drifted = trace->fb_rate * (1.0 + trace->drift_ppm * 1e-6);
+    double t_us = 0.0;
+    double bias_ppm, noise_ppm;
+    double offset_min = 1e9, offset_max = -1e9;
+    int correction = 0;
+    unsigned updates = 0;
+    unsigned failures = 0;
+    unsigned settled, n;
+    clock_t start;
+    double update_ns = 0.0;
+
+    memset(&rmc, 0, sizeof(rmc));
+    rate_measure_set_nominal_rate(&ref_dev.measure, trace->ref_rate);
+    rate_measure_set_nominal_rate(&fb_dev.measure, trace->fb_rate);
+    rate_measure_stop(&ref_dev.measure);
+    rate_measure_stop(&fb_dev.measure);
+    ref_dev.rate = trace->ref_rate;
+    fb_dev.rate = fb_drifted;
+    if (!rate_match_init(&rmc, &fb_dev.measure, NULL,
+                         &rate_measurement_validity_default, trace->fb_rate))
+    {
+        printf("FAIL: %s: rate_match_init\n", trace->name);
+        return 1;
+    }
+
+    random_state = 1;
+    for (n = 0; n < MATCH_UPDATES; n++)
+    {
+        RATE_RELATIVE_RATE ref;
+        TIME now;
+        unsigned k;
+
+        for (k = 0; k < MATCH_PERIOD_US / MATCH_KICK_US; k++)
+        {
+            t_us += MATCH_KICK_US;
+            device_kick(&ref_dev, t_us, MATCH_KICK_US, trace->jitter_us);
+            device_kick(&fb_dev, t_us, MATCH_KICK_US, trace->jitter_us);
+        }
+
+        now = (TIME)llround(t_us);
+        ref.nominal_rate_div25 = (uint16)ref_dev.measure.sample_rate_div25;
+        ref.valid = rate_measure_take_measurement(&ref_dev.measure, &ref.q,
+                                                  &rate_measurement_validity_default, now);
+        start = clock();
+        if (rate_match_update(&rmc, &ref, &correction, now))
+        {
+            updates++;
+        }
+        update_ns += (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC;
+
+        /* A positive correction increases the rate, as a HW warp does */
+        fb_dev.rate = fb_drifted * (1.0 + fractional_to_ppm(correction) * 1e-6);
+
+        rate_error_ppm[n] = ((fb_dev.rate / trace->fb_rate) / (ref_dev.rate / trace->ref_rate) - 1.0) * 1e6;
+        if (n >= STEADY_START(MATCH_UPDATES))
+        {
+            /* The feedback device must also stay in phase with the reference */
+            double offset = (double)fb_dev.reported / trace->fb_rate
+                            - (double)ref_dev.reported / trace->ref_rate;
+
+            offset_min = (offset < offset_min) ? offset : offset_min;
+            offset_max = (offset > offset_max) ? offset : offset_max;
+        }
+    }
+
+    settled = converged_at(rate_error_ppm, MATCH_UPDATES,
+                           (unsigned)(trace->window_s * 1e6 / MATCH_PERIOD_US),
+                           trace->tolerance_ppm);
+    error_stats(rate_error_ppm, STEADY_START(MATCH_UPDATES), MATCH_UPDATES, &bias_ppm, &noise_ppm);
+
+    if (updates < MATCH_UPDATES - 2)
+    {
+        printf("FAIL: %s: only %u of %u updates produced a correction\n",
+               trace->name, updates, MATCH_UPDATES);
+        failures++;
+    }
+    if (settled >= STEADY_START(MATCH_UPDATES))
+    {
+        printf("FAIL: %s: rate error did not converge within %.1f ppm\n",
+               trace->name, trace->tolerance_ppm);
+        failures++;
+    }
+    if ((offset_max - offset_min) * 1e6 > 500.0)
+    {
+        printf("FAIL: %s: feedback phase wanders by %.0f us\n",
+               trace->name, (offset_max - offset_min) * 1e6);
+        failures++;
+    }
+
+    printf("%-26s %6.2f s to %4.1f ppm over %.1f s, bias %5.2f ppm, noise %5.2f ppm rms, "
+           "phase within %4.0f us, %4.0f ns/update\n",
+           trace->name, (double)settled * MATCH_PERIOD_US * 1e-6, trace->tolerance_ppm, trace->window_s,
+           bias_ppm, noise_ppm, (offset_max - offset_min) * 1e6, update_ns / MATCH_UPDATES);
+    return failures;
+}
+
+static unsigned run_trace(const RATE_HOST_TRACE *trace)
+{
+    static double sp_error_ppm[TRACE_UPDATES];
+    RATE_TS_FILTER rtsf;
+    double period_us = 1e6 / TRACE_SAMPLE_RATE * (1.0 + trace->drift_ppm * 1e-6);
+    double bias_ppm, noise_ppm;
+    double sum_sq_error = 0.0;
+    unsigned steady_start = STEADY_START(TRACE_UPDATES);
+    unsigned restarts = 0;
+    unsigned samples = 0;
+    unsigned failures = 0;
+    unsigned settled;
+    double update_ns;
+    clock_t start;
+    unsigned n;
+
+    rate_ts_filter_init(&rtsf, &rate_ts_filter_audio_device_param);
+    rate_ts_filter_set_rate(&rtsf, TRACE_SAMPLE_RATE);
+
+    random_state = 1;
+    start = clock();
+    for (n = 0; n < TRACE_UPDATES; n++)
+    {
+        unsigned kick = TRACE_KICK_SAMPLES;
+        double true_us;
+
+        if (trace->kick_spread != 0)
+        {
+            kick = TRACE_KICK_SAMPLES - trace->kick_spread
+                   + random_below(2 * trace->kick_spread + 1);
+        }
+        samples += kick;
+        true_us = 1000.0 + samples * period_us;
+
+        rate_ts_filter_update(&rtsf, kick, (TIME)llround(true_us + random_jitter(trace->jitter_us)));
+
+        if (rtsf.startup_remaining == RATE_TS_FILTER_STARTING)
+        {
+            restarts++;
+        }
+
+        sp_error_ppm[n] = fractional_to_ppm(rtsf.sp_adjust) - trace->drift_ppm;
+
+        /* Residual of the output against the true sample time */
+        if (n >= steady_start)
+        {
+            double error_us = (double)rate_ts_filter_get_rounded(&rtsf) - true_us;
+
+            sum_sq_error += error_us * error_us;
+        }
+    }
+    update_ns = elapsed_ns(start, TRACE_UPDATES);
+
+    settled = converged_at(sp_error_ppm, TRACE_UPDATES,
+                           (unsigned)(trace->window_s * TRACE_SAMPLE_RATE / TRACE_KICK_SAMPLES),
+                           trace->tolerance_ppm);
+    error_stats(sp_error_ppm, steady_start, TRACE_UPDATES, &bias_ppm, &noise_ppm);
+
+    if (restarts != 0)
+    {
+        printf("FAIL: %s: filter restarted %u times\n", trace->name, restarts);
+        failures++;
+    }
+    if (fabs(bias_ppm) > trace->tolerance_ppm)
+    {
+        printf("FAIL: %s: drift estimate is off by %.2f ppm\n", trace->name, bias_ppm);
+        failures++;
+    }
+    if (settled >= steady_start)
+    {
+        printf("FAIL: %s: sp_adjust did not converge within %.1f ppm\n",
+               trace->name, trace->tolerance_ppm);
+        failures++;
+    }
+
+    printf("%-24s %6.3f s to %4.1f ppm over %.1f s, bias %5.2f ppm, noise %6.2f ppm rms, "
+           "output %5.2f us rms, %4.1f ns/update\n",
+           trace->name, (double)settled * TRACE_KICK_SAMPLES / TRACE_SAMPLE_RATE,
+           trace->tolerance_ppm, trace->window_s, bias_ppm, noise_ppm,
+           sqrt(sum_sq_error / (TRACE_UPDATES - steady_start)), update_ns);
+
+    return failures;
+}
+
+/****************************************************************************
+ * Test entry point
+ */
+
+int main(void)
+{
+    unsigned failures = 0;
+    unsigned i;
+
+    failures += test_divide();
+    failures += test_measure();
+    failures += test_pid();
+    failures += test_compare();
+
+    printf("\ntimestamp filter, %u s at %u Hz, %u samples per update:\n",
+           TRACE_SECONDS, TRACE_SAMPLE_RATE, TRACE_KICK_SAMPLES);
+    for (i = 0; i < sizeof(traces) / sizeof(traces[0]); i++)
+    {
+        failures += run_trace(&traces[i]);
+    }
+
+    printf("\nrate match, %u s, update every %u ms:\n",
+           MATCH_SECONDS, MATCH_PERIOD_US / 1000);
+    for (i = 0; i < sizeof(match_traces) / sizeof(match_traces[0]); i++)
+    {
+        failures += run_match(&match_traces[i]);
+    }
+
+    if (failures != 0)
+    {
+        printf("\n%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
@@ -121,7 +121,62 @@ int rate_subs_generic(int x, int y)
 #endif /* RATE_PLATFORM_GENERIC_ADDS_SUBS */
 
 #ifdef TODO_B_247162
+/* The reference implementation is internal but exposed for testing */
+#if !defined(UNIT_TEST_BUILD) && !defined(DESKTOP_TEST_BUILD)
+static
+#endif /* Not a test build */
+int rate_fractional_divide_generic(int num, int den);
+
+#if DAWTH == 32
+/* The divisors used once per measurement period (sample counts,
+ * microsecond intervals within one measurement, reduced reference rates)
+ * are all below 2^16. For these, the Q.31 quotient is formed from two
+ * single word divisions of 15 bits each plus one shift-and-subtract step,
+ * which gives the same rounded result as the double word division.
+ */
+#define RATE_FRACTIONAL_DIVIDE_FAST_LIMIT (1 << 16)
+
+static int rate_fractional_divide_fast(int num, int den)
+{
+    int q_hi, q_lo, q_last, rem;
+
+    q_hi = (num << 15) / den;
+    rem = (num << 15) - q_hi * den;
+    q_lo = (rem << 15) / den;
+    rem = (rem << 15) - q_lo * den;
+    rem <<= 1;
+    q_last = (rem >= den) ? 1 : 0;
+    rem -= q_last * den;
+
+    /* Round to nearest, as (num << 31 + den/2) / den */
+    return (q_hi << 16) + (q_lo << 1) + q_last
+           + ((rem >= den - (den >> 1)) ? 1 : 0);
+}
+#endif /* DAWTH == 32 */
+
 int rate_fractional_divide(int num, int den)
+{
+    PL_ASSERT((num >= 0) && (den > 0));
+    if (num >= den)
+    {
+        return MAXINT;
+    }
+#ifdef RATE_FRACTIONAL_DIVIDE_FAST_LIMIT
+    else if (den < RATE_FRACTIONAL_DIVIDE_FAST_LIMIT)
+    {
+        return rate_fractional_divide_fast(num, den);
+    }
+#endif /* RATE_FRACTIONAL_DIVIDE_FAST_LIMIT */
+    else
+    {
+        return rate_fractional_divide_generic(num, den);
+    }
+}
+
+#if !defined(UNIT_TEST_BUILD) && !defined(DESKTOP_TEST_BUILD)
+static
+#endif /* Not a test build */
+int rate_fractional_divide_generic(int num, int den)
 {
     PL_ASSERT((num >= 0) && (den > 0));
     if (num >= den)
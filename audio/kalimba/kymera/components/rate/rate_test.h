@@ -27,6 +27,13 @@ bool rate_compare_calc_offset(TIME t_ref, TIME t_fb,
                               int* c_int_p, int* c_frac_p);
 #endif /* RATE_CONTROL_ALG==3 */
 
+/* From rate_platform.c */
+#ifdef TODO_B_247162
+/* Double word division, which rate_fractional_divide
+ * must match for all arguments */
+int rate_fractional_divide_generic(int num, int den);
+#endif /* TODO_B_247162 */
+
 #endif /* A test build */
 
 #endif /* RATE_RATE_TEST_H */
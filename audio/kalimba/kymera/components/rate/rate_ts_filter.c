@@ -195,7 +195,7 @@ void rate_ts_filter_update(RATE_TS_FILTER* rtsf, unsigned num_samples, TIME time
         rtsf->sample_time += predicted_delta;
 
         VOLATILE RATE_STIME error = (RATE_STIME)time_scaled - (RATE_STIME)rtsf->sample_time;
-        VOLATILE TIME error_trunc_us = error >> RATE_TIME_EXTRA_RESOLUTION;
+        VOLATILE TIME_INTERVAL error_trunc_us = error >> RATE_TIME_EXTRA_RESOLUTION;
         VOLATILE int update;
 
         if ( (error_trunc_us > (int)param->max_error_us)
@@ -0,0 +1,245 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  stream_inplace_host_test.c
+ * \ingroup stream
+ *
+ * Host unit test of the in-place savings accounting. <br>
+ *
+ * Builds stream_inplace_savings.c as a DESKTOP_TEST_BUILD and runs it over
+ * transform lists laid out the way connect_in_place() leaves them: the
+ * first connection of a chain allocates the base (case 4), every later one
+ * wraps the same base, possibly with a different size. Checks chains whose
+ * first member is not flagged as shared, chains of different buffer sizes,
+ * several chains in one graph and list order, then prints the buffers and
+ * octets saved for a few typical graphs. Returns non-zero on any failure.
+ *
+ * Build from this directory with
+ *     cc -O2 -DDESKTOP_TEST_BUILD -I../../common/interface
+ *        stream_inplace_host_test.c
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+
+/* stream_private.h brings in most of the firmware, the accounting only needs
+ * the transform and the base and size of its buffer. */
+typedef struct
+{
+    int *base_addr;
+    unsigned size;
+} tCbuffer;
+
+typedef struct ENDPOINT ENDPOINT;
+typedef struct TRANSFORM TRANSFORM;
+typedef struct STREAM_CONNECT_INFO STREAM_CONNECT_INFO;
+
+#include "../stream_transform.h"
+
+static unsigned int cbuffer_get_size_in_octets(tCbuffer *cbuffer)
+{
+    return cbuffer->size * sizeof(uint32);
+}
+
+TRANSFORM *transform_list;
+
+#include "../stream_inplace_savings.c"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define MAX_TRANSFORMS      16
+#define MAX_BASES           8
+#define BASE_WORDS          1024
+
+/****************************************************************************
+Private Variable Definitions
+*/
+
+static TRANSFORM transforms[MAX_TRANSFORMS];
+static tCbuffer buffers[MAX_TRANSFORMS];
+static int bases[MAX_BASES][BASE_WORDS];
+static unsigned num_transforms;
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+static void graph_reset(void)
+{
+    memset(transforms, 0, sizeof(transforms));
+    memset(buffers, 0, sizeof(buffers));
+    num_transforms = 0;
+    transform_list = NULL;
+}
+
+/* Add a connection on top of the transform list, as stream_new_transform()
+ * does. base is the index of the memory the buffer wraps. */
+static void graph_connect(unsigned base, unsigned words, bool shared)
+{
+    TRANSFORM *transform = &transforms[num_transforms];
+    tCbuffer *buffer = &buffers[num_transforms];
+
+    buffer->base_addr = bases[base];
+    buffer->size = words;
+    transform->id = num_transforms + 1;
+    transform->buffer = buffer;
+    transform->shared_buffer = shared;
+    transform->next = transform_list;
+    transform_list = transform;
+    num_transforms++;
+}
+
+/* Reverse the transform list, the result must not depend on its order. */
+static void graph_reverse(void)
+{
+    TRANSFORM *reversed = NULL;
+
+    while (transform_list != NULL)
+    {
+        TRANSFORM *next = transform_list->next;
+
+        transform_list->next = reversed;
+        reversed = transform_list;
+        transform_list = next;
+    }
+    transform_list = reversed;
+}
+
+static unsigned check_savings(const char *name, unsigned buffers, unsigned words)
+{
+    unsigned buffers_saved, octets_saved;
+    unsigned failures = 0;
+    unsigned pass;
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        stream_in_place_get_savings(&buffers_saved, &octets_saved);
+        if ((buffers_saved != buffers) || (octets_saved != words * sizeof(uint32)))
+        {
+            printf("FAIL: %s%s: saved %u buffers, %u octets, expected %u, %u\n",
+                   name, pass ? " (reversed)" : "", buffers_saved, octets_saved,
+                   buffers, (unsigned)(words * sizeof(uint32)));
+            failures++;
+        }
+        graph_reverse();
+    }
+    return failures;
+}
+
+static void report(const char *name)
+{
+    unsigned buffers_saved, octets_saved;
+
+    stream_in_place_get_savings(&buffers_saved, &octets_saved);
+    printf("%-40s %2u connections, saves %2u buffers, %6u octets\n",
+           name, num_transforms, buffers_saved, octets_saved);
+}
+
+/****************************************************************************
+Tests
+*/
+
+static unsigned test_accounting(void)
+{
+    unsigned failures = 0;
+
+    /* Nothing connected. */
+    graph_reset();
+    failures += check_savings("empty graph", 0, 0);
+
+    /* Separate buffers save nothing. */
+    graph_reset();
+    graph_connect(0, 256, FALSE);
+    graph_connect(1, 256, FALSE);
+    failures += check_savings("no in place", 0, 0);
+
+    /* A lone in-place connection has nothing to share with yet. */
+    graph_reset();
+    graph_connect(0, 256, TRUE);
+    failures += check_savings("single in place connection", 0, 0);
+
+    /* decoder -> passthrough -> volume -> sink: three connections on one
+     * base, two buffers saved. */
+    graph_reset();
+    graph_connect(0, 256, TRUE);
+    graph_connect(0, 256, TRUE);
+    graph_connect(0, 256, TRUE);
+    failures += check_savings("chain of three", 2, 512);
+
+    /* The first member of a chain is not always flagged, it still shares. */
+    graph_reset();
+    graph_connect(0, 256, FALSE);
+    graph_connect(0, 256, TRUE);
+    failures += check_savings("unflagged first member", 1, 256);
+
+    /* The base is sized for the largest member, which is the real buffer. */
+    graph_reset();
+    graph_connect(0, 128, TRUE);
+    graph_connect(0, 512, TRUE);
+    graph_connect(0, 256, TRUE);
+    failures += check_savings("mixed sizes", 2, 128 + 256);
+
+    /* Two chains and a plain connection in one graph. */
+    graph_reset();
+    graph_connect(0, 256, TRUE);
+    graph_connect(1, 64, FALSE);
+    graph_connect(2, 384, TRUE);
+    graph_connect(0, 256, TRUE);
+    graph_connect(2, 384, TRUE);
+    graph_connect(2, 384, TRUE);
+    failures += check_savings("two chains", 3, 256 + 2 * 384);
+
+    return failures;
+}
+
+static void report_graphs(void)
+{
+    printf("\n");
+
+    /* A2DP: decoder -> passthrough -> PEQ -> volume -> DAC */
+    graph_reset();
+    graph_connect(0, 512, FALSE);
+    graph_connect(1, 384, TRUE);
+    graph_connect(1, 384, TRUE);
+    graph_connect(1, 384, TRUE);
+    report("A2DP music, stereo (per channel)");
+
+    /* HFP: ADC -> AEC -> CVC -> PEQ -> volume -> SCO encoder */
+    graph_reset();
+    graph_connect(0, 256, FALSE);
+    graph_connect(1, 256, FALSE);
+    graph_connect(2, 160, TRUE);
+    graph_connect(2, 160, TRUE);
+    graph_connect(2, 160, TRUE);
+    report("HFP voice send path");
+
+    /* Prompt mixed in: two inputs of a mixer, each with its own chain. */
+    graph_reset();
+    graph_connect(0, 384, TRUE);
+    graph_connect(0, 384, TRUE);
+    graph_connect(1, 256, TRUE);
+    graph_connect(1, 256, TRUE);
+    graph_connect(2, 384, FALSE);
+    report("Music and prompt into a mixer");
+}
+
+int main(void)
+{
+    unsigned failures = test_accounting();
+
+    report_graphs();
+
+    if (failures != 0)
+    {
+        printf("\n%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
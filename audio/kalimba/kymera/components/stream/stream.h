@@ -641,6 +641,25 @@ bool get_timing_information_from_transform(unsigned tid, unsigned *period, unsig
  */
 extern bool stream_does_ep_exist(ENDPOINT* ep);
 
+/****************************************************************************
+Functions from stream_inplace_savings.c
+*/
+
+/**
+ * \brief  Report how much memory in-place buffer sharing currently saves.
+ *
+ * An in-place chain of N connections shares one buffer base, so it saves
+ * N-1 buffers (and the copy between each of them) compared to connecting the
+ * same operators with separate buffers.
+ *
+ * The transform list is walked once for each transform, so this is meant
+ * for debug and tests rather than for every connect.
+ *
+ * \param  buffers_saved - Number of connection buffers not allocated.
+ * \param  octets_saved - Size of those buffers in octets.
+ */
+extern void stream_in_place_get_savings(unsigned *buffers_saved, unsigned *octets_saved);
+
 /****************************************************************************
 Functions from stream_monitor_interrupt.c
 */
@@ -494,6 +494,19 @@ TRANSFORM *stream_connect_endpoints(ENDPOINT *source_ep, ENDPOINT *sink_ep,
             /*TODO: Handle audio delegation to the second core */
 #endif
         }
+#ifdef IN_PLACE_DEBUG
+        if (transform->shared_buffer)
+        {
+            unsigned buffers_saved, octets_saved;
+
+            /* Report what the in-place chains save now that one has grown.
+             * This walks the transform list once for each transform, so it
+             * is only done in builds with in-place debug. */
+            stream_in_place_get_savings(&buffers_saved, &octets_saved);
+            L2_DBG_MSG2("stream_connect_endpoints: in place saves %u buffers, %u octets",
+                        buffers_saved, octets_saved);
+        }
+#endif /* IN_PLACE_DEBUG */
         set_system_event(SYS_EVENT_EP_CONNECT);
     }
     else
@@ -34,6 +34,10 @@ Include Files
 #include "stream_kip.h"
 #endif /* INSTALL_DUAL_CORE_SUPPORT || AUDIO_SECOND_CORE */
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+#include "opmgr/opmgr_placement.h"
+#endif
+
 #if defined(INSTALL_UNINTERRUPTABLE_ANC) && defined(INSTALL_ANC_STICKY_ENDPOINTS)
 #include "accmd_prim.h"
 #endif /* defined(INSTALL_UNINTERRUPTABLE_ANC) && defined(INSTALL_ANC_STICKY_ENDPOINTS) */
@@ -754,6 +758,15 @@ void stream_if_connect(unsigned con_id, unsigned source_id, unsigned sink_id,
      *          - Call stream_if_transform_connect() and proceed with local connection.
      */
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+    /* Operators not placed yet are placed first, the placement engine makes
+     * the request again once they are where they should be. */
+    if (opmgr_placement_connect(con_id, source_id, sink_id, callback))
+    {
+        return;
+    }
+#endif
+
     /* Figure out whether the provided source endpoint is not a local one */
     if ( STREAM_EP_IS_OPEP_ID(source_id) )
     {
@@ -939,6 +952,10 @@ void stream_if_transform_disconnect(unsigned con_id, unsigned count,
 #if defined(INSTALL_DUAL_CORE_SUPPORT)
     unsigned px_tr_count;
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT)
+    opmgr_placement_disconnect_transforms(count, transforms);
+#endif
+
     /* Find the first P1 transform in the list */
     px_tr_count = stream_kip_find_px_transform_start( count, transforms );
 
@@ -1009,6 +1026,10 @@ void stream_if_disconnect(unsigned con_id, unsigned source_id, unsigned sink_id,
         return;
     }
 
+#if defined(INSTALL_OPMGR_AUTO_PLACEMENT) && defined(INSTALL_DUAL_CORE_SUPPORT)
+    opmgr_placement_disconnect_endpoints(source_id, sink_id);
+#endif
+
 #ifdef INSTALL_DUAL_CORE_SUPPORT
     if( KIP_PRIMARY_CONTEXT())
     {
@@ -0,0 +1,94 @@
+/****************************************************************************
+ * Copyright (c) 2018 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  stream_inplace_savings.c
+ * \ingroup stream
+ *
+ * Accounting of the memory saved by in-place buffer chains. <br>
+ * Kept apart from the in place manager so that it can be built on its own in
+ * a host test build (see host/stream_inplace_host_test.c). <br>
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#ifndef DESKTOP_TEST_BUILD
+#include "stream_private.h"
+
+/* Transforms are owned by stream_connect.c. */
+extern TRANSFORM *transform_list;
+#endif
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/*
+ * stream_in_place_get_savings
+ */
+void stream_in_place_get_savings(unsigned *buffers_saved, unsigned *octets_saved)
+{
+    TRANSFORM *transform;
+    TRANSFORM *other;
+
+    *buffers_saved = 0;
+    *octets_saved = 0;
+
+    /* Every transform of an in-place chain wraps the same base, including the
+     * first one, which may not be flagged as shared. Each base is handled once,
+     * at the first transform in the list that uses it. A chain of N transforms
+     * saves N-1 buffers; the real allocation is the largest of them. */
+    for (transform = transform_list; transform != NULL; transform = transform->next)
+    {
+        unsigned members, octets, largest;
+        bool shared;
+
+        if (transform->buffer == NULL)
+        {
+            continue;
+        }
+
+        for (other = transform_list; other != transform; other = other->next)
+        {
+            if ((other->buffer != NULL) &&
+                (other->buffer->base_addr == transform->buffer->base_addr))
+            {
+                break;
+            }
+        }
+        if (other != transform)
+        {
+            /* Base already counted. */
+            continue;
+        }
+
+        members = 0;
+        octets = 0;
+        largest = 0;
+        shared = FALSE;
+        for (other = transform; other != NULL; other = other->next)
+        {
+            if ((other->buffer != NULL) &&
+                (other->buffer->base_addr == transform->buffer->base_addr))
+            {
+                unsigned size = cbuffer_get_size_in_octets(other->buffer);
+
+                members += 1;
+                octets += size;
+                if (size > largest)
+                {
+                    largest = size;
+                }
+                shared |= other->shared_buffer;
+            }
+        }
+
+        if (shared && (members > 1))
+        {
+            *buffers_saved += members - 1;
+            *octets_saved += octets - largest;
+        }
+    }
+}
@@ -0,0 +1,237 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host.h
+ * \ingroup aac
+ *
+ * Host (PC) port of the AAC-LC synthesis tools of the AAC decoder, with
+ * per-tool time accounting. <br>
+ *
+ * This is the back end of the decoder only, not a host decoder: it does
+ * not read AAC streams, and it is not checked against DSP decoded output,
+ * for which the tree has no streams or reference PCM. Its output is checked
+ * against a double precision model of the standard instead.
+ *
+ * A channel is taken from its quantised spectrum and section data to PCM
+ * through the tools of reconstruct_channels.asm and filterbank.asm, one
+ * function for each assembly module:
+ *
+ *   - apply_scalefactors_and_dequantize.asm: x^(4/3) from the x43 tables
+ *     and the scalefactor gain
+ *   - reorder_spec.asm: short windows from group interleaved to window
+ *     order
+ *   - imdct.asm: pre-twiddle, N/4 point $math.scaleable_ifft, post-twiddle
+ *   - windowing.asm: sine or Kaiser windows, generated as the DSP generates
+ *     them, for the four window sequences
+ *   - overlap_add.asm: keeping the second half of the IMDCT output
+ *
+ * They follow the arch4 (K32) assembly: the same tables, the same order of
+ * rMAC accumulates and the same rounding and saturation. Each tool has a
+ * time counter named after its PROFILER point on the DSP, so the tools can
+ * be compared and worked on without the simulator.
+ *
+ * The bitstream, Huffman decoding, M/S, intensity, PNS, TNS, LTP, SBR and
+ * PS are not ported, so a stream cannot be decoded end to end and the
+ * tools that cost the most MIPS in HE-AAC are not covered. They are left
+ * to a separate port of the decoder's front end, which needs AAC streams
+ * and DSP decoded PCM to be checked against. The spectrum
+ * comes in already Huffman decoded, as a test would give it; the scale is
+ * that of a stream TNS has not touched. The band tables are those
+ * of 44.1 and 48 kHz, the A2DP rates. Window sequences must follow each
+ * other as the standard allows: the DSP's recovery from other orders,
+ * which windows the frame twice, is not ported.
+ *
+ * This directory is not part of the Kalimba library build. The IFFT is the
+ * host port of the math library. To build the benchmark on a PC:
+ *
+ *     cc -O2 -msse4.1 -I../../math/host -o aac_host_bench *.c \
+ *         ../../math/host/math_host_fft.c ../../math/host/math_host_tables.c -lm
+ *
+ * (no -msse4.1 on ARM, where NEON is used when the compiler enables it).
+ */
+
+#ifndef AAC_HOST_H
+#define AAC_HOST_H
+
+/****************************************************************************
+Include Files
+*/
+#include <stdint.h>
+
+/****************************************************************************
+Public Constant Declarations
+*/
+
+/** Samples of a frame and points of the long IMDCT */
+#define AAC_HOST_FRAME_SIZE             1024
+
+/** Points of a short window's IMDCT, and the number of short windows */
+#define AAC_HOST_SHORT_WINDOW_SIZE      128
+#define AAC_HOST_NUM_SHORT_WINDOWS      8
+
+/** Scalefactor bands of the 44.1 and 48 kHz tables, num_swb_long_window
+    and num_swb_short_window */
+#define AAC_HOST_NUM_SWB_LONG           49
+#define AAC_HOST_NUM_SWB_SHORT          14
+
+/** Largest number of scalefactors in a channel */
+#define AAC_HOST_MAX_SCALEFACTORS       (AAC_HOST_NUM_SHORT_WINDOWS * AAC_HOST_NUM_SWB_SHORT)
+
+/** Largest magnitude of a quantised value, after the escape codes */
+#define AAC_HOST_MAX_QUANTISED          8191
+
+/** Scalefactor of unity gain, $aacdec.SF_OFFSET */
+#define AAC_HOST_SF_OFFSET              100
+
+/** Words kept between frames for the overlap, the size of
+    $aacdec.overlap_add_left */
+#define AAC_HOST_OVERLAP_SIZE           576
+
+/** Channels of the synthesis state */
+#define AAC_HOST_MAX_CHANNELS           2
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/** Window sequences, as $aacdec.*_SEQUENCE */
+typedef enum
+{
+    AAC_HOST_ONLY_LONG_SEQUENCE = 0,
+    AAC_HOST_LONG_START_SEQUENCE = 1,
+    AAC_HOST_EIGHT_SHORT_SEQUENCE = 2,
+    AAC_HOST_LONG_STOP_SEQUENCE = 3
+} aac_host_window_sequence;
+
+/** Window shapes, as $aacdec.SIN_WINDOW and $aacdec.KAISER_WINDOW */
+typedef enum
+{
+    AAC_HOST_SIN_WINDOW = 0,
+    AAC_HOST_KAISER_WINDOW = 1
+} aac_host_window_shape;
+
+/** Tools with a time counter, named after the DSP's profiler points */
+typedef enum
+{
+    AAC_HOST_PROFILE_APPLY_SCALEFACTORS_AND_DEQUANTIZE = 0,
+    AAC_HOST_PROFILE_REORDER_SPEC,
+    AAC_HOST_PROFILE_IMDCT,
+    AAC_HOST_PROFILE_WINDOWING,
+    AAC_HOST_PROFILE_OVERLAP_ADD,
+    AAC_HOST_PROFILE_NUM_TOOLS
+} aac_host_profile_tool;
+
+/** Individual channel stream: what ics_info and the scalefactor data give,
+    and what calc_sfb_and_wingroup finds from them */
+typedef struct
+{
+    /* From the bitstream */
+    aac_host_window_sequence window_sequence;
+    aac_host_window_shape window_shape;
+    unsigned max_sfb;
+    unsigned scale_factor_grouping;     /**< 7 bits, eight short sequences */
+    int scalefactors[AAC_HOST_MAX_SCALEFACTORS]; /**< max_sfb for each group */
+
+    /* Set by aac_host_synthesise_channel */
+    unsigned num_swb;
+    unsigned num_window_groups;
+    unsigned window_group_length[AAC_HOST_NUM_SHORT_WINDOWS];
+    const uint16_t *swb_offset;
+    uint16_t sect_sfb_offset[AAC_HOST_NUM_SHORT_WINDOWS * (AAC_HOST_NUM_SWB_SHORT + 1)];
+} aac_host_ics;
+
+/** Time spent in each tool since the counters were cleared */
+typedef struct
+{
+    uint64_t ns[AAC_HOST_PROFILE_NUM_TOOLS];
+    uint32_t calls[AAC_HOST_PROFILE_NUM_TOOLS];
+} aac_host_profile;
+
+/** State a channel keeps from one frame to the next */
+typedef struct
+{
+    int32_t overlap[AAC_HOST_OVERLAP_SIZE];
+    aac_host_window_sequence previous_window_sequence;
+    aac_host_window_shape previous_window_shape;
+    int previous_long_start;            /**< PREV_WINDOW_SEQ_EQ_LONG_START */
+} aac_host_channel;
+
+/** Synthesis state of the channels, and the tool time counters */
+typedef struct
+{
+    aac_host_channel channel[AAC_HOST_MAX_CHANNELS];
+    aac_host_profile profile;
+    int32_t spec[AAC_HOST_FRAME_SIZE];          /**< $aac.mem.BUF_LEFT */
+    int32_t tmp_mem_pool[AAC_HOST_FRAME_SIZE];  /**< IMDCT output */
+} aac_host_synthesis;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief Reset the state: silent overlap, long sine windows before the
+ *        first frame, and cleared time counters.
+ */
+extern void aac_host_init(aac_host_synthesis *synth);
+
+/**
+ * \brief Synthesise one channel of a frame, from its quantised spectrum to
+ *        PCM.
+ *
+ * \param synth      Synthesis state.
+ * \param channel    0 or 1.
+ * \param ics        Channel stream. The fields set by the synthesis are
+ *                   filled in.
+ * \param quantised  AAC_HOST_FRAME_SIZE Huffman decoded values, group
+ *                   interleaved for eight short sequences, zero above
+ *                   max_sfb.
+ * \param pcm        AAC_HOST_FRAME_SIZE output samples, at the scale of
+ *                   the DSP's audio output buffer.
+ *
+ * \return 0, or -1 if max_sfb is too large or the window sequence cannot
+ *         follow the channel's previous one.
+ */
+extern int aac_host_synthesise_channel(aac_host_synthesis *synth, unsigned channel, aac_host_ics *ics,
+                                       const int32_t *quantised, int32_t *pcm);
+
+/**
+ * \brief Set num_swb, the window groups and the band offsets of ics from
+ *        its window sequence and grouping, as $aacdec.calc_sfb_and_wingroup.
+ *
+ * \return 0, or -1 if max_sfb is larger than num_swb.
+ */
+extern int aac_host_calc_sfb_and_wingroup(aac_host_ics *ics);
+
+/**
+ * \brief Dequantise spec in place and apply the scalefactors, as
+ *        $aacdec.apply_scalefactors_and_dequantize. Magnitudes are at
+ *        most AAC_HOST_MAX_QUANTISED.
+ */
+extern void aac_host_apply_scalefactors_and_dequantize(const aac_host_ics *ics, int32_t *spec);
+
+/**
+ * \brief Put the windows of an eight short sequence in window order, as
+ *        $aacdec.reorder_spec. tmp is AAC_HOST_FRAME_SIZE words.
+ */
+extern void aac_host_reorder_spec(const aac_host_ics *ics, int32_t *spec, int32_t *tmp);
+
+/**
+ * \brief IMDCT of num_points (1024 or 128) spectral values, as
+ *        $aacdec.imdct. The input is overwritten; the output is
+ *        num_points words.
+ */
+extern void aac_host_imdct(int32_t *input, int32_t *output, unsigned num_points);
+
+/**
+ * \brief Clear the time counters.
+ */
+extern void aac_host_profile_reset(aac_host_synthesis *synth);
+
+/**
+ * \brief Name of a tool's profiler point on the DSP, without $aacdec.
+ */
+extern const char *aac_host_profile_name(aac_host_profile_tool tool);
+
+#endif /* AAC_HOST_H */
@@ -0,0 +1,772 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_bench.c
+ * \ingroup aac
+ *
+ * Benchmark and regression tool for the host port of the AAC-LC synthesis
+ * tools. <br>
+ *
+ * Checks each tool against the AAC-LC synthesis of ISO/IEC 14496-3 in
+ * double precision: the dequantiser for every quantised value, the IMDCT
+ * of both sizes, and whole channels of random spectra through random
+ * conforming window sequences, shapes and short window groupings. The PCM
+ * is the standard's output times a fixed gain, and the same with the SIMD
+ * IFFT and without. Window sequences the standard does not allow are
+ * rejected. The dequantiser and the PCM of a stream through every window
+ * order are also checked bit for bit against answers recorded from the
+ * port, which the checks against the standard are too loose to do.
+ *
+ * Then synthesises streams of long and of eight short frames and reports
+ * the frames per second and the time of each tool per frame, by the names
+ * of the DSP's profiler points. The rates are those of the synthesis
+ * tools alone, not of a decoder. Returns non-zero on any failure.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "aac_host_private.h"
+#include "math_host.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define BENCH_SECONDS       0.2
+#define BENCH_FRAMES        16
+#define TEST_FRAMES         64
+#define IMDCT_TEST_RUNS     8
+
+/** Dequantiser output for a gain of 1.0 */
+#define DEQUANTIZE_GAIN     32.0
+
+/** PCM of the DSP for a standard output of 1.0: the dequantiser's 32, the
+    IMDCT's 128, and the window's r8 of 2 and OUT_SCALE of 6 */
+#define PCM_GAIN            (DEQUANTIZE_GAIN * IMDCT_GAIN * 12.0)
+
+/** Largest relative error of the x^(4/3) polynomials, and the output from
+    which it is measured */
+#define DEQUANTIZE_MAX_ERROR 3.0e-4
+#define RELATIVE_ERROR_FROM  65536.0
+
+/** IMDCT output N/2 + k for a standard output of 1.0: the IFFT's gain of
+    64 against the N/2 of an unscaled one */
+#define IMDCT_GAIN          128.0
+
+/** Lowest SNRs accepted, dB */
+#define IMDCT_MIN_SNR       100.0
+#define SYNTHESIS_MIN_SNR      80.0
+
+/** Seed of the known answer stream */
+#define KNOWN_ANSWER_SEED   0x4141u
+
+/** Kaiser-Bessel derived window alphas of long and short windows */
+#define KBD_ALPHA_LONG      4.0
+#define KBD_ALPHA_SHORT     6.0
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** A channel of the double precision synthesis */
+typedef struct
+{
+    double overlap[AAC_HOST_FRAME_SIZE];
+    aac_host_window_shape previous_window_shape;
+} ref_channel;
+
+/** A frame of a test stream */
+typedef struct
+{
+    aac_host_ics ics;
+    int32_t quantised[AAC_HOST_FRAME_SIZE];
+    double spec[AAC_HOST_FRAME_SIZE];   /**< dequantised, in window order */
+} test_frame;
+
+/****************************************************************************
+Private Variable Definitions
+*/
+static uint32_t random_state = 1;
+
+/** Standard windows by shape: 2048 and 256 points */
+static double long_windows[2][2 * AAC_HOST_FRAME_SIZE];
+static double short_windows[2][2 * AAC_HOST_SHORT_WINDOW_SIZE];
+
+/** Known answers of the dequantiser: each value at each scalefactor. The
+    x^(4/3) polynomials make 8190 of 64 at unity gain, not 8192. */
+static const int32_t known_values[] = {1, 8, -27, 64, 1000, AAC_HOST_MAX_QUANTISED};
+static const int known_scalefactors[] = {60, 100, 104, 130};
+static const int32_t known_dequantized[4][6] =
+{
+    {0, 1, -3, 8, 313, 5160},
+    {32, 512, -2592, 8190, 320002, 5283879},
+    {64, 1024, -5184, 16381, 640005, 10567757},
+    {5793, 92682, -469202, 1482634, 57926598, 956484220}
+};
+
+/** Window sequences and shapes of the known answer stream, every order the
+    standard allows, and the FNV-1a hash of the PCM of each frame */
+static const struct
+{
+    aac_host_window_sequence sequence;
+    aac_host_window_shape shape;
+    uint32_t pcm_hash;
+} known_frames[] =
+{
+    {AAC_HOST_ONLY_LONG_SEQUENCE, AAC_HOST_SIN_WINDOW, 0xe10088e1u},
+    {AAC_HOST_ONLY_LONG_SEQUENCE, AAC_HOST_KAISER_WINDOW, 0x569a1a0bu},
+    {AAC_HOST_LONG_START_SEQUENCE, AAC_HOST_SIN_WINDOW, 0xe2d30e8fu},
+    {AAC_HOST_EIGHT_SHORT_SEQUENCE, AAC_HOST_KAISER_WINDOW, 0xbbaff778u},
+    {AAC_HOST_EIGHT_SHORT_SEQUENCE, AAC_HOST_SIN_WINDOW, 0x041bfa04u},
+    {AAC_HOST_LONG_STOP_SEQUENCE, AAC_HOST_KAISER_WINDOW, 0x22969b8fu},
+    {AAC_HOST_LONG_START_SEQUENCE, AAC_HOST_KAISER_WINDOW, 0xb6231476u},
+    {AAC_HOST_EIGHT_SHORT_SEQUENCE, AAC_HOST_KAISER_WINDOW, 0x44f91930u},
+    {AAC_HOST_LONG_STOP_SEQUENCE, AAC_HOST_SIN_WINDOW, 0x1f1233f7u},
+    {AAC_HOST_ONLY_LONG_SEQUENCE, AAC_HOST_SIN_WINDOW, 0x238e47f8u}
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* The LCG state through a mixing function. The low bits of the state
+   repeat with short periods, so tests that take a few bits of a word get
+   the mixed bits instead. */
+static int32_t random_word(void)
+{
+    uint32_t x;
+
+    random_state = random_state * 1664525u + 1013904223u;
+    x = random_state;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return (int32_t)x;
+}
+
+static unsigned random_below(unsigned limit)
+{
+    return (unsigned)(((uint64_t)(uint32_t)random_word() * limit) >> 32);
+}
+
+static double bessel_i0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    unsigned k;
+
+    for (k = 1; k < 50; k++)
+    {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+static void kbd_window(double *w, unsigned n, double alpha)
+{
+    double kernel[AAC_HOST_FRAME_SIZE + 1];
+    double total = 0.0, sum = 0.0;
+    unsigned half = n / 2, j;
+
+    for (j = 0; j <= half; j++)
+    {
+        double r = ((double)j - half / 2.0) / (half / 2.0);
+
+        kernel[j] = bessel_i0(M_PI * alpha * sqrt(1.0 - r * r));
+        total += kernel[j];
+    }
+    for (j = 0; j < half; j++)
+    {
+        sum += kernel[j];
+        w[j] = sqrt(sum / total);
+        w[n - 1 - j] = w[j];
+    }
+}
+
+static void sine_window(double *w, unsigned n)
+{
+    unsigned j;
+
+    for (j = 0; j < n; j++)
+    {
+        w[j] = sin(M_PI / n * (j + 0.5));
+    }
+}
+
+static void init_windows(void)
+{
+    sine_window(long_windows[AAC_HOST_SIN_WINDOW], 2 * AAC_HOST_FRAME_SIZE);
+    sine_window(short_windows[AAC_HOST_SIN_WINDOW], 2 * AAC_HOST_SHORT_WINDOW_SIZE);
+    kbd_window(long_windows[AAC_HOST_KAISER_WINDOW], 2 * AAC_HOST_FRAME_SIZE, KBD_ALPHA_LONG);
+    kbd_window(short_windows[AAC_HOST_KAISER_WINDOW], 2 * AAC_HOST_SHORT_WINDOW_SIZE, KBD_ALPHA_SHORT);
+}
+
+/* The standard's IMDCT of n/2 values to n, without the 2/n */
+static void ref_imdct(const double *spec, double *x, unsigned n)
+{
+    double n0 = (n / 2 + 1) / 2.0;
+    unsigned i, k;
+
+    for (i = 0; i < n; i++)
+    {
+        double sum = 0.0;
+
+        for (k = 0; k < n / 2; k++)
+        {
+            sum += spec[k] * cos(2.0 * M_PI / n * (i + n0) * (k + 0.5));
+        }
+        x[i] = sum;
+    }
+}
+
+/* The standard's filterbank and overlap-add of a frame */
+static void ref_synthesis(ref_channel *chan, const test_frame *frame, double *pcm)
+{
+    static double x[2 * AAC_HOST_FRAME_SIZE];
+    static double z[2 * AAC_HOST_FRAME_SIZE];
+    aac_host_window_sequence sequence = frame->ics.window_sequence;
+    aac_host_window_shape shape = frame->ics.window_shape;
+    aac_host_window_shape previous = chan->previous_window_shape;
+    const double *short_prev = short_windows[previous];
+    const double *short_cur = short_windows[shape];
+    unsigned j, n;
+
+    memset(z, 0, sizeof(z));
+    if (sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        for (j = 0; j < AAC_HOST_NUM_SHORT_WINDOWS; j++)
+        {
+            ref_imdct(frame->spec + j * AAC_HOST_SHORT_WINDOW_SIZE, x, 2 * AAC_HOST_SHORT_WINDOW_SIZE);
+            for (n = 0; n < 2 * AAC_HOST_SHORT_WINDOW_SIZE; n++)
+            {
+                double w = (n < AAC_HOST_SHORT_WINDOW_SIZE && j == 0) ? short_prev[n] : short_cur[n];
+
+                z[448 + j * AAC_HOST_SHORT_WINDOW_SIZE + n] += x[n] * w / AAC_HOST_SHORT_WINDOW_SIZE;
+            }
+        }
+    }
+    else
+    {
+        ref_imdct(frame->spec, x, 2 * AAC_HOST_FRAME_SIZE);
+        for (n = 0; n < 2 * AAC_HOST_FRAME_SIZE; n++)
+        {
+            double w;
+
+            if (n < AAC_HOST_FRAME_SIZE)
+            {
+                if (sequence == AAC_HOST_LONG_STOP_SEQUENCE)
+                {
+                    w = (n < 448) ? 0.0 : (n < 576) ? short_prev[n - 448] : 1.0;
+                }
+                else
+                {
+                    w = long_windows[previous][n];
+                }
+            }
+            else if (sequence == AAC_HOST_LONG_START_SEQUENCE)
+            {
+                w = (n < 1472) ? 1.0 : (n < 1600) ? short_cur[n - 1344] : 0.0;
+            }
+            else
+            {
+                w = long_windows[shape][n];
+            }
+            z[n] = x[n] * w / AAC_HOST_FRAME_SIZE;
+        }
+    }
+
+    for (n = 0; n < AAC_HOST_FRAME_SIZE; n++)
+    {
+        pcm[n] = z[n] + chan->overlap[n];
+        chan->overlap[n] = z[AAC_HOST_FRAME_SIZE + n];
+    }
+    chan->previous_window_shape = shape;
+}
+
+/* A random window sequence that can follow the previous one */
+static aac_host_window_sequence next_sequence(aac_host_window_sequence previous)
+{
+    switch (previous)
+    {
+        case AAC_HOST_LONG_START_SEQUENCE:
+            return AAC_HOST_EIGHT_SHORT_SEQUENCE;
+        case AAC_HOST_EIGHT_SHORT_SEQUENCE:
+            return random_below(2) ? AAC_HOST_EIGHT_SHORT_SEQUENCE : AAC_HOST_LONG_STOP_SEQUENCE;
+        default:
+            return random_below(3) ? AAC_HOST_ONLY_LONG_SEQUENCE : AAC_HOST_LONG_START_SEQUENCE;
+    }
+}
+
+/* A random frame: band limited spectrum of random magnitudes and
+   scalefactors, group interleaved for the synthesis as the Huffman decoding
+   leaves it, and dequantised in window order for the reference */
+static void make_frame(test_frame *frame, aac_host_window_sequence sequence, aac_host_window_shape shape)
+{
+    aac_host_ics *ics = &frame->ics;
+    unsigned g, sfb, w, k, window = 0;
+    const int *sf;
+
+    memset(frame, 0, sizeof(*frame));
+    ics->window_sequence = sequence;
+    ics->window_shape = shape;
+    if (sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        ics->max_sfb = 8 + random_below(AAC_HOST_NUM_SWB_SHORT - 7);
+        ics->scale_factor_grouping = random_below(128);
+    }
+    else
+    {
+        ics->max_sfb = 30 + random_below(AAC_HOST_NUM_SWB_LONG - 29);
+    }
+    aac_host_calc_sfb_and_wingroup(ics);
+    for (k = 0; k < ics->num_window_groups * ics->max_sfb; k++)
+    {
+        ics->scalefactors[k] = 95 + (int)random_below(30);
+    }
+
+    sf = ics->scalefactors;
+    for (g = 0; g < ics->num_window_groups; g++, sf += ics->max_sfb)
+    {
+        for (sfb = 0; sfb < ics->max_sfb; sfb++)
+        {
+            unsigned width = (unsigned)(ics->swb_offset[sfb + 1] - ics->swb_offset[sfb]);
+            double gain = pow(2.0, 0.25 * (sf[sfb] - AAC_HOST_SF_OFFSET));
+            int32_t *q = frame->quantised + window * AAC_HOST_SHORT_WINDOW_SIZE
+                         + ics->sect_sfb_offset[g * (ics->num_swb + 1) + sfb];
+
+            for (w = 0; w < ics->window_group_length[g]; w++)
+            {
+                double *spec = frame->spec + (window + w) * AAC_HOST_SHORT_WINDOW_SIZE + ics->swb_offset[sfb];
+
+                for (k = 0; k < width; k++)
+                {
+                    int32_t value = (int32_t)random_below(1u << random_below(7));
+
+                    if (random_below(2))
+                    {
+                        value = -value;
+                    }
+                    *q++ = value;
+                    spec[k] = ((value < 0) ? -1.0 : 1.0) * pow(fabs((double)value), 4.0 / 3.0) * gain;
+                }
+            }
+        }
+        window += ics->window_group_length[g];
+    }
+}
+
+static int check_dequantize(void)
+{
+    static int32_t spec[AAC_HOST_FRAME_SIZE];
+    aac_host_ics ics;
+    double worst = 0.0;
+    int failures = 0;
+    int sf;
+    unsigned base, k;
+
+    memset(&ics, 0, sizeof(ics));
+    ics.window_sequence = AAC_HOST_ONLY_LONG_SEQUENCE;
+    ics.max_sfb = AAC_HOST_NUM_SWB_LONG;
+    aac_host_calc_sfb_and_wingroup(&ics);
+
+    for (sf = 60; sf <= 130; sf++)
+    {
+        for (k = 0; k < AAC_HOST_NUM_SWB_LONG; k++)
+        {
+            ics.scalefactors[k] = sf;
+        }
+        for (base = 0; base <= AAC_HOST_MAX_QUANTISED; base += AAC_HOST_FRAME_SIZE / 2)
+        {
+            for (k = 0; k < AAC_HOST_FRAME_SIZE / 2; k++)
+            {
+                spec[2 * k] = (int32_t)(base + k);
+                spec[2 * k + 1] = -(int32_t)(base + k);
+            }
+            aac_host_apply_scalefactors_and_dequantize(&ics, spec);
+            for (k = 0; (k < AAC_HOST_FRAME_SIZE / 2) && (base + k <= AAC_HOST_MAX_QUANTISED); k++)
+            {
+                double expected = DEQUANTIZE_GAIN * pow(base + k, 4.0 / 3.0)
+                                  * pow(2.0, 0.25 * (sf - AAC_HOST_SF_OFFSET));
+                double error = fabs(spec[2 * k] - expected);
+
+                if (expected >= INT32_MAX)
+                {
+                    continue;
+                }
+                if (expected >= RELATIVE_ERROR_FROM)
+                {
+                    worst = (error / expected > worst) ? error / expected : worst;
+                }
+                /* the final ASHIFT truncates, and a negative value is the
+                   negated positive one to within the rounding */
+                if ((error > DEQUANTIZE_MAX_ERROR * expected + 1.0) || (spec[2 * k] + spec[2 * k + 1] > 1)
+                    || (spec[2 * k] + spec[2 * k + 1] < 0))
+                {
+                    if (failures++ < 4)
+                    {
+                        printf("FAIL: dequantise %u at scalefactor %d gives %d and %d, expected %.1f\n",
+                               base + k, sf, spec[2 * k], spec[2 * k + 1], expected);
+                    }
+                }
+            }
+        }
+    }
+    printf("dequantise: %s, largest relative error %.2g\n", failures ? "FAILED" : "all values match x^(4/3)",
+           worst);
+    return failures;
+}
+
+static int check_imdct(void)
+{
+    static const unsigned sizes[] = {AAC_HOST_SHORT_WINDOW_SIZE, AAC_HOST_FRAME_SIZE};
+    static int32_t input[AAC_HOST_FRAME_SIZE], output[AAC_HOST_FRAME_SIZE];
+    static int32_t simd_output[AAC_HOST_FRAME_SIZE];
+    static double spec[AAC_HOST_FRAME_SIZE], x[2 * AAC_HOST_FRAME_SIZE];
+    int failures = 0;
+    unsigned s, run, k;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        unsigned n = sizes[s];
+        double signal = 0.0, noise = 0.0, snr;
+
+        for (run = 0; run < IMDCT_TEST_RUNS; run++)
+        {
+            for (k = 0; k < n; k++)
+            {
+                unsigned shift = 8 + random_below(12);
+
+                input[k] = random_word() >> shift;
+                spec[k] = input[k];
+            }
+            ref_imdct(spec, x, 2 * n);
+
+            math_host_set_simd(0);
+            aac_host_imdct(input, output, n);
+            for (k = 0; k < n; k++)
+            {
+                input[k] = (int32_t)spec[k];
+            }
+            math_host_set_simd(1);
+            aac_host_imdct(input, simd_output, n);
+            if (memcmp(output, simd_output, n * sizeof(int32_t)))
+            {
+                printf("FAIL: %u point IMDCT differs with SIMD\n", n);
+                failures++;
+            }
+
+            for (k = 0; k < n; k++)
+            {
+                double expected = x[n / 2 + k] / n * IMDCT_GAIN;
+
+                signal += expected * expected;
+                noise += (output[k] - expected) * (output[k] - expected);
+            }
+        }
+        snr = 10.0 * log10(signal / noise);
+        if (snr < IMDCT_MIN_SNR)
+        {
+            printf("FAIL: %u point IMDCT SNR %.1f dB\n", n, snr);
+            failures++;
+        }
+        printf("imdct: %4u points, SNR %.1f dB\n", n, snr);
+    }
+    return failures;
+}
+
+static int check_synthesis(void)
+{
+    static test_frame frames[AAC_HOST_MAX_CHANNELS];
+    static aac_host_synthesis synth, simd_synth;
+    static ref_channel ref[AAC_HOST_MAX_CHANNELS];
+    static double expected[AAC_HOST_FRAME_SIZE];
+    int32_t pcm[AAC_HOST_FRAME_SIZE], simd_pcm[AAC_HOST_FRAME_SIZE];
+    aac_host_window_sequence sequence[AAC_HOST_MAX_CHANNELS];
+    unsigned counts[4] = {0, 0, 0, 0};
+    double signal = 0.0, noise = 0.0, snr;
+    int failures = 0;
+    unsigned f, ch, k;
+
+    aac_host_init(&synth);
+    aac_host_init(&simd_synth);
+    memset(ref, 0, sizeof(ref));
+    for (ch = 0; ch < AAC_HOST_MAX_CHANNELS; ch++)
+    {
+        sequence[ch] = AAC_HOST_ONLY_LONG_SEQUENCE;
+    }
+
+    for (f = 0; f < TEST_FRAMES; f++)
+    {
+        for (ch = 0; ch < AAC_HOST_MAX_CHANNELS; ch++)
+        {
+            test_frame *frame = &frames[ch];
+
+            sequence[ch] = next_sequence(sequence[ch]);
+            counts[sequence[ch]]++;
+            make_frame(frame, sequence[ch], (aac_host_window_shape)random_below(2));
+            ref_synthesis(&ref[ch], frame, expected);
+
+            math_host_set_simd(0);
+            if (aac_host_synthesise_channel(&synth, ch, &frame->ics, frame->quantised, pcm) != 0)
+            {
+                printf("FAIL: frame %u channel %u rejected\n", f, ch);
+                return failures + 1;
+            }
+            math_host_set_simd(1);
+            aac_host_synthesise_channel(&simd_synth, ch, &frame->ics, frame->quantised, simd_pcm);
+            if (memcmp(pcm, simd_pcm, sizeof(pcm)))
+            {
+                printf("FAIL: frame %u channel %u differs with SIMD\n", f, ch);
+                failures++;
+            }
+            for (k = 0; k < AAC_HOST_FRAME_SIZE; k++)
+            {
+                double value = expected[k] * PCM_GAIN;
+
+                signal += value * value;
+                noise += (pcm[k] - value) * (pcm[k] - value);
+            }
+        }
+    }
+
+    snr = 10.0 * log10(signal / noise);
+    if (snr < SYNTHESIS_MIN_SNR)
+    {
+        printf("FAIL: synthesis SNR %.1f dB\n", snr);
+        failures++;
+    }
+    printf("synthesis: %u frames (%u long, %u start, %u short, %u stop), SNR %.1f dB against the standard\n",
+           TEST_FRAMES * AAC_HOST_MAX_CHANNELS, counts[AAC_HOST_ONLY_LONG_SEQUENCE],
+           counts[AAC_HOST_LONG_START_SEQUENCE], counts[AAC_HOST_EIGHT_SHORT_SEQUENCE],
+           counts[AAC_HOST_LONG_STOP_SEQUENCE], snr);
+    return failures;
+}
+
+static int check_sequences(void)
+{
+    static const aac_host_window_sequence orders[][2] =
+    {
+        {AAC_HOST_ONLY_LONG_SEQUENCE, AAC_HOST_EIGHT_SHORT_SEQUENCE},
+        {AAC_HOST_ONLY_LONG_SEQUENCE, AAC_HOST_LONG_STOP_SEQUENCE},
+        {AAC_HOST_LONG_START_SEQUENCE, AAC_HOST_ONLY_LONG_SEQUENCE},
+        {AAC_HOST_LONG_START_SEQUENCE, AAC_HOST_LONG_STOP_SEQUENCE},
+        {AAC_HOST_EIGHT_SHORT_SEQUENCE, AAC_HOST_ONLY_LONG_SEQUENCE},
+        {AAC_HOST_EIGHT_SHORT_SEQUENCE, AAC_HOST_LONG_START_SEQUENCE}
+    };
+    static aac_host_synthesis synth;
+    static test_frame frame;
+    int32_t pcm[AAC_HOST_FRAME_SIZE];
+    int failures = 0;
+    unsigned i;
+
+    for (i = 0; i < sizeof(orders) / sizeof(orders[0]); i++)
+    {
+        aac_host_init(&synth);
+        if (orders[i][0] == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+        {
+            make_frame(&frame, AAC_HOST_LONG_START_SEQUENCE, AAC_HOST_SIN_WINDOW);
+            aac_host_synthesise_channel(&synth, 0, &frame.ics, frame.quantised, pcm);
+        }
+        make_frame(&frame, orders[i][0], AAC_HOST_SIN_WINDOW);
+        if (aac_host_synthesise_channel(&synth, 0, &frame.ics, frame.quantised, pcm) != 0)
+        {
+            printf("FAIL: sequence %d rejected\n", orders[i][0]);
+            failures++;
+        }
+        make_frame(&frame, orders[i][1], AAC_HOST_SIN_WINDOW);
+        if (aac_host_synthesise_channel(&synth, 0, &frame.ics, frame.quantised, pcm) == 0)
+        {
+            printf("FAIL: sequence %d accepted after %d\n", orders[i][1], orders[i][0]);
+            failures++;
+        }
+    }
+
+    aac_host_init(&synth);
+    make_frame(&frame, AAC_HOST_ONLY_LONG_SEQUENCE, AAC_HOST_SIN_WINDOW);
+    frame.ics.max_sfb = AAC_HOST_NUM_SWB_LONG + 1;
+    if (aac_host_synthesise_channel(&synth, 0, &frame.ics, frame.quantised, pcm) == 0)
+    {
+        printf("FAIL: max_sfb %u accepted\n", frame.ics.max_sfb);
+        failures++;
+    }
+    printf("sequences: %s\n", failures ? "FAILED" : "orders the standard does not allow are rejected");
+    return failures;
+}
+
+/* FNV-1a of a block of words, low byte first */
+static uint32_t hash_words(uint32_t hash, const int32_t *words, unsigned count)
+{
+    unsigned i, b;
+
+    for (i = 0; i < count; i++)
+    {
+        for (b = 0; b < 32; b += 8)
+        {
+            hash = (hash ^ (((uint32_t)words[i] >> b) & 0xFF)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+/* The output of the ported tools against answers recorded from them. The
+   checks against the standard allow for the DSP's arithmetic, so they would
+   pass a change that moved bits of the output; these do not. The answers
+   are this port's, not DSP output, which the tree does not have. */
+static int check_known_answers(void)
+{
+    static aac_host_synthesis synth;
+    static test_frame frame;
+    static int32_t spec[AAC_HOST_FRAME_SIZE];
+    int32_t pcm[AAC_HOST_FRAME_SIZE];
+    uint32_t saved_state = random_state;
+    aac_host_ics ics;
+    int failures = 0;
+    unsigned s, v, f, k;
+    int simd;
+
+    memset(&ics, 0, sizeof(ics));
+    ics.window_sequence = AAC_HOST_ONLY_LONG_SEQUENCE;
+    ics.max_sfb = AAC_HOST_NUM_SWB_LONG;
+    aac_host_calc_sfb_and_wingroup(&ics);
+    for (s = 0; s < sizeof(known_scalefactors) / sizeof(known_scalefactors[0]); s++)
+    {
+        for (k = 0; k < AAC_HOST_NUM_SWB_LONG; k++)
+        {
+            ics.scalefactors[k] = known_scalefactors[s];
+        }
+        memset(spec, 0, sizeof(spec));
+        memcpy(spec, known_values, sizeof(known_values));
+        aac_host_apply_scalefactors_and_dequantize(&ics, spec);
+        for (v = 0; v < sizeof(known_values) / sizeof(known_values[0]); v++)
+        {
+            if (spec[v] != known_dequantized[s][v])
+            {
+                printf("FAIL: dequantise %d at scalefactor %d gives %d, known answer %d\n", known_values[v],
+                       known_scalefactors[s], spec[v], known_dequantized[s][v]);
+                failures++;
+            }
+        }
+    }
+
+    for (simd = 0; simd < 2; simd++)
+    {
+        math_host_set_simd(simd);
+        aac_host_init(&synth);
+        random_state = KNOWN_ANSWER_SEED;
+        for (f = 0; f < sizeof(known_frames) / sizeof(known_frames[0]); f++)
+        {
+            uint32_t hash;
+
+            make_frame(&frame, known_frames[f].sequence, known_frames[f].shape);
+            if (aac_host_synthesise_channel(&synth, 0, &frame.ics, frame.quantised, pcm) != 0)
+            {
+                printf("FAIL: known answer frame %u rejected\n", f);
+                failures++;
+                break;
+            }
+            hash = hash_words(2166136261u, pcm, AAC_HOST_FRAME_SIZE);
+            if (hash != known_frames[f].pcm_hash)
+            {
+                printf("FAIL: known answer frame %u, %s: PCM hash 0x%08x, known 0x%08x\n", f,
+                       simd ? "simd" : "scalar", hash, known_frames[f].pcm_hash);
+                failures++;
+            }
+        }
+    }
+    math_host_set_simd(1);
+    random_state = saved_state;
+
+    printf("known answers: %s\n", failures ? "FAILED" : "dequantiser and synthesis output match, with simd and without");
+    return failures;
+}
+
+/* Synthesise a stream of long frames, or one long start and then eight short
+   frames, until BENCH_SECONDS have passed. Returns frames per second and
+   leaves the tool times in synth. */
+static double time_synthesis(aac_host_synthesis *synth, int simd, int eight_short)
+{
+    static test_frame frames[BENCH_FRAMES];
+    int32_t pcm[AAC_HOST_FRAME_SIZE];
+    unsigned count = 0;
+    clock_t begin;
+    double elapsed;
+    unsigned f;
+
+    for (f = 0; f < BENCH_FRAMES; f++)
+    {
+        aac_host_window_sequence sequence = AAC_HOST_ONLY_LONG_SEQUENCE;
+
+        if (eight_short)
+        {
+            sequence = f ? AAC_HOST_EIGHT_SHORT_SEQUENCE : AAC_HOST_LONG_START_SEQUENCE;
+        }
+        make_frame(&frames[f], sequence, (aac_host_window_shape)(f & 1));
+    }
+    math_host_set_simd(simd);
+    aac_host_init(synth);
+
+    /* the first frame is not repeated, so the sequences stay in order */
+    begin = clock();
+    do
+    {
+        for (f = (count == 0) ? 0 : 1; f < BENCH_FRAMES; f++, count++)
+        {
+            aac_host_synthesise_channel(synth, 0, &frames[f].ics, frames[f].quantised, pcm);
+        }
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    math_host_set_simd(1);
+    return count / elapsed;
+}
+
+static void run_bench(void)
+{
+    static const char *const stream_names[] = {"long", "short"};
+    static aac_host_synthesis synth;
+    int eight_short, simd, t;
+
+    for (eight_short = 0; eight_short < 2; eight_short++)
+    {
+        for (simd = 0; simd < 2; simd++)
+        {
+            double rate = time_synthesis(&synth, simd, eight_short);
+            uint32_t frames = synth.profile.calls[AAC_HOST_PROFILE_APPLY_SCALEFACTORS_AND_DEQUANTIZE];
+
+            printf("  %s windows, %s: %.0f frames/s (%.0fx real time at 48 kHz), ns per frame:\n",
+                   stream_names[eight_short], simd ? "simd" : "scalar", rate,
+                   rate * AAC_HOST_FRAME_SIZE / 48000.0);
+            for (t = 0; t < AAC_HOST_PROFILE_NUM_TOOLS; t++)
+            {
+                printf("    %-44s %8.0f\n", aac_host_profile_name((aac_host_profile_tool)t),
+                       (double)synth.profile.ns[t] / frames);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int main(void)
+{
+    int failures = 0;
+
+    init_windows();
+    failures += check_dequantize();
+    failures += check_imdct();
+    failures += check_synthesis();
+    failures += check_sequences();
+    failures += check_known_answers();
+    run_bench();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_dequantize.c
+ * \ingroup aac
+ *
+ * Host port of the band layout, dequantisation and spectrum reordering of
+ * calc_sfb_and_wingroup.asm, apply_scalefactors_and_dequantize.asm and
+ * reorder_spec.asm. <br>
+ *
+ * Each value becomes sign(x) * |x|^(4/3) * 2^((sf - SF_OFFSET)/4) scaled
+ * by 2^-(REQUANTIZE_EXTRA_SHIFT/4). The scalefactor gives a shift and one
+ * of four fractions 2^(n/4 - 1). |x|^(4/3) of x below 32 is a mantissa and
+ * exponent from a table; larger x are normalised and a quadratic in the
+ * normalised value gives the mantissa, with coefficients by SIGNDET x and
+ * by whether the normalised value is above 0.75.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "aac_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Values below this come from x43_lookup32 */
+#define X43_TABLE_SIZE      32
+
+/** Stride of the fields of x43_lookup1 and x43_lookup2 */
+#define X43_FIELD_STRIDE    9
+
+/** Offset of the x43_lookup1 and x43_lookup2 index from SIGNDET x, DAWTH-15 */
+#define X43_SIGNDET_OFFSET  17
+
+/** Bit of the normalised value that selects x43_lookup2: 0.25 */
+#define X43_SELECT_BIT      0x20000000
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Dequantise a magnitude and apply the scalefactor shift and fraction: the
+   dequantize subroutine, returning rMAC */
+static kal_rmac dequantize(int32_t x, int shift, int32_t fraction)
+{
+    const int32_t *table;
+    int32_t normalised, square;
+    kal_rmac acc;
+    int norm;
+
+    if (x < X43_TABLE_SIZE)
+    {
+        acc = KAL_MAC(aac_host_x43_lookup32[X43_TABLE_SIZE + x], fraction);
+        return kal_rmac_ashift(acc, shift + aac_host_x43_lookup32[x]);
+    }
+
+    norm = kal_signdet32(x);
+    normalised = (int32_t)((uint32_t)x << norm);
+    table = (normalised & X43_SELECT_BIT) ? aac_host_x43_lookup2 : aac_host_x43_lookup1;
+    table += norm - X43_SIGNDET_OFFSET;
+
+    square = kal_frac_mult(normalised, normalised);
+    acc = kal_rmac_load(table[X43_FIELD_STRIDE])
+        + KAL_MAC(square, table[2 * X43_FIELD_STRIDE])
+        + KAL_MAC(normalised, table[3 * X43_FIELD_STRIDE]);
+    acc = KAL_MAC(kal_rmac_store(acc), fraction);
+    return kal_rmac_ashift(acc, shift + table[0]);
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int aac_host_calc_sfb_and_wingroup(aac_host_ics *ics)
+{
+    unsigned g, i;
+
+    if (ics->window_sequence != AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        ics->num_window_groups = 1;
+        ics->window_group_length[0] = 1;
+        ics->num_swb = AAC_HOST_NUM_SWB_LONG;
+        if (ics->max_sfb > ics->num_swb)
+        {
+            return -1;
+        }
+        ics->swb_offset = aac_host_swb_offset_long_48;
+        for (i = 0; i < ics->num_swb; i++)
+        {
+            ics->sect_sfb_offset[i] = aac_host_swb_offset_long_48[i];
+        }
+        /* force last offset to be the end */
+        ics->sect_sfb_offset[i] = AAC_HOST_FRAME_SIZE;
+        return 0;
+    }
+
+    ics->num_swb = AAC_HOST_NUM_SWB_SHORT;
+    if (ics->max_sfb > ics->num_swb)
+    {
+        return -1;
+    }
+    ics->swb_offset = aac_host_swb_offset_short_48;
+
+    /* a set grouping bit puts the next window in the same group */
+    ics->num_window_groups = 1;
+    ics->window_group_length[0] = 1;
+    for (i = 0; i < AAC_HOST_NUM_SHORT_WINDOWS - 1; i++)
+    {
+        if (ics->scale_factor_grouping & (1u << (AAC_HOST_NUM_SHORT_WINDOWS - 2 - i)))
+        {
+            ics->window_group_length[ics->num_window_groups - 1]++;
+        }
+        else
+        {
+            ics->window_group_length[ics->num_window_groups++] = 1;
+        }
+    }
+
+    /* the bands of a group hold all its windows, one after another */
+    for (g = 0; g < ics->num_window_groups; g++)
+    {
+        uint16_t *offset = ics->sect_sfb_offset + g * (ics->num_swb + 1);
+        unsigned length = ics->window_group_length[g];
+        unsigned sum = 0;
+
+        for (i = 0; i < ics->num_swb; i++)
+        {
+            offset[i] = (uint16_t)sum;
+            sum += (unsigned)(ics->swb_offset[i + 1] - ics->swb_offset[i]) * length;
+        }
+        offset[i] = (uint16_t)(length * AAC_HOST_SHORT_WINDOW_SIZE);
+    }
+    return 0;
+}
+
+void aac_host_apply_scalefactors_and_dequantize(const aac_host_ics *ics, int32_t *spec)
+{
+    const int *scalefactor = ics->scalefactors;
+    unsigned window = 0;
+    unsigned g, sfb;
+
+    for (g = 0; g < ics->num_window_groups; g++)
+    {
+        const uint16_t *top = ics->sect_sfb_offset + g * (ics->num_swb + 1) + 1;
+        int32_t *group = spec + window * AAC_HOST_SHORT_WINDOW_SIZE;
+        unsigned k = 0;
+
+        for (sfb = 0; sfb < ics->max_sfb; sfb++)
+        {
+            int sf = *scalefactor++ - (AAC_HOST_SF_OFFSET + AAC_HOST_REQUANTIZE_EXTRA_SHIFT);
+            int32_t fraction = aac_host_two2qtrx_lookup[sf & 3];
+            int shift = sf >> 2;
+
+            for (; k < top[sfb]; k++)
+            {
+                int32_t x = group[k];
+
+                if (x < 0)
+                {
+                    group[k] = kal_rmac_store(-dequantize(-x, shift, fraction));
+                }
+                else
+                {
+                    group[k] = kal_rmac_store(dequantize(x, shift, fraction));
+                }
+            }
+        }
+        window += ics->window_group_length[g];
+    }
+}
+
+void aac_host_reorder_spec(const aac_host_ics *ics, int32_t *spec, int32_t *tmp)
+{
+    const int32_t *in = spec;
+    int32_t *start_window = tmp;
+    unsigned g, sfb, w;
+
+    /* spec[g][w][sfb][bin] to spec[w][k] */
+    for (g = 0; g < ics->num_window_groups; g++)
+    {
+        const int32_t *group_start = in;
+        unsigned j = 0;
+
+        for (sfb = 0; sfb < ics->num_swb; sfb++)
+        {
+            unsigned width = (unsigned)(ics->swb_offset[sfb + 1] - ics->swb_offset[sfb]);
+
+            for (w = 0; w < ics->window_group_length[g]; w++)
+            {
+                memcpy(start_window + w * AAC_HOST_SHORT_WINDOW_SIZE + j, in, width * sizeof(int32_t));
+                in += width;
+            }
+            j += width;
+        }
+        start_window += in - group_start;
+    }
+    memcpy(spec, tmp, AAC_HOST_FRAME_SIZE * sizeof(int32_t));
+}
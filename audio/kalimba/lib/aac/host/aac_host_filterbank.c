@@ -0,0 +1,307 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_filterbank.c
+ * \ingroup aac
+ *
+ * Host port of the filterbank of filterbank.asm, windowing.asm and
+ * overlap_add.asm. <br>
+ *
+ * The IMDCT output of N words is half of the 2N windowed samples; the
+ * other half follows from its symmetry. The window subroutine takes the
+ * first half of one IMDCT output (A, read backwards) and the second half
+ * of the one before (B, read forwards) and writes both ends of N output
+ * samples at once: B*c - A*s from the start and B*s + A*c from the end.
+ * The sine window comes from rotating cos and sin of pi/N/2 by pi/N each
+ * sample. The Kaiser window is six polynomial segments, three for each
+ * half, taken in two passes over the output; the second pass adds to the
+ * first and applies the output scale.
+ *
+ * Long windows use the previous window shape. The short windows of an
+ * eight short sequence overlap each other: the first four overlaps fall in
+ * the frame, and the rest are kept in the overlap buffer and output with
+ * the next frame. A long start frame is windowed as a long one, and its
+ * short slope is taken by the next frame.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <stddef.h>
+#include "aac_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Gain from the overlap-add to the output, $aacdec.AUDIO_OUT_SCALE_AMOUNT - 2
+    as the DSP applies it without SBR */
+#define OUT_SCALE           (AAC_HOST_AUDIO_OUT_SCALE_AMOUNT - 2)
+
+/** r8: the IMDCT output is scaled up by 2 here, as TNS has not done it */
+#define SPECTRUM_SCALE      2
+
+/** Start of a short window's first half in an eight short sequence, and
+    the length of the flat part of long start and long stop windows */
+#define SHORT_START         448
+
+/** Kaiser segments of each half and words of each segment */
+#define KAISER_SEGMENTS     3
+#define KAISER_SEGMENT_SIZE 6
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Kaiser window value at x of a segment, rMAC as a word */
+static inline int32_t kaiser_value(const int32_t *segment, int32_t x)
+{
+    int32_t power = kal_frac_mult(x, x);
+    kal_rmac acc = kal_rmac_load(segment[0]) + KAL_MAC(x, segment[1]);
+
+    acc += KAL_MAC(power, segment[2]);
+    power = kal_frac_mult(power, x);
+    acc += KAL_MAC(power, segment[3]);
+    power = kal_frac_mult(power, x);
+    acc += KAL_MAC(power, segment[4]);
+    return kal_rmac_store(acc);
+}
+
+/* Sine window of n (1024 or 128) outputs, the window subroutine with r6 =
+   SIN_WINDOW. a is the last word of the A data, b the first word of the B
+   data. first and second are the two halves of the output, either of
+   which may be dummy (n/2 words). B is scaled by r7 and A by r8. */
+static void window_sine(unsigned n, const int32_t *a, const int32_t *b,
+                        int32_t *first, int32_t *second, int32_t r7, int32_t r8)
+{
+    const int32_t *coefs = (n == AAC_HOST_FRAME_SIZE) ? aac_host_sin2048_coefs : aac_host_sin256_coefs;
+    int shift = kal_signdet32(r7) - kal_signdet32(r8);
+    int32_t gain = kal_int_mult(r7, OUT_SCALE);
+    int32_t c = coefs[0];
+    int32_t s = coefs[1];
+    unsigned half = n / 2;
+    unsigned k;
+
+    for (k = 0; k < half; k++)
+    {
+        int32_t value_a = (int32_t)((uint32_t)a[-(int)k] << shift);
+        int32_t value_b = b[k];
+        int32_t c_old = c;
+
+        second[half - 1 - k] = kal_int_mult_sat(kal_rmac_store(KAL_MAC(value_b, s) + KAL_MAC(value_a, c)), gain);
+        first[k] = kal_int_mult_sat(kal_rmac_store(KAL_MAC(value_b, c) - KAL_MAC(value_a, s)), gain);
+
+        /* update window */
+        c = kal_rmac_store(KAL_MAC(coefs[2], c) - KAL_MAC(coefs[3], s));
+        s = kal_rmac_store(KAL_MAC(coefs[3], c_old) + KAL_MAC(coefs[2], s));
+    }
+}
+
+/* Kaiser window, as window_sine with r6 = KAISER_WINDOW */
+static void window_kaiser(unsigned n, const int32_t *a, const int32_t *b,
+                          int32_t *first, int32_t *second, int32_t r7, int32_t r8)
+{
+    const int32_t *segment = (n == AAC_HOST_FRAME_SIZE) ? aac_host_kaiser2048_coefs : aac_host_kaiser256_coefs;
+    int32_t x_step = 8 << kal_signdet32((int32_t)n);
+    const int32_t *a_start;
+    unsigned half = n / 2;
+    unsigned seg, i, k;
+    int32_t x = 0;
+
+    /* first pass: A forwards into the first half, B into the second */
+    for (seg = 0, k = 0; seg < KAISER_SEGMENTS; seg++, segment += KAISER_SEGMENT_SIZE)
+    {
+        x = 0;
+        for (i = 0; i < (unsigned)segment[5]; i++, k++)
+        {
+            int32_t w = kaiser_value(segment, x);
+
+            second[half - 1 - k] = kal_int_mult_sat(kal_frac_mult(w, b[k]), r7);
+            x += x_step;
+            first[k] = kal_int_mult_sat(kal_frac_mult(w, a[-(int)k]), -r8);
+        }
+    }
+
+    /* second pass: work along A and B in the other direction, adding to the
+       first pass and scaling. The split segment carries on from x. */
+    a_start = a - (half - 1);
+    for (seg = 0, k = 0; seg < KAISER_SEGMENTS; seg++, segment += KAISER_SEGMENT_SIZE)
+    {
+        for (i = 0; i < (unsigned)segment[5]; i++, k++)
+        {
+            int32_t w = kaiser_value(segment, x);
+            int32_t value;
+
+            value = kal_int_mult_sat(kal_frac_mult(b[half - 1 - k], w), r7);
+            first[half - 1 - k] = kal_int_mult_sat(kal_add(value, first[half - 1 - k]), OUT_SCALE);
+            x += x_step;
+            value = kal_int_mult_sat(kal_frac_mult(w, a_start[k]), r8);
+            second[k] = kal_int_mult_sat(kal_add(value, second[k]), OUT_SCALE);
+        }
+        x = 0;
+    }
+}
+
+/* The window subroutine. A NULL half of the output is not written. */
+static void window(aac_host_window_shape shape, unsigned n, const int32_t *a, const int32_t *b,
+                   int32_t *first, int32_t *second, int32_t r7, int32_t r8)
+{
+    int32_t dummy[AAC_HOST_FRAME_SIZE / 2];
+
+    if (first == NULL)
+    {
+        first = dummy;
+    }
+    if (second == NULL)
+    {
+        second = dummy;
+    }
+    if (shape == AAC_HOST_KAISER_WINDOW)
+    {
+        window_kaiser(n, a, b, first, second, r7, r8);
+    }
+    else
+    {
+        window_sine(n, a, b, first, second, r7, r8);
+    }
+}
+
+/* The last four short windows of the previous frame, which are all in the
+   overlap buffer and already scaled. The first writes only its second
+   half, at the start of the frame. */
+static void previous_short_windows(const aac_host_channel *chan, int32_t *out)
+{
+    aac_host_window_shape shape = chan->previous_window_shape;
+    const int32_t *overlap = chan->overlap;
+    unsigned j;
+
+    window(shape, AAC_HOST_SHORT_WINDOW_SIZE, overlap + 127, overlap, NULL, out, 1, 1);
+    for (j = 1; j < 4; j++)
+    {
+        unsigned start = j * AAC_HOST_SHORT_WINDOW_SIZE;
+
+        window(shape, AAC_HOST_SHORT_WINDOW_SIZE, overlap + start + 127, overlap + start,
+               out + start - 64, out + start, 1, 1);
+    }
+}
+
+/* The short windows of this frame's eight short sequence from SHORT_START:
+   the first against the previous frame's data b in shape, then within the
+   frame in the current shape. The last writes only its first half, at the
+   end of the frame. */
+static void current_short_windows(aac_host_window_shape previous_shape, aac_host_window_shape shape,
+                                  const int32_t *b, const int32_t *imdct, int32_t *out)
+{
+    unsigned j;
+
+    window(previous_shape, AAC_HOST_SHORT_WINDOW_SIZE, imdct + 63, b,
+           out + SHORT_START, out + SHORT_START + 64, 1, SPECTRUM_SCALE);
+    for (j = 1; j < 4; j++)
+    {
+        unsigned start = j * AAC_HOST_SHORT_WINDOW_SIZE;
+
+        window(shape, AAC_HOST_SHORT_WINDOW_SIZE, imdct + start + 63, imdct + start - 64,
+               out + SHORT_START + start, out + SHORT_START + start + 64, SPECTRUM_SCALE, SPECTRUM_SCALE);
+    }
+    window(shape, AAC_HOST_SHORT_WINDOW_SIZE, imdct + 512 + 63, imdct + 512 - 64,
+           out + SHORT_START + 512, NULL, SPECTRUM_SCALE, SPECTRUM_SCALE);
+}
+
+/* Window the IMDCT output and overlap it with the previous frame into
+   out, as $aacdec.windowing for a channel with an output buffer */
+static void windowing(aac_host_channel *chan, const aac_host_ics *ics, const int32_t *imdct, int32_t *out)
+{
+    aac_host_window_shape previous_shape = chan->previous_window_shape;
+    const int32_t *overlap = chan->overlap;
+    unsigned k;
+
+    if (chan->previous_long_start)
+    {
+        /* the short slope of the long start window: copy its flat part and
+           scale, then eight short windows */
+        chan->previous_long_start = 0;
+        for (k = 0; k < SHORT_START; k++)
+        {
+            out[k] = kal_int_mult_sat(overlap[k], OUT_SCALE);
+        }
+        current_short_windows(previous_shape, ics->window_shape, overlap + SHORT_START, imdct, out);
+    }
+    else if (ics->window_sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        previous_short_windows(chan, out);
+        current_short_windows(previous_shape, ics->window_shape, overlap + 512, imdct, out);
+    }
+    else if (ics->window_sequence == AAC_HOST_LONG_STOP_SEQUENCE)
+    {
+        int32_t scale = kal_int_mult(SPECTRUM_SCALE, OUT_SCALE);
+
+        previous_short_windows(chan, out);
+        window(previous_shape, AAC_HOST_SHORT_WINDOW_SIZE, imdct + 63, overlap + 512,
+               out + SHORT_START, out + SHORT_START + 64, 1, SPECTRUM_SCALE);
+
+        /* copy end of second buffer and scale */
+        for (k = 0; k < SHORT_START; k++)
+        {
+            out[SHORT_START + AAC_HOST_SHORT_WINDOW_SIZE + k] = kal_int_mult_sat(imdct[64 + k], scale);
+        }
+    }
+    else
+    {
+        window(previous_shape, AAC_HOST_FRAME_SIZE, imdct + 511, overlap,
+               out, out + AAC_HOST_FRAME_SIZE / 2, 1, SPECTRUM_SCALE);
+
+        /* the next frame takes the short slope */
+        chan->previous_long_start = (ics->window_sequence == AAC_HOST_LONG_START_SEQUENCE);
+    }
+
+    chan->previous_window_shape = ics->window_shape;
+    chan->previous_window_sequence = ics->window_sequence;
+}
+
+/* Keep the second half of the IMDCT output, scaled up by 2, as
+   $aacdec.overlap_add */
+static void overlap_add(aac_host_channel *chan, const aac_host_ics *ics, const int32_t *imdct)
+{
+    unsigned start = (ics->window_sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE) ? SHORT_START : 512;
+    unsigned k;
+
+    for (k = 0; k < AAC_HOST_FRAME_SIZE - start; k++)
+    {
+        chan->overlap[k] = kal_int_mult(imdct[start + k], SPECTRUM_SCALE);
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void aac_host_filterbank(aac_host_synthesis *synth, aac_host_channel *chan,
+                         const aac_host_ics *ics, int32_t *pcm)
+{
+    uint64_t start;
+    unsigned w;
+
+    start = aac_host_profile_start();
+    if (ics->window_sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        for (w = 0; w < AAC_HOST_NUM_SHORT_WINDOWS; w++)
+        {
+            aac_host_imdct(synth->spec + w * AAC_HOST_SHORT_WINDOW_SIZE,
+                           synth->tmp_mem_pool + w * AAC_HOST_SHORT_WINDOW_SIZE, AAC_HOST_SHORT_WINDOW_SIZE);
+        }
+    }
+    else
+    {
+        aac_host_imdct(synth->spec, synth->tmp_mem_pool, AAC_HOST_FRAME_SIZE);
+    }
+    aac_host_profile_stop(synth, AAC_HOST_PROFILE_IMDCT, start);
+
+    start = aac_host_profile_start();
+    windowing(chan, ics, synth->tmp_mem_pool, pcm);
+    aac_host_profile_stop(synth, AAC_HOST_PROFILE_WINDOWING, start);
+
+    start = aac_host_profile_start();
+    overlap_add(chan, ics, synth->tmp_mem_pool);
+    aac_host_profile_stop(synth, AAC_HOST_PROFILE_OVERLAP_ADD, start);
+}
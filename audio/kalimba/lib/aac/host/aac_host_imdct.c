@@ -0,0 +1,106 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_imdct.c
+ * \ingroup aac
+ *
+ * Host port of the 1024 and 128 point IMDCT of imdct.asm. <br>
+ *
+ * The even inputs and the odd inputs taken in reverse are the real and
+ * imaginary parts of N/2 complex values. They are turned by a pre-twiddle,
+ * go through the N/2 point $math.scaleable_ifft with a gain of 64, and are
+ * turned again by a post-twiddle that writes the two ends of the output
+ * towards each other. The twiddles come from a rotation by cfreq and sfreq
+ * each sample, restarted from an exact c and s at each eighth of the data.
+ * The DSP takes the IFFT output with bit reversed addressing; here it is
+ * put in order with math_host_bitreverse_array first.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "aac_host_private.h"
+#include "math_host.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** IFFT scale of each stage for a gain of 64: 1.0 as assembled for 64
+    points, (64*0.5^9)^(1/9) for 512 */
+#define IFFT_SCALE_64       0x7FFFFFFF
+#define IFFT_SCALE_512      ((int32_t)(0.79370052598410 * 2147483648.0 + 0.5))
+
+/** The twiddles restart from exact values this many times */
+#define TWIDDLE_BLOCKS      4
+
+/** Words of sin_const_imdct between restart points */
+#define SIN_CONST_STRIDE    4
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void aac_host_imdct(int32_t *input, int32_t *output, unsigned num_points)
+{
+    int32_t fft_real[MATH_HOST_FFT_MAX_POINTS / 4];
+    int32_t fft_imag[MATH_HOST_FFT_MAX_POINTS / 4];
+    const int32_t *sin_const = aac_host_sin_const_imdct + ((num_points >= AAC_HOST_FRAME_SIZE) ? 2 : 0);
+    int32_t cfreq = sin_const[0];
+    int32_t sfreq = sin_const[1];
+    unsigned half = num_points / 2;
+    unsigned block_size = num_points / 8;
+    math_host_fft_struct fft;
+    int32_t c, s;
+    unsigned b, i, k;
+
+    /* copy the odd values into the output buffer */
+    for (k = 0; k < half; k++)
+    {
+        output[half + k] = input[num_points - 1 - 2 * k];
+    }
+
+    /* pre-twiddle, with c = -c and s = -s to make the additions easier */
+    for (b = 0, k = 0; b < TWIDDLE_BLOCKS; b++)
+    {
+        c = -sin_const[2 + b * SIN_CONST_STRIDE];
+        s = -sin_const[3 + b * SIN_CONST_STRIDE];
+        for (i = 0; i < block_size; i++, k++)
+        {
+            int32_t neg_tempr = input[2 * k];
+            int32_t tempi = output[half + k];
+            int32_t c_old = c;
+
+            input[k] = kal_rmac_store(KAL_MAC(neg_tempr, c) + KAL_MAC(tempi, s));
+            output[k] = kal_rmac_store(KAL_MAC(neg_tempr, s) - KAL_MAC(tempi, c));
+            c = kal_rmac_store(KAL_MAC(c, cfreq) - KAL_MAC(s, sfreq));
+            s = kal_rmac_store(KAL_MAC(c_old, sfreq) + KAL_MAC(s, cfreq));
+        }
+    }
+
+    fft.num_points = half;
+    fft.real = input;
+    fft.imag = output;
+    math_host_scaleable_ifft(&fft, (half == 512) ? IFFT_SCALE_512 : IFFT_SCALE_64);
+    math_host_bitreverse_array(input, fft_real, half);
+    math_host_bitreverse_array(output, fft_imag, half);
+
+    /* post-twiddle */
+    for (b = 0, k = 0; b < TWIDDLE_BLOCKS; b++)
+    {
+        c = sin_const[2 + b * SIN_CONST_STRIDE];
+        s = sin_const[3 + b * SIN_CONST_STRIDE];
+        for (i = 0; i < block_size; i++, k++)
+        {
+            int32_t tempr = fft_real[k];
+            int32_t tempi = fft_imag[k];
+            int32_t c_old = c;
+
+            output[num_points - 1 - 2 * k] = kal_rmac_store(KAL_MAC(tempr, c) - KAL_MAC(tempi, s));
+            output[2 * k] = kal_rmac_store(KAL_MAC(tempi, c) + KAL_MAC(tempr, s));
+            c = kal_rmac_store(KAL_MAC(c, cfreq) - KAL_MAC(s, sfreq));
+            s = kal_rmac_store(KAL_MAC(c_old, sfreq) + KAL_MAC(s, cfreq));
+        }
+    }
+}
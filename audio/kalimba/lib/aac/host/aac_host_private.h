@@ -0,0 +1,180 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_private.h
+ * \ingroup aac
+ *
+ * Kalimba arch4 arithmetic, tables and internal functions of the host AAC
+ * port. <br>
+ *
+ * rMAC is a 72 bit accumulator, held here as a 128 bit integer. A
+ * fractional multiply adds twice the integer product. rMAC is used as a
+ * 32 bit value, by M[] = rMAC or r = rMAC, as bits 63..32 rounded on bit 31
+ * and saturated; that is also the value taken where rMAC is the operand of
+ * a multiply. r = rMAC puts a word in bits 63..32. rMAC = rMAC ASHIFT n
+ * shifts within the accumulator, truncating right shifts and saturating
+ * left shifts at 72 bits. Additions of data words wrap.
+ */
+
+#ifndef AAC_HOST_PRIVATE_H
+#define AAC_HOST_PRIVATE_H
+
+/****************************************************************************
+Include Files
+*/
+#include "aac_host.h"
+
+/****************************************************************************
+Private Type Declarations
+*/
+typedef __int128 kal_rmac;
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Largest 72 bit accumulator value */
+#define KAL_RMAC_MAX        ((((kal_rmac)1) << 71) - 1)
+#define KAL_RMAC_MIN        (-(((kal_rmac)1) << 71))
+
+/** $aacdec.REQUANTIZE_EXTRA_SHIFT: the dequantised spectrum is scaled by
+    2^-(this/4) to stay in range */
+#define AAC_HOST_REQUANTIZE_EXTRA_SHIFT     (25 * 4)
+
+/** $aacdec.AUDIO_OUT_SCALE_AMOUNT, from the overlap-add output to PCM */
+#define AAC_HOST_AUDIO_OUT_SCALE_AMOUNT     8
+
+/****************************************************************************
+Private Macro Declarations
+*/
+
+/** rMAC (+)= a * b (frac) */
+#define KAL_MAC(a, b)       ((kal_rmac)((int64_t)(a) * (int64_t)(b)) * 2)
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/** Saturate to a data word */
+static inline int32_t kal_sat32(int64_t value)
+{
+    if (value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)value;
+}
+
+/** M[] = rMAC, rounded and saturated */
+static inline int32_t kal_rmac_store(kal_rmac acc)
+{
+    acc = (acc + ((kal_rmac)1 << 31)) >> 32;
+    if (acc > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (acc < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)acc;
+}
+
+/** rMAC = r */
+static inline kal_rmac kal_rmac_load(int32_t value)
+{
+    return (kal_rmac)value * ((kal_rmac)1 << 32);
+}
+
+/** rMAC = rMAC ASHIFT shift */
+static inline kal_rmac kal_rmac_ashift(kal_rmac acc, int shift)
+{
+    if (shift < 0)
+    {
+        return acc >> -shift;
+    }
+    if (acc > (KAL_RMAC_MAX >> shift))
+    {
+        return KAL_RMAC_MAX;
+    }
+    if (acc < (KAL_RMAC_MIN >> shift))
+    {
+        return KAL_RMAC_MIN;
+    }
+    return acc * ((kal_rmac)1 << shift);
+}
+
+/** r = a * b (frac) */
+static inline int32_t kal_frac_mult(int32_t a, int32_t b)
+{
+    return kal_rmac_store(KAL_MAC(a, b));
+}
+
+/** r = a * b (int) (sat) */
+static inline int32_t kal_int_mult_sat(int32_t a, int32_t b)
+{
+    return kal_sat32((int64_t)a * b);
+}
+
+/** r = a * b (int), wrapping */
+static inline int32_t kal_int_mult(int32_t a, int32_t b)
+{
+    return (int32_t)((uint32_t)a * (uint32_t)b);
+}
+
+/** r = a + b */
+static inline int32_t kal_add(int32_t a, int32_t b)
+{
+    return (int32_t)((uint32_t)a + (uint32_t)b);
+}
+
+/** SIGNDET r: the left shift that normalises a word, 31 for zero */
+static inline int kal_signdet32(int32_t value)
+{
+    uint32_t magnitude = (value < 0) ? ~(uint32_t)value : (uint32_t)value;
+    int shift = 31;
+
+    while (magnitude != 0)
+    {
+        magnitude >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+/****************************************************************************
+Private Data Declarations
+*/
+
+/* aac_host_tables.c */
+extern const int32_t aac_host_sin_const_imdct[18];
+extern const int32_t aac_host_two2qtrx_lookup[4];
+extern const int32_t aac_host_x43_lookup1[36];
+extern const int32_t aac_host_x43_lookup2[36];
+extern const int32_t aac_host_x43_lookup32[64];
+extern const int32_t aac_host_sin2048_coefs[4];
+extern const int32_t aac_host_sin256_coefs[4];
+extern const int32_t aac_host_kaiser2048_coefs[36];
+extern const int32_t aac_host_kaiser256_coefs[36];
+extern const uint16_t aac_host_swb_offset_long_48[AAC_HOST_NUM_SWB_LONG + 1];
+extern const uint16_t aac_host_swb_offset_short_48[AAC_HOST_NUM_SWB_SHORT + 1];
+
+/****************************************************************************
+Private Function Declarations
+*/
+
+/* aac_host_synthesis.c */
+extern uint64_t aac_host_profile_start(void);
+extern void aac_host_profile_stop(aac_host_synthesis *synth, aac_host_profile_tool tool, uint64_t start);
+
+/* aac_host_filterbank.c: IMDCT, windowing and overlap-add of a channel, as
+   $aacdec.filterbank */
+extern void aac_host_filterbank(aac_host_synthesis *synth, aac_host_channel *chan,
+                                const aac_host_ics *ics, int32_t *pcm);
+
+#endif /* AAC_HOST_PRIVATE_H */
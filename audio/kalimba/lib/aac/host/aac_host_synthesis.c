@@ -0,0 +1,138 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_synthesis.c
+ * \ingroup aac
+ *
+ * Channel synthesis and time counters of the host AAC port. <br>
+ *
+ * A channel goes through the tools in the order of reconstruct_channels.asm
+ * and filterbank.asm. Each tool is timed with the monotonic clock between
+ * the places the DSP has its PROFILER_START and PROFILER_STOP, and the time
+ * and number of calls are added to the counters of the synthesis state.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include <string.h>
+#include <time.h>
+#include "aac_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Profiler point names, in the order of aac_host_profile_tool */
+static const char *const profile_names[AAC_HOST_PROFILE_NUM_TOOLS] =
+{
+    "profile_apply_scalefactors_and_dequantize",
+    "profile_reorder_spec",
+    "profile_imdct",
+    "profile_windowing",
+    "profile_overlap_add"
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Whether a window sequence can follow the channel's previous one */
+static int sequence_allowed(const aac_host_channel *chan, aac_host_window_sequence sequence)
+{
+    if (chan->previous_long_start)
+    {
+        return (sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE);
+    }
+    if (chan->previous_window_sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        return (sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE) || (sequence == AAC_HOST_LONG_STOP_SEQUENCE);
+    }
+    return (sequence == AAC_HOST_ONLY_LONG_SEQUENCE) || (sequence == AAC_HOST_LONG_START_SEQUENCE);
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+uint64_t aac_host_profile_start(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+void aac_host_profile_stop(aac_host_synthesis *synth, aac_host_profile_tool tool, uint64_t start)
+{
+    synth->profile.ns[tool] += aac_host_profile_start() - start;
+    synth->profile.calls[tool]++;
+}
+
+void aac_host_profile_reset(aac_host_synthesis *synth)
+{
+    memset(&synth->profile, 0, sizeof(synth->profile));
+}
+
+const char *aac_host_profile_name(aac_host_profile_tool tool)
+{
+    if ((unsigned)tool >= AAC_HOST_PROFILE_NUM_TOOLS)
+    {
+        return "unknown";
+    }
+    return profile_names[tool];
+}
+
+void aac_host_init(aac_host_synthesis *synth)
+{
+    unsigned ch;
+
+    memset(synth, 0, sizeof(*synth));
+    for (ch = 0; ch < AAC_HOST_MAX_CHANNELS; ch++)
+    {
+        synth->channel[ch].previous_window_sequence = AAC_HOST_ONLY_LONG_SEQUENCE;
+        synth->channel[ch].previous_window_shape = AAC_HOST_SIN_WINDOW;
+        synth->channel[ch].previous_long_start = 0;
+    }
+}
+
+int aac_host_synthesise_channel(aac_host_synthesis *synth, unsigned channel, aac_host_ics *ics,
+                                const int32_t *quantised, int32_t *pcm)
+{
+    aac_host_channel *chan;
+    uint64_t start;
+
+    if (channel >= AAC_HOST_MAX_CHANNELS)
+    {
+        return -1;
+    }
+    chan = &synth->channel[channel];
+    if (aac_host_calc_sfb_and_wingroup(ics) != 0)
+    {
+        return -1;
+    }
+    if (!sequence_allowed(chan, ics->window_sequence))
+    {
+        return -1;
+    }
+
+    memcpy(synth->spec, quantised, sizeof(synth->spec));
+
+    start = aac_host_profile_start();
+    aac_host_apply_scalefactors_and_dequantize(ics, synth->spec);
+    aac_host_profile_stop(synth, AAC_HOST_PROFILE_APPLY_SCALEFACTORS_AND_DEQUANTIZE, start);
+
+    if (ics->window_sequence == AAC_HOST_EIGHT_SHORT_SEQUENCE)
+    {
+        start = aac_host_profile_start();
+        aac_host_reorder_spec(ics, synth->spec, synth->tmp_mem_pool);
+        aac_host_profile_stop(synth, AAC_HOST_PROFILE_REORDER_SPEC, start);
+    }
+
+    aac_host_filterbank(synth, chan, ics, pcm);
+    return 0;
+}
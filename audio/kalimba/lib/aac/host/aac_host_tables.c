@@ -0,0 +1,146 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  aac_host_tables.c
+ * \ingroup aac
+ *
+ * Constant tables of the host AAC port, from global_variables.asm and
+ * huffman_tables_packed.asm. Fractions are as assembled: value * 2^31
+ * rounded to the nearest integer.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "aac_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** A fractional constant as the assembler rounds it */
+#define FRAC(x)             ((int32_t)((x) * 2147483648.0 + (((x) < 0) ? -0.5 : 0.5)))
+
+/****************************************************************************
+Public Constant Definitions
+*/
+
+/** IMDCT rotations, $aacdec.sin_const_imdct: cfreq and sfreq of the 128 and
+    1024 point transforms, then c and s at the start of each eighth of the
+    data for both */
+const int32_t aac_host_sin_const_imdct[18] =
+{
+    FRAC(0.9996988186), FRAC(0.0245412285), FRAC(0.9999952938), FRAC(0.0030679567),
+    FRAC(0.9999999264), FRAC(0.0003834951), FRAC(0.9227011283), FRAC(0.3855160538),
+    FRAC(0.9237327073), FRAC(0.3830377075), FRAC(0.7049340803), FRAC(0.7092728264),
+    FRAC(0.7068355571), FRAC(0.7073779012), FRAC(0.3798472089), FRAC(0.9250492407),
+    FRAC(0.3823291008), FRAC(0.9240262218)
+};
+
+/** 2^(x/4 - 1), $aacdec.two2qtrx_lookup */
+const int32_t aac_host_two2qtrx_lookup[4] =
+{
+    FRAC(0.500000000), FRAC(0.594603557), FRAC(0.707106781), FRAC(0.840896415)
+};
+
+/** x^(4/3) of normalised x below 0.75, $aacdec.x43_lookup1: exponent,
+    then the x'^0, x'^2 and x'^1 coefficients, 9 of each by SIGNDET x */
+const int32_t aac_host_x43_lookup1[36] =
+{
+    19, 17, 16, 15, 13, 12, 11, 9, 8,
+    FRAC(-0.035037674009800), FRAC(-0.073515585158020), FRAC(-0.058341562747955),
+    FRAC(-0.046293357852846), FRAC(-0.073446875438094), FRAC(-0.058232603594661),
+    FRAC(-0.046120746526867), FRAC(-0.072901102714241), FRAC(-0.057373376097530),
+    FRAC(0.279823091812432),  FRAC(0.384265203494579),  FRAC(0.305011543445289),
+    FRAC(0.242119652219117),  FRAC(0.384442062117159),  FRAC(0.305292369332165),
+    FRAC(0.242565686348826),  FRAC(0.385859712492675),  FRAC(0.307547663804144),
+    FRAC(0.560124327428639),  FRAC(0.954673318192363),  FRAC(0.757699610199779),
+    FRAC(0.601346732582897),  FRAC(0.954451961908489),  FRAC(0.757348355371505),
+    FRAC(0.600789554417133),  FRAC(0.952685629483312),  FRAC(0.754552931990474)
+};
+
+/** x^(4/3) of normalised x of 0.75 and above, $aacdec.x43_lookup2 */
+const int32_t aac_host_x43_lookup2[36] =
+{
+    0, 19, 16, 15, 14, 12, 11, 10, 8,
+    0,                        FRAC(-0.029032050166279), FRAC(-0.092162329237908),
+    FRAC(-0.073135506361723), FRAC(-0.058025822043419), FRAC(-0.092040891759098),
+    FRAC(-0.072943015489727), FRAC(-0.057721149176359), FRAC(-0.091079273726791),
+    0,                        FRAC(0.076640653889626),  FRAC(0.243330279365182),
+    FRAC(0.193149421829730),  FRAC(0.153331456240267),  FRAC(0.243489523883909),
+    FRAC(0.193402307573706),  FRAC(0.153733205981553),  FRAC(0.244766994379461),
+    0,                        FRAC(0.267386461142451),  FRAC(0.848879184108227),
+    FRAC(0.673724243883044),  FRAC(0.534685116261244),  FRAC(0.848600490484387),
+    FRAC(0.673282076604664),  FRAC(0.533983958419412),  FRAC(0.846379224210978)
+};
+
+/** x^(4/3) of x below 32 as mantissa * 2^exponent, $aacdec.x43_lookup32_flash:
+    32 exponents then 32 mantissas */
+const int32_t aac_host_x43_lookup32[64] =
+{
+    0, 1, 2, 3, 3, 4, 4, 4,
+    5, 5, 5, 5, 5, 5, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 7,
+    7, 7, 7, 7, 7, 7, 7, 7,
+    FRAC(0.0000000000), FRAC(0.5000000000), FRAC(0.6299605248), FRAC(0.5408435888),
+    FRAC(0.7937005260), FRAC(0.5343674831), FRAC(0.6814202224), FRAC(0.8369073924),
+    FRAC(0.5000000000), FRAC(0.5850235755), FRAC(0.6732608406), FRAC(0.7644931562),
+    FRAC(0.8585356819), FRAC(0.9552297168), FRAC(0.5272186203), FRAC(0.5780184548),
+    FRAC(0.6299605248), FRAC(0.6829966726), FRAC(0.7370835170), FRAC(0.7921817396),
+    FRAC(0.8482555053), FRAC(0.9052719953), FRAC(0.9632010199), FRAC(0.5110073481),
+    FRAC(0.5408435888), FRAC(0.5710972147), FRAC(0.6017570137), FRAC(0.6328125000),
+    FRAC(0.6642538374), FRAC(0.6960717808), FRAC(0.7282576184), FRAC(0.7608031267)
+};
+
+/** Sine windows by rotation, $aacdec.sin2048_coefs and sin256_coefs:
+    cos(pi/N/2), sin(pi/N/2), cos(pi/N), sin(pi/N) */
+const int32_t aac_host_sin2048_coefs[4] =
+{
+    FRAC(0.9999997059), FRAC(0.0007669903), FRAC(0.9999988235), FRAC(0.0015339802)
+};
+
+const int32_t aac_host_sin256_coefs[4] =
+{
+    FRAC(0.9999811753), FRAC(0.0061358846), FRAC(0.9999247018), FRAC(0.0122715383)
+};
+
+/** Kaiser windows as polynomials, $aacdec.kaiser2048_coefs and
+    kaiser256_coefs: six segments of the x^0..x^4 coefficients and the
+    number of values; the third and fourth are one polynomial split at the
+    half way point */
+const int32_t aac_host_kaiser2048_coefs[36] =
+{
+    FRAC(0.0003828354), FRAC(0.0224643906), FRAC(0.0523265891), FRAC(0.1343142927), FRAC(-0.0299551922), 210,
+    FRAC(0.1145978775), FRAC(0.3115340074), FRAC(0.2592987506), FRAC(-0.0108654896), FRAC(-0.0631660178), 210,
+    FRAC(0.5100967816), FRAC(0.5758919995), FRAC(-0.0008818654), FRAC(-0.2141262944), FRAC(0.0651965208), 92,
+    FRAC(0.5100967816), FRAC(0.5758919995), FRAC(-0.0008818654), FRAC(-0.2141262944), FRAC(0.0651965208), 98,
+    FRAC(0.8692721937), FRAC(0.3290540106), FRAC(-0.2648256370), FRAC(0.0320950729), FRAC(0.0353308851), 180,
+    FRAC(0.9894981150), FRAC(0.0517153546), FRAC(-0.0990314628), FRAC(0.0869802760), FRAC(-0.0293442242), 234
+};
+
+const int32_t aac_host_kaiser256_coefs[36] =
+{
+    FRAC(0.0000241752), FRAC(0.0028029329), FRAC(0.0073619623), FRAC(0.0600559776), FRAC(0.0457888540), 26,
+    FRAC(0.0592348859), FRAC(0.2295280147), FRAC(0.3056280595), FRAC(0.1657036557), FRAC(-0.1665639444), 28,
+    FRAC(0.5075518468), FRAC(0.6991855142), FRAC(0.0209393097), FRAC(-0.4259068627), FRAC(0.1667795857), 10,
+    FRAC(0.5075518468), FRAC(0.6991855142), FRAC(0.0209393097), FRAC(-0.4259068627), FRAC(0.1667795857), 14,
+    FRAC(0.9168486198), FRAC(0.2972068181), FRAC(-0.3854267702), FRAC(0.1926917615), FRAC(-0.0170969141), 23,
+    FRAC(0.9982646973), FRAC(0.0125103377), FRAC(-0.0342462435), FRAC(0.0414374941), FRAC(-0.0185043712), 27
+};
+
+/** Scalefactor band offsets at 44.1 and 48 kHz, $aacdec.swb_offset_long_48
+    and swb_offset_short_48 */
+const uint16_t aac_host_swb_offset_long_48[AAC_HOST_NUM_SWB_LONG + 1] =
+{
+    0,   4,   8,   12,  16,  20,  24,  28,  32,  36,  40,  48,  56,  64,
+    72,  80,  88,  96,  108, 120, 132, 144, 160, 176, 196, 216, 240, 264,
+    292, 320, 352, 384, 416, 448, 480, 512, 544, 576, 608, 640, 672, 704,
+    736, 768, 800, 832, 864, 896, 928, 1024
+};
+
+const uint16_t aac_host_swb_offset_short_48[AAC_HOST_NUM_SWB_SHORT + 1] =
+{
+    0,   4,   8,   12,  16,  20,  28,  36,  44,  56,  68,  80,  96,  112, 128
+};
@@ -0,0 +1,790 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host.h
+ * \ingroup audio_proc
+ *
+ * Host (PC) port of the biquad cascades, the IIR resampler, the
+ * compander and the stream mixer of the audio_proc library. <br>
+ *
+ * The PEQ cores of peq.asm, hq_peq.asm and dh_peq.asm, the 2 band
+ * crossover of xover.asm which runs two of them, and the resampler of
+ * iir_resamplev2_common.asm give the same output as the arch4 (K32)
+ * assembly: the same coefficient and parameter layouts, the same order of
+ * rMAC accumulates and the same rounding and saturation. The resampler
+ * takes its filters from iir_resamplev2_coefs.dyn, read at run time. The
+ * compander of compander.asm runs as on the DSP, or in a faster block
+ * mode with the same gain curve. The N x M mixer of audio_mux_NxM.asm,
+ * with the gain ramps of the mixer capability, runs as a full sum for
+ * each output or from a compiled list of its active routes, with the same
+ * output either way. The peak monitor of peak_monitor.asm also gives an
+ * RMS level, with both taken four samples at a time in SIMD lanes.
+ *
+ * The gain of stream_gain.asm, the mute of mute_control.asm and the fade
+ * out of audio_fadeout.asm give the same output as the DSP. The gain ramp
+ * generalises stream_gain.asm to linear and exponential ramps, which can
+ * start at a given sample or time to play. The ramp gains are made a chunk
+ * at a time and applied to every channel in SIMD lanes, and the fade out
+ * is made the same way.
+ *
+ * One object filters several channels with the same coefficients. The
+ * samples are interleaved, as in a multi-channel capability buffer, and
+ * each channel has its own history. Blocks of samples are taken through
+ * the cascade one stage at a time, with the channels in SIMD lanes when
+ * the build has SSE4.1 or NEON.
+ *
+ * This directory is not part of the Kalimba library build. To build the
+ * benchmark on a PC:
+ *
+ *     cc -O2 -msse4.1 -o audio_proc_host_bench *.c -lm
+ *     ./audio_proc_host_bench ../iir_resamplev2_coefs.dyn
+ *
+ * (no -msse4.1 on ARM, where NEON is used when the compiler enables it).
+ */
+
+#ifndef AUDIO_PROC_HOST_H
+#define AUDIO_PROC_HOST_H
+
+/****************************************************************************
+Include Files
+*/
+#include <stdint.h>
+
+/****************************************************************************
+Public Constant Declarations
+*/
+
+/** Most stages of a PEQ, PEQ_MAX_STAGES of peq_c.h */
+#define AUDIO_PROC_HOST_PEQ_MAX_STAGES          10
+
+/** Most channels of one PEQ or crossover object */
+#define AUDIO_PROC_HOST_MAX_CHANNELS            8
+
+/** Mask of the number of stages in the first word of the parameters */
+#define AUDIO_PROC_HOST_PEQ_NUM_STAGES_MASK     0xFF
+
+/** Words of PEQ parameters for x stages, PEQ_PARAMS_OBJECT_SIZE of peq_c.h
+    in words. The legacy layout for up to x stages is the same size. */
+#define AUDIO_PROC_HOST_PEQ_PARAMS_SIZE(x)      (6 * (x) + 3)
+
+/** Band inversion bits of the crossover config word, XOVER_CONFIG_INV_BAND1
+    and XOVER_CONFIG_INV_BAND2 of xover_gen_c.h */
+#define AUDIO_PROC_HOST_XOVER_INV_BAND1         0x00000002
+#define AUDIO_PROC_HOST_XOVER_INV_BAND2         0x00000004
+
+/** History words of a resampler stage for each channel,
+    IIR_RESAMPLEV2_FIR_BUFFER_SIZE and IIR_RESAMPLEV2_IIR_BUFFER_SIZE of
+    iir_resamplerv2_common.h */
+#define AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE  10
+#define AUDIO_PROC_HOST_IIR_RESAMPLER_IIR_SIZE  19
+
+/** Sections of the longest resampler IIR, iir_19_s5 */
+#define AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS 5
+
+/** IIR_RESAMPLEV2_IO_SCALE_FACTOR: the capability sets the input scale to
+    minus this and the output scale to this */
+#define AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE  9
+
+/** Samples of each channel in the buffer between two resampler stages */
+#define AUDIO_PROC_HOST_IIR_RESAMPLER_INTERMEDIATE 256
+
+/** Longest name of a module of the coefficient files */
+#define AUDIO_PROC_HOST_IIR_RESAMPLER_NAME_SIZE 64
+
+/** Most sections of the compander gain curve, which has a slope and
+    intercept for each (SLOPE1 to SLOPE6 of compander.h) */
+#define AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS  6
+
+/** Most inputs and outputs of a mixer, CHANNEL_MIXER_MAX_INPUT_CHANS and
+    CHANNEL_MIXER_MAX_OUTPUT_CHANS of the mixer capability */
+#define AUDIO_PROC_HOST_MIXER_MAX_INPUTS        8
+#define AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS       8
+
+/** Range of the output exponents */
+#define AUDIO_PROC_HOST_MIXER_MIN_EXPONENT      (-31)
+#define AUDIO_PROC_HOST_MIXER_MAX_EXPONENT      31
+
+/** Range of the exponent of a gain ramp */
+#define AUDIO_PROC_HOST_RAMP_MIN_EXPONENT       (-31)
+#define AUDIO_PROC_HOST_RAMP_MAX_EXPONENT       30
+
+/** Samples of each linear piece of an exponential ramp */
+#define AUDIO_PROC_HOST_RAMP_SEGMENT            32
+
+/** Samples the fade out of audio_fadeout.asm ramps over: its gain,
+    1.0 - n * SCALE_FRACT * SAMPLING_PERIOD_IN_USECS, is negative from
+    sample 521 */
+#define AUDIO_PROC_HOST_FADE_OUT_SAMPLES        521
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/** PEQ process functions */
+typedef enum
+{
+    AUDIO_PROC_HOST_PEQ_LEGACY,     /**< $audio_proc.peq.process */
+    AUDIO_PROC_HOST_SH_PEQ,         /**< $audio_proc.sh_peq.process */
+    AUDIO_PROC_HOST_HQ_PEQ,         /**< $audio_proc.hq_peq.process */
+    AUDIO_PROC_HOST_DH_PEQ          /**< $audio_proc.dh_peq.process */
+} audio_proc_host_peq_core;
+
+/**
+ * PEQ object, in place of t_peq_object and its delay line. The history of
+ * signal k, the input of stage k (k = num_stages for the output), is kept
+ * as history[2k] = x(n-2) and history[2k + 1] = x(n-1), one word for each
+ * channel. The DSP keeps the same values in a circular delay line.
+ */
+typedef struct
+{
+    audio_proc_host_peq_core core;
+    unsigned num_channels;
+    unsigned num_stages;
+    int headroom_bits;
+    int32_t gain_exponent;
+    int32_t gain_mantissa;
+    int32_t coeffs[AUDIO_PROC_HOST_PEQ_MAX_STAGES][6];   /**< b2, b1, b0, a2, a1, scale */
+    int32_t history[2 * (AUDIO_PROC_HOST_PEQ_MAX_STAGES + 1)][AUDIO_PROC_HOST_MAX_CHANNELS];
+    /** DH PEQ: the low words of history. HQ PEQ: the low word of rMAC
+        left by each stage, which is added to its next sum. */
+    uint32_t history_low[2 * (AUDIO_PROC_HOST_PEQ_MAX_STAGES + 1)][AUDIO_PROC_HOST_MAX_CHANNELS];
+} audio_proc_host_peq;
+
+/** 2 band crossover object, as t_xover_object with its two PEQ objects */
+typedef struct
+{
+    audio_proc_host_peq low;
+    audio_proc_host_peq high;
+    int apc;                        /**< non-zero for the APC filter type */
+    unsigned config;                /**< XOVER_CONFIG parameter */
+} audio_proc_host_xover;
+
+/** Resampler stage functions, iir_function_types of
+    iir_resamplerv2_common.h */
+typedef enum
+{
+    AUDIO_PROC_HOST_IIR_RESAMPLER_NONE,             /**< iir_1stStage_none */
+    AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE,     /**< iir_1stStage_upsample: 6 tap FIR */
+    AUDIO_PROC_HOST_IIR_RESAMPLER_UPSAMPLE,         /**< iir_2ndStage_upsample: 10 tap FIR, then IIR */
+    AUDIO_PROC_HOST_IIR_RESAMPLER_DOWNSAMPLE        /**< iir_2ndStage_downsample: IIR, then 10 tap FIR */
+} audio_proc_host_iir_resampler_function;
+
+/**
+ * A module of the coefficient files: a FIR table such as fir_L40_M21_K6, or
+ * a filter definition such as Up_160_Down_147, which is the .BLOCK filter
+ * of iir_resampler_definition. The words are those the assembler makes:
+ * fractional values rounded to Q31, $iir_resamplerv2_common constants as
+ * their enum values. A word that is the address of another module holds
+ * zero, and refs gives the index of that module.
+ */
+typedef struct
+{
+    char name[AUDIO_PROC_HOST_IIR_RESAMPLER_NAME_SIZE];     /**< name after $M.iir_resamplev2. */
+    int32_t *words;
+    int *refs;                      /**< module index of each word, or -1 */
+    unsigned num_words;
+} audio_proc_host_iir_resampler_module;
+
+/** The modules of a coefficient file and the files it includes */
+typedef struct
+{
+    audio_proc_host_iir_resampler_module *modules;
+    unsigned num_modules;
+} audio_proc_host_iir_resampler_coefs;
+
+/**
+ * A stage of the resampler: iir_resampler_stage_definition, unpacked, and
+ * the state iir_resampler_channel keeps for it. The channels are given the
+ * same number of samples, so the counters are shared. The FIR history of
+ * each channel is a ring of fir_size words and the IIR history a ring of
+ * the IIR order, one word (or, double precision, a high and a low word) for
+ * each tap of each section. Each ring is stored twice over, so a sample's
+ * taps are read from one run of rows.
+ */
+typedef struct
+{
+    audio_proc_host_iir_resampler_function function;
+    unsigned fir_size;
+    unsigned rout;
+    int input_scale;
+    int output_scale;
+    const int32_t *fir;             /**< fir_size / 2 * rout coefficients */
+    int32_t frac_ratio;
+    int32_t int_ratio;
+    unsigned iir_order;             /**< zero for the FIR upsample stage */
+    unsigned num_sections;
+    unsigned taps[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS];
+    const int32_t *iir;             /**< c0, c1 to c(taps), scale of each section */
+    int in_shift;                   /**< r6 of the stage function: IIR input shift */
+    int out_shift;                  /**< r8 of the stage function: output shift */
+    int simd_fir;                   /**< non-zero if the SIMD FIR loops can take the shifts */
+    int simd_iir;                   /**< non-zero if the SIMD IIR loops can take the shifts */
+    unsigned partial;               /**< inputs still needed for the next output */
+    unsigned counter;               /**< polyphase counter */
+    unsigned fir_pos;
+    unsigned iir_pos;
+    int32_t fir_history[2 * AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE][AUDIO_PROC_HOST_MAX_CHANNELS];
+    int32_t iir_history[2 * AUDIO_PROC_HOST_IIR_RESAMPLER_IIR_SIZE][AUDIO_PROC_HOST_MAX_CHANNELS];
+    uint32_t iir_history_low[2 * AUDIO_PROC_HOST_IIR_RESAMPLER_IIR_SIZE][AUDIO_PROC_HOST_MAX_CHANNELS];
+} audio_proc_host_iir_resampler_stage;
+
+/** Resampler object, as iir_resamplerv2_common with a channel structure and
+    history buffers for each channel */
+typedef struct
+{
+    unsigned num_channels;
+    int input_scale;
+    int output_scale;
+    int dbl_precision;
+    int32_t int_ratio;              /**< int_ratio and frac_ratio of the definition */
+    int32_t frac_ratio;
+    unsigned num_stages;            /**< 0 with no filter, which copies the input */
+    unsigned block;                 /**< inputs that fill at most the intermediate buffer */
+    audio_proc_host_iir_resampler_stage stages[2];
+    int32_t intermediate[AUDIO_PROC_HOST_IIR_RESAMPLER_INTERMEDIATE * AUDIO_PROC_HOST_MAX_CHANNELS];
+} audio_proc_host_iir_resampler;
+
+/**
+ * Compander parameters, in the layout of t_compander_params of
+ * compander_c.h. The levels and gains are log2 values.
+ */
+typedef struct
+{
+    int32_t compander_config;
+    int32_t num_sections;           /**< 2 to AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS */
+    int32_t gain_ratio[AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS - 1];         /**< q.27 */
+    int32_t gain_threshold[AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS - 1];     /**< q.27 */
+    int32_t gain_kneewidth[AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS - 1];     /**< q.31 */
+    int32_t gain_attack_tc;         /**< seconds, q.28, as the other times */
+    int32_t gain_release_tc;
+    int32_t level_attack_tc;
+    int32_t level_release_tc;
+    int32_t level_average_tc;
+    int32_t makeup_gain;            /**< q.30 */
+    int32_t lookahead_time;         /**< seconds, q.31 */
+    int32_t level_estimation_flag;  /**< 1 for the peak detector, 0 for the average */
+    int32_t gain_update_flag;       /**< 1 to update the gain every 0.5 ms, 0 every sample */
+    int32_t gain_interp_flag;       /**< 1 to step to each new gain across the 0.5 ms */
+    int32_t soft_knee_coeffs[AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS - 1][3];   /**< a, b, c, q.18 */
+} audio_proc_host_compander_params;
+
+/**
+ * Compander object, as the t_compander_object of each channel. The DSP
+ * keeps the shared values in the first channel's object; here there is
+ * one of each, but for the level detector history.
+ */
+typedef struct
+{
+    audio_proc_host_compander_params params;
+    unsigned num_channels;
+    int block_mode;                 /**< non-zero for the block mode of this port */
+    int gain_interp;
+    unsigned gain_update_rate;      /**< samples of each channel in a block */
+    int32_t gain_update_rate_inv;
+    int32_t num_channels_inv;
+    int32_t lvl_alpha_atk;
+    int32_t lvl_alpha_rls;
+    int32_t lvl_alpha_avg;
+    int32_t gain_alpha_atk;
+    int32_t gain_alpha_rls;
+    int32_t slope[AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS];         /**< q.27 */
+    int32_t intercept[AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS];     /**< q.23 */
+    int32_t level_hist[AUDIO_PROC_HOST_MAX_CHANNELS];   /**< LEVEL_DETECT_LAST_SAMPLE_HIST */
+    int32_t gain_smooth_hist;       /**< log2, q.24 */
+    int32_t gain_smooth_hist_linear;    /**< q.27 */
+    unsigned lookahead_samples;
+    unsigned lookahead_pos;         /**< PTR_LOOKAHEAD_HIST, in samples of each channel */
+    int32_t *lookahead_hist;        /**< interleaved, as the input */
+    int32_t lookahead_frame[AUDIO_PROC_HOST_MAX_CHANNELS];  /**< history with no look-ahead */
+} audio_proc_host_compander;
+
+/** How the sparse mixer makes an output */
+typedef enum
+{
+    AUDIO_PROC_HOST_MIXER_SILENT,   /**< no active routes: zeros */
+    AUDIO_PROC_HOST_MIXER_COPY,     /**< one unity route: a copy of its input */
+    AUDIO_PROC_HOST_MIXER_SUM,      /**< fixed gains: a block sum, unity routes added */
+    AUDIO_PROC_HOST_MIXER_RAMP,     /**< a gain ramping: sample by sample */
+    AUDIO_PROC_HOST_MIXER_WIDE      /**< a sum that needs rMAC's width: sample by sample in it */
+} audio_proc_host_mixer_path;
+
+/** An output of the compiled gain matrix: its active routes, the unity
+    ones first */
+typedef struct
+{
+    audio_proc_host_mixer_path path;
+    unsigned num_routes;
+    unsigned num_unity;
+    unsigned input[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+    int32_t gain[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+    int32_t gain_adjust[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+} audio_proc_host_mixer_output;
+
+/**
+ * Mixer object. Output j is the sum of input i times gain[j][i] for each
+ * input, times 2^exponent[j], as audio_mux_NxM.asm makes it from
+ * PTR_IN_CHAN_MANT and PTR_OUT_CHAN_EXP; a masked input is a zero gain.
+ * The gains ramp as the mixer capability's: all together, over
+ * samples_to_ramp samples from the call after they are set.
+ */
+typedef struct
+{
+    unsigned num_inputs;
+    unsigned num_outputs;
+    int sparse;                     /**< non-zero to mix from the compiled routes */
+    unsigned samples_to_ramp;
+    int32_t inv_samples_to_ramp;
+    unsigned transition_count;      /**< samples left of the ramp */
+    int restart_transition;
+    int reset_gains;                /**< the routes need compiling */
+    int exponent[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS];
+    int32_t current_gain[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS][AUDIO_PROC_HOST_MIXER_MAX_INPUTS];   /**< q.31 */
+    int32_t target_gain[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS][AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+    int32_t gain_adjust[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS][AUDIO_PROC_HOST_MIXER_MAX_INPUTS];    /**< per sample */
+    audio_proc_host_mixer_output routes[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS];
+} audio_proc_host_mixer;
+
+/**
+ * Peak monitor, as the peak monitor data object, with the sum of squares
+ * for an RMS level. The owner reads and clears it.
+ */
+typedef struct
+{
+    int32_t peak_level;             /**< PEAK_LEVEL: largest magnitude */
+    uint64_t sum_squares;           /**< sum of the squares as q.31, truncated */
+    uint32_t samples;               /**< samples in sum_squares */
+} audio_proc_host_peak_monitor;
+
+/** Shapes of a gain ramp */
+typedef enum
+{
+    AUDIO_PROC_HOST_RAMP_LINEAR,
+    AUDIO_PROC_HOST_RAMP_EXPONENTIAL    /**< linear pieces between points of a geometric series */
+} audio_proc_host_ramp_shape;
+
+/**
+ * Gain ramp. The gain is a q.31 mantissa applied as stream_gain.asm applies
+ * it: the product with each sample is shifted by the exponent and
+ * truncated. A ramp is made of linear pieces: the gain * 2^31 steps by a
+ * fixed amount each sample, and is set to the piece's end point at its
+ * end. A linear ramp is one piece.
+ */
+typedef struct
+{
+    int exponent;
+    int32_t gain;                   /**< gain of the next sample */
+    int32_t target;
+    audio_proc_host_ramp_shape shape;
+    unsigned delay;                 /**< samples before the ramp starts */
+    unsigned remaining;             /**< samples left of the ramp */
+    unsigned segment_left;          /**< samples left of the piece */
+    int32_t segment_end;            /**< gain at the end of the piece */
+    int64_t position;               /**< gain * 2^31 in the piece */
+    int64_t step;
+    double start_level;             /**< exponential: first point and ratio of the series */
+    double ratio;
+    unsigned segment;               /**< exponential: the piece, from 0 */
+} audio_proc_host_ramp;
+
+/** States of a fade out, FADEOUT_STATE of audio_fadeout.h */
+typedef enum
+{
+    AUDIO_PROC_HOST_FADE_OUT_NOT_RUNNING,
+    AUDIO_PROC_HOST_FADE_OUT_RUNNING,
+    AUDIO_PROC_HOST_FADE_OUT_FLUSHING,
+    AUDIO_PROC_HOST_FADE_OUT_END
+} audio_proc_host_fade_out_state;
+
+/** Fade out, as FADEOUT_PARAMS */
+typedef struct
+{
+    unsigned counter;               /**< samples since the fade out started */
+    audio_proc_host_fade_out_state state;
+    unsigned flush_count;           /**< zeros left to flush before the end */
+} audio_proc_host_fade_out;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief Select the SIMD or scalar loops. The SIMD loops are used by
+ *        default when the build has them.
+ */
+extern void audio_proc_host_set_simd(int enable);
+
+/**
+ * \brief Set up a PEQ object for one of the cores, with a zero delay line.
+ *
+ * \param peq The object.
+ * \param core The process function to match.
+ * \param num_channels Channels in the interleaved buffers, 1 to
+ *        AUDIO_PROC_HOST_MAX_CHANNELS.
+ */
+extern void audio_proc_host_peq_init(audio_proc_host_peq *peq, audio_proc_host_peq_core core,
+                                     unsigned num_channels);
+
+/**
+ * \brief Load the parameters, as the core's initialize function.
+ *
+ * \param peq The object.
+ * \param params Parameters in the layout of t_peq_params: the number of
+ *        stages, gain exponent, gain mantissa, then b2, b1, b0, a2, a1 and
+ *        scale of each stage. The legacy core has the b2 to a1 of
+ *        max_stages stages, then the scale of each stage.
+ * \param max_stages MAX_STAGES_FIELD of the legacy PEQ object; not used by
+ *        the other cores.
+ *
+ * \return Zero if the number of stages is not 1 to
+ *         AUDIO_PROC_HOST_PEQ_MAX_STAGES, non-zero otherwise.
+ */
+extern int audio_proc_host_peq_set_params(audio_proc_host_peq *peq, const int32_t *params,
+                                          unsigned max_stages);
+
+/**
+ * \brief Clear the history, as the core's zero_delay_data function.
+ */
+extern void audio_proc_host_peq_zero_delay_data(audio_proc_host_peq *peq);
+
+/**
+ * \brief Filter interleaved samples, as the core's process function.
+ *
+ * \param peq The object.
+ * \param input num_channels * samples interleaved input samples.
+ * \param output num_channels * samples interleaved output samples, which
+ *        may be the input buffer.
+ * \param samples Samples of each channel.
+ */
+extern void audio_proc_host_peq_process(audio_proc_host_peq *peq, const int32_t *input, int32_t *output,
+                                        unsigned samples);
+
+/**
+ * \brief Set up a crossover object, with zero delay lines.
+ *
+ * \param xover The object.
+ * \param core Process function of the bands: SH, HQ or DH.
+ * \param num_channels Channels in the interleaved buffers.
+ * \param apc Non-zero for the APC filter type, where the bands are made
+ *        from the sum and difference of the two filter outputs.
+ * \param config XOVER_CONFIG parameter, for the band inversion bits.
+ */
+extern void audio_proc_host_xover_init(audio_proc_host_xover *xover, audio_proc_host_peq_core core,
+                                       unsigned num_channels, int apc, unsigned config);
+
+/**
+ * \brief Load the low and high band PEQ parameters, as made by the
+ *        crossover initialize function.
+ *
+ * \return Zero if either has a bad number of stages.
+ */
+extern int audio_proc_host_xover_set_params(audio_proc_host_xover *xover, const int32_t *low_params,
+                                            const int32_t *high_params);
+
+/**
+ * \brief Split interleaved samples into low and high bands, as
+ *        $audio_proc.xover_2band.stream_process. The outputs may not be the
+ *        input buffer.
+ */
+extern void audio_proc_host_xover_process(audio_proc_host_xover *xover, const int32_t *input,
+                                          int32_t *low, int32_t *high, unsigned samples);
+
+/**
+ * \brief Read a resampler coefficient file, such as
+ *        iir_resamplev2_coefs.dyn, and the .dyn files it includes.
+ *
+ * \param coefs Set to the modules of the files.
+ * \param path The file.
+ *
+ * \return Zero if a file cannot be read or a module refers to one that is
+ *         not there, non-zero otherwise.
+ */
+extern int audio_proc_host_iir_resampler_load_coefs(audio_proc_host_iir_resampler_coefs *coefs, const char *path);
+
+/**
+ * \brief Free the modules read by audio_proc_host_iir_resampler_load_coefs.
+ */
+extern void audio_proc_host_iir_resampler_free_coefs(audio_proc_host_iir_resampler_coefs *coefs);
+
+/**
+ * \brief Find a module by name, such as "Up_147_Down_160_low_mips".
+ *
+ * \return The module, or NULL if there is none.
+ */
+extern const audio_proc_host_iir_resampler_module *audio_proc_host_iir_resampler_find(
+    const audio_proc_host_iir_resampler_coefs *coefs, const char *name);
+
+/**
+ * \brief Find the filter for a pair of rates, as
+ *        iir_resamplerv2_get_id_from_rate.
+ *
+ * \param coefs The modules.
+ * \param in_rate Input sample rate.
+ * \param out_rate Output sample rate.
+ * \param low_mips Non-zero for the low MIPS filter where there is one.
+ *
+ * \return The filter definition, or NULL if there is none or the rates are
+ *         the same.
+ */
+extern const audio_proc_host_iir_resampler_module *audio_proc_host_iir_resampler_find_rate(
+    const audio_proc_host_iir_resampler_coefs *coefs, unsigned in_rate, unsigned out_rate, int low_mips);
+
+/**
+ * \brief Set up a resampler object and reset it.
+ *
+ * \param rs The object.
+ * \param coefs The modules the filter was found in.
+ * \param filter Filter definition, or NULL to copy the input with the two
+ *        scales applied.
+ * \param num_channels Channels in the interleaved buffers.
+ * \param input_scale Shift of the input, as the common input_scale.
+ * \param output_scale Shift of the output, as the common output_scale.
+ * \param dbl_precision Non-zero for the double precision IIR functions.
+ *
+ * \return Zero if the definition is not one the assembly can run,
+ *         non-zero otherwise.
+ */
+extern int audio_proc_host_iir_resampler_init(audio_proc_host_iir_resampler *rs,
+                                              const audio_proc_host_iir_resampler_coefs *coefs,
+                                              const audio_proc_host_iir_resampler_module *filter,
+                                              unsigned num_channels, int input_scale, int output_scale,
+                                              int dbl_precision);
+
+/**
+ * \brief Reset the stages, as reset_iir_resampler. This clears the counters
+ *        and the IIR history; the FIR history is kept, as on the DSP.
+ */
+extern void audio_proc_host_iir_resampler_reset(audio_proc_host_iir_resampler *rs);
+
+/**
+ * \brief Most samples of each channel that a call with the given number of
+ *        input samples can produce.
+ */
+extern unsigned audio_proc_host_iir_resampler_max_output(const audio_proc_host_iir_resampler *rs,
+                                                         unsigned samples);
+
+/**
+ * \brief Resample interleaved samples, as $iir_perform_resample on each
+ *        channel.
+ *
+ * \param rs The object.
+ * \param input num_channels * samples interleaved input samples.
+ * \param output Interleaved output, with room for max_output samples of
+ *        each channel. It may not be the input buffer.
+ * \param samples Input samples of each channel.
+ *
+ * \return Samples of each channel written to the output.
+ */
+extern unsigned audio_proc_host_iir_resampler_process(audio_proc_host_iir_resampler *rs, const int32_t *input,
+                                                      int32_t *output, unsigned samples);
+
+/**
+ * \brief Words of look-ahead history a compander needs.
+ */
+extern unsigned audio_proc_host_compander_lookahead_size(const audio_proc_host_compander_params *params,
+                                                         unsigned sample_rate, unsigned num_channels);
+
+/**
+ * \brief Set up a compander object, as $audio_proc.cmpd.initialize on
+ *        each channel, with the detector and gain history cleared.
+ *
+ * \param cmpd The object.
+ * \param params The parameters, which are copied.
+ * \param num_channels Channels in the interleaved buffers.
+ * \param sample_rate Sample rate in Hz.
+ * \param block_mode Zero to run as the DSP, with the gain updated every
+ *        sample or every 0.5 ms as gain_update_flag says. Non-zero for the
+ *        block mode of this port, which updates it every 0.5 ms.
+ * \param lookahead_hist History for the look-ahead delay, or NULL for none.
+ * \param lookahead_size Words at lookahead_hist. With fewer than
+ *        audio_proc_host_compander_lookahead_size there is no delay, as on
+ *        the DSP when the history cannot be allocated.
+ *
+ * \return Zero if num_sections or num_channels is out of range, non-zero
+ *         otherwise.
+ */
+extern int audio_proc_host_compander_init(audio_proc_host_compander *cmpd,
+                                          const audio_proc_host_compander_params *params,
+                                          unsigned num_channels, unsigned sample_rate, int block_mode,
+                                          int32_t *lookahead_hist, unsigned lookahead_size);
+
+/**
+ * \brief Compand interleaved samples, as
+ *        $audio_proc.compander.stream_process.
+ *
+ * \param cmpd The object.
+ * \param input num_channels * samples interleaved input samples.
+ * \param output Interleaved output. It may not be the input buffer.
+ * \param samples Samples of each channel.
+ *
+ * \return Samples of each channel processed: the whole blocks of
+ *         gain_update_rate samples. The rest should be passed again with
+ *         the next input.
+ */
+extern unsigned audio_proc_host_compander_process(audio_proc_host_compander *cmpd, const int32_t *input,
+                                                  int32_t *output, unsigned samples);
+
+/**
+ * \brief Set up a mixer object with all gains zero, exponents zero and no
+ *        ramp.
+ *
+ * \param mixer The object.
+ * \param num_inputs Input channels, 1 to AUDIO_PROC_HOST_MIXER_MAX_INPUTS.
+ * \param num_outputs Output channels, 1 to
+ *        AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS.
+ * \param sparse Zero to make every output as the DSP does, as the sum of
+ *        all the inputs. Non-zero to make it from the compiled routes of
+ *        the gain matrix, which skip the zero gains, copy or add the inputs
+ *        with unity gain, and only take the ramping outputs sample by
+ *        sample.
+ *
+ * \return Zero if num_inputs or num_outputs is out of range, non-zero
+ *         otherwise.
+ */
+extern int audio_proc_host_mixer_init(audio_proc_host_mixer *mixer, unsigned num_inputs, unsigned num_outputs,
+                                      int sparse);
+
+/**
+ * \brief Set the length of the gain ramps, as
+ *        OPMSG_MIXER_ID_SET_RAMP_NUM_SAMPLES. Zero makes new gains apply
+ *        at once.
+ */
+extern void audio_proc_host_mixer_set_ramp(audio_proc_host_mixer *mixer, unsigned samples);
+
+/**
+ * \brief Set the shift of an output, as its PTR_OUT_CHAN_EXP entry. It
+ *        applies from the next call, without a ramp.
+ *
+ * \return Zero if the output or the exponent is out of range.
+ */
+extern int audio_proc_host_mixer_set_exponent(audio_proc_host_mixer *mixer, unsigned output, int exponent);
+
+/**
+ * \brief Set the gain mantissa of the route from an input to an output.
+ *        With a ramp length set, all the gains move to their targets over
+ *        that many samples from the next call, as gen_mixer_set_gain
+ *        starts a transition; otherwise the gain applies from the next
+ *        call.
+ *
+ * \param mixer The object.
+ * \param output The output.
+ * \param input The input.
+ * \param gain q.31 mantissa. Unity is 2^(31 - exponent) with an exponent
+ *        of 1 to 30.
+ *
+ * \return Zero if the output or input is out of range.
+ */
+extern int audio_proc_host_mixer_set_gain(audio_proc_host_mixer *mixer, unsigned output, unsigned input,
+                                          int32_t gain);
+
+/**
+ * \brief Mix, as $M.Audio_Mux_NxM.Process with the gains stepped as
+ *        $_gen_mixer_process_channels steps them.
+ *
+ * \param mixer The object.
+ * \param inputs num_inputs input channels.
+ * \param outputs num_outputs output channels, which may not be inputs.
+ * \param samples Samples of each channel.
+ */
+extern void audio_proc_host_mixer_process(audio_proc_host_mixer *mixer, const int32_t *const *inputs,
+                                          int32_t *const *outputs, unsigned samples);
+
+/**
+ * \brief Clear the peak level and the sum of squares.
+ */
+extern void audio_proc_host_peak_monitor_reset(audio_proc_host_peak_monitor *monitor);
+
+/**
+ * \brief Raise the peak level to the largest magnitude of a block, as
+ *        $M.audio_proc.peak_monitor.Process.func on a frame, and add the
+ *        block to the sum of squares.
+ */
+extern void audio_proc_host_peak_monitor_process(audio_proc_host_peak_monitor *monitor, const int32_t *input,
+                                                 unsigned samples);
+
+/**
+ * \brief RMS level of the samples since the monitor was cleared, q.31.
+ */
+extern int32_t audio_proc_host_peak_monitor_rms(const audio_proc_host_peak_monitor *monitor);
+
+/**
+ * \brief Apply a gain, as $M.audio_proc.stream_gain.Process: each output
+ *        is input * mantissa, shifted by exponent, truncated and saturated.
+ *        output may be input.
+ */
+extern void audio_proc_host_stream_gain(const int32_t *input, int32_t *output, unsigned samples,
+                                        int32_t mantissa, int exponent);
+
+/**
+ * \brief Zero a buffer if state is mute_value, as
+ *        $M.MUTE_CONTROL.Process.func.
+ */
+extern void audio_proc_host_mute_control(int32_t *buffer, unsigned samples, int32_t state, int32_t mute_value);
+
+/**
+ * \brief Set up a gain ramp at a fixed gain.
+ *
+ * \param ramp The object.
+ * \param gain q.31 mantissa.
+ * \param exponent Shift of the products, AUDIO_PROC_HOST_RAMP_MIN_EXPONENT
+ *        to AUDIO_PROC_HOST_RAMP_MAX_EXPONENT.
+ *
+ * \return Zero if the exponent is out of range, non-zero otherwise.
+ */
+extern int audio_proc_host_ramp_init(audio_proc_host_ramp *ramp, int32_t gain, int exponent);
+
+/**
+ * \brief Start a ramp from the current gain to a target, in place of any
+ *        ramp in progress.
+ *
+ * \param ramp The object.
+ * \param target q.31 mantissa at the end of the ramp.
+ * \param samples Length of the ramp; zero sets the target at the start.
+ * \param shape Linear, or exponential: points of a geometric series every
+ *        AUDIO_PROC_HOST_RAMP_SEGMENT samples, with a gain below -96 dB
+ *        taken as -96 dB for the series. A ramp with both ends at or below
+ *        -96 dB is linear.
+ * \param delay Samples of the next calls before the ramp starts.
+ */
+extern void audio_proc_host_ramp_start(audio_proc_host_ramp *ramp, int32_t target, unsigned samples,
+                                       audio_proc_host_ramp_shape shape, unsigned delay);
+
+/**
+ * \brief Delay of a ramp that is to start at a time to play, from the time
+ *        to play of the first sample of the next block. Times are in
+ *        microseconds and wrap as the DSP's do.
+ *
+ * \return Samples, rounded; zero for a start time not after the block's.
+ */
+extern unsigned audio_proc_host_ramp_ttp_delay(uint32_t start_time, uint32_t block_time, unsigned sample_rate);
+
+/**
+ * \brief Non-zero while a ramp is waiting to start or in progress.
+ */
+extern int audio_proc_host_ramp_active(const audio_proc_host_ramp *ramp);
+
+/**
+ * \brief Apply the gain to a block of each channel, stepping the ramp.
+ *
+ * \param ramp The object.
+ * \param inputs Input channels.
+ * \param outputs Output channels, which may be the inputs.
+ * \param channels Channels, all with the same gain.
+ * \param samples Samples of each channel.
+ */
+extern void audio_proc_host_ramp_process(audio_proc_host_ramp *ramp, const int32_t *const *inputs,
+                                         int32_t *const *outputs, unsigned channels, unsigned samples);
+
+/**
+ * \brief Fade out in place, as $audio.fade_out for one channel and
+ *        $audio.fade_out_stereo for two: the gain falls from 1.0 to zero
+ *        over AUDIO_PROC_HOST_FADE_OUT_SAMPLES, then flush_count zeros are
+ *        written before the end state, which writes zeros. Any state but
+ *        flushing and end runs the ramp, as on the DSP.
+ *
+ * \return Non-zero in the call the flush ends, as mono_cbuffer_fadeout.
+ */
+extern int audio_proc_host_fade_out_process(audio_proc_host_fade_out *fade, int32_t *const *buffers,
+                                            unsigned channels, unsigned samples);
+
+#endif /* AUDIO_PROC_HOST_H */
@@ -0,0 +1,2537 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_bench.c
+ * \ingroup audio_proc
+ *
+ * Benchmark and regression tool for the host audio_proc port. <br>
+ *
+ * Checks the PEQ cores and the crossover against a plain model of the
+ * assembly, which walks the circular delay line of each channel as the
+ * DSP does, with the SIMD loops and without. Then reports the speed of
+ * each version for a range of stages, channels and block sizes. Returns
+ * non-zero on any mismatch.
+ *
+ * The resampler is checked the same way for every filter of the
+ * coefficient file given on the command line (by default the one in the
+ * library directory), and timed for the common rate pairs next to the DSP
+ * cycles the assembly headers give.
+ *
+ * The compander's block mode is checked against itself without SIMD, and
+ * both modes for calls of any size against one whole call. Then the block
+ * mode and the DSP's 0.5 ms mode are compared with the DSP's per-sample
+ * gain on tone bursts, for output error and speed.
+ *
+ * The sparse mixer is checked against the dense one, with the SIMD loops
+ * and without, for random gain matrices that change and ramp between calls
+ * of random size. Then both are timed on the usual 2 to 2, 4 to 2 and 6 to
+ * 2 mixes, with fixed gains and with one gain ramping.
+ *
+ * The peak monitor is checked against the assembly's loop and the RMS
+ * level against a double precision one, to the truncation of the squares,
+ * with the SIMD loop and without, for calls of random size, and timed for
+ * common frame sizes.
+ *
+ * Stream gain is checked against rMAC ASHIFT and the fade out against a
+ * per-sample model of audio_fadeout.asm, mono and stereo, for calls of
+ * random size from any state. The gain ramp is checked for the same output
+ * in one call, in calls of random size and sample by sample, with SIMD and
+ * without, for its start and end gains, for a steady gain equal to stream
+ * gain, and for gains that only move towards the target. Each is then
+ * timed against a per-sample loop.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_proc_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define PEQ_TEST_RUNS       12
+#define MAX_TEST_SAMPLES    600
+#define BENCH_SECONDS       0.2
+#define BENCH_SAMPLES       1024
+#define PARAMS_SIZE         AUDIO_PROC_HOST_PEQ_PARAMS_SIZE(AUDIO_PROC_HOST_PEQ_MAX_STAGES)
+#define RS_TEST_SAMPLES     400
+#define RS_MAX_CALL         90
+#define RS_MAX_RATIO        48
+#define RS_DEFAULT_COEFS    "../iir_resamplev2_coefs.dyn"
+#define CMPD_RATE           48000
+#define CMPD_TEST_SAMPLES   2400
+#define CMPD_MAX_CALL       100
+#define CMPD_BURST_SAMPLES  4800
+#define CMPD_WINDOW         240
+#define CMPD_MAX_LOOKAHEAD  ((CMPD_RATE / 500 + 1) * AUDIO_PROC_HOST_MAX_CHANNELS)
+#define MIX_TEST_RUNS       400
+#define MIX_MAX_CALL        70
+#define MIX_MAX_RAMP        300
+#define PEAK_TEST_RUNS      200
+#define PEAK_MAX_CALL       300
+#define GAIN_TEST_RUNS      200
+#define FADE_TEST_RUNS      300
+#define FADE_MAX_CALL       200
+#define RAMP_TEST_RUNS      300
+#define RAMP_TEST_SAMPLES   2400
+#define RAMP_MAX_CALL       300
+#define FADE_OUT_STEP       ((1 << 16) * 63)
+
+/** Unity and -3 dB gains of the mixes, with an exponent of 1 */
+#define MIX_UNITY           0x40000000
+#define MIX_MINUS_3DB       0x2D413CCD
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** One channel of a PEQ data object with its delay line */
+typedef struct
+{
+    audio_proc_host_peq_core core;
+    const int32_t *params;
+    unsigned max_stages;
+    unsigned num_stages;
+    int headroom_bits;
+    unsigned delayline_size;
+    unsigned delayline_addr;
+    int32_t delayline[4 * (AUDIO_PROC_HOST_PEQ_MAX_STAGES + 1)];
+} model_peq;
+
+/** A stage of one channel of the resampler, as iir_resampler_channel: the
+    FIR history ring with I0, the IIR history ring with I4 */
+typedef struct
+{
+    unsigned partial;
+    unsigned counter;
+    unsigned i0;
+    unsigned i4;
+    int32_t fir[AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE];
+    int32_t iir[2 * AUDIO_PROC_HOST_IIR_RESAMPLER_IIR_SIZE];
+} model_rs_stage;
+
+/** One channel of the resampler, with the common scales and filter */
+typedef struct
+{
+    const audio_proc_host_iir_resampler_coefs *coefs;
+    const audio_proc_host_iir_resampler_module *filter;
+    int input_scale;
+    int output_scale;
+    int dbl_precision;
+    model_rs_stage stages[2];
+} model_rs;
+
+/** Rates to time, with the low MIPS filter where there is one */
+typedef struct
+{
+    unsigned in_rate;
+    unsigned out_rate;
+} rate_pair;
+
+/** A mix to time: the gains of each output, with an exponent of 1, and
+    the route that ramps */
+typedef struct
+{
+    const char *name;
+    unsigned num_inputs;
+    unsigned num_outputs;
+    int32_t gains[2][6];
+    unsigned ramp_output;
+    unsigned ramp_input;
+} mix_case;
+
+/** The fade out as audio_fadeout.asm keeps it, flush count in r5 */
+typedef struct
+{
+    uint32_t counter;
+    int state;
+    int32_t flush_count;
+} model_fade;
+
+/****************************************************************************
+Private Variable Definitions
+*/
+static uint32_t random_state = 1;
+
+static const char *core_names[] = {"peq", "sh_peq", "hq_peq", "dh_peq"};
+
+/* History taps of each section of the IIR functions, from the History reads
+   of iir_resamplev2_common.asm, in the order of iir_function_types */
+static const unsigned model_iir_taps[][AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS + 1] =
+{
+    {10, 9}, {7, 6, 6}, {6, 5, 4, 4}, {4, 4, 4, 4, 3}, {6, 5, 4}, {8, 7}, {5, 4}
+};
+
+static const rate_pair bench_rates[] =
+{
+    {44100, 48000}, {48000, 44100}, {16000, 44100}, {44100, 16000},
+    {16000, 48000}, {48000, 16000}, {8000, 48000}, {48000, 8000}
+};
+
+/* COMPANDER defaults of compander_gen_defs.c */
+static const audio_proc_host_compander_params default_compander_params =
+{
+    0x00000000, 6,
+    {0x30000000, 0x08000000, 0x04000000, 0x08000000, 0x08000000},
+    {(int32_t)0xF2B65A9B, (int32_t)0xD02A0BA2, (int32_t)0xCD81B867, (int32_t)0xC2E0663C, (int32_t)0xBAE7674D},
+    {0x550A6762, 0x15426FE7, 0x15426FE7, 0x00000000, 0x00000000},
+    0x00147AE1, 0x02666666, 0x000014F9, 0x0020C49C, 0x00147AE1,
+    0x00000000, 0x00000000, 1, 1, 1,
+    {
+        {(int32_t)0xFFFD7DCD, (int32_t)0xFFFA0000, (int32_t)0xFFF75CED},
+        {(int32_t)0xFFF3F574, (int32_t)0xFF760000, (int32_t)0xFE5EAECB},
+        {0x000C0A8C, 0x009E0000, 0x01EC648E},
+        {0x00000000, 0x00040000, 0x00000000},
+        {0x00000000, 0x00040000, 0x00000000}
+    }
+};
+
+/* Stereo through, quad and 5.1 (L, R, C, LFE, Ls, Rs) down to stereo */
+static const mix_case mix_cases[] =
+{
+    {"2->2 stereo", 2, 2, {{MIX_UNITY, 0}, {0, MIX_UNITY}}, 0, 0},
+    {"4->2 quad", 4, 2, {{MIX_UNITY, 0, MIX_MINUS_3DB, 0}, {0, MIX_UNITY, 0, MIX_MINUS_3DB}}, 0, 2},
+    {"6->2 5.1", 6, 2,
+     {{MIX_UNITY, 0, MIX_MINUS_3DB, 0, MIX_MINUS_3DB, 0}, {0, MIX_UNITY, MIX_MINUS_3DB, 0, 0, MIX_MINUS_3DB}},
+     0, 2}
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* The LCG state through a mixing function. The low bits of the state
+   repeat with short periods, so tests that take a few bits of a word get
+   the mixed bits instead. */
+static int32_t random_word(void)
+{
+    uint32_t x;
+
+    random_state = random_state * 1664525u + 1013904223u;
+    x = random_state;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return (int32_t)x;
+}
+
+/* b2, b1, b0, a2, a1 of a stage in the parameters */
+static int32_t model_coeff(const model_peq *m, unsigned stage, unsigned index)
+{
+    unsigned per_stage = (m->core == AUDIO_PROC_HOST_PEQ_LEGACY) ? 5 : 6;
+
+    return m->params[3 + per_stage * stage + index];
+}
+
+static int model_scale(const model_peq *m, unsigned stage)
+{
+    if (m->core == AUDIO_PROC_HOST_PEQ_LEGACY)
+    {
+        return m->params[3 + 5 * m->max_stages + stage];
+    }
+    return m->params[3 + 6 * stage + 5];
+}
+
+/* The initialize and zero_delay_data functions of the core */
+static void model_init(model_peq *m, audio_proc_host_peq_core core, const int32_t *params, unsigned max_stages)
+{
+    memset(m, 0, sizeof(*m));
+    m->core = core;
+    m->params = params;
+    m->max_stages = max_stages;
+    m->num_stages = (uint32_t)params[0] & AUDIO_PROC_HOST_PEQ_NUM_STAGES_MASK;
+    m->headroom_bits = (core == AUDIO_PROC_HOST_PEQ_LEGACY) ? AUDIO_PROC_HOST_LEGACY_PEQ_HEADROOM
+                                                            : AUDIO_PROC_HOST_PEQ_HEADROOM;
+    switch (core)
+    {
+        case AUDIO_PROC_HOST_HQ_PEQ:
+            m->delayline_size = 3 * m->num_stages + 2;
+            break;
+        case AUDIO_PROC_HOST_DH_PEQ:
+            m->delayline_size = 4 * (m->num_stages + 1);
+            break;
+        default:
+            m->delayline_size = 2 * (m->num_stages + 1);
+            break;
+    }
+}
+
+/* Step a circular delay line index */
+static unsigned step(const model_peq *m, unsigned p, int amount)
+{
+    return (p + m->delayline_size + (unsigned)amount) % m->delayline_size;
+}
+
+/* One sample through $audio_proc.sh_peq.process_op or
+   $audio_proc.peq.process_op: rMACB carries each stage's output into the
+   next, and the pointer moves one word along the delay line each sample */
+static int32_t model_sh_sample(model_peq *m, int32_t in)
+{
+    int32_t *d = m->delayline;
+    unsigned p = m->delayline_addr;
+    kal_rmac rmacb = kal_rmac_ashift(KAL_MAC(in, m->params[2]), m->params[1] - m->headroom_bits);
+    int32_t r0, r3, r5;
+    unsigned s;
+
+    r3 = d[p];
+    p = step(m, p, 1);
+    for (s = 0; s < m->num_stages; s++)
+    {
+        kal_rmac rmac = KAL_MAC(model_coeff(m, s, 0), r3);
+
+        r5 = d[p];
+        p = step(m, p, 1);
+        rmac += KAL_MAC(model_coeff(m, s, 1), r5);
+        r3 = d[p];
+        p = step(m, p, 1);
+        rmac += KAL_MAC(model_coeff(m, s, 2), kal_rmac_store(rmacb));
+        r5 = d[p];
+        p = step(m, p, -1);
+        rmac -= KAL_MAC(model_coeff(m, s, 3), r3);
+        r0 = kal_rmac_store(rmacb);
+        rmac -= KAL_MAC(model_coeff(m, s, 4), r5);
+        d[p] = r0;
+        p = step(m, p, 1);
+        rmacb = kal_rmac_ashift(rmac, model_scale(m, s));
+    }
+    r0 = kal_rmac_store(rmacb);
+    p = step(m, p, 1);
+    d[p] = r0;
+    m->delayline_addr = step(m, p, 1);
+    return kal_rmac_store(kal_rmac_ashift(rmacb, m->headroom_bits));
+}
+
+/* One sample through $audio_proc.hq_peq.process_op: the low word of each
+   stage's rMAC is kept in the delay line and starts its next sum. The
+   pointer comes back to the start of the delay line. */
+static int32_t model_hq_sample(model_peq *m, int32_t in)
+{
+    int32_t *d = m->delayline;
+    int32_t r0 = kal_rmac_to_reg(KAL_MAC(in, m->params[2]), m->params[1] - m->headroom_bits);
+    unsigned p = 0;
+    int32_t r1, r2;
+    uint32_t r3;
+    unsigned s;
+
+    r2 = d[p++];
+    r1 = d[p++];
+    for (s = 0; s < m->num_stages; s++)
+    {
+        kal_rmac rmac;
+
+        r3 = (uint32_t)d[p];
+        p = step(m, p, -1);
+        rmac = r3;
+        rmac += KAL_MAC(r2, model_coeff(m, s, 0));
+        d[p] = r0;
+        p = step(m, p, -1);
+        rmac += KAL_MAC(r1, model_coeff(m, s, 1));
+        d[p] = r1;
+        p = step(m, p, 3);
+        rmac += KAL_MAC(r0, model_coeff(m, s, 2));
+        r2 = d[p];
+        p = step(m, p, 1);
+        rmac -= KAL_MAC(r2, model_coeff(m, s, 3));
+        r1 = d[p];
+        p = step(m, p, -1);
+        rmac -= KAL_MAC(r1, model_coeff(m, s, 4));
+        r2 = d[p];
+        p = step(m, p, -1);
+        r3 = kal_rmac_low(rmac);
+        rmac -= r3;
+        r0 = kal_rmac_to_reg(rmac, model_scale(m, s));
+        d[p] = (int32_t)r3;
+        p = step(m, p, 3);
+    }
+    p = step(m, p, -2);
+    d[p] = r1;
+    p = step(m, p, 1);
+    d[p] = r0;
+    return kal_ashift32(r0, m->headroom_bits);
+}
+
+/* One sample through $audio_proc.dh_peq.process_op: each value is a low
+   and a high word, and the pointer moves two words each sample */
+static int32_t model_dh_sample(model_peq *m, int32_t in)
+{
+    int32_t *d = m->delayline;
+    unsigned p = m->delayline_addr;
+    kal_rmac rmac = kal_rmac_ashift(KAL_MAC(in, m->params[2]), m->params[1] - m->headroom_bits);
+    int32_t r1, r3, r4, r5, r7;
+    unsigned s;
+
+    r1 = d[p];
+    p = step(m, p, 1);
+    r3 = d[p];
+    p = step(m, p, 1);
+    r4 = kal_rmac_to_reg(rmac, 0);
+    r7 = (int32_t)kal_rmac_low(rmac);
+    for (s = 0; s < m->num_stages; s++)
+    {
+        rmac = KAL_MAC_SU(model_coeff(m, s, 0), r1);
+        r5 = d[p];
+        p = step(m, p, 2);
+        rmac += KAL_MAC_SU(model_coeff(m, s, 1), r5);
+        rmac += KAL_MAC_SU(model_coeff(m, s, 2), r7);
+        r1 = d[p];
+        p = step(m, p, 2);
+        rmac -= KAL_MAC_SU(model_coeff(m, s, 3), r1);
+        r5 = d[p];
+        p = step(m, p, -3);
+        rmac -= KAL_MAC_SU(model_coeff(m, s, 4), r5);
+        r5 = d[p];
+        p = step(m, p, 2);
+        rmac = kal_rmac_ashift(rmac, -32);
+        rmac += KAL_MAC(model_coeff(m, s, 0), r3);
+        r3 = d[p];
+        p = step(m, p, -1);
+        rmac += KAL_MAC(model_coeff(m, s, 1), r5);
+        d[p] = r7;
+        p = step(m, p, 1);
+        rmac += KAL_MAC(model_coeff(m, s, 2), r4);
+        d[p] = r4;
+        p = step(m, p, 2);
+        rmac -= KAL_MAC(model_coeff(m, s, 3), r3);
+        r5 = d[p];
+        p = step(m, p, -1);
+        rmac -= KAL_MAC(model_coeff(m, s, 4), r5);
+        rmac = kal_rmac_ashift(rmac, model_scale(m, s));
+        r4 = kal_rmac_to_reg(rmac, 0);
+        r7 = (int32_t)kal_rmac_low(rmac);
+    }
+    p = step(m, p, 2);
+    d[p] = r7;
+    p = step(m, p, 1);
+    d[p] = r4;
+    m->delayline_addr = step(m, p, 1);
+    return kal_rmac_store(kal_rmac_ashift(rmac, m->headroom_bits));
+}
+
+/* The process function of the core on one channel of interleaved samples */
+static void model_process(model_peq *m, const int32_t *input, int32_t *output, unsigned stride, unsigned samples)
+{
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        int32_t in = input[i * stride];
+
+        switch (m->core)
+        {
+            case AUDIO_PROC_HOST_HQ_PEQ:
+                output[i * stride] = model_hq_sample(m, in);
+                break;
+            case AUDIO_PROC_HOST_DH_PEQ:
+                output[i * stride] = model_dh_sample(m, in);
+                break;
+            default:
+                output[i * stride] = model_sh_sample(m, in);
+                break;
+        }
+    }
+}
+
+/* Parameters with random coefficients, which reach the saturation and
+   wrapping of each core, in the layout of the core */
+static void random_params(int32_t *params, audio_proc_host_peq_core core, unsigned num_stages,
+                          unsigned max_stages)
+{
+    unsigned s, i;
+
+    params[0] = (int32_t)(num_stages | ((uint32_t)random_word() & 0xFF00));
+    params[1] = (random_word() & 3) - 1;
+    params[2] = random_word() | 0x40000000;
+    for (s = 0; s < num_stages; s++)
+    {
+        int shift = (int)((uint32_t)random_word() % 8);
+        int32_t c[6];
+
+        for (i = 0; i < 5; i++)
+        {
+            c[i] = random_word() >> shift;
+        }
+        c[5] = (int)((uint32_t)random_word() % 5) - 1;
+        if (core == AUDIO_PROC_HOST_PEQ_LEGACY)
+        {
+            memcpy(&params[3 + 5 * s], c, 5 * sizeof(int32_t));
+            params[3 + 5 * max_stages + s] = c[5];
+        }
+        else
+        {
+            memcpy(&params[3 + 6 * s], c, 6 * sizeof(int32_t));
+        }
+    }
+}
+
+/* Peaking filters at spread out frequencies, quantised as the PEQ
+   coefficient generator does: each stage scaled down by the power of two
+   that brings its largest coefficient below 1.0 */
+static void peaking_params(int32_t *params, unsigned num_stages)
+{
+    unsigned s, i;
+
+    params[0] = (int32_t)num_stages;
+    params[1] = 0;
+    params[2] = 0x40000000;
+    for (s = 0; s < num_stages; s++)
+    {
+        double w = 2.0 * M_PI * 60.0 * pow(2.0, 1.2 * s) / 48000.0;
+        double a = pow(10.0, ((s & 1) ? -6.0 : 6.0) / 40.0);
+        double alpha = sin(w) / (2.0 * 1.4);
+        double a0 = 1.0 + alpha / a;
+        double c[5];
+        double largest = 0.0;
+        int scale = 0;
+
+        c[0] = (1.0 - alpha * a) / a0;
+        c[1] = -2.0 * cos(w) / a0;
+        c[2] = (1.0 + alpha * a) / a0;
+        c[3] = (1.0 - alpha / a) / a0;
+        c[4] = -2.0 * cos(w) / a0;
+        for (i = 0; i < 5; i++)
+        {
+            largest = fmax(largest, fabs(c[i]));
+        }
+        while (largest >= (double)(1 << scale))
+        {
+            scale++;
+        }
+        for (i = 0; i < 5; i++)
+        {
+            params[3 + 6 * s + i] = (int32_t)lrint(fmin(c[i] / (1 << scale) * 2147483648.0, 2147483647.0));
+        }
+        params[3 + 6 * s + 5] = scale;
+    }
+}
+
+/* Compare the library with the model for every core, number of stages and
+   channels, taking the samples in calls of random sizes */
+static int check_peq(void)
+{
+    static int32_t params[PARAMS_SIZE];
+    static int32_t input[MAX_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t ref[MAX_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t out[MAX_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static model_peq models[AUDIO_PROC_HOST_MAX_CHANNELS];
+    audio_proc_host_peq peq;
+    int failures = 0;
+    unsigned stages, channels, run, i, ch;
+    int core, simd;
+
+    for (core = AUDIO_PROC_HOST_PEQ_LEGACY; core <= AUDIO_PROC_HOST_DH_PEQ; core++)
+    {
+        for (stages = 1; stages <= AUDIO_PROC_HOST_PEQ_MAX_STAGES; stages++)
+        {
+            for (channels = 1; channels <= AUDIO_PROC_HOST_MAX_CHANNELS; channels++)
+            {
+                for (run = 0; run < PEQ_TEST_RUNS; run++)
+                {
+                    unsigned max_stages = AUDIO_PROC_HOST_PEQ_MAX_STAGES;
+                    int shift = (int)(run % 8) * 2;
+
+                    if (run & 1)
+                    {
+                        random_params(params, (audio_proc_host_peq_core)core, stages, max_stages);
+                    }
+                    else
+                    {
+                        peaking_params(params, stages);
+                        if (core == AUDIO_PROC_HOST_PEQ_LEGACY)
+                        {
+                            random_params(params, (audio_proc_host_peq_core)core, stages, max_stages);
+                        }
+                    }
+                    for (i = 0; i < MAX_TEST_SAMPLES * channels; i++)
+                    {
+                        input[i] = random_word() >> shift;
+                    }
+                    for (ch = 0; ch < channels; ch++)
+                    {
+                        model_init(&models[ch], (audio_proc_host_peq_core)core, params, max_stages);
+                        model_process(&models[ch], &input[ch], &ref[ch], channels, MAX_TEST_SAMPLES);
+                    }
+
+                    for (simd = 0; simd < 2; simd++)
+                    {
+                        unsigned done = 0;
+
+                        audio_proc_host_set_simd(simd);
+                        audio_proc_host_peq_init(&peq, (audio_proc_host_peq_core)core, channels);
+                        if (!audio_proc_host_peq_set_params(&peq, params, max_stages))
+                        {
+                            printf("FAIL: %s rejects %u stages\n", core_names[core], stages);
+                            failures++;
+                            break;
+                        }
+                        while (done < MAX_TEST_SAMPLES)
+                        {
+                            unsigned n = 1 + (uint32_t)random_word() % 150;
+
+                            if (n > MAX_TEST_SAMPLES - done)
+                            {
+                                n = MAX_TEST_SAMPLES - done;
+                            }
+                            audio_proc_host_peq_process(&peq, &input[done * channels], &out[done * channels], n);
+                            done += n;
+                        }
+                        if (memcmp(out, ref, MAX_TEST_SAMPLES * channels * sizeof(int32_t)))
+                        {
+                            printf("FAIL: %s %u stages %u channels %s differs from the model\n",
+                                   core_names[core], stages, channels, simd ? "simd" : "scalar");
+                            failures++;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    audio_proc_host_set_simd(1);
+    return failures;
+}
+
+/* Compare the crossover with two model PEQs and the APC sum and difference
+   of xover.asm */
+static int check_xover(void)
+{
+    static int32_t low_params[PARAMS_SIZE], high_params[PARAMS_SIZE];
+    static int32_t input[MAX_TEST_SAMPLES * 2];
+    static int32_t ref_low[MAX_TEST_SAMPLES * 2], ref_high[MAX_TEST_SAMPLES * 2];
+    static int32_t low[MAX_TEST_SAMPLES * 2], high[MAX_TEST_SAMPLES * 2];
+    audio_proc_host_xover xover;
+    model_peq model;
+    int failures = 0;
+    unsigned config, i, ch;
+    int core, apc;
+
+    for (core = AUDIO_PROC_HOST_SH_PEQ; core <= AUDIO_PROC_HOST_DH_PEQ; core++)
+    {
+        for (apc = 0; apc < 2; apc++)
+        {
+            for (config = 0; config < 8; config += 2)
+            {
+                int32_t r5 = INT32_MAX, r6 = INT32_MIN;
+
+                random_params(low_params, (audio_proc_host_peq_core)core, 2, 2);
+                random_params(high_params, (audio_proc_host_peq_core)core, 4, 4);
+                for (i = 0; i < MAX_TEST_SAMPLES * 2; i++)
+                {
+                    input[i] = random_word() >> 4;
+                }
+                for (ch = 0; ch < 2; ch++)
+                {
+                    model_init(&model, (audio_proc_host_peq_core)core, low_params, 0);
+                    model_process(&model, &input[ch], &ref_low[ch], 2, MAX_TEST_SAMPLES);
+                    model_init(&model, (audio_proc_host_peq_core)core, high_params, 0);
+                    model_process(&model, &input[ch], &ref_high[ch], 2, MAX_TEST_SAMPLES);
+                }
+                if (config & AUDIO_PROC_HOST_XOVER_INV_BAND1)
+                {
+                    r5 = r6;
+                }
+                if (!(config & AUDIO_PROC_HOST_XOVER_INV_BAND2))
+                {
+                    r6 = r5;
+                }
+                r5 = kal_frac_mult(r5, 0x40000000);
+                r6 = kal_frac_mult(r6, 0x40000000);
+                for (i = 0; apc && (i < MAX_TEST_SAMPLES * 2); i++)
+                {
+                    int32_t r0 = ref_high[i];
+                    int32_t r1 = ref_low[i];
+                    kal_rmac rmac = KAL_MAC(r0, r5);
+
+                    ref_high[i] = kal_rmac_store((kal_rmac)kal_frac_mult(r0, r6) * ((kal_rmac)1 << 32)
+                                                 + KAL_MAC(r1, r6));
+                    rmac = (kal_rmac)kal_frac_mult(r1, r5) * ((kal_rmac)1 << 32) - rmac;
+                    ref_low[i] = kal_rmac_store(rmac);
+                }
+
+                audio_proc_host_xover_init(&xover, (audio_proc_host_peq_core)core, 2, apc, config);
+                audio_proc_host_xover_set_params(&xover, low_params, high_params);
+                audio_proc_host_xover_process(&xover, input, low, high, MAX_TEST_SAMPLES / 2);
+                audio_proc_host_xover_process(&xover, &input[MAX_TEST_SAMPLES], &low[MAX_TEST_SAMPLES],
+                                              &high[MAX_TEST_SAMPLES], MAX_TEST_SAMPLES / 2);
+                if (memcmp(low, ref_low, sizeof(low)) || memcmp(high, ref_high, sizeof(high)))
+                {
+                    printf("FAIL: xover %s apc %d config %u differs from the model\n", core_names[core], apc,
+                           config);
+                    failures++;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/* Time one block size, in ns per sample of each channel. version 0 is the
+   model, 1 the library without SIMD, 2 with it. */
+static double time_peq(int version, audio_proc_host_peq_core core, unsigned stages, unsigned channels,
+                       unsigned block)
+{
+    static int32_t params[PARAMS_SIZE];
+    static int32_t buffer[BENCH_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static model_peq models[AUDIO_PROC_HOST_MAX_CHANNELS];
+    audio_proc_host_peq peq;
+    unsigned samples = 0;
+    unsigned i, start, ch;
+    clock_t begin;
+    double elapsed;
+
+    peaking_params(params, stages);
+    for (i = 0; i < BENCH_SAMPLES * channels; i++)
+    {
+        buffer[i] = random_word() >> 4;
+    }
+    for (ch = 0; ch < channels; ch++)
+    {
+        model_init(&models[ch], core, params, stages);
+    }
+    audio_proc_host_set_simd(version == 2);
+    audio_proc_host_peq_init(&peq, core, channels);
+    audio_proc_host_peq_set_params(&peq, params, stages);
+
+    begin = clock();
+    do
+    {
+        for (start = 0; start + block <= BENCH_SAMPLES; start += block)
+        {
+            int32_t *p = &buffer[start * channels];
+
+            if (version == 0)
+            {
+                for (ch = 0; ch < channels; ch++)
+                {
+                    model_process(&models[ch], &p[ch], &p[ch], channels, block);
+                }
+            }
+            else
+            {
+                audio_proc_host_peq_process(&peq, p, p, block);
+            }
+            samples += block;
+        }
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    return elapsed * 1e9 / samples / channels;
+}
+
+static int run_peq(void)
+{
+    static const unsigned stage_counts[] = {1, 5, 10};
+    static const unsigned channel_counts[] = {1, 2, 8};
+    static const unsigned block_sizes[] = {8, 64, 256};
+    int failures = check_peq();
+    int core;
+    unsigned s, c, b;
+
+    printf("peq: %s\n", failures ? "FAILED" : "library matches the model for 1 to 10 stages and 1 to 8 channels");
+    for (core = AUDIO_PROC_HOST_SH_PEQ; core <= AUDIO_PROC_HOST_DH_PEQ; core++)
+    {
+        printf("  %s, ns per sample per channel:\n", core_names[core]);
+        for (s = 0; s < sizeof(stage_counts) / sizeof(stage_counts[0]); s++)
+        {
+            for (c = 0; c < sizeof(channel_counts) / sizeof(channel_counts[0]); c++)
+            {
+                for (b = 0; b < sizeof(block_sizes) / sizeof(block_sizes[0]); b++)
+                {
+                    audio_proc_host_peq_core k = (audio_proc_host_peq_core)core;
+                    double model = time_peq(0, k, stage_counts[s], channel_counts[c], block_sizes[b]);
+                    double scalar = time_peq(1, k, stage_counts[s], channel_counts[c], block_sizes[b]);
+                    double simd = time_peq(2, k, stage_counts[s], channel_counts[c], block_sizes[b]);
+
+                    printf("    %2u stages %u ch block %3u: model %6.1f, scalar %6.1f (%.1fx), simd %6.1f (%.1fx)\n",
+                           stage_counts[s], channel_counts[c], block_sizes[b], model, scalar, model / scalar,
+                           simd, model / simd);
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+static int run_xover(void)
+{
+    int failures = check_xover();
+
+    printf("xover: %s\n", failures ? "FAILED" : "library matches the model for each core and band config");
+    return failures;
+}
+
+/* $iir_resamplerv2.iir_*: I2 walks the coefficients of each section, c0,
+   c1 to c(taps) and the scale, and I4 the history ring of L words. The
+   output of a section goes over the oldest tap of the next, read just
+   before. Returns rMAC, with r1 = rMAC as a word. */
+static kal_rmac model_iir(model_rs_stage *s, const int32_t *c, const unsigned *taps, unsigned length,
+                          kal_rmac rmac, int r6, int32_t *r1, unsigned *words)
+{
+    int32_t r2 = kal_rmac_to_reg(rmac, r6);
+    int32_t oldest = 0;
+    unsigned i2 = 0;
+    unsigned k, j;
+
+    for (k = 0; taps[k]; k++)
+    {
+        rmac = KAL_MAC(r2, c[i2++]);
+        for (j = 0; j < taps[k]; j++)
+        {
+            int32_t h = oldest;
+
+            if (k == 0 || j != 0)
+            {
+                h = s->iir[s->i4];
+                s->i4 = (s->i4 + 1) % length;
+            }
+            rmac -= KAL_MAC(h, c[i2++]);
+        }
+        rmac = kal_rmac_ashift(rmac, c[i2++]);
+        if (taps[k + 1])
+        {
+            oldest = s->iir[s->i4];
+            r2 = kal_rmac_store(rmac);
+            s->iir[s->i4] = r2;
+            s->i4 = (s->i4 + 1) % length;
+        }
+    }
+    *words = i2;
+    *r1 = kal_rmac_store(rmac);
+    return rmac;
+}
+
+/* $iir_resamplerv2.iir_*_diir: the history ring holds a low and a high word
+   for each tap. The low words are taken first, the coefficients as signed
+   and the words as unsigned, then the sum is shifted down a word and the
+   high words added. A section output goes over the oldest tap of the next
+   section, each word once it has been read. Returns rMAC, with r1 its high
+   word; the low word is written here. */
+static kal_rmac model_iir_dp(model_rs_stage *s, const int32_t *c, const unsigned *taps, unsigned length,
+                             kal_rmac rmac, int r6, int32_t *r1, unsigned *words)
+{
+    uint32_t x_low;
+    int32_t x_high;
+    unsigned i2 = 0;
+    unsigned k, j;
+
+    rmac = kal_rmac_ashift(rmac, r6);
+    x_low = kal_rmac_low(rmac);
+    x_high = kal_rmac_high(rmac);
+    for (k = 0; taps[k]; k++)
+    {
+        const int32_t *ck = &c[i2];
+        unsigned base = s->i4;
+
+        rmac = KAL_MAC_SU(ck[0], x_low);
+        for (j = 0; j < taps[k]; j++)
+        {
+            unsigned p = (base + 2 * j) % length;
+
+            rmac -= KAL_MAC_SU(ck[1 + j], (uint32_t)s->iir[p]);
+            if (k && !j)
+            {
+                s->iir[p] = (int32_t)x_low;
+            }
+        }
+        rmac = kal_rmac_ashift(rmac, -32);
+        rmac += KAL_MAC(x_high, ck[0]);
+        for (j = 0; j < taps[k]; j++)
+        {
+            unsigned p = (base + 2 * j + 1) % length;
+
+            rmac -= KAL_MAC(s->iir[p], ck[1 + j]);
+            if (k && !j)
+            {
+                s->iir[p] = x_high;
+            }
+        }
+        rmac = kal_rmac_ashift(rmac, ck[taps[k] + 1]);
+        x_low = kal_rmac_low(rmac);
+        x_high = kal_rmac_high(rmac);
+        s->i4 = (base + 2 * taps[k]) % length;
+        i2 += taps[k] + 2;
+    }
+    s->iir[s->i4] = (int32_t)x_low;
+    s->i4 = (s->i4 + 1) % length;
+    *words = i2;
+    *r1 = x_high;
+    return rmac;
+}
+
+static kal_rmac model_run_iir(const model_rs *m, model_rs_stage *s, const int32_t *c, int32_t function,
+                              unsigned iir_size, kal_rmac rmac, int r6, int32_t *r1, unsigned *words)
+{
+    if (m->dbl_precision)
+    {
+        return model_iir_dp(s, c, model_iir_taps[function], 2 * iir_size, rmac, r6, r1, words);
+    }
+    return model_iir(s, c, model_iir_taps[function], iir_size, rmac, r6, r1, words);
+}
+
+/* The FIR polyphase kernel: I7 steps by Rout through the first half of the
+   taps, is mirrored by M3, then steps back */
+static kal_rmac model_fir(model_rs_stage *s, const int32_t *fir, unsigned taps, unsigned rout, unsigned phase)
+{
+    unsigned i7 = phase;
+    kal_rmac rmac = 0;
+    unsigned t;
+
+    for (t = 0; t < taps; t++)
+    {
+        if (t == taps / 2)
+        {
+            i7 = taps * rout - 1 - i7;
+        }
+        rmac += KAL_MAC(fir[i7], s->fir[s->i0]);
+        s->i0 = (s->i0 + 1) % taps;
+        i7 = (t < taps / 2) ? i7 + rout : i7 - rout;
+    }
+    return rmac;
+}
+
+static int32_t model_fraction(unsigned r3, int32_t r5)
+{
+    int32_t r2 = (int32_t)(r3 * (uint32_t)r5);
+
+    if (r2 < 0)
+    {
+        r2 += INT32_MAX;
+    }
+    return r2;
+}
+
+/* $iir_1stStage_upsample and $iir_2ndStage_upsample on one channel. def is
+   I3, past the function pointer. Returns the outputs, with the words of the
+   definition the stage takes. */
+static unsigned model_upsample(const model_rs *m, model_rs_stage *s, const int32_t *def, const int *refs,
+                               int fir_only, int r2, int r5, const int32_t *input, unsigned in_stride,
+                               unsigned samples, int32_t *output, unsigned out_stride, unsigned *words)
+{
+    unsigned taps = fir_only ? 6 : AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE;
+    unsigned i3 = fir_only ? 2 : 1;
+    unsigned iir_size = fir_only ? 0 : (unsigned)def[1];
+    unsigned r4, r3, r7 = 0, i, iir_words = 0;
+    int r6 = 0, r8;
+    int32_t frac, function = 0, fraction;
+    const int32_t *fir;
+
+    if (!fir_only)
+    {
+        i3++;
+    }
+    r4 = (unsigned)def[i3++];
+    if (fir_only)
+    {
+        r8 = def[i3++] + r2;
+    }
+    else
+    {
+        r6 = def[i3++] + r2;
+        r8 = def[i3++] + r5;
+    }
+    fir = m->coefs->modules[refs[i3++]].words;
+    frac = def[i3++];
+    if (!fir_only)
+    {
+        i3++;
+        function = def[i3++];
+    }
+
+    r3 = s->counter;
+    fraction = model_fraction(r3, frac);
+    for (i = 0; i < samples; i++)
+    {
+        s->fir[s->i0] = input[i * in_stride];
+        s->i0 = (s->i0 + 1) % taps;
+        do
+        {
+            unsigned phase = (unsigned)kal_frac_mult(fraction, (int32_t)r4);
+            kal_rmac rmac = model_fir(s, fir, taps, r4, phase);
+
+            r3++;
+            if (fir_only)
+            {
+                output[r7 * out_stride] = kal_rmac_to_reg(rmac, r8);
+            }
+            else
+            {
+                int32_t r1;
+                unsigned length = m->dbl_precision ? 2 * iir_size : iir_size;
+
+                rmac = model_run_iir(m, s, &def[i3], function, iir_size, rmac, r6, &r1, &iir_words);
+                rmac = kal_rmac_ashift(rmac, r8);
+                s->iir[s->i4] = r1;
+                s->i4 = (s->i4 + 1) % length;
+                output[r7 * out_stride] = kal_rmac_store(rmac);
+            }
+            r7++;
+            if (r3 >= r4)
+            {
+                r3 = 0;
+            }
+            fraction = model_fraction(r3, frac);
+        } while (frac <= fraction);
+    }
+    s->counter = r3;
+    *words = i3 + iir_words;
+    return r7;
+}
+
+/* One input of $iir_2ndStage_downsample: the IIR, then the FIR history */
+static void model_downsample_input(const model_rs *m, model_rs_stage *s, const int32_t *c, int32_t function,
+                                   unsigned iir_size, int r6, int32_t x, unsigned *words)
+{
+    unsigned length = m->dbl_precision ? 2 * iir_size : iir_size;
+    kal_rmac rmac = (kal_rmac)x * ((kal_rmac)1 << 32);
+    int32_t r1;
+
+    rmac = model_run_iir(m, s, c, function, iir_size, rmac, r6, &r1, words);
+    s->fir[s->i0] = kal_rmac_store(rmac);
+    s->i0 = (s->i0 + 1) % AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE;
+    s->iir[s->i4] = r1;
+    s->i4 = (s->i4 + 1) % length;
+}
+
+/* $iir_2ndStage_downsample on one channel */
+static unsigned model_downsample(const model_rs *m, model_rs_stage *s, const int32_t *def, const int *refs,
+                                 int r2, int r5, const int32_t *input, unsigned in_stride, unsigned samples,
+                                 int32_t *output, unsigned out_stride, unsigned *words)
+{
+    unsigned iir_size = (unsigned)def[1];
+    unsigned r4 = (unsigned)def[2];
+    int r6 = def[3] + r2;
+    int r8 = def[4] + r5;
+    const int32_t *fir = m->coefs->modules[refs[5]].words;
+    int32_t frac = def[6];
+    int32_t int_ratio = def[7];
+    int32_t function = def[8];
+    const int32_t *c = &def[9];
+    unsigned r3 = s->counter, r7 = 0, in = 0, iir_words = 0;
+    int32_t fraction, need;
+    int r10;
+
+    if (r3 >= r4)
+    {
+        r3 = 0;
+    }
+    fraction = model_fraction(r3, frac);
+    need = int_ratio + (frac > fraction);
+    if (s->partial)
+    {
+        need = (int32_t)s->partial;
+    }
+    r10 = (int)samples - need;
+    while (r10 >= 0)
+    {
+        unsigned phase = (unsigned)kal_frac_mult(fraction, (int32_t)r4);
+        int32_t k;
+
+        for (k = 0; k < need; k++)
+        {
+            model_downsample_input(m, s, c, function, iir_size, r6, input[in++ * in_stride], &iir_words);
+        }
+        r3++;
+        output[r7++ * out_stride] = kal_rmac_to_reg(model_fir(s, fir, AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE,
+                                                              r4, phase), r8);
+        if (r3 >= r4)
+        {
+            r3 = 0;
+        }
+        fraction = model_fraction(r3, frac);
+        need = int_ratio + (frac > fraction);
+        r10 -= need;
+    }
+    s->partial = 0;
+    if (need + r10)
+    {
+        int32_t k;
+
+        for (k = 0; k < need + r10; k++)
+        {
+            model_downsample_input(m, s, c, function, iir_size, r6, input[in++ * in_stride], &iir_words);
+        }
+        s->partial = (unsigned)-r10;
+    }
+    s->counter = r3;
+    *words = 9 + iir_words;
+    return r7;
+}
+
+static unsigned model_stage(const model_rs *m, model_rs_stage *s, const int32_t *def, const int *refs,
+                            int32_t function, int r2, int r5, const int32_t *input, unsigned in_stride,
+                            unsigned samples, int32_t *output, unsigned out_stride, unsigned *words)
+{
+    if (function == AUDIO_PROC_HOST_IIR_RESAMPLER_DOWNSAMPLE)
+    {
+        return model_downsample(m, s, def, refs, r2, r5, input, in_stride, samples, output, out_stride, words);
+    }
+    return model_upsample(m, s, def, refs, function == AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE, r2, r5,
+                          input, in_stride, samples, output, out_stride, words);
+}
+
+static void model_rs_init(model_rs *m, const audio_proc_host_iir_resampler_coefs *coefs,
+                          const audio_proc_host_iir_resampler_module *filter, int input_scale, int output_scale,
+                          int dbl_precision)
+{
+    memset(m, 0, sizeof(*m));
+    m->coefs = coefs;
+    m->filter = filter;
+    m->input_scale = input_scale;
+    m->output_scale = output_scale;
+    m->dbl_precision = dbl_precision;
+}
+
+/* reset_iir_resampler: the pointers go back to the start of the history and
+   the IIR history is cleared */
+static void model_rs_reset(model_rs *m)
+{
+    unsigned i;
+
+    for (i = 0; i < 2; i++)
+    {
+        m->stages[i].partial = 0;
+        m->stages[i].counter = 0;
+        m->stages[i].i0 = 0;
+        m->stages[i].i4 = 0;
+        memset(m->stages[i].iir, 0, sizeof(m->stages[i].iir));
+    }
+}
+
+/* $iir_perform_resample on one channel: the first stage, if any, takes the
+   whole input into a temporary buffer for the second */
+static unsigned model_rs_process(model_rs *m, const int32_t *input, unsigned in_stride, unsigned samples,
+                                 int32_t *output, unsigned out_stride)
+{
+    static int32_t temp[RS_MAX_CALL * RS_MAX_RATIO];
+    const int32_t *w;
+    const int *refs;
+    unsigned i3 = 5;
+    unsigned words, i;
+    int r2 = m->input_scale;
+
+    if (m->filter == NULL)
+    {
+        for (i = 0; i < samples; i++)
+        {
+            kal_rmac rmac = (kal_rmac)input[i * in_stride] * ((kal_rmac)1 << 32);
+
+            output[i * out_stride] = kal_rmac_store(kal_rmac_ashift(rmac, m->input_scale + m->output_scale));
+        }
+        return samples;
+    }
+    w = m->filter->words;
+    refs = m->filter->refs;
+    if (w[4])
+    {
+        samples = model_stage(m, &m->stages[0], &w[i3], &refs[i3], w[4], r2, 0, input, in_stride, samples,
+                              temp, 1, &words);
+        i3 += words;
+        input = temp;
+        in_stride = 1;
+        r2 = 0;
+    }
+    return model_stage(m, &m->stages[1], &w[i3 + 1], &refs[i3 + 1], w[i3], r2, m->output_scale, input,
+                       in_stride, samples, output, out_stride, &words);
+}
+
+static int is_filter(const audio_proc_host_iir_resampler_module *module)
+{
+    return strncmp(module->name, "Up_", 3) == 0;
+}
+
+/* Run one filter through the library and the model, for channels, scales
+   and input level, in calls of random sizes with a reset part way.
+   Returns non-zero on a mismatch. */
+static int check_filter(const audio_proc_host_iir_resampler_coefs *coefs,
+                        const audio_proc_host_iir_resampler_module *filter, unsigned channels, int dbl_precision,
+                        int input_scale, int output_scale, int shift)
+{
+    static int32_t input[RS_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t ref[RS_TEST_SAMPLES * RS_MAX_RATIO * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t out[RS_TEST_SAMPLES * RS_MAX_RATIO * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static unsigned calls[RS_TEST_SAMPLES];
+    static model_rs models[AUDIO_PROC_HOST_MAX_CHANNELS];
+    static audio_proc_host_iir_resampler rs;
+    unsigned num_calls = 0, reset_call, done, ref_produced = 0;
+    unsigned i, ch;
+    int simd;
+
+    for (i = 0; i < RS_TEST_SAMPLES * channels; i++)
+    {
+        input[i] = random_word() >> shift;
+    }
+    for (done = 0; done < RS_TEST_SAMPLES; done += calls[num_calls++])
+    {
+        calls[num_calls] = 1 + (uint32_t)random_word() % RS_MAX_CALL;
+        if (calls[num_calls] > RS_TEST_SAMPLES - done)
+        {
+            calls[num_calls] = RS_TEST_SAMPLES - done;
+        }
+    }
+    reset_call = num_calls / 2;
+
+    for (ch = 0; ch < channels; ch++)
+    {
+        model_rs_init(&models[ch], coefs, filter, input_scale, output_scale, dbl_precision);
+    }
+    for (i = 0, done = 0; i < num_calls; done += calls[i++])
+    {
+        unsigned produced = 0;
+
+        for (ch = 0; ch < channels; ch++)
+        {
+            if (i == reset_call)
+            {
+                model_rs_reset(&models[ch]);
+            }
+            produced = model_rs_process(&models[ch], &input[done * channels + ch], channels, calls[i],
+                                        &ref[ref_produced * channels + ch], channels);
+        }
+        ref_produced += produced;
+    }
+
+    for (simd = 0; simd < 2; simd++)
+    {
+        unsigned produced = 0;
+
+        audio_proc_host_set_simd(simd);
+        if (!audio_proc_host_iir_resampler_init(&rs, coefs, filter, channels, input_scale, output_scale,
+                                                dbl_precision))
+        {
+            printf("FAIL: %s is rejected\n", filter->name);
+            return 1;
+        }
+        for (i = 0, done = 0; i < num_calls; done += calls[i++])
+        {
+            unsigned max = audio_proc_host_iir_resampler_max_output(&rs, calls[i]);
+            unsigned n;
+
+            if (i == reset_call)
+            {
+                audio_proc_host_iir_resampler_reset(&rs);
+            }
+            n = audio_proc_host_iir_resampler_process(&rs, &input[done * channels], &out[produced * channels],
+                                                      calls[i]);
+            if (n > max)
+            {
+                printf("FAIL: %s gives %u samples from %u, more than %u\n", filter->name, n, calls[i], max);
+                return 1;
+            }
+            produced += n;
+        }
+        if (produced != ref_produced || memcmp(out, ref, produced * channels * sizeof(int32_t)))
+        {
+            printf("FAIL: %s %u channels %s %s, scales %d %d, differs from the model\n", filter->name, channels,
+                   dbl_precision ? "double" : "single", simd ? "simd" : "scalar", input_scale, output_scale);
+            return 1;
+        }
+    }
+    audio_proc_host_set_simd(1);
+    return 0;
+}
+
+/* Copy the modules, with every FIR table filled with random words, so the
+   sums saturate and the SIMD loops fall back to the scalar code */
+static void random_fir_coefs(audio_proc_host_iir_resampler_coefs *copy,
+                             const audio_proc_host_iir_resampler_coefs *coefs)
+{
+    unsigned i, w;
+
+    copy->num_modules = coefs->num_modules;
+    copy->modules = malloc(coefs->num_modules * sizeof(copy->modules[0]));
+    for (i = 0; i < coefs->num_modules; i++)
+    {
+        copy->modules[i] = coefs->modules[i];
+        if (strncmp(coefs->modules[i].name, "fir_", 4) == 0)
+        {
+            copy->modules[i].words = malloc(coefs->modules[i].num_words * sizeof(int32_t));
+            for (w = 0; w < coefs->modules[i].num_words; w++)
+            {
+                copy->modules[i].words[w] = random_word();
+            }
+        }
+    }
+}
+
+static void free_random_fir_coefs(audio_proc_host_iir_resampler_coefs *copy)
+{
+    unsigned i;
+
+    for (i = 0; i < copy->num_modules; i++)
+    {
+        if (strncmp(copy->modules[i].name, "fir_", 4) == 0)
+        {
+            free(copy->modules[i].words);
+        }
+    }
+    free(copy->modules);
+}
+
+/* Compare the library with the model for every filter of the modules,
+   single and double precision and 1 to 8 channels, at the scales of the
+   capability, and loud at other scales */
+static int check_resampler(const audio_proc_host_iir_resampler_coefs *coefs, unsigned *num_filters)
+{
+    static const int scales[][3] =
+    {
+        {-AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE, AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE, 4},
+        {0, 0, 0},
+        {-2, 6, 0}
+    };
+    audio_proc_host_iir_resampler_coefs random_coefs;
+    int failures = 0;
+    unsigned i, s, channels;
+    int dbl;
+
+    *num_filters = 0;
+    failures += check_filter(coefs, NULL, 3, 0, -AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE,
+                             AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE + 2, 0);
+    random_fir_coefs(&random_coefs, coefs);
+    for (i = 0; i < coefs->num_modules; i++)
+    {
+        const audio_proc_host_iir_resampler_module *filter = &coefs->modules[i];
+
+        if (!is_filter(filter))
+        {
+            continue;
+        }
+        (*num_filters)++;
+        for (dbl = 0; dbl < 2; dbl++)
+        {
+            for (channels = 1; channels <= AUDIO_PROC_HOST_MAX_CHANNELS; channels++)
+            {
+                for (s = 0; s < sizeof(scales) / sizeof(scales[0]); s++)
+                {
+                    failures += check_filter(coefs, filter, channels, dbl, scales[s][0], scales[s][1],
+                                             scales[s][2]);
+                }
+            }
+            failures += check_filter(&random_coefs, &random_coefs.modules[i], 2 + dbl * 3, dbl,
+                                     -AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE,
+                                     AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE, 0);
+        }
+    }
+    free_random_fir_coefs(&random_coefs);
+    return failures;
+}
+
+/* DSP cycles per output sample of each channel, from the MIPS of the stage
+   functions of iir_resamplev2_common.asm, single precision */
+static double dsp_cycles(const audio_proc_host_iir_resampler *rs)
+{
+    double in = 1.0, cycles = 0.0;
+    unsigned i;
+
+    for (i = 0; i < rs->num_stages; i++)
+    {
+        const audio_proc_host_iir_resampler_stage *st = &rs->stages[i];
+        double out = in * 2147483648.0 / ((double)st->int_ratio * 2147483648.0 + st->frac_ratio);
+
+        switch (st->function)
+        {
+            case AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE:
+                cycles += 2 * in + 19 * out;
+                break;
+            case AUDIO_PROC_HOST_IIR_RESAMPLER_UPSAMPLE:
+                cycles += 2 * in + (31 + st->iir_order) * out;
+                break;
+            default:
+                cycles += (10 + st->iir_order) * in + 27 * out;
+                break;
+        }
+        in = out;
+    }
+    return cycles / in;
+}
+
+/* Time one filter, in ns per output sample of each channel. version 0 is
+   the model, 1 the library without SIMD, 2 with it. */
+static double time_resampler(int version, const audio_proc_host_iir_resampler_coefs *coefs,
+                             const audio_proc_host_iir_resampler_module *filter, unsigned channels)
+{
+    static int32_t input[RS_MAX_CALL * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t output[RS_MAX_CALL * RS_MAX_RATIO * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static model_rs models[AUDIO_PROC_HOST_MAX_CHANNELS];
+    static audio_proc_host_iir_resampler rs;
+    double produced = 0;
+    unsigned i, ch;
+    clock_t begin;
+    double elapsed;
+
+    for (i = 0; i < RS_MAX_CALL * channels; i++)
+    {
+        input[i] = random_word() >> 4;
+    }
+    for (ch = 0; ch < channels; ch++)
+    {
+        model_rs_init(&models[ch], coefs, filter, -AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE,
+                      AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE, 0);
+    }
+    audio_proc_host_set_simd(version == 2);
+    audio_proc_host_iir_resampler_init(&rs, coefs, filter, channels, -AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE,
+                                       AUDIO_PROC_HOST_IIR_RESAMPLER_IO_SCALE, 0);
+
+    begin = clock();
+    do
+    {
+        unsigned n = 0;
+
+        if (version == 0)
+        {
+            for (ch = 0; ch < channels; ch++)
+            {
+                n = model_rs_process(&models[ch], &input[ch], channels, RS_MAX_CALL, &output[ch], channels);
+            }
+        }
+        else
+        {
+            n = audio_proc_host_iir_resampler_process(&rs, input, output, RS_MAX_CALL);
+        }
+        produced += n;
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    return elapsed * 1e9 / produced / channels;
+}
+
+static int run_resampler(const char *path)
+{
+    static const unsigned channel_counts[] = {2, 8};
+    audio_proc_host_iir_resampler_coefs coefs;
+    static audio_proc_host_iir_resampler rs;
+    unsigned num_filters, r, c;
+    int failures, low_mips;
+
+    if (!audio_proc_host_iir_resampler_load_coefs(&coefs, path))
+    {
+        printf("iir_resampler: FAILED to read %s\n", path);
+        return 1;
+    }
+    failures = check_resampler(&coefs, &num_filters);
+    if (failures)
+    {
+        printf("iir_resampler: FAILED\n");
+    }
+    else
+    {
+        printf("iir_resampler: library matches the model for the %u filters of %s, single and double "
+               "precision, 1 to 8 channels\n", num_filters, path);
+    }
+
+    printf("  ns per output sample per channel, and DSP cycles from the MIPS of the stage functions:\n");
+    for (r = 0; r < sizeof(bench_rates) / sizeof(bench_rates[0]); r++)
+    {
+        const audio_proc_host_iir_resampler_module *standard =
+            audio_proc_host_iir_resampler_find_rate(&coefs, bench_rates[r].in_rate, bench_rates[r].out_rate, 0);
+
+        for (low_mips = 0; low_mips < 2; low_mips++)
+        {
+            const audio_proc_host_iir_resampler_module *filter =
+                audio_proc_host_iir_resampler_find_rate(&coefs, bench_rates[r].in_rate, bench_rates[r].out_rate,
+                                                        low_mips);
+
+            if (filter == NULL || (low_mips && filter == standard))
+            {
+                continue;
+            }
+            audio_proc_host_iir_resampler_init(&rs, &coefs, filter, 1, 0, 0, 0);
+            for (c = 0; c < sizeof(channel_counts) / sizeof(channel_counts[0]); c++)
+            {
+                double model = time_resampler(0, &coefs, filter, channel_counts[c]);
+                double scalar = time_resampler(1, &coefs, filter, channel_counts[c]);
+                double simd = time_resampler(2, &coefs, filter, channel_counts[c]);
+
+                printf("    %5u -> %5u %-26s %u ch: model %6.1f, scalar %6.1f (%.1fx), simd %6.1f (%.1fx); "
+                       "DSP %5.1f\n", bench_rates[r].in_rate, bench_rates[r].out_rate, filter->name,
+                       channel_counts[c], model, scalar, model / scalar, simd, model / simd, dsp_cycles(&rs));
+            }
+        }
+    }
+    audio_proc_host_iir_resampler_free_coefs(&coefs);
+    return failures;
+}
+
+/* Noise whose level steps between loud and quiet every 300 samples */
+static void compander_noise(int32_t *input, unsigned channels, unsigned samples)
+{
+    unsigned i;
+
+    for (i = 0; i < samples * channels; i++)
+    {
+        input[i] = random_word() >> (((i / channels / 300) % 2) ? 9 : 1);
+    }
+}
+
+/* Tone bursts: -6 and -36 dBFS in turn, a different tone on each channel */
+static void compander_bursts(int32_t *input, unsigned channels, unsigned samples)
+{
+    unsigned i, ch;
+
+    for (i = 0; i < samples; i++)
+    {
+        double level = ((i / CMPD_BURST_SAMPLES) % 2) ? 0.0158 : 0.5;
+
+        for (ch = 0; ch < channels; ch++)
+        {
+            double freq = 1000.0 + 150.0 * ch;
+
+            input[i * channels + ch] = (int32_t)(level * 2147483647.0 * sin(2 * M_PI * freq * i / CMPD_RATE));
+        }
+    }
+}
+
+/* Compand with calls of random size, each taking the samples the last one
+   left. Returns the samples processed. */
+static unsigned compand_in_calls(audio_proc_host_compander *cmpd, const int32_t *input, int32_t *output,
+                                 unsigned samples)
+{
+    unsigned stride = cmpd->num_channels;
+    unsigned done = 0, end = 0;
+
+    while (end < samples)
+    {
+        end += 1 + (uint32_t)random_word() % CMPD_MAX_CALL;
+        if (end > samples)
+        {
+            end = samples;
+        }
+        done += audio_proc_host_compander_process(cmpd, &input[done * stride], &output[done * stride], end - done);
+    }
+    return done;
+}
+
+static int check_compander(void)
+{
+    static int32_t input[CMPD_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t whole[CMPD_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t calls[CMPD_TEST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t hist_whole[CMPD_MAX_LOOKAHEAD], hist_calls[CMPD_MAX_LOOKAHEAD];
+    static audio_proc_host_compander a, b;
+    static const char *mode_names[] = {"dsp per sample", "dsp 0.5 ms", "block"};
+    int failures = 0;
+    unsigned channels, mode, variant;
+
+    for (channels = 1; channels <= AUDIO_PROC_HOST_MAX_CHANNELS; channels++)
+    {
+        compander_noise(input, channels, CMPD_TEST_SAMPLES);
+        for (mode = 0; mode < 3; mode++)
+        {
+            /* peak or average detector, interpolation, 2 ms look-ahead */
+            for (variant = 0; variant < 8; variant++)
+            {
+                audio_proc_host_compander_params params = default_compander_params;
+                unsigned n_whole, n_calls;
+
+                params.level_estimation_flag = (variant & 1);
+                params.gain_interp_flag = (variant >> 1) & 1;
+                params.lookahead_time = (variant & 4) ? (int32_t)(0.002 * 2147483648.0) : 0;
+                params.gain_update_flag = (mode != 0);
+
+                /* The block mode with SIMD in calls against one scalar call,
+                   the DSP modes in calls against one call */
+                audio_proc_host_set_simd(mode != 2);
+                audio_proc_host_compander_init(&a, &params, channels, CMPD_RATE, mode == 2, hist_whole,
+                                               CMPD_MAX_LOOKAHEAD);
+                n_whole = audio_proc_host_compander_process(&a, input, whole, CMPD_TEST_SAMPLES);
+                audio_proc_host_set_simd(1);
+                audio_proc_host_compander_init(&b, &params, channels, CMPD_RATE, mode == 2, hist_calls,
+                                               CMPD_MAX_LOOKAHEAD);
+                n_calls = compand_in_calls(&b, input, calls, CMPD_TEST_SAMPLES);
+
+                if (n_whole != n_calls || memcmp(whole, calls, n_whole * channels * sizeof(int32_t)) != 0 ||
+                    a.gain_smooth_hist != b.gain_smooth_hist)
+                {
+                    printf("FAIL: compander %s, %u ch, variant %u\n", mode_names[mode], channels, variant);
+                    failures++;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/* Output error of a mode against the reference: the signal to error ratio
+   in dB, and the largest gain difference in dB over CMPD_WINDOW samples */
+static void compander_error(const int32_t *ref, const int32_t *out, unsigned count, double *snr, double *max_gain)
+{
+    double signal = 0, error = 0;
+    unsigned start, i;
+
+    *max_gain = 0;
+    for (start = 0; start + CMPD_WINDOW <= count; start += CMPD_WINDOW)
+    {
+        double ref_power = 0, out_power = 0;
+
+        for (i = start; i < start + CMPD_WINDOW; i++)
+        {
+            double r = ref[i], o = out[i];
+
+            ref_power += r * r;
+            out_power += o * o;
+            error += (o - r) * (o - r);
+        }
+        signal += ref_power;
+        if (ref_power > 0 && out_power > 0 && fabs(10 * log10(out_power / ref_power)) > *max_gain)
+        {
+            *max_gain = fabs(10 * log10(out_power / ref_power));
+        }
+    }
+    *snr = (error > 0) ? 10 * log10(signal / error) : 999.0;
+}
+
+/* Set up a compander for a mode: 0 is the DSP updating the gain every
+   sample, 1 every 0.5 ms, 2 the block mode without SIMD and 3 with it */
+static void compander_mode(audio_proc_host_compander *cmpd, unsigned mode,
+                           const audio_proc_host_compander_params *base, unsigned channels)
+{
+    static int32_t hist[CMPD_MAX_LOOKAHEAD];
+    audio_proc_host_compander_params params = *base;
+
+    params.gain_update_flag = (mode != 0);
+    audio_proc_host_set_simd(mode == 3);
+    audio_proc_host_compander_init(cmpd, &params, channels, CMPD_RATE, mode >= 2, hist, CMPD_MAX_LOOKAHEAD);
+}
+
+/* Time a mode, in ns per sample per channel */
+static double time_compander(unsigned mode, const audio_proc_host_compander_params *params, const int32_t *input,
+                             int32_t *output, unsigned channels, unsigned samples)
+{
+    static audio_proc_host_compander cmpd;
+    double done = 0;
+    clock_t begin;
+    double elapsed;
+
+    compander_mode(&cmpd, mode, params, channels);
+    begin = clock();
+    do
+    {
+        done += audio_proc_host_compander_process(&cmpd, input, output, samples);
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    return elapsed * 1e9 / done / channels;
+}
+
+static int run_compander(void)
+{
+    static const char *mode_names[] = {"dsp per sample", "dsp 0.5 ms", "block scalar", "block simd"};
+    static const unsigned channel_counts[] = {2, 8};
+    static int32_t input[4 * CMPD_BURST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t ref[4 * CMPD_BURST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static int32_t output[4 * CMPD_BURST_SAMPLES * AUDIO_PROC_HOST_MAX_CHANNELS];
+    static audio_proc_host_compander cmpd;
+    unsigned samples = 4 * CMPD_BURST_SAMPLES;
+    int failures = check_compander();
+    unsigned peak, mode, c;
+
+    if (failures)
+    {
+        printf("compander: FAILED\n");
+    }
+    else
+    {
+        printf("compander: block mode matches it without SIMD, and calls of any size match one call, "
+               "for each mode, 1 to 8 channels\n");
+    }
+
+    printf("  -6/-36 dBFS tone bursts at %u Hz, each mode against the DSP's per-sample gain, "
+           "and ns per sample per channel:\n", CMPD_RATE);
+    for (peak = 0; peak < 2; peak++)
+    {
+        audio_proc_host_compander_params params = default_compander_params;
+
+        params.level_estimation_flag = 1 - peak;
+        compander_bursts(input, 2, samples);
+        compander_mode(&cmpd, 0, &params, 2);
+        audio_proc_host_compander_process(&cmpd, input, ref, samples);
+        for (mode = 0; mode < 4; mode++)
+        {
+            double snr, max_gain;
+
+            printf("    %-7s %-14s:", peak ? "average" : "peak", mode_names[mode]);
+            for (c = 0; c < sizeof(channel_counts) / sizeof(channel_counts[0]); c++)
+            {
+                compander_bursts(input, channel_counts[c], samples);
+                printf(" %u ch %6.1f ns", channel_counts[c],
+                       time_compander(mode, &params, input, output, channel_counts[c], samples));
+            }
+            if (mode > 0)
+            {
+                compander_bursts(input, 2, samples);
+                compander_mode(&cmpd, mode, &params, 2);
+                audio_proc_host_compander_process(&cmpd, input, output, samples);
+                compander_error(ref, output, 2 * samples, &snr, &max_gain);
+                printf("; SNR %5.1f dB, gain within %.2f dB", snr, max_gain);
+            }
+            printf("\n");
+        }
+    }
+    audio_proc_host_set_simd(1);
+    return failures;
+}
+
+/* A gain for a route: mostly zero or unity, as real mixes are, some
+   random, and some at the extremes */
+static int32_t random_mix_gain(int exponent)
+{
+    unsigned pick = (uint32_t)random_word() % 10;
+
+    if (pick < 4)
+    {
+        return 0;
+    }
+    if (pick < 7 && exponent >= 1 && exponent <= 30)
+    {
+        return (int32_t)1 << (31 - exponent);
+    }
+    if (pick == 9)
+    {
+        return (random_word() & 1) ? INT32_MIN : INT32_MAX;
+    }
+    return random_word() >> ((uint32_t)random_word() % 4);
+}
+
+/* An exponent: mostly 0 to 3, sometimes anywhere in range */
+static int random_mix_exponent(void)
+{
+    if ((uint32_t)random_word() % 8 == 0)
+    {
+        return AUDIO_PROC_HOST_MIXER_MIN_EXPONENT +
+               (int)((uint32_t)random_word() % (AUDIO_PROC_HOST_MIXER_MAX_EXPONENT -
+                                                AUDIO_PROC_HOST_MIXER_MIN_EXPONENT + 1));
+    }
+    return (int)((uint32_t)random_word() % 4);
+}
+
+/* Change the same random gains, exponents and ramp length of two mixers */
+static void random_mix_change(audio_proc_host_mixer *a, audio_proc_host_mixer *b, unsigned changes)
+{
+    unsigned c;
+
+    if (random_word() & 1)
+    {
+        unsigned ramp = (uint32_t)random_word() % MIX_MAX_RAMP;
+
+        audio_proc_host_mixer_set_ramp(a, ramp);
+        audio_proc_host_mixer_set_ramp(b, ramp);
+    }
+    for (c = 0; c < changes; c++)
+    {
+        unsigned j = (uint32_t)random_word() % a->num_outputs;
+        unsigned i = (uint32_t)random_word() % a->num_inputs;
+        int32_t gain;
+
+        if ((uint32_t)random_word() % 8 == 0)
+        {
+            int exponent = random_mix_exponent();
+
+            audio_proc_host_mixer_set_exponent(a, j, exponent);
+            audio_proc_host_mixer_set_exponent(b, j, exponent);
+        }
+        gain = random_mix_gain(a->exponent[j]);
+        audio_proc_host_mixer_set_gain(a, j, i, gain);
+        audio_proc_host_mixer_set_gain(b, j, i, gain);
+    }
+}
+
+static int check_mixer(void)
+{
+    static int32_t input[AUDIO_PROC_HOST_MIXER_MAX_INPUTS][MAX_TEST_SAMPLES];
+    static int32_t dense[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS][MAX_TEST_SAMPLES];
+    static int32_t sparse[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS][MAX_TEST_SAMPLES];
+    static audio_proc_host_mixer a, b;
+    int failures = 0;
+    unsigned run, i, j, n;
+
+    for (run = 0; run < MIX_TEST_RUNS; run++)
+    {
+        unsigned num_inputs = 1 + (uint32_t)random_word() % AUDIO_PROC_HOST_MIXER_MAX_INPUTS;
+        unsigned num_outputs = 1 + (uint32_t)random_word() % AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS;
+        unsigned end = 0, done = 0;
+
+        for (i = 0; i < num_inputs; i++)
+        {
+            for (n = 0; n < MAX_TEST_SAMPLES; n++)
+            {
+                input[i][n] = ((uint32_t)random_word() % 16 == 0)
+                              ? ((random_word() & 1) ? INT32_MIN : INT32_MAX)
+                              : random_word() >> ((uint32_t)random_word() % 3);
+            }
+        }
+        audio_proc_host_mixer_init(&a, num_inputs, num_outputs, 0);
+        audio_proc_host_mixer_init(&b, num_inputs, num_outputs, 1);
+        random_mix_change(&a, &b, num_inputs * num_outputs);
+        if (run % 4 == 2)
+        {
+            /* routing only: one unity gain for each output */
+            for (j = 0; j < num_outputs; j++)
+            {
+                unsigned route = (uint32_t)random_word() % num_inputs;
+
+                audio_proc_host_mixer_set_exponent(&a, j, 1);
+                audio_proc_host_mixer_set_exponent(&b, j, 1);
+                for (i = 0; i < num_inputs; i++)
+                {
+                    audio_proc_host_mixer_set_gain(&a, j, i, (i == route) ? MIX_UNITY : 0);
+                    audio_proc_host_mixer_set_gain(&b, j, i, (i == route) ? MIX_UNITY : 0);
+                }
+            }
+        }
+        audio_proc_host_set_simd(run & 1);
+
+        while (end < MAX_TEST_SAMPLES)
+        {
+            const int32_t *in[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+            int32_t *out_a[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS], *out_b[AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS];
+
+            end += 1 + (uint32_t)random_word() % MIX_MAX_CALL;
+            if (end > MAX_TEST_SAMPLES)
+            {
+                end = MAX_TEST_SAMPLES;
+            }
+            for (i = 0; i < num_inputs; i++)
+            {
+                in[i] = &input[i][done];
+            }
+            for (j = 0; j < num_outputs; j++)
+            {
+                out_a[j] = &dense[j][done];
+                out_b[j] = &sparse[j][done];
+            }
+            audio_proc_host_mixer_process(&a, in, out_a, end - done);
+            audio_proc_host_mixer_process(&b, in, out_b, end - done);
+            done = end;
+            if ((uint32_t)random_word() % 3 == 0)
+            {
+                random_mix_change(&a, &b, 1 + (uint32_t)random_word() % 3);
+            }
+        }
+
+        for (j = 0; j < num_outputs; j++)
+        {
+            if (memcmp(dense[j], sparse[j], sizeof(dense[j])) != 0 ||
+                memcmp(a.current_gain[j], b.current_gain[j], sizeof(a.current_gain[j])) != 0)
+            {
+                printf("FAIL: mixer run %u, %u -> %u, output %u, simd %u\n", run, num_inputs, num_outputs, j, run & 1);
+                failures++;
+                break;
+            }
+        }
+    }
+    audio_proc_host_set_simd(1);
+    return failures;
+}
+
+/* Time a mixer version on a mix, in ns per sample of all the outputs:
+   0 dense, 1 sparse, 2 sparse with SIMD. With ramp set, the ramping route
+   moves between its gain and half of it through every call. */
+static double time_mixer(unsigned version, const mix_case *mix, int ramp, int32_t *const *outputs)
+{
+    static int32_t input[AUDIO_PROC_HOST_MIXER_MAX_INPUTS][BENCH_SAMPLES];
+    static audio_proc_host_mixer mixer;
+    const int32_t *in[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+    int32_t ramp_gain = mix->gains[mix->ramp_output][mix->ramp_input];
+    unsigned i, j, calls = 0;
+    clock_t begin;
+    double elapsed;
+
+    for (i = 0; i < mix->num_inputs; i++)
+    {
+        for (j = 0; j < BENCH_SAMPLES; j++)
+        {
+            input[i][j] = random_word() >> 2;
+        }
+        in[i] = input[i];
+    }
+    audio_proc_host_mixer_init(&mixer, mix->num_inputs, mix->num_outputs, version > 0);
+    audio_proc_host_set_simd(version == 2);
+    for (j = 0; j < mix->num_outputs; j++)
+    {
+        audio_proc_host_mixer_set_exponent(&mixer, j, 1);
+        for (i = 0; i < mix->num_inputs; i++)
+        {
+            audio_proc_host_mixer_set_gain(&mixer, j, i, mix->gains[j][i]);
+        }
+    }
+    audio_proc_host_mixer_set_ramp(&mixer, BENCH_SAMPLES);
+
+    begin = clock();
+    do
+    {
+        if (ramp)
+        {
+            audio_proc_host_mixer_set_gain(&mixer, mix->ramp_output, mix->ramp_input,
+                                           (calls & 1) ? ramp_gain : ramp_gain / 2);
+        }
+        audio_proc_host_mixer_process(&mixer, in, outputs, BENCH_SAMPLES);
+        calls++;
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    return elapsed * 1e9 / ((double)calls * BENCH_SAMPLES * mix->num_outputs);
+}
+
+static int run_mixer(void)
+{
+    static int32_t output[2][BENCH_SAMPLES];
+    int32_t *outputs[2] = {output[0], output[1]};
+    int failures = check_mixer();
+    unsigned m;
+    int ramp;
+
+    if (failures)
+    {
+        printf("mixer: FAILED\n");
+    }
+    else
+    {
+        printf("mixer: sparse matches dense, with SIMD and without, for 1 to %u inputs and outputs with random "
+               "gains and ramps\n", AUDIO_PROC_HOST_MIXER_MAX_INPUTS);
+    }
+
+    printf("  ns per output sample, blocks of %u samples:\n", BENCH_SAMPLES);
+    for (m = 0; m < sizeof(mix_cases) / sizeof(mix_cases[0]); m++)
+    {
+        for (ramp = 0; ramp < 2; ramp++)
+        {
+            double dense = time_mixer(0, &mix_cases[m], ramp, outputs);
+            double scalar = time_mixer(1, &mix_cases[m], ramp, outputs);
+            double simd = time_mixer(2, &mix_cases[m], ramp, outputs);
+
+            printf("    %-12s %-7s: dense %6.2f, sparse %6.2f (x%5.1f), sparse simd %6.2f (x%5.1f)\n",
+                   mix_cases[m].name, ramp ? "ramping" : "fixed", dense, scalar, dense / scalar, simd, dense / simd);
+        }
+    }
+    return failures;
+}
+
+static int check_peak_monitor(void)
+{
+    static int32_t input[PEAK_MAX_CALL];
+    audio_proc_host_peak_monitor scalar, simd;
+    int failures = 0;
+    unsigned run, i;
+
+    for (run = 0; run < PEAK_TEST_RUNS; run++)
+    {
+        int32_t model_peak = 0;
+        double sum = 0.0;
+        unsigned total = 0, call;
+
+        audio_proc_host_peak_monitor_reset(&scalar);
+        audio_proc_host_peak_monitor_reset(&simd);
+        for (call = 0; call < 8; call++)
+        {
+            unsigned samples = (uint32_t)random_word() % PEAK_MAX_CALL;
+            int shift = (int)((uint32_t)random_word() % 24);
+
+            for (i = 0; i < samples; i++)
+            {
+                input[i] = random_word() >> shift;
+                if (((uint32_t)random_word() & 0xFFF) == 0)
+                {
+                    input[i] = INT32_MIN;
+                }
+                /* r4 = ABS r4; r3 = MAX r4 */
+                model_peak = (kal_abs32(input[i]) > model_peak) ? kal_abs32(input[i]) : model_peak;
+                sum += ((double)input[i] / 2147483648.0) * ((double)input[i] / 2147483648.0);
+            }
+            total += samples;
+
+            audio_proc_host_set_simd(0);
+            audio_proc_host_peak_monitor_process(&scalar, input, samples);
+            audio_proc_host_set_simd(1);
+            audio_proc_host_peak_monitor_process(&simd, input, samples);
+        }
+
+        if ((scalar.peak_level != model_peak) || (simd.peak_level != model_peak)
+            || (scalar.sum_squares != simd.sum_squares)
+            || (audio_proc_host_peak_monitor_rms(&scalar) != audio_proc_host_peak_monitor_rms(&simd)))
+        {
+            printf("FAIL: peak monitor run %u: peak %d, simd %d, model %d\n", run, scalar.peak_level,
+                   simd.peak_level, model_peak);
+            failures++;
+        }
+        if (total > 0)
+        {
+            /* each square and the mean lose under 2^-31 to truncation, so
+               the mean square is low by under 2^32 in units of 2^-62 */
+            double rms = sqrt(sum / total) * 2147483648.0;
+            double level = audio_proc_host_peak_monitor_rms(&simd);
+            double error = rms * rms - (level + 1.0) * (level + 1.0);
+
+            if ((level > rms + 1e-6 * rms) || (error > 4294967296.0))
+            {
+                printf("FAIL: peak monitor run %u: rms %.0f, double %.1f\n", run, level, rms);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+/* Time a sample of the peak monitor in ns. version 0 is the DSP's loop,
+   which has only the peak. */
+static double time_peak_monitor(int version, unsigned frame)
+{
+    static int32_t input[BENCH_SAMPLES];
+    audio_proc_host_peak_monitor monitor;
+    unsigned samples = 0;
+    unsigned i, start;
+    clock_t begin;
+    double elapsed;
+    int32_t peak = 0;
+
+    for (i = 0; i < BENCH_SAMPLES; i++)
+    {
+        input[i] = random_word() >> 4;
+    }
+    audio_proc_host_set_simd(version == 2);
+    audio_proc_host_peak_monitor_reset(&monitor);
+
+    begin = clock();
+    do
+    {
+        for (start = 0; start + frame <= BENCH_SAMPLES; start += frame)
+        {
+            if (version == 0)
+            {
+                for (i = 0; i < frame; i++)
+                {
+                    peak = (kal_abs32(input[start + i]) > peak) ? kal_abs32(input[start + i]) : peak;
+                }
+            }
+            else
+            {
+                audio_proc_host_peak_monitor_process(&monitor, &input[start], frame);
+            }
+            samples += frame;
+        }
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    random_state ^= (uint32_t)(peak ^ monitor.peak_level) & 1;
+    return elapsed * 1e9 / samples;
+}
+
+static int run_peak_monitor(void)
+{
+    static const unsigned frames[] = {8, 64, 240, 1024};
+    int failures = check_peak_monitor();
+    unsigned f;
+
+    printf("peak monitor: %s\n",
+           failures ? "FAILED" : "peak matches the model and RMS the double level, with simd and without");
+    for (f = 0; f < sizeof(frames) / sizeof(frames[0]); f++)
+    {
+        double model = time_peak_monitor(0, frames[f]);
+        double scalar = time_peak_monitor(1, frames[f]);
+        double simd = time_peak_monitor(2, frames[f]);
+
+        printf("  frame %4u, ns per sample: peak only model %5.2f, peak and rms scalar %5.2f, simd %5.2f\n",
+               frames[f], model, scalar, simd);
+    }
+    return failures;
+}
+
+static int check_stream_gain(void)
+{
+    static int32_t input[MAX_TEST_SAMPLES], output[MAX_TEST_SAMPLES], muted[MAX_TEST_SAMPLES];
+    int failures = 0;
+    unsigned run, i;
+
+    for (run = 0; run < GAIN_TEST_RUNS; run++)
+    {
+        unsigned samples = (uint32_t)random_word() % MAX_TEST_SAMPLES;
+        int32_t mantissa = random_word() >> ((uint32_t)random_word() % 16);
+        int exponent = (int)((uint32_t)random_word() % 70) - 35;
+        int shift = (int)((uint32_t)random_word() % 24);
+        int simd;
+
+        if (((run & 3) == 0) && (exponent >= 1) && (exponent <= 30))
+        {
+            /* about unity, where the SIMD loop stops saturating */
+            static const int32_t offsets[] = {0, -1, 1};
+            int32_t unity = (int32_t)1 << (31 - exponent);
+
+            mantissa = (run & 4) ? unity : -unity;
+            mantissa += offsets[(run >> 3) % 3];
+        }
+        for (i = 0; i < samples; i++)
+        {
+            input[i] = random_word() >> shift;
+            if (((uint32_t)random_word() & 0xFF) == 0)
+            {
+                input[i] = INT32_MIN;
+            }
+        }
+        for (simd = 0; simd < 2; simd++)
+        {
+            audio_proc_host_set_simd(simd);
+            audio_proc_host_stream_gain(input, output, samples, mantissa, exponent);
+            for (i = 0; i < samples; i++)
+            {
+                /* rMAC = i/p * mantissa; r0 = rMAC ASHIFT r2 */
+                int32_t expect = kal_rmac_to_reg(KAL_MAC(input[i], mantissa), exponent);
+
+                if (output[i] != expect)
+                {
+                    printf("FAIL: stream gain %s run %u: gain %d exponent %d sample %u: %d, expect %d\n",
+                           simd ? "simd" : "scalar", run, mantissa, exponent, i, output[i], expect);
+                    failures++;
+                    break;
+                }
+            }
+        }
+
+        memcpy(muted, input, samples * sizeof(int32_t));
+        audio_proc_host_mute_control(muted, samples, (int32_t)(run & 1), 1);
+        for (i = 0; i < samples; i++)
+        {
+            if (muted[i] != ((run & 1) ? 0 : input[i]))
+            {
+                printf("FAIL: mute control run %u sample %u\n", run, i);
+                failures++;
+                break;
+            }
+        }
+    }
+    audio_proc_host_set_simd(1);
+    return failures;
+}
+
+/* $audio.fade_out, sample by sample, for one channel or two */
+static int model_fade_out(model_fade *m, int32_t *const *buffers, unsigned channels, unsigned samples)
+{
+    int finished = 0;
+    int flush = 0;
+    unsigned i = 0, ch;
+
+    if (m->state == AUDIO_PROC_HOST_FADE_OUT_FLUSHING)
+    {
+        flush = 1;
+    }
+    else if (m->state != AUDIO_PROC_HOST_FADE_OUT_END)
+    {
+        for (i = 0; i < samples; i++)
+        {
+            /* r1 = r6 * (SCALE_FRACT * SAMPLING_PERIOD_IN_USECS) (int); r1 = 1.0 - r1 */
+            int32_t gain = (int32_t)(0x7FFFFFFFu - (m->counter + i) * (uint32_t)FADE_OUT_STEP);
+
+            if (gain < 0)
+            {
+                m->state = AUDIO_PROC_HOST_FADE_OUT_FLUSHING;
+                flush = 1;
+                break;
+            }
+            for (ch = 0; ch < channels; ch++)
+            {
+                buffers[ch][i] = kal_frac_mult(buffers[ch][i], gain);
+            }
+        }
+    }
+    if (flush)
+    {
+        /* r5 = r5 - r10; if POS jump zero_samples */
+        m->flush_count -= (int32_t)(samples - i);
+        if (m->flush_count < 0)
+        {
+            finished = 1;
+            m->state = AUDIO_PROC_HOST_FADE_OUT_END;
+            m->flush_count = 0;
+        }
+    }
+    for (; i < samples; i++)
+    {
+        for (ch = 0; ch < channels; ch++)
+        {
+            buffers[ch][i] = 0;
+        }
+    }
+    m->counter += samples;
+    return finished;
+}
+
+static int check_fade_out(void)
+{
+    static int32_t expect[2][FADE_MAX_CALL], output[2][FADE_MAX_CALL];
+    int32_t *expects[2] = {expect[0], expect[1]};
+    int32_t *outputs[2] = {output[0], output[1]};
+    int failures = 0;
+    unsigned run, i, ch;
+
+    for (run = 0; run < FADE_TEST_RUNS; run++)
+    {
+        /* every state, mono and stereo, with simd and without */
+        unsigned channels = 1 + (run & 1);
+        model_fade m;
+        audio_proc_host_fade_out fade;
+        unsigned call;
+
+        m.counter = ((uint32_t)random_word() & 3) ? 0 : (uint32_t)random_word() % 600;
+        m.state = (int)(run >> 2) & 3;
+        m.flush_count = (int32_t)((uint32_t)random_word() % 1000);
+        fade.counter = m.counter;
+        fade.state = (audio_proc_host_fade_out_state)m.state;
+        fade.flush_count = (unsigned)m.flush_count;
+        audio_proc_host_set_simd((int)(run >> 1) & 1);
+
+        for (call = 0; call < 24; call++)
+        {
+            unsigned samples = (uint32_t)random_word() % FADE_MAX_CALL;
+            int expect_done, done;
+
+            for (ch = 0; ch < channels; ch++)
+            {
+                for (i = 0; i < samples; i++)
+                {
+                    expect[ch][i] = random_word();
+                    if (((uint32_t)random_word() & 0xFF) == 0)
+                    {
+                        expect[ch][i] = INT32_MIN;
+                    }
+                    output[ch][i] = expect[ch][i];
+                }
+            }
+            expect_done = model_fade_out(&m, expects, channels, samples);
+            done = audio_proc_host_fade_out_process(&fade, outputs, channels, samples);
+
+            if ((done != expect_done) || (fade.counter != m.counter) || ((int)fade.state != m.state)
+                || ((int32_t)fade.flush_count != m.flush_count))
+            {
+                printf("FAIL: fade out run %u call %u: finished %d state %d flush %u, expect %d %d %d\n", run, call,
+                       done, (int)fade.state, fade.flush_count, expect_done, m.state, (int)m.flush_count);
+                failures++;
+                break;
+            }
+            for (ch = 0; ch < channels; ch++)
+            {
+                if (memcmp(output[ch], expect[ch], samples * sizeof(int32_t)) != 0)
+                {
+                    printf("FAIL: fade out run %u call %u channel %u: samples differ\n", run, call, ch);
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+    audio_proc_host_set_simd(1);
+    return failures;
+}
+
+/* A ramp of random gains, length and delay */
+static void random_ramp(audio_proc_host_ramp *ramp, unsigned *length, unsigned *delay, int32_t *target)
+{
+    int32_t gain = (int32_t)((uint32_t)random_word() >> ((uint32_t)random_word() % 20 + 1));
+    int exponent = (int)((uint32_t)random_word() % 62) - 31;
+
+    *target = (int32_t)((uint32_t)random_word() >> ((uint32_t)random_word() % 20 + 1));
+    if (((uint32_t)random_word() & 7) == 0)
+    {
+        *target = 0;
+    }
+    *length = ((uint32_t)random_word() & 15) ? (uint32_t)random_word() % 1000 : 0;
+    *delay = ((uint32_t)random_word() & 1) ? (uint32_t)random_word() % 800 : 0;
+    audio_proc_host_ramp_init(ramp, gain, exponent);
+}
+
+/* Gain ramp output in calls of random size, or of size step if non-zero */
+static void ramp_in_calls(audio_proc_host_ramp *ramp, const int32_t *const *inputs, int32_t *const *outputs,
+                          unsigned samples, unsigned step, int32_t *gains)
+{
+    unsigned done = 0;
+
+    while (done < samples)
+    {
+        unsigned n = step ? step : (uint32_t)random_word() % RAMP_MAX_CALL;
+        const int32_t *in[2];
+        int32_t *out[2];
+        unsigned ch;
+
+        n = (n < samples - done) ? n : samples - done;
+        for (ch = 0; ch < 2; ch++)
+        {
+            in[ch] = &inputs[ch][done];
+            out[ch] = &outputs[ch][done];
+        }
+        if (gains != NULL)
+        {
+            gains[done] = ramp->gain;
+        }
+        audio_proc_host_ramp_process(ramp, in, out, 2, n);
+        done += n;
+    }
+}
+
+static int check_ramp(void)
+{
+    static int32_t input[2][RAMP_TEST_SAMPLES], output[4][2][RAMP_TEST_SAMPLES];
+    static int32_t gains[RAMP_TEST_SAMPLES], steady[RAMP_TEST_SAMPLES];
+    const int32_t *inputs[2] = {input[0], input[1]};
+    int failures = 0;
+    unsigned run, i, v;
+
+    for (run = 0; run < RAMP_TEST_RUNS; run++)
+    {
+        audio_proc_host_ramp ramp[4];
+        unsigned length, delay, end;
+        int32_t start, target;
+        audio_proc_host_ramp_shape shape = (run & 1) ? AUDIO_PROC_HOST_RAMP_EXPONENTIAL : AUDIO_PROC_HOST_RAMP_LINEAR;
+        int shift = (int)((uint32_t)random_word() % 24);
+        int error = 0;
+
+        for (i = 0; i < RAMP_TEST_SAMPLES; i++)
+        {
+            input[0][i] = random_word() >> shift;
+            input[1][i] = random_word() >> shift;
+        }
+        random_ramp(&ramp[0], &length, &delay, &target);
+        start = ramp[0].gain;
+        audio_proc_host_ramp_start(&ramp[0], target, length, shape, delay);
+        for (v = 1; v < 4; v++)
+        {
+            ramp[v] = ramp[0];
+        }
+
+        /* one call, calls of random size with and without simd, and
+           sample by sample */
+        for (v = 0; v < 4; v++)
+        {
+            int32_t *outputs[2] = {output[v][0], output[v][1]};
+
+            audio_proc_host_set_simd(v == 1);
+            ramp_in_calls(&ramp[v], inputs, outputs, RAMP_TEST_SAMPLES, (v == 0) ? RAMP_TEST_SAMPLES : (v == 3),
+                          (v == 3) ? gains : NULL);
+            if ((v > 0) && (memcmp(output[v], output[0], sizeof(output[0])) != 0))
+            {
+                printf("FAIL: ramp run %u: version %u differs from one call\n", run, v);
+                error = 1;
+            }
+        }
+        if (audio_proc_host_ramp_active(&ramp[0]) || (ramp[0].gain != target))
+        {
+            printf("FAIL: ramp run %u: gain %d after the ramp, target %d\n", run, ramp[0].gain, target);
+            error = 1;
+        }
+
+        /* the start gain up to the delay, the target after the ramp, and
+           between them gains that only move towards the target */
+        end = delay + length;
+        for (i = 0; i < RAMP_TEST_SAMPLES && !error; i++)
+        {
+            int32_t expect = (i < end) ? start : target;
+
+            if ((i < delay || i >= end) && (gains[i] != expect))
+            {
+                printf("FAIL: ramp run %u sample %u: gain %d, expect %d\n", run, i, gains[i], expect);
+                error = 1;
+            }
+            if ((i > 0) && ((target >= start) ? (gains[i] < gains[i - 1]) : (gains[i] > gains[i - 1])))
+            {
+                printf("FAIL: ramp run %u sample %u: gain %d after %d\n", run, i, gains[i], gains[i - 1]);
+                error = 1;
+            }
+        }
+        audio_proc_host_stream_gain(&input[0][end], steady, RAMP_TEST_SAMPLES - end, target, ramp[0].exponent);
+        if (!error && (end < RAMP_TEST_SAMPLES)
+            && memcmp(steady, &output[0][0][end], (RAMP_TEST_SAMPLES - end) * sizeof(int32_t)) != 0)
+        {
+            printf("FAIL: ramp run %u: steady gain differs from stream gain\n", run);
+            error = 1;
+        }
+        failures += error;
+    }
+
+    if ((audio_proc_host_ramp_ttp_delay(1000, 0, 48000) != 48)
+        || (audio_proc_host_ramp_ttp_delay(10, 0, 48000) != 0)
+        || (audio_proc_host_ramp_ttp_delay(11, 0, 48000) != 1)
+        || (audio_proc_host_ramp_ttp_delay(0, 1000, 48000) != 0)
+        || (audio_proc_host_ramp_ttp_delay(5000, 0xFFFFFC18u, 44100) != 265))
+    {
+        printf("FAIL: ramp start from time to play\n");
+        failures++;
+    }
+    audio_proc_host_set_simd(1);
+    return failures;
+}
+
+/* Time a sample of each of two channels in ns, of stream gain or, if
+   ramped, of a ramp that starts an eighth of the way into each call and
+   lasts the rest of it. Version 0 is a loop that works out the gain of
+   each sample and multiplies it as the DSP would, 1 and 2 the port without
+   and with simd. */
+static double time_ramp(int version, int ramped, audio_proc_host_ramp_shape shape)
+{
+    static int32_t input[2][BENCH_SAMPLES], output[2][BENCH_SAMPLES];
+    const int32_t *in[2] = {input[0], input[1]};
+    int32_t *out[2] = {output[0], output[1]};
+    audio_proc_host_ramp ramp;
+    unsigned calls = 0, i, ch;
+    clock_t begin;
+    double elapsed;
+
+    for (i = 0; i < BENCH_SAMPLES; i++)
+    {
+        input[0][i] = random_word() >> 2;
+        input[1][i] = random_word() >> 2;
+    }
+    audio_proc_host_set_simd(version == 2);
+    audio_proc_host_ramp_init(&ramp, 0x40000000, 1);
+
+    begin = clock();
+    do
+    {
+        int32_t target = (calls & 1) ? 0x40000000 : 0x08000000;
+
+        if (!ramped)
+        {
+            for (ch = 0; ch < 2; ch++)
+            {
+                if (version == 0)
+                {
+                    for (i = 0; i < BENCH_SAMPLES; i++)
+                    {
+                        output[ch][i] = kal_rmac_to_reg(KAL_MAC(input[ch][i], target), 1);
+                    }
+                }
+                else
+                {
+                    audio_proc_host_stream_gain(input[ch], output[ch], BENCH_SAMPLES, target, 1);
+                }
+            }
+        }
+        else if (version == 0)
+        {
+            /* gain = start + (target - start) * n / length */
+            int32_t start = ramp.gain;
+            unsigned delay = BENCH_SAMPLES / 8;
+            unsigned length = BENCH_SAMPLES - delay;
+
+            for (i = 0; i < BENCH_SAMPLES; i++)
+            {
+                int32_t gain = start;
+
+                if (i >= delay)
+                {
+                    gain = (int32_t)(start + ((int64_t)target - start) * (i - delay) / length);
+                }
+                output[0][i] = kal_rmac_to_reg(KAL_MAC(input[0][i], gain), 1);
+                output[1][i] = kal_rmac_to_reg(KAL_MAC(input[1][i], gain), 1);
+            }
+            ramp.gain = target;
+        }
+        else
+        {
+            audio_proc_host_ramp_start(&ramp, target, BENCH_SAMPLES - BENCH_SAMPLES / 8, shape, BENCH_SAMPLES / 8);
+            audio_proc_host_ramp_process(&ramp, in, out, 2, BENCH_SAMPLES);
+        }
+        calls++;
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    return elapsed * 1e9 / ((double)calls * BENCH_SAMPLES * 2);
+}
+
+/* Time a sample of each of two channels of the fade out in ns, restarted
+   every frame so that it is always fading: version 0 is the model */
+static double time_fade_out(int version)
+{
+    static int32_t buffer[2][BENCH_SAMPLES];
+    int32_t *buffers[2] = {buffer[0], buffer[1]};
+    const unsigned frame = BENCH_SAMPLES / 2;
+    unsigned calls = 0, i;
+    clock_t begin;
+    double elapsed;
+
+    audio_proc_host_set_simd(version == 2);
+    begin = clock();
+    do
+    {
+        model_fade m = {0, AUDIO_PROC_HOST_FADE_OUT_RUNNING, 0};
+        audio_proc_host_fade_out fade = {0, AUDIO_PROC_HOST_FADE_OUT_RUNNING, 0};
+
+        for (i = 0; i < frame; i++)
+        {
+            buffer[0][i] = 0x20000000 + (int32_t)i;
+            buffer[1][i] = 0x10000000 - (int32_t)i;
+        }
+        if (version == 0)
+        {
+            model_fade_out(&m, buffers, 2, frame);
+        }
+        else
+        {
+            audio_proc_host_fade_out_process(&fade, buffers, 2, frame);
+        }
+        calls++;
+        elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    audio_proc_host_set_simd(1);
+    return elapsed * 1e9 / ((double)calls * frame * 2);
+}
+
+static int run_ramp(void)
+{
+    int failures = check_stream_gain();
+    int fade_failures = check_fade_out();
+    int ramp_failures = check_ramp();
+    double model, scalar, simd;
+
+    printf("stream gain: %s\n", failures ? "FAILED" : "matches rMAC ASHIFT, with simd and without");
+    printf("fade out: %s\n", fade_failures ? "FAILED" : "matches the model, mono and stereo, from any state");
+    printf("gain ramp: %s\n", ramp_failures ? "FAILED"
+           : "the same in any calls, with simd and without, and steady gains match stream gain");
+    printf("  ns per sample of two channels:\n");
+
+    model = time_ramp(0, 0, AUDIO_PROC_HOST_RAMP_LINEAR);
+    scalar = time_ramp(1, 0, AUDIO_PROC_HOST_RAMP_LINEAR);
+    simd = time_ramp(2, 0, AUDIO_PROC_HOST_RAMP_LINEAR);
+    printf("    stream gain        : loop %5.2f, scalar %5.2f, simd %5.2f (x%4.1f)\n", model, scalar, simd,
+           model / simd);
+    model = time_ramp(0, 1, AUDIO_PROC_HOST_RAMP_LINEAR);
+    scalar = time_ramp(1, 1, AUDIO_PROC_HOST_RAMP_LINEAR);
+    simd = time_ramp(2, 1, AUDIO_PROC_HOST_RAMP_LINEAR);
+    printf("    linear ramp        : loop %5.2f, scalar %5.2f, simd %5.2f (x%4.1f)\n", model, scalar, simd,
+           model / simd);
+    scalar = time_ramp(1, 1, AUDIO_PROC_HOST_RAMP_EXPONENTIAL);
+    simd = time_ramp(2, 1, AUDIO_PROC_HOST_RAMP_EXPONENTIAL);
+    printf("    exponential ramp   :            scalar %5.2f, simd %5.2f\n", scalar, simd);
+    model = time_fade_out(0);
+    scalar = time_fade_out(1);
+    simd = time_fade_out(2);
+    printf("    fade out           : model %5.2f, scalar %5.2f, simd %5.2f (x%4.1f)\n", model, scalar, simd,
+           model / simd);
+    return failures + fade_failures + ramp_failures;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int main(int argc, char **argv)
+{
+    int failures = 0;
+
+    failures += run_peq();
+    failures += run_xover();
+    failures += run_resampler((argc > 1) ? argv[1] : RS_DEFAULT_COEFS);
+    failures += run_compander();
+    failures += run_mixer();
+    failures += run_peak_monitor();
+    failures += run_ramp();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,689 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_compander.c
+ * \ingroup audio_proc
+ *
+ * Host port of the compander of compander.asm, and a block mode with the
+ * same gain curve built for speed. <br>
+ *
+ * The DSP takes the channels in blocks of gain_update_rate samples: one
+ * sample, or 0.5 ms with GAIN_UPDATE_FLAG. For each block it tracks the
+ * level of each channel with a one-pole peak or average detector, takes
+ * the largest peak or the mean over the channels, finds the gain from log2
+ * of the level on a piecewise linear curve with soft knees, smooths the
+ * gain in log2, turns it back to linear with pow2 and applies it to the
+ * input delayed by the look-ahead, stepping to it across the block with
+ * GAIN_INTERP_FLAG. The DSP mode of this port does all of that as the
+ * assembly does, with $math.log2_taylor and $math.pow2_taylor.
+ *
+ * The block mode always updates the gain every 0.5 ms. The detectors run
+ * through the whole block with a pair of channels in SIMD lanes, giving
+ * the same levels as the DSP's. log2 and pow2 come from the 32 entry
+ * tables of $math.log2_table and $math.pow2_table in place of the Taylor
+ * series, and a second pass applies the gain to a pair of channels at a
+ * time, rounding the product once where the DSP rounds it and then
+ * shifts. The look-ahead history is the last input samples in order, so
+ * the gain pass reads the delayed input straight from the history or the
+ * input buffer.
+ *
+ * The reciprocals that initialize finds with kal_float_lib are found in
+ * double precision here, and may differ from the DSP's in the last bit.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "audio_proc_host_private.h"
+#include "audio_proc_host_simd.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** A fractional constant as the assembler rounds it, Qfmt_(x, n) with n
+    integer bits */
+#define QFMT(x, n)          ((int32_t)((x) * (double)((int64_t)1 << (32 - (n))) + (((x) < 0) ? -0.5 : 0.5)))
+#define FRAC(x)             QFMT(x, 1)
+
+/** Qfmt_(1.0, 5): unity slope and linear gain */
+#define UNITY_Q27           (1 << 27)
+
+/** Integer and fractional parts of a Q8.24 value */
+#define Q24_SHIFT           24
+
+/** Log2 of e, Qfmt_(1.44269504, 2) */
+#define LOG2_E              QFMT(1.44269504, 2)
+
+/** 0.5 ms of samples: the gain update rate of the block modes */
+#define GAIN_UPDATE_TIME    FRAC(0.0005)
+
+/** Index bits of the log2 and pow2 tables, $LOG2_TBL_INDX and
+    $POW2_TBL_INDX */
+#define TABLE_INDEX_BITS    5
+
+/****************************************************************************
+Private Variable Definitions
+*/
+
+/* log2_coefs of $math.log2_taylor, C6 first */
+static const int32_t log2_coefs[7] =
+{
+    FRAC(-0.0124136209), FRAC(0.0589549541), FRAC(-0.1361793280),
+    FRAC(0.2269296646), FRAC(-0.3584938049), FRAC(0.7211978436),
+    FRAC(0.0000063181)
+};
+
+/* tab32_log2 of $math.log2_table: log2(1 + i/32), Q8.24 */
+static const int32_t log2_tab[(1 << TABLE_INDEX_BITS) + 1] =
+{
+    QFMT(0.0000000000, 8), QFMT(0.0443954560, 8), QFMT(0.0874633728, 8),
+    QFMT(0.1292801024, 8), QFMT(0.1699218688, 8), QFMT(0.2094497792, 8),
+    QFMT(0.2479248000, 8), QFMT(0.2854003968, 8), QFMT(0.3219299328, 8),
+    QFMT(0.3575515648, 8), QFMT(0.3923187200, 8), QFMT(0.4262619136, 8),
+    QFMT(0.4594345216, 8), QFMT(0.4918518016, 8), QFMT(0.5235595648, 8),
+    QFMT(0.5545883264, 8), QFMT(0.5849609344, 8), QFMT(0.6147079552, 8),
+    QFMT(0.6438598656, 8), QFMT(0.6724243200, 8), QFMT(0.7004394496, 8),
+    QFMT(0.7279205376, 8), QFMT(0.7548904448, 8), QFMT(0.7813568128, 8),
+    QFMT(0.8073577856, 8), QFMT(0.8328933632, 8), QFMT(0.8579788160, 8),
+    QFMT(0.8826446592, 8), QFMT(0.9068908672, 8), QFMT(0.9307403520, 8),
+    QFMT(0.9541931136, 8), QFMT(0.9772796672, 8), QFMT(1.0000000000, 8)
+};
+
+/* pow2_coefs of $math.pow2_taylor, C6 first */
+static const int32_t pow2_coefs[7] =
+{
+    FRAC(0.0000782609), FRAC(0.0006790758), FRAC(0.0048083663),
+    FRAC(0.0277463794), FRAC(0.1201133728), FRAC(0.3465742469),
+    FRAC(0.5000000000)
+};
+
+/* tab32_pow2 of $math.pow2_table: pow2(i/32 - 1), Q1.31 */
+static const int32_t pow2_tab[(1 << TABLE_INDEX_BITS) + 1] =
+{
+    FRAC(0.4999998808), FRAC(0.5109484196), FRAC(0.5221368074),
+    FRAC(0.5335700512), FRAC(0.5452537537), FRAC(0.5571932793),
+    FRAC(0.5693942308), FRAC(0.5818623304), FRAC(0.5946034193),
+    FRAC(0.6076235771), FRAC(0.6209287643), FRAC(0.6345254183),
+    FRAC(0.6484196186), FRAC(0.6626181602), FRAC(0.6771275997),
+    FRAC(0.6919548512), FRAC(0.7071067095), FRAC(0.7225903273),
+    FRAC(0.7384129763), FRAC(0.7545820475), FRAC(0.7711052895),
+    FRAC(0.7879903316), FRAC(0.8052450418), FRAC(0.8228776455),
+    FRAC(0.8408962488), FRAC(0.8593095541), FRAC(0.8781259060),
+    FRAC(0.8973543644), FRAC(0.9170038700), FRAC(0.9370837212),
+    FRAC(0.9576032162), FRAC(0.9785718918), FRAC(0.9999998808)
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* $math.log2_taylor: log2 of rMAC (Q9.63), Q8.24 */
+static int32_t log2_taylor(kal_rmac acc)
+{
+    int shift = kal_rmac_signdet(acc);
+    int32_t x, sum;
+    unsigned k;
+
+    /* 2M - 1 of the mantissa M, 0.5 <= M < 1 */
+    acc = kal_rmac_ashift(acc, shift);
+    x = (int32_t)((uint32_t)(acc >> 30) >> 1);
+    sum = log2_coefs[0];
+    for (k = 1; k < 7; k++)
+    {
+        sum = kal_frac_mac(log2_coefs[k], sum, x);
+    }
+    return (sum >> 6) - (int32_t)((uint32_t)(shift + 1) << Q24_SHIFT);
+}
+
+/* $math.log2_table: log2 of rMAC (Q9.63), Q8.24 */
+static int32_t log2_table(kal_rmac acc)
+{
+    int shift = kal_rmac_signdet(acc);
+    uint32_t index;
+    int32_t fraction;
+
+    acc = kal_rmac_ashift(acc, shift);
+    index = (uint32_t)(acc >> 30) >> (32 - TABLE_INDEX_BITS);
+    fraction = (int32_t)((uint32_t)(acc >> (30 - TABLE_INDEX_BITS)) >> 1);
+    acc = kal_rmac_load(log2_tab[index]) + KAL_MAC(fraction, log2_tab[index + 1] - log2_tab[index]);
+    return kal_rmac_to_reg(acc - kal_rmac_load((int32_t)((uint32_t)(shift + 1) << Q24_SHIFT)), 0);
+}
+
+/* r1 ASHIFT (integer + 1) at the end of pow2: the DSP's shifter runs out
+   of bits long before the value does */
+static int32_t pow2_scale(int32_t value, int32_t x)
+{
+    int shift = (x >> Q24_SHIFT) + 1;
+
+    return (shift < -31) ? 0 : kal_ashift32(value, shift);
+}
+
+/* $math.pow2_taylor: pow2 of x (Q8.24, not positive), Q1.31 */
+static int32_t pow2_taylor(int32_t x)
+{
+    int32_t f = (int32_t)(((uint32_t)x << 8) >> 1);
+    int32_t sum = pow2_coefs[0];
+    unsigned k;
+
+    for (k = 1; k < 7; k++)
+    {
+        sum = kal_frac_mac(pow2_coefs[k], sum, f);
+    }
+    return pow2_scale(sum, x);
+}
+
+/* $math.pow2_table: pow2 of x (Q8.24, not positive), Q1.31 */
+static int32_t pow2_table(int32_t x)
+{
+    uint32_t index = ((uint32_t)x << 8) >> (32 - TABLE_INDEX_BITS);
+    int32_t fraction = (int32_t)(((uint32_t)x << (8 + TABLE_INDEX_BITS)) >> 1);
+
+    return pow2_scale(kal_frac_mac(pow2_tab[index], pow2_tab[index + 1] - pow2_tab[index], fraction), x);
+}
+
+/* 1/value as the fractional result of $audio_proc.cmpd.recip_calc */
+static int32_t frac_recip(unsigned value)
+{
+    return (value > 1) ? (int32_t)(2147483648.0 / value + 0.5) : INT32_MAX;
+}
+
+/* $audio_proc.cmpd.tc_exp_calc: exp(-samples / (tc * fs)) for a time
+   constant tc in seconds, q.28, where the filter steps once every samples
+   samples. 1/(tc * fs) is formed in q.25 and goes through pow2_taylor. */
+static int32_t tc_alpha(int32_t tc, unsigned sample_rate, unsigned samples)
+{
+    double x;
+    int32_t step;
+
+    if (tc == 0)
+    {
+        return 0;
+    }
+    x = (double)samples * (double)(1 << 25) * (double)(1 << 28) / ((double)tc * sample_rate);
+    step = (x >= INT32_MAX) ? INT32_MAX : (int32_t)(x + 0.5);
+    return pow2_taylor(kal_frac_mult(-step, LOG2_E));
+}
+
+/* $audio_proc.cmpd.level_detect_peak on one channel: returns the running
+   max across channels */
+static int32_t level_peak_scalar(audio_proc_host_compander *cmpd, unsigned ch, const int32_t *in, unsigned n,
+                                 int32_t level)
+{
+    unsigned stride = cmpd->num_channels;
+    kal_rmac acc = kal_rmac_load(cmpd->level_hist[ch]);
+    kal_rmac peak = 0;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        int32_t x = in[i * stride];
+        int32_t alpha = (kal_rmac_load(x) > acc) ? cmpd->lvl_alpha_atk : cmpd->lvl_alpha_rls;
+
+        /* alpha y + (1 - alpha) |x|, from -(1 - alpha) = alpha - 1.0 */
+        acc = KAL_MAC(alpha, kal_rmac_high(acc)) - KAL_MAC(alpha + INT32_MIN, kal_abs32(x));
+        if (acc > peak)
+        {
+            peak = acc;
+        }
+    }
+    cmpd->level_hist[ch] = kal_rmac_store(acc);
+    if (peak > kal_rmac_load(level))
+    {
+        level = kal_rmac_store(peak);
+    }
+    return level;
+}
+
+/* $audio_proc.cmpd.level_detect_rms on one channel: returns the running
+   mean across channels. Despite the name the detector averages |x|. */
+static int32_t level_average_scalar(audio_proc_host_compander *cmpd, unsigned ch, const int32_t *in, unsigned n,
+                                    int32_t level)
+{
+    unsigned stride = cmpd->num_channels;
+    kal_rmac acc = kal_rmac_load(cmpd->level_hist[ch]);
+    int32_t alpha = cmpd->lvl_alpha_avg;
+    int32_t beta = INT32_MAX - alpha;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        acc = KAL_MAC(alpha, kal_rmac_high(acc)) + KAL_MAC(beta, kal_abs32(in[i * stride]));
+    }
+    cmpd->level_hist[ch] = kal_rmac_store(acc);
+    return kal_frac_mac(level, kal_rmac_high(acc), cmpd->num_channels_inv);
+}
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+
+/* level_peak_scalar on channels ch and ch + 1. The lanes hold half of
+   rMAC, which stays under 2^62 as alpha y + (1 - alpha) |x| < 2^62, so no
+   check is needed. x > y(high word) is the same test as x > rMAC, and the
+   peak of the rounded values is the rounded peak. */
+static int32_t level_peak_pair_simd(audio_proc_host_compander *cmpd, unsigned ch, const int32_t *in, unsigned n,
+                                    int32_t level)
+{
+    unsigned stride = cmpd->num_channels;
+    const vec2 atk = vec2_dup(cmpd->lvl_alpha_atk);
+    const vec2 rls = vec2_dup(cmpd->lvl_alpha_rls);
+    const vec2 atk_beta = vec2_dup(cmpd->lvl_alpha_atk + INT32_MIN);
+    const vec2 rls_beta = vec2_dup(cmpd->lvl_alpha_rls + INT32_MIN);
+    const acc2 half = acc2_dup((int64_t)1 << 30);
+    vec2 y = vec2_load(&cmpd->level_hist[ch]);
+    vec2 rounded = y;
+    vec2 peak = vec2_dup(0);
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        vec2 x = vec2_load(&in[i * stride]);
+        vec2 alpha = vec2_select_gt(x, y, atk, rls);
+        vec2 beta = vec2_select_gt(x, y, atk_beta, rls_beta);
+        acc2 sum = acc2_sub(acc2_mul(alpha, y), acc2_mul(beta, vec2_abs_sat(x)));
+
+        y = acc2_shift_sat(sum, 31);
+        rounded = acc2_shift_sat(acc2_add(sum, half), 31);
+        peak = vec2_max(peak, rounded);
+    }
+    vec2_store(&cmpd->level_hist[ch], rounded);
+    if (vec2_lane(peak, 0) > level)
+    {
+        level = vec2_lane(peak, 0);
+    }
+    if (vec2_lane(peak, 1) > level)
+    {
+        level = vec2_lane(peak, 1);
+    }
+    return level;
+}
+
+/* level_average_scalar on channels ch and ch + 1 */
+static int32_t level_average_pair_simd(audio_proc_host_compander *cmpd, unsigned ch, const int32_t *in,
+                                       unsigned n, int32_t level)
+{
+    unsigned stride = cmpd->num_channels;
+    const vec2 alpha = vec2_dup(cmpd->lvl_alpha_avg);
+    const vec2 beta = vec2_dup(INT32_MAX - cmpd->lvl_alpha_avg);
+    vec2 y = vec2_load(&cmpd->level_hist[ch]);
+    acc2 sum = acc2_dup(0);
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        sum = acc2_add(acc2_mul(alpha, y), acc2_mul(beta, vec2_abs_sat(vec2_load(&in[i * stride]))));
+        y = acc2_shift_sat(sum, 31);
+    }
+    vec2_store(&cmpd->level_hist[ch], acc2_shift_sat(acc2_add(sum, acc2_dup((int64_t)1 << 30)), 31));
+    level = kal_frac_mac(level, vec2_lane(y, 0), cmpd->num_channels_inv);
+    return kal_frac_mac(level, vec2_lane(y, 1), cmpd->num_channels_inv);
+}
+
+/* apply_gain_scalar on channels ch and ch + 1 */
+static void apply_gain_pair_simd(const int32_t *src, int32_t *out, unsigned stride, unsigned n, int32_t gain,
+                                 int32_t delta)
+{
+    const acc2 half = acc2_dup((int64_t)1 << 26);
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        acc2 product = acc2_mul(vec2_load(&src[i * stride]), vec2_dup(gain));
+
+        vec2_store(&out[i * stride], acc2_shift_sat(acc2_add(product, half), 27));
+        gain = (int32_t)((uint32_t)gain + (uint32_t)delta);
+    }
+}
+
+#endif
+
+/* Gain pass of the block mode on one channel: out = src * gain, q.31 *
+   q.27, with the gain stepping by delta after each sample */
+static void apply_gain_scalar(const int32_t *src, int32_t *out, unsigned stride, unsigned n, int32_t gain,
+                              int32_t delta)
+{
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        out[i * stride] = kal_sat32(((int64_t)src[i * stride] * gain + ((int64_t)1 << 26)) >> 27);
+        gain = (int32_t)((uint32_t)gain + (uint32_t)delta);
+    }
+}
+
+/* Level detection of all the channels over a block */
+static int32_t detect_level(audio_proc_host_compander *cmpd, const int32_t *in, unsigned n)
+{
+    unsigned stride = cmpd->num_channels;
+    int32_t level = 0;
+    unsigned ch = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    if (cmpd->block_mode && audio_proc_host_simd_enabled)
+    {
+        for (; ch + 2 <= stride; ch += 2)
+        {
+            level = cmpd->params.level_estimation_flag
+                    ? level_peak_pair_simd(cmpd, ch, &in[ch], n, level)
+                    : level_average_pair_simd(cmpd, ch, &in[ch], n, level);
+        }
+    }
+#endif
+    for (; ch < stride; ch++)
+    {
+        level = cmpd->params.level_estimation_flag
+                ? level_peak_scalar(cmpd, ch, &in[ch], n, level)
+                : level_average_scalar(cmpd, ch, &in[ch], n, level);
+    }
+    return level;
+}
+
+/* 2 |a - b| as (int) arithmetic, which wraps */
+static int32_t twice_distance(int32_t a, int32_t b)
+{
+    return (int32_t)((uint32_t)kal_abs32((int32_t)((uint32_t)a - (uint32_t)b)) * 2u);
+}
+
+/* $audio_proc.cmpd.computegain: G_log2 in rMAC (q.24 in the high word)
+   for the level xg, log2 in q.24 */
+static kal_rmac compute_gain(const audio_proc_host_compander *cmpd, int32_t xg)
+{
+    const audio_proc_host_compander_params *p = &cmpd->params;
+    unsigned threshold_index = (unsigned)p->num_sections;
+    unsigned kw_index = threshold_index - 1;
+    int norm = kal_signdet32(xg);
+    int32_t xn = (int32_t)((uint32_t)xg << norm);
+    int32_t threshold, kneewidth;
+    kal_rmac acc;
+    unsigned j;
+
+    /* The lowest section whose threshold is at or below the level, and the
+       lowest whose knee the level is in */
+    for (j = threshold_index - 1; j > 0; j--)
+    {
+        threshold = p->gain_threshold[j - 1] >> 3;
+        kneewidth = p->gain_kneewidth[j - 1] >> 7;
+        if (threshold <= xg)
+        {
+            threshold_index = j;
+        }
+        if (twice_distance(xg, threshold) <= kneewidth)
+        {
+            kw_index = j;
+        }
+    }
+    if (kw_index > threshold_index)
+    {
+        kw_index = threshold_index;
+    }
+
+    threshold = p->gain_threshold[kw_index - 1] >> 3;
+    kneewidth = p->gain_kneewidth[kw_index - 1] >> 7;
+    if (twice_distance(xg, threshold) <= kneewidth)
+    {
+        /* soft_knee_part: a xg^2 + b xg + c, with xg normalised */
+        const int32_t *c = p->soft_knee_coeffs[kw_index - 1];
+
+        acc = KAL_MAC(xn, xn);
+        acc = KAL_MAC(kal_rmac_high(acc), c[0]);
+        acc = kal_rmac_ashift(acc, 19 - 2 * norm);
+        acc += kal_rmac_load(kal_ashift32(kal_frac_mult(c[1], xn), 12 - norm));
+        acc += kal_rmac_load(kal_ashift32(c[2], 5));
+    }
+    else
+    {
+        /* linear_part: slope xg + intercept */
+        acc = kal_rmac_ashift(KAL_MAC(cmpd->slope[threshold_index - 1], xn), 3 - norm);
+        acc += kal_rmac_load(cmpd->intercept[threshold_index - 1]);
+    }
+
+    /* compute_gain: yG - xG + makeup gain */
+    acc = kal_rmac_ashift(acc, 1) - kal_rmac_load(xg);
+    return acc + kal_rmac_load(p->makeup_gain >> 6);
+}
+
+/* $audio_proc.cmpd.smoothGainB */
+static void smooth_gain(audio_proc_host_compander *cmpd, kal_rmac gain)
+{
+    int32_t old = cmpd->gain_smooth_hist;
+    int32_t alpha = (gain < kal_rmac_load(old)) ? cmpd->gain_alpha_atk : cmpd->gain_alpha_rls;
+
+    cmpd->gain_smooth_hist = kal_frac_mac(kal_frac_mult(alpha, old), INT32_MAX - alpha, kal_rmac_high(gain));
+}
+
+/* $audio_proc.cmpd.calc_pow2_input: the smoothed gain in linear, q.27 */
+static int32_t gain_to_linear(const audio_proc_host_compander *cmpd, int32_t (*pow2)(int32_t))
+{
+    int32_t gain = cmpd->gain_smooth_hist;
+    int32_t integer;
+
+    if (gain == 0)
+    {
+        return UNITY_Q27;
+    }
+    if (gain < 0)
+    {
+        return kal_frac_mult(UNITY_Q27, pow2(gain));
+    }
+
+    /* pow2(integer + 1) pow2(fraction - 1) */
+    integer = gain >> Q24_SHIFT;
+    gain = gain - (integer << Q24_SHIFT) - (1 << Q24_SHIFT);
+    return kal_frac_mult(kal_ashift32(1, (integer < 3) ? integer + 28 : 31), pow2(gain));
+}
+
+/* $audio_proc.cmpd.final_gain_apply on every channel: the input goes into
+   the look-ahead ring, which runs backwards from lookahead_pos, and the
+   sample lookahead_samples older comes out. gain is the new gain, or with
+   interpolation the step to it from old_gain. */
+static void apply_gain_dsp(audio_proc_host_compander *cmpd, const int32_t *in, int32_t *out, unsigned n,
+                           int32_t old_gain, int32_t gain)
+{
+    unsigned stride = cmpd->num_channels;
+    unsigned size = cmpd->lookahead_samples + 1;
+    unsigned pos = cmpd->lookahead_pos;
+    unsigned ch, i;
+
+    for (ch = 0; ch < stride; ch++)
+    {
+        pos = cmpd->lookahead_pos;
+        for (i = 0; i < n; i++)
+        {
+            int32_t g = gain;
+            int32_t x;
+
+            if (cmpd->gain_interp)
+            {
+                g = (int32_t)((uint32_t)old_gain + (uint32_t)gain * (i + 1));
+            }
+            cmpd->lookahead_hist[pos * stride + ch] = in[i * stride + ch];
+            pos = (pos == 0) ? size - 1 : pos - 1;
+            x = cmpd->lookahead_hist[pos * stride + ch];
+            out[i * stride + ch] = kal_ashift32(kal_frac_mult(x, g), 4);
+        }
+    }
+    cmpd->lookahead_pos = pos;
+}
+
+/* The gain pass of the block mode, with gain as for apply_gain_dsp. The
+   history holds the last lookahead_samples input samples, oldest first. */
+static void apply_gain_block(audio_proc_host_compander *cmpd, const int32_t *in, int32_t *out, unsigned n,
+                             int32_t old_gain, int32_t gain)
+{
+    unsigned stride = cmpd->num_channels;
+    unsigned delay = cmpd->lookahead_samples;
+    unsigned from_hist = (n < delay) ? n : delay;
+    int32_t delta = 0;
+    unsigned part;
+
+    if (cmpd->gain_interp)
+    {
+        delta = gain;
+        gain = (int32_t)((uint32_t)old_gain + (uint32_t)delta);
+    }
+
+    for (part = 0; part < 2; part++)
+    {
+        const int32_t *src = part ? in : cmpd->lookahead_hist;
+        int32_t *dest = part ? &out[from_hist * stride] : out;
+        unsigned count = part ? n - from_hist : from_hist;
+        int32_t first = (int32_t)((uint32_t)gain + (uint32_t)delta * (part ? from_hist : 0));
+        unsigned ch = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+        if (audio_proc_host_simd_enabled)
+        {
+            for (; ch + 2 <= stride; ch += 2)
+            {
+                apply_gain_pair_simd(&src[ch], &dest[ch], stride, count, first, delta);
+            }
+        }
+#endif
+        for (; ch < stride; ch++)
+        {
+            apply_gain_scalar(&src[ch], &dest[ch], stride, count, first, delta);
+        }
+    }
+
+    /* Keep the last delay input samples */
+    if (delay > n)
+    {
+        memmove(cmpd->lookahead_hist, &cmpd->lookahead_hist[n * stride], (delay - n) * stride * sizeof(int32_t));
+        memcpy(&cmpd->lookahead_hist[(delay - n) * stride], in, n * stride * sizeof(int32_t));
+    }
+    else if (delay > 0)
+    {
+        memcpy(cmpd->lookahead_hist, &in[(n - delay) * stride], delay * stride * sizeof(int32_t));
+    }
+}
+
+/* $audio_proc.cmpd.process_channels: one block of gain_update_rate samples */
+static void process_block(audio_proc_host_compander *cmpd, const int32_t *in, int32_t *out)
+{
+    unsigned n = cmpd->gain_update_rate;
+    int32_t level = detect_level(cmpd, in, n);
+    int32_t old_gain = cmpd->gain_smooth_hist_linear;
+    int32_t gain;
+
+    if (cmpd->block_mode)
+    {
+        smooth_gain(cmpd, compute_gain(cmpd, log2_table(kal_rmac_load(level))));
+        gain = gain_to_linear(cmpd, pow2_table);
+    }
+    else
+    {
+        smooth_gain(cmpd, compute_gain(cmpd, log2_taylor(kal_rmac_load(level))));
+        gain = gain_to_linear(cmpd, pow2_taylor);
+    }
+    cmpd->gain_smooth_hist_linear = gain;
+
+    /* $audio_proc.cmpd.smoothGainS: the step to the new gain */
+    if (cmpd->gain_interp)
+    {
+        gain = kal_frac_mult(gain - old_gain, cmpd->gain_update_rate_inv);
+    }
+
+    if (cmpd->block_mode)
+    {
+        apply_gain_block(cmpd, in, out, n, old_gain, gain);
+    }
+    else
+    {
+        apply_gain_dsp(cmpd, in, out, n, old_gain, gain);
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+unsigned audio_proc_host_compander_lookahead_size(const audio_proc_host_compander_params *params,
+                                                  unsigned sample_rate, unsigned num_channels)
+{
+    return ((unsigned)kal_frac_mult((int32_t)sample_rate, params->lookahead_time) + 1) * num_channels;
+}
+
+int audio_proc_host_compander_init(audio_proc_host_compander *cmpd, const audio_proc_host_compander_params *params,
+                                   unsigned num_channels, unsigned sample_rate, int block_mode,
+                                   int32_t *lookahead_hist, unsigned lookahead_size)
+{
+    unsigned n = (unsigned)params->num_sections;
+    unsigned i;
+
+    if (num_channels < 1 || num_channels > AUDIO_PROC_HOST_MAX_CHANNELS ||
+        n < 2 || n > AUDIO_PROC_HOST_COMPANDER_MAX_SECTIONS)
+    {
+        return 0;
+    }
+    memset(cmpd, 0, sizeof(*cmpd));
+    cmpd->params = *params;
+    cmpd->num_channels = num_channels;
+    cmpd->block_mode = block_mode;
+
+    cmpd->lvl_alpha_atk = tc_alpha(params->level_attack_tc, sample_rate, 1);
+    cmpd->lvl_alpha_rls = tc_alpha(params->level_release_tc, sample_rate, 1);
+    cmpd->lvl_alpha_avg = tc_alpha(params->level_average_tc, sample_rate, 1);
+
+    /* Slopes are 1/ratio in q.27, with 1.0 for the last section. The
+       intercepts keep the curve continuous, from the last section down. */
+    cmpd->slope[n - 1] = UNITY_Q27;
+    for (i = 0; i < n - 1; i++)
+    {
+        double slope = (params->gain_ratio[i] > 0) ? 18014398509481984.0 / params->gain_ratio[i] : INT32_MAX;
+
+        cmpd->slope[i] = (slope >= INT32_MAX) ? INT32_MAX : (int32_t)(slope + 0.5);
+    }
+    cmpd->intercept[n - 1] = 0;
+    cmpd->intercept[n - 2] = kal_frac_mult(params->gain_threshold[n - 2], UNITY_Q27 - cmpd->slope[n - 2]);
+    for (i = n - 2; i-- > 0;)
+    {
+        cmpd->intercept[i] = kal_frac_mac(cmpd->intercept[i + 1], params->gain_threshold[i],
+                                          cmpd->slope[i + 1] - cmpd->slope[i]);
+    }
+
+    /* The DSP only interpolates when updating every 0.5 ms */
+    cmpd->gain_update_rate = 1;
+    cmpd->gain_interp = 0;
+    if (block_mode || params->gain_update_flag)
+    {
+        cmpd->gain_update_rate = (unsigned)kal_frac_mult((int32_t)sample_rate, GAIN_UPDATE_TIME);
+        if (cmpd->gain_update_rate == 0)
+        {
+            cmpd->gain_update_rate = 1;
+        }
+        cmpd->gain_interp = (params->gain_interp_flag != 0);
+    }
+    cmpd->gain_update_rate_inv = frac_recip(cmpd->gain_update_rate);
+    cmpd->gain_alpha_atk = tc_alpha(params->gain_attack_tc, sample_rate, cmpd->gain_update_rate);
+    cmpd->gain_alpha_rls = tc_alpha(params->gain_release_tc, sample_rate, cmpd->gain_update_rate);
+
+    /* No look-ahead if there is no room for its history, as when the DSP
+       fails to allocate it */
+    cmpd->lookahead_hist = cmpd->lookahead_frame;
+    if (lookahead_hist != NULL &&
+        lookahead_size >= audio_proc_host_compander_lookahead_size(params, sample_rate, num_channels))
+    {
+        cmpd->lookahead_hist = lookahead_hist;
+        cmpd->lookahead_samples = (unsigned)kal_frac_mult((int32_t)sample_rate, params->lookahead_time);
+        memset(lookahead_hist, 0, lookahead_size * sizeof(int32_t));
+    }
+
+    cmpd->num_channels_inv = frac_recip(num_channels);
+    cmpd->gain_smooth_hist_linear = UNITY_Q27;
+    return 1;
+}
+
+unsigned audio_proc_host_compander_process(audio_proc_host_compander *cmpd, const int32_t *input, int32_t *output,
+                                           unsigned samples)
+{
+    unsigned rate = cmpd->gain_update_rate;
+    unsigned stride = cmpd->num_channels;
+    unsigned done;
+
+    for (done = 0; done + rate <= samples; done += rate)
+    {
+        process_block(cmpd, &input[done * stride], &output[done * stride]);
+    }
+    return done;
+}
@@ -0,0 +1,940 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_iir_resampler.c
+ * \ingroup audio_proc
+ *
+ * Host port of the IIR resampler of iir_resamplev2_common.asm:
+ * $iir_perform_resample, its three stage functions and the single and
+ * double precision IIR functions. <br>
+ *
+ * A definition has one or two stages. Each is a polyphase FIR of 6 or 10
+ * taps, where the counter steps through rout phases by frac_ratio, and
+ * (but for the FIR upsample stage) an IIR of two to five cascaded sections,
+ * before the FIR to downsample or after it to upsample.
+ *
+ * The channels are taken together, one input or output at a time, as the
+ * counters only depend on the number of samples. The FIR and single
+ * precision IIR sums of a pair of channels share each SIMD instruction.
+ * A SIMD sum is a 64 bit value, twice which is rMAC; as in the PEQ, a coarse
+ * sum of the top bits of the products is kept, and a pair where it comes
+ * near 2^63 is done again with the scalar code before any history is
+ * written. The double precision IIR is scalar.
+ *
+ * Two stages pass a block of samples through the intermediate buffer. The
+ * DSP runs the first stage on the whole input before the second, but as a
+ * stage keeps all of its state from one call to the next, the output is
+ * the same.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "audio_proc_host_private.h"
+#include "audio_proc_host_simd.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Words of iir_resampler_definition before the first stage */
+#define DEF_INT_RATIO       0
+#define DEF_FRAC_RATIO      1
+#define DEF_STAGE1          4
+
+/** Words of iir_resampler_stage_definition. The FIR upsample stage has no
+    output scale, and ends at its frac_ratio. */
+#define STAGE_FUNCTION      0
+#define STAGE_FIR_SIZE      1
+#define STAGE_IIR_SIZE      2
+#define STAGE_ROUT          3
+#define STAGE_INPUT_SCALE   4
+#define STAGE_OUTPUT_SCALE  5
+#define STAGE_FIR           6
+#define STAGE_FRAC_RATIO    7
+#define STAGE_INT_RATIO     8
+#define STAGE_IIR_FUNCTION  9
+#define STAGE_IIR_COEFFS    10
+#define FIR_STAGE_FIR       5
+#define FIR_STAGE_FRAC_RATIO 6
+#define FIR_STAGE_WORDS     7
+
+/** FIR taps of the FIR upsample stage */
+#define FIR_STAGE_SIZE      6
+
+/** Coarse sums are of products shifted down 35 bits. Eleven products within
+    this limit are within +-(2^63 - 2^37). */
+#define EST_SHIFT           35
+#define EST_LIMIT           ((1 << 28) - 16)
+
+/** The SIMD loops take shifts of sums, as rMAC holding twice the sum, by
+    1 to 62 bits, and round by adding 2^(shift - 1) for shifts up to 35 */
+#define MIN_SIMD_SHIFT      1
+#define MAX_SIMD_SHIFT      62
+#define MAX_SIMD_ROUND_SHIFT 35
+
+/** IIR section scales the SIMD loops take */
+#define MAX_SIMD_IIR_SCALE  7
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** An IIR function of iir_resamplev2_common.asm */
+typedef struct
+{
+    unsigned order;
+    unsigned num_sections;
+    unsigned taps[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS];
+} iir_function;
+
+/****************************************************************************
+Private Variable Definitions
+*/
+
+/** The IIR functions in the order of iir_resampler_function_table */
+static const iir_function iir_functions[] =
+{
+    {19, 2, {10, 9}},               /* iir_19_s2 */
+    {19, 3, {7, 6, 6}},             /* iir_19_s3 */
+    {19, 4, {6, 5, 4, 4}},          /* iir_19_s4 */
+    {19, 5, {4, 4, 4, 4, 3}},       /* iir_19_s5 */
+    {15, 3, {6, 5, 4}},             /* iir_15_s3 */
+    {15, 2, {8, 7}},                /* iir_15_s2 */
+    {9, 2, {5, 4}}                  /* iir_9_s2 */
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Fraction of the phase step for a counter, as the stage functions take it:
+   counter * frac_ratio as an unsigned product, brought back into range */
+static inline int32_t counter_fraction(const audio_proc_host_iir_resampler_stage *st, unsigned counter)
+{
+    int32_t r2 = (int32_t)(counter * (uint32_t)st->frac_ratio);
+
+    if (r2 < 0)
+    {
+        r2 += INT32_MAX;
+    }
+    return r2;
+}
+
+static inline unsigned counter_phase(const audio_proc_host_iir_resampler_stage *st, int32_t fraction)
+{
+    return (unsigned)kal_frac_mult(fraction, (int32_t)st->rout);
+}
+
+/* Last scale of the IIR coefficients, which the upsample output takes */
+static inline int iir_last_scale(const audio_proc_host_iir_resampler_stage *st)
+{
+    return st->iir[st->iir_order + 2 * st->num_sections - 1];
+}
+
+/* Write a sample to the FIR ring of each channel. fir_pos is then the
+   oldest sample, where a sum starts. */
+static void fir_write(audio_proc_host_iir_resampler_stage *st, unsigned num_channels, const int32_t *x)
+{
+    unsigned pos = st->fir_pos;
+
+    memcpy(st->fir_history[pos], x, num_channels * sizeof(int32_t));
+    memcpy(st->fir_history[pos + st->fir_size], x, num_channels * sizeof(int32_t));
+    st->fir_pos = (pos + 1 == st->fir_size) ? 0 : pos + 1;
+}
+
+/* FIR sum of one channel at a phase. The second half of the taps takes the
+   coefficients from the end of the table back. */
+static kal_rmac fir_sum(const audio_proc_host_iir_resampler_stage *st, unsigned phase, unsigned ch)
+{
+    const int32_t (*x)[AUDIO_PROC_HOST_MAX_CHANNELS] = &st->fir_history[st->fir_pos];
+    unsigned half = st->fir_size / 2;
+    unsigned k;
+    kal_rmac acc = 0;
+
+    for (k = 0; k < half; k++)
+    {
+        acc += KAL_MAC(st->fir[phase + k * st->rout], x[k][ch]);
+    }
+    for (k = 0; k < half; k++)
+    {
+        acc += KAL_MAC(st->fir[(half - k) * st->rout - 1 - phase], x[half + k][ch]);
+    }
+    return acc;
+}
+
+/* Ring position of each section output: after the taps the section reads,
+   which are the oldest taps of the next section, and the last at the start
+   of the ring, which then moves on */
+static inline unsigned iir_write_pos(const audio_proc_host_iir_resampler_stage *st, unsigned offset)
+{
+    unsigned pos = st->iir_pos + offset;
+
+    return (pos >= st->iir_order) ? pos - st->iir_order : pos;
+}
+
+static void iir_write(audio_proc_host_iir_resampler_stage *st, unsigned ch, const int32_t *y)
+{
+    unsigned offset = 0;
+    unsigned k;
+
+    for (k = 0; k < st->num_sections; k++)
+    {
+        unsigned pos;
+
+        offset += st->taps[k];
+        pos = iir_write_pos(st, offset);
+        st->iir_history[pos][ch] = st->iir_history[pos + st->iir_order][ch] = y[k];
+    }
+}
+
+static void iir_write_low(audio_proc_host_iir_resampler_stage *st, unsigned ch, const uint32_t *y)
+{
+    unsigned offset = 0;
+    unsigned k;
+
+    for (k = 0; k < st->num_sections; k++)
+    {
+        unsigned pos;
+
+        offset += st->taps[k];
+        pos = iir_write_pos(st, offset);
+        st->iir_history_low[pos][ch] = st->iir_history_low[pos + st->iir_order][ch] = y[k];
+    }
+}
+
+static inline void iir_next(audio_proc_host_iir_resampler_stage *st)
+{
+    st->iir_pos = (st->iir_pos + 1 == st->iir_order) ? 0 : st->iir_pos + 1;
+}
+
+/* Single precision IIR of one channel, as iir_19_s2 and the others. Each
+   section is
+
+       acc = c0 in - c1 h(n-T) - ... - cT h(n-1)
+       acc = acc << scale
+
+   and its output R(acc) is the input of the next. The outputs are written
+   once all have been read. Returns the acc of the last section. */
+static kal_rmac iir_single(audio_proc_host_iir_resampler_stage *st, unsigned ch, int32_t in)
+{
+    int32_t y[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS];
+    const int32_t *c = st->iir;
+    unsigned row = st->iir_pos;
+    kal_rmac acc = 0;
+    unsigned k, j;
+
+    for (k = 0; k < st->num_sections; k++)
+    {
+        unsigned taps = st->taps[k];
+
+        acc = KAL_MAC(in, c[0]);
+        for (j = 0; j < taps; j++)
+        {
+            acc -= KAL_MAC(st->iir_history[row + j][ch], c[1 + j]);
+        }
+        acc = kal_rmac_ashift(acc, c[taps + 1]);
+        in = y[k] = kal_rmac_store(acc);
+        c += taps + 2;
+        row += taps;
+    }
+    iir_write(st, ch, y);
+    return acc;
+}
+
+/* Double precision IIR of one channel, as iir_19_s2_dp and the others. The
+   input and the history have a high and a low word; the products of the
+   low words are summed first, with the coefficients as signed and the low
+   words as unsigned, and shifted down a word before the products of the
+   high words are added. */
+static kal_rmac iir_double(audio_proc_host_iir_resampler_stage *st, unsigned ch, kal_rmac in)
+{
+    int32_t y[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS] = {0};
+    uint32_t y_low[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS] = {0};
+    const int32_t *c = st->iir;
+    unsigned row = st->iir_pos;
+    kal_rmac x = kal_rmac_ashift(in, st->in_shift);
+    kal_rmac acc = x;
+    unsigned k, j;
+
+    for (k = 0; k < st->num_sections; k++)
+    {
+        unsigned taps = st->taps[k];
+
+        acc = KAL_MAC_SU(c[0], kal_rmac_low(x));
+        for (j = 0; j < taps; j++)
+        {
+            acc -= KAL_MAC_SU(c[1 + j], st->iir_history_low[row + j][ch]);
+        }
+        acc = kal_rmac_ashift(acc, -32);
+        acc += KAL_MAC(kal_rmac_high(x), c[0]);
+        for (j = 0; j < taps; j++)
+        {
+            acc -= KAL_MAC(st->iir_history[row + j][ch], c[1 + j]);
+        }
+        acc = kal_rmac_ashift(acc, c[taps + 1]);
+        y_low[k] = kal_rmac_low(acc);
+        y[k] = kal_rmac_high(acc);
+        x = acc;
+        c += taps + 2;
+        row += taps;
+    }
+    iir_write(st, ch, y);
+    iir_write_low(st, ch, y_low);
+    return acc;
+}
+
+/* Upsample output of one channel at a phase: the FIR output shifted by r8,
+   or for the IIR upsample stage the FIR sum through the IIR, then rounded */
+static int32_t upsample_output_scalar(audio_proc_host_iir_resampler_stage *st, unsigned phase, unsigned ch,
+                                      int dbl_precision)
+{
+    kal_rmac acc = fir_sum(st, phase, ch);
+
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE)
+    {
+        return kal_rmac_to_reg(acc, st->out_shift);
+    }
+    if (dbl_precision)
+    {
+        acc = iir_double(st, ch, acc);
+    }
+    else
+    {
+        acc = iir_single(st, ch, kal_rmac_to_reg(acc, st->in_shift));
+    }
+    return kal_rmac_store(kal_rmac_ashift(acc, st->out_shift));
+}
+
+/* Downsample input of one channel: the IIR output that goes to the FIR */
+static int32_t downsample_input_scalar(audio_proc_host_iir_resampler_stage *st, unsigned ch, int32_t x,
+                                       int dbl_precision)
+{
+    kal_rmac acc;
+
+    if (dbl_precision)
+    {
+        acc = iir_double(st, ch, (kal_rmac)x * ((kal_rmac)1 << 32));
+    }
+    else
+    {
+        acc = iir_single(st, ch, kal_ashift32(x, st->in_shift));
+    }
+    return kal_rmac_store(acc);
+}
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+
+/* FIR sums of channels ch and ch + 1. Returns zero if a sum may be out of
+   range. */
+static inline int fir_sum_pair(const audio_proc_host_iir_resampler_stage *st, unsigned phase, unsigned ch,
+                               acc2 *sum)
+{
+    const int32_t (*x)[AUDIO_PROC_HOST_MAX_CHANNELS] = &st->fir_history[st->fir_pos];
+    unsigned half = st->fir_size / 2;
+    acc2 s = acc2_dup(0);
+    est2 e = vec2_dup(0);
+    unsigned k;
+
+    for (k = 0; k < half; k++)
+    {
+        acc2 p = acc2_mul(vec2_load(&x[k][ch]), vec2_dup(st->fir[phase + k * st->rout]));
+
+        s = acc2_add(s, p);
+        e = est2_add(e, est2_product(p, EST_SHIFT));
+    }
+    for (k = 0; k < half; k++)
+    {
+        acc2 p = acc2_mul(vec2_load(&x[half + k][ch]), vec2_dup(st->fir[(half - k) * st->rout - 1 - phase]));
+
+        s = acc2_add(s, p);
+        e = est2_add(e, est2_product(p, EST_SHIFT));
+    }
+    *sum = s;
+    return !est2_out_of_range(e, EST_LIMIT);
+}
+
+/* R(sum << (31 - shift)) as rMAC of twice the sum */
+static inline vec2 acc2_round(acc2 sum, int shift)
+{
+    return acc2_shift_sat(acc2_add(sum, acc2_dup((int64_t)1 << (shift - 1))), shift);
+}
+
+/* Single precision IIR of channels ch and ch + 1. Returns zero, with
+   nothing written, if a sum may be out of range; otherwise the sum of the
+   last section before its scale and the output of the last section. */
+static int iir_single_pair(audio_proc_host_iir_resampler_stage *st, unsigned ch, vec2 in, acc2 *last,
+                           vec2 *out)
+{
+    vec2 y[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS];
+    int32_t y0[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS];
+    int32_t y1[AUDIO_PROC_HOST_IIR_RESAMPLER_MAX_SECTIONS];
+    const int32_t *c = st->iir;
+    unsigned row = st->iir_pos;
+    acc2 s = acc2_dup(0);
+    unsigned k, j;
+
+    for (k = 0; k < st->num_sections; k++)
+    {
+        unsigned taps = st->taps[k];
+        est2 e;
+
+        s = acc2_mul(in, vec2_dup(c[0]));
+        e = est2_product(s, EST_SHIFT);
+        for (j = 0; j < taps; j++)
+        {
+            acc2 p = acc2_mul(vec2_load(&st->iir_history[row + j][ch]), vec2_dup(c[1 + j]));
+
+            s = acc2_sub(s, p);
+            e = est2_sub(e, est2_product(p, EST_SHIFT));
+        }
+        if (est2_out_of_range(e, EST_LIMIT))
+        {
+            return 0;
+        }
+        in = y[k] = acc2_round(s, 31 - c[taps + 1]);
+        c += taps + 2;
+        row += taps;
+    }
+    for (k = 0; k < st->num_sections; k++)
+    {
+        y0[k] = vec2_lane(y[k], 0);
+        y1[k] = vec2_lane(y[k], 1);
+    }
+    iir_write(st, ch, y0);
+    iir_write(st, ch + 1, y1);
+    *last = s;
+    *out = in;
+    return 1;
+}
+
+/* Upsample outputs of channels ch and ch + 1 */
+static void upsample_output_pair(audio_proc_host_iir_resampler_stage *st, unsigned phase, unsigned ch,
+                                 int dbl_precision, int32_t *out)
+{
+    acc2 sum, last;
+    vec2 y;
+
+    if (!fir_sum_pair(st, phase, ch, &sum))
+    {
+        out[ch] = upsample_output_scalar(st, phase, ch, dbl_precision);
+        out[ch + 1] = upsample_output_scalar(st, phase, ch + 1, dbl_precision);
+        return;
+    }
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE)
+    {
+        vec2_store(&out[ch], acc2_shift_sat(sum, 31 - st->out_shift));
+        return;
+    }
+    if (dbl_precision)
+    {
+        int64_t lanes[2];
+        unsigned lane;
+
+        acc2_store(lanes, sum);
+        for (lane = 0; lane < 2; lane++)
+        {
+            kal_rmac acc = iir_double(st, ch + lane, (kal_rmac)lanes[lane] * 2);
+
+            out[ch + lane] = kal_rmac_store(kal_rmac_ashift(acc, st->out_shift));
+        }
+        return;
+    }
+    if (!st->simd_iir || !iir_single_pair(st, ch, acc2_shift_sat(sum, 31 - st->in_shift), &last, &y))
+    {
+        out[ch] = upsample_output_scalar(st, phase, ch, 0);
+        out[ch + 1] = upsample_output_scalar(st, phase, ch + 1, 0);
+        return;
+    }
+    vec2_store(&out[ch], acc2_round(last, 31 - iir_last_scale(st) - st->out_shift));
+}
+
+/* Downsample FIR inputs of channels ch and ch + 1 */
+static void downsample_input_pair(audio_proc_host_iir_resampler_stage *st, unsigned ch, const int32_t *x,
+                                  int32_t *v)
+{
+    acc2 last;
+    vec2 y;
+
+    if (iir_single_pair(st, ch, vec2_ashift_sat(vec2_load(&x[ch]), st->in_shift), &last, &y))
+    {
+        vec2_store(&v[ch], y);
+        return;
+    }
+    v[ch] = downsample_input_scalar(st, ch, x[ch], 0);
+    v[ch + 1] = downsample_input_scalar(st, ch + 1, x[ch + 1], 0);
+}
+
+/* Downsample outputs of channels ch and ch + 1 */
+static void downsample_output_pair(const audio_proc_host_iir_resampler_stage *st, unsigned phase, unsigned ch,
+                                   int32_t *out)
+{
+    acc2 sum;
+
+    if (fir_sum_pair(st, phase, ch, &sum))
+    {
+        vec2_store(&out[ch], acc2_shift_sat(sum, 31 - st->out_shift));
+        return;
+    }
+    out[ch] = kal_rmac_to_reg(fir_sum(st, phase, ch), st->out_shift);
+    out[ch + 1] = kal_rmac_to_reg(fir_sum(st, phase, ch + 1), st->out_shift);
+}
+
+#endif
+
+/* One output of each channel of an upsample stage */
+static void upsample_outputs(audio_proc_host_iir_resampler *rs, audio_proc_host_iir_resampler_stage *st,
+                             unsigned phase, int32_t *out)
+{
+    unsigned ch = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    if (audio_proc_host_simd_enabled && st->simd_fir)
+    {
+        for (; ch + 2 <= rs->num_channels; ch += 2)
+        {
+            upsample_output_pair(st, phase, ch, rs->dbl_precision, out);
+        }
+    }
+#endif
+    for (; ch < rs->num_channels; ch++)
+    {
+        out[ch] = upsample_output_scalar(st, phase, ch, rs->dbl_precision);
+    }
+    if (st->iir_order)
+    {
+        iir_next(st);
+    }
+}
+
+/* One input of each channel of a downsample stage */
+static void downsample_inputs(audio_proc_host_iir_resampler *rs, audio_proc_host_iir_resampler_stage *st,
+                              const int32_t *x)
+{
+    int32_t v[AUDIO_PROC_HOST_MAX_CHANNELS];
+    unsigned ch = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    if (audio_proc_host_simd_enabled && st->simd_iir && !rs->dbl_precision)
+    {
+        for (; ch + 2 <= rs->num_channels; ch += 2)
+        {
+            downsample_input_pair(st, ch, x, v);
+        }
+    }
+#endif
+    for (; ch < rs->num_channels; ch++)
+    {
+        v[ch] = downsample_input_scalar(st, ch, x[ch], rs->dbl_precision);
+    }
+    iir_next(st);
+    fir_write(st, rs->num_channels, v);
+}
+
+/* One output of each channel of a downsample stage */
+static void downsample_outputs(const audio_proc_host_iir_resampler *rs, const audio_proc_host_iir_resampler_stage *st,
+                               unsigned phase, int32_t *out)
+{
+    unsigned ch = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    if (audio_proc_host_simd_enabled && st->simd_fir)
+    {
+        for (; ch + 2 <= rs->num_channels; ch += 2)
+        {
+            downsample_output_pair(st, phase, ch, out);
+        }
+    }
+#endif
+    for (; ch < rs->num_channels; ch++)
+    {
+        out[ch] = kal_rmac_to_reg(fir_sum(st, phase, ch), st->out_shift);
+    }
+}
+
+/* The upsample stage functions: each input is followed by outputs until the
+   fraction of the counter is below frac_ratio */
+static unsigned upsample_stage(audio_proc_host_iir_resampler *rs, audio_proc_host_iir_resampler_stage *st,
+                               const int32_t *input, int32_t *output, unsigned samples)
+{
+    unsigned num_channels = rs->num_channels;
+    unsigned counter = st->counter;
+    int32_t fraction = counter_fraction(st, counter);
+    unsigned phase = counter_phase(st, fraction);
+    unsigned produced = 0;
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        fir_write(st, num_channels, &input[i * num_channels]);
+        do
+        {
+            counter++;
+            upsample_outputs(rs, st, phase, &output[produced * num_channels]);
+            produced++;
+            if (counter >= st->rout)
+            {
+                counter = 0;
+            }
+            fraction = counter_fraction(st, counter);
+            phase = counter_phase(st, fraction);
+        } while (st->frac_ratio <= fraction);
+    }
+    st->counter = counter;
+    return produced;
+}
+
+/* The downsample stage function: each output takes int_ratio inputs, or
+   one more where the fraction of the counter is below frac_ratio. Inputs
+   left at the end go into the history, and partial is what the next
+   output still needs. */
+static unsigned downsample_stage(audio_proc_host_iir_resampler *rs, audio_proc_host_iir_resampler_stage *st,
+                                 const int32_t *input, int32_t *output, unsigned samples)
+{
+    unsigned num_channels = rs->num_channels;
+    unsigned counter = (st->counter >= st->rout) ? 0 : st->counter;
+    int32_t fraction = counter_fraction(st, counter);
+    int need = st->int_ratio + (st->frac_ratio > fraction);
+    int remaining;
+    unsigned produced = 0;
+    unsigned in = 0;
+    int k;
+
+    if (st->partial)
+    {
+        need = (int)st->partial;
+    }
+    remaining = (int)samples - need;
+    while (remaining >= 0)
+    {
+        unsigned phase = counter_phase(st, fraction);
+
+        for (k = 0; k < need; k++)
+        {
+            downsample_inputs(rs, st, &input[in++ * num_channels]);
+        }
+        counter++;
+        downsample_outputs(rs, st, phase, &output[produced++ * num_channels]);
+        if (counter >= st->rout)
+        {
+            counter = 0;
+        }
+        fraction = counter_fraction(st, counter);
+        need = st->int_ratio + (st->frac_ratio > fraction);
+        remaining -= need;
+    }
+
+    st->partial = 0;
+    if (need + remaining != 0)
+    {
+        for (k = 0; k < need + remaining; k++)
+        {
+            downsample_inputs(rs, st, &input[in++ * num_channels]);
+        }
+        st->partial = (unsigned)-remaining;
+    }
+    st->counter = counter;
+    return produced;
+}
+
+static unsigned run_stage(audio_proc_host_iir_resampler *rs, audio_proc_host_iir_resampler_stage *st,
+                          const int32_t *input, int32_t *output, unsigned samples)
+{
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_DOWNSAMPLE)
+    {
+        return downsample_stage(rs, st, input, output, samples);
+    }
+    return upsample_stage(rs, st, input, output, samples);
+}
+
+/* Most outputs of a stage for one input */
+static unsigned stage_bound(const audio_proc_host_iir_resampler_stage *st)
+{
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_DOWNSAMPLE)
+    {
+        return 1;
+    }
+    return (unsigned)(0x80000000u / (uint32_t)st->frac_ratio) + 1;
+}
+
+/* Unpack a stage definition from word pos of the filter, and move pos past
+   it. Returns zero if it is not a stage the assembly can run. */
+static int load_stage(audio_proc_host_iir_resampler_stage *st, const audio_proc_host_iir_resampler_coefs *coefs,
+                      const audio_proc_host_iir_resampler_module *filter, unsigned *pos)
+{
+    const int32_t *w = &filter->words[*pos];
+    const int *refs = &filter->refs[*pos];
+    unsigned left = filter->num_words - *pos;
+    unsigned fir_word;
+    unsigned counter;
+    int ref;
+
+    memset(st, 0, sizeof(*st));
+    if (*pos >= filter->num_words || left < FIR_STAGE_WORDS)
+    {
+        return 0;
+    }
+    st->function = (audio_proc_host_iir_resampler_function)w[STAGE_FUNCTION];
+    st->fir_size = (unsigned)w[STAGE_FIR_SIZE];
+    st->rout = (unsigned)w[STAGE_ROUT];
+    st->input_scale = w[STAGE_INPUT_SCALE];
+
+    switch (w[STAGE_FUNCTION])
+    {
+        case AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE:
+            if (w[STAGE_FIR_SIZE] != FIR_STAGE_SIZE || w[STAGE_IIR_SIZE] != 0)
+            {
+                return 0;
+            }
+            st->frac_ratio = w[FIR_STAGE_FRAC_RATIO];
+            fir_word = FIR_STAGE_FIR;
+            *pos += FIR_STAGE_WORDS;
+            break;
+
+        case AUDIO_PROC_HOST_IIR_RESAMPLER_UPSAMPLE:
+        case AUDIO_PROC_HOST_IIR_RESAMPLER_DOWNSAMPLE:
+        {
+            const iir_function *iir;
+            unsigned words;
+
+            if (left < STAGE_IIR_COEFFS || w[STAGE_FIR_SIZE] != AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_SIZE
+                || w[STAGE_IIR_FUNCTION] < 0
+                || w[STAGE_IIR_FUNCTION] >= (int32_t)(sizeof(iir_functions) / sizeof(iir_functions[0])))
+            {
+                return 0;
+            }
+            iir = &iir_functions[w[STAGE_IIR_FUNCTION]];
+            words = STAGE_IIR_COEFFS + iir->order + 2 * iir->num_sections;
+            if (w[STAGE_IIR_SIZE] != (int32_t)iir->order || left < words)
+            {
+                return 0;
+            }
+            st->output_scale = w[STAGE_OUTPUT_SCALE];
+            st->frac_ratio = w[STAGE_FRAC_RATIO];
+            st->int_ratio = w[STAGE_INT_RATIO];
+            st->iir_order = iir->order;
+            st->num_sections = iir->num_sections;
+            memcpy(st->taps, iir->taps, sizeof(st->taps));
+            st->iir = &w[STAGE_IIR_COEFFS];
+            fir_word = STAGE_FIR;
+            *pos += words;
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    ref = refs[fir_word];
+    if (ref < 0 || w[STAGE_ROUT] < 1
+        || coefs->modules[ref].num_words < st->fir_size / 2 * st->rout)
+    {
+        return 0;
+    }
+    st->fir = coefs->modules[ref].words;
+
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_DOWNSAMPLE ? st->int_ratio < 1 || st->frac_ratio < 0
+                                                                 : st->frac_ratio <= 0)
+    {
+        return 0;
+    }
+    for (counter = 0; counter < st->rout; counter++)
+    {
+        if (counter_phase(st, counter_fraction(st, counter)) >= st->rout)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int simd_shift(int shift)
+{
+    return shift >= MIN_SIMD_SHIFT && shift <= MAX_SIMD_SHIFT;
+}
+
+/* Set the shifts of a stage from the scales it is given, r2 and r3 of the
+   stage function, and whether the SIMD loops can take them */
+static void set_shifts(audio_proc_host_iir_resampler_stage *st, int in, int out)
+{
+    const int32_t *c = st->iir;
+    unsigned k;
+
+    st->in_shift = st->input_scale + in;
+    st->out_shift = st->output_scale + out;
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_FIR_UPSAMPLE)
+    {
+        st->out_shift = st->input_scale + in;
+    }
+    st->simd_fir = simd_shift(31 - st->out_shift)
+                   || st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_UPSAMPLE;
+    if (!st->iir_order)
+    {
+        return;
+    }
+
+    /* the scale of each section follows its taps */
+    st->simd_iir = 1;
+    for (k = 0; k < st->num_sections; k++)
+    {
+        c += st->taps[k] + 2;
+        if (c[-1] < 0 || c[-1] > MAX_SIMD_IIR_SCALE)
+        {
+            st->simd_iir = 0;
+        }
+    }
+    if (st->function == AUDIO_PROC_HOST_IIR_RESAMPLER_UPSAMPLE)
+    {
+        int last = 31 - iir_last_scale(st) - st->out_shift;
+
+        if (!simd_shift(31 - st->in_shift) || last < MIN_SIMD_SHIFT || last > MAX_SIMD_ROUND_SHIFT)
+        {
+            st->simd_iir = 0;
+        }
+    }
+    else if (st->in_shift < -31 || st->in_shift > 30)
+    {
+        st->simd_iir = 0;
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int audio_proc_host_iir_resampler_init(audio_proc_host_iir_resampler *rs,
+                                       const audio_proc_host_iir_resampler_coefs *coefs,
+                                       const audio_proc_host_iir_resampler_module *filter,
+                                       unsigned num_channels, int input_scale, int output_scale,
+                                       int dbl_precision)
+{
+    unsigned pos = DEF_STAGE1;
+
+    memset(rs, 0, sizeof(*rs));
+    rs->num_channels = num_channels;
+    rs->input_scale = input_scale;
+    rs->output_scale = output_scale;
+    rs->dbl_precision = dbl_precision;
+    if (num_channels < 1 || num_channels > AUDIO_PROC_HOST_MAX_CHANNELS)
+    {
+        return 0;
+    }
+    if (filter == NULL)
+    {
+        return 1;
+    }
+    if (filter->num_words <= DEF_STAGE1)
+    {
+        return 0;
+    }
+    rs->int_ratio = filter->words[DEF_INT_RATIO];
+    rs->frac_ratio = filter->words[DEF_FRAC_RATIO];
+
+    if (filter->words[DEF_STAGE1] == AUDIO_PROC_HOST_IIR_RESAMPLER_NONE)
+    {
+        pos++;
+    }
+    else
+    {
+        if (!load_stage(&rs->stages[0], coefs, filter, &pos))
+        {
+            return 0;
+        }
+        rs->num_stages = 1;
+    }
+    if (!load_stage(&rs->stages[rs->num_stages], coefs, filter, &pos))
+    {
+        rs->num_stages = 0;
+        return 0;
+    }
+    rs->num_stages++;
+
+    if (rs->num_stages == 2)
+    {
+        set_shifts(&rs->stages[0], input_scale, 0);
+        set_shifts(&rs->stages[1], 0, output_scale);
+    }
+    else
+    {
+        set_shifts(&rs->stages[0], input_scale, output_scale);
+    }
+
+    rs->block = AUDIO_PROC_HOST_IIR_RESAMPLER_INTERMEDIATE / stage_bound(&rs->stages[0]);
+    if (rs->block == 0 || (rs->int_ratio == 0 && rs->frac_ratio <= 0))
+    {
+        rs->num_stages = 0;
+        return 0;
+    }
+    audio_proc_host_iir_resampler_reset(rs);
+    return 1;
+}
+
+void audio_proc_host_iir_resampler_reset(audio_proc_host_iir_resampler *rs)
+{
+    unsigned i;
+
+    for (i = 0; i < rs->num_stages; i++)
+    {
+        audio_proc_host_iir_resampler_stage *st = &rs->stages[i];
+
+        st->partial = 0;
+        st->counter = 0;
+        st->fir_pos = 0;
+        st->iir_pos = 0;
+        memset(st->iir_history, 0, sizeof(st->iir_history));
+        memset(st->iir_history_low, 0, sizeof(st->iir_history_low));
+    }
+}
+
+unsigned audio_proc_host_iir_resampler_max_output(const audio_proc_host_iir_resampler *rs, unsigned samples)
+{
+    uint64_t bound = samples;
+    unsigned i;
+
+    /* each stage gives at most its ratio of the samples, rounded up, and
+       one more for the phase it starts at */
+    for (i = 0; i < rs->num_stages; i++)
+    {
+        const audio_proc_host_iir_resampler_stage *st = &rs->stages[i];
+        uint64_t ratio = ((uint64_t)st->int_ratio << 31) + (uint64_t)st->frac_ratio;
+
+        bound = (bound << 31) / ratio + 2;
+    }
+    return (unsigned)bound;
+}
+
+unsigned audio_proc_host_iir_resampler_process(audio_proc_host_iir_resampler *rs, const int32_t *input,
+                                               int32_t *output, unsigned samples)
+{
+    unsigned num_channels = rs->num_channels;
+    unsigned produced = 0;
+    unsigned done;
+
+    if (rs->num_stages == 0)
+    {
+        int shift = rs->input_scale + rs->output_scale;
+        unsigned total = samples * num_channels;
+        unsigned i;
+
+        for (i = 0; i < total; i++)
+        {
+            output[i] = kal_rmac_store(kal_rmac_ashift((kal_rmac)input[i] * ((kal_rmac)1 << 32), shift));
+        }
+        return samples;
+    }
+    if (rs->num_stages == 1)
+    {
+        return run_stage(rs, &rs->stages[0], input, output, samples);
+    }
+
+    for (done = 0; done < samples; done += rs->block)
+    {
+        unsigned n = (samples - done < rs->block) ? samples - done : rs->block;
+        unsigned mid = run_stage(rs, &rs->stages[0], &input[done * num_channels], rs->intermediate, n);
+
+        produced += run_stage(rs, &rs->stages[1], rs->intermediate, &output[produced * num_channels], mid);
+    }
+    return produced;
+}
@@ -0,0 +1,573 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_iir_resampler_coefs.c
+ * \ingroup audio_proc
+ *
+ * Reader of the resampler coefficient files, iir_resamplev2_coefs.dyn and
+ * iir_resamplev2_coefs_low_mips.dyn. <br>
+ *
+ * The files are assembler source. Each .MODULE becomes the words of its
+ * .VAR statements, in order, as the assembler lays them out: a value with
+ * a decimal point is fractional and rounds to the nearest Q31 word, other
+ * numbers are integers, a $iir_resamplerv2_common constant is its enum
+ * value and &$M.iir_resamplev2.x.coeffs is the address of module x.
+ * Preprocessor lines are skipped, apart from #include of another .dyn
+ * file, so the KYMERA dynamic memory tables are read as well; a module
+ * with values that are none of these, such as DynTable_Main, is dropped.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_proc_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Prefix of the module names */
+#define MODULE_PREFIX       "$M.iir_resamplev2."
+
+/** Prefix of the function constants */
+#define CONSTANT_PREFIX     "$iir_resamplerv2_common."
+
+/** Deepest #include */
+#define MAX_INCLUDE_DEPTH   4
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** A word that is the address of a module, found before that module */
+typedef struct
+{
+    unsigned module;
+    unsigned word;
+    char name[AUDIO_PROC_HOST_IIR_RESAMPLER_NAME_SIZE];
+} pending_ref;
+
+typedef struct
+{
+    audio_proc_host_iir_resampler_coefs *coefs;
+    pending_ref *refs;
+    unsigned num_refs;
+    int module;                     /**< module being read, or -1 */
+    int dropped;                    /**< the module has a value that is not understood */
+} reader;
+
+/****************************************************************************
+Private Variable Definitions
+*/
+
+/** Values of the $iir_resamplerv2_common constants, iir_function_types and
+    iir_stage_types of iir_resamplerv2_common.h */
+static const struct
+{
+    const char *name;
+    int32_t value;
+} constants[] =
+{
+    {"iir_1stStage_none", 0},
+    {"iir_1stStage_upsample", 1},
+    {"iir_2ndStage_upsample", 2},
+    {"iir_2ndStage_downsample", 3},
+    {"iir_19_s2", 0},
+    {"iir_19_s3", 1},
+    {"iir_19_s4", 2},
+    {"iir_19_s5", 3},
+    {"iir_15_s3", 4},
+    {"iir_15_s2", 5},
+    {"iir_9_s2", 6}
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+static char *read_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    char *text = NULL;
+    long size;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        text = malloc((size_t)size + 1);
+        if (text != NULL)
+        {
+            if (fread(text, 1, (size_t)size, file) != (size_t)size)
+            {
+                free(text);
+                text = NULL;
+            }
+            else
+            {
+                text[size] = '\0';
+            }
+        }
+    }
+    fclose(file);
+    return text;
+}
+
+/* Blank out comments, keeping the line breaks */
+static void strip_comments(char *text)
+{
+    char *p = text;
+
+    while (*p != '\0')
+    {
+        if (p[0] == '/' && p[1] == '/')
+        {
+            while (*p != '\0' && *p != '\n')
+            {
+                *p++ = ' ';
+            }
+        }
+        else if (p[0] == '/' && p[1] == '*')
+        {
+            *p++ = ' ';
+            *p++ = ' ';
+            while (*p != '\0' && !(p[0] == '*' && p[1] == '/'))
+            {
+                if (*p != '\n')
+                {
+                    *p = ' ';
+                }
+                p++;
+            }
+            if (*p != '\0')
+            {
+                *p++ = ' ';
+                *p++ = ' ';
+            }
+        }
+        else
+        {
+            p++;
+        }
+    }
+}
+
+static char *trim(char *s)
+{
+    char *end;
+
+    while (isspace((unsigned char)*s))
+    {
+        s++;
+    }
+    end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+    {
+        *--end = '\0';
+    }
+    return s;
+}
+
+static int starts_with(const char *s, const char *prefix)
+{
+    return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+/* Copy a name, stopping at a space or the end */
+static void copy_name(char *dst, const char *src)
+{
+    size_t n = 0;
+
+    while (src[n] != '\0' && !isspace((unsigned char)src[n]) && n + 1 < AUDIO_PROC_HOST_IIR_RESAMPLER_NAME_SIZE)
+    {
+        dst[n] = src[n];
+        n++;
+    }
+    dst[n] = '\0';
+}
+
+static int add_word(reader *r, int32_t word, int ref)
+{
+    audio_proc_host_iir_resampler_module *m = &r->coefs->modules[r->module];
+    int32_t *words = realloc(m->words, (m->num_words + 1) * sizeof(*words));
+    int *refs;
+
+    if (words == NULL)
+    {
+        return 0;
+    }
+    m->words = words;
+    refs = realloc(m->refs, (m->num_words + 1) * sizeof(*refs));
+    if (refs == NULL)
+    {
+        return 0;
+    }
+    m->refs = refs;
+    m->words[m->num_words] = word;
+    m->refs[m->num_words] = ref;
+    m->num_words++;
+    return 1;
+}
+
+/* Read one value of a .VAR list. Returns zero when out of memory. */
+static int add_value(reader *r, char *value)
+{
+    char *end;
+    unsigned i;
+
+    if (*value == '&')
+    {
+        value++;
+    }
+    if (starts_with(value, MODULE_PREFIX))
+    {
+        /* the address of the coefficients of another module */
+        pending_ref *refs = realloc(r->refs, (r->num_refs + 1) * sizeof(*refs));
+        char *dot;
+
+        if (refs == NULL)
+        {
+            return 0;
+        }
+        r->refs = refs;
+        refs[r->num_refs].module = (unsigned)r->module;
+        refs[r->num_refs].word = r->coefs->modules[r->module].num_words;
+        copy_name(refs[r->num_refs].name, value + strlen(MODULE_PREFIX));
+        dot = strchr(refs[r->num_refs].name, '.');
+        if (dot != NULL)
+        {
+            *dot = '\0';
+        }
+        r->num_refs++;
+        return add_word(r, 0, -1);
+    }
+    if (starts_with(value, CONSTANT_PREFIX))
+    {
+        for (i = 0; i < sizeof(constants) / sizeof(constants[0]); i++)
+        {
+            if (strcmp(value + strlen(CONSTANT_PREFIX), constants[i].name) == 0)
+            {
+                return add_word(r, constants[i].value, -1);
+            }
+        }
+        r->dropped = 1;
+        return 1;
+    }
+    if (strpbrk(value, ".eE") != NULL)
+    {
+        double x = strtod(value, &end);
+        double q = floor(x * 2147483648.0 + 0.5);
+
+        if (*end != '\0' || end == value)
+        {
+            r->dropped = 1;
+            return 1;
+        }
+        return add_word(r, (int32_t)(q > INT32_MAX ? INT32_MAX : q < INT32_MIN ? INT32_MIN : q), -1);
+    }
+    else
+    {
+        long x = strtol(value, &end, 0);
+
+        if (*end != '\0' || end == value)
+        {
+            r->dropped = 1;
+            return 1;
+        }
+        return add_word(r, (int32_t)x, -1);
+    }
+}
+
+/* .VAR[/segment] name[[size]] [= value, ...] */
+static int read_var(reader *r, char *statement)
+{
+    audio_proc_host_iir_resampler_module *m = &r->coefs->modules[r->module];
+    unsigned start = m->num_words;
+    char *bracket, *equals, *value;
+    unsigned size = 0;
+
+    equals = strchr(statement, '=');
+    if (equals != NULL)
+    {
+        *equals = '\0';
+    }
+    bracket = strchr(statement, '[');
+    if (bracket != NULL)
+    {
+        size = (unsigned)strtoul(bracket + 1, NULL, 0);
+    }
+    if (equals != NULL)
+    {
+        for (value = strtok(equals + 1, ","); value != NULL && !r->dropped; value = strtok(NULL, ","))
+        {
+            if (!add_value(r, trim(value)))
+            {
+                return 0;
+            }
+        }
+    }
+    else if (bracket == NULL)
+    {
+        size = 1;
+    }
+
+    /* an array with fewer values than its size is zero filled */
+    while (!r->dropped && r->coefs->modules[r->module].num_words - start < size)
+    {
+        if (!add_word(r, 0, -1))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void drop_module(reader *r)
+{
+    audio_proc_host_iir_resampler_coefs *coefs = r->coefs;
+    unsigned i = 0;
+
+    while (i < r->num_refs)
+    {
+        if (r->refs[i].module == (unsigned)r->module)
+        {
+            r->refs[i] = r->refs[--r->num_refs];
+        }
+        else
+        {
+            i++;
+        }
+    }
+    free(coefs->modules[r->module].words);
+    free(coefs->modules[r->module].refs);
+    coefs->num_modules--;
+}
+
+static int read_statement(reader *r, char *statement)
+{
+    audio_proc_host_iir_resampler_coefs *coefs = r->coefs;
+
+    statement = trim(statement);
+    if (starts_with(statement, ".MODULE"))
+    {
+        audio_proc_host_iir_resampler_module *modules;
+        char *name = trim(statement + strlen(".MODULE"));
+
+        if (r->module >= 0 && r->dropped)
+        {
+            drop_module(r);
+        }
+        modules = realloc(coefs->modules, (coefs->num_modules + 1) * sizeof(*modules));
+        if (modules == NULL)
+        {
+            return 0;
+        }
+        coefs->modules = modules;
+        r->module = (int)coefs->num_modules++;
+        r->dropped = 0;
+        memset(&modules[r->module], 0, sizeof(modules[r->module]));
+        copy_name(modules[r->module].name, starts_with(name, MODULE_PREFIX) ? name + strlen(MODULE_PREFIX) : name);
+    }
+    else if (starts_with(statement, ".ENDMODULE"))
+    {
+        if (r->module >= 0 && r->dropped)
+        {
+            drop_module(r);
+        }
+        r->module = -1;
+    }
+    else if (starts_with(statement, ".VAR") && r->module >= 0 && !r->dropped)
+    {
+        statement += strlen(".VAR");
+        if (*statement == '/')
+        {
+            statement += strcspn(statement, " \t\r\n");
+        }
+        return read_var(r, statement);
+    }
+    return 1;
+}
+
+static int read_source(reader *r, const char *path, unsigned depth)
+{
+    char *text = read_file(path);
+    char *line, *statement, *next;
+    int ok = 1;
+
+    if (text == NULL || depth > MAX_INCLUDE_DEPTH)
+    {
+        free(text);
+        return 0;
+    }
+    strip_comments(text);
+
+    /* follow #include of .dyn files, then blank out the preprocessor lines */
+    for (line = text; ok && line != NULL && *line != '\0'; line = next)
+    {
+        char *start = line;
+
+        next = strchr(line, '\n');
+        if (next != NULL)
+        {
+            next++;
+        }
+        while (*start == ' ' || *start == '\t')
+        {
+            start++;
+        }
+        if (*start == '#')
+        {
+            char *quote = strchr(start, '"');
+            char *end = quote != NULL ? strchr(quote + 1, '"') : NULL;
+
+            if (starts_with(start, "#include") && end != NULL && end - quote > 4 &&
+                strncmp(end - 4, ".dyn", 4) == 0)
+            {
+                const char *slash = strrchr(path, '/');
+                size_t dir = slash != NULL ? (size_t)(slash - path + 1) : 0;
+                size_t name = (size_t)(end - quote - 1);
+                char *include = malloc(dir + name + 1);
+
+                if (include == NULL)
+                {
+                    ok = 0;
+                    break;
+                }
+                memcpy(include, path, dir);
+                memcpy(include + dir, quote + 1, name);
+                include[dir + name] = '\0';
+                ok = read_source(r, include, depth + 1);
+                free(include);
+            }
+            while (*start != '\0' && *start != '\n')
+            {
+                *start++ = ' ';
+            }
+        }
+    }
+
+    for (statement = text; ok && statement != NULL; statement = next)
+    {
+        next = strchr(statement, ';');
+        if (next != NULL)
+        {
+            *next++ = '\0';
+        }
+        ok = read_statement(r, statement);
+    }
+    if (ok && r->module >= 0 && r->dropped)
+    {
+        drop_module(r);
+    }
+    r->module = -1;
+    free(text);
+    return ok;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int audio_proc_host_iir_resampler_load_coefs(audio_proc_host_iir_resampler_coefs *coefs, const char *path)
+{
+    reader r;
+    unsigned i;
+    int ok;
+
+    memset(coefs, 0, sizeof(*coefs));
+    memset(&r, 0, sizeof(r));
+    r.coefs = coefs;
+    r.module = -1;
+    ok = read_source(&r, path, 0);
+
+    for (i = 0; ok && i < r.num_refs; i++)
+    {
+        const audio_proc_host_iir_resampler_module *target = audio_proc_host_iir_resampler_find(coefs, r.refs[i].name);
+
+        if (target == NULL)
+        {
+            ok = 0;
+        }
+        else
+        {
+            coefs->modules[r.refs[i].module].refs[r.refs[i].word] = (int)(target - coefs->modules);
+        }
+    }
+    free(r.refs);
+    if (!ok)
+    {
+        audio_proc_host_iir_resampler_free_coefs(coefs);
+    }
+    return ok;
+}
+
+void audio_proc_host_iir_resampler_free_coefs(audio_proc_host_iir_resampler_coefs *coefs)
+{
+    unsigned i;
+
+    for (i = 0; i < coefs->num_modules; i++)
+    {
+        free(coefs->modules[i].words);
+        free(coefs->modules[i].refs);
+    }
+    free(coefs->modules);
+    coefs->modules = NULL;
+    coefs->num_modules = 0;
+}
+
+const audio_proc_host_iir_resampler_module *audio_proc_host_iir_resampler_find(
+    const audio_proc_host_iir_resampler_coefs *coefs, const char *name)
+{
+    unsigned i;
+
+    for (i = 0; i < coefs->num_modules; i++)
+    {
+        if (strcmp(coefs->modules[i].name, name) == 0)
+        {
+            return &coefs->modules[i];
+        }
+    }
+    return NULL;
+}
+
+const audio_proc_host_iir_resampler_module *audio_proc_host_iir_resampler_find_rate(
+    const audio_proc_host_iir_resampler_coefs *coefs, unsigned in_rate, unsigned out_rate, int low_mips)
+{
+    const audio_proc_host_iir_resampler_module *filter = NULL;
+    char name[AUDIO_PROC_HOST_IIR_RESAMPLER_NAME_SIZE];
+    unsigned a = in_rate, b = out_rate;
+
+    if (in_rate == out_rate || in_rate == 0 || out_rate == 0)
+    {
+        return NULL;
+    }
+    while (b != 0)
+    {
+        unsigned t = a % b;
+
+        a = b;
+        b = t;
+    }
+    /* the Kymera build takes the low MIPS filters for 160:441 and 441:160
+       unless IIR_RESAMPLER_USE_HIGH_MIPS is defined; here they are asked for
+       like the others */
+    if (low_mips)
+    {
+        snprintf(name, sizeof(name), "Up_%u_Down_%u_low_mips", out_rate / a, in_rate / a);
+        filter = audio_proc_host_iir_resampler_find(coefs, name);
+    }
+    if (filter == NULL)
+    {
+        snprintf(name, sizeof(name), "Up_%u_Down_%u", out_rate / a, in_rate / a);
+        filter = audio_proc_host_iir_resampler_find(coefs, name);
+    }
+    return filter;
+}
@@ -0,0 +1,416 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_mixer.c
+ * \ingroup audio_proc
+ *
+ * Host port of the N x M mixer of audio_mux_NxM.asm, with the gain ramps
+ * of the mixer capability, and a sparse mode that gives the same output
+ * for a cost that follows the active routes. <br>
+ *
+ * The DSP sums every input times its mantissa in rMAC for each output
+ * sample, shifts rMAC by the output's exponent and stores it rounded. A
+ * gain transition steps every gain by its gain_adjust before each sample,
+ * for transition_count samples, and then sets it to its target, as
+ * $_gen_mixer_process_channels does. The dense mode of this port does the
+ * same, for all N x M routes.
+ *
+ * The sparse mode compiles the gain matrix when it changes. Zero gains
+ * that are not ramping are dropped. An output with one unity gain is a
+ * copy of its input. An output with fixed gains is made a block at a time,
+ * with the unity inputs summed and shifted into place and the products of
+ * the rest added in 64 bits, two samples at a time in SIMD lanes, and
+ * rounded once as the store of rMAC rounds. That is exact while the sum of
+ * the gain magnitudes, over the whole transition, leaves the 64 bit sum in
+ * range, which the compiler checks. Only the outputs with a ramping gain
+ * are made sample by sample, over their active routes, and only a sum that
+ * could leave that range is made in rMAC's width.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "audio_proc_host_private.h"
+#include "audio_proc_host_simd.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Exponents of the block sum: rMAC's shift and rounding become one right
+    shift of the 64 bit sum by 31 - exponent, which must be 1 to 62 */
+#define SUM_MIN_EXPONENT    (-31)
+#define SUM_MAX_EXPONENT    30
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Steps of the transition in a call of samples */
+static unsigned transition_steps(const audio_proc_host_mixer *mixer, unsigned samples)
+{
+    return (mixer->transition_count < samples) ? mixer->transition_count : samples;
+}
+
+/* The routes of an output. Zero gains that are not ramping are dropped,
+   unity gains come first. */
+static void compile_output(audio_proc_host_mixer *mixer, unsigned j)
+{
+    audio_proc_host_mixer_output *out = &mixer->routes[j];
+    int exponent = mixer->exponent[j];
+    int32_t unity = (exponent >= 1 && exponent <= SUM_MAX_EXPONENT) ? (int32_t)1 << (31 - exponent) : 0;
+    int ramping = 0;
+    kal_rmac magnitude = 0;
+    unsigned pass, i;
+
+    out->num_routes = 0;
+    out->num_unity = 0;
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (i = 0; i < mixer->num_inputs; i++)
+        {
+            int32_t gain = mixer->current_gain[j][i];
+            int32_t adjust = mixer->gain_adjust[j][i];
+
+            if ((gain == 0 && adjust == 0) || ((pass == 0) != (gain == unity && adjust == 0)))
+            {
+                continue;
+            }
+            out->input[out->num_routes] = i;
+            out->gain[out->num_routes] = gain;
+            out->gain_adjust[out->num_routes] = adjust;
+            out->num_routes++;
+            out->num_unity += (pass == 0);
+            ramping |= (adjust != 0);
+
+            /* the largest the gain can reach in the transition */
+            magnitude += (gain < 0) ? -(kal_rmac)gain : gain;
+            magnitude += (kal_rmac)((adjust < 0) ? -(int64_t)adjust : adjust) * mixer->transition_count;
+        }
+    }
+
+    /* The 64 bit sum is within +-2^63 while the sum of the gain magnitudes
+       times the largest input, plus the rounding, is */
+    if (out->num_routes == 0)
+    {
+        out->path = AUDIO_PROC_HOST_MIXER_SILENT;
+    }
+    else if (exponent < SUM_MIN_EXPONENT || exponent > SUM_MAX_EXPONENT ||
+             magnitude * ((kal_rmac)1 << 31) + ((kal_rmac)1 << (30 - exponent)) > INT64_MAX)
+    {
+        out->path = AUDIO_PROC_HOST_MIXER_WIDE;
+    }
+    else if (ramping)
+    {
+        out->path = AUDIO_PROC_HOST_MIXER_RAMP;
+    }
+    else if (out->num_routes == 1 && out->num_unity == 1)
+    {
+        out->path = AUDIO_PROC_HOST_MIXER_COPY;
+    }
+    else
+    {
+        out->path = AUDIO_PROC_HOST_MIXER_SUM;
+    }
+}
+
+/* Start or end a transition, as setup_mixes does after a gain change:
+   each gain_adjust is frac_mult(target - current, inv_samples_to_ramp), and
+   a gain with no adjustment goes to its target. The difference is
+   saturated, where the capability's unsigned gains cannot overflow. Then
+   compile the routes. */
+static void update_gains(audio_proc_host_mixer *mixer)
+{
+    unsigned i, j;
+
+    if (mixer->restart_transition)
+    {
+        mixer->transition_count = mixer->samples_to_ramp;
+        mixer->restart_transition = 0;
+    }
+    for (j = 0; j < mixer->num_outputs; j++)
+    {
+        for (i = 0; i < mixer->num_inputs; i++)
+        {
+            int32_t difference = kal_sat32((int64_t)mixer->target_gain[j][i] - mixer->current_gain[j][i]);
+            int32_t adjust = 0;
+
+            if (mixer->transition_count > 0)
+            {
+                adjust = kal_frac_mult(difference, mixer->inv_samples_to_ramp);
+            }
+            if (adjust == 0)
+            {
+                mixer->current_gain[j][i] = mixer->target_gain[j][i];
+            }
+            mixer->gain_adjust[j][i] = adjust;
+        }
+        compile_output(mixer, j);
+    }
+    mixer->reset_gains = 0;
+}
+
+/* One output of the DSP, over all the inputs, stepping all the gains for
+   the first steps samples */
+static void mix_dense(audio_proc_host_mixer *mixer, unsigned j, const int32_t *const *inputs, int32_t *output,
+                      unsigned samples, unsigned steps)
+{
+    int32_t *gain = mixer->current_gain[j];
+    const int32_t *adjust = mixer->gain_adjust[j];
+    unsigned n, i;
+
+    for (n = 0; n < samples; n++)
+    {
+        kal_rmac acc = 0;
+
+        for (i = 0; i < mixer->num_inputs; i++)
+        {
+            if (n < steps)
+            {
+                gain[i] = kal_sat32((int64_t)gain[i] + adjust[i]);
+            }
+            acc += KAL_MAC(inputs[i][n], gain[i]);
+        }
+        output[n] = kal_rmac_store(kal_rmac_ashift(acc, mixer->exponent[j]));
+    }
+}
+
+/* An output sample by sample, over its active routes only. The sum is
+   made as mix_sum_scalar makes it, or in rMAC for the wide path. The
+   stepped gains are kept for the next call. */
+static void mix_ramp(audio_proc_host_mixer *mixer, unsigned j, const int32_t *const *inputs, int32_t *output,
+                     unsigned samples, unsigned steps)
+{
+    audio_proc_host_mixer_output *out = &mixer->routes[j];
+    int exponent = mixer->exponent[j];
+    unsigned n, k;
+
+    for (n = 0; n < samples; n++)
+    {
+        if (n < steps)
+        {
+            for (k = 0; k < out->num_routes; k++)
+            {
+                out->gain[k] = kal_sat32((int64_t)out->gain[k] + out->gain_adjust[k]);
+            }
+        }
+        if (out->path == AUDIO_PROC_HOST_MIXER_WIDE)
+        {
+            kal_rmac acc = 0;
+
+            for (k = 0; k < out->num_routes; k++)
+            {
+                acc += KAL_MAC(inputs[out->input[k]][n], out->gain[k]);
+            }
+            output[n] = kal_rmac_store(kal_rmac_ashift(acc, exponent));
+        }
+        else
+        {
+            int64_t acc = (int64_t)1 << (30 - exponent);
+
+            for (k = 0; k < out->num_routes; k++)
+            {
+                acc += (int64_t)inputs[out->input[k]][n] * out->gain[k];
+            }
+            output[n] = kal_sat32(acc >> (31 - exponent));
+        }
+    }
+    for (k = 0; k < out->num_routes; k++)
+    {
+        mixer->current_gain[j][out->input[k]] = out->gain[k];
+    }
+}
+
+/* Samples first to samples - 1 of an output with fixed gains. rMAC holds
+   2 * sum(in * gain), and the DSP stores (rMAC ASHIFT exponent) rounded on
+   bit 31, which is the sum plus 2^(30 - exponent), shifted right by
+   31 - exponent. A unity gain is 2^(31 - exponent), so those inputs are
+   added and shifted into place together. */
+static void mix_sum_scalar(const audio_proc_host_mixer_output *out, int exponent, const int32_t *const *inputs,
+                           int32_t *output, unsigned first, unsigned samples)
+{
+    int shift = 31 - exponent;
+    int64_t half = (int64_t)1 << (shift - 1);
+    unsigned n, k;
+
+    for (n = first; n < samples; n++)
+    {
+        int64_t unity = 0;
+        int64_t acc;
+
+        for (k = 0; k < out->num_unity; k++)
+        {
+            unity += inputs[out->input[k]][n];
+        }
+        acc = unity * ((int64_t)1 << shift) + half;
+        for (k = out->num_unity; k < out->num_routes; k++)
+        {
+            acc += (int64_t)inputs[out->input[k]][n] * out->gain[k];
+        }
+        output[n] = kal_sat32(acc >> shift);
+    }
+}
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+
+/* mix_sum_scalar on two samples at a time */
+static void mix_sum_simd(const audio_proc_host_mixer_output *out, int exponent, const int32_t *const *inputs,
+                         int32_t *output, unsigned samples)
+{
+    const int32_t *in[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+    vec2 gain[AUDIO_PROC_HOST_MIXER_MAX_INPUTS];
+    int shift = 31 - exponent;
+    acc2 half = acc2_dup((int64_t)1 << (shift - 1));
+    unsigned n, k;
+
+    for (k = 0; k < out->num_routes; k++)
+    {
+        in[k] = inputs[out->input[k]];
+        gain[k] = vec2_dup(out->gain[k]);
+    }
+    for (n = 0; n + 2 <= samples; n += 2)
+    {
+        acc2 unity = acc2_dup(0);
+        acc2 acc;
+
+        for (k = 0; k < out->num_unity; k++)
+        {
+            unity = acc2_add(unity, acc2_widen(vec2_load(&in[k][n])));
+        }
+        acc = acc2_add(acc2_shl(unity, shift), half);
+        for (; k < out->num_routes; k++)
+        {
+            acc = acc2_add(acc, acc2_mul(vec2_load(&in[k][n]), gain[k]));
+        }
+        vec2_store(&output[n], acc2_shift_sat(acc, shift));
+    }
+    mix_sum_scalar(out, exponent, inputs, output, n, samples);
+}
+
+#endif
+
+/* One output from its compiled routes */
+static void mix_sparse(audio_proc_host_mixer *mixer, unsigned j, const int32_t *const *inputs, int32_t *output,
+                       unsigned samples, unsigned steps)
+{
+    const audio_proc_host_mixer_output *out = &mixer->routes[j];
+
+    switch (out->path)
+    {
+        case AUDIO_PROC_HOST_MIXER_SILENT:
+            memset(output, 0, samples * sizeof(int32_t));
+            break;
+
+        case AUDIO_PROC_HOST_MIXER_COPY:
+            memcpy(output, inputs[out->input[0]], samples * sizeof(int32_t));
+            break;
+
+        case AUDIO_PROC_HOST_MIXER_SUM:
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+            if (audio_proc_host_simd_enabled)
+            {
+                mix_sum_simd(out, mixer->exponent[j], inputs, output, samples);
+                break;
+            }
+#endif
+            mix_sum_scalar(out, mixer->exponent[j], inputs, output, 0, samples);
+            break;
+
+        default:
+            mix_ramp(mixer, j, inputs, output, samples, steps);
+            break;
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int audio_proc_host_mixer_init(audio_proc_host_mixer *mixer, unsigned num_inputs, unsigned num_outputs,
+                               int sparse)
+{
+    if (num_inputs < 1 || num_inputs > AUDIO_PROC_HOST_MIXER_MAX_INPUTS ||
+        num_outputs < 1 || num_outputs > AUDIO_PROC_HOST_MIXER_MAX_OUTPUTS)
+    {
+        return 0;
+    }
+    memset(mixer, 0, sizeof(*mixer));
+    mixer->num_inputs = num_inputs;
+    mixer->num_outputs = num_outputs;
+    mixer->sparse = sparse;
+    mixer->reset_gains = 1;
+    return 1;
+}
+
+void audio_proc_host_mixer_set_ramp(audio_proc_host_mixer *mixer, unsigned samples)
+{
+    /* pl_fractional_divide(1, samples) */
+    mixer->samples_to_ramp = samples;
+    mixer->inv_samples_to_ramp = (samples > 0) ? kal_sat32(((int64_t)1 << 31) / samples) : 0;
+}
+
+int audio_proc_host_mixer_set_exponent(audio_proc_host_mixer *mixer, unsigned output, int exponent)
+{
+    if (output >= mixer->num_outputs ||
+        exponent < AUDIO_PROC_HOST_MIXER_MIN_EXPONENT || exponent > AUDIO_PROC_HOST_MIXER_MAX_EXPONENT)
+    {
+        return 0;
+    }
+    mixer->exponent[output] = exponent;
+    mixer->reset_gains = 1;
+    return 1;
+}
+
+int audio_proc_host_mixer_set_gain(audio_proc_host_mixer *mixer, unsigned output, unsigned input, int32_t gain)
+{
+    if (output >= mixer->num_outputs || input >= mixer->num_inputs)
+    {
+        return 0;
+    }
+    mixer->target_gain[output][input] = gain;
+    if (mixer->samples_to_ramp > 0)
+    {
+        mixer->restart_transition = 1;
+    }
+    mixer->reset_gains = 1;
+    return 1;
+}
+
+void audio_proc_host_mixer_process(audio_proc_host_mixer *mixer, const int32_t *const *inputs,
+                                   int32_t *const *outputs, unsigned samples)
+{
+    unsigned steps;
+    unsigned j;
+
+    if (mixer->reset_gains)
+    {
+        update_gains(mixer);
+    }
+    steps = transition_steps(mixer, samples);
+
+    for (j = 0; j < mixer->num_outputs; j++)
+    {
+        if (mixer->sparse)
+        {
+            mix_sparse(mixer, j, inputs, outputs[j], samples, steps);
+        }
+        else
+        {
+            mix_dense(mixer, j, inputs, outputs[j], samples, steps);
+        }
+    }
+
+    /* End of the transition: the gains go to their targets and the routes
+       are compiled again */
+    if (mixer->transition_count > 0)
+    {
+        mixer->transition_count -= steps;
+        if (mixer->transition_count == 0)
+        {
+            memcpy(mixer->current_gain, mixer->target_gain, sizeof(mixer->current_gain));
+            mixer->reset_gains = 1;
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_peak_monitor.c
+ * \ingroup audio_proc
+ *
+ * Host port of the peak monitor of peak_monitor.asm, with an RMS level
+ * taken in the same pass. <br>
+ *
+ * The DSP keeps the largest ABS of the samples of each frame in
+ * PEAK_LEVEL, until the owner clears it. ABS saturates the most negative
+ * value. The port does the same, and adds each sample's square, as a
+ * fraction truncated to 31 bits, to a 64 bit sum for the mean square. Both
+ * are exact integers, so a block can be taken in any order (squares below
+ * 2^-31, of samples under about -93 dBFS, count as zero): the SIMD loop takes
+ * four samples at a time, keeps a peak and two sums in each lane, and
+ * combines them at the end of the block.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <math.h>
+#include "audio_proc_host_private.h"
+#include "audio_proc_host_simd.h"
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+#if defined(AUDIO_PROC_HOST_SSE4_1)
+
+/* Peak and sum of squares of n samples, n a multiple of 4 */
+static int32_t peak_block_simd(const int32_t *in, unsigned n, int32_t peak, uint64_t *sum_squares)
+{
+    __m128i peaks = _mm_set1_epi32(peak);
+    __m128i sums = _mm_setzero_si128();
+    int32_t lanes[4];
+    uint64_t sum[2];
+    unsigned i;
+
+    for (i = 0; i < n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)&in[i]);
+        __m128i odd = _mm_srli_epi64(x, 32);
+
+        peaks = _mm_max_epi32(peaks, _mm_min_epu32(_mm_abs_epi32(x), _mm_set1_epi32(INT32_MAX)));
+        sums = _mm_add_epi64(sums, _mm_srli_epi64(_mm_mul_epi32(x, x), 31));
+        sums = _mm_add_epi64(sums, _mm_srli_epi64(_mm_mul_epi32(odd, odd), 31));
+    }
+
+    _mm_storeu_si128((__m128i *)lanes, peaks);
+    _mm_storeu_si128((__m128i *)sum, sums);
+    *sum_squares += sum[0] + sum[1];
+    for (i = 0; i < 4; i++)
+    {
+        peak = (lanes[i] > peak) ? lanes[i] : peak;
+    }
+    return peak;
+}
+
+#elif defined(AUDIO_PROC_HOST_NEON)
+
+static int32_t peak_block_simd(const int32_t *in, unsigned n, int32_t peak, uint64_t *sum_squares)
+{
+    int32x4_t peaks = vdupq_n_s32(peak);
+    uint64x2_t sums = vdupq_n_u64(0);
+    int32x2_t pair;
+    unsigned i;
+
+    for (i = 0; i < n; i += 4)
+    {
+        int32x4_t x = vld1q_s32(&in[i]);
+        int64x2_t low = vmull_s32(vget_low_s32(x), vget_low_s32(x));
+        int64x2_t high = vmull_s32(vget_high_s32(x), vget_high_s32(x));
+
+        peaks = vmaxq_s32(peaks, vqabsq_s32(x));
+        sums = vaddq_u64(sums, vshrq_n_u64(vreinterpretq_u64_s64(low), 31));
+        sums = vaddq_u64(sums, vshrq_n_u64(vreinterpretq_u64_s64(high), 31));
+    }
+
+    *sum_squares += vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1);
+    pair = vmax_s32(vget_low_s32(peaks), vget_high_s32(peaks));
+    return vget_lane_s32(vpmax_s32(pair, pair), 0);
+}
+
+#endif
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void audio_proc_host_peak_monitor_reset(audio_proc_host_peak_monitor *monitor)
+{
+    monitor->peak_level = 0;
+    monitor->sum_squares = 0;
+    monitor->samples = 0;
+}
+
+void audio_proc_host_peak_monitor_process(audio_proc_host_peak_monitor *monitor, const int32_t *input,
+                                          unsigned samples)
+{
+    int32_t peak = monitor->peak_level;
+    uint64_t sum_squares = monitor->sum_squares;
+    unsigned i = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    if (audio_proc_host_simd_enabled)
+    {
+        i = samples & ~3u;
+        peak = peak_block_simd(input, i, peak, &sum_squares);
+    }
+#endif
+    for (; i < samples; i++)
+    {
+        int32_t x = kal_abs32(input[i]);
+
+        peak = (x > peak) ? x : peak;
+        sum_squares += (uint64_t)((int64_t)input[i] * input[i]) >> 31;
+    }
+
+    monitor->peak_level = peak;
+    monitor->sum_squares = sum_squares;
+    monitor->samples += samples;
+}
+
+int32_t audio_proc_host_peak_monitor_rms(const audio_proc_host_peak_monitor *monitor)
+{
+    uint64_t mean_square, root;
+
+    if (monitor->samples == 0)
+    {
+        return 0;
+    }
+
+    /* the root of the mean square in q.31 is the integer root of it times
+       2^31; the double root is corrected to the exact floor */
+    mean_square = (monitor->sum_squares / monitor->samples) << 31;
+    root = (uint64_t)sqrt((double)mean_square);
+    while (root * root > mean_square)
+    {
+        root--;
+    }
+    while ((root + 1) * (root + 1) <= mean_square)
+    {
+        root++;
+    }
+    return (root > INT32_MAX) ? INT32_MAX : (int32_t)root;
+}
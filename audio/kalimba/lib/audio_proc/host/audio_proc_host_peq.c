@@ -0,0 +1,626 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_peq.c
+ * \ingroup audio_proc
+ *
+ * Host port of the PEQ cores: $audio_proc.peq, $audio_proc.sh_peq,
+ * $audio_proc.hq_peq and $audio_proc.dh_peq. <br>
+ *
+ * Each stage is the direct form I biquad of the DSP, where the output
+ * history of one stage is the input history of the next:
+ *
+ *     acc = b2 x(n-2) + b1 x(n-1) + b0 x(n) - a2 y(n-2) - a1 y(n-1)
+ *     y(n) = acc << scale
+ *
+ * The cores differ in how y(n) is taken from rMAC. A transposed form would
+ * keep sums that the DSP never rounds, so it would not give the same
+ * output. The order of work is changed instead: a block of samples goes
+ * through one stage at a time, so the history and coefficients of a stage
+ * stay in registers, and a pair of channels shares each SIMD instruction.
+ * A stage writes back only its input history, as the next stage has not
+ * yet read its own from the same rows; the last stage writes both.
+ *
+ * The SIMD stages hold each sum as a 64 bit value. A sum of five products
+ * can pass 2^63 only when the stage output is far out of range, so a
+ * coarse sum of the top bits of the products is kept as well, and any
+ * sample where it comes near 2^62 is done again with the scalar code.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "audio_proc_host_private.h"
+#include "audio_proc_host_simd.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Samples taken through the cascade at a time */
+#define BLOCK_SAMPLES       64
+
+/** Coefficients of a stage */
+#define B2                  0
+#define B1                  1
+#define B0                  2
+#define A2                  3
+#define A1                  4
+#define SCALE               5
+
+/** The SIMD stages take shifts of sums of products, as rMAC holding twice
+    the sum, by 1 to 62 bits */
+#define MIN_SIMD_SHIFT      (-31)
+#define MAX_SIMD_SHIFT      30
+
+/****************************************************************************
+Public Variable Definitions
+*/
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+int audio_proc_host_simd_enabled = 1;
+#else
+int audio_proc_host_simd_enabled = 0;
+#endif
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Sum of the products of a stage, with the inputs in the order of the
+   history: x(n-2), x(n-1), x(n), y(n-2), y(n-1) */
+static inline kal_rmac stage_sum(const int32_t *c, int32_t x2, int32_t x1, int32_t x, int32_t y2, int32_t y1)
+{
+    return KAL_MAC(c[B2], x2) + KAL_MAC(c[B1], x1) + KAL_MAC(c[B0], x)
+           - KAL_MAC(c[A2], y2) - KAL_MAC(c[A1], y1);
+}
+
+/* Front end gain of the legacy and SH cores: rMACB = in * mantissa ASHIFT
+   exponent - headroom, used as a word. The HQ core shifts into a register,
+   which truncates. */
+static inline int32_t sh_gain(const audio_proc_host_peq *peq, int32_t in)
+{
+    return kal_rmac_store(kal_rmac_ashift(KAL_MAC(in, peq->gain_mantissa),
+                                          peq->gain_exponent - peq->headroom_bits));
+}
+
+static inline int32_t hq_gain(const audio_proc_host_peq *peq, int32_t in)
+{
+    return kal_rmac_to_reg(KAL_MAC(in, peq->gain_mantissa), peq->gain_exponent - peq->headroom_bits);
+}
+
+/* Output of an HQ stage from its sum with the low word of the last one.
+   The new low word is kept and cleared from rMAC before the shift. */
+static inline int32_t hq_output(kal_rmac acc, int scale, uint32_t *residue)
+{
+    *residue = kal_rmac_low(acc);
+    return kal_rmac_to_reg(acc - *residue, scale);
+}
+
+/* Legacy and SH stage over n samples of one channel, from src to dst. The
+   last stage of the legacy core writes rMACB shifted by the headroom, the
+   others write y(n). */
+static void sh_stage_scalar(audio_proc_host_peq *peq, unsigned stage, unsigned ch, const int32_t *src,
+                            unsigned src_stride, int32_t *dst, unsigned dst_stride, unsigned n)
+{
+    const int32_t *c = peq->coeffs[stage];
+    int32_t *x_hist = &peq->history[2 * stage][ch];
+    int32_t *y_hist = &peq->history[2 * stage + 2][ch];
+    int32_t x2 = x_hist[0], x1 = x_hist[AUDIO_PROC_HOST_MAX_CHANNELS];
+    int32_t y2 = y_hist[0], y1 = y_hist[AUDIO_PROC_HOST_MAX_CHANNELS];
+    int headroom = (stage + 1 == peq->num_stages) ? peq->headroom_bits : 0;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        int32_t x = src[i * src_stride];
+        kal_rmac acc = kal_rmac_ashift(stage_sum(c, x2, x1, x, y2, y1), c[SCALE]);
+        int32_t y = kal_rmac_store(acc);
+
+        dst[i * dst_stride] = headroom ? kal_rmac_store(kal_rmac_ashift(acc, headroom)) : y;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+    }
+    x_hist[0] = x2;
+    x_hist[AUDIO_PROC_HOST_MAX_CHANNELS] = x1;
+    if (stage + 1 == peq->num_stages)
+    {
+        y_hist[0] = y2;
+        y_hist[AUDIO_PROC_HOST_MAX_CHANNELS] = y1;
+    }
+}
+
+/* HQ stage over n samples of one channel */
+static void hq_stage_scalar(audio_proc_host_peq *peq, unsigned stage, unsigned ch, const int32_t *src,
+                            unsigned src_stride, int32_t *dst, unsigned dst_stride, unsigned n)
+{
+    const int32_t *c = peq->coeffs[stage];
+    int32_t *x_hist = &peq->history[2 * stage][ch];
+    int32_t *y_hist = &peq->history[2 * stage + 2][ch];
+    uint32_t *residue = &peq->history_low[stage][ch];
+    int32_t x2 = x_hist[0], x1 = x_hist[AUDIO_PROC_HOST_MAX_CHANNELS];
+    int32_t y2 = y_hist[0], y1 = y_hist[AUDIO_PROC_HOST_MAX_CHANNELS];
+    int headroom = (stage + 1 == peq->num_stages) ? peq->headroom_bits : 0;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        int32_t x = src[i * src_stride];
+        int32_t y = hq_output((kal_rmac)*residue + stage_sum(c, x2, x1, x, y2, y1), c[SCALE], residue);
+
+        dst[i * dst_stride] = kal_ashift32(y, headroom);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+    }
+    x_hist[0] = x2;
+    x_hist[AUDIO_PROC_HOST_MAX_CHANNELS] = x1;
+    if (stage + 1 == peq->num_stages)
+    {
+        y_hist[0] = y2;
+        y_hist[AUDIO_PROC_HOST_MAX_CHANNELS] = y1;
+    }
+}
+
+/* DH stage over n samples of one channel. Each value is a high word and an
+   unsigned low word; the low words are summed first, with (SU) products,
+   and shifted down onto the sum of the high words. */
+static void dh_stage_scalar(audio_proc_host_peq *peq, unsigned stage, unsigned ch, int32_t *high,
+                            uint32_t *low, int32_t *dst, unsigned dst_stride, unsigned n)
+{
+    const int32_t *c = peq->coeffs[stage];
+    int32_t *x_hist = &peq->history[2 * stage][ch];
+    int32_t *y_hist = &peq->history[2 * stage + 2][ch];
+    uint32_t *x_low = &peq->history_low[2 * stage][ch];
+    uint32_t *y_low = &peq->history_low[2 * stage + 2][ch];
+    int32_t x2 = x_hist[0], x1 = x_hist[AUDIO_PROC_HOST_MAX_CHANNELS];
+    int32_t y2 = y_hist[0], y1 = y_hist[AUDIO_PROC_HOST_MAX_CHANNELS];
+    uint32_t x2_low = x_low[0], x1_low = x_low[AUDIO_PROC_HOST_MAX_CHANNELS];
+    uint32_t y2_low = y_low[0], y1_low = y_low[AUDIO_PROC_HOST_MAX_CHANNELS];
+    int last = (stage + 1 == peq->num_stages);
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        int32_t x = high[i];
+        uint32_t x_l = low[i];
+        kal_rmac acc = KAL_MAC_SU(c[B2], x2_low) + KAL_MAC_SU(c[B1], x1_low) + KAL_MAC_SU(c[B0], x_l)
+                       - KAL_MAC_SU(c[A2], y2_low) - KAL_MAC_SU(c[A1], y1_low);
+
+        acc = kal_rmac_ashift(acc, -32) + stage_sum(c, x2, x1, x, y2, y1);
+        acc = kal_rmac_ashift(acc, c[SCALE]);
+
+        x2 = x1;
+        x1 = x;
+        x2_low = x1_low;
+        x1_low = x_l;
+        y2 = y1;
+        y1 = kal_rmac_to_reg(acc, 0);
+        y2_low = y1_low;
+        y1_low = kal_rmac_low(acc);
+        if (last)
+        {
+            dst[i * dst_stride] = kal_rmac_store(kal_rmac_ashift(acc, peq->headroom_bits));
+        }
+        else
+        {
+            high[i] = y1;
+            low[i] = y1_low;
+        }
+    }
+    x_hist[0] = x2;
+    x_hist[AUDIO_PROC_HOST_MAX_CHANNELS] = x1;
+    x_low[0] = x2_low;
+    x_low[AUDIO_PROC_HOST_MAX_CHANNELS] = x1_low;
+    if (last)
+    {
+        y_hist[0] = y2;
+        y_hist[AUDIO_PROC_HOST_MAX_CHANNELS] = y1;
+        y_low[0] = y2_low;
+        y_low[AUDIO_PROC_HOST_MAX_CHANNELS] = y1_low;
+    }
+}
+
+/* One channel of a block through the whole cascade */
+static void process_channel_scalar(audio_proc_host_peq *peq, unsigned ch, const int32_t *input,
+                                   int32_t *output, unsigned n)
+{
+    unsigned stride = peq->num_channels;
+    unsigned last = peq->num_stages - 1;
+    int32_t work[BLOCK_SAMPLES];
+    unsigned stage, i;
+
+    if (peq->core == AUDIO_PROC_HOST_DH_PEQ)
+    {
+        uint32_t work_low[BLOCK_SAMPLES];
+
+        for (i = 0; i < n; i++)
+        {
+            kal_rmac acc = kal_rmac_ashift(KAL_MAC(input[i * stride], peq->gain_mantissa),
+                                           peq->gain_exponent - peq->headroom_bits);
+
+            work[i] = kal_rmac_to_reg(acc, 0);
+            work_low[i] = kal_rmac_low(acc);
+        }
+        for (stage = 0; stage <= last; stage++)
+        {
+            dh_stage_scalar(peq, stage, ch, work, work_low, output, stride, n);
+        }
+        return;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        work[i] = (peq->core == AUDIO_PROC_HOST_HQ_PEQ) ? hq_gain(peq, input[i * stride])
+                                                        : sh_gain(peq, input[i * stride]);
+    }
+    for (stage = 0; stage <= last; stage++)
+    {
+        int32_t *dst = (stage == last) ? output : work;
+        unsigned dst_stride = (stage == last) ? stride : 1;
+
+        if (peq->core == AUDIO_PROC_HOST_HQ_PEQ)
+        {
+            hq_stage_scalar(peq, stage, ch, work, 1, dst, dst_stride, n);
+        }
+        else
+        {
+            sh_stage_scalar(peq, stage, ch, work, 1, dst, dst_stride, n);
+        }
+    }
+}
+
+#if defined(AUDIO_PROC_HOST_SSE4_1)
+
+/* HQ: rMAC = residue + 2 * sum, with the residue zero extended */
+static inline acc2 acc2_hq(acc2 sum, vec2 residue)
+{
+    return _mm_add_epi64(_mm_slli_epi64(sum, 1), _mm_and_si128(residue, _mm_set1_epi64x(0xFFFFFFFF)));
+}
+
+#define acc2_low(a)         (a)
+#define acc2_high(a)        _mm_srli_epi64((a), 32)
+
+#elif defined(AUDIO_PROC_HOST_NEON)
+
+static inline acc2 acc2_hq(acc2 sum, vec2 residue)
+{
+    return vaddq_s64(vshlq_n_s64(sum, 1), vreinterpretq_s64_u64(vmovl_u32(vreinterpret_u32_s32(residue))));
+}
+
+#define acc2_low(a)         vmovn_s64(a)
+#define acc2_high(a)        vshrn_n_s64((a), 32)
+
+#endif
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+
+/* Limit of the coarse sum of five products, two of them subtracted, for a
+   sum within +-(2^62 - 2^33) */
+#define EST_LIMIT           ((1 << 29) - 4)
+
+/* floor(p / 2^33) of a product, which is within +-2^29 */
+#define EST(p)              est2_product((p), 33)
+
+/* Coarse sum of the products of a stage */
+#define STAGE_PRODUCTS(p_b2, p_b1, p_b0, p_a2, p_a1, sum, est)                          \
+    do                                                                                  \
+    {                                                                                   \
+        (sum) = acc2_sub(acc2_sub(acc2_add(acc2_add((p_b2), (p_b1)), (p_b0)), (p_a2)), (p_a1)); \
+        (est) = est2_sub(est2_sub(est2_add(est2_add(EST(p_b2), EST(p_b1)), EST(p_b0)),  \
+                                  EST(p_a2)),                                           \
+                         EST(p_a1));                                                    \
+    } while (0)
+
+/* Gain of two channels. SH rounds: with the word shift d = 31 - shift,
+   rMACB as a word is floor((p + 2^(d - 1)) / 2^d). HQ truncates. */
+static void gain_simd(const audio_proc_host_peq *peq, const int32_t *input, unsigned stride, int32_t *work,
+                      unsigned n)
+{
+    int shift = 31 - (peq->gain_exponent - peq->headroom_bits);
+    vec2 mantissa = vec2_dup(peq->gain_mantissa);
+    unsigned i;
+
+    if (peq->core == AUDIO_PROC_HOST_HQ_PEQ)
+    {
+        for (i = 0; i < n; i++)
+        {
+            vec2_store(&work[2 * i], acc2_shift_sat(acc2_mul(vec2_load(&input[i * stride]), mantissa), shift));
+        }
+    }
+    else
+    {
+        acc2 round = acc2_dup((int64_t)1 << (shift - 1));
+
+        for (i = 0; i < n; i++)
+        {
+            vec2_store(&work[2 * i],
+                       acc2_shift_sat(acc2_add(acc2_mul(vec2_load(&input[i * stride]), mantissa), round), shift));
+        }
+    }
+}
+
+/* Legacy and SH stage over n samples of channels ch and ch + 1. src and dst
+   hold the pair of channels at each stride. */
+static void sh_stage_simd(audio_proc_host_peq *peq, unsigned stage, unsigned ch, const int32_t *src,
+                          unsigned src_stride, int32_t *dst, unsigned dst_stride, unsigned n)
+{
+    const int32_t *c = peq->coeffs[stage];
+    int32_t *x_hist = &peq->history[2 * stage][ch];
+    int32_t *y_hist = &peq->history[2 * stage + 2][ch];
+    int headroom = (stage + 1 == peq->num_stages) ? peq->headroom_bits : 0;
+    int shift = 31 - c[SCALE];
+    int out_shift = shift - headroom;
+    vec2 b2 = vec2_dup(c[B2]), b1 = vec2_dup(c[B1]), b0 = vec2_dup(c[B0]);
+    vec2 a2 = vec2_dup(c[A2]), a1 = vec2_dup(c[A1]);
+    vec2 x2 = vec2_load(&x_hist[0]), x1 = vec2_load(&x_hist[AUDIO_PROC_HOST_MAX_CHANNELS]);
+    vec2 y2 = vec2_load(&y_hist[0]), y1 = vec2_load(&y_hist[AUDIO_PROC_HOST_MAX_CHANNELS]);
+    acc2 round = acc2_dup((int64_t)1 << (shift - 1));
+    acc2 out_round = acc2_dup((int64_t)1 << (out_shift - 1));
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        vec2 x = vec2_load(&src[i * src_stride]);
+        vec2 y, out;
+        acc2 sum;
+        est2 est;
+
+        STAGE_PRODUCTS(acc2_mul(b2, x2), acc2_mul(b1, x1), acc2_mul(b0, x), acc2_mul(a2, y2),
+                       acc2_mul(a1, y1), sum, est);
+        if (est2_out_of_range(est, EST_LIMIT))
+        {
+            int32_t y_lane[2], out_lane[2];
+            int lane;
+
+            for (lane = 0; lane < 2; lane++)
+            {
+                kal_rmac acc = kal_rmac_ashift(stage_sum(c, vec2_lane(x2, lane), vec2_lane(x1, lane),
+                                                         vec2_lane(x, lane), vec2_lane(y2, lane),
+                                                         vec2_lane(y1, lane)),
+                                               c[SCALE]);
+
+                y_lane[lane] = kal_rmac_store(acc);
+                out_lane[lane] = kal_rmac_store(kal_rmac_ashift(acc, headroom));
+            }
+            y = vec2_set(y_lane[0], y_lane[1]);
+            out = vec2_set(out_lane[0], out_lane[1]);
+        }
+        else
+        {
+            y = acc2_shift_sat(acc2_add(sum, round), shift);
+            out = headroom ? acc2_shift_sat(acc2_add(sum, out_round), out_shift) : y;
+        }
+        vec2_store(&dst[i * dst_stride], out);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+    }
+    vec2_store(&x_hist[0], x2);
+    vec2_store(&x_hist[AUDIO_PROC_HOST_MAX_CHANNELS], x1);
+    if (stage + 1 == peq->num_stages)
+    {
+        vec2_store(&y_hist[0], y2);
+        vec2_store(&y_hist[AUDIO_PROC_HOST_MAX_CHANNELS], y1);
+    }
+}
+
+/* HQ stage over n samples of channels ch and ch + 1 */
+static void hq_stage_simd(audio_proc_host_peq *peq, unsigned stage, unsigned ch, const int32_t *src,
+                          unsigned src_stride, int32_t *dst, unsigned dst_stride, unsigned n)
+{
+    const int32_t *c = peq->coeffs[stage];
+    int32_t *x_hist = &peq->history[2 * stage][ch];
+    int32_t *y_hist = &peq->history[2 * stage + 2][ch];
+    uint32_t *residue_hist = &peq->history_low[stage][ch];
+    int headroom = (stage + 1 == peq->num_stages) ? peq->headroom_bits : 0;
+    vec2 b2 = vec2_dup(c[B2]), b1 = vec2_dup(c[B1]), b0 = vec2_dup(c[B0]);
+    vec2 a2 = vec2_dup(c[A2]), a1 = vec2_dup(c[A1]);
+    vec2 x2 = vec2_load(&x_hist[0]), x1 = vec2_load(&x_hist[AUDIO_PROC_HOST_MAX_CHANNELS]);
+    vec2 y2 = vec2_load(&y_hist[0]), y1 = vec2_load(&y_hist[AUDIO_PROC_HOST_MAX_CHANNELS]);
+    vec2 residue = vec2_load((const int32_t *)residue_hist);
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        vec2 x = vec2_load(&src[i * src_stride]);
+        vec2 y;
+        acc2 sum;
+        est2 est;
+
+        STAGE_PRODUCTS(acc2_mul(b2, x2), acc2_mul(b1, x1), acc2_mul(b0, x), acc2_mul(a2, y2),
+                       acc2_mul(a1, y1), sum, est);
+        if (est2_out_of_range(est, EST_LIMIT))
+        {
+            int32_t y_lane[2];
+            uint32_t residue_lane[2];
+            int lane;
+
+            for (lane = 0; lane < 2; lane++)
+            {
+                kal_rmac acc = (kal_rmac)(uint32_t)vec2_lane(residue, lane)
+                               + stage_sum(c, vec2_lane(x2, lane), vec2_lane(x1, lane), vec2_lane(x, lane),
+                                           vec2_lane(y2, lane), vec2_lane(y1, lane));
+
+                y_lane[lane] = hq_output(acc, c[SCALE], &residue_lane[lane]);
+            }
+            y = vec2_set(y_lane[0], y_lane[1]);
+            residue = vec2_set((int32_t)residue_lane[0], (int32_t)residue_lane[1]);
+        }
+        else
+        {
+            acc2 acc = acc2_hq(sum, residue);
+
+            residue = acc2_low(acc);
+            y = vec2_ashift_sat(acc2_high(acc), c[SCALE]);
+        }
+        vec2_store(&dst[i * dst_stride], headroom ? vec2_ashift_sat(y, headroom) : y);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+    }
+    vec2_store(&x_hist[0], x2);
+    vec2_store(&x_hist[AUDIO_PROC_HOST_MAX_CHANNELS], x1);
+    if (stage + 1 == peq->num_stages)
+    {
+        vec2_store(&y_hist[0], y2);
+        vec2_store(&y_hist[AUDIO_PROC_HOST_MAX_CHANNELS], y1);
+    }
+    vec2_store((int32_t *)residue_hist, residue);
+}
+
+/* Two channels of a block through the whole cascade */
+static void process_pair_simd(audio_proc_host_peq *peq, unsigned ch, const int32_t *input, int32_t *output,
+                              unsigned n)
+{
+    unsigned stride = peq->num_channels;
+    unsigned last = peq->num_stages - 1;
+    int32_t work[2 * BLOCK_SAMPLES];
+    unsigned stage;
+
+    gain_simd(peq, input, stride, work, n);
+    for (stage = 0; stage <= last; stage++)
+    {
+        int32_t *dst = (stage == last) ? output : work;
+        unsigned dst_stride = (stage == last) ? stride : 2;
+
+        if (peq->core == AUDIO_PROC_HOST_HQ_PEQ)
+        {
+            hq_stage_simd(peq, stage, ch, work, 2, dst, dst_stride, n);
+        }
+        else
+        {
+            sh_stage_simd(peq, stage, ch, work, 2, dst, dst_stride, n);
+        }
+    }
+}
+
+/* Whether the SIMD stages can take the object: legacy, SH or HQ, with the
+   shifts in range */
+static int simd_supported(const audio_proc_host_peq *peq)
+{
+    int gain_shift = peq->gain_exponent - peq->headroom_bits;
+    unsigned stage;
+
+    if ((peq->core == AUDIO_PROC_HOST_DH_PEQ) || (gain_shift < MIN_SIMD_SHIFT) || (gain_shift > MAX_SIMD_SHIFT))
+    {
+        return 0;
+    }
+    for (stage = 0; stage < peq->num_stages; stage++)
+    {
+        int scale = peq->coeffs[stage][SCALE];
+
+        if ((scale < MIN_SIMD_SHIFT) || (scale + peq->headroom_bits > MAX_SIMD_SHIFT))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void audio_proc_host_set_simd(int enable)
+{
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    audio_proc_host_simd_enabled = enable;
+#else
+    (void)enable;
+#endif
+}
+
+void audio_proc_host_peq_init(audio_proc_host_peq *peq, audio_proc_host_peq_core core, unsigned num_channels)
+{
+    memset(peq, 0, sizeof(*peq));
+    peq->core = core;
+    peq->num_channels = num_channels;
+    peq->headroom_bits = (core == AUDIO_PROC_HOST_PEQ_LEGACY) ? AUDIO_PROC_HOST_LEGACY_PEQ_HEADROOM
+                                                              : AUDIO_PROC_HOST_PEQ_HEADROOM;
+}
+
+int audio_proc_host_peq_set_params(audio_proc_host_peq *peq, const int32_t *params, unsigned max_stages)
+{
+    unsigned num_stages = (uint32_t)params[0] & AUDIO_PROC_HOST_PEQ_NUM_STAGES_MASK;
+    unsigned stage, i;
+
+    if ((num_stages == 0) || (num_stages > AUDIO_PROC_HOST_PEQ_MAX_STAGES))
+    {
+        return 0;
+    }
+    if ((peq->core == AUDIO_PROC_HOST_PEQ_LEGACY) && (num_stages > max_stages))
+    {
+        return 0;
+    }
+
+    peq->num_stages = num_stages;
+    peq->gain_exponent = params[1];
+    peq->gain_mantissa = params[2];
+    for (stage = 0; stage < num_stages; stage++)
+    {
+        if (peq->core == AUDIO_PROC_HOST_PEQ_LEGACY)
+        {
+            /* the scale factors follow the coefficients of max_stages */
+            for (i = 0; i < SCALE; i++)
+            {
+                peq->coeffs[stage][i] = params[3 + 5 * stage + i];
+            }
+            peq->coeffs[stage][SCALE] = params[3 + 5 * max_stages + stage];
+        }
+        else
+        {
+            for (i = 0; i <= SCALE; i++)
+            {
+                peq->coeffs[stage][i] = params[3 + 6 * stage + i];
+            }
+        }
+    }
+    return 1;
+}
+
+void audio_proc_host_peq_zero_delay_data(audio_proc_host_peq *peq)
+{
+    memset(peq->history, 0, sizeof(peq->history));
+    memset(peq->history_low, 0, sizeof(peq->history_low));
+}
+
+void audio_proc_host_peq_process(audio_proc_host_peq *peq, const int32_t *input, int32_t *output,
+                                 unsigned samples)
+{
+    unsigned stride = peq->num_channels;
+    unsigned start;
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    int simd = audio_proc_host_simd_enabled && simd_supported(peq);
+#endif
+
+    for (start = 0; start < samples; start += BLOCK_SAMPLES)
+    {
+        unsigned n = (samples - start < BLOCK_SAMPLES) ? samples - start : BLOCK_SAMPLES;
+        const int32_t *in = &input[start * stride];
+        int32_t *out = &output[start * stride];
+        unsigned ch = 0;
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+        if (simd)
+        {
+            for (; ch + 2 <= stride; ch += 2)
+            {
+                process_pair_simd(peq, ch, &in[ch], &out[ch], n);
+            }
+        }
+#endif
+        for (; ch < stride; ch++)
+        {
+            process_channel_scalar(peq, ch, &in[ch], &out[ch], n);
+        }
+    }
+}
@@ -0,0 +1,208 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_private.h
+ * \ingroup audio_proc
+ *
+ * Kalimba arch4 arithmetic used by the host audio_proc port. <br>
+ *
+ * rMAC and rMACB are 72 bit accumulators, held here as 128 bit integers.
+ * A fractional multiply adds twice the integer product; (SU) takes the
+ * second operand as unsigned. The accumulators are used as a 32 bit value
+ * in three ways:
+ *
+ *   - M[] = rMAC or r = rMACB: bits 63..32 rounded on bit 31, saturated
+ *   - r = rMAC ASHIFT n: bits 63..32 of rMAC shifted by n, truncated and
+ *     saturated
+ *   - r = rMAC LSHIFT DAWTH: bits 31..0
+ *   - r = rMAC LSHIFT 0: bits 63..32, not saturated
+ *
+ * rMAC = rMAC ASHIFT n (56bit) shifts within the accumulator, truncating
+ * right shifts and saturating left shifts at 72 bits.
+ */
+
+#ifndef AUDIO_PROC_HOST_PRIVATE_H
+#define AUDIO_PROC_HOST_PRIVATE_H
+
+/****************************************************************************
+Include Files
+*/
+#include "audio_proc_host.h"
+
+/****************************************************************************
+Private Type Declarations
+*/
+typedef __int128 kal_rmac;
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Headroom bits of the cores, $audio_proc.peq.*_HEADROOM_SHIFTS */
+#define AUDIO_PROC_HOST_LEGACY_PEQ_HEADROOM     2
+#define AUDIO_PROC_HOST_PEQ_HEADROOM            0
+
+/** Largest 72 bit accumulator value */
+#define KAL_RMAC_MAX        ((((kal_rmac)1) << 71) - 1)
+#define KAL_RMAC_MIN        (-(((kal_rmac)1) << 71))
+
+/****************************************************************************
+Private Macro Declarations
+*/
+
+/** rMAC (+)= a * b (frac) */
+#define KAL_MAC(a, b)       ((kal_rmac)((int64_t)(a) * (int64_t)(b)) * 2)
+
+/** rMAC (+)= a * b (SU) */
+#define KAL_MAC_SU(a, b)    ((kal_rmac)((int64_t)(a) * (int64_t)(uint32_t)(b)) * 2)
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/** Saturate to a data word */
+static inline int32_t kal_sat32(int64_t value)
+{
+    if (value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)value;
+}
+
+/** Saturate an accumulator value to a data word */
+static inline int32_t kal_rmac_sat32(kal_rmac value)
+{
+    if (value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)value;
+}
+
+/** M[] = rMAC, rounded and saturated */
+static inline int32_t kal_rmac_store(kal_rmac acc)
+{
+    return kal_rmac_sat32((acc + ((kal_rmac)1 << 31)) >> 32);
+}
+
+/** rMAC = rMAC ASHIFT shift (56bit) */
+static inline kal_rmac kal_rmac_ashift(kal_rmac acc, int shift)
+{
+    if (shift < 0)
+    {
+        return acc >> -shift;
+    }
+    if (acc > (KAL_RMAC_MAX >> shift))
+    {
+        return KAL_RMAC_MAX;
+    }
+    if (acc < (KAL_RMAC_MIN >> shift))
+    {
+        return KAL_RMAC_MIN;
+    }
+    return acc * ((kal_rmac)1 << shift);
+}
+
+/** r = rMAC ASHIFT shift */
+static inline int32_t kal_rmac_to_reg(kal_rmac acc, int shift)
+{
+    return kal_rmac_sat32(kal_rmac_ashift(acc, shift) >> 32);
+}
+
+/** rMAC = r */
+static inline kal_rmac kal_rmac_load(int32_t value)
+{
+    return (kal_rmac)value * ((kal_rmac)1 << 32);
+}
+
+/** SIGNDET rMAC: the shift that takes the top bit of the magnitude to bit
+    62, negative if rMAC is using its guard bits, 63 for zero */
+static inline int kal_rmac_signdet(kal_rmac acc)
+{
+    kal_rmac magnitude = (acc < 0) ? ~acc : acc;
+    int shift = 63;
+
+    while (magnitude != 0)
+    {
+        magnitude >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+/** r = rMAC LSHIFT DAWTH */
+static inline uint32_t kal_rmac_low(kal_rmac acc)
+{
+    return (uint32_t)acc;
+}
+
+/** r = rMAC LSHIFT 0 */
+static inline int32_t kal_rmac_high(kal_rmac acc)
+{
+    return (int32_t)(uint32_t)(acc >> 32);
+}
+
+/** r = a * b (frac) */
+static inline int32_t kal_frac_mult(int32_t a, int32_t b)
+{
+    return kal_rmac_store(KAL_MAC(a, b));
+}
+
+/** r = acc + a * b, the sum rounded and saturated as rMAC */
+static inline int32_t kal_frac_mac(int32_t acc, int32_t a, int32_t b)
+{
+    return kal_rmac_store((kal_rmac)acc * ((kal_rmac)1 << 32) + KAL_MAC(a, b));
+}
+
+/** r = ABS r, saturating the most negative value */
+static inline int32_t kal_abs32(int32_t value)
+{
+    if (value == INT32_MIN)
+    {
+        return INT32_MAX;
+    }
+    return (value < 0) ? -value : value;
+}
+
+/** SIGNDET r: the left shift that normalises a word, 31 for zero */
+static inline int kal_signdet32(int32_t value)
+{
+    uint32_t magnitude = (value < 0) ? ~(uint32_t)value : (uint32_t)value;
+    int shift = 31;
+
+    while (magnitude != 0)
+    {
+        magnitude >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+/** r = r ASHIFT shift, saturating left shifts */
+static inline int32_t kal_ashift32(int32_t value, int shift)
+{
+    if (shift < 0)
+    {
+        return value >> -shift;
+    }
+    return kal_sat32((int64_t)value * ((int64_t)1 << shift));
+}
+
+/****************************************************************************
+Private Data Declarations
+*/
+
+/* audio_proc_host_peq.c */
+extern int audio_proc_host_simd_enabled;
+
+#endif /* AUDIO_PROC_HOST_PRIVATE_H */
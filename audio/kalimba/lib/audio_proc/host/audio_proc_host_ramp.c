@@ -0,0 +1,398 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_ramp.c
+ * \ingroup audio_proc
+ *
+ * Host ports of stream_gain.asm, mute_control.asm and audio_fadeout.asm,
+ * and a gain ramp with a start that can be put on any sample. <br>
+ *
+ * stream_gain.asm takes each sample times the mantissa into rMAC and
+ * stores rMAC ASHIFT exponent, which truncates: for exponents of -31 to 30
+ * that is the 64 bit product shifted right by 31 - exponent and saturated.
+ * The fade out stores each sample times its gain rounded, which is the
+ * same shift by 31 after adding 2^30. Where no gain of a block can take a
+ * sample out of a word, as for gains up to unity, both are plain loops
+ * without the saturation, which the compiler vectorises wider than the two
+ * SIMD lanes of a 64 bit product; the other blocks take the SIMD loop.
+ *
+ * The gain ramp is made of linear pieces. The gains of up to RAMP_CHUNK
+ * samples of a piece are made in one scalar pass, by adding the step to a
+ * 64 bit position, and the kernel then applies them to every channel. A
+ * call is split where the delay or a piece ends, so neither is tested for
+ * each sample, and the gains only depend on the sample's place in the
+ * ramp: any split of the blocks gives the same output.
+ *
+ * The fade out's gain, 1.0 - n * SCALE_FRACT * SAMPLING_PERIOD_IN_USECS,
+ * is made in the loop that applies it, up to the sample where it goes
+ * negative and the DSP starts to flush, which is worked out first.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <math.h>
+#include <string.h>
+#include "audio_proc_host_private.h"
+#include "audio_proc_host_simd.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Gains made at a time */
+#define RAMP_CHUNK          64
+
+/** -96 dB, the lowest level of an exponential ramp's series */
+#define RAMP_MIN_LEVEL      ((int32_t)1 << 15)
+
+/** SCALE_FRACT * SAMPLING_PERIOD_IN_USECS of audio_fadeout.asm, the fall
+    of the fade out's gain each sample: SCALE_FRACT is 2^-15, 2^16 in q.31 */
+#define FADE_OUT_STEP       ((1 << 16) * 63)
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* out = sat32((in * gain + half) >> shift), shift 1 to 62 and half below
+   2^shift, with a gain for each sample (gains) or the same gain for all
+   (gains NULL). peak is the largest of the gains and of one minus each
+   negative gain: up to 2^shift no result can leave a word, as unity gain
+   is 2^shift, and the plain loops leave out the saturation. */
+static void apply_gains(const int32_t *in, int32_t *out, const int32_t *gains, int32_t gain, int64_t peak,
+                        unsigned samples, int shift, int64_t half)
+{
+    unsigned i = 0;
+
+    if ((shift <= 32) && (peak <= ((int64_t)1 << shift)))
+    {
+        if (gains == NULL)
+        {
+            for (i = 0; i < samples; i++)
+            {
+                out[i] = (int32_t)(((int64_t)in[i] * gain + half) >> shift);
+            }
+            return;
+        }
+        for (i = 0; i < samples; i++)
+        {
+            out[i] = (int32_t)(((int64_t)in[i] * gains[i] + half) >> shift);
+        }
+        return;
+    }
+
+#if defined(AUDIO_PROC_HOST_SSE4_1) || defined(AUDIO_PROC_HOST_NEON)
+    if (audio_proc_host_simd_enabled)
+    {
+        acc2 round = acc2_dup(half);
+        vec2 same = vec2_dup(gain);
+
+        if (gains == NULL)
+        {
+            for (; i + 2 <= samples; i += 2)
+            {
+                vec2_store(&out[i], acc2_shift_sat(acc2_add(acc2_mul(vec2_load(&in[i]), same), round), shift));
+            }
+        }
+        else
+        {
+            for (; i + 2 <= samples; i += 2)
+            {
+                vec2_store(&out[i],
+                           acc2_shift_sat(acc2_add(acc2_mul(vec2_load(&in[i]), vec2_load(&gains[i])), round), shift));
+            }
+        }
+    }
+#endif
+    if (gains == NULL)
+    {
+        for (; i < samples; i++)
+        {
+            out[i] = kal_sat32(((int64_t)in[i] * gain + half) >> shift);
+        }
+        return;
+    }
+    for (; i < samples; i++)
+    {
+        out[i] = kal_sat32(((int64_t)in[i] * gains[i] + half) >> shift);
+    }
+}
+
+/* The peak of apply_gains for two gains */
+static int64_t gain_peak(int32_t a, int32_t b)
+{
+    int64_t x = (a < 0) ? 1 - (int64_t)a : a;
+    int64_t y = (b < 0) ? 1 - (int64_t)b : b;
+
+    return (x > y) ? x : y;
+}
+
+/* The gains, or the ramp's gain, on a block of each channel, with its
+   exponent: the shift is 1 to 62 and the products truncate */
+static void apply_channels(const audio_proc_host_ramp *ramp, const int32_t *const *inputs, int32_t *const *outputs,
+                           unsigned channels, unsigned offset, const int32_t *gains, int64_t peak, unsigned samples)
+{
+    unsigned ch;
+
+    for (ch = 0; ch < channels; ch++)
+    {
+        apply_gains(&inputs[ch][offset], &outputs[ch][offset], gains, ramp->gain, peak, samples,
+                    31 - ramp->exponent, 0);
+    }
+}
+
+/* Point k of an exponential ramp's series. The first is the gain the ramp
+   starts from and the last the target. */
+static int32_t series_point(const audio_proc_host_ramp *ramp, unsigned k, unsigned num_points)
+{
+    double level;
+
+    if (k + 1 >= num_points)
+    {
+        return ramp->target;
+    }
+    level = floor(ramp->start_level * pow(ramp->ratio, (double)k));
+    return (level >= (double)INT32_MAX) ? INT32_MAX : (int32_t)level;
+}
+
+/* Set up the next piece of a ramp, from the gain now */
+static void start_piece(audio_proc_host_ramp *ramp)
+{
+    unsigned length = ramp->remaining;
+
+    ramp->segment_end = ramp->target;
+    if (ramp->shape == AUDIO_PROC_HOST_RAMP_EXPONENTIAL)
+    {
+        /* the pieces left, the last of them the shortest */
+        unsigned left = (ramp->remaining + AUDIO_PROC_HOST_RAMP_SEGMENT - 1) / AUDIO_PROC_HOST_RAMP_SEGMENT;
+
+        ramp->segment++;
+        length = (left > 1) ? AUDIO_PROC_HOST_RAMP_SEGMENT : ramp->remaining;
+        ramp->segment_end = series_point(ramp, ramp->segment, ramp->segment + left);
+    }
+    ramp->segment_left = length;
+    ramp->position = (int64_t)ramp->gain * ((int64_t)1 << 31);
+    ramp->step = ((int64_t)ramp->segment_end - ramp->gain) * ((int64_t)1 << 31) / (int64_t)length;
+}
+
+/* Start the ramp once its delay is over */
+static void begin_ramp(audio_proc_host_ramp *ramp)
+{
+    ramp->segment = 0;
+    ramp->segment_left = 0;
+    if (ramp->remaining == 0)
+    {
+        ramp->gain = ramp->target;
+    }
+}
+
+/* Samples of the fade out from sample counter before its gain goes
+   negative. The DSP's multiply and subtract wrap, so the gain is not
+   negative while the product is below 2^31. */
+static unsigned fade_out_length(uint32_t counter, unsigned samples)
+{
+    uint32_t fall = counter * (uint32_t)FADE_OUT_STEP;
+    uint32_t left;
+
+    if (fall > (uint32_t)INT32_MAX)
+    {
+        return 0;
+    }
+    left = ((uint32_t)INT32_MAX - fall) / FADE_OUT_STEP + 1;
+    return (left < samples) ? left : samples;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void audio_proc_host_stream_gain(const int32_t *input, int32_t *output, unsigned samples, int32_t mantissa,
+                                 int exponent)
+{
+    unsigned i;
+
+    if (exponent >= AUDIO_PROC_HOST_RAMP_MIN_EXPONENT && exponent <= AUDIO_PROC_HOST_RAMP_MAX_EXPONENT)
+    {
+        apply_gains(input, output, NULL, mantissa, gain_peak(mantissa, 0), samples, 31 - exponent, 0);
+        return;
+    }
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = kal_rmac_to_reg(KAL_MAC(input[i], mantissa), exponent);
+    }
+}
+
+void audio_proc_host_mute_control(int32_t *buffer, unsigned samples, int32_t state, int32_t mute_value)
+{
+    if (state == mute_value)
+    {
+        memset(buffer, 0, samples * sizeof(int32_t));
+    }
+}
+
+int audio_proc_host_ramp_init(audio_proc_host_ramp *ramp, int32_t gain, int exponent)
+{
+    if (exponent < AUDIO_PROC_HOST_RAMP_MIN_EXPONENT || exponent > AUDIO_PROC_HOST_RAMP_MAX_EXPONENT)
+    {
+        return 0;
+    }
+    memset(ramp, 0, sizeof(*ramp));
+    ramp->exponent = exponent;
+    ramp->gain = gain;
+    ramp->target = gain;
+    return 1;
+}
+
+void audio_proc_host_ramp_start(audio_proc_host_ramp *ramp, int32_t target, unsigned samples,
+                                audio_proc_host_ramp_shape shape, unsigned delay)
+{
+    ramp->target = target;
+    ramp->shape = shape;
+    ramp->delay = delay;
+    ramp->remaining = samples;
+    ramp->segment_left = 0;
+    if (shape == AUDIO_PROC_HOST_RAMP_EXPONENTIAL && samples > 0)
+    {
+        double from = (ramp->gain > RAMP_MIN_LEVEL) ? ramp->gain : RAMP_MIN_LEVEL;
+        double to = (target > RAMP_MIN_LEVEL) ? target : RAMP_MIN_LEVEL;
+
+        if (from == to)
+        {
+            /* both at or below -96 dB, or the same */
+            ramp->shape = AUDIO_PROC_HOST_RAMP_LINEAR;
+        }
+        ramp->start_level = from;
+        ramp->ratio = pow(to / from, (double)AUDIO_PROC_HOST_RAMP_SEGMENT / samples);
+    }
+    if (delay == 0)
+    {
+        begin_ramp(ramp);
+    }
+}
+
+unsigned audio_proc_host_ramp_ttp_delay(uint32_t start_time, uint32_t block_time, unsigned sample_rate)
+{
+    int32_t difference = (int32_t)(start_time - block_time);
+
+    if (difference <= 0)
+    {
+        return 0;
+    }
+    return (unsigned)(((uint64_t)difference * sample_rate + 500000) / 1000000);
+}
+
+int audio_proc_host_ramp_active(const audio_proc_host_ramp *ramp)
+{
+    return (ramp->delay > 0) || (ramp->remaining > 0);
+}
+
+void audio_proc_host_ramp_process(audio_proc_host_ramp *ramp, const int32_t *const *inputs,
+                                  int32_t *const *outputs, unsigned channels, unsigned samples)
+{
+    int32_t gains[RAMP_CHUNK];
+    unsigned done = 0;
+
+    while (done < samples)
+    {
+        unsigned n = samples - done;
+        unsigned i;
+
+        if (ramp->delay > 0 || ramp->remaining == 0)
+        {
+            /* a fixed gain, up to the end of the delay */
+            if (ramp->delay > 0 && ramp->delay < n)
+            {
+                n = ramp->delay;
+            }
+            apply_channels(ramp, inputs, outputs, channels, done, NULL, gain_peak(ramp->gain, 0), n);
+            if (ramp->delay > 0)
+            {
+                ramp->delay -= n;
+                if (ramp->delay == 0)
+                {
+                    begin_ramp(ramp);
+                }
+            }
+            done += n;
+            continue;
+        }
+
+        if (ramp->segment_left == 0)
+        {
+            start_piece(ramp);
+        }
+        n = (n < ramp->segment_left) ? n : ramp->segment_left;
+        n = (n < RAMP_CHUNK) ? n : RAMP_CHUNK;
+        for (i = 0; i < n; i++)
+        {
+            gains[i] = (int32_t)(ramp->position >> 31);
+            ramp->position += ramp->step;
+        }
+        /* the gains of a piece move one way, so the ends are the peak */
+        apply_channels(ramp, inputs, outputs, channels, done, gains, gain_peak(gains[0], gains[n - 1]), n);
+
+        ramp->segment_left -= n;
+        ramp->remaining -= n;
+        ramp->gain = (ramp->segment_left == 0) ? ramp->segment_end : (int32_t)(ramp->position >> 31);
+        done += n;
+    }
+}
+
+int audio_proc_host_fade_out_process(audio_proc_host_fade_out *fade, int32_t *const *buffers, unsigned channels,
+                                     unsigned samples)
+{
+    unsigned done = 0;
+    unsigned ch, i;
+    int finished = 0;
+
+    if (fade->state != AUDIO_PROC_HOST_FADE_OUT_FLUSHING && fade->state != AUDIO_PROC_HOST_FADE_OUT_END)
+    {
+        done = fade_out_length(fade->counter, samples);
+        for (ch = 0; ch < channels; ch++)
+        {
+            int32_t *buffer = buffers[ch];
+
+            /* the gains are up to just below unity, so the products round
+               into a word */
+            for (i = 0; i < done; i++)
+            {
+                int32_t gain = (int32_t)((uint32_t)INT32_MAX - (fade->counter + i) * (uint32_t)FADE_OUT_STEP);
+
+                buffer[i] = (int32_t)(((int64_t)buffer[i] * gain + ((int64_t)1 << 30)) >> 31);
+            }
+        }
+        if (done < samples)
+        {
+            fade->state = AUDIO_PROC_HOST_FADE_OUT_FLUSHING;
+        }
+    }
+
+    if (fade->state == AUDIO_PROC_HOST_FADE_OUT_FLUSHING)
+    {
+        /* flush_count counts down the samples zeroed, and the call that
+           takes it below zero ends the flush */
+        unsigned zeros = samples - done;
+
+        if (fade->flush_count >= zeros)
+        {
+            fade->flush_count -= zeros;
+        }
+        else
+        {
+            finished = 1;
+            fade->state = AUDIO_PROC_HOST_FADE_OUT_END;
+            fade->flush_count = 0;
+        }
+    }
+    if (done < samples)
+    {
+        for (ch = 0; ch < channels; ch++)
+        {
+            memset(&buffers[ch][done], 0, (samples - done) * sizeof(int32_t));
+        }
+    }
+
+    fade->counter += samples;
+    return finished;
+}
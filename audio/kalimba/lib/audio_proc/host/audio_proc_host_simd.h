@@ -0,0 +1,203 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_simd.h
+ * \ingroup audio_proc
+ *
+ * Two channel SIMD helpers of the host audio_proc port. <br>
+ *
+ * A pair of channels is held as two 32 bit words, and their sums of
+ * products as two 64 bit values. A 64 bit sum is exact only while it is
+ * within +-2^63, so the users also keep a coarse sum of the top bits of
+ * each product, and check it before the sum is used.
+ */
+
+#ifndef AUDIO_PROC_HOST_SIMD_H
+#define AUDIO_PROC_HOST_SIMD_H
+
+/****************************************************************************
+Include Files
+*/
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define AUDIO_PROC_HOST_SSE4_1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUDIO_PROC_HOST_NEON
+#endif
+
+#include <stdint.h>
+
+/****************************************************************************
+Private Function Definitions
+*/
+#if defined(AUDIO_PROC_HOST_SSE4_1)
+
+/* Two channels, each in the low word of a 64 bit lane */
+typedef __m128i vec2;
+
+/* Two 64 bit sums */
+typedef __m128i acc2;
+
+/* Two coarse sums, in the high words of the 64 bit lanes */
+typedef __m128i est2;
+
+static inline vec2 vec2_load(const int32_t *p)
+{
+    return _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i *)p));
+}
+
+static inline void vec2_store(int32_t *p, vec2 v)
+{
+    _mm_storel_epi64((__m128i *)p, _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+static inline vec2 vec2_set(int32_t lane0, int32_t lane1)
+{
+    return _mm_set_epi32(0, lane1, 0, lane0);
+}
+
+static inline int32_t vec2_lane(vec2 v, int lane)
+{
+    return lane ? _mm_extract_epi32(v, 2) : _mm_cvtsi128_si32(v);
+}
+
+#define vec2_dup(x)         _mm_set1_epi32(x)
+#define acc2_mul(a, b)      _mm_mul_epi32((a), (b))
+#define acc2_add(a, b)      _mm_add_epi64((a), (b))
+#define acc2_sub(a, b)      _mm_sub_epi64((a), (b))
+#define acc2_dup(x)         _mm_set1_epi64x(x)
+#define acc2_store(p, a)    _mm_storeu_si128((__m128i *)(p), (a))
+
+/* vec2 lanes are already sign extended to 64 bits */
+#define acc2_widen(v)       (v)
+#define acc2_shl(a, shift)  _mm_sll_epi64((a), _mm_cvtsi32_si128(shift))
+
+/* floor(t / 2^shift) where it is known to fit a word, shift 1 to 32: the
+   low word of a logical shift is the same as of an arithmetic one */
+#define acc2_shift(a, shift) _mm_srl_epi64((a), _mm_cvtsi32_si128(shift))
+
+/* floor(p / 2^shift) of a product, shift 32 to 63 */
+#define est2_product(p, shift) _mm_srai_epi32((p), (shift) - 32)
+#define est2_add(a, b)      _mm_add_epi32((a), (b))
+#define est2_sub(a, b)      _mm_sub_epi32((a), (b))
+
+/* Non-zero if a coarse sum of either lane is outside +-limit */
+static inline int est2_out_of_range(est2 h, int32_t limit)
+{
+    __m128i out = _mm_or_si128(_mm_cmpgt_epi32(h, _mm_set1_epi32(limit)),
+                               _mm_cmplt_epi32(h, _mm_set1_epi32(-limit)));
+
+    return _mm_movemask_ps(_mm_castsi128_ps(out)) & 0xA;
+}
+
+/* sat32(floor(t / 2^shift)), for |t| < 2^63 and shift 1 to 62. SSE4.1 has
+   no 64 bit arithmetic shift or compare, so t is offset by 2^63 and shifted
+   logically, and it is in range when t + 2^(31 + shift) has no bits above
+   bit 31 + shift. */
+static inline vec2 acc2_shift_sat(acc2 t, int shift)
+{
+    const __m128i sign_bit = _mm_set1_epi64x(INT64_MIN);
+    __m128i value = _mm_sub_epi64(_mm_srl_epi64(_mm_xor_si128(t, sign_bit), _mm_cvtsi32_si128(shift)),
+                                  _mm_set1_epi64x((int64_t)1 << (63 - shift)));
+    __m128i in_range, negative;
+
+    if (shift > 31)
+    {
+        return value;
+    }
+    in_range = _mm_cmpeq_epi64(_mm_srl_epi64(_mm_add_epi64(t, _mm_set1_epi64x((int64_t)1 << (31 + shift))),
+                                             _mm_cvtsi32_si128(32 + shift)),
+                               _mm_setzero_si128());
+    negative = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    return _mm_blendv_epi8(_mm_sub_epi32(_mm_set1_epi32(INT32_MAX), negative), value, in_range);
+}
+
+/* |v|, saturating the most negative value. _mm_abs_epi32 leaves it as
+   2^31 unsigned. */
+static inline vec2 vec2_abs_sat(vec2 v)
+{
+    return _mm_min_epu32(_mm_abs_epi32(v), _mm_set1_epi32(INT32_MAX));
+}
+
+#define vec2_max(a, b)      _mm_max_epi32((a), (b))
+
+/* Lanes of x where a > b, of y elsewhere */
+static inline vec2 vec2_select_gt(vec2 a, vec2 b, vec2 x, vec2 y)
+{
+    return _mm_blendv_epi8(y, x, _mm_cmpgt_epi32(a, b));
+}
+
+/* sat32(v << shift) or v >> -shift, for shift -31 to 30 */
+static inline vec2 vec2_ashift_sat(vec2 v, int shift)
+{
+    __m128i shifted, negative;
+
+    if (shift < 0)
+    {
+        return _mm_sra_epi32(v, _mm_cvtsi32_si128(-shift));
+    }
+    shifted = _mm_sll_epi32(v, _mm_cvtsi32_si128(shift));
+    negative = _mm_srai_epi32(v, 31);
+    return _mm_blendv_epi8(_mm_sub_epi32(_mm_set1_epi32(INT32_MAX), negative), shifted,
+                           _mm_cmpeq_epi32(_mm_sra_epi32(shifted, _mm_cvtsi32_si128(shift)), v));
+}
+
+#elif defined(AUDIO_PROC_HOST_NEON)
+
+typedef int32x2_t vec2;
+typedef int64x2_t acc2;
+typedef int32x2_t est2;
+
+#define vec2_load(p)        vld1_s32(p)
+#define vec2_store(p, v)    vst1_s32((p), (v))
+#define vec2_dup(x)         vdup_n_s32(x)
+#define acc2_mul(a, b)      vmull_s32((a), (b))
+#define acc2_add(a, b)      vaddq_s64((a), (b))
+#define acc2_sub(a, b)      vsubq_s64((a), (b))
+#define acc2_dup(x)         vdupq_n_s64(x)
+#define acc2_store(p, a)    vst1q_s64((p), (a))
+#define acc2_widen(v)       vmovl_s32(v)
+#define acc2_shl(a, shift)  vshlq_s64((a), vdupq_n_s64(shift))
+#define acc2_shift(a, shift) vmovn_s64(vshlq_s64((a), vdupq_n_s64(-(shift))))
+#define est2_product(p, shift) vmovn_s64(vshrq_n_s64((p), (shift)))
+#define est2_add(a, b)      vadd_s32((a), (b))
+#define est2_sub(a, b)      vsub_s32((a), (b))
+#define vec2_abs_sat(v)     vqabs_s32(v)
+#define vec2_max(a, b)      vmax_s32((a), (b))
+#define vec2_select_gt(a, b, x, y) vbsl_s32(vcgt_s32((a), (b)), (x), (y))
+
+static inline vec2 vec2_set(int32_t lane0, int32_t lane1)
+{
+    return vset_lane_s32(lane1, vdup_n_s32(lane0), 1);
+}
+
+static inline int32_t vec2_lane(vec2 v, int lane)
+{
+    return lane ? vget_lane_s32(v, 1) : vget_lane_s32(v, 0);
+}
+
+static inline int est2_out_of_range(est2 h, int32_t limit)
+{
+    uint32x2_t out = vorr_u32(vcgt_s32(h, vdup_n_s32(limit)), vclt_s32(h, vdup_n_s32(-limit)));
+
+    return vget_lane_u64(vreinterpret_u64_u32(out), 0) != 0;
+}
+
+/* vshlq_s64 by a negative count is an arithmetic shift right and vqmovn_s64
+   saturates */
+static inline vec2 acc2_shift_sat(acc2 t, int shift)
+{
+    return vqmovn_s64(vshlq_s64(t, vdupq_n_s64(-shift)));
+}
+
+/* vqshl_s32 saturates left shifts and truncates right shifts */
+static inline vec2 vec2_ashift_sat(vec2 v, int shift)
+{
+    return vqshl_s32(v, vdup_n_s32(shift));
+}
+
+#endif
+
+#endif /* AUDIO_PROC_HOST_SIMD_H */
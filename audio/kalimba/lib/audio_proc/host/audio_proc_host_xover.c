@@ -0,0 +1,82 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  audio_proc_host_xover.c
+ * \ingroup audio_proc
+ *
+ * Host port of the 2 band crossover of xover.asm,
+ * $audio_proc.xover_2band.stream_process. <br>
+ *
+ * The low and high bands are the input through two PEQ objects, with the
+ * coefficients made by $audio_proc.xover.initialize. For the APC filter
+ * type the bands are then half the sum and half the difference of the two
+ * filter outputs.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "audio_proc_host_private.h"
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void audio_proc_host_xover_init(audio_proc_host_xover *xover, audio_proc_host_peq_core core,
+                                unsigned num_channels, int apc, unsigned config)
+{
+    audio_proc_host_peq_init(&xover->low, core, num_channels);
+    audio_proc_host_peq_init(&xover->high, core, num_channels);
+    xover->apc = apc;
+    xover->config = config;
+}
+
+int audio_proc_host_xover_set_params(audio_proc_host_xover *xover, const int32_t *low_params,
+                                     const int32_t *high_params)
+{
+    int low_ok = audio_proc_host_peq_set_params(&xover->low, low_params, 0);
+    int high_ok = audio_proc_host_peq_set_params(&xover->high, high_params, 0);
+
+    return low_ok && high_ok;
+}
+
+void audio_proc_host_xover_process(audio_proc_host_xover *xover, const int32_t *input,
+                                   int32_t *low, int32_t *high, unsigned samples)
+{
+    unsigned total = samples * xover->low.num_channels;
+    int32_t low_gain = INT32_MAX;
+    int32_t high_gain = INT32_MIN;
+    unsigned i;
+
+    audio_proc_host_peq_process(&xover->low, input, low, samples);
+    audio_proc_host_peq_process(&xover->high, input, high, samples);
+    if (!xover->apc)
+    {
+        return;
+    }
+
+    /* the band multipliers, chosen as the DSP does: r5 = 1.0, r6 = -1.0,
+       r5 = r6 for an inverted band 1, then r6 = r5 unless band 2 is
+       inverted */
+    if (xover->config & AUDIO_PROC_HOST_XOVER_INV_BAND1)
+    {
+        low_gain = high_gain;
+    }
+    if (!(xover->config & AUDIO_PROC_HOST_XOVER_INV_BAND2))
+    {
+        high_gain = low_gain;
+    }
+    low_gain = kal_frac_mult(low_gain, 0x40000000);
+    high_gain = kal_frac_mult(high_gain, 0x40000000);
+
+    for (i = 0; i < total; i++)
+    {
+        int32_t h = high[i];
+        int32_t l = low[i];
+
+        high[i] = kal_frac_mac(kal_frac_mult(h, high_gain), l, high_gain);
+        low[i] = kal_frac_mac(kal_frac_mult(l, low_gain), h, -low_gain);
+    }
+}
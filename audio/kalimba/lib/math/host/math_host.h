@@ -0,0 +1,237 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host.h
+ * \ingroup math
+ *
+ * Host (PC) port of parts of the Kalimba math library: the FFT and the
+ * median filter, and block versions of the elementary functions. <br>
+ *
+ * The functions give the same results as the arch4 (K32) assembly in the
+ * parent directory: the same tables, the same order of rMAC accumulates and
+ * the same rounding and saturation when rMAC is used as a 32 bit value. The
+ * inner loops have SSE4.1 and NEON versions which give the same results as
+ * the scalar versions. The median filter also has a sliding version which
+ * gives the same output from two heaps, at O(log N) a sample in place of
+ * the DSP's O(N).
+ *
+ * The elementary functions are not ports: sqrt.asm, log2.asm, pow2.asm,
+ * sin.asm, cos.asm, atan.asm, inv_qdrt.asm and div48.asm each take one
+ * value a call, at the one accuracy of their polynomial. The block versions
+ * take the same formats, a buffer at a time, at an accuracy the caller
+ * selects: each reduces the argument to a segment of a table and sums 3, 4
+ * or 5 terms of the function's Chebyshev series there.
+ *
+ * This directory is not part of the Kalimba library build. To build the
+ * benchmark on a PC:
+ *
+ *     cc -O2 -msse4.1 -o math_host_bench *.c -lm
+ *
+ * (no -msse4.1 on ARM, where NEON is used when the compiler enables it).
+ */
+
+#ifndef MATH_HOST_H
+#define MATH_HOST_H
+
+/****************************************************************************
+Include Files
+*/
+#include <stdint.h>
+
+/****************************************************************************
+Public Constant Declarations
+*/
+
+/** Largest FFT, the size of the largest twiddle table of fft_twiddle.h */
+#define MATH_HOST_FFT_MAX_POINTS        2048
+
+/** Longest window of a sliding median */
+#define MATH_HOST_MEDIAN_FILTER_MAX_LENGTH 1024
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/**
+ * Accuracy of the block elementary functions: the largest absolute error
+ * of a result is 2^-bits, in the units of the result (1.0 for a fraction,
+ * one octave for log2, pi for an angle). sqrt.asm is about as accurate as
+ * the 16 bit tier and sin.asm as the 20 bit tier.
+ */
+typedef enum
+{
+    MATH_HOST_ACCURACY_16_BITS = 16,
+    MATH_HOST_ACCURACY_20_BITS = 20,
+    MATH_HOST_ACCURACY_24_BITS = 24
+} math_host_accuracy;
+
+/** FFT structure, as $fft.STRUC in fft.h */
+typedef struct
+{
+    unsigned num_points;            /**< power of 2, 2 to MATH_HOST_FFT_MAX_POINTS */
+    int32_t *real;                  /**< real data, replaced by the output */
+    int32_t *imag;                  /**< imaginary data, replaced by the output */
+} math_host_fft_struct;
+
+/**
+ * Sliding median of the last length samples. Each sample has a slot, taken
+ * in turn, and the slots are kept in two heaps: the smaller half of the
+ * window in a max-heap at heap[0 .. num_low - 1], the larger half in a
+ * min-heap after it. values holds the sample of each heap entry.
+ */
+typedef struct
+{
+    unsigned length;
+    unsigned num_low;               /**< length - length / 2 */
+    unsigned oldest;                /**< slot the next sample replaces */
+    int32_t values[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH];
+    uint16_t heap[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH];      /**< slot of each heap entry */
+    uint16_t position[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH];  /**< heap entry of each slot */
+} math_host_sliding_median;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief Select the SIMD or scalar inner loops. The SIMD loops are used by
+ *        default when the build has them.
+ */
+extern void math_host_set_simd(int enable);
+
+/**
+ * \brief In place FFT with no scaling, as $math.fft. The output is in bit
+ *        reversed order.
+ */
+extern void math_host_fft(const math_host_fft_struct *fft);
+
+/**
+ * \brief In place IFFT scaled by 0.5 at each stage, as $math.ifft. The
+ *        output is in bit reversed order.
+ */
+extern void math_host_ifft(const math_host_fft_struct *fft);
+
+/**
+ * \brief In place FFT scaled by scale at each stage, as
+ *        $math.scaleable_fft with r8 = scale.
+ */
+extern void math_host_scaleable_fft(const math_host_fft_struct *fft, int32_t scale);
+
+/**
+ * \brief In place IFFT scaled by scale at each stage, as
+ *        $math.scaleable_ifft with r8 = scale.
+ */
+extern void math_host_scaleable_ifft(const math_host_fft_struct *fft, int32_t scale);
+
+/**
+ * \brief Copy an array to bit reversed positions, as $math.bitreverse_array.
+ *        in and out must not overlap.
+ */
+extern void math_host_bitreverse_array(const int32_t *in, int32_t *out, unsigned size);
+
+/**
+ * \brief Fill the buffers of a median filter with a value, as
+ *        $math.median_filter_initialise.
+ *
+ * \param history Window, length words, kept sorted largest first.
+ * \param index Age of each history entry, length words.
+ * \param length Filter length.
+ * \param value Initial value.
+ */
+extern void math_host_median_filter_initialise(int32_t *history, int32_t *index, unsigned length,
+                                               int32_t value);
+
+/**
+ * \brief Add a sample to a median filter and return the median of the last
+ *        length samples, as $math.median_filter_process. An even length
+ *        gives the mean of the two middle values. Takes O(length) a sample.
+ */
+extern int32_t math_host_median_filter_process(int32_t *history, int32_t *index, unsigned length,
+                                               int32_t sample);
+
+/**
+ * \brief Set up a sliding median with every sample of the window at value,
+ *        as math_host_median_filter_initialise.
+ *
+ * \return Zero if length is 0 or above MATH_HOST_MEDIAN_FILTER_MAX_LENGTH,
+ *         non-zero otherwise.
+ */
+extern int math_host_sliding_median_init(math_host_sliding_median *median, unsigned length, int32_t value);
+
+/**
+ * \brief Add a sample and return the median, the same value as
+ *        math_host_median_filter_process gives. Takes O(log length) a
+ *        sample.
+ */
+extern int32_t math_host_sliding_median_process(math_host_sliding_median *median, int32_t sample);
+
+/**
+ * \brief math_host_sliding_median_process on each of a block of samples.
+ *        output may be input.
+ */
+extern void math_host_sliding_median_block(math_host_sliding_median *median, const int32_t *input,
+                                           int32_t *output, unsigned samples);
+
+/**
+ * \brief Square roots of a block, in the formats of $math.sqrt: input and
+ *        output fractions, with zero for an input of zero or below.
+ *        output may be input, here and in the other block functions.
+ */
+extern void math_host_sqrt_block(const int32_t *input, int32_t *output, unsigned samples,
+                                 math_host_accuracy accuracy);
+
+/**
+ * \brief log2 of a block of fractions, as $math.log2_table with the input
+ *        in the top word of rMAC. The output is in Q8.24; zero and
+ *        negative inputs give -64.0, log2(0) of $math.log2_table.
+ */
+extern void math_host_log2_block(const int32_t *input, int32_t *output, unsigned samples,
+                                 math_host_accuracy accuracy);
+
+/**
+ * \brief 2^x of a block of x in Q8.24, as $math.pow2_sat_table. The output
+ *        is a fraction, saturated to 1.0 for x of zero and above.
+ */
+extern void math_host_pow2_block(const int32_t *input, int32_t *output, unsigned samples,
+                                 math_host_accuracy accuracy);
+
+/**
+ * \brief Sine of a block of angles, as $math.sin: -1.0 is -180 degrees and
+ *        1.0 is 180 degrees. 90 degrees gives 1.0 saturated.
+ */
+extern void math_host_sin_block(const int32_t *input, int32_t *output, unsigned samples,
+                                math_host_accuracy accuracy);
+
+/**
+ * \brief Cosine of a block of angles, as $math.cos.
+ */
+extern void math_host_cos_block(const int32_t *input, int32_t *output, unsigned samples,
+                                math_host_accuracy accuracy);
+
+/**
+ * \brief Angle of each complex value of a block, as $math.atan: -1.0 is
+ *        -180 degrees and 1.0 is 180 degrees. The negative real axis gives
+ *        -1.0 and zero gives zero.
+ */
+extern void math_host_atan_block(const int32_t *real, const int32_t *imag, int32_t *output,
+                                 unsigned samples, math_host_accuracy accuracy);
+
+/**
+ * \brief x^-0.25 / 512 of a block of fractions, the value $math.inv_qdrt
+ *        gives for x as mantissa and exponent. Zero and negative inputs
+ *        give zero.
+ */
+extern void math_host_inv_qdrt_block(const int32_t *input, int32_t *output, unsigned samples,
+                                     math_host_accuracy accuracy);
+
+/**
+ * \brief Fractional quotients num / denom of a block, as $math.div48 on
+ *        words. The quotient is saturated to 0 to 1.0: zero for num of zero
+ *        or below and 1.0 for num of denom or above, or denom of zero or
+ *        below.
+ */
+extern void math_host_div_block(const int32_t *num, const int32_t *denom, int32_t *output,
+                                unsigned samples, math_host_accuracy accuracy);
+
+#endif /* MATH_HOST_H */
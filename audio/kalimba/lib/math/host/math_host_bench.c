@@ -0,0 +1,712 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host_bench.c
+ * \ingroup math
+ *
+ * Benchmark and regression tool for the host math port. <br>
+ *
+ * Checks each function against a plain model of the assembly, with the
+ * SIMD loops and without, then reports the speed of each version. The
+ * median filter and the sliding median are checked against a sort of the
+ * window, for every length to 64 and random lengths to the maximum, and
+ * timed for a range of lengths. The block elementary functions are checked
+ * against double precision for the largest error of each accuracy tier,
+ * and timed a block at a time and a value a call. Returns non-zero on any
+ * mismatch, or an error above a tier's bound.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "math_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define FFT_TEST_RUNS       20
+#define BENCH_SECONDS       0.2
+#define MEDIAN_TEST_RUNS    300
+#define MEDIAN_TEST_SAMPLES 2000
+#define MEDIAN_BENCH_SAMPLES 4096
+#define ELEMENTARY_TEST_SAMPLES 200000
+#define ELEMENTARY_BENCH_SAMPLES 256
+
+/****************************************************************************
+Private Type Declarations
+*/
+typedef enum
+{
+    ELEMENTARY_SQRT,
+    ELEMENTARY_LOG2,
+    ELEMENTARY_POW2,
+    ELEMENTARY_SIN,
+    ELEMENTARY_COS,
+    ELEMENTARY_ATAN,
+    ELEMENTARY_INV_QDRT,
+    ELEMENTARY_DIV,
+    ELEMENTARY_FUNCTIONS
+} elementary_function;
+
+/****************************************************************************
+Private Constant Declarations
+*/
+static const char *const elementary_names[ELEMENTARY_FUNCTIONS] =
+{
+    "sqrt", "log2", "pow2", "sin", "cos", "atan", "inv_qdrt", "div"
+};
+
+static const math_host_accuracy accuracies[] =
+{
+    MATH_HOST_ACCURACY_16_BITS, MATH_HOST_ACCURACY_20_BITS, MATH_HOST_ACCURACY_24_BITS
+};
+
+/****************************************************************************
+Private Variable Definitions
+*/
+static uint32_t random_state = 1;
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* The LCG state through a mixing function. The low bits of the state
+   repeat with short periods, so tests that take a few bits of a word get
+   the mixed bits instead. */
+static int32_t random_word(void)
+{
+    uint32_t x;
+
+    random_state = random_state * 1664525u + 1013904223u;
+    x = random_state;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return (int32_t)x;
+}
+
+/* The stage, group and butterfly loops of fft.asm written out directly,
+   with rMAC as a 128 bit accumulator. scaled selects $math.scaleable_fft
+   with r8 and r7, otherwise $math.fft. */
+static void reference_fft(int32_t *re, int32_t *im, unsigned n, int scaled, int32_t r8, int32_t r7)
+{
+    unsigned node_space, groups, j, k;
+
+    for (node_space = n / 2, groups = 1; node_space >= 1; node_space /= 2, groups *= 2)
+    {
+        for (j = 0; j < groups; j++)
+        {
+            int32_t c = math_host_fft_twiddle_real[j];
+            int32_t ns = math_host_fft_twiddle_imag[j];
+
+            if (scaled)
+            {
+                c = kal_frac_mult(c, r8);
+                ns = kal_frac_mult(ns, r7);
+            }
+            for (k = 2 * node_space * j; k < 2 * node_space * j + node_space; k++)
+            {
+                __int128 rmacb = (__int128)((int64_t)re[k + node_space] * c) * 2
+                               - (__int128)((int64_t)im[k + node_space] * ns) * 2;
+                __int128 rmac = (__int128)((int64_t)re[k + node_space] * ns) * 2
+                              + (__int128)((int64_t)im[k + node_space] * c) * 2;
+                int32_t x_mac = kal_sat32((int64_t)((rmacb + ((__int128)1 << 31)) >> 32));
+                int32_t y_mac = kal_sat32((int64_t)((rmac + ((__int128)1 << 31)) >> 32));
+                int32_t x0 = scaled ? kal_frac_mult(re[k], r8) : re[k];
+                int32_t y0 = scaled ? kal_frac_mult(im[k], r8) : im[k];
+
+                re[k] = kal_add(x0, x_mac);
+                re[k + node_space] = kal_sub(x0, x_mac);
+                im[k] = kal_add(y0, y_mac);
+                im[k + node_space] = kal_sub(y0, y_mac);
+            }
+        }
+    }
+}
+
+/* Run one of the library transforms. kind: 0 fft, 1 ifft, 2 scaleable fft,
+   3 scaleable ifft */
+static void library_fft(int kind, int32_t *re, int32_t *im, unsigned n, int32_t scale)
+{
+    math_host_fft_struct fft;
+
+    fft.num_points = n;
+    fft.real = re;
+    fft.imag = im;
+    switch (kind)
+    {
+        case 0:
+            math_host_fft(&fft);
+            break;
+        case 1:
+            math_host_ifft(&fft);
+            break;
+        case 2:
+            math_host_scaleable_fft(&fft, scale);
+            break;
+        default:
+            math_host_scaleable_ifft(&fft, scale);
+            break;
+    }
+}
+
+static void reference_kind(int kind, int32_t *re, int32_t *im, unsigned n, int32_t scale)
+{
+    switch (kind)
+    {
+        case 0:
+            reference_fft(re, im, n, 0, 0, 0);
+            break;
+        case 1:
+            reference_fft(re, im, n, 1, 0x40000000, (int32_t)0xC0000000);
+            break;
+        case 2:
+            reference_fft(re, im, n, 1, scale, scale);
+            break;
+        default:
+            reference_fft(re, im, n, 1, scale, kal_sub(0, scale));
+            break;
+    }
+}
+
+/* Compare the library with the model, with and without SIMD, on random
+   data of several amplitudes including ones that saturate and wrap */
+static int check_fft(void)
+{
+    static const char *names[] = {"fft", "ifft", "scaleable_fft", "scaleable_ifft"};
+    static int32_t in_re[MATH_HOST_FFT_MAX_POINTS], in_im[MATH_HOST_FFT_MAX_POINTS];
+    static int32_t ref_re[MATH_HOST_FFT_MAX_POINTS], ref_im[MATH_HOST_FFT_MAX_POINTS];
+    static int32_t out_re[MATH_HOST_FFT_MAX_POINTS], out_im[MATH_HOST_FFT_MAX_POINTS];
+    int failures = 0;
+    unsigned n, run, i;
+    int kind, simd;
+
+    for (n = 2; n <= MATH_HOST_FFT_MAX_POINTS; n *= 2)
+    {
+        for (kind = 0; kind < 4; kind++)
+        {
+            for (run = 0; run < FFT_TEST_RUNS; run++)
+            {
+                int shift = (int)(run % 12);
+                int32_t scale = (run % 3) ? random_word() : 0x7FFFFFFF;
+
+                for (i = 0; i < n; i++)
+                {
+                    in_re[i] = random_word() >> shift;
+                    in_im[i] = random_word() >> shift;
+                }
+                memcpy(ref_re, in_re, n * sizeof(int32_t));
+                memcpy(ref_im, in_im, n * sizeof(int32_t));
+                reference_kind(kind, ref_re, ref_im, n, scale);
+
+                for (simd = 0; simd < 2; simd++)
+                {
+                    math_host_set_simd(simd);
+                    memcpy(out_re, in_re, n * sizeof(int32_t));
+                    memcpy(out_im, in_im, n * sizeof(int32_t));
+                    library_fft(kind, out_re, out_im, n, scale);
+                    if (memcmp(out_re, ref_re, n * sizeof(int32_t)) || memcmp(out_im, ref_im, n * sizeof(int32_t)))
+                    {
+                        printf("FAIL: %s %u points %s differs from the model\n", names[kind], n,
+                               simd ? "simd" : "scalar");
+                        failures++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    math_host_set_simd(1);
+    return failures;
+}
+
+/* Error of the FFT and IFFT against a double precision DFT, which shows
+   the scaling: the FFT is unscaled and the IFFT is scaled by 1/N */
+static void fft_accuracy(unsigned n)
+{
+    static int32_t re[MATH_HOST_FFT_MAX_POINTS], im[MATH_HOST_FFT_MAX_POINTS];
+    static int32_t br_re[MATH_HOST_FFT_MAX_POINTS], br_im[MATH_HOST_FFT_MAX_POINTS];
+    static double in_re[MATH_HOST_FFT_MAX_POINTS], in_im[MATH_HOST_FFT_MAX_POINTS];
+    math_host_fft_struct fft;
+    double snr[2];
+    int inverse;
+    unsigned i, k;
+
+    fft.num_points = n;
+    fft.real = re;
+    fft.imag = im;
+    for (inverse = 0; inverse < 2; inverse++)
+    {
+        double signal = 0.0, noise = 0.0;
+
+        for (i = 0; i < n; i++)
+        {
+            /* keep the unscaled FFT in range */
+            re[i] = inverse ? random_word() >> 2 : (int32_t)(random_word() / (int32_t)(2 * n));
+            im[i] = inverse ? random_word() >> 2 : (int32_t)(random_word() / (int32_t)(2 * n));
+            in_re[i] = re[i];
+            in_im[i] = im[i];
+        }
+        if (inverse)
+        {
+            math_host_ifft(&fft);
+        }
+        else
+        {
+            math_host_fft(&fft);
+        }
+        math_host_bitreverse_array(re, br_re, n);
+        math_host_bitreverse_array(im, br_im, n);
+
+        for (k = 0; k < n; k++)
+        {
+            double sum_re = 0.0, sum_im = 0.0;
+
+            for (i = 0; i < n; i++)
+            {
+                double w = (inverse ? 2.0 : -2.0) * M_PI * (double)((i * k) % n) / n;
+
+                sum_re += in_re[i] * cos(w) - in_im[i] * sin(w);
+                sum_im += in_re[i] * sin(w) + in_im[i] * cos(w);
+            }
+            if (inverse)
+            {
+                sum_re /= n;
+                sum_im /= n;
+            }
+            signal += sum_re * sum_re + sum_im * sum_im;
+            noise += (br_re[k] - sum_re) * (br_re[k] - sum_re) + (br_im[k] - sum_im) * (br_im[k] - sum_im);
+        }
+        snr[inverse] = 10.0 * log10(signal / noise);
+    }
+    printf("  %4u points: fft SNR %.1fdB, ifft SNR %.1fdB\n", n, snr[0], snr[1]);
+}
+
+/* Time one transform, in ns */
+static double time_fft(int version, unsigned n)
+{
+    static int32_t re[MATH_HOST_FFT_MAX_POINTS], im[MATH_HOST_FFT_MAX_POINTS];
+    math_host_fft_struct fft;
+    unsigned runs = 0;
+    unsigned i;
+    clock_t start;
+    double elapsed;
+
+    for (i = 0; i < n; i++)
+    {
+        re[i] = random_word() >> 12;
+        im[i] = random_word() >> 12;
+    }
+    fft.num_points = n;
+    fft.real = re;
+    fft.imag = im;
+    math_host_set_simd(version == 2);
+
+    start = clock();
+    do
+    {
+        for (i = 0; i < 64; i++)
+        {
+            if (version == 0)
+            {
+                reference_fft(re, im, n, 0, 0, 0);
+            }
+            else
+            {
+                math_host_fft(&fft);
+            }
+        }
+        runs += 64;
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    math_host_set_simd(1);
+    return elapsed * 1e9 / runs;
+}
+
+static int run_fft(void)
+{
+    int failures = check_fft();
+    unsigned n;
+
+    printf("fft: %s\n", failures ? "FAILED" : "library matches the model for 2 to 2048 points");
+    for (n = 64; n <= 1024; n *= 2)
+    {
+        fft_accuracy(n);
+    }
+    for (n = 64; n <= 1024; n *= 2)
+    {
+        double radix2 = time_fft(0, n);
+        double radix4 = time_fft(1, n);
+        double simd = time_fft(2, n);
+
+        printf("  %4u points: radix 2 model %8.0fns, radix 4 %8.0fns (%.1fx), simd %8.0fns (%.1fx)\n",
+               n, radix2, radix4, radix2 / radix4, simd, radix2 / simd);
+    }
+    return failures;
+}
+
+/* A test sample: mostly small values, so the window has ties, with some
+   near the ends of the range to reach the overflow of an even median */
+static int32_t median_sample(void)
+{
+    uint32_t kind = (uint32_t)random_word() >> 29;
+
+    if (kind == 0)
+    {
+        return (random_word() < 0) ? INT32_MIN + (random_word() & 7) : INT32_MAX - (random_word() & 7);
+    }
+    if (kind < 4)
+    {
+        return random_word() >> 28;
+    }
+    return random_word();
+}
+
+static int compare_words(const void *a, const void *b)
+{
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Median of the last length samples of a stream, by sorting them */
+static int32_t reference_median(const int32_t *window, unsigned length)
+{
+    static int32_t sorted[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH];
+    int64_t sum;
+
+    memcpy(sorted, window, length * sizeof(int32_t));
+    qsort(sorted, length, sizeof(int32_t), compare_words);
+    if (length & 1)
+    {
+        return sorted[length / 2];
+    }
+    sum = (int64_t)sorted[length / 2 - 1] + sorted[length / 2];
+    if ((sum > INT32_MAX) || (sum < INT32_MIN))
+    {
+        return (sorted[length / 2 - 1] >> 1) + (sorted[length / 2] >> 1);
+    }
+    return (int32_t)(sum >> 1);
+}
+
+static int check_median(void)
+{
+    static int32_t stream[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH + MEDIAN_TEST_SAMPLES];
+    static int32_t history[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH], index[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH];
+    static int32_t block[MEDIAN_TEST_SAMPLES];
+    static math_host_sliding_median median;
+    int failures = 0;
+    unsigned run, i;
+
+    for (run = 0; run < MEDIAN_TEST_RUNS; run++)
+    {
+        unsigned length = (run < 64) ? run + 1 : 1 + ((uint32_t)random_word() % MATH_HOST_MEDIAN_FILTER_MAX_LENGTH);
+        int32_t initial = median_sample();
+
+        for (i = 0; i < length; i++)
+        {
+            stream[i] = initial;
+        }
+        for (i = 0; i < MEDIAN_TEST_SAMPLES; i++)
+        {
+            stream[length + i] = median_sample();
+        }
+        math_host_median_filter_initialise(history, index, length, initial);
+        math_host_sliding_median_init(&median, length, initial);
+        math_host_sliding_median_block(&median, &stream[length], block, MEDIAN_TEST_SAMPLES);
+
+        for (i = 0; i < MEDIAN_TEST_SAMPLES; i++)
+        {
+            int32_t expected = reference_median(&stream[i + 1], length);
+            int32_t dsp = math_host_median_filter_process(history, index, length, stream[length + i]);
+
+            if ((dsp != expected) || (block[i] != expected))
+            {
+                printf("FAIL: median of %u, sample %u: dsp %d, sliding %d, expected %d\n", length, i, dsp,
+                       block[i], expected);
+                failures++;
+                break;
+            }
+        }
+    }
+    return failures;
+}
+
+/* Time one sample, in ns */
+static double time_median(int sliding, unsigned length)
+{
+    static int32_t history[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH], index[MATH_HOST_MEDIAN_FILTER_MAX_LENGTH];
+    static int32_t samples[MEDIAN_BENCH_SAMPLES];
+    static math_host_sliding_median median;
+    unsigned runs = 0;
+    unsigned i;
+    clock_t start;
+    double elapsed;
+    int32_t sink = 0;
+
+    for (i = 0; i < MEDIAN_BENCH_SAMPLES; i++)
+    {
+        samples[i] = random_word() >> 8;
+    }
+    math_host_median_filter_initialise(history, index, length, 0);
+    math_host_sliding_median_init(&median, length, 0);
+
+    start = clock();
+    do
+    {
+        for (i = 0; i < MEDIAN_BENCH_SAMPLES; i++)
+        {
+            if (sliding)
+            {
+                sink ^= math_host_sliding_median_process(&median, samples[i]);
+            }
+            else
+            {
+                sink ^= math_host_median_filter_process(history, index, length, samples[i]);
+            }
+        }
+        runs += MEDIAN_BENCH_SAMPLES;
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    random_state ^= (uint32_t)sink & 1;
+    return elapsed * 1e9 / runs;
+}
+
+static int run_median(void)
+{
+    static const unsigned lengths[] = {3, 5, 16, 31, 64, 255, 1024};
+    int failures = check_median();
+    unsigned l;
+
+    printf("median filter: %s\n", failures ? "FAILED" : "dsp and sliding versions match a sort for 1 to 1024 samples");
+    for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+        double dsp = time_median(0, lengths[l]);
+        double sliding = time_median(1, lengths[l]);
+
+        printf("  %4u samples: dsp %7.1fns, sliding %6.1fns (%.1fx)\n", lengths[l], dsp, sliding,
+               dsp / sliding);
+    }
+    return failures;
+}
+
+/* A random word scaled down by a random number of bits, to cover the whole
+   range of exponents */
+static int32_t scaled_word(void)
+{
+    int shift = (int)((uint32_t)random_word() % 32);
+
+    return random_word() >> shift;
+}
+
+/* Arguments of a function. b is the imaginary part of atan and the
+   denominator of div. The first values are the ends of the range. */
+static void elementary_arguments(elementary_function function, int32_t *a, int32_t *b, unsigned samples)
+{
+    static const int32_t ends[] = {0, 1, 2, -1, INT32_MAX, INT32_MIN, 0x40000000, -0x40000000};
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        int32_t x = (i < 8) ? ends[i] : scaled_word();
+        int32_t y = (i < 64) ? ends[(i / 8) % 8] : scaled_word();
+
+        switch (function)
+        {
+            case ELEMENTARY_SQRT:
+            case ELEMENTARY_LOG2:
+            case ELEMENTARY_INV_QDRT:
+                a[i] = (x == INT32_MIN) ? INT32_MAX : ((x < 0) ? -x : x);
+                break;
+            case ELEMENTARY_POW2:
+                a[i] = (x > 0) ? -x : x;
+                break;
+            case ELEMENTARY_DIV:
+                b[i] = (y == INT32_MIN) ? INT32_MAX : ((y < 0) ? -y : y);
+                b[i] = (b[i] == 0) ? 1 : b[i];
+                a[i] = (int32_t)(((uint64_t)((uint32_t)x >> 1) * (uint32_t)b[i]) >> 31);
+                break;
+            default:
+                a[i] = x;
+                b[i] = ((i & 0xFF) == 0xFF) ? x : y;
+                break;
+        }
+    }
+}
+
+static void elementary_block(elementary_function function, const int32_t *a, const int32_t *b, int32_t *out,
+                             unsigned samples, math_host_accuracy accuracy)
+{
+    switch (function)
+    {
+        case ELEMENTARY_SQRT:
+            math_host_sqrt_block(a, out, samples, accuracy);
+            break;
+        case ELEMENTARY_LOG2:
+            math_host_log2_block(a, out, samples, accuracy);
+            break;
+        case ELEMENTARY_POW2:
+            math_host_pow2_block(a, out, samples, accuracy);
+            break;
+        case ELEMENTARY_SIN:
+            math_host_sin_block(a, out, samples, accuracy);
+            break;
+        case ELEMENTARY_COS:
+            math_host_cos_block(a, out, samples, accuracy);
+            break;
+        case ELEMENTARY_ATAN:
+            math_host_atan_block(a, b, out, samples, accuracy);
+            break;
+        case ELEMENTARY_INV_QDRT:
+            math_host_inv_qdrt_block(a, out, samples, accuracy);
+            break;
+        default:
+            math_host_div_block(a, b, out, samples, accuracy);
+            break;
+    }
+}
+
+/* Error of a result, in the units of the result. Zero inputs of log2 and
+   inv_qdrt have no error to take. */
+static double elementary_error(elementary_function function, int32_t a, int32_t b, int32_t out)
+{
+    double x = a / 2147483648.0;
+    double y = out / 2147483648.0;
+    double error;
+
+    switch (function)
+    {
+        case ELEMENTARY_SQRT:
+            return fabs(y - sqrt(x));
+        case ELEMENTARY_LOG2:
+            return (a == 0) ? 0.0 : fabs(out / 16777216.0 - log2(x));
+        case ELEMENTARY_POW2:
+            return fabs(y - pow(2.0, a / 16777216.0));
+        case ELEMENTARY_SIN:
+            return fabs(y - sin(M_PI * x));
+        case ELEMENTARY_COS:
+            return fabs(y - cos(M_PI * x));
+        case ELEMENTARY_ATAN:
+            /* the difference of two angles, -1.0 to 1.0 */
+            error = y - atan2((double)b, (double)a) / M_PI;
+            return fabs(error - 2.0 * floor(error / 2.0 + 0.5));
+        case ELEMENTARY_INV_QDRT:
+            return (a == 0) ? 0.0 : fabs(y - pow(x, -0.25) / 512.0);
+        default:
+            return fabs(y - (double)a / b);
+    }
+}
+
+static int check_elementary(void)
+{
+    static int32_t a[ELEMENTARY_TEST_SAMPLES], b[ELEMENTARY_TEST_SAMPLES], out[ELEMENTARY_TEST_SAMPLES];
+    int failures = 0;
+    unsigned f, tier, i;
+
+    for (f = 0; f < ELEMENTARY_FUNCTIONS; f++)
+    {
+        printf("  %-8s max error", elementary_names[f]);
+        elementary_arguments((elementary_function)f, a, b, ELEMENTARY_TEST_SAMPLES);
+        for (tier = 0; tier < sizeof(accuracies) / sizeof(accuracies[0]); tier++)
+        {
+            double bound = ldexp(1.0, -(int)accuracies[tier]);
+            double worst = 0.0;
+
+            elementary_block((elementary_function)f, a, b, out, ELEMENTARY_TEST_SAMPLES, accuracies[tier]);
+            for (i = 0; i < ELEMENTARY_TEST_SAMPLES; i++)
+            {
+                double error = elementary_error((elementary_function)f, a[i], b[i], out[i]);
+
+                worst = (error > worst) ? error : worst;
+            }
+            printf(", %u bits 2^%.1f", (unsigned)accuracies[tier], log2(worst));
+            if (worst > bound)
+            {
+                printf(" FAIL");
+                failures++;
+            }
+        }
+        printf("\n");
+    }
+    return failures;
+}
+
+/* Time a value of a function, in ns, a block or a value at a call */
+static double time_elementary(elementary_function function, math_host_accuracy accuracy, int per_value)
+{
+    static int32_t a[ELEMENTARY_BENCH_SAMPLES], b[ELEMENTARY_BENCH_SAMPLES], out[ELEMENTARY_BENCH_SAMPLES];
+    unsigned values = 0;
+    unsigned i;
+    clock_t start;
+    double elapsed;
+
+    elementary_arguments(function, a, b, ELEMENTARY_BENCH_SAMPLES);
+    start = clock();
+    do
+    {
+        if (per_value)
+        {
+            for (i = 0; i < ELEMENTARY_BENCH_SAMPLES; i++)
+            {
+                elementary_block(function, &a[i], &b[i], &out[i], 1, accuracy);
+            }
+        }
+        else
+        {
+            elementary_block(function, a, b, out, ELEMENTARY_BENCH_SAMPLES, accuracy);
+        }
+        values += ELEMENTARY_BENCH_SAMPLES;
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (elapsed < BENCH_SECONDS);
+
+    random_state ^= (uint32_t)out[0] & 1;
+    return elapsed * 1e9 / values;
+}
+
+static int run_elementary(void)
+{
+    int failures;
+    unsigned f, tier;
+
+    printf("elementary functions:\n");
+    failures = check_elementary();
+    printf("  %s\n", failures ? "FAILED" : "all within the bound of each tier");
+    for (f = 0; f < ELEMENTARY_FUNCTIONS; f++)
+    {
+        printf("  %-8s ns per value", elementary_names[f]);
+        for (tier = 0; tier < sizeof(accuracies) / sizeof(accuracies[0]); tier++)
+        {
+            double block = time_elementary((elementary_function)f, accuracies[tier], 0);
+            double single = time_elementary((elementary_function)f, accuracies[tier], 1);
+
+            printf(", %u bits %5.2f (%5.2f a call)", (unsigned)accuracies[tier], block, single);
+        }
+        printf("\n");
+    }
+    return failures;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int main(void)
+{
+    int failures = 0;
+
+    failures += run_fft();
+    failures += run_median();
+    failures += run_elementary();
+    return failures ? 1 : 0;
+}
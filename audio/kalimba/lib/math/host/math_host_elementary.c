@@ -0,0 +1,386 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host_elementary.c
+ * \ingroup math
+ *
+ * Block versions of the elementary functions of the math library, at a
+ * selected accuracy. <br>
+ *
+ * The DSP routines each evaluate one polynomial over the whole reduced
+ * range, so their accuracy is fixed: about 16 bits for $math.sqrt and 20
+ * for $math.sin. Here each function has a table of short Chebyshev series,
+ * one for each of a number of equal segments of its reduced argument, and
+ * the accuracy tier is the number of terms summed: 3, 4 or 5. The segments
+ * are chosen so that 3 terms reach 16 bits with a bit to spare, and each
+ * further term gains more than 4 bits. The series are summed by Clenshaw's
+ * recurrence in 64 bits, with the segment's argument from -1.0 to 1.0 as a
+ * fraction, so the rounding adds well under 2^-28.
+ *
+ * Each argument is reduced to t, 0 to 1 as an unsigned 0.32 fraction, and
+ * the result scaled back:
+ *
+ *     sqrt       x = t * 2^-2k,          t from 0.25   sqrt(t) * 2^-k
+ *     log2       x = t * 2^-k,           t from 0.5    log2(t) + 1 - (k + 1)
+ *     pow2       x = i + t                             2^(t - 1) * 2^(i + 1)
+ *     sin        quarter turn q + t                    +/- sin(pi / 2 * t or 1 - t)
+ *     atan       t = min / max of |re|, |im|           octant +/- atan(t) / pi
+ *     inv_qdrt   x = t * 2^-(4k + j),    t from 0.5    t^-0.25 * 2^(j / 4) * 2^(k - 9)
+ *     div        denom = t * 2^-k,       t from 0.5    num * 2^k / t
+ *
+ * The divisions of atan and div multiply by 1 / (4 t) from a table of the
+ * same form, which has 2 more bits than the tier as the quotient can be up
+ * to 4 times its error.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "math_host_private.h"
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** Chebyshev series of a function of t on 2^segment_bits equal segments,
+    from segment first */
+typedef struct
+{
+    const int32_t *coefs;
+    unsigned segment_bits;
+    unsigned first;
+} chebyshev_table;
+
+/****************************************************************************
+Private Constant Declarations
+*/
+static const chebyshev_table sqrt_table = {math_host_sqrt_chebyshev, 5, 8};
+static const chebyshev_table log2_table = {math_host_log2_chebyshev, 5, 16};
+static const chebyshev_table pow2_table = {math_host_pow2_chebyshev, 3, 0};
+static const chebyshev_table sin_table = {math_host_sin_chebyshev, 4, 0};
+static const chebyshev_table atan_table = {math_host_atan_chebyshev, 3, 0};
+static const chebyshev_table inv_qdrt_table = {math_host_inv_qdrt_chebyshev, 4, 8};
+static const chebyshev_table recip_table = {math_host_recip_chebyshev, 6, 32};
+
+/** 2^(j / 4) / 2 for the exponent of inv_qdrt modulo 4 */
+static const int32_t qdrt_scale[4] =
+{
+    (int32_t)0x40000000, (int32_t)0x4C1BF829, (int32_t)0x5A82799A, (int32_t)0x6BA27E65
+};
+
+/** log2(0) of $math.log2_table in Q8.24 */
+#define LOG2_OF_ZERO        (-64 * (1 << 24))
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Terms of the Chebyshev series summed for an accuracy */
+static unsigned accuracy_terms(math_host_accuracy accuracy)
+{
+    if (accuracy > MATH_HOST_ACCURACY_20_BITS)
+    {
+        return 5;
+    }
+    if (accuracy > MATH_HOST_ACCURACY_16_BITS)
+    {
+        return 4;
+    }
+    return 3;
+}
+
+/* Leading zeros of a non-zero word */
+static inline unsigned leading_zeros(uint32_t value)
+{
+    return (unsigned)__builtin_clz(value);
+}
+
+/* value / 2^shift rounded to the nearest */
+static inline int64_t round_shift(int64_t value, unsigned shift)
+{
+    if (shift == 0)
+    {
+        return value;
+    }
+    return (value + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+/* Sum of the first terms of a Chebyshev series at u, -1.0 to 1.0 */
+static inline int64_t chebyshev_sum(const int32_t *c, int32_t u, unsigned terms)
+{
+    int64_t b1 = c[terms - 1];
+    int64_t b2 = 0;
+    unsigned k;
+
+    /* b(k) = c(k) + 2 u b(k + 1) - b(k + 2) */
+    for (k = terms - 2; k > 0; k--)
+    {
+        int64_t b = c[k] + ((u * b1 + (1 << 29)) >> 30) - b2;
+
+        b2 = b1;
+        b1 = b;
+    }
+    return c[0] + ((u * b1 + (1 << 30)) >> 31) - b2;
+}
+
+/* Function of a table at t, 0 to 1 as a 0.32 fraction, as a saturated
+   fraction */
+static inline int32_t table_value(const chebyshev_table *table, uint32_t t, unsigned terms)
+{
+    unsigned segment = (t >> (32 - table->segment_bits)) - table->first;
+    int32_t u = (int32_t)((t << table->segment_bits) ^ 0x80000000u);
+
+    return kal_sat32(chebyshev_sum(&table->coefs[segment * MATH_HOST_CHEBYSHEV_TERMS], u, terms));
+}
+
+static inline int32_t sqrt_value(int32_t x, unsigned terms)
+{
+    uint32_t t = (uint32_t)x << 1;
+    unsigned shift;
+
+    if (x <= 0)
+    {
+        return 0;
+    }
+    shift = leading_zeros(t) & ~1u;
+    return (int32_t)round_shift(table_value(&sqrt_table, t << shift, terms), shift / 2);
+}
+
+static inline int32_t log2_value(int32_t x, unsigned terms)
+{
+    uint32_t t = (uint32_t)x << 1;
+    unsigned shift;
+
+    if (x <= 0)
+    {
+        return LOG2_OF_ZERO;
+    }
+    shift = leading_zeros(t);
+    return (int32_t)(round_shift(table_value(&log2_table, t << shift, terms), 7)
+                     - (int64_t)(shift + 1) * (1 << 24));
+}
+
+static inline int32_t pow2_value(int32_t x, unsigned terms)
+{
+    unsigned shift;
+
+    if (x >= 0)
+    {
+        return INT32_MAX;
+    }
+    /* x = i + t with i = -shift - 1 */
+    shift = (unsigned)(-(x >> 24) - 1);
+    if (shift >= 32)
+    {
+        return 0;
+    }
+    return (int32_t)round_shift(table_value(&pow2_table, (uint32_t)x << 8, terms), shift);
+}
+
+/* Sine of an angle as a word of a full turn */
+static inline int32_t sin_value(uint32_t angle, unsigned terms)
+{
+    unsigned quarter = angle >> 30;
+    uint32_t t = angle & 0x3FFFFFFFu;
+    int32_t value;
+
+    if (quarter & 1)
+    {
+        t = 0x40000000u - t;
+    }
+    value = (t == 0x40000000u) ? INT32_MAX : table_value(&sin_table, t << 2, terms);
+    return (quarter & 2) ? -value : value;
+}
+
+/* 1 / (4 t) of a word, as the table gives it, with the word's leading
+   zeros */
+static inline int32_t reciprocal(uint32_t value, unsigned *shift, unsigned terms)
+{
+    *shift = leading_zeros(value);
+    return table_value(&recip_table, value << *shift, terms);
+}
+
+static inline int32_t atan_value(int32_t re, int32_t im, unsigned terms)
+{
+    uint32_t abs_re = (re < 0) ? -(uint32_t)re : (uint32_t)re;
+    uint32_t abs_im = (im < 0) ? -(uint32_t)im : (uint32_t)im;
+    uint32_t large = (abs_im > abs_re) ? abs_im : abs_re;
+    uint32_t small = (abs_im > abs_re) ? abs_re : abs_im;
+    uint32_t angle;
+
+    if (large == 0)
+    {
+        return 0;
+    }
+    if (small == large)
+    {
+        /* atan(1) / pi */
+        angle = 0x20000000u;
+    }
+    else
+    {
+        unsigned shift;
+        int32_t inverse = reciprocal(large, &shift, terms);
+        uint64_t ratio = (uint64_t)small * (uint32_t)inverse;
+
+        /* small / large as a 0.32 fraction */
+        ratio = (shift <= 29) ? (ratio + ((1ull << (29 - shift)) >> 1)) >> (29 - shift) : ratio << (shift - 29);
+        if (ratio > UINT32_MAX)
+        {
+            ratio = UINT32_MAX;
+        }
+        angle = (uint32_t)table_value(&atan_table, (uint32_t)ratio, terms);
+    }
+
+    /* to the octant */
+    if (abs_im > abs_re)
+    {
+        angle = 0x40000000u - angle;
+    }
+    if (re < 0)
+    {
+        angle = 0x80000000u - angle;
+    }
+    if (im < 0)
+    {
+        angle = -angle;
+    }
+    return (int32_t)angle;
+}
+
+static inline int32_t inv_qdrt_value(int32_t x, unsigned terms)
+{
+    uint32_t t = (uint32_t)x << 1;
+    unsigned shift;
+    int32_t root;
+
+    if (x <= 0)
+    {
+        return 0;
+    }
+    shift = leading_zeros(t);
+    root = table_value(&inv_qdrt_table, t << shift, terms);
+    return (int32_t)round_shift((int64_t)root * qdrt_scale[shift & 3], 31 + 7 - shift / 4);
+}
+
+static inline int32_t div_value(int32_t num, int32_t denom, unsigned terms)
+{
+    unsigned shift;
+    int32_t inverse;
+    int64_t quotient;
+
+    if (num <= 0)
+    {
+        return 0;
+    }
+    if (denom <= num)
+    {
+        return INT32_MAX;
+    }
+    /* denom is 2 or more, so shift is at most 30 */
+    inverse = reciprocal((uint32_t)denom, &shift, terms);
+    quotient = round_shift((int64_t)num * inverse, 30 - shift);
+    return (quotient > INT32_MAX) ? INT32_MAX : (int32_t)quotient;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void math_host_sqrt_block(const int32_t *input, int32_t *output, unsigned samples,
+                          math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = sqrt_value(input[i], terms);
+    }
+}
+
+void math_host_log2_block(const int32_t *input, int32_t *output, unsigned samples,
+                          math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = log2_value(input[i], terms);
+    }
+}
+
+void math_host_pow2_block(const int32_t *input, int32_t *output, unsigned samples,
+                          math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = pow2_value(input[i], terms);
+    }
+}
+
+void math_host_sin_block(const int32_t *input, int32_t *output, unsigned samples,
+                         math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = sin_value((uint32_t)input[i], terms);
+    }
+}
+
+void math_host_cos_block(const int32_t *input, int32_t *output, unsigned samples,
+                         math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    /* cos(x) = sin(x + 90 degrees), as $math.cos */
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = sin_value((uint32_t)input[i] + 0x40000000u, terms);
+    }
+}
+
+void math_host_atan_block(const int32_t *real, const int32_t *imag, int32_t *output,
+                          unsigned samples, math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = atan_value(real[i], imag[i], terms);
+    }
+}
+
+void math_host_inv_qdrt_block(const int32_t *input, int32_t *output, unsigned samples,
+                              math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = inv_qdrt_value(input[i], terms);
+    }
+}
+
+void math_host_div_block(const int32_t *num, const int32_t *denom, int32_t *output,
+                         unsigned samples, math_host_accuracy accuracy)
+{
+    unsigned terms = accuracy_terms(accuracy);
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = div_value(num[i], denom[i], terms);
+    }
+}
@@ -0,0 +1,513 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host_fft.c
+ * \ingroup math
+ *
+ * Host port of fft.asm: $math.fft, $math.ifft, the scaleable versions and
+ * $math.bitreverse_array. <br>
+ *
+ * The DSP runs log2(N) radix 2 decimation in time stages on natural order
+ * input, with the twiddle factors in bit reversed order and bit reversed
+ * output. Each butterfly rounds x1 * W once and wraps on the adds:
+ *
+ *     x0' = x0 + rMAC(x1 cos + y1 sin)   x1' = x0 - rMAC(x1 cos + y1 sin)
+ *     y0' = y0 + rMAC(y1 cos - x1 sin)   y1' = y0 - rMAC(y1 cos - x1 sin)
+ *
+ * Here the stages are taken two at a time as radix 4 (radix 2^2) passes,
+ * which do the same four radix 2 butterflies on four points while they
+ * are held in registers. The results are identical to the DSP's, with half
+ * the passes over the data. A radix 4 or split radix butterfly with fewer
+ * multiplies would round differently, so those are not used. With an odd
+ * number of stages the first one is a plain radix 2 pass.
+ *
+ * The SIMD versions do four butterflies at once. Their products are exact
+ * 64 bit values, and the sum of two products with |cos| + |sin| < 2 can not
+ * overflow, so they need no range check.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define MATH_HOST_SSE4_1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MATH_HOST_NEON
+#endif
+
+#include "math_host_private.h"
+
+/****************************************************************************
+Public Variable Definitions
+*/
+#if defined(MATH_HOST_SSE4_1) || defined(MATH_HOST_NEON)
+int math_host_simd_enabled = 1;
+#else
+int math_host_simd_enabled = 0;
+#endif
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** Twiddle factors of a transform, scaled for the scaleable versions */
+typedef struct
+{
+    const int32_t *cos;
+    const int32_t *nsin;
+    int scaled;                     /**< non-zero to scale x0 and y0 */
+    int32_t x0_scale;
+} fft_twiddles;
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* One radix 2 butterfly on points a and b */
+static inline void butterfly(int32_t *re, int32_t *im, unsigned a, unsigned b,
+                             int32_t c, int32_t ns, const fft_twiddles *tw)
+{
+    int32_t x0 = re[a];
+    int32_t y0 = im[a];
+    int32_t x1 = re[b];
+    int32_t y1 = im[b];
+    int32_t x_mac = kal_store_sum((int64_t)x1 * c - (int64_t)y1 * ns);
+    int32_t y_mac = kal_store_sum((int64_t)x1 * ns + (int64_t)y1 * c);
+
+    if (tw->scaled)
+    {
+        x0 = kal_frac_mult(x0, tw->x0_scale);
+        y0 = kal_frac_mult(y0, tw->x0_scale);
+    }
+    re[a] = kal_add(x0, x_mac);
+    re[b] = kal_sub(x0, x_mac);
+    im[a] = kal_add(y0, y_mac);
+    im[b] = kal_sub(y0, y_mac);
+}
+
+/* Radix 2 pass of the first stage: one group with W = twiddle 0 */
+static void radix2_first_stage_scalar(int32_t *re, int32_t *im, unsigned n, const fft_twiddles *tw)
+{
+    unsigned half = n >> 1;
+    unsigned k;
+
+    for (k = 0; k < half; k++)
+    {
+        butterfly(re, im, k, k + half, tw->cos[0], tw->nsin[0], tw);
+    }
+}
+
+/* Radix 4 pass of stages s and s + 1, where node_space is the distance
+   between the butterfly inputs in stage s and groups is 2^s */
+static void radix4_stage_scalar(int32_t *re, int32_t *im, unsigned node_space, unsigned groups,
+                                const fft_twiddles *tw)
+{
+    unsigned quarter = node_space >> 1;
+    unsigned j, k;
+
+    for (j = 0; j < groups; j++)
+    {
+        unsigned base = 2 * node_space * j;
+
+        for (k = base; k < base + quarter; k++)
+        {
+            butterfly(re, im, k, k + node_space, tw->cos[j], tw->nsin[j], tw);
+            butterfly(re, im, k + quarter, k + node_space + quarter, tw->cos[j], tw->nsin[j], tw);
+            butterfly(re, im, k, k + quarter, tw->cos[2 * j], tw->nsin[2 * j], tw);
+            butterfly(re, im, k + node_space, k + node_space + quarter,
+                      tw->cos[2 * j + 1], tw->nsin[2 * j + 1], tw);
+        }
+    }
+}
+
+#if defined(MATH_HOST_SSE4_1)
+
+typedef __m128i vec4;
+
+#define vec_load(p)         _mm_loadu_si128((const __m128i *)(p))
+#define vec_store(p, v)     _mm_storeu_si128((__m128i *)(p), (v))
+#define vec_dup(x)          _mm_set1_epi32(x)
+#define vec_add(a, b)       _mm_add_epi32((a), (b))
+#define vec_sub(a, b)       _mm_sub_epi32((a), (b))
+
+/* Round four 64 bit sums, held as the even and odd lanes, as rMAC holding
+   twice each sum. SSE4.1 has no 64 bit arithmetic shift, so the sums are
+   shifted logically. The results fit in 33 bits: the low word is the
+   value and bit 0 of the high word its sign, which shows overflow. */
+static inline vec4 vec_round(__m128i even, __m128i odd)
+{
+    const __m128i bias = _mm_set1_epi64x(1 << 30);
+    __m128i e = _mm_srli_epi64(_mm_add_epi64(even, bias), 31);
+    __m128i o = _mm_srli_epi64(_mm_add_epi64(odd, bias), 31);
+    __m128i value = _mm_blend_epi16(e, _mm_slli_epi64(o, 32), 0xCC);
+    __m128i sign = _mm_blend_epi16(_mm_srli_epi64(e, 32), o, 0xCC);
+    __m128i overflow = _mm_sub_epi32(_mm_setzero_si128(),
+                                     _mm_xor_si128(_mm_srli_epi32(value, 31), sign));
+    __m128i saturated = _mm_add_epi32(_mm_set1_epi32(INT32_MAX), sign);
+
+    return _mm_blendv_epi8(value, saturated, overflow);
+}
+
+static inline vec4 vec_frac_mult(vec4 a, vec4 b)
+{
+    return vec_round(_mm_mul_epi32(a, b),
+                     _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)));
+}
+
+/* x_mac and y_mac of four butterflies */
+static inline void vec_twiddle(vec4 x1, vec4 y1, vec4 c, vec4 ns, vec4 *x_mac, vec4 *y_mac)
+{
+    __m128i x1_odd = _mm_srli_epi64(x1, 32);
+    __m128i y1_odd = _mm_srli_epi64(y1, 32);
+    __m128i c_odd = _mm_srli_epi64(c, 32);
+    __m128i ns_odd = _mm_srli_epi64(ns, 32);
+
+    *x_mac = vec_round(_mm_sub_epi64(_mm_mul_epi32(x1, c), _mm_mul_epi32(y1, ns)),
+                       _mm_sub_epi64(_mm_mul_epi32(x1_odd, c_odd), _mm_mul_epi32(y1_odd, ns_odd)));
+    *y_mac = vec_round(_mm_add_epi64(_mm_mul_epi32(x1, ns), _mm_mul_epi32(y1, c)),
+                       _mm_add_epi64(_mm_mul_epi32(x1_odd, ns_odd), _mm_mul_epi32(y1_odd, c_odd)));
+}
+
+static inline void vec_transpose(vec4 *a, vec4 *b, vec4 *c, vec4 *d)
+{
+    __m128i ab_low = _mm_unpacklo_epi32(*a, *b);
+    __m128i ab_high = _mm_unpackhi_epi32(*a, *b);
+    __m128i cd_low = _mm_unpacklo_epi32(*c, *d);
+    __m128i cd_high = _mm_unpackhi_epi32(*c, *d);
+
+    *a = _mm_unpacklo_epi64(ab_low, cd_low);
+    *b = _mm_unpackhi_epi64(ab_low, cd_low);
+    *c = _mm_unpacklo_epi64(ab_high, cd_high);
+    *d = _mm_unpackhi_epi64(ab_high, cd_high);
+}
+
+/* Split 8 words into the even and odd ones */
+static inline void vec_deinterleave(const int32_t *p, vec4 *even, vec4 *odd)
+{
+    __m128i low = _mm_shuffle_epi32(vec_load(p), _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i high = _mm_shuffle_epi32(vec_load(p + 4), _MM_SHUFFLE(3, 1, 2, 0));
+
+    *even = _mm_unpacklo_epi64(low, high);
+    *odd = _mm_unpackhi_epi64(low, high);
+}
+
+#elif defined(MATH_HOST_NEON)
+
+typedef int32x4_t vec4;
+
+#define vec_load(p)         vld1q_s32(p)
+#define vec_store(p, v)     vst1q_s32((p), (v))
+#define vec_dup(x)          vdupq_n_s32(x)
+#define vec_add(a, b)       vaddq_s32((a), (b))
+#define vec_sub(a, b)       vsubq_s32((a), (b))
+
+/* vrshrq_n_s64 adds the rounding constant before shifting and vqmovn_s64
+   saturates, which is rMAC holding twice the sum used as a 32 bit value */
+static inline vec4 vec_round(int64x2_t low, int64x2_t high)
+{
+    return vcombine_s32(vqmovn_s64(vrshrq_n_s64(low, 31)), vqmovn_s64(vrshrq_n_s64(high, 31)));
+}
+
+static inline vec4 vec_frac_mult(vec4 a, vec4 b)
+{
+    return vec_round(vmull_s32(vget_low_s32(a), vget_low_s32(b)),
+                     vmull_s32(vget_high_s32(a), vget_high_s32(b)));
+}
+
+static inline void vec_twiddle(vec4 x1, vec4 y1, vec4 c, vec4 ns, vec4 *x_mac, vec4 *y_mac)
+{
+    *x_mac = vec_round(vmlsl_s32(vmull_s32(vget_low_s32(x1), vget_low_s32(c)),
+                                 vget_low_s32(y1), vget_low_s32(ns)),
+                       vmlsl_s32(vmull_s32(vget_high_s32(x1), vget_high_s32(c)),
+                                 vget_high_s32(y1), vget_high_s32(ns)));
+    *y_mac = vec_round(vmlal_s32(vmull_s32(vget_low_s32(x1), vget_low_s32(ns)),
+                                 vget_low_s32(y1), vget_low_s32(c)),
+                       vmlal_s32(vmull_s32(vget_high_s32(x1), vget_high_s32(ns)),
+                                 vget_high_s32(y1), vget_high_s32(c)));
+}
+
+static inline void vec_transpose(vec4 *a, vec4 *b, vec4 *c, vec4 *d)
+{
+    int32x4x2_t ab = vtrnq_s32(*a, *b);
+    int32x4x2_t cd = vtrnq_s32(*c, *d);
+
+    *a = vcombine_s32(vget_low_s32(ab.val[0]), vget_low_s32(cd.val[0]));
+    *b = vcombine_s32(vget_low_s32(ab.val[1]), vget_low_s32(cd.val[1]));
+    *c = vcombine_s32(vget_high_s32(ab.val[0]), vget_high_s32(cd.val[0]));
+    *d = vcombine_s32(vget_high_s32(ab.val[1]), vget_high_s32(cd.val[1]));
+}
+
+static inline void vec_deinterleave(const int32_t *p, vec4 *even, vec4 *odd)
+{
+    int32x4x2_t pair = vld2q_s32(p);
+
+    *even = pair.val[0];
+    *odd = pair.val[1];
+}
+
+#endif
+
+#if defined(MATH_HOST_SSE4_1) || defined(MATH_HOST_NEON)
+
+/* Four butterflies on points a[0..3] and b[0..3] held in registers */
+static inline void vec_butterfly(vec4 *xa, vec4 *ya, vec4 *xb, vec4 *yb,
+                                 vec4 c, vec4 ns, const fft_twiddles *tw)
+{
+    vec4 x0 = *xa;
+    vec4 y0 = *ya;
+    vec4 x_mac, y_mac;
+
+    vec_twiddle(*xb, *yb, c, ns, &x_mac, &y_mac);
+    if (tw->scaled)
+    {
+        vec4 scale = vec_dup(tw->x0_scale);
+
+        x0 = vec_frac_mult(x0, scale);
+        y0 = vec_frac_mult(y0, scale);
+    }
+    *xa = vec_add(x0, x_mac);
+    *xb = vec_sub(x0, x_mac);
+    *ya = vec_add(y0, y_mac);
+    *yb = vec_sub(y0, y_mac);
+}
+
+static void radix2_first_stage_simd(int32_t *re, int32_t *im, unsigned n, const fft_twiddles *tw)
+{
+    unsigned half = n >> 1;
+    vec4 c = vec_dup(tw->cos[0]);
+    vec4 ns = vec_dup(tw->nsin[0]);
+    unsigned k;
+
+    for (k = 0; k < half; k += 4)
+    {
+        vec4 x0 = vec_load(&re[k]);
+        vec4 y0 = vec_load(&im[k]);
+        vec4 x1 = vec_load(&re[k + half]);
+        vec4 y1 = vec_load(&im[k + half]);
+
+        vec_butterfly(&x0, &y0, &x1, &y1, c, ns, tw);
+        vec_store(&re[k], x0);
+        vec_store(&im[k], y0);
+        vec_store(&re[k + half], x1);
+        vec_store(&im[k + half], y1);
+    }
+}
+
+/* Radix 4 pass with at least 4 butterflies per group: the lanes are four
+   adjacent butterflies with the same twiddle factors */
+static void radix4_stage_simd(int32_t *re, int32_t *im, unsigned node_space, unsigned groups,
+                              const fft_twiddles *tw)
+{
+    unsigned quarter = node_space >> 1;
+    unsigned j, k;
+
+    for (j = 0; j < groups; j++)
+    {
+        unsigned base = 2 * node_space * j;
+        vec4 c1 = vec_dup(tw->cos[j]);
+        vec4 ns1 = vec_dup(tw->nsin[j]);
+        vec4 c2a = vec_dup(tw->cos[2 * j]);
+        vec4 ns2a = vec_dup(tw->nsin[2 * j]);
+        vec4 c2b = vec_dup(tw->cos[2 * j + 1]);
+        vec4 ns2b = vec_dup(tw->nsin[2 * j + 1]);
+
+        for (k = base; k < base + quarter; k += 4)
+        {
+            unsigned p1 = k + quarter;
+            unsigned p2 = k + node_space;
+            unsigned p3 = p2 + quarter;
+            vec4 x0 = vec_load(&re[k]), y0 = vec_load(&im[k]);
+            vec4 x1 = vec_load(&re[p1]), y1 = vec_load(&im[p1]);
+            vec4 x2 = vec_load(&re[p2]), y2 = vec_load(&im[p2]);
+            vec4 x3 = vec_load(&re[p3]), y3 = vec_load(&im[p3]);
+
+            vec_butterfly(&x0, &y0, &x2, &y2, c1, ns1, tw);
+            vec_butterfly(&x1, &y1, &x3, &y3, c1, ns1, tw);
+            vec_butterfly(&x0, &y0, &x1, &y1, c2a, ns2a, tw);
+            vec_butterfly(&x2, &y2, &x3, &y3, c2b, ns2b, tw);
+
+            vec_store(&re[k], x0);
+            vec_store(&im[k], y0);
+            vec_store(&re[p1], x1);
+            vec_store(&im[p1], y1);
+            vec_store(&re[p2], x2);
+            vec_store(&im[p2], y2);
+            vec_store(&re[p3], x3);
+            vec_store(&im[p3], y3);
+        }
+    }
+}
+
+/* Radix 4 pass of the last two stages, with one butterfly of each kind
+   per group: the lanes are four adjacent groups, transposed in and out */
+static void radix4_last_stages_simd(int32_t *re, int32_t *im, unsigned groups, const fft_twiddles *tw)
+{
+    unsigned j;
+
+    for (j = 0; j < groups; j += 4)
+    {
+        int32_t *pr = &re[4 * j];
+        int32_t *pi = &im[4 * j];
+        vec4 x0 = vec_load(pr), x1 = vec_load(pr + 4), x2 = vec_load(pr + 8), x3 = vec_load(pr + 12);
+        vec4 y0 = vec_load(pi), y1 = vec_load(pi + 4), y2 = vec_load(pi + 8), y3 = vec_load(pi + 12);
+        vec4 c1 = vec_load(&tw->cos[j]);
+        vec4 ns1 = vec_load(&tw->nsin[j]);
+        vec4 c2a, c2b, ns2a, ns2b;
+
+        vec_deinterleave(&tw->cos[2 * j], &c2a, &c2b);
+        vec_deinterleave(&tw->nsin[2 * j], &ns2a, &ns2b);
+        vec_transpose(&x0, &x1, &x2, &x3);
+        vec_transpose(&y0, &y1, &y2, &y3);
+
+        vec_butterfly(&x0, &y0, &x2, &y2, c1, ns1, tw);
+        vec_butterfly(&x1, &y1, &x3, &y3, c1, ns1, tw);
+        vec_butterfly(&x0, &y0, &x1, &y1, c2a, ns2a, tw);
+        vec_butterfly(&x2, &y2, &x3, &y3, c2b, ns2b, tw);
+
+        vec_transpose(&x0, &x1, &x2, &x3);
+        vec_transpose(&y0, &y1, &y2, &y3);
+        vec_store(pr, x0);
+        vec_store(pr + 4, x1);
+        vec_store(pr + 8, x2);
+        vec_store(pr + 12, x3);
+        vec_store(pi, y0);
+        vec_store(pi + 4, y1);
+        vec_store(pi + 8, y2);
+        vec_store(pi + 12, y3);
+    }
+}
+
+#endif
+
+/* Run all the stages, as the stage, group and butterfly loops of fft.asm */
+static void fft_stages(const math_host_fft_struct *fft, const fft_twiddles *tw)
+{
+    unsigned n = fft->num_points;
+    int32_t *re = fft->real;
+    int32_t *im = fft->imag;
+    unsigned stages = 0;
+    unsigned stage = 0;
+#if defined(MATH_HOST_SSE4_1) || defined(MATH_HOST_NEON)
+    int simd = math_host_simd_enabled && (n >= 16);
+#endif
+
+    while ((1u << stages) < n)
+    {
+        stages++;
+    }
+
+    if (stages & 1)
+    {
+#if defined(MATH_HOST_SSE4_1) || defined(MATH_HOST_NEON)
+        if (simd)
+        {
+            radix2_first_stage_simd(re, im, n, tw);
+        }
+        else
+#endif
+        {
+            radix2_first_stage_scalar(re, im, n, tw);
+        }
+        stage = 1;
+    }
+
+    for (; stage < stages; stage += 2)
+    {
+        unsigned node_space = n >> (stage + 1);
+        unsigned groups = 1u << stage;
+
+#if defined(MATH_HOST_SSE4_1) || defined(MATH_HOST_NEON)
+        if (simd && (node_space >= 8))
+        {
+            radix4_stage_simd(re, im, node_space, groups, tw);
+            continue;
+        }
+        if (simd)
+        {
+            radix4_last_stages_simd(re, im, groups, tw);
+            continue;
+        }
+#endif
+        radix4_stage_scalar(re, im, node_space, groups, tw);
+    }
+}
+
+/* Scaled transform, as $math.ifft: cos(w) and x0 are scaled by r8 and
+   -sin(w) by r7 at every stage */
+static void scaled_fft(const math_host_fft_struct *fft, int32_t r8, int32_t r7)
+{
+    int32_t cos_scaled[MATH_HOST_FFT_MAX_POINTS / 2];
+    int32_t nsin_scaled[MATH_HOST_FFT_MAX_POINTS / 2];
+    fft_twiddles tw;
+    unsigned i;
+
+    for (i = 0; i < fft->num_points / 2; i++)
+    {
+        cos_scaled[i] = kal_frac_mult(math_host_fft_twiddle_real[i], r8);
+        nsin_scaled[i] = kal_frac_mult(math_host_fft_twiddle_imag[i], r7);
+    }
+    tw.cos = cos_scaled;
+    tw.nsin = nsin_scaled;
+    tw.scaled = 1;
+    tw.x0_scale = r8;
+    fft_stages(fft, &tw);
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void math_host_set_simd(int enable)
+{
+#if defined(MATH_HOST_SSE4_1) || defined(MATH_HOST_NEON)
+    math_host_simd_enabled = enable;
+#else
+    (void)enable;
+#endif
+}
+
+void math_host_fft(const math_host_fft_struct *fft)
+{
+    fft_twiddles tw;
+
+    tw.cos = math_host_fft_twiddle_real;
+    tw.nsin = math_host_fft_twiddle_imag;
+    tw.scaled = 0;
+    tw.x0_scale = 0;
+    fft_stages(fft, &tw);
+}
+
+void math_host_ifft(const math_host_fft_struct *fft)
+{
+    math_host_scaleable_ifft(fft, 0x40000000);
+}
+
+void math_host_scaleable_fft(const math_host_fft_struct *fft, int32_t scale)
+{
+    scaled_fft(fft, scale, scale);
+}
+
+void math_host_scaleable_ifft(const math_host_fft_struct *fft, int32_t scale)
+{
+    /* r7 = -r8 wraps for -1.0 as the DSP's negate does */
+    scaled_fft(fft, scale, kal_sub(0, scale));
+}
+
+void math_host_bitreverse_array(const int32_t *in, int32_t *out, unsigned size)
+{
+    unsigned shift = 0;
+    unsigned i;
+
+    while (((unsigned)MATH_HOST_FFT_MAX_POINTS >> shift) > size)
+    {
+        shift++;
+    }
+    for (i = 0; i < size; i++)
+    {
+        out[math_host_bitreverse_2048[i] >> shift] = in[i];
+    }
+}
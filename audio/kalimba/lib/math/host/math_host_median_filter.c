@@ -0,0 +1,243 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host_median_filter.c
+ * \ingroup math
+ *
+ * Host port of median_filter.asm, and a sliding median with the same
+ * output at O(log N) a sample. <br>
+ *
+ * The DSP keeps the window sorted in the history buffer, largest first,
+ * with the age of each sample in the index buffer. Each new sample ages
+ * them all, and goes after the last sample not below it while the samples
+ * between there and the oldest shift along by one over the oldest: two
+ * passes of up to N words a sample.
+ *
+ * The median is only a function of the samples in the window, so the
+ * sliding median keeps them in two heaps instead: the smaller half in a
+ * max-heap and the larger half in a min-heap, with the middle values at
+ * the tops. The new sample takes the place of the oldest in its heap and
+ * is sifted; if the tops are then out of order they are swapped and sifted
+ * down. An even length gives the mean of the two middle values, halved
+ * before the add if the add would overflow, as the DSP does.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "math_host_private.h"
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Median of a window from its middle value and, for an even length, the
+   one above it */
+static int32_t median_of(unsigned length, int32_t middle, int32_t above)
+{
+    int32_t sum;
+
+    if (length & 1)
+    {
+        return middle;
+    }
+    sum = kal_add(middle, above);
+    if (((middle ^ sum) & (above ^ sum)) < 0)
+    {
+        /* overflow */
+        return (middle >> 1) + (above >> 1);
+    }
+    return sum >> 1;
+}
+
+/* Heap entry i holds slot heap[i] and its value, and slot s is at heap
+   entry position[s]. The low heap is the first num_low entries and the
+   high heap the rest, each with its top first. */
+static int32_t entry_value(const math_host_sliding_median *median, unsigned i)
+{
+    return median->values[i];
+}
+
+static void swap_entries(math_host_sliding_median *median, unsigned i, unsigned j)
+{
+    uint16_t slot = median->heap[i];
+    int32_t value = median->values[i];
+
+    median->heap[i] = median->heap[j];
+    median->heap[j] = slot;
+    median->values[i] = median->values[j];
+    median->values[j] = value;
+    median->position[median->heap[i]] = (uint16_t)i;
+    median->position[median->heap[j]] = (uint16_t)j;
+}
+
+/* Order of two values in a heap: for the low heap a parent is not below
+   its children, for the high heap not above */
+static int out_of_order(int low, int32_t parent, int32_t child)
+{
+    return low ? (parent < child) : (parent > child);
+}
+
+/* Sift heap entry k, relative to the heap's base, up or down */
+static void sift(math_host_sliding_median *median, unsigned base, unsigned count, int low, unsigned k)
+{
+    while (k > 0)
+    {
+        unsigned parent = (k - 1) / 2;
+
+        if (!out_of_order(low, entry_value(median, base + parent), entry_value(median, base + k)))
+        {
+            break;
+        }
+        swap_entries(median, base + parent, base + k);
+        k = parent;
+    }
+    for (;;)
+    {
+        unsigned child = 2 * k + 1;
+
+        if (child >= count)
+        {
+            break;
+        }
+        if ((child + 1 < count)
+            && out_of_order(low, entry_value(median, base + child), entry_value(median, base + child + 1)))
+        {
+            child++;
+        }
+        if (!out_of_order(low, entry_value(median, base + k), entry_value(median, base + child)))
+        {
+            break;
+        }
+        swap_entries(median, base + k, base + child);
+        k = child;
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void math_host_median_filter_initialise(int32_t *history, int32_t *index, unsigned length, int32_t value)
+{
+    unsigned i;
+
+    for (i = 0; i < length; i++)
+    {
+        history[i] = value;
+        index[i] = (int32_t)i;
+    }
+}
+
+int32_t math_host_median_filter_process(int32_t *history, int32_t *index, unsigned length, int32_t sample)
+{
+    unsigned oldest = 0;
+    int last = -1;
+    unsigned i;
+
+    /* find old sample and increase index, and the last sample not below
+       the new one */
+    for (i = 0; i < length; i++)
+    {
+        if (++index[i] == (int32_t)length)
+        {
+            oldest = i;
+        }
+        if (history[i] >= sample)
+        {
+            last = (int)i;
+        }
+    }
+
+    if ((int)oldest > last)
+    {
+        /* shift the samples after last towards the oldest */
+        unsigned at = (unsigned)(last + 1);
+
+        memmove(&history[at + 1], &history[at], (oldest - at) * sizeof(int32_t));
+        memmove(&index[at + 1], &index[at], (oldest - at) * sizeof(int32_t));
+        history[at] = sample;
+        index[at] = 0;
+    }
+    else
+    {
+        /* shift the samples after the oldest up to last back over it */
+        memmove(&history[oldest], &history[oldest + 1], ((unsigned)last - oldest) * sizeof(int32_t));
+        memmove(&index[oldest], &index[oldest + 1], ((unsigned)last - oldest) * sizeof(int32_t));
+        history[last] = sample;
+        index[last] = 0;
+    }
+
+    return median_of(length, history[length / 2], history[(length - 1) / 2]);
+}
+
+int math_host_sliding_median_init(math_host_sliding_median *median, unsigned length, int32_t value)
+{
+    unsigned i;
+
+    if ((length == 0) || (length > MATH_HOST_MEDIAN_FILTER_MAX_LENGTH))
+    {
+        return 0;
+    }
+    median->length = length;
+    median->num_low = length - length / 2;
+    median->oldest = 0;
+    for (i = 0; i < length; i++)
+    {
+        median->values[i] = value;
+        median->heap[i] = (uint16_t)i;
+        median->position[i] = (uint16_t)i;
+    }
+    return 1;
+}
+
+int32_t math_host_sliding_median_process(math_host_sliding_median *median, int32_t sample)
+{
+    unsigned num_low = median->num_low;
+    unsigned slot = median->oldest;
+    unsigned entry = median->position[slot];
+    int32_t low_top, high_top;
+
+    median->values[entry] = sample;
+    median->oldest = (slot + 1 == median->length) ? 0 : slot + 1;
+
+    if (entry < num_low)
+    {
+        sift(median, 0, num_low, 1, entry);
+    }
+    else
+    {
+        sift(median, num_low, median->length - num_low, 0, entry - num_low);
+    }
+
+    if (median->length == 1)
+    {
+        return sample;
+    }
+
+    /* keep every low value at or below every high value */
+    low_top = entry_value(median, 0);
+    high_top = entry_value(median, num_low);
+    if (low_top > high_top)
+    {
+        swap_entries(median, 0, num_low);
+        sift(median, 0, num_low, 1, 0);
+        sift(median, num_low, median->length - num_low, 0, 0);
+        low_top = entry_value(median, 0);
+        high_top = entry_value(median, num_low);
+    }
+    return median_of(median->length, low_top, high_top);
+}
+
+void math_host_sliding_median_block(math_host_sliding_median *median, const int32_t *input, int32_t *output,
+                                    unsigned samples)
+{
+    unsigned i;
+
+    for (i = 0; i < samples; i++)
+    {
+        output[i] = math_host_sliding_median_process(median, input[i]);
+    }
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host_private.h
+ * \ingroup math
+ *
+ * Kalimba arch4 arithmetic used by the host math port. <br>
+ *
+ * A fractional multiply adds twice the integer product to rMAC. Using rMAC
+ * as a 32 bit value takes bits 63..32 rounded on bit 31 and saturated. The
+ * sums in this library are of at most two products of 32 bit values, so
+ * they are held as 64 bit sums of the integer products and rounded with
+ * kal_store_sum.
+ */
+
+#ifndef MATH_HOST_PRIVATE_H
+#define MATH_HOST_PRIVATE_H
+
+/****************************************************************************
+Include Files
+*/
+#include "math_host.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Coefficients a segment of each Chebyshev table has, the number the
+    most accurate tier uses */
+#define MATH_HOST_CHEBYSHEV_TERMS       5
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/** Saturate to a data word */
+static inline int32_t kal_sat32(int64_t value)
+{
+    if (value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)value;
+}
+
+/** rMAC as a 32 bit value, where rMAC holds twice sum */
+static inline int32_t kal_store_sum(int64_t sum)
+{
+    return kal_sat32((sum + (1 << 30)) >> 31);
+}
+
+/** r = a * b (frac) */
+static inline int32_t kal_frac_mult(int32_t a, int32_t b)
+{
+    return kal_store_sum((int64_t)a * b);
+}
+
+/** Addition and subtraction of data words wrap */
+static inline int32_t kal_add(int32_t a, int32_t b)
+{
+    return (int32_t)((uint32_t)a + (uint32_t)b);
+}
+
+static inline int32_t kal_sub(int32_t a, int32_t b)
+{
+    return (int32_t)((uint32_t)a - (uint32_t)b);
+}
+
+/****************************************************************************
+Private Data Declarations
+*/
+extern const int32_t math_host_fft_twiddle_real[MATH_HOST_FFT_MAX_POINTS / 2];
+extern const int32_t math_host_fft_twiddle_imag[MATH_HOST_FFT_MAX_POINTS / 2];
+extern const uint16_t math_host_bitreverse_2048[MATH_HOST_FFT_MAX_POINTS];
+extern const int32_t math_host_sqrt_chebyshev[24 * MATH_HOST_CHEBYSHEV_TERMS];
+extern const int32_t math_host_log2_chebyshev[16 * MATH_HOST_CHEBYSHEV_TERMS];
+extern const int32_t math_host_pow2_chebyshev[8 * MATH_HOST_CHEBYSHEV_TERMS];
+extern const int32_t math_host_sin_chebyshev[16 * MATH_HOST_CHEBYSHEV_TERMS];
+extern const int32_t math_host_atan_chebyshev[8 * MATH_HOST_CHEBYSHEV_TERMS];
+extern const int32_t math_host_inv_qdrt_chebyshev[8 * MATH_HOST_CHEBYSHEV_TERMS];
+extern const int32_t math_host_recip_chebyshev[32 * MATH_HOST_CHEBYSHEV_TERMS];
+
+/* math_host_fft.c */
+extern int math_host_simd_enabled;
+
+#endif /* MATH_HOST_PRIVATE_H */
@@ -0,0 +1,872 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  math_host_tables.c
+ * \ingroup math
+ *
+ * Constant tables of the host math port. The twiddle factors are the K32
+ * tables of fft_twiddle.h for a 2048 point FFT as assembled: value * 2^31
+ * rounded to the nearest integer, with 1.0 saturated to 0x7FFFFFFF. The
+ * tables for smaller FFTs are the start of these.
+ *
+ * The Chebyshev tables of the block elementary functions hold, for each
+ * segment, the first MATH_HOST_CHEBYSHEV_TERMS coefficients of the
+ * function's Chebyshev series on the segment, value * 2^31 rounded. They
+ * are only given for the segments a function's argument reaches.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "math_host_private.h"
+
+/****************************************************************************
+Public Constant Definitions
+*/
+
+/** cos(w) of each group, in bit reversed order ($fft.twiddle_real) */
+const int32_t math_host_fft_twiddle_real[1024] =
+{
+    (int32_t)0x7FFFFFFF, (int32_t)0x00000000, (int32_t)0x5A82799A, (int32_t)0xA57D8666,
+    (int32_t)0x7641AF3D, (int32_t)0xCF043AB3, (int32_t)0x30FBC54D, (int32_t)0x89BE50C3,
+    (int32_t)0x7D8A5F40, (int32_t)0xE70747C4, (int32_t)0x471CECE7, (int32_t)0x9592675C,
+    (int32_t)0x6A6D98A4, (int32_t)0xB8E31319, (int32_t)0x18F8B83C, (int32_t)0x8275A0C0,
+    (int32_t)0x7F62368F, (int32_t)0xF3742CA2, (int32_t)0x5133CC94, (int32_t)0x9D0DFE54,
+    (int32_t)0x70E2CBC6, (int32_t)0xC3A94590, (int32_t)0x25280C5E, (int32_t)0x8582FAA5,
+    (int32_t)0x7A7D055B, (int32_t)0xDAD7F3A2, (int32_t)0x3C56BA70, (int32_t)0x8F1D343A,
+    (int32_t)0x62F201AC, (int32_t)0xAECC336C, (int32_t)0x0C8BD35E, (int32_t)0x809DC971,
+    (int32_t)0x7FD8878E, (int32_t)0xF9B82684, (int32_t)0x55F5A4D2, (int32_t)0xA1288376,
+    (int32_t)0x73B5EBD1, (int32_t)0xC945DFEC, (int32_t)0x2B1F34EB, (int32_t)0x877B7BEC,
+    (int32_t)0x7C29FBEE, (int32_t)0xE0E60685, (int32_t)0x41CE1E65, (int32_t)0x9235F2EC,
+    (int32_t)0x66CF8120, (int32_t)0xB3C0200C, (int32_t)0x12C8106F, (int32_t)0x8162AA04,
+    (int32_t)0x7E9D55FC, (int32_t)0xED37EF91, (int32_t)0x4C3FDFF4, (int32_t)0x99307EE0,
+    (int32_t)0x6DCA0D14, (int32_t)0xBE31E19B, (int32_t)0x1F19F97B, (int32_t)0x83D60412,
+    (int32_t)0x78848414, (int32_t)0xD4E0CB15, (int32_t)0x36BA2014, (int32_t)0x8C4A142F,
+    (int32_t)0x5ED77C8A, (int32_t)0xAA0A5B2E, (int32_t)0x0647D97C, (int32_t)0x80277872,
+    (int32_t)0x7FF62182, (int32_t)0xFCDBD541, (int32_t)0x5842DD54, (int32_t)0xA34BDF20,
+    (int32_t)0x7504D345, (int32_t)0xCC210D79, (int32_t)0x2E110A62, (int32_t)0x8893B125,
+    (int32_t)0x7CE3CEB1, (int32_t)0xE3F47D95, (int32_t)0x447ACD50, (int32_t)0x93DBD6A0,
+    (int32_t)0x68A69E81, (int32_t)0xB64BEACD, (int32_t)0x15E21445, (int32_t)0x81E26C16,
+    (int32_t)0x7F0991C4, (int32_t)0xF054D8D5, (int32_t)0x4EBFE8A5, (int32_t)0x9B1776DA,
+    (int32_t)0x6F5F02B2, (int32_t)0xC0E8B648, (int32_t)0x2223A4C5, (int32_t)0x84A2FC62,
+    (int32_t)0x798A23B1, (int32_t)0xD7D946D8, (int32_t)0x398CDD32, (int32_t)0x8DAAD37B,
+    (int32_t)0x60EC3830, (int32_t)0xAC64D510, (int32_t)0x096A9049, (int32_t)0x8058C94C,
+    (int32_t)0x7FA736B4, (int32_t)0xF6956FB7, (int32_t)0x539B2AF0, (int32_t)0x9F13C7D0,
+    (int32_t)0x72552C85, (int32_t)0xC67322CE, (int32_t)0x2826B928, (int32_t)0x8675DC4F,
+    (int32_t)0x7B5D039E, (int32_t)0xDDDC5B3B, (int32_t)0x3F1749B8, (int32_t)0x90A0FD4E,
+    (int32_t)0x64E88926, (int32_t)0xB140175B, (int32_t)0x0FAB272B, (int32_t)0x80F66E3C,
+    (int32_t)0x7E1D93EA, (int32_t)0xEA1DEBBB, (int32_t)0x49B41533, (int32_t)0x9759617F,
+    (int32_t)0x6C242960, (int32_t)0xBB8532B0, (int32_t)0x1C0B826B, (int32_t)0x831C314F,
+    (int32_t)0x776C4EDB, (int32_t)0xD1EEF59E, (int32_t)0x33DEF287, (int32_t)0x8AFB2CBB,
+    (int32_t)0x5CB420E0, (int32_t)0xA7BD22AC, (int32_t)0x03242ABF, (int32_t)0x8009DE7E,
+    (int32_t)0x7FFD885A, (int32_t)0xFE6DE2E0, (int32_t)0x59646498, (int32_t)0xA462EEAC,
+    (int32_t)0x75A585CF, (int32_t)0xCD91AB38, (int32_t)0x2F875262, (int32_t)0x8926B677,
+    (int32_t)0x7D3980EC, (int32_t)0xE57D5FDA, (int32_t)0x45CD358F, (int32_t)0x94B50D87,
+    (int32_t)0x698C246C, (int32_t)0xB796199B, (int32_t)0x176DD9DE, (int32_t)0x82299972,
+    (int32_t)0x7F3857F6, (int32_t)0xF1E43D1C, (int32_t)0x4FFB654D, (int32_t)0x9C10CD70,
+    (int32_t)0x7023109A, (int32_t)0xC247CD5A, (int32_t)0x23A6887F, (int32_t)0x85109CDD,
+    (int32_t)0x7A05EEAD, (int32_t)0xD957DE7A, (int32_t)0x3AF2EEB7, (int32_t)0x8E61D32E,
+    (int32_t)0x61F1003F, (int32_t)0xAD96ED92, (int32_t)0x0AFB6805, (int32_t)0x8078D40D,
+    (int32_t)0x7FC25596, (int32_t)0xF826A462, (int32_t)0x54CA0A4B, (int32_t)0xA01C4C73,
+    (int32_t)0x7307C3D0, (int32_t)0xC7DB6C50, (int32_t)0x29A3C485, (int32_t)0x86F656D3,
+    (int32_t)0x7BC5E28F, (int32_t)0xDF608FE4, (int32_t)0x4073F21D, (int32_t)0x91695663,
+    (int32_t)0x65DDFBD3, (int32_t)0xB27E9D3C, (int32_t)0x1139F0CF, (int32_t)0x812A1A3A,
+    (int32_t)0x7E5FE493, (int32_t)0xEBAA894F, (int32_t)0x4AFB6C98, (int32_t)0x9842F043,
+    (int32_t)0x6CF934FC, (int32_t)0xBCDA3ECA, (int32_t)0x1D934FE5, (int32_t)0x8376B422,
+    (int32_t)0x77FAB989, (int32_t)0xD3670446, (int32_t)0x354D9057, (int32_t)0x8BA0622F,
+    (int32_t)0x5DC79D7C, (int32_t)0xA8E21106, (int32_t)0x04B6195D, (int32_t)0x80163440,
+    (int32_t)0x7FE9CBC0, (int32_t)0xFB49E6A3, (int32_t)0x571DEEFA, (int32_t)0xA2386284,
+    (int32_t)0x745F9DD1, (int32_t)0xCAB26FA9, (int32_t)0x2C98FBBA, (int32_t)0x88054677,
+    (int32_t)0x7C894BDE, (int32_t)0xE26CB01B, (int32_t)0x4325C136, (int32_t)0x9306CB04,
+    (int32_t)0x67BD0FBD, (int32_t)0xB5049368, (int32_t)0x145576B1, (int32_t)0x81A01B6D,
+    (int32_t)0x7ED5E5C6, (int32_t)0xEEC60F31, (int32_t)0x4D8162C4, (int32_t)0x9A22042D,
+    (int32_t)0x6E96A99D, (int32_t)0xBF8C0DE3, (int32_t)0x209F701C, (int32_t)0x843A1D71,
+    (int32_t)0x7909A92D, (int32_t)0xD65C3B7B, (int32_t)0x382493B0, (int32_t)0x8CF83C30,
+    (int32_t)0x5FE3B38D, (int32_t)0xAB35F5B5, (int32_t)0x07D95B9E, (int32_t)0x803DAA6A,
+    (int32_t)0x7F872BF3, (int32_t)0xF50497FB, (int32_t)0x5269126E, (int32_t)0x9E0EFFC1,
+    (int32_t)0x719E2CD2, (int32_t)0xC50D1149, (int32_t)0x26A82186, (int32_t)0x85FA1153,
+    (int32_t)0x7AEF6323, (int32_t)0xDC597781, (int32_t)0x3DB832A6, (int32_t)0x8FDCEF66,
+    (int32_t)0x63EF3290, (int32_t)0xB0049AB3, (int32_t)0x0E1BC2E4, (int32_t)0x80C7A80A,
+    (int32_t)0x7DD6668E, (int32_t)0xE8922622, (int32_t)0x4869E665, (int32_t)0x9673DB94,
+    (int32_t)0x6B4AF279, (int32_t)0xBA32CA71, (int32_t)0x1A82A026, (int32_t)0x82C67F14,
+    (int32_t)0x76D94989, (int32_t)0xD078AD9E, (int32_t)0x326E54C8, (int32_t)0x8A5A7A31,
+    (int32_t)0x5B9D1154, (int32_t)0xA69B9B68, (int32_t)0x01921D20, (int32_t)0x800277A6,
+    (int32_t)0x7FFF6216, (int32_t)0xFF36F078, (int32_t)0x59F3DE12, (int32_t)0xA4EFCA31,
+    (int32_t)0x75F42C0B, (int32_t)0xCE4AB5A2, (int32_t)0x3041C761, (int32_t)0x8971F15A,
+    (int32_t)0x7D628AC6, (int32_t)0xE642340D, (int32_t)0x46756828, (int32_t)0x9523369C,
+    (int32_t)0x69FD614B, (int32_t)0xB83C3DD1, (int32_t)0x183366E9, (int32_t)0x824F0208,
+    (int32_t)0x7F4DE450, (int32_t)0xF2AC246E, (int32_t)0x5097FC5E, (int32_t)0x9C8EEB34,
+    (int32_t)0x708378FF, (int32_t)0xC2F83E2A, (int32_t)0x24677758, (int32_t)0x8549345C,
+    (int32_t)0x7A4210D8, (int32_t)0xDA17BA4A, (int32_t)0x3BA51E29, (int32_t)0x8EBEF7FB,
+    (int32_t)0x6271FA69, (int32_t)0xAE312B92, (int32_t)0x0BC3AC35, (int32_t)0x808AB180,
+    (int32_t)0x7FCE0C3E, (int32_t)0xF8EF5CBB, (int32_t)0x556040E2, (int32_t)0xA0A1F24D,
+    (int32_t)0x735F6626, (int32_t)0xC89061BA, (int32_t)0x2A61B101, (int32_t)0x8738545E,
+    (int32_t)0x7BF88830, (int32_t)0xE02323E5, (int32_t)0x4121589B, (int32_t)0x91CF1CB6,
+    (int32_t)0x66573CBB, (int32_t)0xB31EFFCC, (int32_t)0x120116D5, (int32_t)0x8145C5C7,
+    (int32_t)0x7E7F3957, (int32_t)0xEC71244F, (int32_t)0x4B9E0390, (int32_t)0x98B93828,
+    (int32_t)0x6D6227FA, (int32_t)0xBD85BE30, (int32_t)0x1E56CA1E, (int32_t)0x83A5C2B0,
+    (int32_t)0x78403329, (int32_t)0xD423B191, (int32_t)0x36041AD9, (int32_t)0x8BF4AC05,
+    (int32_t)0x5E50015D, (int32_t)0xA975CB56, (int32_t)0x057F0035, (int32_t)0x801E3894,
+    (int32_t)0x7FF09478, (int32_t)0xFC12D91A, (int32_t)0x57B0D256, (int32_t)0xA2C1ADC9,
+    (int32_t)0x74B2C884, (int32_t)0xCB697DB0, (int32_t)0x2D553AFC, (int32_t)0x884BE821,
+    (int32_t)0x7CB72724, (int32_t)0xE330734D, (int32_t)0x43D09AED, (int32_t)0x9370CAE4,
+    (int32_t)0x683257AB, (int32_t)0xB5A7E362, (int32_t)0x151BDF86, (int32_t)0x81C0A801,
+    (int32_t)0x7EF05860, (int32_t)0xEF8D5FB8, (int32_t)0x4E210618, (int32_t)0x9A9C406E,
+    (int32_t)0x6EFB5F12, (int32_t)0xC03A1368, (int32_t)0x2161B3A0, (int32_t)0x846DF477,
+    (int32_t)0x794A7C12, (int32_t)0xD71A8EB5, (int32_t)0x38D8FE93, (int32_t)0x8D50FA59,
+    (int32_t)0x60686CCF, (int32_t)0xABCCFD83, (int32_t)0x08A2009A, (int32_t)0x804A9C4D,
+    (int32_t)0x7F97CEBD, (int32_t)0xF5CCF743, (int32_t)0x53028518, (int32_t)0x9E90EB94,
+    (int32_t)0x71FA3948, (int32_t)0xC5BFD22E, (int32_t)0x27679DF4, (int32_t)0x86376092,
+    (int32_t)0x7B26CB4F, (int32_t)0xDD1ABE51, (int32_t)0x3E680B2C, (int32_t)0x903E6C7B,
+    (int32_t)0x646C59BF, (int32_t)0xB0A1F71D, (int32_t)0x0EE38766, (int32_t)0x80DE6E4C,
+    (int32_t)0x7DFA98A8, (int32_t)0xE957ECFB, (int32_t)0x490F57EE, (int32_t)0x96E61CE0,
+    (int32_t)0x6BB812D1, (int32_t)0xBADBA943, (int32_t)0x1B4732EF, (int32_t)0x82F0BDE8,
+    (int32_t)0x77235F2D, (int32_t)0xD13397E2, (int32_t)0x3326E2C2, (int32_t)0x8AAA42B4,
+    (int32_t)0x5C290ACC, (int32_t)0xA72BF174, (int32_t)0x025B26D7, (int32_t)0x80058D2F,
+    (int32_t)0x7FFA72D1, (int32_t)0xFDA4D929, (int32_t)0x58D40E8C, (int32_t)0xA3D6F534,
+    (int32_t)0x7555BD4C, (int32_t)0xCCD91D3E, (int32_t)0x2ECC681E, (int32_t)0x88DCA0D3,
+    (int32_t)0x7D0F4218, (int32_t)0xE4B8CD11, (int32_t)0x452456BD, (int32_t)0x9447ED2F,
+    (int32_t)0x6919E320, (int32_t)0xB6F0A812, (int32_t)0x16A81305, (int32_t)0x82056758,
+    (int32_t)0x7F2191B4, (int32_t)0xF11C789A, (int32_t)0x4F5E08E3, (int32_t)0x9B93A641,
+    (int32_t)0x6FC19385, (int32_t)0xC197F4D4, (int32_t)0x22E541AF, (int32_t)0x84D934B1,
+    (int32_t)0x79C89F6E, (int32_t)0xD898620C, (int32_t)0x3A402DD2, (int32_t)0x8E05C6B8,
+    (int32_t)0x616F146C, (int32_t)0xACFD7AE8, (int32_t)0x0A3308BD, (int32_t)0x80683143,
+    (int32_t)0x7FB563B3, (int32_t)0xF75DFF66, (int32_t)0x5433027D, (int32_t)0x9F979331,
+    (int32_t)0x72AF05A7, (int32_t)0xC727016D, (int32_t)0x28E5714B, (int32_t)0x86B583EE,
+    (int32_t)0x7B920B89, (int32_t)0xDE9E4C60, (int32_t)0x3FC5EC98, (int32_t)0x9104A0EE,
+    (int32_t)0x6563BF92, (int32_t)0xB1DEF9E8, (int32_t)0x1072A048, (int32_t)0x810FA7A0,
+    (int32_t)0x7E3F57FF, (int32_t)0xEAE4207A, (int32_t)0x4A581C9E, (int32_t)0x97CDA855,
+    (int32_t)0x6C8F351C, (int32_t)0xBC2F6513, (int32_t)0x1CCF8CB3, (int32_t)0x8348D8DC,
+    (int32_t)0x77B417DF, (int32_t)0xD2AAC504, (int32_t)0x34968250, (int32_t)0x8B4D377C,
+    (int32_t)0x5D3E5237, (int32_t)0xA84F2DAA, (int32_t)0x03ED26E6, (int32_t)0x800F6B88,
+    (int32_t)0x7FE1C76C, (int32_t)0xFA80FFCB, (int32_t)0x568A34AA, (int32_t)0xA1AFFEA3,
+    (int32_t)0x740B53FB, (int32_t)0xC9FBE527, (int32_t)0x2BDC4E6F, (int32_t)0x87BFCCD7,
+    (int32_t)0x7C5A3D50, (int32_t)0xE1A935E2, (int32_t)0x427A41D0, (int32_t)0x929DD806,
+    (int32_t)0x6746C7D8, (int32_t)0xB461FC70, (int32_t)0x138EDBB1, (int32_t)0x8180C6A9,
+    (int32_t)0x7EBA3A39, (int32_t)0xEDFEE92B, (int32_t)0x4CE10034, (int32_t)0x99A8C345,
+    (int32_t)0x6E30E34A, (int32_t)0xBEDEA765, (int32_t)0x1FDCDC1B, (int32_t)0x840777D0,
+    (int32_t)0x78C7ABA2, (int32_t)0xD59E4EFF, (int32_t)0x376F9E46, (int32_t)0x8CA099DA,
+    (int32_t)0x5F5E0DB3, (int32_t)0xAA9FBF1E, (int32_t)0x0710A345, (int32_t)0x8031F3C2,
+    (int32_t)0x7F754E80, (int32_t)0xF43C53CB, (int32_t)0x51CED46E, (int32_t)0x9D8E0597,
+    (int32_t)0x71410805, (int32_t)0xC45AE1D7, (int32_t)0x25E845B6, (int32_t)0x85BDEF28,
+    (int32_t)0x7AB6CBA4, (int32_t)0xDB9888A8, (int32_t)0x3D07C1D6, (int32_t)0x8F7C8701,
+    (int32_t)0x637114CC, (int32_t)0xAF6803A2, (int32_t)0x0D53DB92, (int32_t)0x80B21BB0,
+    (int32_t)0x7DB0FDF8, (int32_t)0xE7CC9917, (int32_t)0x47C3C22F, (int32_t)0x96029EB5,
+    (int32_t)0x6ADCC964, (int32_t)0xB98A97D8, (int32_t)0x19BDCBF3, (int32_t)0x829D753A,
+    (int32_t)0x768E0EA6, (int32_t)0xCFBE389F, (int32_t)0x31B54A5E, (int32_t)0x8A0BD3F5,
+    (int32_t)0x5B1035CF, (int32_t)0xA60C21EE, (int32_t)0x00C90F88, (int32_t)0x80009DEA,
+    (int32_t)0x7FFFD886, (int32_t)0xFF9B781D, (int32_t)0x5A3B47AB, (int32_t)0xA5368C4B,
+    (int32_t)0x761B1211, (int32_t)0xCEA768F2, (int32_t)0x309ED556, (int32_t)0x8997FC8A,
+    (int32_t)0x7D769BB5, (int32_t)0xE6A4B616, (int32_t)0x46C9405C, (int32_t)0x955AAE17,
+    (int32_t)0x6A359DB9, (int32_t)0xB88F926D, (int32_t)0x18961728, (int32_t)0x82622AA6,
+    (int32_t)0x7F5834B7, (int32_t)0xF310248A, (int32_t)0x50E5FD6D, (int32_t)0x9CCE562C,
+    (int32_t)0x70B34525, (int32_t)0xC350AF25, (int32_t)0x24C7CD33, (int32_t)0x8565F1B0,
+    (int32_t)0x7A5FB0D8, (int32_t)0xDA77CB63, (int32_t)0x3BFDFECD, (int32_t)0x8EEDF33B,
+    (int32_t)0x62B21C7C, (int32_t)0xAE7E965B, (int32_t)0x0C27C389, (int32_t)0x8094162C,
+    (int32_t)0x7FD37153, (int32_t)0xF953BF91, (int32_t)0x55AB0D46, (int32_t)0xA0E51D8D,
+    (int32_t)0x738ACC9E, (int32_t)0xC8EB0FD6, (int32_t)0x2AC08026, (int32_t)0x8759C2EF,
+    (int32_t)0x7C116853, (int32_t)0xE0848B7F, (int32_t)0x4177CFB1, (int32_t)0x920265E4,
+    (int32_t)0x66937E91, (int32_t)0xB36F784F, (int32_t)0x1264994E, (int32_t)0x815410D4,
+    (int32_t)0x7E8E6EB2, (int32_t)0xECD48407, (int32_t)0x4BEF092D, (int32_t)0x98F4BBBC,
+    (int32_t)0x6D963C54, (int32_t)0xBDDBBB7F, (int32_t)0x1EB86B46, (int32_t)0x83BDBD0E,
+    (int32_t)0x786280BF, (int32_t)0xD48230E9, (int32_t)0x365F2E3B, (int32_t)0x8C1F3C5D,
+    (int32_t)0x5E93DC1F, (int32_t)0xA9BFF8A8, (int32_t)0x05E36EA9, (int32_t)0x8022B114,
+    (int32_t)0x7FF38274, (int32_t)0xFC775616, (int32_t)0x57F9F2F8, (int32_t)0xA306A9C8,
+    (int32_t)0x74DBF1EF, (int32_t)0xCBC53579, (int32_t)0x2DB330C7, (int32_t)0x886FA7C2,
+    (int32_t)0x7CCDA169, (int32_t)0xE3926FAD, (int32_t)0x4425C923, (int32_t)0x93A62F57,
+    (int32_t)0x686C9B4B, (int32_t)0xB5F9D043, (int32_t)0x157F0086, (int32_t)0x81D16321,
+    (int32_t)0x7EFD1C3C, (int32_t)0xEFF11753, (int32_t)0x4E708F8F, (int32_t)0x9AD9BC71,
+    (int32_t)0x6F2D532C, (int32_t)0xC0915148, (int32_t)0x21C2B69C, (int32_t)0x84885258,
+    (int32_t)0x796A7554, (int32_t)0xD779DE47, (int32_t)0x3932FF87, (int32_t)0x8D7DC399,
+    (int32_t)0x60AA7050, (int32_t)0xAC18CF69, (int32_t)0x09064B3A, (int32_t)0x80518B6B,
+    (int32_t)0x7F9FAA15, (int32_t)0xF6313077, (int32_t)0x534EF1B5, (int32_t)0x9ED23BB9,
+    (int32_t)0x7227D61C, (int32_t)0xC61968A2, (int32_t)0x27C737D3, (int32_t)0x865678EB,
+    (int32_t)0x7B420D7A, (int32_t)0xDD7B8220, (int32_t)0x3EBFBDCD, (int32_t)0x906F927C,
+    (int32_t)0x64AA907F, (int32_t)0xB0F0EEDA, (int32_t)0x0F475BFF, (int32_t)0x80EA4712,
+    (int32_t)0x7E0C3D29, (int32_t)0xE9BAE57D, (int32_t)0x4961CD33, (int32_t)0x971F9ED7,
+    (int32_t)0x6BEE3F62, (int32_t)0xBB3058C0, (int32_t)0x1BA96335, (int32_t)0x83065110,
+    (int32_t)0x7747FBCE, (int32_t)0xD191386E, (int32_t)0x3382FA88, (int32_t)0x8AD29394,
+    (int32_t)0x5C6EB258, (int32_t)0xA7746EC0, (int32_t)0x02BFA9A4, (int32_t)0x80078E5E,
+    (int32_t)0x7FFC250F, (int32_t)0xFE095D69, (int32_t)0x591C550E, (int32_t)0xA41CD599,
+    (int32_t)0x757DC5CA, (int32_t)0xCD355491, (int32_t)0x2F29EBCC, (int32_t)0x890186F2,
+    (int32_t)0x7D24881B, (int32_t)0xE51B0E2A, (int32_t)0x4578DB94, (int32_t)0x947E5C33,
+    (int32_t)0x69532442, (int32_t)0xB7434A67, (int32_t)0x170AFD8D, (int32_t)0x82175990,
+    (int32_t)0x7F2D1C0E, (int32_t)0xF1805662, (int32_t)0x4FACCFAB, (int32_t)0x9BD21AF3,
+    (int32_t)0x6FF27497, (int32_t)0xC1EFCDF3, (int32_t)0x2345EFF8, (int32_t)0x84F4C2D4,
+    (int32_t)0x79E76CA7, (int32_t)0xD8F81439, (int32_t)0x3A99A057, (int32_t)0x8E33A9D9,
+    (int32_t)0x61B02876, (int32_t)0xAD4A1ABA, (int32_t)0x0A973BA5, (int32_t)0x80705B50,
+    (int32_t)0x7FBC040A, (int32_t)0xF7C24F59, (int32_t)0x547EA073, (int32_t)0x9FD9D22A,
+    (int32_t)0x72DB8828, (int32_t)0xC7812572, (int32_t)0x2944A7A2, (int32_t)0x86D5C802,
+    (int32_t)0x7BAC1D31, (int32_t)0xDEFF63F4, (int32_t)0x401D0321, (int32_t)0x9136D97D,
+    (int32_t)0x65A0FD0B, (int32_t)0xB22EB392, (int32_t)0x10D64DBD, (int32_t)0x811CB9CA,
+    (int32_t)0x7E4FC53E, (int32_t)0xEB474E80, (int32_t)0x4AA9DBA2, (int32_t)0x98082C3B,
+    (int32_t)0x6CC45698, (int32_t)0xBC84BD1F, (int32_t)0x1D31774D, (int32_t)0x835FA00F,
+    (int32_t)0x77D78DAA, (int32_t)0xD308D6C7, (int32_t)0x34F219A8, (int32_t)0x8B76A8E4,
+    (int32_t)0x5D8314B1, (int32_t)0xA8988463, (int32_t)0x0451A177, (int32_t)0x8012A86F,
+    (int32_t)0x7FE5F108, (int32_t)0xFAE571A4, (int32_t)0x56D42C99, (int32_t)0xA1F41392,
+    (int32_t)0x74359CBD, (int32_t)0xCA5719DB, (int32_t)0x2C3AB2B9, (int32_t)0x87E2649B,
+    (int32_t)0x7C71EAF9, (int32_t)0xE20AE9C1, (int32_t)0x42D0161E, (int32_t)0x92D22FD9,
+    (int32_t)0x67820BB7, (int32_t)0xB4B330B3, (int32_t)0x13F22F58, (int32_t)0x81904A0C,
+    (int32_t)0x7EC8371A, (int32_t)0xEE6276BF, (int32_t)0x4D31494B, (int32_t)0x99E5443B,
+    (int32_t)0x6E63E87F, (int32_t)0xBF3546A8, (int32_t)0x203E300E, (int32_t)0x8420A46C,
+    (int32_t)0x78E8CFB2, (int32_t)0xD5FD3848, (int32_t)0x37CA2A30, (int32_t)0x8CCC477D,
+    (int32_t)0x5FA0FE1F, (int32_t)0xAAEAC02C, (int32_t)0x077501BE, (int32_t)0x8037A7AD,
+    (int32_t)0x7F7E648C, (int32_t)0xF4A07261, (int32_t)0x521C0CC1, (int32_t)0x9DCE6463,
+    (int32_t)0x716FBD68, (int32_t)0xC4B3E746, (int32_t)0x26483F6C, (int32_t)0x85DBDA91,
+    (int32_t)0x7AD33D45, (int32_t)0xDBF8F4F8, (int32_t)0x3D600D2C, (int32_t)0x8FAC988F,
+    (int32_t)0x63B0426D, (int32_t)0xAFB63667, (int32_t)0x0DB7D376, (int32_t)0x80BCBA9D,
+    (int32_t)0x7DC3D90D, (int32_t)0xE82F5844, (int32_t)0x4816EA86, (int32_t)0x963B1C86,
+    (int32_t)0x6B13FEF5, (int32_t)0xB9DE9B83, (int32_t)0x1A203E1B, (int32_t)0x82B1D381,
+    (int32_t)0x76B3D0B4, (int32_t)0xD01B6459, (int32_t)0x3211DF04, (int32_t)0x8A3302BE,
+    (int32_t)0x5B56BFBD, (int32_t)0xA653C303, (int32_t)0x012D96B1, (int32_t)0x8001634E,
+    (int32_t)0x7FFE9CB2, (int32_t)0xFED2694F, (int32_t)0x59AC3CFD, (int32_t)0xA4A94043,
+    (int32_t)0x75CCFD42, (int32_t)0xCDEE20FC, (int32_t)0x2FE49BA7, (int32_t)0x894C2F4C,
+    (int32_t)0x7D4E2C7F, (int32_t)0xE5DFC1E5, (int32_t)0x4621647D, (int32_t)0x94EC010B,
+    (int32_t)0x69C4E37A, (int32_t)0xB7E9157A, (int32_t)0x17D0A7BC, (int32_t)0x823C26F3,
+    (int32_t)0x7F434563, (int32_t)0xF2482C8A, (int32_t)0x5049C999, (int32_t)0x9C4FBD93,
+    (int32_t)0x70536771, (int32_t)0xC29FF2D4, (int32_t)0x24070B08, (int32_t)0x852CC2BB,
+    (int32_t)0x7A24256F, (int32_t)0xD9B7C094, (int32_t)0x3B4C18BA, (int32_t)0x8E904298,
+    (int32_t)0x62319B9D, (int32_t)0xADE3F33F, (int32_t)0x0B5F8D9F, (int32_t)0x80819B74,
+    (int32_t)0x7FC85853, (int32_t)0xF88AFE42, (int32_t)0x55153FD4, (int32_t)0xA05F01E1,
+    (int32_t)0x7333B883, (int32_t)0xC835D5D0, (int32_t)0x2A02C7B8, (int32_t)0x8717304E,
+    (int32_t)0x7BDF5B94, (int32_t)0xDFC1CFF2, (int32_t)0x40CAB958, (int32_t)0x919C1781,
+    (int32_t)0x661ABBC5, (int32_t)0xB2CEB6B5, (int32_t)0x119D8941, (int32_t)0x8137C8E6,
+    (int32_t)0x7E6FB5F4, (int32_t)0xEC0DD0A8, (int32_t)0x4B4CCF4D, (int32_t)0x987DF449,
+    (int32_t)0x6D2DD027, (int32_t)0xBD2FE9E2, (int32_t)0x1DF5163F, (int32_t)0x838E1507,
+    (int32_t)0x781D9B65, (int32_t)0xD3C54D47, (int32_t)0x35A8E625, (int32_t)0x8BCA6343,
+    (int32_t)0x5E0BEC6E, (int32_t)0xA92BD367, (int32_t)0x051A8E5C, (int32_t)0x801A0EF8,
+    (int32_t)0x7FED5791, (int32_t)0xFBAE5E89, (int32_t)0x57677B9D, (int32_t)0xA27CEB4F,
+    (int32_t)0x7489571C, (int32_t)0xCB0DE658, (int32_t)0x2CF72939, (int32_t)0x88287256,
+    (int32_t)0x7CA05FF1, (int32_t)0xE2CE88B3, (int32_t)0x437B42E1, (int32_t)0x933BA968,
+    (int32_t)0x67F7D3C5, (int32_t)0xB556245E, (int32_t)0x14B8B180, (int32_t)0x81B03AC2,
+    (int32_t)0x7EE34636, (int32_t)0xEF29B243, (int32_t)0x4DD14C6E, (int32_t)0x9A5F02F5,
+    (int32_t)0x6EC92683, (int32_t)0xBFE2FCDF, (int32_t)0x21009C0C, (int32_t)0x8453E2CF,
+    (int32_t)0x792A37FE, (int32_t)0xD6BB585E, (int32_t)0x387EDA8E, (int32_t)0x8D2477D8,
+    (int32_t)0x60262DD6, (int32_t)0xAB815F8D, (int32_t)0x083DB0A7, (int32_t)0x8043FBF6,
+    (int32_t)0x7F8FA4B0, (int32_t)0xF568C45B, (int32_t)0x52B5E546, (int32_t)0x9E4FD78A,
+    (int32_t)0x71CC5627, (int32_t)0xC5665FA9, (int32_t)0x2707EBC7, (int32_t)0x86189359,
+    (int32_t)0x7B0B3D2C, (int32_t)0xDCBA1008, (int32_t)0x3E10320D, (int32_t)0x900D8B69,
+    (int32_t)0x642DE50D, (int32_t)0xB0533055, (int32_t)0x0E7FA99E, (int32_t)0x80D2E3F2,
+    (int32_t)0x7DE8A670, (int32_t)0xE8F50273, (int32_t)0x48BCB599, (int32_t)0x96ACDBBE,
+    (int32_t)0x6B81A3CD, (int32_t)0xBA87246C, (int32_t)0x1AE4F1D6, (int32_t)0x82DB77E5,
+    (int32_t)0x76FE790E, (int32_t)0xD0D61434, (int32_t)0x32CAAB6F, (int32_t)0x8A823A36,
+    (int32_t)0x5BE32A67, (int32_t)0xA6E3AAF2, (int32_t)0x01F6A297, (int32_t)0x8003DAF1,
+    (int32_t)0x7FF871A2, (int32_t)0xFD40565C, (int32_t)0x588B9140, (int32_t)0xA3914DA8,
+    (int32_t)0x752D6C6C, (int32_t)0xCC7D0578, (int32_t)0x2E6EC792, (int32_t)0x88B80432,
+    (int32_t)0x7CF9AEF0, (int32_t)0xE4569CCB, (int32_t)0x44CFA740, (int32_t)0x9411C09E,
+    (int32_t)0x68E06129, (int32_t)0xB69E32CD, (int32_t)0x16451A83, (int32_t)0x81F3C2D7,
+    (int32_t)0x7F15B8EE, (int32_t)0xF0B8A401, (int32_t)0x4F0F1126, (int32_t)0x9B556F81,
+    (int32_t)0x6F906D84, (int32_t)0xC1404233, (int32_t)0x22847DE0, (int32_t)0x84BDF286,
+    (int32_t)0x79A98715, (int32_t)0xD838C82D, (int32_t)0x39E6975E, (int32_t)0x8DD829E4,
+    (int32_t)0x612DC447, (int32_t)0xACB10E4B, (int32_t)0x09CECF89, (int32_t)0x806055EB,
+    (int32_t)0x7FAE7495, (int32_t)0xF6F9B4C6, (int32_t)0x53E73097, (int32_t)0x9F558FB0,
+    (int32_t)0x72823C67, (int32_t)0xC6CD0079, (int32_t)0x288621B9, (int32_t)0x86958AAC,
+    (int32_t)0x7B77ADA8, (int32_t)0xDE3D4964, (int32_t)0x3F6EAEB8, (int32_t)0x90D2ACD4,
+    (int32_t)0x6526438F, (int32_t)0xB18F7071, (int32_t)0x100EE8AD, (int32_t)0x8102E3C4,
+    (int32_t)0x7E2E9CDF, (int32_t)0xEA80FF7A, (int32_t)0x4A062FBD, (int32_t)0x979364B5,
+    (int32_t)0x6C59D0A9, (int32_t)0xBBDA36DD, (int32_t)0x1C6D9053, (int32_t)0x83325E97,
+    (int32_t)0x7790583E, (int32_t)0xD24CCF39, (int32_t)0x343ACA87, (int32_t)0x8B240E11,
+    (int32_t)0x5CF95638, (int32_t)0xA8060D08, (int32_t)0x0388A9EA, (int32_t)0x800C7D8C,
+    (int32_t)0x7FDD4EEC, (int32_t)0xFA1C9157, (int32_t)0x56400758, (int32_t)0xA16C23E1,
+    (int32_t)0x73E0C3A3, (int32_t)0xC9A0D1C5, (int32_t)0x2B7DCF17, (int32_t)0x879D7F41,
+    (int32_t)0x7C4242F2, (int32_t)0xE14794BA, (int32_t)0x42244481, (int32_t)0x9269C3AC,
+    (int32_t)0x670B4444, (int32_t)0xB410F6D3, (int32_t)0x132B7BF9, (int32_t)0x8171914E,
+    (int32_t)0x7EABEF2C, (int32_t)0xED9B66B2, (int32_t)0x4C9087B1, (int32_t)0x996C816F,
+    (int32_t)0x6DFD9A1C, (int32_t)0xBE88304F, (int32_t)0x1F7B7481, (int32_t)0x83EE97AD,
+    (int32_t)0x78A63D11, (int32_t)0xD53F7FDA, (int32_t)0x3714F02A, (int32_t)0x8C753362,
+    (int32_t)0x5F1AE273, (int32_t)0xAA54F2BA, (int32_t)0x06AC406F, (int32_t)0x802C8EAD,
+    (int32_t)0x7F6BE9D4, (int32_t)0xF3D83C77, (int32_t)0x518169A5, (int32_t)0x9D4DE384,
+    (int32_t)0x71120CC5, (int32_t)0xC4020133, (int32_t)0x2588349D, (int32_t)0x85A04F28,
+    (int32_t)0x7A9A0E50, (int32_t)0xDB3832CD, (int32_t)0x3CAF50DB, (int32_t)0x8F4CBADB,
+    (int32_t)0x6331A9D4, (int32_t)0xAF1A0293, (int32_t)0x0CEFDB76, (int32_t)0x80A7CB49,
+    (int32_t)0x7D9DD55A, (int32_t)0xE769E8D8, (int32_t)0x47706D93, (int32_t)0x95CA6247,
+    (int32_t)0x6AA551E9, (int32_t)0xB936BFA4, (int32_t)0x195B49EA, (int32_t)0x8289644B,
+    (int32_t)0x76680376, (int32_t)0xCF612AAA, (int32_t)0x3158970E, (int32_t)0x89E4EDEF,
+    (int32_t)0x5AC973B5, (int32_t)0xA5C4B855, (int32_t)0x006487E3, (int32_t)0x8000277A
+};
+
+/** -sin(w) of each group, in bit reversed order ($fft.twiddle_imag) */
+const int32_t math_host_fft_twiddle_imag[1024] =
+{
+    (int32_t)0x00000000, (int32_t)0x80000000, (int32_t)0xA57D8666, (int32_t)0xA57D8666,
+    (int32_t)0xCF043AB3, (int32_t)0x89BE50C3, (int32_t)0x89BE50C3, (int32_t)0xCF043AB3,
+    (int32_t)0xE70747C4, (int32_t)0x8275A0C0, (int32_t)0x9592675C, (int32_t)0xB8E31319,
+    (int32_t)0xB8E31319, (int32_t)0x9592675C, (int32_t)0x8275A0C0, (int32_t)0xE70747C4,
+    (int32_t)0xF3742CA2, (int32_t)0x809DC971, (int32_t)0x9D0DFE54, (int32_t)0xAECC336C,
+    (int32_t)0xC3A94590, (int32_t)0x8F1D343A, (int32_t)0x8582FAA5, (int32_t)0xDAD7F3A2,
+    (int32_t)0xDAD7F3A2, (int32_t)0x8582FAA5, (int32_t)0x8F1D343A, (int32_t)0xC3A94590,
+    (int32_t)0xAECC336C, (int32_t)0x9D0DFE54, (int32_t)0x809DC971, (int32_t)0xF3742CA2,
+    (int32_t)0xF9B82684, (int32_t)0x80277872, (int32_t)0xA1288376, (int32_t)0xAA0A5B2E,
+    (int32_t)0xC945DFEC, (int32_t)0x8C4A142F, (int32_t)0x877B7BEC, (int32_t)0xD4E0CB15,
+    (int32_t)0xE0E60685, (int32_t)0x83D60412, (int32_t)0x9235F2EC, (int32_t)0xBE31E19B,
+    (int32_t)0xB3C0200C, (int32_t)0x99307EE0, (int32_t)0x8162AA04, (int32_t)0xED37EF91,
+    (int32_t)0xED37EF91, (int32_t)0x8162AA04, (int32_t)0x99307EE0, (int32_t)0xB3C0200C,
+    (int32_t)0xBE31E19B, (int32_t)0x9235F2EC, (int32_t)0x83D60412, (int32_t)0xE0E60685,
+    (int32_t)0xD4E0CB15, (int32_t)0x877B7BEC, (int32_t)0x8C4A142F, (int32_t)0xC945DFEC,
+    (int32_t)0xAA0A5B2E, (int32_t)0xA1288376, (int32_t)0x80277872, (int32_t)0xF9B82684,
+    (int32_t)0xFCDBD541, (int32_t)0x8009DE7E, (int32_t)0xA34BDF20, (int32_t)0xA7BD22AC,
+    (int32_t)0xCC210D79, (int32_t)0x8AFB2CBB, (int32_t)0x8893B125, (int32_t)0xD1EEF59E,
+    (int32_t)0xE3F47D95, (int32_t)0x831C314F, (int32_t)0x93DBD6A0, (int32_t)0xBB8532B0,
+    (int32_t)0xB64BEACD, (int32_t)0x9759617F, (int32_t)0x81E26C16, (int32_t)0xEA1DEBBB,
+    (int32_t)0xF054D8D5, (int32_t)0x80F66E3C, (int32_t)0x9B1776DA, (int32_t)0xB140175B,
+    (int32_t)0xC0E8B648, (int32_t)0x90A0FD4E, (int32_t)0x84A2FC62, (int32_t)0xDDDC5B3B,
+    (int32_t)0xD7D946D8, (int32_t)0x8675DC4F, (int32_t)0x8DAAD37B, (int32_t)0xC67322CE,
+    (int32_t)0xAC64D510, (int32_t)0x9F13C7D0, (int32_t)0x8058C94C, (int32_t)0xF6956FB7,
+    (int32_t)0xF6956FB7, (int32_t)0x8058C94C, (int32_t)0x9F13C7D0, (int32_t)0xAC64D510,
+    (int32_t)0xC67322CE, (int32_t)0x8DAAD37B, (int32_t)0x8675DC4F, (int32_t)0xD7D946D8,
+    (int32_t)0xDDDC5B3B, (int32_t)0x84A2FC62, (int32_t)0x90A0FD4E, (int32_t)0xC0E8B648,
+    (int32_t)0xB140175B, (int32_t)0x9B1776DA, (int32_t)0x80F66E3C, (int32_t)0xF054D8D5,
+    (int32_t)0xEA1DEBBB, (int32_t)0x81E26C16, (int32_t)0x9759617F, (int32_t)0xB64BEACD,
+    (int32_t)0xBB8532B0, (int32_t)0x93DBD6A0, (int32_t)0x831C314F, (int32_t)0xE3F47D95,
+    (int32_t)0xD1EEF59E, (int32_t)0x8893B125, (int32_t)0x8AFB2CBB, (int32_t)0xCC210D79,
+    (int32_t)0xA7BD22AC, (int32_t)0xA34BDF20, (int32_t)0x8009DE7E, (int32_t)0xFCDBD541,
+    (int32_t)0xFE6DE2E0, (int32_t)0x800277A6, (int32_t)0xA462EEAC, (int32_t)0xA69B9B68,
+    (int32_t)0xCD91AB38, (int32_t)0x8A5A7A31, (int32_t)0x8926B677, (int32_t)0xD078AD9E,
+    (int32_t)0xE57D5FDA, (int32_t)0x82C67F14, (int32_t)0x94B50D87, (int32_t)0xBA32CA71,
+    (int32_t)0xB796199B, (int32_t)0x9673DB94, (int32_t)0x82299972, (int32_t)0xE8922622,
+    (int32_t)0xF1E43D1C, (int32_t)0x80C7A80A, (int32_t)0x9C10CD70, (int32_t)0xB0049AB3,
+    (int32_t)0xC247CD5A, (int32_t)0x8FDCEF66, (int32_t)0x85109CDD, (int32_t)0xDC597781,
+    (int32_t)0xD957DE7A, (int32_t)0x85FA1153, (int32_t)0x8E61D32E, (int32_t)0xC50D1149,
+    (int32_t)0xAD96ED92, (int32_t)0x9E0EFFC1, (int32_t)0x8078D40D, (int32_t)0xF50497FB,
+    (int32_t)0xF826A462, (int32_t)0x803DAA6A, (int32_t)0xA01C4C73, (int32_t)0xAB35F5B5,
+    (int32_t)0xC7DB6C50, (int32_t)0x8CF83C30, (int32_t)0x86F656D3, (int32_t)0xD65C3B7B,
+    (int32_t)0xDF608FE4, (int32_t)0x843A1D71, (int32_t)0x91695663, (int32_t)0xBF8C0DE3,
+    (int32_t)0xB27E9D3C, (int32_t)0x9A22042D, (int32_t)0x812A1A3A, (int32_t)0xEEC60F31,
+    (int32_t)0xEBAA894F, (int32_t)0x81A01B6D, (int32_t)0x9842F043, (int32_t)0xB5049368,
+    (int32_t)0xBCDA3ECA, (int32_t)0x9306CB04, (int32_t)0x8376B422, (int32_t)0xE26CB01B,
+    (int32_t)0xD3670446, (int32_t)0x88054677, (int32_t)0x8BA0622F, (int32_t)0xCAB26FA9,
+    (int32_t)0xA8E21106, (int32_t)0xA2386284, (int32_t)0x80163440, (int32_t)0xFB49E6A3,
+    (int32_t)0xFB49E6A3, (int32_t)0x80163440, (int32_t)0xA2386284, (int32_t)0xA8E21106,
+    (int32_t)0xCAB26FA9, (int32_t)0x8BA0622F, (int32_t)0x88054677, (int32_t)0xD3670446,
+    (int32_t)0xE26CB01B, (int32_t)0x8376B422, (int32_t)0x9306CB04, (int32_t)0xBCDA3ECA,
+    (int32_t)0xB5049368, (int32_t)0x9842F043, (int32_t)0x81A01B6D, (int32_t)0xEBAA894F,
+    (int32_t)0xEEC60F31, (int32_t)0x812A1A3A, (int32_t)0x9A22042D, (int32_t)0xB27E9D3C,
+    (int32_t)0xBF8C0DE3, (int32_t)0x91695663, (int32_t)0x843A1D71, (int32_t)0xDF608FE4,
+    (int32_t)0xD65C3B7B, (int32_t)0x86F656D3, (int32_t)0x8CF83C30, (int32_t)0xC7DB6C50,
+    (int32_t)0xAB35F5B5, (int32_t)0xA01C4C73, (int32_t)0x803DAA6A, (int32_t)0xF826A462,
+    (int32_t)0xF50497FB, (int32_t)0x8078D40D, (int32_t)0x9E0EFFC1, (int32_t)0xAD96ED92,
+    (int32_t)0xC50D1149, (int32_t)0x8E61D32E, (int32_t)0x85FA1153, (int32_t)0xD957DE7A,
+    (int32_t)0xDC597781, (int32_t)0x85109CDD, (int32_t)0x8FDCEF66, (int32_t)0xC247CD5A,
+    (int32_t)0xB0049AB3, (int32_t)0x9C10CD70, (int32_t)0x80C7A80A, (int32_t)0xF1E43D1C,
+    (int32_t)0xE8922622, (int32_t)0x82299972, (int32_t)0x9673DB94, (int32_t)0xB796199B,
+    (int32_t)0xBA32CA71, (int32_t)0x94B50D87, (int32_t)0x82C67F14, (int32_t)0xE57D5FDA,
+    (int32_t)0xD078AD9E, (int32_t)0x8926B677, (int32_t)0x8A5A7A31, (int32_t)0xCD91AB38,
+    (int32_t)0xA69B9B68, (int32_t)0xA462EEAC, (int32_t)0x800277A6, (int32_t)0xFE6DE2E0,
+    (int32_t)0xFF36F078, (int32_t)0x80009DEA, (int32_t)0xA4EFCA31, (int32_t)0xA60C21EE,
+    (int32_t)0xCE4AB5A2, (int32_t)0x8A0BD3F5, (int32_t)0x8971F15A, (int32_t)0xCFBE389F,
+    (int32_t)0xE642340D, (int32_t)0x829D753A, (int32_t)0x9523369C, (int32_t)0xB98A97D8,
+    (int32_t)0xB83C3DD1, (int32_t)0x96029EB5, (int32_t)0x824F0208, (int32_t)0xE7CC9917,
+    (int32_t)0xF2AC246E, (int32_t)0x80B21BB0, (int32_t)0x9C8EEB34, (int32_t)0xAF6803A2,
+    (int32_t)0xC2F83E2A, (int32_t)0x8F7C8701, (int32_t)0x8549345C, (int32_t)0xDB9888A8,
+    (int32_t)0xDA17BA4A, (int32_t)0x85BDEF28, (int32_t)0x8EBEF7FB, (int32_t)0xC45AE1D7,
+    (int32_t)0xAE312B92, (int32_t)0x9D8E0597, (int32_t)0x808AB180, (int32_t)0xF43C53CB,
+    (int32_t)0xF8EF5CBB, (int32_t)0x8031F3C2, (int32_t)0xA0A1F24D, (int32_t)0xAA9FBF1E,
+    (int32_t)0xC89061BA, (int32_t)0x8CA099DA, (int32_t)0x8738545E, (int32_t)0xD59E4EFF,
+    (int32_t)0xE02323E5, (int32_t)0x840777D0, (int32_t)0x91CF1CB6, (int32_t)0xBEDEA765,
+    (int32_t)0xB31EFFCC, (int32_t)0x99A8C345, (int32_t)0x8145C5C7, (int32_t)0xEDFEE92B,
+    (int32_t)0xEC71244F, (int32_t)0x8180C6A9, (int32_t)0x98B93828, (int32_t)0xB461FC70,
+    (int32_t)0xBD85BE30, (int32_t)0x929DD806, (int32_t)0x83A5C2B0, (int32_t)0xE1A935E2,
+    (int32_t)0xD423B191, (int32_t)0x87BFCCD7, (int32_t)0x8BF4AC05, (int32_t)0xC9FBE527,
+    (int32_t)0xA975CB56, (int32_t)0xA1AFFEA3, (int32_t)0x801E3894, (int32_t)0xFA80FFCB,
+    (int32_t)0xFC12D91A, (int32_t)0x800F6B88, (int32_t)0xA2C1ADC9, (int32_t)0xA84F2DAA,
+    (int32_t)0xCB697DB0, (int32_t)0x8B4D377C, (int32_t)0x884BE821, (int32_t)0xD2AAC504,
+    (int32_t)0xE330734D, (int32_t)0x8348D8DC, (int32_t)0x9370CAE4, (int32_t)0xBC2F6513,
+    (int32_t)0xB5A7E362, (int32_t)0x97CDA855, (int32_t)0x81C0A801, (int32_t)0xEAE4207A,
+    (int32_t)0xEF8D5FB8, (int32_t)0x810FA7A0, (int32_t)0x9A9C406E, (int32_t)0xB1DEF9E8,
+    (int32_t)0xC03A1368, (int32_t)0x9104A0EE, (int32_t)0x846DF477, (int32_t)0xDE9E4C60,
+    (int32_t)0xD71A8EB5, (int32_t)0x86B583EE, (int32_t)0x8D50FA59, (int32_t)0xC727016D,
+    (int32_t)0xABCCFD83, (int32_t)0x9F979331, (int32_t)0x804A9C4D, (int32_t)0xF75DFF66,
+    (int32_t)0xF5CCF743, (int32_t)0x80683143, (int32_t)0x9E90EB94, (int32_t)0xACFD7AE8,
+    (int32_t)0xC5BFD22E, (int32_t)0x8E05C6B8, (int32_t)0x86376092, (int32_t)0xD898620C,
+    (int32_t)0xDD1ABE51, (int32_t)0x84D934B1, (int32_t)0x903E6C7B, (int32_t)0xC197F4D4,
+    (int32_t)0xB0A1F71D, (int32_t)0x9B93A641, (int32_t)0x80DE6E4C, (int32_t)0xF11C789A,
+    (int32_t)0xE957ECFB, (int32_t)0x82056758, (int32_t)0x96E61CE0, (int32_t)0xB6F0A812,
+    (int32_t)0xBADBA943, (int32_t)0x9447ED2F, (int32_t)0x82F0BDE8, (int32_t)0xE4B8CD11,
+    (int32_t)0xD13397E2, (int32_t)0x88DCA0D3, (int32_t)0x8AAA42B4, (int32_t)0xCCD91D3E,
+    (int32_t)0xA72BF174, (int32_t)0xA3D6F534, (int32_t)0x80058D2F, (int32_t)0xFDA4D929,
+    (int32_t)0xFDA4D929, (int32_t)0x80058D2F, (int32_t)0xA3D6F534, (int32_t)0xA72BF174,
+    (int32_t)0xCCD91D3E, (int32_t)0x8AAA42B4, (int32_t)0x88DCA0D3, (int32_t)0xD13397E2,
+    (int32_t)0xE4B8CD11, (int32_t)0x82F0BDE8, (int32_t)0x9447ED2F, (int32_t)0xBADBA943,
+    (int32_t)0xB6F0A812, (int32_t)0x96E61CE0, (int32_t)0x82056758, (int32_t)0xE957ECFB,
+    (int32_t)0xF11C789A, (int32_t)0x80DE6E4C, (int32_t)0x9B93A641, (int32_t)0xB0A1F71D,
+    (int32_t)0xC197F4D4, (int32_t)0x903E6C7B, (int32_t)0x84D934B1, (int32_t)0xDD1ABE51,
+    (int32_t)0xD898620C, (int32_t)0x86376092, (int32_t)0x8E05C6B8, (int32_t)0xC5BFD22E,
+    (int32_t)0xACFD7AE8, (int32_t)0x9E90EB94, (int32_t)0x80683143, (int32_t)0xF5CCF743,
+    (int32_t)0xF75DFF66, (int32_t)0x804A9C4D, (int32_t)0x9F979331, (int32_t)0xABCCFD83,
+    (int32_t)0xC727016D, (int32_t)0x8D50FA59, (int32_t)0x86B583EE, (int32_t)0xD71A8EB5,
+    (int32_t)0xDE9E4C60, (int32_t)0x846DF477, (int32_t)0x9104A0EE, (int32_t)0xC03A1368,
+    (int32_t)0xB1DEF9E8, (int32_t)0x9A9C406E, (int32_t)0x810FA7A0, (int32_t)0xEF8D5FB8,
+    (int32_t)0xEAE4207A, (int32_t)0x81C0A801, (int32_t)0x97CDA855, (int32_t)0xB5A7E362,
+    (int32_t)0xBC2F6513, (int32_t)0x9370CAE4, (int32_t)0x8348D8DC, (int32_t)0xE330734D,
+    (int32_t)0xD2AAC504, (int32_t)0x884BE821, (int32_t)0x8B4D377C, (int32_t)0xCB697DB0,
+    (int32_t)0xA84F2DAA, (int32_t)0xA2C1ADC9, (int32_t)0x800F6B88, (int32_t)0xFC12D91A,
+    (int32_t)0xFA80FFCB, (int32_t)0x801E3894, (int32_t)0xA1AFFEA3, (int32_t)0xA975CB56,
+    (int32_t)0xC9FBE527, (int32_t)0x8BF4AC05, (int32_t)0x87BFCCD7, (int32_t)0xD423B191,
+    (int32_t)0xE1A935E2, (int32_t)0x83A5C2B0, (int32_t)0x929DD806, (int32_t)0xBD85BE30,
+    (int32_t)0xB461FC70, (int32_t)0x98B93828, (int32_t)0x8180C6A9, (int32_t)0xEC71244F,
+    (int32_t)0xEDFEE92B, (int32_t)0x8145C5C7, (int32_t)0x99A8C345, (int32_t)0xB31EFFCC,
+    (int32_t)0xBEDEA765, (int32_t)0x91CF1CB6, (int32_t)0x840777D0, (int32_t)0xE02323E5,
+    (int32_t)0xD59E4EFF, (int32_t)0x8738545E, (int32_t)0x8CA099DA, (int32_t)0xC89061BA,
+    (int32_t)0xAA9FBF1E, (int32_t)0xA0A1F24D, (int32_t)0x8031F3C2, (int32_t)0xF8EF5CBB,
+    (int32_t)0xF43C53CB, (int32_t)0x808AB180, (int32_t)0x9D8E0597, (int32_t)0xAE312B92,
+    (int32_t)0xC45AE1D7, (int32_t)0x8EBEF7FB, (int32_t)0x85BDEF28, (int32_t)0xDA17BA4A,
+    (int32_t)0xDB9888A8, (int32_t)0x8549345C, (int32_t)0x8F7C8701, (int32_t)0xC2F83E2A,
+    (int32_t)0xAF6803A2, (int32_t)0x9C8EEB34, (int32_t)0x80B21BB0, (int32_t)0xF2AC246E,
+    (int32_t)0xE7CC9917, (int32_t)0x824F0208, (int32_t)0x96029EB5, (int32_t)0xB83C3DD1,
+    (int32_t)0xB98A97D8, (int32_t)0x9523369C, (int32_t)0x829D753A, (int32_t)0xE642340D,
+    (int32_t)0xCFBE389F, (int32_t)0x8971F15A, (int32_t)0x8A0BD3F5, (int32_t)0xCE4AB5A2,
+    (int32_t)0xA60C21EE, (int32_t)0xA4EFCA31, (int32_t)0x80009DEA, (int32_t)0xFF36F078,
+    (int32_t)0xFF9B781D, (int32_t)0x8000277A, (int32_t)0xA5368C4B, (int32_t)0xA5C4B855,
+    (int32_t)0xCEA768F2, (int32_t)0x89E4EDEF, (int32_t)0x8997FC8A, (int32_t)0xCF612AAA,
+    (int32_t)0xE6A4B616, (int32_t)0x8289644B, (int32_t)0x955AAE17, (int32_t)0xB936BFA4,
+    (int32_t)0xB88F926D, (int32_t)0x95CA6247, (int32_t)0x82622AA6, (int32_t)0xE769E8D8,
+    (int32_t)0xF310248A, (int32_t)0x80A7CB49, (int32_t)0x9CCE562C, (int32_t)0xAF1A0293,
+    (int32_t)0xC350AF25, (int32_t)0x8F4CBADB, (int32_t)0x8565F1B0, (int32_t)0xDB3832CD,
+    (int32_t)0xDA77CB63, (int32_t)0x85A04F28, (int32_t)0x8EEDF33B, (int32_t)0xC4020133,
+    (int32_t)0xAE7E965B, (int32_t)0x9D4DE384, (int32_t)0x8094162C, (int32_t)0xF3D83C77,
+    (int32_t)0xF953BF91, (int32_t)0x802C8EAD, (int32_t)0xA0E51D8D, (int32_t)0xAA54F2BA,
+    (int32_t)0xC8EB0FD6, (int32_t)0x8C753362, (int32_t)0x8759C2EF, (int32_t)0xD53F7FDA,
+    (int32_t)0xE0848B7F, (int32_t)0x83EE97AD, (int32_t)0x920265E4, (int32_t)0xBE88304F,
+    (int32_t)0xB36F784F, (int32_t)0x996C816F, (int32_t)0x815410D4, (int32_t)0xED9B66B2,
+    (int32_t)0xECD48407, (int32_t)0x8171914E, (int32_t)0x98F4BBBC, (int32_t)0xB410F6D3,
+    (int32_t)0xBDDBBB7F, (int32_t)0x9269C3AC, (int32_t)0x83BDBD0E, (int32_t)0xE14794BA,
+    (int32_t)0xD48230E9, (int32_t)0x879D7F41, (int32_t)0x8C1F3C5D, (int32_t)0xC9A0D1C5,
+    (int32_t)0xA9BFF8A8, (int32_t)0xA16C23E1, (int32_t)0x8022B114, (int32_t)0xFA1C9157,
+    (int32_t)0xFC775616, (int32_t)0x800C7D8C, (int32_t)0xA306A9C8, (int32_t)0xA8060D08,
+    (int32_t)0xCBC53579, (int32_t)0x8B240E11, (int32_t)0x886FA7C2, (int32_t)0xD24CCF39,
+    (int32_t)0xE3926FAD, (int32_t)0x83325E97, (int32_t)0x93A62F57, (int32_t)0xBBDA36DD,
+    (int32_t)0xB5F9D043, (int32_t)0x979364B5, (int32_t)0x81D16321, (int32_t)0xEA80FF7A,
+    (int32_t)0xEFF11753, (int32_t)0x8102E3C4, (int32_t)0x9AD9BC71, (int32_t)0xB18F7071,
+    (int32_t)0xC0915148, (int32_t)0x90D2ACD4, (int32_t)0x84885258, (int32_t)0xDE3D4964,
+    (int32_t)0xD779DE47, (int32_t)0x86958AAC, (int32_t)0x8D7DC399, (int32_t)0xC6CD0079,
+    (int32_t)0xAC18CF69, (int32_t)0x9F558FB0, (int32_t)0x80518B6B, (int32_t)0xF6F9B4C6,
+    (int32_t)0xF6313077, (int32_t)0x806055EB, (int32_t)0x9ED23BB9, (int32_t)0xACB10E4B,
+    (int32_t)0xC61968A2, (int32_t)0x8DD829E4, (int32_t)0x865678EB, (int32_t)0xD838C82D,
+    (int32_t)0xDD7B8220, (int32_t)0x84BDF286, (int32_t)0x906F927C, (int32_t)0xC1404233,
+    (int32_t)0xB0F0EEDA, (int32_t)0x9B556F81, (int32_t)0x80EA4712, (int32_t)0xF0B8A401,
+    (int32_t)0xE9BAE57D, (int32_t)0x81F3C2D7, (int32_t)0x971F9ED7, (int32_t)0xB69E32CD,
+    (int32_t)0xBB3058C0, (int32_t)0x9411C09E, (int32_t)0x83065110, (int32_t)0xE4569CCB,
+    (int32_t)0xD191386E, (int32_t)0x88B80432, (int32_t)0x8AD29394, (int32_t)0xCC7D0578,
+    (int32_t)0xA7746EC0, (int32_t)0xA3914DA8, (int32_t)0x80078E5E, (int32_t)0xFD40565C,
+    (int32_t)0xFE095D69, (int32_t)0x8003DAF1, (int32_t)0xA41CD599, (int32_t)0xA6E3AAF2,
+    (int32_t)0xCD355491, (int32_t)0x8A823A36, (int32_t)0x890186F2, (int32_t)0xD0D61434,
+    (int32_t)0xE51B0E2A, (int32_t)0x82DB77E5, (int32_t)0x947E5C33, (int32_t)0xBA87246C,
+    (int32_t)0xB7434A67, (int32_t)0x96ACDBBE, (int32_t)0x82175990, (int32_t)0xE8F50273,
+    (int32_t)0xF1805662, (int32_t)0x80D2E3F2, (int32_t)0x9BD21AF3, (int32_t)0xB0533055,
+    (int32_t)0xC1EFCDF3, (int32_t)0x900D8B69, (int32_t)0x84F4C2D4, (int32_t)0xDCBA1008,
+    (int32_t)0xD8F81439, (int32_t)0x86189359, (int32_t)0x8E33A9D9, (int32_t)0xC5665FA9,
+    (int32_t)0xAD4A1ABA, (int32_t)0x9E4FD78A, (int32_t)0x80705B50, (int32_t)0xF568C45B,
+    (int32_t)0xF7C24F59, (int32_t)0x8043FBF6, (int32_t)0x9FD9D22A, (int32_t)0xAB815F8D,
+    (int32_t)0xC7812572, (int32_t)0x8D2477D8, (int32_t)0x86D5C802, (int32_t)0xD6BB585E,
+    (int32_t)0xDEFF63F4, (int32_t)0x8453E2CF, (int32_t)0x9136D97D, (int32_t)0xBFE2FCDF,
+    (int32_t)0xB22EB392, (int32_t)0x9A5F02F5, (int32_t)0x811CB9CA, (int32_t)0xEF29B243,
+    (int32_t)0xEB474E80, (int32_t)0x81B03AC2, (int32_t)0x98082C3B, (int32_t)0xB556245E,
+    (int32_t)0xBC84BD1F, (int32_t)0x933BA968, (int32_t)0x835FA00F, (int32_t)0xE2CE88B3,
+    (int32_t)0xD308D6C7, (int32_t)0x88287256, (int32_t)0x8B76A8E4, (int32_t)0xCB0DE658,
+    (int32_t)0xA8988463, (int32_t)0xA27CEB4F, (int32_t)0x8012A86F, (int32_t)0xFBAE5E89,
+    (int32_t)0xFAE571A4, (int32_t)0x801A0EF8, (int32_t)0xA1F41392, (int32_t)0xA92BD367,
+    (int32_t)0xCA5719DB, (int32_t)0x8BCA6343, (int32_t)0x87E2649B, (int32_t)0xD3C54D47,
+    (int32_t)0xE20AE9C1, (int32_t)0x838E1507, (int32_t)0x92D22FD9, (int32_t)0xBD2FE9E2,
+    (int32_t)0xB4B330B3, (int32_t)0x987DF449, (int32_t)0x81904A0C, (int32_t)0xEC0DD0A8,
+    (int32_t)0xEE6276BF, (int32_t)0x8137C8E6, (int32_t)0x99E5443B, (int32_t)0xB2CEB6B5,
+    (int32_t)0xBF3546A8, (int32_t)0x919C1781, (int32_t)0x8420A46C, (int32_t)0xDFC1CFF2,
+    (int32_t)0xD5FD3848, (int32_t)0x8717304E, (int32_t)0x8CCC477D, (int32_t)0xC835D5D0,
+    (int32_t)0xAAEAC02C, (int32_t)0xA05F01E1, (int32_t)0x8037A7AD, (int32_t)0xF88AFE42,
+    (int32_t)0xF4A07261, (int32_t)0x80819B74, (int32_t)0x9DCE6463, (int32_t)0xADE3F33F,
+    (int32_t)0xC4B3E746, (int32_t)0x8E904298, (int32_t)0x85DBDA91, (int32_t)0xD9B7C094,
+    (int32_t)0xDBF8F4F8, (int32_t)0x852CC2BB, (int32_t)0x8FAC988F, (int32_t)0xC29FF2D4,
+    (int32_t)0xAFB63667, (int32_t)0x9C4FBD93, (int32_t)0x80BCBA9D, (int32_t)0xF2482C8A,
+    (int32_t)0xE82F5844, (int32_t)0x823C26F3, (int32_t)0x963B1C86, (int32_t)0xB7E9157A,
+    (int32_t)0xB9DE9B83, (int32_t)0x94EC010B, (int32_t)0x82B1D381, (int32_t)0xE5DFC1E5,
+    (int32_t)0xD01B6459, (int32_t)0x894C2F4C, (int32_t)0x8A3302BE, (int32_t)0xCDEE20FC,
+    (int32_t)0xA653C303, (int32_t)0xA4A94043, (int32_t)0x8001634E, (int32_t)0xFED2694F,
+    (int32_t)0xFED2694F, (int32_t)0x8001634E, (int32_t)0xA4A94043, (int32_t)0xA653C303,
+    (int32_t)0xCDEE20FC, (int32_t)0x8A3302BE, (int32_t)0x894C2F4C, (int32_t)0xD01B6459,
+    (int32_t)0xE5DFC1E5, (int32_t)0x82B1D381, (int32_t)0x94EC010B, (int32_t)0xB9DE9B83,
+    (int32_t)0xB7E9157A, (int32_t)0x963B1C86, (int32_t)0x823C26F3, (int32_t)0xE82F5844,
+    (int32_t)0xF2482C8A, (int32_t)0x80BCBA9D, (int32_t)0x9C4FBD93, (int32_t)0xAFB63667,
+    (int32_t)0xC29FF2D4, (int32_t)0x8FAC988F, (int32_t)0x852CC2BB, (int32_t)0xDBF8F4F8,
+    (int32_t)0xD9B7C094, (int32_t)0x85DBDA91, (int32_t)0x8E904298, (int32_t)0xC4B3E746,
+    (int32_t)0xADE3F33F, (int32_t)0x9DCE6463, (int32_t)0x80819B74, (int32_t)0xF4A07261,
+    (int32_t)0xF88AFE42, (int32_t)0x8037A7AD, (int32_t)0xA05F01E1, (int32_t)0xAAEAC02C,
+    (int32_t)0xC835D5D0, (int32_t)0x8CCC477D, (int32_t)0x8717304E, (int32_t)0xD5FD3848,
+    (int32_t)0xDFC1CFF2, (int32_t)0x8420A46C, (int32_t)0x919C1781, (int32_t)0xBF3546A8,
+    (int32_t)0xB2CEB6B5, (int32_t)0x99E5443B, (int32_t)0x8137C8E6, (int32_t)0xEE6276BF,
+    (int32_t)0xEC0DD0A8, (int32_t)0x81904A0C, (int32_t)0x987DF449, (int32_t)0xB4B330B3,
+    (int32_t)0xBD2FE9E2, (int32_t)0x92D22FD9, (int32_t)0x838E1507, (int32_t)0xE20AE9C1,
+    (int32_t)0xD3C54D47, (int32_t)0x87E2649B, (int32_t)0x8BCA6343, (int32_t)0xCA5719DB,
+    (int32_t)0xA92BD367, (int32_t)0xA1F41392, (int32_t)0x801A0EF8, (int32_t)0xFAE571A4,
+    (int32_t)0xFBAE5E89, (int32_t)0x8012A86F, (int32_t)0xA27CEB4F, (int32_t)0xA8988463,
+    (int32_t)0xCB0DE658, (int32_t)0x8B76A8E4, (int32_t)0x88287256, (int32_t)0xD308D6C7,
+    (int32_t)0xE2CE88B3, (int32_t)0x835FA00F, (int32_t)0x933BA968, (int32_t)0xBC84BD1F,
+    (int32_t)0xB556245E, (int32_t)0x98082C3B, (int32_t)0x81B03AC2, (int32_t)0xEB474E80,
+    (int32_t)0xEF29B243, (int32_t)0x811CB9CA, (int32_t)0x9A5F02F5, (int32_t)0xB22EB392,
+    (int32_t)0xBFE2FCDF, (int32_t)0x9136D97D, (int32_t)0x8453E2CF, (int32_t)0xDEFF63F4,
+    (int32_t)0xD6BB585E, (int32_t)0x86D5C802, (int32_t)0x8D2477D8, (int32_t)0xC7812572,
+    (int32_t)0xAB815F8D, (int32_t)0x9FD9D22A, (int32_t)0x8043FBF6, (int32_t)0xF7C24F59,
+    (int32_t)0xF568C45B, (int32_t)0x80705B50, (int32_t)0x9E4FD78A, (int32_t)0xAD4A1ABA,
+    (int32_t)0xC5665FA9, (int32_t)0x8E33A9D9, (int32_t)0x86189359, (int32_t)0xD8F81439,
+    (int32_t)0xDCBA1008, (int32_t)0x84F4C2D4, (int32_t)0x900D8B69, (int32_t)0xC1EFCDF3,
+    (int32_t)0xB0533055, (int32_t)0x9BD21AF3, (int32_t)0x80D2E3F2, (int32_t)0xF1805662,
+    (int32_t)0xE8F50273, (int32_t)0x82175990, (int32_t)0x96ACDBBE, (int32_t)0xB7434A67,
+    (int32_t)0xBA87246C, (int32_t)0x947E5C33, (int32_t)0x82DB77E5, (int32_t)0xE51B0E2A,
+    (int32_t)0xD0D61434, (int32_t)0x890186F2, (int32_t)0x8A823A36, (int32_t)0xCD355491,
+    (int32_t)0xA6E3AAF2, (int32_t)0xA41CD599, (int32_t)0x8003DAF1, (int32_t)0xFE095D69,
+    (int32_t)0xFD40565C, (int32_t)0x80078E5E, (int32_t)0xA3914DA8, (int32_t)0xA7746EC0,
+    (int32_t)0xCC7D0578, (int32_t)0x8AD29394, (int32_t)0x88B80432, (int32_t)0xD191386E,
+    (int32_t)0xE4569CCB, (int32_t)0x83065110, (int32_t)0x9411C09E, (int32_t)0xBB3058C0,
+    (int32_t)0xB69E32CD, (int32_t)0x971F9ED7, (int32_t)0x81F3C2D7, (int32_t)0xE9BAE57D,
+    (int32_t)0xF0B8A401, (int32_t)0x80EA4712, (int32_t)0x9B556F81, (int32_t)0xB0F0EEDA,
+    (int32_t)0xC1404233, (int32_t)0x906F927C, (int32_t)0x84BDF286, (int32_t)0xDD7B8220,
+    (int32_t)0xD838C82D, (int32_t)0x865678EB, (int32_t)0x8DD829E4, (int32_t)0xC61968A2,
+    (int32_t)0xACB10E4B, (int32_t)0x9ED23BB9, (int32_t)0x806055EB, (int32_t)0xF6313077,
+    (int32_t)0xF6F9B4C6, (int32_t)0x80518B6B, (int32_t)0x9F558FB0, (int32_t)0xAC18CF69,
+    (int32_t)0xC6CD0079, (int32_t)0x8D7DC399, (int32_t)0x86958AAC, (int32_t)0xD779DE47,
+    (int32_t)0xDE3D4964, (int32_t)0x84885258, (int32_t)0x90D2ACD4, (int32_t)0xC0915148,
+    (int32_t)0xB18F7071, (int32_t)0x9AD9BC71, (int32_t)0x8102E3C4, (int32_t)0xEFF11753,
+    (int32_t)0xEA80FF7A, (int32_t)0x81D16321, (int32_t)0x979364B5, (int32_t)0xB5F9D043,
+    (int32_t)0xBBDA36DD, (int32_t)0x93A62F57, (int32_t)0x83325E97, (int32_t)0xE3926FAD,
+    (int32_t)0xD24CCF39, (int32_t)0x886FA7C2, (int32_t)0x8B240E11, (int32_t)0xCBC53579,
+    (int32_t)0xA8060D08, (int32_t)0xA306A9C8, (int32_t)0x800C7D8C, (int32_t)0xFC775616,
+    (int32_t)0xFA1C9157, (int32_t)0x8022B114, (int32_t)0xA16C23E1, (int32_t)0xA9BFF8A8,
+    (int32_t)0xC9A0D1C5, (int32_t)0x8C1F3C5D, (int32_t)0x879D7F41, (int32_t)0xD48230E9,
+    (int32_t)0xE14794BA, (int32_t)0x83BDBD0E, (int32_t)0x9269C3AC, (int32_t)0xBDDBBB7F,
+    (int32_t)0xB410F6D3, (int32_t)0x98F4BBBC, (int32_t)0x8171914E, (int32_t)0xECD48407,
+    (int32_t)0xED9B66B2, (int32_t)0x815410D4, (int32_t)0x996C816F, (int32_t)0xB36F784F,
+    (int32_t)0xBE88304F, (int32_t)0x920265E4, (int32_t)0x83EE97AD, (int32_t)0xE0848B7F,
+    (int32_t)0xD53F7FDA, (int32_t)0x8759C2EF, (int32_t)0x8C753362, (int32_t)0xC8EB0FD6,
+    (int32_t)0xAA54F2BA, (int32_t)0xA0E51D8D, (int32_t)0x802C8EAD, (int32_t)0xF953BF91,
+    (int32_t)0xF3D83C77, (int32_t)0x8094162C, (int32_t)0x9D4DE384, (int32_t)0xAE7E965B,
+    (int32_t)0xC4020133, (int32_t)0x8EEDF33B, (int32_t)0x85A04F28, (int32_t)0xDA77CB63,
+    (int32_t)0xDB3832CD, (int32_t)0x8565F1B0, (int32_t)0x8F4CBADB, (int32_t)0xC350AF25,
+    (int32_t)0xAF1A0293, (int32_t)0x9CCE562C, (int32_t)0x80A7CB49, (int32_t)0xF310248A,
+    (int32_t)0xE769E8D8, (int32_t)0x82622AA6, (int32_t)0x95CA6247, (int32_t)0xB88F926D,
+    (int32_t)0xB936BFA4, (int32_t)0x955AAE17, (int32_t)0x8289644B, (int32_t)0xE6A4B616,
+    (int32_t)0xCF612AAA, (int32_t)0x8997FC8A, (int32_t)0x89E4EDEF, (int32_t)0xCEA768F2,
+    (int32_t)0xA5C4B855, (int32_t)0xA5368C4B, (int32_t)0x8000277A, (int32_t)0xFF9B781D
+};
+
+/** i bit reversed in 11 bits; shift right for smaller sizes */
+const uint16_t math_host_bitreverse_2048[2048] =
+{
+       0, 1024,  512, 1536,  256, 1280,  768, 1792,  128, 1152,  640, 1664,
+     384, 1408,  896, 1920,   64, 1088,  576, 1600,  320, 1344,  832, 1856,
+     192, 1216,  704, 1728,  448, 1472,  960, 1984,   32, 1056,  544, 1568,
+     288, 1312,  800, 1824,  160, 1184,  672, 1696,  416, 1440,  928, 1952,
+      96, 1120,  608, 1632,  352, 1376,  864, 1888,  224, 1248,  736, 1760,
+     480, 1504,  992, 2016,   16, 1040,  528, 1552,  272, 1296,  784, 1808,
+     144, 1168,  656, 1680,  400, 1424,  912, 1936,   80, 1104,  592, 1616,
+     336, 1360,  848, 1872,  208, 1232,  720, 1744,  464, 1488,  976, 2000,
+      48, 1072,  560, 1584,  304, 1328,  816, 1840,  176, 1200,  688, 1712,
+     432, 1456,  944, 1968,  112, 1136,  624, 1648,  368, 1392,  880, 1904,
+     240, 1264,  752, 1776,  496, 1520, 1008, 2032,    8, 1032,  520, 1544,
+     264, 1288,  776, 1800,  136, 1160,  648, 1672,  392, 1416,  904, 1928,
+      72, 1096,  584, 1608,  328, 1352,  840, 1864,  200, 1224,  712, 1736,
+     456, 1480,  968, 1992,   40, 1064,  552, 1576,  296, 1320,  808, 1832,
+     168, 1192,  680, 1704,  424, 1448,  936, 1960,  104, 1128,  616, 1640,
+     360, 1384,  872, 1896,  232, 1256,  744, 1768,  488, 1512, 1000, 2024,
+      24, 1048,  536, 1560,  280, 1304,  792, 1816,  152, 1176,  664, 1688,
+     408, 1432,  920, 1944,   88, 1112,  600, 1624,  344, 1368,  856, 1880,
+     216, 1240,  728, 1752,  472, 1496,  984, 2008,   56, 1080,  568, 1592,
+     312, 1336,  824, 1848,  184, 1208,  696, 1720,  440, 1464,  952, 1976,
+     120, 1144,  632, 1656,  376, 1400,  888, 1912,  248, 1272,  760, 1784,
+     504, 1528, 1016, 2040,    4, 1028,  516, 1540,  260, 1284,  772, 1796,
+     132, 1156,  644, 1668,  388, 1412,  900, 1924,   68, 1092,  580, 1604,
+     324, 1348,  836, 1860,  196, 1220,  708, 1732,  452, 1476,  964, 1988,
+      36, 1060,  548, 1572,  292, 1316,  804, 1828,  164, 1188,  676, 1700,
+     420, 1444,  932, 1956,  100, 1124,  612, 1636,  356, 1380,  868, 1892,
+     228, 1252,  740, 1764,  484, 1508,  996, 2020,   20, 1044,  532, 1556,
+     276, 1300,  788, 1812,  148, 1172,  660, 1684,  404, 1428,  916, 1940,
+      84, 1108,  596, 1620,  340, 1364,  852, 1876,  212, 1236,  724, 1748,
+     468, 1492,  980, 2004,   52, 1076,  564, 1588,  308, 1332,  820, 1844,
+     180, 1204,  692, 1716,  436, 1460,  948, 1972,  116, 1140,  628, 1652,
+     372, 1396,  884, 1908,  244, 1268,  756, 1780,  500, 1524, 1012, 2036,
+      12, 1036,  524, 1548,  268, 1292,  780, 1804,  140, 1164,  652, 1676,
+     396, 1420,  908, 1932,   76, 1100,  588, 1612,  332, 1356,  844, 1868,
+     204, 1228,  716, 1740,  460, 1484,  972, 1996,   44, 1068,  556, 1580,
+     300, 1324,  812, 1836,  172, 1196,  684, 1708,  428, 1452,  940, 1964,
+     108, 1132,  620, 1644,  364, 1388,  876, 1900,  236, 1260,  748, 1772,
+     492, 1516, 1004, 2028,   28, 1052,  540, 1564,  284, 1308,  796, 1820,
+     156, 1180,  668, 1692,  412, 1436,  924, 1948,   92, 1116,  604, 1628,
+     348, 1372,  860, 1884,  220, 1244,  732, 1756,  476, 1500,  988, 2012,
+      60, 1084,  572, 1596,  316, 1340,  828, 1852,  188, 1212,  700, 1724,
+     444, 1468,  956, 1980,  124, 1148,  636, 1660,  380, 1404,  892, 1916,
+     252, 1276,  764, 1788,  508, 1532, 1020, 2044,    2, 1026,  514, 1538,
+     258, 1282,  770, 1794,  130, 1154,  642, 1666,  386, 1410,  898, 1922,
+      66, 1090,  578, 1602,  322, 1346,  834, 1858,  194, 1218,  706, 1730,
+     450, 1474,  962, 1986,   34, 1058,  546, 1570,  290, 1314,  802, 1826,
+     162, 1186,  674, 1698,  418, 1442,  930, 1954,   98, 1122,  610, 1634,
+     354, 1378,  866, 1890,  226, 1250,  738, 1762,  482, 1506,  994, 2018,
+      18, 1042,  530, 1554,  274, 1298,  786, 1810,  146, 1170,  658, 1682,
+     402, 1426,  914, 1938,   82, 1106,  594, 1618,  338, 1362,  850, 1874,
+     210, 1234,  722, 1746,  466, 1490,  978, 2002,   50, 1074,  562, 1586,
+     306, 1330,  818, 1842,  178, 1202,  690, 1714,  434, 1458,  946, 1970,
+     114, 1138,  626, 1650,  370, 1394,  882, 1906,  242, 1266,  754, 1778,
+     498, 1522, 1010, 2034,   10, 1034,  522, 1546,  266, 1290,  778, 1802,
+     138, 1162,  650, 1674,  394, 1418,  906, 1930,   74, 1098,  586, 1610,
+     330, 1354,  842, 1866,  202, 1226,  714, 1738,  458, 1482,  970, 1994,
+      42, 1066,  554, 1578,  298, 1322,  810, 1834,  170, 1194,  682, 1706,
+     426, 1450,  938, 1962,  106, 1130,  618, 1642,  362, 1386,  874, 1898,
+     234, 1258,  746, 1770,  490, 1514, 1002, 2026,   26, 1050,  538, 1562,
+     282, 1306,  794, 1818,  154, 1178,  666, 1690,  410, 1434,  922, 1946,
+      90, 1114,  602, 1626,  346, 1370,  858, 1882,  218, 1242,  730, 1754,
+     474, 1498,  986, 2010,   58, 1082,  570, 1594,  314, 1338,  826, 1850,
+     186, 1210,  698, 1722,  442, 1466,  954, 1978,  122, 1146,  634, 1658,
+     378, 1402,  890, 1914,  250, 1274,  762, 1786,  506, 1530, 1018, 2042,
+       6, 1030,  518, 1542,  262, 1286,  774, 1798,  134, 1158,  646, 1670,
+     390, 1414,  902, 1926,   70, 1094,  582, 1606,  326, 1350,  838, 1862,
+     198, 1222,  710, 1734,  454, 1478,  966, 1990,   38, 1062,  550, 1574,
+     294, 1318,  806, 1830,  166, 1190,  678, 1702,  422, 1446,  934, 1958,
+     102, 1126,  614, 1638,  358, 1382,  870, 1894,  230, 1254,  742, 1766,
+     486, 1510,  998, 2022,   22, 1046,  534, 1558,  278, 1302,  790, 1814,
+     150, 1174,  662, 1686,  406, 1430,  918, 1942,   86, 1110,  598, 1622,
+     342, 1366,  854, 1878,  214, 1238,  726, 1750,  470, 1494,  982, 2006,
+      54, 1078,  566, 1590,  310, 1334,  822, 1846,  182, 1206,  694, 1718,
+     438, 1462,  950, 1974,  118, 1142,  630, 1654,  374, 1398,  886, 1910,
+     246, 1270,  758, 1782,  502, 1526, 1014, 2038,   14, 1038,  526, 1550,
+     270, 1294,  782, 1806,  142, 1166,  654, 1678,  398, 1422,  910, 1934,
+      78, 1102,  590, 1614,  334, 1358,  846, 1870,  206, 1230,  718, 1742,
+     462, 1486,  974, 1998,   46, 1070,  558, 1582,  302, 1326,  814, 1838,
+     174, 1198,  686, 1710,  430, 1454,  942, 1966,  110, 1134,  622, 1646,
+     366, 1390,  878, 1902,  238, 1262,  750, 1774,  494, 1518, 1006, 2030,
+      30, 1054,  542, 1566,  286, 1310,  798, 1822,  158, 1182,  670, 1694,
+     414, 1438,  926, 1950,   94, 1118,  606, 1630,  350, 1374,  862, 1886,
+     222, 1246,  734, 1758,  478, 1502,  990, 2014,   62, 1086,  574, 1598,
+     318, 1342,  830, 1854,  190, 1214,  702, 1726,  446, 1470,  958, 1982,
+     126, 1150,  638, 1662,  382, 1406,  894, 1918,  254, 1278,  766, 1790,
+     510, 1534, 1022, 2046,    1, 1025,  513, 1537,  257, 1281,  769, 1793,
+     129, 1153,  641, 1665,  385, 1409,  897, 1921,   65, 1089,  577, 1601,
+     321, 1345,  833, 1857,  193, 1217,  705, 1729,  449, 1473,  961, 1985,
+      33, 1057,  545, 1569,  289, 1313,  801, 1825,  161, 1185,  673, 1697,
+     417, 1441,  929, 1953,   97, 1121,  609, 1633,  353, 1377,  865, 1889,
+     225, 1249,  737, 1761,  481, 1505,  993, 2017,   17, 1041,  529, 1553,
+     273, 1297,  785, 1809,  145, 1169,  657, 1681,  401, 1425,  913, 1937,
+      81, 1105,  593, 1617,  337, 1361,  849, 1873,  209, 1233,  721, 1745,
+     465, 1489,  977, 2001,   49, 1073,  561, 1585,  305, 1329,  817, 1841,
+     177, 1201,  689, 1713,  433, 1457,  945, 1969,  113, 1137,  625, 1649,
+     369, 1393,  881, 1905,  241, 1265,  753, 1777,  497, 1521, 1009, 2033,
+       9, 1033,  521, 1545,  265, 1289,  777, 1801,  137, 1161,  649, 1673,
+     393, 1417,  905, 1929,   73, 1097,  585, 1609,  329, 1353,  841, 1865,
+     201, 1225,  713, 1737,  457, 1481,  969, 1993,   41, 1065,  553, 1577,
+     297, 1321,  809, 1833,  169, 1193,  681, 1705,  425, 1449,  937, 1961,
+     105, 1129,  617, 1641,  361, 1385,  873, 1897,  233, 1257,  745, 1769,
+     489, 1513, 1001, 2025,   25, 1049,  537, 1561,  281, 1305,  793, 1817,
+     153, 1177,  665, 1689,  409, 1433,  921, 1945,   89, 1113,  601, 1625,
+     345, 1369,  857, 1881,  217, 1241,  729, 1753,  473, 1497,  985, 2009,
+      57, 1081,  569, 1593,  313, 1337,  825, 1849,  185, 1209,  697, 1721,
+     441, 1465,  953, 1977,  121, 1145,  633, 1657,  377, 1401,  889, 1913,
+     249, 1273,  761, 1785,  505, 1529, 1017, 2041,    5, 1029,  517, 1541,
+     261, 1285,  773, 1797,  133, 1157,  645, 1669,  389, 1413,  901, 1925,
+      69, 1093,  581, 1605,  325, 1349,  837, 1861,  197, 1221,  709, 1733,
+     453, 1477,  965, 1989,   37, 1061,  549, 1573,  293, 1317,  805, 1829,
+     165, 1189,  677, 1701,  421, 1445,  933, 1957,  101, 1125,  613, 1637,
+     357, 1381,  869, 1893,  229, 1253,  741, 1765,  485, 1509,  997, 2021,
+      21, 1045,  533, 1557,  277, 1301,  789, 1813,  149, 1173,  661, 1685,
+     405, 1429,  917, 1941,   85, 1109,  597, 1621,  341, 1365,  853, 1877,
+     213, 1237,  725, 1749,  469, 1493,  981, 2005,   53, 1077,  565, 1589,
+     309, 1333,  821, 1845,  181, 1205,  693, 1717,  437, 1461,  949, 1973,
+     117, 1141,  629, 1653,  373, 1397,  885, 1909,  245, 1269,  757, 1781,
+     501, 1525, 1013, 2037,   13, 1037,  525, 1549,  269, 1293,  781, 1805,
+     141, 1165,  653, 1677,  397, 1421,  909, 1933,   77, 1101,  589, 1613,
+     333, 1357,  845, 1869,  205, 1229,  717, 1741,  461, 1485,  973, 1997,
+      45, 1069,  557, 1581,  301, 1325,  813, 1837,  173, 1197,  685, 1709,
+     429, 1453,  941, 1965,  109, 1133,  621, 1645,  365, 1389,  877, 1901,
+     237, 1261,  749, 1773,  493, 1517, 1005, 2029,   29, 1053,  541, 1565,
+     285, 1309,  797, 1821,  157, 1181,  669, 1693,  413, 1437,  925, 1949,
+      93, 1117,  605, 1629,  349, 1373,  861, 1885,  221, 1245,  733, 1757,
+     477, 1501,  989, 2013,   61, 1085,  573, 1597,  317, 1341,  829, 1853,
+     189, 1213,  701, 1725,  445, 1469,  957, 1981,  125, 1149,  637, 1661,
+     381, 1405,  893, 1917,  253, 1277,  765, 1789,  509, 1533, 1021, 2045,
+       3, 1027,  515, 1539,  259, 1283,  771, 1795,  131, 1155,  643, 1667,
+     387, 1411,  899, 1923,   67, 1091,  579, 1603,  323, 1347,  835, 1859,
+     195, 1219,  707, 1731,  451, 1475,  963, 1987,   35, 1059,  547, 1571,
+     291, 1315,  803, 1827,  163, 1187,  675, 1699,  419, 1443,  931, 1955,
+      99, 1123,  611, 1635,  355, 1379,  867, 1891,  227, 1251,  739, 1763,
+     483, 1507,  995, 2019,   19, 1043,  531, 1555,  275, 1299,  787, 1811,
+     147, 1171,  659, 1683,  403, 1427,  915, 1939,   83, 1107,  595, 1619,
+     339, 1363,  851, 1875,  211, 1235,  723, 1747,  467, 1491,  979, 2003,
+      51, 1075,  563, 1587,  307, 1331,  819, 1843,  179, 1203,  691, 1715,
+     435, 1459,  947, 1971,  115, 1139,  627, 1651,  371, 1395,  883, 1907,
+     243, 1267,  755, 1779,  499, 1523, 1011, 2035,   11, 1035,  523, 1547,
+     267, 1291,  779, 1803,  139, 1163,  651, 1675,  395, 1419,  907, 1931,
+      75, 1099,  587, 1611,  331, 1355,  843, 1867,  203, 1227,  715, 1739,
+     459, 1483,  971, 1995,   43, 1067,  555, 1579,  299, 1323,  811, 1835,
+     171, 1195,  683, 1707,  427, 1451,  939, 1963,  107, 1131,  619, 1643,
+     363, 1387,  875, 1899,  235, 1259,  747, 1771,  491, 1515, 1003, 2027,
+      27, 1051,  539, 1563,  283, 1307,  795, 1819,  155, 1179,  667, 1691,
+     411, 1435,  923, 1947,   91, 1115,  603, 1627,  347, 1371,  859, 1883,
+     219, 1243,  731, 1755,  475, 1499,  987, 2011,   59, 1083,  571, 1595,
+     315, 1339,  827, 1851,  187, 1211,  699, 1723,  443, 1467,  955, 1979,
+     123, 1147,  635, 1659,  379, 1403,  891, 1915,  251, 1275,  763, 1787,
+     507, 1531, 1019, 2043,    7, 1031,  519, 1543,  263, 1287,  775, 1799,
+     135, 1159,  647, 1671,  391, 1415,  903, 1927,   71, 1095,  583, 1607,
+     327, 1351,  839, 1863,  199, 1223,  711, 1735,  455, 1479,  967, 1991,
+      39, 1063,  551, 1575,  295, 1319,  807, 1831,  167, 1191,  679, 1703,
+     423, 1447,  935, 1959,  103, 1127,  615, 1639,  359, 1383,  871, 1895,
+     231, 1255,  743, 1767,  487, 1511,  999, 2023,   23, 1047,  535, 1559,
+     279, 1303,  791, 1815,  151, 1175,  663, 1687,  407, 1431,  919, 1943,
+      87, 1111,  599, 1623,  343, 1367,  855, 1879,  215, 1239,  727, 1751,
+     471, 1495,  983, 2007,   55, 1079,  567, 1591,  311, 1335,  823, 1847,
+     183, 1207,  695, 1719,  439, 1463,  951, 1975,  119, 1143,  631, 1655,
+     375, 1399,  887, 1911,  247, 1271,  759, 1783,  503, 1527, 1015, 2039,
+      15, 1039,  527, 1551,  271, 1295,  783, 1807,  143, 1167,  655, 1679,
+     399, 1423,  911, 1935,   79, 1103,  591, 1615,  335, 1359,  847, 1871,
+     207, 1231,  719, 1743,  463, 1487,  975, 1999,   47, 1071,  559, 1583,
+     303, 1327,  815, 1839,  175, 1199,  687, 1711,  431, 1455,  943, 1967,
+     111, 1135,  623, 1647,  367, 1391,  879, 1903,  239, 1263,  751, 1775,
+     495, 1519, 1007, 2031,   31, 1055,  543, 1567,  287, 1311,  799, 1823,
+     159, 1183,  671, 1695,  415, 1439,  927, 1951,   95, 1119,  607, 1631,
+     351, 1375,  863, 1887,  223, 1247,  735, 1759,  479, 1503,  991, 2015,
+      63, 1087,  575, 1599,  319, 1343,  831, 1855,  191, 1215,  703, 1727,
+     447, 1471,  959, 1983,  127, 1151,  639, 1663,  383, 1407,  895, 1919,
+     255, 1279,  767, 1791,  511, 1535, 1023, 2047
+};
+
+/** Chebyshev coefficients of sqrt(t), t from 0.25 to 1, on each of 24 segments of width 2^-5 */
+const int32_t math_host_sqrt_chebyshev[24 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x41F495DB, (int32_t)0x01F0DFD2, (int32_t)0xFFFC5800, (int32_t)0x00000DC7, (int32_t)0xFFFFFFBF,
+    (int32_t)0x45BAF4FD, (int32_t)0x01D5F72F, (int32_t)0xFFFCE800, (int32_t)0x00000A6E, (int32_t)0xFFFFFFD4,
+    (int32_t)0x494F9186, (int32_t)0x01BF015D, (int32_t)0xFFFD5683, (int32_t)0x0000081E, (int32_t)0xFFFFFFE1,
+    (int32_t)0x4CB9676F, (int32_t)0x01AB1CFE, (int32_t)0xFFFDAD82, (int32_t)0x00000677, (int32_t)0xFFFFFFEA,
+    (int32_t)0x4FFDF384, (int32_t)0x0199A956, (int32_t)0xFFFDF373, (int32_t)0x0000053F, (int32_t)0xFFFFFFEF,
+    (int32_t)0x53219D72, (int32_t)0x018A3041, (int32_t)0xFFFE2CAC, (int32_t)0x00000454, (int32_t)0xFFFFFFF3,
+    (int32_t)0x5627FECF, (int32_t)0x017C58B2, (int32_t)0xFFFE5C33, (int32_t)0x0000039F, (int32_t)0xFFFFFFF6,
+    (int32_t)0x5914144B, (int32_t)0x016FDE18, (int32_t)0xFFFE842E, (int32_t)0x00000310, (int32_t)0xFFFFFFF8,
+    (int32_t)0x5BE860BD, (int32_t)0x01648AB0, (int32_t)0xFFFEA631, (int32_t)0x0000029F, (int32_t)0xFFFFFFFA,
+    (int32_t)0x5EA706B6, (int32_t)0x015A33A2, (int32_t)0xFFFEC36B, (int32_t)0x00000243, (int32_t)0xFFFFFFFB,
+    (int32_t)0x6151DB90, (int32_t)0x0150B652, (int32_t)0xFFFEDCBE, (int32_t)0x000001F8, (int32_t)0xFFFFFFFC,
+    (int32_t)0x63EA75E6, (int32_t)0x0147F672, (int32_t)0xFFFEF2DD, (int32_t)0x000001BA, (int32_t)0xFFFFFFFC,
+    (int32_t)0x667238BB, (int32_t)0x013FDC99, (int32_t)0xFFFF0652, (int32_t)0x00000186, (int32_t)0xFFFFFFFD,
+    (int32_t)0x68EA5C35, (int32_t)0x0138553A, (int32_t)0xFFFF178A, (int32_t)0x0000015A, (int32_t)0xFFFFFFFD,
+    (int32_t)0x6B53F485, (int32_t)0x01314FDC, (int32_t)0xFFFF26DE, (int32_t)0x00000135, (int32_t)0xFFFFFFFE,
+    (int32_t)0x6DAFF777, (int32_t)0x012ABE83, (int32_t)0xFFFF3494, (int32_t)0x00000115, (int32_t)0xFFFFFFFE,
+    (int32_t)0x6FFF40EA, (int32_t)0x01249536, (int32_t)0xFFFF40E8, (int32_t)0x000000FA, (int32_t)0xFFFFFFFE,
+    (int32_t)0x72429680, (int32_t)0x011EC9A7, (int32_t)0xFFFF4C0A, (int32_t)0x000000E2, (int32_t)0xFFFFFFFF,
+    (int32_t)0x747AAAA5, (int32_t)0x011952E6, (int32_t)0xFFFF5622, (int32_t)0x000000CD, (int32_t)0xFFFFFFFF,
+    (int32_t)0x76A81F10, (int32_t)0x0114292C, (int32_t)0xFFFF5F50, (int32_t)0x000000BB, (int32_t)0xFFFFFFFF,
+    (int32_t)0x78CB86E5, (int32_t)0x010F45A5, (int32_t)0xFFFF67B2, (int32_t)0x000000AB, (int32_t)0xFFFFFFFF,
+    (int32_t)0x7AE56876, (int32_t)0x010AA252, (int32_t)0xFFFF6F60, (int32_t)0x0000009D, (int32_t)0xFFFFFFFF,
+    (int32_t)0x7CF63ECC, (int32_t)0x010639E4, (int32_t)0xFFFF766E, (int32_t)0x00000090, (int32_t)0xFFFFFFFF,
+    (int32_t)0x7EFE7AEA, (int32_t)0x010207A4, (int32_t)0xFFFF7CEE, (int32_t)0x00000085, (int32_t)0xFFFFFFFF
+};
+
+/** Chebyshev coefficients of log2(t) + 1, t from 0.5 to 1, on each of 16 segments of width 2^-5 */
+const int32_t math_host_log2_chebyshev[16 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x05A3D9A0, (int32_t)0x0598E1A9, (int32_t)0xFFF52471, (int32_t)0x00001C15, (int32_t)0xFFFFFFAE,
+    (int32_t)0x1082B1F5, (int32_t)0x0546F7D4, (int32_t)0xFFF65927, (int32_t)0x00001789, (int32_t)0xFFFFFFBF,
+    (int32_t)0x1AC6BB87, (int32_t)0x04FDEA53, (int32_t)0xFFF75D26, (int32_t)0x000013EC, (int32_t)0xFFFFFFCC,
+    (int32_t)0x248049A9, (int32_t)0x04BC5BEC, (int32_t)0xFFF83A29, (int32_t)0x00001103, (int32_t)0xFFFFFFD6,
+    (int32_t)0x2DBD3B5A, (int32_t)0x04813399, (int32_t)0xFFF8F79D, (int32_t)0x00000EA4, (int32_t)0xFFFFFFDE,
+    (int32_t)0x36897348, (int32_t)0x044B8CA6, (int32_t)0xFFF99B3D, (int32_t)0x00000CB1, (int32_t)0xFFFFFFE4,
+    (int32_t)0x3EEF3471, (int32_t)0x041AAB0F, (int32_t)0xFFFA2988, (int32_t)0x00000B12, (int32_t)0xFFFFFFE8,
+    (int32_t)0x46F76A99, (int32_t)0x03EDF2D5, (int32_t)0xFFFAA60B, (int32_t)0x000009B8, (int32_t)0xFFFFFFEC,
+    (int32_t)0x4EA9E399, (int32_t)0x03C4E176, (int32_t)0xFFFB139E, (int32_t)0x00000893, (int32_t)0xFFFFFFEF,
+    (int32_t)0x560D7D36, (int32_t)0x039F08EA, (int32_t)0xFFFB748D, (int32_t)0x0000079B, (int32_t)0xFFFFFFF2,
+    (int32_t)0x5D284A1D, (int32_t)0x037C0BC8, (int32_t)0xFFFBCAB7, (int32_t)0x000006C7, (int32_t)0xFFFFFFF4,
+    (int32_t)0x63FFB00A, (int32_t)0x035B9A3F, (int32_t)0xFFFC17A7, (int32_t)0x00000610, (int32_t)0xFFFFFFF5,
+    (int32_t)0x6A988081, (int32_t)0x033D6FB2, (int32_t)0xFFFC5CA2, (int32_t)0x00000572, (int32_t)0xFFFFFFF7,
+    (int32_t)0x70F70D4A, (int32_t)0x032150D2, (int32_t)0xFFFC9AB7, (int32_t)0x000004E9, (int32_t)0xFFFFFFF8,
+    (int32_t)0x771F397E, (int32_t)0x03070A1B, (int32_t)0xFFFCD2CA, (int32_t)0x00000472, (int32_t)0xFFFFFFF9,
+    (int32_t)0x7D1487D1, (int32_t)0x02EE6E90, (int32_t)0xFFFD059C, (int32_t)0x00000409, (int32_t)0xFFFFFFFA
+};
+
+/** Chebyshev coefficients of 2^(t - 1), t from 0 to 1, on each of 8 segments of width 2^-3 */
+const int32_t math_host_pow2_chebyshev[8 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x42DD6902, (int32_t)0x02E561A2, (int32_t)0x00080763, (int32_t)0x00000ED7, (int32_t)0x00000015,
+    (int32_t)0x48EAAB0D, (int32_t)0x03287B6C, (int32_t)0x0008C16A, (int32_t)0x0000102F, (int32_t)0x00000016,
+    (int32_t)0x4F84255F, (int32_t)0x0371A7F0, (int32_t)0x00098C47, (int32_t)0x000011A6, (int32_t)0x00000018,
+    (int32_t)0x56B688DC, (int32_t)0x03C173E4, (int32_t)0x000A6981, (int32_t)0x0000133F, (int32_t)0x0000001B,
+    (int32_t)0x5E8FAC73, (int32_t)0x041878BB, (int32_t)0x000B5AC1, (int32_t)0x000014FD, (int32_t)0x0000001D,
+    (int32_t)0x671EA7C1, (int32_t)0x04775DCB, (int32_t)0x000C61D6, (int32_t)0x000016E3, (int32_t)0x00000020,
+    (int32_t)0x7073F00F, (int32_t)0x04DED992, (int32_t)0x000D80BB, (int32_t)0x000018F5, (int32_t)0x00000023,
+    (int32_t)0x7AA177FD, (int32_t)0x054FB30E, (int32_t)0x000EB998, (int32_t)0x00001B37, (int32_t)0x00000026
+};
+
+/** Chebyshev coefficients of sin(t * pi / 2), t from 0 to 1, on each of 16 segments of width 2^-4 */
+const int32_t math_host_sin_chebyshev[16 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x0646E192, (int32_t)0x064612F8, (int32_t)0xFFFF0819, (int32_t)0xFFFFD6B7, (int32_t)0x00000003,
+    (int32_t)0x12C52B14, (int32_t)0x06369B52, (int32_t)0xFFFD1AAF, (int32_t)0xFFFFD71D, (int32_t)0x0000000A,
+    (int32_t)0x1F152DD4, (int32_t)0x0617D229, (int32_t)0xFFFB3469, (int32_t)0xFFFFD7E7, (int32_t)0x00000010,
+    (int32_t)0x2B188ECB, (int32_t)0x05EA0363, (int32_t)0xFFF959F5, (int32_t)0xFFFFD915, (int32_t)0x00000016,
+    (int32_t)0x36B1AFDD, (int32_t)0x05AD9FEF, (int32_t)0xFFF78FE5, (int32_t)0xFFFFDAA2, (int32_t)0x0000001C,
+    (int32_t)0x41C3F8E7, (int32_t)0x05633CAF, (int32_t)0xFFF5DAA3, (int32_t)0xFFFFDC8C, (int32_t)0x00000021,
+    (int32_t)0x4C341E32, (int32_t)0x050B910A, (int32_t)0xFFF43E65, (int32_t)0xFFFFDECD, (int32_t)0x00000027,
+    (int32_t)0x55E863C9, (int32_t)0x04A77523, (int32_t)0xFFF2BF22, (int32_t)0xFFFFE15F, (int32_t)0x0000002C,
+    (int32_t)0x5EC8DCE6, (int32_t)0x0437DFCB, (int32_t)0xFFF1608D, (int32_t)0xFFFFE43E, (int32_t)0x00000030,
+    (int32_t)0x66BFA6F0, (int32_t)0x03BDE41B, (int32_t)0xFFF02604, (int32_t)0xFFFFE760, (int32_t)0x00000034,
+    (int32_t)0x6DB91F6D, (int32_t)0x033AAED1, (int32_t)0xFFEF1290, (int32_t)0xFFFFEAC0, (int32_t)0x00000038,
+    (int32_t)0x73A4146E, (int32_t)0x02AF8368, (int32_t)0xFFEE28D8, (int32_t)0xFFFFEE54, (int32_t)0x0000003B,
+    (int32_t)0x7871EEF3, (int32_t)0x021DB8FC, (int32_t)0xFFED6B1C, (int32_t)0xFFFFF213, (int32_t)0x0000003D,
+    (int32_t)0x7C16D6DF, (int32_t)0x0186B6FD, (int32_t)0xFFECDB30, (int32_t)0xFFFFF5F5, (int32_t)0x0000003F,
+    (int32_t)0x7E89D032, (int32_t)0x00EBF1B8, (int32_t)0xFFEC7A76, (int32_t)0xFFFFF9EF, (int32_t)0x00000040,
+    (int32_t)0x7FC4D12A, (int32_t)0x004EE6C0, (int32_t)0xFFEC49DD, (int32_t)0xFFFFFDF9, (int32_t)0x00000041
+};
+
+/** Chebyshev coefficients of atan(t) / pi, t from 0 to 1, on each of 8 segments of width 2^-3 */
+const int32_t math_host_atan_chebyshev[8 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x0289CAC7, (int32_t)0x0288BDCD, (int32_t)0xFFFEBDD4, (int32_t)0xFFFFCB16, (int32_t)0x0000004F,
+    (int32_t)0x0789B1A7, (int32_t)0x02753EF8, (int32_t)0xFFFC72A5, (int32_t)0xFFFFD447, (int32_t)0x000000CC,
+    (int32_t)0x0C51EE79, (int32_t)0x02518F6D, (int32_t)0xFFFABB4B, (int32_t)0xFFFFE2F7, (int32_t)0x000000FC,
+    (int32_t)0x10C75415, (int32_t)0x022301B9, (int32_t)0xFFF9BC28, (int32_t)0xFFFFF246, (int32_t)0x000000E4,
+    (int32_t)0x14D9CF9C, (int32_t)0x01EF3237, (int32_t)0xFFF965C8, (int32_t)0xFFFFFEB9, (int32_t)0x000000A7,
+    (int32_t)0x1883A1A8, (int32_t)0x01BAC05D, (int32_t)0xFFF98C51, (int32_t)0x0000070D, (int32_t)0x00000065,
+    (int32_t)0x1BC6D100, (int32_t)0x0188CF24, (int32_t)0xFFF9FF50, (int32_t)0x00000B99, (int32_t)0x00000030,
+    (int32_t)0x1EAA3E52, (int32_t)0x015B1D03, (int32_t)0xFFFA973F, (int32_t)0x00000D61, (int32_t)0x0000000C
+};
+
+/** Chebyshev coefficients of t^-0.25 / 2, t from 0.5 to 1, on each of 8 segments of width 2^-4 */
+const int32_t math_host_inv_qdrt_chebyshev[8 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x4AFC1706, (int32_t)0xFEE56FDE, (int32_t)0x000532E6, (int32_t)0xFFFFE29E, (int32_t)0x000000B4,
+    (int32_t)0x48ECA8C7, (int32_t)0xFF0A2C65, (int32_t)0x00040BCD, (int32_t)0xFFFFEB8B, (int32_t)0x00000070,
+    (int32_t)0x471EA1DC, (int32_t)0xFF271EAD, (int32_t)0x00033AB2, (int32_t)0xFFFFF13B, (int32_t)0x00000049,
+    (int32_t)0x4584B523, (int32_t)0xFF3E751B, (int32_t)0x0002A185, (int32_t)0xFFFFF503, (int32_t)0x00000032,
+    (int32_t)0x44152C06, (int32_t)0xFF51A1C8, (int32_t)0x00022E35, (int32_t)0xFFFFF7A0, (int32_t)0x00000023,
+    (int32_t)0x42C8BAF7, (int32_t)0xFF61A335, (int32_t)0x0001D563, (int32_t)0xFFFFF97A, (int32_t)0x00000019,
+    (int32_t)0x4199C616, (int32_t)0xFF6F2DD2, (int32_t)0x00018FA1, (int32_t)0xFFFFFAD5, (int32_t)0x00000013,
+    (int32_t)0x4083E740, (int32_t)0xFF7AC4F2, (int32_t)0x000157EA, (int32_t)0xFFFFFBD7, (int32_t)0x0000000E
+};
+
+/** Chebyshev coefficients of 1 / (4 t), t from 0.5 to 1, on each of 32 segments of width 2^-6 */
+const int32_t math_host_recip_chebyshev[32 * MATH_HOST_CHEBYSHEV_TERMS] =
+{
+    (int32_t)0x3F05D910, (int32_t)0xFF07C5B3, (int32_t)0x0001E8D9, (int32_t)0xFFFFFC3D, (int32_t)0x00000007,
+    (int32_t)0x3D2421AD, (int32_t)0xFF165F82, (int32_t)0x0001BE5B, (int32_t)0xFFFFFCAB, (int32_t)0x00000006,
+    (int32_t)0x3B5E598F, (int32_t)0xFF23B8F5, (int32_t)0x000198A7, (int32_t)0xFFFFFD0A, (int32_t)0x00000005,
+    (int32_t)0x39B22421, (int32_t)0xFF2FF5A3, (int32_t)0x00017714, (int32_t)0xFFFFFD5C, (int32_t)0x00000005,
+    (int32_t)0x381D6718, (int32_t)0xFF3B3455, (int32_t)0x00015915, (int32_t)0xFFFFFDA3, (int32_t)0x00000004,
+    (int32_t)0x369E419A, (int32_t)0xFF458FC7, (int32_t)0x00013E34, (int32_t)0xFFFFFDE1, (int32_t)0x00000004,
+    (int32_t)0x353304C9, (int32_t)0xFF4F1F46, (int32_t)0x0001260B, (int32_t)0xFFFFFE17, (int32_t)0x00000003,
+    (int32_t)0x33DA2D6C, (int32_t)0xFF57F739, (int32_t)0x00011045, (int32_t)0xFFFFFE47, (int32_t)0x00000003,
+    (int32_t)0x32925E8F, (int32_t)0xFF602985, (int32_t)0x0000FC98, (int32_t)0xFFFFFE71, (int32_t)0x00000002,
+    (int32_t)0x315A5CE1, (int32_t)0xFF67C5F3, (int32_t)0x0000EAC5, (int32_t)0xFFFFFE96, (int32_t)0x00000002,
+    (int32_t)0x30310AC3, (int32_t)0xFF6EDA72, (int32_t)0x0000DA95, (int32_t)0xFFFFFEB7, (int32_t)0x00000002,
+    (int32_t)0x2F1564DB, (int32_t)0xFF75735F, (int32_t)0x0000CBD9, (int32_t)0xFFFFFED4, (int32_t)0x00000002,
+    (int32_t)0x2E067F20, (int32_t)0xFF7B9BB4, (int32_t)0x0000BE6A, (int32_t)0xFFFFFEEE, (int32_t)0x00000002,
+    (int32_t)0x2D03824D, (int32_t)0xFF815D3D, (int32_t)0x0000B221, (int32_t)0xFFFFFF05, (int32_t)0x00000001,
+    (int32_t)0x2C0BA9A1, (int32_t)0xFF86C0B8, (int32_t)0x0000A6E2, (int32_t)0xFFFFFF1A, (int32_t)0x00000001,
+    (int32_t)0x2B1E40F0, (int32_t)0xFF8BCDFD, (int32_t)0x00009C90, (int32_t)0xFFFFFF2D, (int32_t)0x00000001,
+    (int32_t)0x2A3AA2E8, (int32_t)0xFF908C14, (int32_t)0x00009313, (int32_t)0xFFFFFF3E, (int32_t)0x00000001,
+    (int32_t)0x29603797, (int32_t)0xFF950153, (int32_t)0x00008A57, (int32_t)0xFFFFFF4D, (int32_t)0x00000001,
+    (int32_t)0x288E7312, (int32_t)0xFF993372, (int32_t)0x00008248, (int32_t)0xFFFFFF5B, (int32_t)0x00000001,
+    (int32_t)0x27C4D450, (int32_t)0xFF9D2798, (int32_t)0x00007AD7, (int32_t)0xFFFFFF67, (int32_t)0x00000001,
+    (int32_t)0x2702E41A, (int32_t)0xFFA0E275, (int32_t)0x000073F4, (int32_t)0xFFFFFF73, (int32_t)0x00000001,
+    (int32_t)0x26483426, (int32_t)0xFFA46846, (int32_t)0x00006D92, (int32_t)0xFFFFFF7D, (int32_t)0x00000001,
+    (int32_t)0x25945E41, (int32_t)0xFFA7BCE6, (int32_t)0x000067A6, (int32_t)0xFFFFFF86, (int32_t)0x00000001,
+    (int32_t)0x24E70396, (int32_t)0xFFAAE3DA, (int32_t)0x00006226, (int32_t)0xFFFFFF8F, (int32_t)0x00000001,
+    (int32_t)0x243FCC09, (int32_t)0xFFADE055, (int32_t)0x00005D07, (int32_t)0xFFFFFF97, (int32_t)0x00000000,
+    (int32_t)0x239E659D, (int32_t)0xFFB0B546, (int32_t)0x00005842, (int32_t)0xFFFFFF9E, (int32_t)0x00000000,
+    (int32_t)0x230283F1, (int32_t)0xFFB3655A, (int32_t)0x000053CF, (int32_t)0xFFFFFFA4, (int32_t)0x00000000,
+    (int32_t)0x226BDFC9, (int32_t)0xFFB5F307, (int32_t)0x00004FA7, (int32_t)0xFFFFFFAA, (int32_t)0x00000000,
+    (int32_t)0x21DA369C, (int32_t)0xFFB8608F, (int32_t)0x00004BC5, (int32_t)0xFFFFFFB0, (int32_t)0x00000000,
+    (int32_t)0x214D4A36, (int32_t)0xFFBAB004, (int32_t)0x00004822, (int32_t)0xFFFFFFB5, (int32_t)0x00000000,
+    (int32_t)0x20C4E05F, (int32_t)0xFFBCE34E, (int32_t)0x000044B9, (int32_t)0xFFFFFFBA, (int32_t)0x00000000,
+    (int32_t)0x2040C289, (int32_t)0xFFBEFC32, (int32_t)0x00004187, (int32_t)0xFFFFFFBE, (int32_t)0x00000000
+};
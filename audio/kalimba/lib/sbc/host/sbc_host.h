@@ -0,0 +1,199 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host.h
+ * \ingroup sbc
+ *
+ * Host (PC) port of the Kalimba SBC encoder and decoder library. <br>
+ *
+ * The encoder and decoder follow the arch4 (K32) assembly in the parent
+ * directory step by step: the same frame layout in the sample buffers,
+ * the same coefficient tables, and the rMAC accumulate, rounding and
+ * saturation behaviour of each multiply. The polyphase analysis and
+ * synthesis filterbanks have SSE4.1 and NEON versions which give the same
+ * results as the scalar version; see sbc_host_filter.c.
+ *
+ * This directory is not part of the Kalimba library build. To build the
+ * benchmark and regression tool on a PC:
+ *
+ *     cc -O2 -msse4.1 -o sbc_host_bench *.c
+ *
+ * (no -msse4.1 on ARM, where NEON is used when the compiler enables it).
+ */
+
+#ifndef SBC_HOST_H
+#define SBC_HOST_H
+
+/****************************************************************************
+Include Files
+*/
+#include <stdint.h>
+
+/****************************************************************************
+Public Constant Declarations
+*/
+#define SBC_HOST_MAX_CHANNELS           2
+#define SBC_HOST_MAX_SUBBANDS           8
+#define SBC_HOST_MAX_BLOCKS             16
+
+/** Samples per channel in the largest frame */
+#define SBC_HOST_MAX_FRAME_SAMPLES      (SBC_HOST_MAX_BLOCKS * SBC_HOST_MAX_SUBBANDS)
+
+/** Largest encoded frame in bytes */
+#define SBC_HOST_MAX_FRAME_BYTES        (4 + 8 + 32 * SBC_HOST_MAX_BLOCKS + 1)
+
+/** Length of the analysis X and synthesis V ring buffers for M = 8 */
+#define SBC_HOST_ANALYSIS_BUFFER_LENGTH     80
+#define SBC_HOST_SYNTHESIS_BUFFER_LENGTH    160
+
+/* Frame header values, as $sbc in global_variables_encdec.asm */
+#define SBC_HOST_FS_16000HZ             0
+#define SBC_HOST_FS_32000HZ             1
+#define SBC_HOST_FS_44100HZ             2
+#define SBC_HOST_FS_48000HZ             3
+
+#define SBC_HOST_MONO                   0
+#define SBC_HOST_DUAL_CHANNEL           1
+#define SBC_HOST_STEREO                 2
+#define SBC_HOST_JOINT_STEREO           3
+
+#define SBC_HOST_LOUDNESS               0
+#define SBC_HOST_SNR                    1
+
+/* sbc_host_decode_frame return values other than a sample count */
+#define SBC_HOST_NOT_ENOUGH_INPUT_DATA  (-1)
+#define SBC_HOST_FRAME_CORRUPT          (-2)
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/** Encoder settings, as the ENC_SETTING_ fields of the library */
+typedef struct
+{
+    unsigned sampling_freq;         /**< SBC_HOST_FS_ value */
+    unsigned nrof_blocks;           /**< 4, 8, 12 or 16 */
+    unsigned channel_mode;          /**< SBC_HOST_MONO etc. */
+    unsigned allocation_method;     /**< SBC_HOST_LOUDNESS or SBC_HOST_SNR */
+    unsigned nrof_subbands;         /**< 4 or 8 */
+    unsigned bitpool;               /**< 2 to the SBC maximum for the mode, not checked */
+    unsigned force_word_align;      /**< pad frames to 16 bits, not 8 */
+} sbc_host_params;
+
+/** Frame state shared by the encoder and decoder. The sample buffer is
+ *  indexed as the library's AUDIO_SAMPLE buffer: block, then channel, then
+ *  subband, with nrof_channels * nrof_subbands words per block. */
+typedef struct
+{
+    sbc_host_params params;
+    unsigned nrof_channels;
+    int32_t audio_sample[SBC_HOST_MAX_BLOCKS * SBC_HOST_MAX_CHANNELS * SBC_HOST_MAX_SUBBANDS];
+    int scale_factor[SBC_HOST_MAX_CHANNELS * SBC_HOST_MAX_SUBBANDS];
+    int bitneed[SBC_HOST_MAX_CHANNELS * SBC_HOST_MAX_SUBBANDS];
+    int bits[SBC_HOST_MAX_CHANNELS * SBC_HOST_MAX_SUBBANDS];
+    int join[SBC_HOST_MAX_SUBBANDS];
+    unsigned crc_checksum;
+} sbc_host_frame;
+
+/** Analysis filterbank history of one channel. The X ring buffer is held
+ *  twice over so that every window reads contiguous samples. */
+typedef struct
+{
+    int32_t x[2 * SBC_HOST_ANALYSIS_BUFFER_LENGTH];
+    unsigned x_pos;
+} sbc_host_analysis;
+
+/** Synthesis filterbank history of one channel, with the V ring buffer
+ *  held twice over and the largest magnitude in each 2M word segment. */
+typedef struct
+{
+    int32_t v[2 * SBC_HOST_SYNTHESIS_BUFFER_LENGTH];
+    uint32_t v_max[10];
+    unsigned v_pos;
+} sbc_host_synthesis;
+
+typedef struct
+{
+    sbc_host_frame frame;
+    int32_t audio_sample_js[SBC_HOST_MAX_BLOCKS * SBC_HOST_MAX_CHANNELS * SBC_HOST_MAX_SUBBANDS];
+    int scale_factor_js[SBC_HOST_MAX_CHANNELS * SBC_HOST_MAX_SUBBANDS];
+    sbc_host_analysis analysis[SBC_HOST_MAX_CHANNELS];
+    uint32_t put_nextword;
+    int put_bitpos;
+    int use_simd;
+} sbc_host_encoder;
+
+typedef struct
+{
+    sbc_host_frame frame;
+    sbc_host_synthesis synthesis[SBC_HOST_MAX_CHANNELS];
+    unsigned framecrc;
+    unsigned cur_frame_length;
+    int use_simd;
+} sbc_host_decoder;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief Initialise an encoder, as init_static_encoder and reset_encoder.
+ *
+ * \param enc       The encoder.
+ * \param params    Encoder settings, which may be changed between frames.
+ * \param use_simd  Non-zero to use the SSE4.1 or NEON filterbank when the
+ *                  build has one.
+ */
+extern void sbc_host_encoder_init(sbc_host_encoder *enc, const sbc_host_params *params, int use_simd);
+
+/**
+ * \brief Encode one frame, as $sbcenc.frame_encode.
+ *
+ * \param enc   The encoder.
+ * \param left  nrof_blocks * nrof_subbands Q31 samples, or NULL.
+ * \param right nrof_blocks * nrof_subbands Q31 samples, or NULL.
+ * \param out   At least SBC_HOST_MAX_FRAME_BYTES bytes.
+ *
+ * \return The number of bytes written. The library writes the stream in
+ *         16 bit words, so the last byte of a frame with an odd length is
+ *         written with the next frame or by sbc_host_encoder_flush.
+ */
+extern unsigned sbc_host_encode_frame(sbc_host_encoder *enc, const int32_t *left, const int32_t *right, uint8_t *out);
+
+/**
+ * \brief Write any partly filled word of the encoded stream.
+ *
+ * \return The number of bytes written to out, 0 or 1.
+ */
+extern unsigned sbc_host_encoder_flush(sbc_host_encoder *enc, uint8_t *out);
+
+/**
+ * \brief Initialise a decoder, as init_static_decoder and reset_decoder.
+ */
+extern void sbc_host_decoder_init(sbc_host_decoder *dec, int use_simd);
+
+/**
+ * \brief Decode one frame, as $sbcdec.frame_decode.
+ *
+ * \param dec       The decoder.
+ * \param data      Encoded stream.
+ * \param length    Bytes in data.
+ * \param consumed  Set to the number of bytes used from data.
+ * \param left      At least SBC_HOST_MAX_FRAME_SAMPLES words, or NULL.
+ * \param right     At least SBC_HOST_MAX_FRAME_SAMPLES words, or NULL.
+ *
+ * \return Q31 samples written per channel, SBC_HOST_NOT_ENOUGH_INPUT_DATA
+ *         if data does not hold a whole frame, or SBC_HOST_FRAME_CORRUPT
+ *         if the header or CRC of the frame found is bad.
+ */
+extern int sbc_host_decode_frame(sbc_host_decoder *dec, const uint8_t *data, unsigned length,
+                                 unsigned *consumed, int32_t *left, int32_t *right);
+
+/**
+ * \brief Length of the frame described by the params and channel count of
+ *        a frame, as $sbc.calc_frame_length.
+ */
+extern unsigned sbc_host_frame_length(const sbc_host_frame *frame);
+
+#endif /* SBC_HOST_H */
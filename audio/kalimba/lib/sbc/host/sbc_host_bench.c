@@ -0,0 +1,591 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_bench.c
+ * \ingroup sbc
+ *
+ * Benchmark and regression tool for the host SBC port. <br>
+ *
+ * With no arguments, encodes and decodes a synthetic signal in several
+ * configurations, checks that the SIMD filterbanks give the same stream and
+ * PCM as the scalar ones, and reports the speed and round trip SNR. It then
+ * checks the reference vectors: the stream and PCM of an integer test signal
+ * in each configuration, and the PCM of the SBC file the KSE decoder test
+ * plays, against hashes recorded from this port.
+ *
+ *     sbc_host_bench -d file.sbc [-o out.raw] [-r reference.raw|.wav [-r right.raw|.wav]]
+ *
+ * decodes an SBC file, prints a checksum of the 16 bit PCM, optionally
+ * writes it (interleaved if stereo) and compares it with a reference
+ * produced by the DSP library. One reference holds interleaved PCM; two
+ * hold the left and right channels, as audio/kse/config/sbc_decoder.cfg.json
+ * writes them under kalsim to tmp/sbc_decoder_0.wav and tmp/sbc_decoder_1.wav.
+ * Returns non-zero on any mismatch.
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sbc_host.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define BENCH_SECONDS       10
+#define MAX_DELAY           256
+#define WAV_HEADER_BYTES    44
+
+/** Smallest SBC frame: mono, 4 subbands, 4 blocks, bitpool 2 */
+#define MIN_FRAME_BYTES     7
+
+/** Frames of the integer test signal encoded for the reference vectors */
+#define REFERENCE_FRAMES    200
+
+/** The stream sbc_decoder.cfg.json plays, from this directory, and the
+    checksum of its 16 bit PCM as decode_file prints it */
+#define REFERENCE_FILE      "../../../../kse/resource/153_Prompts_176.4_kHz_Music_Detected_48k.sbc"
+#define REFERENCE_FILE_CHECKSUM 0xd0a6c50du
+
+#define FNV_OFFSET_BASIS    2166136261u
+#define FNV_PRIME           16777619u
+
+/****************************************************************************
+Private Type Declarations
+*/
+typedef struct
+{
+    const char *name;
+    unsigned rate;
+    sbc_host_params params;
+    /** FNV-1a hashes of the reference vector stream and of its decoded
+        PCM, recorded from this port */
+    uint32_t stream_hash;
+    uint32_t pcm_hash;
+} bench_config;
+
+/****************************************************************************
+Private Data Declarations
+*/
+static const bench_config configs[] =
+{
+    {"48kHz joint stereo M8 B16 bitpool 53 loudness", 48000,
+     {SBC_HOST_FS_48000HZ, 16, SBC_HOST_JOINT_STEREO, SBC_HOST_LOUDNESS, 8, 53, 0},
+     0x1ffe8802u, 0xf123d147u},
+    {"44.1kHz stereo M8 B16 bitpool 35 SNR", 44100,
+     {SBC_HOST_FS_44100HZ, 16, SBC_HOST_STEREO, SBC_HOST_SNR, 8, 35, 0},
+     0x1620bde8u, 0x7207b50eu},
+    {"32kHz dual channel M8 B12 bitpool 24 loudness", 32000,
+     {SBC_HOST_FS_32000HZ, 12, SBC_HOST_DUAL_CHANNEL, SBC_HOST_LOUDNESS, 8, 24, 0},
+     0xe7c440eeu, 0x2172d257u},
+    {"16kHz mono M4 B8 bitpool 26 loudness", 16000,
+     {SBC_HOST_FS_16000HZ, 8, SBC_HOST_MONO, SBC_HOST_LOUDNESS, 4, 26, 1},
+     0x630b0f59u, 0x9eba9f8du},
+};
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* A few tones and some noise at about -6dBFS, different on each channel */
+static void make_signal(int32_t *pcm, unsigned n, unsigned rate, unsigned ch)
+{
+    uint32_t seed = 12345u + ch;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        double t = (double)i / rate;
+        double x = 0.25 * sin(2 * M_PI * (ch ? 440.0 : 1000.0) * t)
+                 + 0.12 * sin(2 * M_PI * 3150.0 * t + ch)
+                 + 0.06 * sin(2 * M_PI * (0.3 * rate / 2) * t);
+
+        seed = seed * 1664525u + 1013904223u;
+        x += 0.03 * ((double)(int32_t)seed / 2147483648.0);
+        pcm[i] = (int32_t)(x * 2147483647.0);
+    }
+}
+
+/* FNV-1a of a block of bytes */
+static uint32_t hash_bytes(uint32_t hash, const uint8_t *bytes, unsigned count)
+{
+    unsigned i;
+
+    for (i = 0; i < count; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/* FNV-1a of a block of words, low byte first */
+static uint32_t hash_words(uint32_t hash, const int32_t *words, unsigned count)
+{
+    unsigned i, b;
+
+    for (i = 0; i < count; i++)
+    {
+        for (b = 0; b < 32; b += 8)
+        {
+            hash = (hash ^ (((uint32_t)words[i] >> b) & 0xFF)) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+/* The reference vector input: two triangle waves and some noise, in integer
+   arithmetic so that every host builds the same samples. Every other
+   thousand samples it clips at full scale. */
+static void make_reference_signal(int32_t *pcm, unsigned n, unsigned ch)
+{
+    uint32_t seed = 54321u + ch;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        uint32_t slow = (uint32_t)i * (ch ? 0x00c80000u : 0x01000000u);
+        uint32_t fast = (uint32_t)i * 0x0b000000u;
+        int32_t tri_slow = (int32_t)((slow & 0x80000000u) ? ~slow : slow) - 0x40000000;
+        int32_t tri_fast = (int32_t)((fast & 0x80000000u) ? ~fast : fast) - 0x40000000;
+        int64_t x;
+
+        seed = seed * 1664525u + 1013904223u;
+        x = (int64_t)tri_slow + (tri_fast >> 2) + (int32_t)(seed >> 4) - 0x08000000;
+        /* Every other thousand samples, twice as loud and clipped */
+        if ((i / 1000) & 1)
+        {
+            x = 2 * x;
+            x = (x > INT32_MAX) ? INT32_MAX : (x < INT32_MIN) ? INT32_MIN : x;
+        }
+        pcm[i] = (int32_t)x;
+    }
+}
+
+/* Encode the signal a frame at a time. Returns the stream length. */
+static unsigned encode(const sbc_host_params *params, int use_simd, const int32_t *const *pcm,
+                       unsigned frames, uint8_t *stream)
+{
+    static sbc_host_encoder enc;
+    unsigned frame_samples = params->nrof_blocks * params->nrof_subbands;
+    unsigned length = 0;
+    unsigned f;
+
+    sbc_host_encoder_init(&enc, params, use_simd);
+    for (f = 0; f < frames; f++)
+    {
+        const int32_t *right = pcm[1] ? &pcm[1][f * frame_samples] : NULL;
+
+        length += sbc_host_encode_frame(&enc, &pcm[0][f * frame_samples], right, &stream[length]);
+    }
+    return length + sbc_host_encoder_flush(&enc, &stream[length]);
+}
+
+/* Decode a whole stream. Returns the samples per channel, or 0 after
+   printing an error if a frame is corrupt. */
+static unsigned decode(int use_simd, const uint8_t *stream, unsigned length,
+                       int32_t *left, int32_t *right, unsigned max_samples, unsigned *nrof_channels)
+{
+    static sbc_host_decoder dec;
+    unsigned pos = 0;
+    unsigned samples = 0;
+
+    sbc_host_decoder_init(&dec, use_simd);
+    while (samples + SBC_HOST_MAX_FRAME_SAMPLES <= max_samples)
+    {
+        unsigned consumed;
+        int result = sbc_host_decode_frame(&dec, &stream[pos], length - pos, &consumed,
+                                           &left[samples], &right[samples]);
+
+        pos += consumed;
+        if (result == SBC_HOST_NOT_ENOUGH_INPUT_DATA)
+        {
+            break;
+        }
+        if (result == SBC_HOST_FRAME_CORRUPT)
+        {
+            fprintf(stderr, "corrupt frame at byte %u\n", pos);
+            return 0;
+        }
+        samples += (unsigned)result;
+    }
+    *nrof_channels = dec.frame.nrof_channels;
+    return samples;
+}
+
+/* SNR of the decoded signal against the input, at the best delay */
+static double round_trip_snr(const int32_t *in, const int32_t *out, unsigned n)
+{
+    double best = -1000.0;
+    unsigned delay, i;
+
+    for (delay = 0; delay < MAX_DELAY; delay++)
+    {
+        double signal = 0.0;
+        double noise = 0.0;
+
+        for (i = MAX_DELAY; i + delay < n; i++)
+        {
+            double error = (double)out[i + delay] - (double)in[i];
+
+            signal += (double)in[i] * (double)in[i];
+            noise += error * error;
+        }
+        if (noise > 0.0 && 10.0 * log10(signal / noise) > best)
+        {
+            best = 10.0 * log10(signal / noise);
+        }
+    }
+    return best;
+}
+
+static double seconds_since(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int run_benchmarks(void)
+{
+    int failures = 0;
+    unsigned c;
+
+    for (c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        const bench_config *config = &configs[c];
+        unsigned frame_samples = config->params.nrof_blocks * config->params.nrof_subbands;
+        unsigned frames = BENCH_SECONDS * config->rate / frame_samples;
+        unsigned n = frames * frame_samples;
+        unsigned stereo = config->params.channel_mode != SBC_HOST_MONO;
+        size_t stream_size = (size_t)frames * SBC_HOST_MAX_FRAME_BYTES + 2;
+        int32_t *in[2], *out[2][2];
+        const int32_t *pcm[2];
+        uint8_t *stream[2];
+        unsigned length[2], samples[2], nch;
+        double encode_time[2], decode_time[2];
+        unsigned simd, ch;
+
+        for (ch = 0; ch < 2; ch++)
+        {
+            in[ch] = malloc(n * sizeof(int32_t));
+            out[ch][0] = malloc((n + SBC_HOST_MAX_FRAME_SAMPLES) * sizeof(int32_t));
+            out[ch][1] = malloc((n + SBC_HOST_MAX_FRAME_SAMPLES) * sizeof(int32_t));
+            stream[ch] = malloc(stream_size);
+            make_signal(in[ch], n, config->rate, ch);
+        }
+        pcm[0] = in[0];
+        pcm[1] = stereo ? in[1] : NULL;
+
+        for (simd = 0; simd < 2; simd++)
+        {
+            clock_t start = clock();
+
+            length[simd] = encode(&config->params, (int)simd, pcm, frames, stream[simd]);
+            encode_time[simd] = seconds_since(start);
+
+            start = clock();
+            samples[simd] = decode((int)simd, stream[0], length[0], out[0][simd], out[1][simd],
+                                   n + SBC_HOST_MAX_FRAME_SAMPLES, &nch);
+            decode_time[simd] = seconds_since(start);
+        }
+
+        printf("%s\n", config->name);
+        for (simd = 0; simd < 2; simd++)
+        {
+            printf("  %-6s encode %7.1fx realtime, decode %7.1fx realtime\n", simd ? "simd" : "scalar",
+                   BENCH_SECONDS / encode_time[simd], BENCH_SECONDS / decode_time[simd]);
+        }
+
+        if ((length[0] != length[1]) || memcmp(stream[0], stream[1], length[0]))
+        {
+            printf("  FAIL: SIMD encoder output differs from scalar\n");
+            failures++;
+        }
+        if ((samples[0] != n) || (samples[1] != n)
+            || memcmp(out[0][0], out[0][1], n * sizeof(int32_t))
+            || memcmp(out[1][0], out[1][1], n * sizeof(int32_t)))
+        {
+            printf("  FAIL: SIMD decoder output differs from scalar\n");
+            failures++;
+        }
+        printf("  %u bytes, round trip SNR left %.1fdB", length[0], round_trip_snr(in[0], out[0][0], n));
+        if (stereo)
+        {
+            printf(", right %.1fdB", round_trip_snr(in[1], out[1][0], n));
+        }
+        printf("\n");
+
+        for (ch = 0; ch < 2; ch++)
+        {
+            free(in[ch]);
+            free(out[ch][0]);
+            free(out[ch][1]);
+            free(stream[ch]);
+        }
+    }
+    return failures;
+}
+
+static uint8_t *read_file(const char *name, unsigned *length)
+{
+    FILE *file = fopen(name, "rb");
+    uint8_t *data;
+    long size;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", name);
+        exit(2);
+    }
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = malloc((size_t)size + 1);
+    if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size))
+    {
+        fprintf(stderr, "cannot read %s\n", name);
+        exit(2);
+    }
+    fclose(file);
+    *length = (unsigned)size;
+    return data;
+}
+
+/* Compares PCM with a reference file, skipping a WAV header if it has one */
+static int compare_reference(const char *ref_name, const uint8_t *pcm, unsigned pcm_bytes)
+{
+    unsigned ref_length, offset = 0, i;
+    uint8_t *ref = read_file(ref_name, &ref_length);
+    int failures = 0;
+
+    if ((ref_length >= WAV_HEADER_BYTES) && !memcmp(ref, "RIFF", 4))
+    {
+        offset = WAV_HEADER_BYTES;
+    }
+    if ((ref_length - offset != pcm_bytes) || memcmp(&ref[offset], pcm, pcm_bytes))
+    {
+        for (i = 0; (i < pcm_bytes) && (offset + i < ref_length) && (ref[offset + i] == pcm[i]); i++)
+        {
+        }
+        printf("FAIL: differs from %s at sample %u\n", ref_name, i / 2);
+        failures++;
+    }
+    else
+    {
+        printf("matches %s\n", ref_name);
+    }
+    free(ref);
+    return failures;
+}
+
+/* Decodes an SBC file with both filterbanks, then writes and compares the
+   16 bit PCM. One reference is interleaved PCM, two are one per channel.
+   Sets the checksum of the interleaved PCM. */
+static int decode_file(const char *name, const char *out_name, const char *const *ref_names,
+                       unsigned nrof_refs, uint32_t *checksum)
+{
+    unsigned length, samples, simd_samples, nch, pcm_bytes, i;
+    uint8_t *stream = read_file(name, &length);
+    unsigned max_samples = (length / MIN_FRAME_BYTES + 1) * SBC_HOST_MAX_FRAME_SAMPLES;
+    int32_t *left = malloc(max_samples * sizeof(int32_t));
+    int32_t *right = malloc(max_samples * sizeof(int32_t));
+    int32_t *simd_left = malloc(max_samples * sizeof(int32_t));
+    int32_t *simd_right = malloc(max_samples * sizeof(int32_t));
+    uint8_t *pcm, *channel_pcm;
+    int failures = 0;
+
+    samples = decode(0, stream, length, left, right, max_samples, &nch);
+    simd_samples = decode(1, stream, length, simd_left, simd_right, max_samples, &nch);
+    if ((samples != simd_samples) || memcmp(left, simd_left, samples * sizeof(int32_t))
+        || memcmp(right, simd_right, samples * sizeof(int32_t)))
+    {
+        printf("FAIL: SIMD decoder output differs from scalar\n");
+        failures++;
+    }
+
+    /* 16 bit little endian PCM, interleaved if stereo */
+    pcm_bytes = samples * nch * 2;
+    pcm = malloc(pcm_bytes + 1);
+    channel_pcm = malloc(samples * 2 + 1);
+    for (i = 0; i < samples * nch; i++)
+    {
+        int32_t sample = ((nch == 2) && (i & 1)) ? right[i >> 1] : left[i / nch];
+        int16_t value = (int16_t)(sample >> 16);
+
+        pcm[2 * i] = (uint8_t)value;
+        pcm[2 * i + 1] = (uint8_t)((uint16_t)value >> 8);
+    }
+    *checksum = hash_bytes(FNV_OFFSET_BASIS, pcm, pcm_bytes);
+    printf("%s: %u samples, %u channel(s), checksum %08x\n", name, samples, nch, (unsigned)*checksum);
+
+    if (out_name != NULL)
+    {
+        FILE *file = fopen(out_name, "wb");
+
+        if ((file == NULL) || (fwrite(pcm, 1, pcm_bytes, file) != pcm_bytes))
+        {
+            fprintf(stderr, "cannot write %s\n", out_name);
+            exit(2);
+        }
+        fclose(file);
+    }
+
+    if (nrof_refs == 1)
+    {
+        failures += compare_reference(ref_names[0], pcm, pcm_bytes);
+    }
+    else if (nrof_refs == 2)
+    {
+        unsigned ch;
+
+        /* A mono stream is checked against both, as the decoder writes it
+           to both outputs */
+        for (ch = 0; ch < 2; ch++)
+        {
+            for (i = 0; i < samples; i++)
+            {
+                unsigned from = 2 * (i * nch + ((nch == 2) ? ch : 0));
+
+                channel_pcm[2 * i] = pcm[from];
+                channel_pcm[2 * i + 1] = pcm[from + 1];
+            }
+            failures += compare_reference(ref_names[ch], channel_pcm, samples * 2);
+        }
+    }
+
+    free(stream);
+    free(left);
+    free(right);
+    free(simd_left);
+    free(simd_right);
+    free(pcm);
+    free(channel_pcm);
+    return failures;
+}
+
+/* The reference vectors against the hashes recorded from this port. The
+   round trip and SIMD checks would pass a change that moved bits of the
+   output of both filterbanks; these do not. They are this port's output,
+   not DSP output, which the tree does not have; decode_file's references
+   check the file vector against the DSP. */
+static int check_reference_vectors(void)
+{
+    int failures = 0;
+    unsigned c, ch, simd;
+
+    for (c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        const bench_config *config = &configs[c];
+        unsigned n = REFERENCE_FRAMES * config->params.nrof_blocks * config->params.nrof_subbands;
+        unsigned stereo = config->params.channel_mode != SBC_HOST_MONO;
+        int32_t *in[2], *out[2];
+        const int32_t *pcm[2];
+        uint8_t *stream = malloc((size_t)REFERENCE_FRAMES * SBC_HOST_MAX_FRAME_BYTES + 2);
+
+        for (ch = 0; ch < 2; ch++)
+        {
+            in[ch] = malloc(n * sizeof(int32_t));
+            out[ch] = malloc((n + SBC_HOST_MAX_FRAME_SAMPLES) * sizeof(int32_t));
+            make_reference_signal(in[ch], n, ch);
+        }
+        pcm[0] = in[0];
+        pcm[1] = stereo ? in[1] : NULL;
+
+        for (simd = 0; simd < 2; simd++)
+        {
+            unsigned length = encode(&config->params, (int)simd, pcm, REFERENCE_FRAMES, stream);
+            uint32_t stream_hash = hash_bytes(FNV_OFFSET_BASIS, stream, length);
+            unsigned samples, nch;
+            uint32_t pcm_hash;
+
+            samples = decode((int)simd, stream, length, out[0], out[1], n + SBC_HOST_MAX_FRAME_SAMPLES, &nch);
+            pcm_hash = hash_words(FNV_OFFSET_BASIS, out[0], samples);
+            if (stereo)
+            {
+                pcm_hash = hash_words(pcm_hash, out[1], samples);
+            }
+            if ((stream_hash != config->stream_hash) || (pcm_hash != config->pcm_hash))
+            {
+                printf("FAIL: %s, %s: stream 0x%08x PCM 0x%08x, reference stream 0x%08x PCM 0x%08x\n",
+                       config->name, simd ? "simd" : "scalar", stream_hash, pcm_hash,
+                       config->stream_hash, config->pcm_hash);
+                failures++;
+            }
+        }
+
+        for (ch = 0; ch < 2; ch++)
+        {
+            free(in[ch]);
+            free(out[ch]);
+        }
+        free(stream);
+    }
+
+    {
+        FILE *file = fopen(REFERENCE_FILE, "rb");
+        uint32_t checksum;
+
+        if (file == NULL)
+        {
+            printf("%s not found, file vector skipped\n", REFERENCE_FILE);
+        }
+        else
+        {
+            fclose(file);
+            failures += decode_file(REFERENCE_FILE, NULL, NULL, 0, &checksum);
+            if (checksum != REFERENCE_FILE_CHECKSUM)
+            {
+                printf("FAIL: checksum %08x, reference %08x\n", (unsigned)checksum,
+                       (unsigned)REFERENCE_FILE_CHECKSUM);
+                failures++;
+            }
+        }
+    }
+
+    printf("reference vectors: %s\n", failures ? "FAILED" : "stream and PCM match, with simd and without");
+    return failures;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+int main(int argc, char *argv[])
+{
+    const char *name = NULL;
+    const char *out_name = NULL;
+    const char *ref_names[2];
+    unsigned nrof_refs = 0;
+    uint32_t checksum;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-d") && (i + 1 < argc))
+        {
+            name = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-o") && (i + 1 < argc))
+        {
+            out_name = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-r") && (i + 1 < argc) && (nrof_refs < 2))
+        {
+            ref_names[nrof_refs++] = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-d file.sbc [-o out.raw] [-r reference.raw|.wav [-r right.raw|.wav]]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (name != NULL)
+    {
+        return decode_file(name, out_name, ref_names, nrof_refs, &checksum) ? 1 : 0;
+    }
+    return (run_benchmarks() + check_reference_vectors()) ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_common.c
+ * \ingroup sbc
+ *
+ * Functions of the host SBC port used by both the encoder and the decoder:
+ * crc_calc.asm, calc_frame_length.asm and calc_bit_allocation.asm.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "sbc_host_private.h"
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Slices a bitneed contributes at a bitslice, as bitslice_lkup */
+static int slice_count(int bitneed, int bitslice)
+{
+    int diff = bitneed - bitslice;
+
+    if (diff == 1)
+    {
+        return 2;
+    }
+    return ((diff > 1) && (diff < 16)) ? 1 : 0;
+}
+
+/* Derive bitneed from the scale factors of count subbands, starting at
+   subband 0 of a channel */
+static void calc_bitneed(sbc_host_frame *frame, unsigned first, unsigned count)
+{
+    unsigned m = frame->params.nrof_subbands;
+    unsigned i;
+
+    for (i = first; i < first + count; i++)
+    {
+        int scale_factor = frame->scale_factor[i];
+
+        if (frame->params.allocation_method == SBC_HOST_SNR)
+        {
+            frame->bitneed[i] = scale_factor;
+        }
+        else if (scale_factor == 0)
+        {
+            frame->bitneed[i] = -5;
+        }
+        else
+        {
+            const int *offset = (m == 8) ? sbc_loudness_offset_m8 : sbc_loudness_offset_m4;
+            int loudness = scale_factor - offset[frame->params.sampling_freq * m + (i % m)];
+
+            frame->bitneed[i] = (loudness >= 0) ? (loudness >> 1) : loudness;
+        }
+    }
+}
+
+/* Allocate the bitpool to count subbands. In stereo and joint stereo the
+   two channels share the bitpool and the remaining bits are given out
+   alternately to the left and right subbands. */
+static void allocate_bits(sbc_host_frame *frame, unsigned first, unsigned count, unsigned stride)
+{
+    int bitpool = (int)frame->params.bitpool;
+    int max_bitneed = 0;
+    int bitcount = 0;
+    int slicecount = 0;
+    int bitslice;
+    unsigned i, n;
+
+    for (i = first; i < first + count; i++)
+    {
+        if (frame->bitneed[i] > max_bitneed)
+        {
+            max_bitneed = frame->bitneed[i];
+        }
+    }
+
+    /* iteratively find how many bitslices fit into the bitpool */
+    bitslice = max_bitneed + 1;
+    do
+    {
+        bitslice--;
+        bitcount += slicecount;
+        slicecount = 0;
+        for (i = first; i < first + count; i++)
+        {
+            slicecount += slice_count(frame->bitneed[i], bitslice);
+        }
+    } while (bitcount + slicecount < bitpool);
+
+    if (bitcount + slicecount == bitpool)
+    {
+        bitcount += slicecount;
+        bitslice--;
+    }
+
+    /* distribute bits until the last bitslice is reached */
+    for (i = first; i < first + count; i++)
+    {
+        int bits = frame->bitneed[i] - bitslice;
+
+        if (bits < 2)
+        {
+            bits = 0;
+        }
+        else if (bits > 16)
+        {
+            bits = 16;
+        }
+        frame->bits[i] = bits;
+    }
+
+    /* remaining bits are allocated starting at subband 0. With a non-zero
+       stride (the right channel offset) the order is left 0, right 0,
+       left 1, ... */
+    for (n = 0; (n < count) && (bitcount < bitpool); n++)
+    {
+        i = first + (stride ? ((n >> 1) + (n & 1) * stride) : n);
+        if ((frame->bits[i] >= 2) && (frame->bits[i] < 16))
+        {
+            frame->bits[i]++;
+            bitcount++;
+        }
+        else if ((frame->bitneed[i] == bitslice + 1) && (bitpool - bitcount >= 2))
+        {
+            frame->bits[i] = 2;
+            bitcount += 2;
+        }
+    }
+    for (n = 0; (n < count) && (bitcount < bitpool); n++)
+    {
+        i = first + (stride ? ((n >> 1) + (n & 1) * stride) : n);
+        if (frame->bits[i] < 16)
+        {
+            frame->bits[i]++;
+            bitcount++;
+        }
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/**
+ * \brief Add nbits (at most 8) of data to the CRC, as $sbc.crc_calc.
+ */
+void sbc_host_crc_calc(sbc_host_frame *frame, unsigned nbits, uint32_t data)
+{
+    uint32_t crc = frame->crc_checksum;
+    uint32_t shifted = kal_lshift(data, 8 - (int)nbits);
+    unsigned i;
+
+    for (i = 0; i < nbits; i++)
+    {
+        uint32_t temp = (shifted ^ crc) & 0x80;
+
+        crc <<= 1;
+        if (temp)
+        {
+            crc ^= SBC_HOST_CRC_GENPOLY;
+        }
+        shifted <<= 1;
+    }
+    frame->crc_checksum = crc;
+}
+
+/**
+ * \brief Calculate bits from the scale factors, as $sbc.calc_bit_allocation.
+ */
+void sbc_host_calc_bit_allocation(sbc_host_frame *frame)
+{
+    unsigned m = frame->params.nrof_subbands;
+    unsigned ch;
+
+    if (frame->params.channel_mode & SBC_HOST_STEREO)
+    {
+        calc_bitneed(frame, 0, 2 * m);
+        allocate_bits(frame, 0, 2 * m, m);
+    }
+    else
+    {
+        for (ch = 0; ch < frame->nrof_channels; ch++)
+        {
+            calc_bitneed(frame, ch * m, m);
+            allocate_bits(frame, ch * m, m, 0);
+        }
+    }
+}
+
+unsigned sbc_host_frame_length(const sbc_host_frame *frame)
+{
+    const sbc_host_params *params = &frame->params;
+    unsigned m = params->nrof_subbands;
+    unsigned length = 4 + 1 + ((m * frame->nrof_channels) >> 1);
+    unsigned bits = params->nrof_blocks * params->bitpool;
+
+    if (params->channel_mode >= SBC_HOST_STEREO)
+    {
+        bits += (params->channel_mode - SBC_HOST_STEREO) * m;
+    }
+    else
+    {
+        bits *= frame->nrof_channels;
+    }
+
+    /* ceil(bits / 8) = (bits - 1) / 8 + 1 */
+    return length + ((bits - 1) >> 3);
+}
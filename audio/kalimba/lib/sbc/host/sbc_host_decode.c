@@ -0,0 +1,300 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_decode.c
+ * \ingroup sbc
+ *
+ * Host port of the SBC decoder: frame_decode.asm, find_sync.asm,
+ * read_frame_header.asm, the read_ and getbits functions,
+ * sample_reconstruction.asm and joint_stereo_decode.asm.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "sbc_host_private.h"
+
+/****************************************************************************
+Private Type Declarations
+*/
+
+/** Reads bits most significant first from a byte buffer */
+typedef struct
+{
+    const uint8_t *data;
+    unsigned bitpos;
+} bit_reader;
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Read nbits (at most 16), as $sbcdec.getbits */
+static uint32_t getbits(bit_reader *reader, unsigned nbits)
+{
+    uint32_t value = 0;
+    unsigned i;
+
+    for (i = 0; i < nbits; i++)
+    {
+        unsigned bitpos = reader->bitpos++;
+
+        value = (value << 1) | ((reader->data[bitpos >> 3] >> (7 - (bitpos & 7))) & 1);
+    }
+    return value;
+}
+
+/* Read nbits and add them to the CRC */
+static uint32_t getbits_crc(sbc_host_decoder *dec, bit_reader *reader, unsigned nbits)
+{
+    uint32_t value = getbits(reader, nbits);
+
+    sbc_host_crc_calc(&dec->frame, nbits, value);
+    return value;
+}
+
+/* Bytes of the frame read so far */
+static unsigned bytes_read(const bit_reader *reader)
+{
+    return (reader->bitpos + 7) >> 3;
+}
+
+/* Reset the synthesis history, as $sbcdec.silence_decoder */
+static void silence_decoder(sbc_host_decoder *dec)
+{
+    unsigned ch;
+
+    for (ch = 0; ch < SBC_HOST_MAX_CHANNELS; ch++)
+    {
+        sbc_host_synthesis_reset(&dec->synthesis[ch]);
+    }
+}
+
+/* Read and check the frame header, as $sbcdec.read_frame_header.
+   Returns zero if the header is corrupt. */
+static int read_frame_header(sbc_host_decoder *dec, bit_reader *reader)
+{
+    sbc_host_frame *frame = &dec->frame;
+    sbc_host_params *params = &frame->params;
+    unsigned nrof_subbands, max_bitpool, i;
+
+    getbits(reader, 8);
+    frame->crc_checksum = 0x0f;
+    params->sampling_freq = getbits_crc(dec, reader, 2);
+    params->nrof_blocks = getbits_crc(dec, reader, 2) * 4 + 4;
+    params->channel_mode = getbits_crc(dec, reader, 2);
+    frame->nrof_channels = params->channel_mode ? 2 : 1;
+    params->allocation_method = getbits_crc(dec, reader, 1);
+    nrof_subbands = getbits_crc(dec, reader, 1) * 4 + 4;
+
+    /* the filterbank history is meaningless at a new number of subbands */
+    if (nrof_subbands != params->nrof_subbands)
+    {
+        silence_decoder(dec);
+    }
+    params->nrof_subbands = nrof_subbands;
+
+    params->bitpool = getbits_crc(dec, reader, 8);
+    max_bitpool = 16 * nrof_subbands;
+    if (params->channel_mode >= SBC_HOST_STEREO)
+    {
+        max_bitpool *= 2;
+    }
+    if (max_bitpool > 250)
+    {
+        max_bitpool = 250;
+    }
+    if ((params->bitpool > max_bitpool) || (params->bitpool < 2))
+    {
+        return 0;
+    }
+
+    dec->framecrc = getbits(reader, 8);
+
+    if (params->channel_mode == SBC_HOST_JOINT_STEREO)
+    {
+        for (i = 0; i < nrof_subbands - 1; i++)
+        {
+            frame->join[i] = (int)getbits_crc(dec, reader, 1);
+        }
+        frame->join[nrof_subbands - 1] = 0;
+
+        /* RFA bit */
+        getbits_crc(dec, reader, 1);
+    }
+
+    dec->cur_frame_length = sbc_host_frame_length(frame);
+    return 1;
+}
+
+/* Dequantize the samples in place, as $sbcdec.sample_reconstruction */
+static void sample_reconstruction(sbc_host_frame *frame)
+{
+    unsigned stride = frame->nrof_channels * frame->params.nrof_subbands;
+    unsigned i, blk;
+
+    for (i = 0; i < stride; i++)
+    {
+        int bits = frame->bits[i];
+        int shift = frame->scale_factor[i] + 1;
+        int64_t offset = (int64_t)0x8000 << shift;
+        uint32_t levelrecip;
+
+        if (bits == 0)
+        {
+            for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+            {
+                frame->audio_sample[blk * stride + i] = 0;
+            }
+            continue;
+        }
+
+        /* the library reads levelrecip_coefs[bits - 2]; with one bit, which
+           calc_bit_allocation can give, that is the word before the table,
+           the all ones level reciprocal of 1/(2^1 - 1) */
+        levelrecip = (bits >= 2) ? sbc_levelrecip_coefs[bits - 2] : 0xFFFFFFFFu;
+        shift -= bits;
+
+        for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+        {
+            int32_t *sample = &frame->audio_sample[blk * stride + i];
+            uint32_t level = ((uint32_t)*sample << 16) + 0x8000;
+            unsigned __int128 product = (unsigned __int128)((uint64_t)level * levelrecip) << 1;
+            int32_t value;
+
+            product = (shift >= 0) ? (product << shift) : (product >> -shift);
+            value = (int32_t)(uint32_t)(product >> 32);
+            *sample = kal_sat32((int64_t)value - offset);
+        }
+    }
+}
+
+/* Turn mid/side subbands back into left/right, as
+   $sbcdec.joint_stereo_decode */
+static void joint_stereo_decode(sbc_host_frame *frame)
+{
+    unsigned m = frame->params.nrof_subbands;
+    unsigned blk, sb;
+
+    for (sb = 0; sb < m; sb++)
+    {
+        if (!frame->join[sb])
+        {
+            continue;
+        }
+        for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+        {
+            int32_t *sample = &frame->audio_sample[blk * 2 * m + sb];
+            int64_t mid = sample[0];
+            int64_t side = sample[m];
+
+            sample[0] = kal_sat32(mid + side);
+            sample[m] = kal_sat32(mid - side);
+        }
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void sbc_host_decoder_init(sbc_host_decoder *dec, int use_simd)
+{
+    sbc_host_filter_init();
+    memset(dec, 0, sizeof(*dec));
+    silence_decoder(dec);
+    dec->use_simd = use_simd;
+}
+
+int sbc_host_decode_frame(sbc_host_decoder *dec, const uint8_t *data, unsigned length,
+                          unsigned *consumed, int32_t *left, int32_t *right)
+{
+    sbc_host_frame *frame = &dec->frame;
+    unsigned stride, m, blk, i;
+    unsigned sync = 0;
+    bit_reader reader;
+
+    /* find_sync: the sync byte must leave room for the rest of a minimum
+       sized frame */
+    while ((sync + 2 < length) && (data[sync] != SBC_HOST_SYNC_WORD))
+    {
+        sync++;
+    }
+    if (sync + 2 >= length)
+    {
+        *consumed = (length > 2) ? length - 2 : 0;
+        return SBC_HOST_NOT_ENOUGH_INPUT_DATA;
+    }
+    if (length - sync < SBC_HOST_MIN_SBC_FRAME_SIZE_IN_BYTES + 2)
+    {
+        *consumed = sync;
+        return SBC_HOST_NOT_ENOUGH_INPUT_DATA;
+    }
+
+    reader.data = &data[sync];
+    reader.bitpos = 0;
+    if (!read_frame_header(dec, &reader))
+    {
+        *consumed = sync + bytes_read(&reader);
+        return SBC_HOST_FRAME_CORRUPT;
+    }
+    if (dec->cur_frame_length > length - sync)
+    {
+        *consumed = sync;
+        return SBC_HOST_NOT_ENOUGH_INPUT_DATA;
+    }
+
+    /* read_scale_factors, then check the CRC */
+    m = frame->params.nrof_subbands;
+    stride = frame->nrof_channels * m;
+    for (i = 0; i < stride; i++)
+    {
+        frame->scale_factor[i] = (int)getbits_crc(dec, &reader, 4);
+    }
+    if ((dec->framecrc - frame->crc_checksum) & 0xff)
+    {
+        *consumed = sync + bytes_read(&reader);
+        return SBC_HOST_FRAME_CORRUPT;
+    }
+
+    sbc_host_calc_bit_allocation(frame);
+
+    /* read_audio_samples and read_padding_bits */
+    for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+    {
+        for (i = 0; i < stride; i++)
+        {
+            frame->audio_sample[blk * stride + i] =
+                frame->bits[i] ? (int32_t)getbits(&reader, (unsigned)frame->bits[i]) : 0;
+        }
+    }
+    *consumed = sync + bytes_read(&reader);
+
+    sample_reconstruction(frame);
+    if (frame->params.channel_mode == SBC_HOST_JOINT_STEREO)
+    {
+        joint_stereo_decode(frame);
+    }
+
+    /* synthesis of each wanted output. Mono frames feed both outputs from
+       the one channel, each with its own filterbank history. */
+    for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+    {
+        const int32_t *block = &frame->audio_sample[blk * stride];
+
+        if (left != NULL)
+        {
+            sbc_host_synthesis_block(&dec->synthesis[0], m, block, &left[blk * m], dec->use_simd);
+        }
+        if (right != NULL)
+        {
+            sbc_host_synthesis_block(&dec->synthesis[1], m, &block[(frame->nrof_channels == 2) ? m : 0],
+                                     &right[blk * m], dec->use_simd);
+        }
+    }
+
+    return (int)(frame->params.nrof_blocks * m);
+}
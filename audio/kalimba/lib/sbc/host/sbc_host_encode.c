@@ -0,0 +1,329 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_encode.c
+ * \ingroup sbc
+ *
+ * Host port of the SBC encoder: frame_encode.asm, joint_stereo_encode.asm,
+ * calc_scale_factors.asm, quantize_samples.asm and the write_ and putbits
+ * functions of the library.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+#include "sbc_host_private.h"
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/* Write nbits of value to the stream, as $sbcenc.putbits. The stream is
+   built up in 16 bit words which are output most significant byte first. */
+static void putbits(sbc_host_encoder *enc, unsigned nbits, uint32_t value, uint8_t *out, unsigned *written)
+{
+    int bitpos = enc->put_bitpos - (int)nbits;
+
+    if (bitpos > 0)
+    {
+        enc->put_nextword += value << bitpos;
+        enc->put_bitpos = bitpos;
+    }
+    else
+    {
+        uint32_t word = (kal_lshift(value, bitpos) + enc->put_nextword) & 0xffff;
+
+        out[(*written)++] = (uint8_t)(word >> 8);
+        out[(*written)++] = (uint8_t)word;
+        enc->put_nextword = value << (bitpos + 16);
+        enc->put_bitpos = bitpos + 16;
+    }
+}
+
+/* Write nbits of value to the stream and add them to the CRC */
+static void putbits_crc(sbc_host_encoder *enc, unsigned nbits, uint32_t value, uint8_t *out, unsigned *written)
+{
+    putbits(enc, nbits, value, out, written);
+    sbc_host_crc_calc(&enc->frame, nbits, value);
+}
+
+/* Scale factors of each channel and subband of a frame of samples, as
+   $sbcenc.calc_scale_factors */
+static void calc_scale_factors(const sbc_host_frame *frame, const int32_t *audio_sample, int *scale_factor)
+{
+    unsigned stride = frame->nrof_channels * frame->params.nrof_subbands;
+    unsigned i, blk;
+
+    for (i = 0; i < stride; i++)
+    {
+        int min_signdet = 16;
+
+        for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+        {
+            int signdet = kal_signdet(audio_sample[blk * stride + i]);
+
+            if (signdet < min_signdet)
+            {
+                min_signdet = signdet;
+            }
+        }
+        scale_factor[i] = 16 - min_signdet;
+    }
+}
+
+/* Choose between left/right and mid/side coding for each subband, as
+   $sbcenc.joint_stereo_encode */
+static void joint_stereo_encode(sbc_host_encoder *enc)
+{
+    sbc_host_frame *frame = &enc->frame;
+    unsigned m = frame->params.nrof_subbands;
+    unsigned blocks = frame->params.nrof_blocks;
+    unsigned blk, sb;
+
+    for (blk = 0; blk < blocks; blk++)
+    {
+        const int32_t *in = &frame->audio_sample[blk * 2 * m];
+        int32_t *out = &enc->audio_sample_js[blk * 2 * m];
+
+        for (sb = 0; sb < m; sb++)
+        {
+            kal_rmac acc = KAL_MAC(in[sb], 0x40000000) + KAL_MAC(in[m + sb], 0x40000000);
+
+            out[sb] = kal_rmac_store(acc);
+            out[m + sb] = kal_rmac_store(acc - KAL_MAC(in[m + sb], INT32_MAX));
+        }
+    }
+    calc_scale_factors(frame, enc->audio_sample_js, enc->scale_factor_js);
+
+    /* use mid/side when it needs fewer scale factor bits. The last
+       subband is always coded left/right. */
+    for (sb = 0; sb < m - 1; sb++)
+    {
+        frame->join[sb] = (enc->scale_factor_js[sb] + enc->scale_factor_js[m + sb]
+                           - frame->scale_factor[sb] - frame->scale_factor[m + sb]) < 0;
+    }
+    frame->join[m - 1] = 0;
+
+    for (sb = 0; sb < m; sb++)
+    {
+        if (frame->join[sb])
+        {
+            for (blk = 0; blk < blocks; blk++)
+            {
+                frame->audio_sample[blk * 2 * m + sb] = enc->audio_sample_js[blk * 2 * m + sb];
+                frame->audio_sample[blk * 2 * m + m + sb] = enc->audio_sample_js[blk * 2 * m + m + sb];
+            }
+            frame->scale_factor[sb] = enc->scale_factor_js[sb];
+            frame->scale_factor[m + sb] = enc->scale_factor_js[m + sb];
+        }
+    }
+}
+
+/* Header, join flags and CRC, as $sbcenc.write_frame_header. The CRC
+   covers the scale factors, which are written next. */
+static void write_frame_header(sbc_host_encoder *enc, uint8_t *out, unsigned *written)
+{
+    sbc_host_frame *frame = &enc->frame;
+    const sbc_host_params *params = &frame->params;
+    unsigned m = params->nrof_subbands;
+    unsigned i;
+
+    frame->crc_checksum = 0x0f;
+    putbits(enc, 8, SBC_HOST_SYNC_WORD, out, written);
+    putbits_crc(enc, 2, params->sampling_freq, out, written);
+    putbits_crc(enc, 2, (params->nrof_blocks >> 2) - 1, out, written);
+    putbits_crc(enc, 2, params->channel_mode, out, written);
+    putbits_crc(enc, 1, params->allocation_method, out, written);
+    putbits_crc(enc, 1, (m >> 2) - 1, out, written);
+    putbits_crc(enc, 8, params->bitpool, out, written);
+
+    if (params->channel_mode == SBC_HOST_JOINT_STEREO)
+    {
+        for (i = 0; i < m; i++)
+        {
+            sbc_host_crc_calc(frame, 1, (uint32_t)frame->join[i]);
+        }
+    }
+    for (i = 0; i < frame->nrof_channels * m; i++)
+    {
+        sbc_host_crc_calc(frame, 4, (uint32_t)frame->scale_factor[i]);
+    }
+    putbits(enc, 8, frame->crc_checksum & 0xff, out, written);
+
+    if (params->channel_mode == SBC_HOST_JOINT_STEREO)
+    {
+        for (i = 0; i < m; i++)
+        {
+            putbits(enc, 1, (uint32_t)frame->join[i], out, written);
+        }
+    }
+}
+
+/* Quantize the samples in place, as $sbcenc.quantize_samples */
+static void quantize_samples(sbc_host_frame *frame)
+{
+    unsigned stride = frame->nrof_channels * frame->params.nrof_subbands;
+    unsigned i, blk;
+
+    for (i = 0; i < stride; i++)
+    {
+        int bits = frame->bits[i];
+        int scale_factor = frame->scale_factor[i];
+        uint32_t offset = 0x8000u << scale_factor;
+
+        for (blk = 0; blk < frame->params.nrof_blocks; blk++)
+        {
+            int32_t *sample = &frame->audio_sample[blk * stride + i];
+
+            if (bits == 0)
+            {
+                *sample = 0;
+            }
+            else
+            {
+                /* the add wraps as the DSP's does */
+                int32_t level = (int32_t)((uint32_t)*sample + offset);
+
+                *sample = kal_rmac_store(KAL_MAC(level, sbc_level_coefs[bits - 1]) >> scale_factor);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+void sbc_host_encoder_init(sbc_host_encoder *enc, const sbc_host_params *params, int use_simd)
+{
+    unsigned ch;
+
+    sbc_host_filter_init();
+    memset(enc, 0, sizeof(*enc));
+    enc->frame.params = *params;
+    for (ch = 0; ch < SBC_HOST_MAX_CHANNELS; ch++)
+    {
+        sbc_host_analysis_reset(&enc->analysis[ch]);
+    }
+    enc->put_nextword = 0;
+    enc->put_bitpos = 16;
+    enc->use_simd = use_simd;
+}
+
+unsigned sbc_host_encode_frame(sbc_host_encoder *enc, const int32_t *left, const int32_t *right, uint8_t *out)
+{
+    sbc_host_frame *frame = &enc->frame;
+    const sbc_host_params *params = &frame->params;
+    unsigned m = params->nrof_subbands;
+    unsigned blocks = params->nrof_blocks;
+    unsigned written = 0;
+    unsigned ch, blk, i;
+
+    /* encoder_set_parameters */
+    frame->nrof_channels = (params->channel_mode == SBC_HOST_MONO) ? 1 : 2;
+
+    for (ch = 0; ch < SBC_HOST_MAX_CHANNELS; ch++)
+    {
+        const int32_t *in = ch ? right : left;
+        const int32_t *other = ch ? left : right;
+        unsigned interleave, base;
+
+        if (in == NULL)
+        {
+            continue;
+        }
+
+        /* a channel is written interleaved with the other one if the frame
+           has two channels or there is a second input to mix in */
+        interleave = ((frame->nrof_channels == 2) || (other != NULL)) ? m : 0;
+        base = interleave ? ch * m : 0;
+        for (blk = 0; blk < blocks; blk++)
+        {
+            sbc_host_analysis_block(&enc->analysis[ch], m, &in[blk * m],
+                                    &frame->audio_sample[base + blk * (m + interleave)], enc->use_simd);
+        }
+
+        /* one input to a two channel frame: copy the subband samples of
+           channel 0 to channel 1, as the library does */
+        if ((frame->nrof_channels == 2) && (other == NULL))
+        {
+            for (blk = 0; blk < blocks; blk++)
+            {
+                memcpy(&frame->audio_sample[blk * 2 * m + m], &frame->audio_sample[blk * 2 * m],
+                       m * sizeof(int32_t));
+            }
+        }
+    }
+
+    /* two inputs to a mono frame: mix them at half amplitude */
+    if ((frame->nrof_channels == 1) && (left != NULL) && (right != NULL))
+    {
+        for (blk = 0; blk < blocks; blk++)
+        {
+            for (i = 0; i < m; i++)
+            {
+                int32_t l = frame->audio_sample[blk * 2 * m + i];
+                int32_t r = frame->audio_sample[blk * 2 * m + m + i];
+
+                frame->audio_sample[blk * m + i] = (int32_t)((uint32_t)kal_frac_mult(l, 0x40000000)
+                                                             + (uint32_t)kal_frac_mult(r, 0x40000000));
+            }
+        }
+    }
+
+    calc_scale_factors(frame, frame->audio_sample, frame->scale_factor);
+    if (params->channel_mode == SBC_HOST_JOINT_STEREO)
+    {
+        joint_stereo_encode(enc);
+    }
+
+    write_frame_header(enc, out, &written);
+    for (i = 0; i < frame->nrof_channels * m; i++)
+    {
+        putbits(enc, 4, (uint32_t)frame->scale_factor[i], out, &written);
+    }
+
+    sbc_host_calc_bit_allocation(frame);
+    quantize_samples(frame);
+
+    for (blk = 0; blk < blocks; blk++)
+    {
+        for (i = 0; i < frame->nrof_channels * m; i++)
+        {
+            if (frame->bits[i])
+            {
+                putbits(enc, (unsigned)frame->bits[i],
+                        (uint32_t)frame->audio_sample[blk * frame->nrof_channels * m + i], out, &written);
+            }
+        }
+    }
+
+    /* write_padding_bits */
+    i = (unsigned)enc->put_bitpos & ((params->force_word_align << 3) | 7);
+    if (i)
+    {
+        putbits(enc, i, 0, out, &written);
+    }
+
+    return written;
+}
+
+unsigned sbc_host_encoder_flush(sbc_host_encoder *enc, uint8_t *out)
+{
+    unsigned written = 0;
+
+    if (enc->put_bitpos < 16)
+    {
+        out[written++] = (uint8_t)(enc->put_nextword >> 8);
+        if (enc->put_bitpos < 8)
+        {
+            out[written++] = (uint8_t)enc->put_nextword;
+        }
+    }
+    enc->put_nextword = 0;
+    enc->put_bitpos = 16;
+    return written;
+}
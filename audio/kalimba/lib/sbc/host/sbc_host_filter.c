@@ -0,0 +1,461 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_filter.c
+ * \ingroup sbc
+ *
+ * Polyphase analysis and synthesis filterbanks of the host SBC port, as
+ * analysis_subband_filter.asm and synthesis_subband_filter.asm.
+ *
+ * Each output is a sum of 32 x 32 bit fractional products accumulated in
+ * rMAC and then stored. The SIMD versions keep one 64 bit sum of the
+ * integer products per output lane. Integer addition does not depend on
+ * the order, so the SIMD sum equals the rMAC sum as long as it can not
+ * overflow 64 bits. That is checked for every block from the largest input
+ * magnitude and the largest sum of coefficient magnitudes of an output;
+ * blocks that could overflow use the scalar 128 bit version instead.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include <string.h>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define SBC_HOST_SSE4_1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SBC_HOST_NEON
+#endif
+
+#include "sbc_host_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define MAX_TAPS    10
+
+/****************************************************************************
+Private Variable Definitions
+*/
+
+/* The analysis and synthesis matrices transposed, so that the outputs of a
+   block are adjacent: analysis [t][i] of 2M x M, synthesis [i][k] of
+   M x 2M. Index 0 is for M = 4, index 1 for M = 8. */
+static int32_t analysis_coefs_t[2][128];
+static int32_t synthesis_coefs_t[2][128];
+
+/* Largest input magnitude for which the 64 bit sums can not overflow */
+static uint32_t analysis_matrix_limit[2];
+static uint32_t synthesis_matrix_limit[2];
+static uint32_t synthesis_window_limit[2];
+
+static int filter_initialised;
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+static uint32_t magnitude(int32_t value)
+{
+    return (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+}
+
+/* Input limit for outputs whose coefficient magnitudes sum to at most
+   coef_sum. The sum of products plus the rounding constant must fit in
+   64 bits. */
+static uint32_t input_limit(uint64_t coef_sum)
+{
+    uint64_t limit = ((uint64_t)INT64_MAX - (1u << 30)) / coef_sum;
+
+    return (limit > 0x80000000u) ? 0x80000000u : (uint32_t)limit;
+}
+
+/* Largest sum over taps of |coef[k * stride + i]| for i < n */
+static uint64_t max_coef_sum(const int32_t *coef, unsigned taps, unsigned stride, unsigned n)
+{
+    uint64_t largest = 1;
+    unsigned i, k;
+
+    for (i = 0; i < n; i++)
+    {
+        uint64_t sum = 0;
+
+        for (k = 0; k < taps; k++)
+        {
+            sum += magnitude(coef[k * stride + i]);
+        }
+        if (sum > largest)
+        {
+            largest = sum;
+        }
+    }
+    return largest;
+}
+
+static void filter_init_m(unsigned index, unsigned m)
+{
+    const int32_t *win = index ? sbc_win_coefs_m8 : sbc_win_coefs_m4;
+    const int32_t *analysis = index ? sbc_analysis_coefs_m8 : sbc_analysis_coefs_m4;
+    const int32_t *synthesis = index ? sbc_synthesis_coefs_m8 : sbc_synthesis_coefs_m4;
+    unsigned i, t;
+
+    for (i = 0; i < m; i++)
+    {
+        for (t = 0; t < 2 * m; t++)
+        {
+            analysis_coefs_t[index][t * m + i] = analysis[i * 2 * m + t];
+            synthesis_coefs_t[index][i * 2 * m + t] = synthesis[t * m + i];
+        }
+    }
+
+    analysis_matrix_limit[index] = input_limit(max_coef_sum(analysis_coefs_t[index], 2 * m, m, m));
+    synthesis_matrix_limit[index] = input_limit(max_coef_sum(synthesis_coefs_t[index], m, 2 * m, 2 * m));
+    synthesis_window_limit[index] = input_limit(max_coef_sum(win, 10, m, m));
+}
+
+/* Round a 64 bit sum of integer products as rMAC holding twice the sum */
+static inline int32_t store_sum(int64_t sum)
+{
+    return kal_sat32((sum + (1 << 30)) >> 31);
+}
+
+/* out[i] = sum over k of a[k][i] * b[k][i], for n outputs */
+static void mac_columns_scalar(const int32_t *const *a, const int32_t *const *b,
+                               unsigned taps, unsigned n, int32_t *out)
+{
+    unsigned i, k;
+
+    for (i = 0; i < n; i++)
+    {
+        kal_rmac acc = 0;
+
+        for (k = 0; k < taps; k++)
+        {
+            acc += KAL_MAC(a[k][i], b[k][i]);
+        }
+        out[i] = kal_rmac_store(acc);
+    }
+}
+
+/* out[i] = sum over t of y[t] * c[t * n + i], for n outputs */
+static void mac_matrix_scalar(const int32_t *y, const int32_t *c,
+                              unsigned taps, unsigned n, int32_t *out)
+{
+    unsigned i, t;
+
+    for (i = 0; i < n; i++)
+    {
+        kal_rmac acc = 0;
+
+        for (t = 0; t < taps; t++)
+        {
+            acc += KAL_MAC(y[t], c[t * n + i]);
+        }
+        out[i] = kal_rmac_store(acc);
+    }
+}
+
+#if defined(SBC_HOST_SSE4_1)
+
+/* _mm_mul_epi32 multiplies the even 32 bit lanes to 64 bits, so the even
+   and odd outputs are accumulated separately. */
+static inline void store_lanes(__m128i even, __m128i odd, int32_t *out)
+{
+    int64_t e[2], o[2];
+
+    _mm_storeu_si128((__m128i *)e, even);
+    _mm_storeu_si128((__m128i *)o, odd);
+    out[0] = store_sum(e[0]);
+    out[1] = store_sum(o[0]);
+    out[2] = store_sum(e[1]);
+    out[3] = store_sum(o[1]);
+}
+
+static void mac_columns_simd(const int32_t *const *a, const int32_t *const *b,
+                             unsigned taps, unsigned n, int32_t *out)
+{
+    unsigned i, k;
+
+    for (i = 0; i < n; i += 4)
+    {
+        __m128i even = _mm_setzero_si128();
+        __m128i odd = _mm_setzero_si128();
+
+        for (k = 0; k < taps; k++)
+        {
+            __m128i x = _mm_loadu_si128((const __m128i *)&a[k][i]);
+            __m128i y = _mm_loadu_si128((const __m128i *)&b[k][i]);
+
+            even = _mm_add_epi64(even, _mm_mul_epi32(x, y));
+            odd = _mm_add_epi64(odd, _mm_mul_epi32(_mm_srli_epi64(x, 32),
+                                                   _mm_srli_epi64(y, 32)));
+        }
+        store_lanes(even, odd, &out[i]);
+    }
+}
+
+static void mac_matrix_simd(const int32_t *y, const int32_t *c,
+                            unsigned taps, unsigned n, int32_t *out)
+{
+    unsigned i, t;
+
+    for (i = 0; i < n; i += 4)
+    {
+        __m128i even = _mm_setzero_si128();
+        __m128i odd = _mm_setzero_si128();
+
+        for (t = 0; t < taps; t++)
+        {
+            __m128i x = _mm_set1_epi32(y[t]);
+            __m128i z = _mm_loadu_si128((const __m128i *)&c[t * n + i]);
+
+            even = _mm_add_epi64(even, _mm_mul_epi32(x, z));
+            odd = _mm_add_epi64(odd, _mm_mul_epi32(x, _mm_srli_epi64(z, 32)));
+        }
+        store_lanes(even, odd, &out[i]);
+    }
+}
+
+#elif defined(SBC_HOST_NEON)
+
+/* vrshrq_n_s64 adds the rounding constant before shifting and vqmovn_s64
+   saturates, which is the rMAC store of twice the sum. */
+static inline void store_lanes(int64x2_t low, int64x2_t high, int32_t *out)
+{
+    vst1q_s32(out, vcombine_s32(vqmovn_s64(vrshrq_n_s64(low, 31)),
+                                vqmovn_s64(vrshrq_n_s64(high, 31))));
+}
+
+static void mac_columns_simd(const int32_t *const *a, const int32_t *const *b,
+                             unsigned taps, unsigned n, int32_t *out)
+{
+    unsigned i, k;
+
+    for (i = 0; i < n; i += 4)
+    {
+        int64x2_t low = vdupq_n_s64(0);
+        int64x2_t high = vdupq_n_s64(0);
+
+        for (k = 0; k < taps; k++)
+        {
+            int32x4_t x = vld1q_s32(&a[k][i]);
+            int32x4_t y = vld1q_s32(&b[k][i]);
+
+            low = vmlal_s32(low, vget_low_s32(x), vget_low_s32(y));
+            high = vmlal_s32(high, vget_high_s32(x), vget_high_s32(y));
+        }
+        store_lanes(low, high, &out[i]);
+    }
+}
+
+static void mac_matrix_simd(const int32_t *y, const int32_t *c,
+                            unsigned taps, unsigned n, int32_t *out)
+{
+    unsigned i, t;
+
+    for (i = 0; i < n; i += 4)
+    {
+        int64x2_t low = vdupq_n_s64(0);
+        int64x2_t high = vdupq_n_s64(0);
+
+        for (t = 0; t < taps; t++)
+        {
+            int32x2_t x = vdup_n_s32(y[t]);
+            int32x4_t z = vld1q_s32(&c[t * n + i]);
+
+            low = vmlal_s32(low, x, vget_low_s32(z));
+            high = vmlal_s32(high, x, vget_high_s32(z));
+        }
+        store_lanes(low, high, &out[i]);
+    }
+}
+
+#else
+
+#define mac_columns_simd mac_columns_scalar
+#define mac_matrix_simd mac_matrix_scalar
+
+#endif
+
+static uint32_t max_magnitude(const int32_t *data, unsigned n)
+{
+    uint32_t largest = 0;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        uint32_t value = magnitude(data[i]);
+
+        if (value > largest)
+        {
+            largest = value;
+        }
+    }
+    return largest;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/**
+ * \brief Build the transposed matrices and overflow limits, once.
+ */
+void sbc_host_filter_init(void)
+{
+    if (!filter_initialised)
+    {
+        filter_init_m(0, 4);
+        filter_init_m(1, 8);
+        filter_initialised = 1;
+    }
+}
+
+/**
+ * \brief Clear the analysis history of a channel, as reset_encoder.
+ */
+void sbc_host_analysis_reset(sbc_host_analysis *state)
+{
+    memset(state, 0, sizeof(*state));
+}
+
+/**
+ * \brief Analysis filter one block of one channel.
+ *
+ * \param state         The channel's history.
+ * \param nrof_subbands M, 4 or 8.
+ * \param in            M new input samples, oldest first.
+ * \param out           M subband samples.
+ * \param use_simd      Use the SIMD sums where they can not overflow.
+ */
+void sbc_host_analysis_block(sbc_host_analysis *state, unsigned nrof_subbands,
+                             const int32_t *in, int32_t *out, int use_simd)
+{
+    unsigned m = nrof_subbands;
+    unsigned index = (m == 8);
+    unsigned length = 10 * m;
+    int shift = (m == 8) ? 4 : 3;
+    unsigned pos = state->x_pos % length;
+    const int32_t *win = index ? sbc_win_coefs_m8 : sbc_win_coefs_m4;
+    const int32_t *a[5], *b[5];
+    int32_t y[2 * SBC_HOST_MAX_SUBBANDS];
+    unsigned i, k;
+
+    /* insert M new samples into the X ring buffer, newest at the lowest
+       address, and scale them */
+    for (i = 0; i < m; i++)
+    {
+        unsigned index_x = (pos + length - i) % length;
+        int32_t value = in[i] >> shift;
+
+        state->x[index_x] = value;
+        state->x[index_x + length] = value;
+    }
+    pos = (pos + length - m + 1) % length;
+
+    /* window the data: 2M partial sums of 5 products 2M apart. The scaled
+       samples are below 2^28 and 5 window coefficients sum to less than
+       5.0, so these sums always fit in 64 bits. */
+    for (k = 0; k < 5; k++)
+    {
+        a[k] = &state->x[pos + 2 * m * k];
+        b[k] = &win[2 * m * k];
+    }
+    if (use_simd)
+    {
+        mac_columns_simd(a, b, 5, 2 * m, y);
+    }
+    else
+    {
+        mac_columns_scalar(a, b, 5, 2 * m, y);
+    }
+
+    /* matrix the partial sums into M subband samples */
+    if (use_simd && (max_magnitude(y, 2 * m) <= analysis_matrix_limit[index]))
+    {
+        mac_matrix_simd(y, analysis_coefs_t[index], 2 * m, m, out);
+    }
+    else
+    {
+        mac_matrix_scalar(y, analysis_coefs_t[index], 2 * m, m, out);
+    }
+
+    state->x_pos = (pos + length - 1) % length;
+}
+
+/**
+ * \brief Clear the synthesis history of a channel, as silence_decoder.
+ */
+void sbc_host_synthesis_reset(sbc_host_synthesis *state)
+{
+    memset(state, 0, sizeof(*state));
+}
+
+/**
+ * \brief Synthesis filter one block of one channel.
+ *
+ * \param state         The channel's history.
+ * \param nrof_subbands M, 4 or 8.
+ * \param in            M subband samples.
+ * \param out           M output samples, oldest first.
+ * \param use_simd      Use the SIMD sums where they can not overflow.
+ */
+void sbc_host_synthesis_block(sbc_host_synthesis *state, unsigned nrof_subbands,
+                              const int32_t *in, int32_t *out, int use_simd)
+{
+    unsigned m = nrof_subbands;
+    unsigned index = (m == 8);
+    unsigned length = 20 * m;
+    unsigned pos = state->v_pos % length;
+    const int32_t *win = index ? sbc_win_coefs_m8 : sbc_win_coefs_m4;
+    const int32_t *a[MAX_TAPS], *b[MAX_TAPS];
+    int32_t v[2 * SBC_HOST_MAX_SUBBANDS];
+    int32_t sum[SBC_HOST_MAX_SUBBANDS];
+    uint32_t v_max = 0;
+    unsigned i, k;
+
+    /* matrix M subband samples into 2M new V samples */
+    if (use_simd && (max_magnitude(in, m) <= synthesis_matrix_limit[index]))
+    {
+        mac_matrix_simd(in, synthesis_coefs_t[index], m, 2 * m, v);
+    }
+    else
+    {
+        mac_matrix_scalar(in, synthesis_coefs_t[index], m, 2 * m, v);
+    }
+    memcpy(&state->v[pos], v, 2 * m * sizeof(int32_t));
+    memcpy(&state->v[pos + length], v, 2 * m * sizeof(int32_t));
+    state->v_max[pos / (2 * m)] = max_magnitude(v, 2 * m);
+
+    /* build U from V, window it and sum 10 products for each output:
+       V(0+n), V(3M+n), V(4M+n), V(7M+n), ... V(19M+n) */
+    for (k = 0; k < 10; k++)
+    {
+        a[k] = &state->v[pos + (k >> 1) * 4 * m + (k & 1) * 3 * m];
+        b[k] = &win[k * m];
+        if (state->v_max[k] > v_max)
+        {
+            v_max = state->v_max[k];
+        }
+    }
+    if (use_simd && (v_max <= synthesis_window_limit[index]))
+    {
+        mac_columns_simd(a, b, 10, m, sum);
+    }
+    else
+    {
+        mac_columns_scalar(a, b, 10, m, sum);
+    }
+
+    /* scale so that PCM data is between -1.0 and +1.0 */
+    for (i = 0; i < m; i++)
+    {
+        out[i] = kal_sat32((int64_t)sum[i] * -4);
+    }
+
+    state->v_pos = (pos + length - 2 * m) % length;
+}
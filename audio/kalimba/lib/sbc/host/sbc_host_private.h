@@ -0,0 +1,142 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_private.h
+ * \ingroup sbc
+ *
+ * Kalimba arch4 arithmetic used by the host SBC port. <br>
+ *
+ * rMAC is 72 bits, modelled with a 128 bit integer. A fractional multiply
+ * adds the product shifted left by one. Storing rMAC to memory, or using it
+ * as a 32 bit operand, takes bits 63..32 rounded on bit 31 and saturated.
+ * Every place that depends on this goes through the functions below.
+ */
+
+#ifndef SBC_HOST_PRIVATE_H
+#define SBC_HOST_PRIVATE_H
+
+/****************************************************************************
+Include Files
+*/
+#include "sbc_host.h"
+
+/****************************************************************************
+Private Type Declarations
+*/
+typedef __int128 kal_rmac;
+
+/****************************************************************************
+Private Constant Declarations
+*/
+#define SBC_HOST_SYNC_WORD              0x9C
+#define SBC_HOST_CRC_GENPOLY            0x1D
+#define SBC_HOST_MIN_SBC_FRAME_SIZE_IN_BYTES    20
+
+/****************************************************************************
+Private Macro Declarations
+*/
+
+/** rMAC (+)= a * b (frac) */
+#define KAL_MAC(a, b)       ((kal_rmac)((int64_t)(a) * (int64_t)(b)) * 2)
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/** Saturate to a data word */
+static inline int32_t kal_sat32(int64_t value)
+{
+    if (value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)value;
+}
+
+/** M[] = rMAC, rounded and saturated */
+static inline int32_t kal_rmac_store(kal_rmac acc)
+{
+    acc = (acc + ((kal_rmac)1 << 31)) >> 32;
+    if (acc > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (acc < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)acc;
+}
+
+/** r = a * b (frac) */
+static inline int32_t kal_frac_mult(int32_t a, int32_t b)
+{
+    return kal_rmac_store(KAL_MAC(a, b));
+}
+
+/** SIGNDET: the number of redundant sign bits */
+static inline int kal_signdet(int32_t value)
+{
+    uint32_t bits = (value < 0) ? ~(uint32_t)value : (uint32_t)value;
+    int count = 0;
+
+    if (bits == 0)
+    {
+        return 31;
+    }
+    while (!(bits & 0x40000000u))
+    {
+        bits <<= 1;
+        count++;
+    }
+    return count;
+}
+
+/** LSHIFT of a data word: left for positive shifts, logical right for
+ *  negative ones */
+static inline uint32_t kal_lshift(uint32_t value, int shift)
+{
+    if (shift >= 32 || shift <= -32)
+    {
+        return 0;
+    }
+    return (shift >= 0) ? (value << shift) : (value >> -shift);
+}
+
+/****************************************************************************
+Private Data Declarations
+*/
+extern const int32_t sbc_win_coefs_m4[40];
+extern const int32_t sbc_win_coefs_m8[80];
+extern const int32_t sbc_analysis_coefs_m4[32];
+extern const int32_t sbc_analysis_coefs_m8[128];
+extern const int32_t sbc_synthesis_coefs_m4[32];
+extern const int32_t sbc_synthesis_coefs_m8[128];
+extern const int32_t sbc_level_coefs[16];
+extern const uint32_t sbc_levelrecip_coefs[15];
+extern const int sbc_loudness_offset_m4[16];
+extern const int sbc_loudness_offset_m8[32];
+
+/****************************************************************************
+Private Function Declarations
+*/
+
+/* sbc_host_filter.c */
+extern void sbc_host_filter_init(void);
+extern void sbc_host_analysis_reset(sbc_host_analysis *state);
+extern void sbc_host_analysis_block(sbc_host_analysis *state, unsigned nrof_subbands,
+                                    const int32_t *in, int32_t *out, int use_simd);
+extern void sbc_host_synthesis_reset(sbc_host_synthesis *state);
+extern void sbc_host_synthesis_block(sbc_host_synthesis *state, unsigned nrof_subbands,
+                                     const int32_t *in, int32_t *out, int use_simd);
+
+/* sbc_host_common.c */
+extern void sbc_host_crc_calc(sbc_host_frame *frame, unsigned nbits, uint32_t data);
+extern void sbc_host_calc_bit_allocation(sbc_host_frame *frame);
+
+#endif /* SBC_HOST_PRIVATE_H */
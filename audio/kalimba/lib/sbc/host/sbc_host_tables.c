@@ -0,0 +1,198 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  sbc_host_tables.c
+ * \ingroup sbc
+ *
+ * Constant tables of the host SBC port. The fractional tables are the K32
+ * tables of global_variables_encdec.asm, global_variables_encoder.asm and
+ * global_variables_decoder.asm as assembled: value * 2^31 rounded to the
+ * nearest integer, with 1.0 saturated to 0x7FFFFFFF.
+ *
+ */
+
+/****************************************************************************
+Include Files
+*/
+#include "sbc_host_private.h"
+
+/****************************************************************************
+Public Constant Definitions
+*/
+
+/** subband prototype window for M = 4 */
+const int32_t sbc_win_coefs_m4[40] =
+{
+    (int32_t)0x00000000, (int32_t)0x002329CC, (int32_t)0x0061C5A7, (int32_t)0x00B32807,
+    (int32_t)0x00FB7991, (int32_t)0x00FF11CA, (int32_t)0x007A4737, (int32_t)0xFF3773A8,
+    (int32_t)0x02CB3E8B, (int32_t)0x053B7546, (int32_t)0x07646684, (int32_t)0x083DDC80,
+    (int32_t)0x069FDC59, (int32_t)0x0191E578, (int32_t)0xF89F23A7, (int32_t)0xEC1F5E6D,
+    (int32_t)0x22B63DA5, (int32_t)0x31EAB920, (int32_t)0x3F23948D, (int32_t)0x4825E4A3,
+    (int32_t)0x4B583FE6, (int32_t)0x4825E4A3, (int32_t)0x3F23948D, (int32_t)0x31EAB920,
+    (int32_t)0xDD49C25B, (int32_t)0xEC1F5E6D, (int32_t)0xF89F23A7, (int32_t)0x0191E578,
+    (int32_t)0x069FDC59, (int32_t)0x083DDC80, (int32_t)0x07646684, (int32_t)0x053B7546,
+    (int32_t)0xFD34C175, (int32_t)0xFF3773A8, (int32_t)0x007A4737, (int32_t)0x00FF11CA,
+    (int32_t)0x00FB7991, (int32_t)0x00B32807, (int32_t)0x0061C5A7, (int32_t)0x002329CC
+};
+
+/** subband prototype window for M = 8 */
+const int32_t sbc_win_coefs_m8[80] =
+{
+    (int32_t)0x00000000, (int32_t)0x001485CC, (int32_t)0x002CFDC6, (int32_t)0x0048B1F7,
+    (int32_t)0x006BFE27, (int32_t)0x0095698A, (int32_t)0x00C183D2, (int32_t)0x00E9CB9F,
+    (int32_t)0x0107B1A9, (int32_t)0x0113BD20, (int32_t)0x01056DD8, (int32_t)0x00D3E2D9,
+    (int32_t)0x00763F48, (int32_t)0xFFE8904A, (int32_t)0xFF27C437, (int32_t)0xFE359E4B,
+    (int32_t)0x02E5CD22, (int32_t)0x041C6E59, (int32_t)0x055ACF28, (int32_t)0x0686CE2E,
+    (int32_t)0x07808933, (int32_t)0x0824A47D, (int32_t)0x084E1950, (int32_t)0x07D7D091,
+    (int32_t)0x069FB3BF, (int32_t)0x0488FAE9, (int32_t)0x017F43FE, (int32_t)0xFD7BADC9,
+    (int32_t)0xF8810D70, (int32_t)0xF2A1B9F8, (int32_t)0xEBFE57F0, (int32_t)0xE4C4A240,
+    (int32_t)0x22D0C1EA, (int32_t)0x2A7CFA6A, (int32_t)0x31F566D9, (int32_t)0x38EEC5BD,
+    (int32_t)0x3F1C87E5, (int32_t)0x443B3BC0, (int32_t)0x4810D7EA, (int32_t)0x4A7089BC,
+    (int32_t)0x4B3DB1D6, (int32_t)0x4A7089BC, (int32_t)0x4810D7EA, (int32_t)0x443B3BC0,
+    (int32_t)0x3F1C87E5, (int32_t)0x38EEC5BD, (int32_t)0x31F566D9, (int32_t)0x2A7CFA6A,
+    (int32_t)0xDD2F3E16, (int32_t)0xE4C4A240, (int32_t)0xEBFE57F0, (int32_t)0xF2A1B9F8,
+    (int32_t)0xF8810D70, (int32_t)0xFD7BADC9, (int32_t)0x017F43FE, (int32_t)0x0488FAE9,
+    (int32_t)0x069FB3BF, (int32_t)0x07D7D091, (int32_t)0x084E1950, (int32_t)0x0824A47D,
+    (int32_t)0x07808933, (int32_t)0x0686CE2E, (int32_t)0x055ACF28, (int32_t)0x041C6E59,
+    (int32_t)0xFD1A32DE, (int32_t)0xFE359E4B, (int32_t)0xFF27C437, (int32_t)0xFFE8904A,
+    (int32_t)0x00763F48, (int32_t)0x00D3E2D9, (int32_t)0x01056DD8, (int32_t)0x0113BD20,
+    (int32_t)0x0107B1A9, (int32_t)0x00E9CB9F, (int32_t)0x00C183D2, (int32_t)0x0095698A,
+    (int32_t)0x006BFE27, (int32_t)0x0048B1F7, (int32_t)0x002CFDC6, (int32_t)0x001485CC
+};
+
+/** analysis subband filterbank matrix (4x8) for M = 4 */
+const int32_t sbc_analysis_coefs_m4[32] =
+{
+    (int32_t)0x5A82799A, (int32_t)0x7641AF3D, (int32_t)0x7FFFFFFF, (int32_t)0x7641AF3D,
+    (int32_t)0x5A82799A, (int32_t)0x30FBC54D, (int32_t)0x00000000, (int32_t)0xCF043AB3,
+    (int32_t)0xA57D8666, (int32_t)0x30FBC54D, (int32_t)0x7FFFFFFF, (int32_t)0x30FBC54D,
+    (int32_t)0xA57D8666, (int32_t)0x89BE50C3, (int32_t)0x00000000, (int32_t)0x7641AF3D,
+    (int32_t)0xA57D8666, (int32_t)0xCF043AB3, (int32_t)0x7FFFFFFF, (int32_t)0xCF043AB3,
+    (int32_t)0xA57D8666, (int32_t)0x7641AF3D, (int32_t)0x00000000, (int32_t)0x89BE50C3,
+    (int32_t)0x5A82799A, (int32_t)0x89BE50C3, (int32_t)0x7FFFFFFF, (int32_t)0x89BE50C3,
+    (int32_t)0x5A82799A, (int32_t)0xCF043AB3, (int32_t)0x00000000, (int32_t)0x30FBC54D
+};
+
+/** analysis subband filterbank matrix (8x16) for M = 8 */
+const int32_t sbc_analysis_coefs_m8[128] =
+{
+    (int32_t)0x5A82799A, (int32_t)0x6A6D98A4, (int32_t)0x7641AF3D, (int32_t)0x7D8A5F40,
+    (int32_t)0x7FFFFFFF, (int32_t)0x7D8A5F40, (int32_t)0x7641AF3D, (int32_t)0x6A6D98A4,
+    (int32_t)0x5A82799A, (int32_t)0x471CECE7, (int32_t)0x30FBC54D, (int32_t)0x18F8B83C,
+    (int32_t)0x00000000, (int32_t)0xE70747C4, (int32_t)0xCF043AB3, (int32_t)0xB8E31319,
+    (int32_t)0xA57D8666, (int32_t)0xE70747C4, (int32_t)0x30FBC54D, (int32_t)0x6A6D98A4,
+    (int32_t)0x7FFFFFFF, (int32_t)0x6A6D98A4, (int32_t)0x30FBC54D, (int32_t)0xE70747C4,
+    (int32_t)0xA57D8666, (int32_t)0x8275A0C0, (int32_t)0x89BE50C3, (int32_t)0xB8E31319,
+    (int32_t)0x00000000, (int32_t)0x471CECE7, (int32_t)0x7641AF3D, (int32_t)0x7D8A5F40,
+    (int32_t)0xA57D8666, (int32_t)0x8275A0C0, (int32_t)0xCF043AB3, (int32_t)0x471CECE7,
+    (int32_t)0x7FFFFFFF, (int32_t)0x471CECE7, (int32_t)0xCF043AB3, (int32_t)0x8275A0C0,
+    (int32_t)0xA57D8666, (int32_t)0x18F8B83C, (int32_t)0x7641AF3D, (int32_t)0x6A6D98A4,
+    (int32_t)0x00000000, (int32_t)0x9592675C, (int32_t)0x89BE50C3, (int32_t)0xE70747C4,
+    (int32_t)0x5A82799A, (int32_t)0xB8E31319, (int32_t)0x89BE50C3, (int32_t)0x18F8B83C,
+    (int32_t)0x7FFFFFFF, (int32_t)0x18F8B83C, (int32_t)0x89BE50C3, (int32_t)0xB8E31319,
+    (int32_t)0x5A82799A, (int32_t)0x6A6D98A4, (int32_t)0xCF043AB3, (int32_t)0x8275A0C0,
+    (int32_t)0x00000000, (int32_t)0x7D8A5F40, (int32_t)0x30FBC54D, (int32_t)0x9592675C,
+    (int32_t)0x5A82799A, (int32_t)0x471CECE7, (int32_t)0x89BE50C3, (int32_t)0xE70747C4,
+    (int32_t)0x7FFFFFFF, (int32_t)0xE70747C4, (int32_t)0x89BE50C3, (int32_t)0x471CECE7,
+    (int32_t)0x5A82799A, (int32_t)0x9592675C, (int32_t)0xCF043AB3, (int32_t)0x7D8A5F40,
+    (int32_t)0x00000000, (int32_t)0x8275A0C0, (int32_t)0x30FBC54D, (int32_t)0x6A6D98A4,
+    (int32_t)0xA57D8666, (int32_t)0x7D8A5F40, (int32_t)0xCF043AB3, (int32_t)0xB8E31319,
+    (int32_t)0x7FFFFFFF, (int32_t)0xB8E31319, (int32_t)0xCF043AB3, (int32_t)0x7D8A5F40,
+    (int32_t)0xA57D8666, (int32_t)0xE70747C4, (int32_t)0x7641AF3D, (int32_t)0x9592675C,
+    (int32_t)0x00000000, (int32_t)0x6A6D98A4, (int32_t)0x89BE50C3, (int32_t)0x18F8B83C,
+    (int32_t)0xA57D8666, (int32_t)0x18F8B83C, (int32_t)0x30FBC54D, (int32_t)0x9592675C,
+    (int32_t)0x7FFFFFFF, (int32_t)0x9592675C, (int32_t)0x30FBC54D, (int32_t)0x18F8B83C,
+    (int32_t)0xA57D8666, (int32_t)0x7D8A5F40, (int32_t)0x89BE50C3, (int32_t)0x471CECE7,
+    (int32_t)0x00000000, (int32_t)0xB8E31319, (int32_t)0x7641AF3D, (int32_t)0x8275A0C0,
+    (int32_t)0x5A82799A, (int32_t)0x9592675C, (int32_t)0x7641AF3D, (int32_t)0x8275A0C0,
+    (int32_t)0x7FFFFFFF, (int32_t)0x8275A0C0, (int32_t)0x7641AF3D, (int32_t)0x9592675C,
+    (int32_t)0x5A82799A, (int32_t)0xB8E31319, (int32_t)0x30FBC54D, (int32_t)0xE70747C4,
+    (int32_t)0x00000000, (int32_t)0x18F8B83C, (int32_t)0xCF043AB3, (int32_t)0x471CECE7
+};
+
+/** synthesis subband filterbank matrix (8x4) for M = 4 */
+const int32_t sbc_synthesis_coefs_m4[32] =
+{
+    (int32_t)0x5A82799A, (int32_t)0xA57D8666, (int32_t)0xA57D8666, (int32_t)0x5A82799A,
+    (int32_t)0x30FBC54D, (int32_t)0x89BE50C3, (int32_t)0x7641AF3D, (int32_t)0xCF043AB3,
+    (int32_t)0x00000000, (int32_t)0x00000000, (int32_t)0x00000000, (int32_t)0x00000000,
+    (int32_t)0xCF043AB3, (int32_t)0x7641AF3D, (int32_t)0x89BE50C3, (int32_t)0x30FBC54D,
+    (int32_t)0xA57D8666, (int32_t)0x5A82799A, (int32_t)0x5A82799A, (int32_t)0xA57D8666,
+    (int32_t)0x89BE50C3, (int32_t)0xCF043AB3, (int32_t)0x30FBC54D, (int32_t)0x7641AF3D,
+    (int32_t)0x80000000, (int32_t)0x80000000, (int32_t)0x80000000, (int32_t)0x80000000,
+    (int32_t)0x89BE50C3, (int32_t)0xCF043AB3, (int32_t)0x30FBC54D, (int32_t)0x7641AF3D
+};
+
+/** synthesis subband filterbank matrix (16x8) for M = 8 */
+const int32_t sbc_synthesis_coefs_m8[128] =
+{
+    (int32_t)0x5A82799A, (int32_t)0xA57D8666, (int32_t)0xA57D8666, (int32_t)0x5A82799A,
+    (int32_t)0x5A82799A, (int32_t)0xA57D8666, (int32_t)0xA57D8666, (int32_t)0x5A82799A,
+    (int32_t)0x471CECE7, (int32_t)0x8275A0C0, (int32_t)0x18F8B83C, (int32_t)0x6A6D98A4,
+    (int32_t)0x9592675C, (int32_t)0xE70747C4, (int32_t)0x7D8A5F40, (int32_t)0xB8E31319,
+    (int32_t)0x30FBC54D, (int32_t)0x89BE50C3, (int32_t)0x7641AF3D, (int32_t)0xCF043AB3,
+    (int32_t)0xCF043AB3, (int32_t)0x7641AF3D, (int32_t)0x89BE50C3, (int32_t)0x30FBC54D,
+    (int32_t)0x18F8B83C, (int32_t)0xB8E31319, (int32_t)0x6A6D98A4, (int32_t)0x8275A0C0,
+    (int32_t)0x7D8A5F40, (int32_t)0x9592675C, (int32_t)0x471CECE7, (int32_t)0xE70747C4,
+    (int32_t)0x00000000, (int32_t)0x00000000, (int32_t)0x00000000, (int32_t)0x00000000,
+    (int32_t)0x00000000, (int32_t)0x00000000, (int32_t)0x00000000, (int32_t)0x00000000,
+    (int32_t)0xE70747C4, (int32_t)0x471CECE7, (int32_t)0x9592675C, (int32_t)0x7D8A5F40,
+    (int32_t)0x8275A0C0, (int32_t)0x6A6D98A4, (int32_t)0xB8E31319, (int32_t)0x18F8B83C,
+    (int32_t)0xCF043AB3, (int32_t)0x7641AF3D, (int32_t)0x89BE50C3, (int32_t)0x30FBC54D,
+    (int32_t)0x30FBC54D, (int32_t)0x89BE50C3, (int32_t)0x7641AF3D, (int32_t)0xCF043AB3,
+    (int32_t)0xB8E31319, (int32_t)0x7D8A5F40, (int32_t)0xE70747C4, (int32_t)0x9592675C,
+    (int32_t)0x6A6D98A4, (int32_t)0x18F8B83C, (int32_t)0x8275A0C0, (int32_t)0x471CECE7,
+    (int32_t)0xA57D8666, (int32_t)0x5A82799A, (int32_t)0x5A82799A, (int32_t)0xA57D8666,
+    (int32_t)0xA57D8666, (int32_t)0x5A82799A, (int32_t)0x5A82799A, (int32_t)0xA57D8666,
+    (int32_t)0x9592675C, (int32_t)0x18F8B83C, (int32_t)0x7D8A5F40, (int32_t)0x471CECE7,
+    (int32_t)0xB8E31319, (int32_t)0x8275A0C0, (int32_t)0xE70747C4, (int32_t)0x6A6D98A4,
+    (int32_t)0x89BE50C3, (int32_t)0xCF043AB3, (int32_t)0x30FBC54D, (int32_t)0x7641AF3D,
+    (int32_t)0x7641AF3D, (int32_t)0x30FBC54D, (int32_t)0xCF043AB3, (int32_t)0x89BE50C3,
+    (int32_t)0x8275A0C0, (int32_t)0x9592675C, (int32_t)0xB8E31319, (int32_t)0xE70747C4,
+    (int32_t)0x18F8B83C, (int32_t)0x471CECE7, (int32_t)0x6A6D98A4, (int32_t)0x7D8A5F40,
+    (int32_t)0x80000000, (int32_t)0x80000000, (int32_t)0x80000000, (int32_t)0x80000000,
+    (int32_t)0x80000000, (int32_t)0x80000000, (int32_t)0x80000000, (int32_t)0x80000000,
+    (int32_t)0x8275A0C0, (int32_t)0x9592675C, (int32_t)0xB8E31319, (int32_t)0xE70747C4,
+    (int32_t)0x18F8B83C, (int32_t)0x471CECE7, (int32_t)0x6A6D98A4, (int32_t)0x7D8A5F40,
+    (int32_t)0x89BE50C3, (int32_t)0xCF043AB3, (int32_t)0x30FBC54D, (int32_t)0x7641AF3D,
+    (int32_t)0x7641AF3D, (int32_t)0x30FBC54D, (int32_t)0xCF043AB3, (int32_t)0x89BE50C3,
+    (int32_t)0x9592675C, (int32_t)0x18F8B83C, (int32_t)0x7D8A5F40, (int32_t)0x471CECE7,
+    (int32_t)0xB8E31319, (int32_t)0x8275A0C0, (int32_t)0xE70747C4, (int32_t)0x6A6D98A4
+};
+
+/** Lookup of (2^bits - 1) in Q17.15 */
+const int32_t sbc_level_coefs[16] =
+{
+    0x00008000, 0x00018000, 0x00038000, 0x00078000,
+    0x000F8000, 0x001F8000, 0x003F8000, 0x007F8000,
+    0x00FF8000, 0x01FF8000, 0x03FF8000, 0x07FF8000,
+    0x0FFF8000, 0x1FFF8000, 0x3FFF8000, 0x7FFF8000
+};
+
+/** Unsigned lookup of (2^bits) / (2^bits - 1) in 1.31, for bits of 2-16 */
+const uint32_t sbc_levelrecip_coefs[15] =
+{
+    0xAAAAAAAB, 0x92492492, 0x88888889, 0x84210842,
+    0x82082082, 0x81020408, 0x80808081, 0x80402010,
+    0x80200802, 0x80100200, 0x80080080, 0x80040020,
+    0x80020008, 0x80010002, 0x80008001
+};
+
+/** Loudness bit allocation offset table for M = 4, by sampling frequency */
+const int sbc_loudness_offset_m4[16] =
+{
+    -1,  0,  0,  0,
+    -2,  0,  0,  1,
+    -2,  0,  0,  1,
+    -2,  0,  0,  1
+};
+
+/** Loudness bit allocation offset table for M = 8, by sampling frequency */
+const int sbc_loudness_offset_m8[32] =
+{
+    -2,  0,  0,  0,  0,  0,  0,  1,
+    -3,  0,  0,  0,  0,  0,  1,  2,
+    -4,  0,  0,  0,  0,  0,  1,  2,
+    -4,  0,  0,  0,  0,  0,  1,  2
+};